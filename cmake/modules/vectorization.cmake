@@ -29,6 +29,13 @@ if (USE_VECTORIZATION)
             message(SEND_ERROR "\"${VECTOR_INSTRUCTIONS}\" is an unknown vector instruction set option.\
      Available options: ${VECTOR_INSTRUCTIONS_OPTIONS}")
         endif ()
+
+        # the kernels of the VectorizedCellProcessor are additionally compiled for these instruction sets and
+        # selected at runtime (see src/CMakeLists.txt and VectorizedCellProcessorKernel.h)
+        if (CMAKE_SYSTEM_PROCESSOR MATCHES "x86_64|AMD64|i.86")
+            set(VCP_KERNEL_AVX2_FLAGS -mavx2 -mfma)
+            set(VCP_KERNEL_AVX512F_FLAGS -mavx512f -mavx512dq)
+        endif ()
     elseif (CMAKE_CXX_COMPILER_ID MATCHES "Intel")
         set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -qopenmp-simd")
 
@@ -0,0 +1,41 @@
+#!/bin/bash
+# Weak scaling test of the load balancing of the KDDecomposition.
+#
+# The domain is extended in x direction proportional to the number of processes, so that the number of
+# particles and cells per process stays constant. For every process count the simulation is run with the
+# global (MPI_Allreduce of all cell counts) and with the distributed gathering of the cell costs
+# (distributedCostGathering), and the time spent in the decomposition is reported.
+#
+# Usage: ./run-weak-scaling.sh [process counts]
+#   e.g. PROCS="1 2 4 8 16" ./run-weak-scaling.sh
+#
+# Environment variables:
+#   MARDYN_EXE  path to the MPI build of MarDyn (default: ../../src/MarDyn)
+#   MPIRUN      mpi launcher (default: mpirun)
+#   LX_PER_PROC domain length in x direction per process (default: 30)
+#
+
+MARDYN_EXE=${MARDYN_EXE:=$PWD/../../src/MarDyn}
+MPIRUN=${MPIRUN:=mpirun}
+LX_PER_PROC=${LX_PER_PROC:=30}
+PROCS=${PROCS:=${@:-"1 2 4 8"}}
+
+printf "%8s %12s %24s %24s\n" "procs" "lx" "decomposition (global)" "decomposition (distr.)"
+for p in $PROCS
+do
+  lx=$((p * LX_PER_PROC))
+  times=()
+  for distributed in 0 1
+  do
+    config=config_p${p}_d${distributed}.xml
+    sed -e "s/@LX@/$lx/g" -e "s/@DISTRIBUTED@/$distributed/g" config.xml.in > $config
+    logfile=weak_scaling_p${p}_d${distributed}.log
+    $MPIRUN -np $p $MARDYN_EXE $config --final-checkpoint=0 > $logfile 2>&1
+    if [ $? -ne 0 ]; then
+      times+=("failed")
+    else
+      times+=("$(grep "Decomposition took:" $logfile | tail -n 1 | awk '{print $(NF-1)}')")
+    fi
+  done
+  printf "%8s %12s %24s %24s\n" $p $lx ${times[0]} ${times[1]}
+done
@@ -47,6 +47,11 @@ ifeq ($(VECTORIZE_CODE),AVXAMD)
 CXXFLAGS_VECTORIZE = -mavx -mfma4 -march=bdver1
 endif
 
+# The kernels of the VectorizedCellProcessor are additionally compiled for these
+# instruction sets and selected at runtime (see src/Makefile):
+CXXFLAGS_VCP_KERNEL_AVX2 = -mavx2 -mfma
+CXXFLAGS_VCP_KERNEL_AVX512F = -mavx512f -mavx512dq
+
 # OpenMP settings:
 #########################################
 ifeq ($(OPENMP),1)
@@ -3,6 +3,7 @@
 #include <string>
 #include <cmath>
 #include <cstdint>
+#include <vector>
 
 #include "Domain.h"
 
@@ -154,9 +155,6 @@ void Domain::calculateGlobalValues(
 		bool collectThermostatVelocities,
 		double Tfactor
 		) {
-	double Upot = _localUpot;
-	double Virial = _localVirial;
-
 	// To calculate Upot, Ukin and Pressure, intermediate values from all      
 	// processes are needed. Here the         
 	// intermediate values of all processes are summed up so that the root    
@@ -166,20 +164,6 @@ void Domain::calculateGlobalValues(
 	// of m_Ukin, m_Upot and Pressure had to be moved from Thermostat / upd_F  
 	// to this point           
 
-	/* FIXME stuff for the ensemble class */
-	domainDecomp->collCommInit(2, 654);
-	domainDecomp->collCommAppendDouble(Upot);
-	domainDecomp->collCommAppendDouble(Virial);
-	domainDecomp->collCommAllreduceSumAllowPrevious();
-	Upot = domainDecomp->collCommGetDouble();
-	Virial = domainDecomp->collCommGetDouble();
-	domainDecomp->collCommFinalize();
-
-	// Process 0 has to add the dipole correction:
-	// m_UpotCorr and m_VirialCorr already contain constant (internal) dipole correction
-	_globalUpot = Upot + _UpotCorr;
-	_globalVirial = Virial + _VirialCorr;
-
 	/*
 	 * thermostat ID 0 represents the entire system
 	 */
@@ -201,27 +185,74 @@ void Domain::calculateGlobalValues(
 			this->_local2KERot[0] += this->_local2KERot[thermit->first];
 		}
 	}
+
+	// Upot, Virial and per thermostat (mv2, Iw2, N, rotDOF) are reduced in one collective. Its layout is the same in
+	// every step, so with overlappingCollectives it is a single non-blocking allreduce, whose values may lag one step.
+	const size_t numThermostats = _universalThermostatN.size();
+	/* FIXME stuff for the ensemble class */
+	domainDecomp->collCommInit(2 + 4 * numThermostats, 654);
+	domainDecomp->collCommAppendDouble(_localUpot);
+	domainDecomp->collCommAppendDouble(_localVirial);
+	for (thermit = _universalThermostatN.begin(); thermit != _universalThermostatN.end(); thermit++) {
+		const unsigned long rotDOF = _localRotationalDOF[thermit->first];
+		domainDecomp->collCommAppendDouble(_local2KETrans[thermit->first]);
+		domainDecomp->collCommAppendDouble((rotDOF > 0) ? _local2KERot[thermit->first] : 0.0);
+		domainDecomp->collCommAppendUnsLong(_localThermostatN[thermit->first]);
+		domainDecomp->collCommAppendUnsLong(rotDOF);
+	}
+	domainDecomp->collCommAllreduceSumAllowPrevious();
+	const double Upot = domainDecomp->collCommGetDouble();
+	const double Virial = domainDecomp->collCommGetDouble();
+	std::vector<double> globalSummv2(numThermostats);
+	std::vector<double> globalSumIw2(numThermostats);
+	std::vector<unsigned long> globalNumMolecules(numThermostats);
+	std::vector<unsigned long> globalRotDOF(numThermostats);
+	for (size_t i = 0; i < numThermostats; i++) {
+		globalSummv2[i] = domainDecomp->collCommGetDouble();
+		globalSumIw2[i] = domainDecomp->collCommGetDouble();
+		globalNumMolecules[i] = domainDecomp->collCommGetUnsLong();
+		globalRotDOF[i] = domainDecomp->collCommGetUnsLong();
+	}
+	domainDecomp->collCommFinalize();
+
+	// the directed velocities are only collected every few steps and have to be exact, so all undirected thermostats
+	// share one blocking collective on these steps
+	std::map<int, std::array<double, 3>> globalDirectedVelocity;
+	if (collectThermostatVelocities) {
+		for (thermit = _universalThermostatN.begin(); thermit != _universalThermostatN.end(); thermit++) {
+			if (_universalUndirectedThermostat[thermit->first]) {
+				globalDirectedVelocity[thermit->first] = _localThermostatDirectedVelocity[thermit->first];
+			}
+		}
+	}
+	if (not globalDirectedVelocity.empty()) {
+		domainDecomp->collCommInit(3 * globalDirectedVelocity.size());
+		for (const auto& directedVelocity : globalDirectedVelocity) {
+			for (int d = 0; d < 3; d++) {
+				domainDecomp->collCommAppendDouble(directedVelocity.second[d]);
+			}
+		}
+		domainDecomp->collCommAllreduceSum();
+		for (auto& directedVelocity : globalDirectedVelocity) {
+			for (int d = 0; d < 3; d++) {
+				directedVelocity.second[d] = domainDecomp->collCommGetDouble();
+			}
+		}
+		domainDecomp->collCommFinalize();
+	}
+
+	// Process 0 has to add the dipole correction:
+	// m_UpotCorr and m_VirialCorr already contain constant (internal) dipole correction
+	_globalUpot = Upot + _UpotCorr;
+	_globalVirial = Virial + _VirialCorr;
+
 	int thermid = 0;
 	for (thermit = _universalThermostatN.begin(); thermit != _universalThermostatN.end(); thermit++, thermid++)
 	{
-		// number of molecules on the local process. After the reduce operation
-		// num_molecules will contain the global number of molecules
-		unsigned long numMolecules = _localThermostatN[thermit->first];
-		double summv2 = _local2KETrans[thermit->first];
-		unsigned long rotDOF = _localRotationalDOF[thermit->first];
-		double sumIw2 = (rotDOF > 0)? _local2KERot[thermit->first]: 0.0;
-
-		domainDecomp->collCommInit(4, 12+thermid);
-		domainDecomp->collCommAppendDouble(summv2);
-		domainDecomp->collCommAppendDouble(sumIw2);
-		domainDecomp->collCommAppendUnsLong(numMolecules);
-		domainDecomp->collCommAppendUnsLong(rotDOF);
-		domainDecomp->collCommAllreduceSumAllowPrevious();
-		summv2 = domainDecomp->collCommGetDouble();
-		sumIw2 = domainDecomp->collCommGetDouble();
-		numMolecules = domainDecomp->collCommGetUnsLong();
-		rotDOF = domainDecomp->collCommGetUnsLong();
-		domainDecomp->collCommFinalize();
+		const double summv2 = globalSummv2[thermid];
+		const double sumIw2 = globalSumIw2[thermid];
+		const unsigned long numMolecules = globalNumMolecules[thermid];
+		const unsigned long rotDOF = globalRotDOF[thermid];
 		global_log->debug() << "[ thermostat ID " << thermit->first << "]\tN = " << numMolecules << "\trotDOF = " << rotDOF
 			<< "\tmv2 = " <<  summv2 << "\tIw2 = " << sumIw2 << endl;
 
@@ -320,13 +351,7 @@ void Domain::calculateGlobalValues(
 
 		if(collectThermostatVelocities && _universalUndirectedThermostat[thermit->first])
 		{
-			std::array<double, 3> sigv = _localThermostatDirectedVelocity[thermit->first];
-
-			domainDecomp->collCommInit(3);
-			for(int d=0; d < 3; d++) domainDecomp->collCommAppendDouble(sigv[d]);
-			domainDecomp->collCommAllreduceSum();
-			for(int d=0; d < 3; d++) sigv[d] = domainDecomp->collCommGetDouble();
-			domainDecomp->collCommFinalize();
+			const std::array<double, 3> sigv = globalDirectedVelocity[thermit->first];
 
 
 			_localThermostatDirectedVelocity[thermit->first].fill(0.0);
@@ -596,7 +621,7 @@ void Domain::writeCheckpointHeaderXML(string filename, ParticleContainer* partic
 
 void Domain::writeCheckpoint(string filename,
 		ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, double currentTime,
-		bool useBinaryFormat) {
+		bool useBinaryFormat, bool writeIndex, double indexBlockLength) {
 	domainDecomp->assertDisjunctivity(particleContainer);
 #ifdef ENABLE_REDUCED_MEMORY_MODE
 	global_log->warning() << "The checkpoints are not adapted for RMM-mode. Velocity will be one half-timestep ahead!" << std::endl;
@@ -615,7 +640,7 @@ void Domain::writeCheckpoint(string filename,
 	} else {
 		this->writeCheckpointHeader(filename, particleContainer, domainDecomp, currentTime);
 	}
-	domainDecomp->writeMoleculesToFile(filename, particleContainer, useBinaryFormat);
+	domainDecomp->writeMoleculesToFile(filename, particleContainer, useBinaryFormat, writeIndex, indexBlockLength);
 }
 
 
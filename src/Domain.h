@@ -67,8 +67,11 @@ public:
 	//!                     Methods to achieve this are available in domainDecomp
 	//! @param currentTime The current time to be printed.
 	//! @param useBinaryFormat indicates wheter binary I/O is used or not
+	//! @param writeIndex binary only: also write a spatial index for parallel restarts (see CheckpointIndex)
+	//! @param indexBlockLength edge length of the index blocks, <= 0: one block per process
 	void writeCheckpoint( std::string filename, ParticleContainer* particleContainer,
-			DomainDecompBase* domainDecomp, double currentTime, bool useBinaryFormat = false);
+			DomainDecompBase* domainDecomp, double currentTime, bool useBinaryFormat = false,
+			bool writeIndex = false, double indexBlockLength = 0.);
 
 	//! @brief writes a checkpoint file that can be used to continue the simulation
 	//!
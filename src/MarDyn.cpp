@@ -133,7 +133,13 @@ int run_unit_tests(const Values &options, const vector<string> &args) {
  */
 int main(int argc, char** argv) {
 #ifdef ENABLE_MPI
+#ifdef _OPENMP
+	// the FMM task graph issues its MPI calls from one task at a time, but not necessarily from the master thread
+	int threadSupport;
+	MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &threadSupport);
+#else
 	MPI_Init(&argc, &argv);
+#endif
 #endif
 
 	/* Initialize the global log file */
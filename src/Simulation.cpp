@@ -16,6 +16,7 @@
 
 #include "Common.h"
 #include "Domain.h"
+#include "WrapOpenMP.h"
 #include "particleContainer/LinkedCells.h"
 
 #ifdef MARDYN_AUTOPAS
@@ -50,6 +51,7 @@
 
 #include "io/ASCIIReader.h"
 #include "io/BinaryReader.h"
+#include "io/CompactCheckpointReader.h"
 #include "io/CubicGridGeneratorInternal.h"
 #include "io/MemoryProfiler.h"
 #include "io/Mkesfera.h"
@@ -76,6 +78,7 @@
 
 #include "bhfmm/FastMultipoleMethod.h"
 #include "bhfmm/cellProcessors/VectorizedLJP2PCellProcessor.h"
+#include "spme/SmoothParticleMeshEwald.h"
 
 using Log::global_log;
 using namespace std;
@@ -111,6 +114,7 @@ Simulation::Simulation()
 	_longRangeCorrection(nullptr),
 	_temperatureControl(nullptr),
 	_FMM(nullptr),
+	_SPME(nullptr),
 	_timerProfiler(),
 #ifdef TASKTIMINGPROFILE
 	_taskTimingProfiler(new TaskTimingProfiler),
@@ -147,6 +151,8 @@ Simulation::~Simulation() {
 	_temperatureControl = nullptr;
 	delete _FMM;
 	_FMM = nullptr;
+	delete _SPME;
+	_SPME = nullptr;
 
 	/* destruct plugins and remove from plugin list */
 	_plugins.remove_if([](PluginBase *pluginPtr) {delete pluginPtr; return true;} );
@@ -276,6 +282,10 @@ void Simulation::readXML(XMLfileUnits& xmlconfig) {
 			Simulation::exit(1);
 		}
 
+		if(xmlconfig.getNodeValue("precision", _cellProcessorPrecision)) {
+			global_log->info() << "Precision of the vectorized cell processor: " << _cellProcessorPrecision << endl;
+		}
+
 		/* electrostatics */
 		/** @todo This may be better go into a physical section for constants? */
 		if(xmlconfig.changecurrentnode("electrostatic[@type='ReactionField']")) {
@@ -301,6 +311,22 @@ void Simulation::readXML(XMLfileUnits& xmlconfig) {
 			xmlconfig.changecurrentnode("..");
 		}
 
+		if (xmlconfig.changecurrentnode("electrostatic[@type='SmoothParticleMeshEwald']")) {
+#ifdef MARDYN_AUTOPAS
+			global_log->fatal()
+				<< "Smooth particle mesh Ewald is not compatible with AutoPas. Please disable the AutoPas mode (ENABLE_AUTOPAS)!"
+				<< std::endl;
+			Simulation::exit(1);
+#endif
+			if (_FMM != nullptr) {
+				global_log->error() << "Select either the fast multipole method or smooth particle mesh Ewald." << endl;
+				Simulation::exit(1);
+			}
+			_SPME = new spme::SmoothParticleMeshEwald();
+			_SPME->readXML(xmlconfig);
+			xmlconfig.changecurrentnode("..");
+		}
+
 		/* parallelisation */
 		if(xmlconfig.changecurrentnode("parallelisation")) {
 			string parallelisationtype("DomainDecomposition");
@@ -600,6 +626,12 @@ void Simulation::readXML(XMLfileUnits& xmlconfig) {
 			double timestepLength = 0.005;  // <-- TODO: should be removed from parameter list
 			_inputReader->readPhaseSpaceHeader(_domain, timestepLength);
 		}
+		else if (pspfiletype == "compact") {
+			_inputReader = new CompactCheckpointReader();
+			_inputReader->readXML(xmlconfig);
+			double timestepLength = 0.005;  // <-- TODO: should be removed from parameter list
+			_inputReader->readPhaseSpaceHeader(_domain, timestepLength);
+		}
 		else {
 			global_log->error() << "Unknown phase space file type" << endl;
 			Simulation::exit(-1);
@@ -768,7 +800,12 @@ void Simulation::prepare_start() {
 	if (!_legacyCellProcessor) {
 #ifndef ENABLE_REDUCED_MEMORY_MODE
 		global_log->info() << "Using vectorized cell processor." << endl;
-		_cellProcessor = new VectorizedCellProcessor( *_domain, _cutoffRadius, _LJCutoffRadius);
+		VectorizedCellProcessor* vcp = new VectorizedCellProcessor( *_domain, _cutoffRadius, _LJCutoffRadius);
+#ifndef MARDYN_AUTOPAS
+		vcp->setVerletListParameters(_moleculeContainer->getSkin(), _moleculeContainer->getRebuildFrequency());
+		vcp->setPrecision(VectorizedCellProcessor::precisionFromString(_cellProcessorPrecision));
+#endif
+		_cellProcessor = vcp;
 #else
 		global_log->info() << "Using reduced memory mode (RMM) cell processor." << endl;
 		_cellProcessor = new VCP1CLJRMM( *_domain, _cutoffRadius, _LJCutoffRadius);
@@ -796,6 +833,17 @@ void Simulation::prepare_start() {
 		_cellProcessor = new bhfmm::VectorizedLJP2PCellProcessor(*_domain, _LJCutoffRadius, _cutoffRadius);
 	}
 
+	if (_SPME != nullptr) {
+		// the real space part is computed by the charge kernels of the vectorized cell processor
+		auto* vcp = dynamic_cast<VectorizedCellProcessor*>(_cellProcessor);
+		if (vcp == nullptr) {
+			global_log->error() << "Smooth particle mesh Ewald requires the vectorized cell processor." << endl;
+			Simulation::exit(1);
+		}
+		_SPME->init(_domain, _domainDecomposition, _cutoffRadius);
+		vcp->setEwaldSplitting(_SPME->getAlpha());
+	}
+
 #ifdef ENABLE_MPI
 	if(auto *kdd = dynamic_cast<KDDecomposition*>(_domainDecomposition); kdd != nullptr){
 		kdd->fillTimeVecs(&_cellProcessor);
@@ -837,6 +885,11 @@ void Simulation::prepare_start() {
 		global_log->fatal() << "No _longRangeCorrection set!" << endl;
 		Simulation::exit(93742);
 	}
+	if (_SPME != nullptr) {
+		global_log->info() << "Performing initial SPME force calculation" << endl;
+		_SPME->computeElectrostatics(_moleculeContainer);
+	}
+
 	// longRangeCorrection is a site-wise force plugin, so we have to call it before updateForces()
 	_longRangeCorrection->calculateLongRange();
 
@@ -880,11 +933,11 @@ void Simulation::prepare_start() {
 	//afterForces Plugin Call
 	global_log->debug() << "[AFTER FORCES] Performing AfterForces plugin call"
 						<< endl;
-	for (auto plugin : _plugins) {
+	pluginHookCall(PluginBase::MoleculeVisitHook::AFTER_FORCES, _simstep, [this](PluginBase* plugin) {
 		global_log->debug() << "[AFTER FORCES] Plugin: "
 							<< plugin->getPluginName() << endl;
 		plugin->afterForces(_moleculeContainer, _domainDecomposition, _simstep);
-	}
+	});
 
 #ifndef MARDYN_AUTOPAS
 	// clear halo
@@ -939,6 +992,7 @@ void Simulation::simulate() {
 	global_simulation->timers()->setOutputString("SIMULATION_MPI_OMP_COMMUNICATION", "Communication took:");
 	global_simulation->timers()->setOutputString("SIMULATION_UPDATE_CONTAINER", "Container update took:");
 	global_simulation->timers()->setOutputString("SIMULATION_UPDATE_CACHES", "Cache update took:");
+	global_simulation->timers()->setOutputString("SIMULATION_PLUGIN_MOLECULE_VISIT", "Common plugin pass over the molecules took:");
 	global_simulation->timers()->setOutputString("COMMUNICATION_PARTNER_INIT_SEND", "initSend() took:");
 	global_simulation->timers()->setOutputString("COMMUNICATION_PARTNER_TEST_RECV", "testRecv() took:");
 
@@ -985,10 +1039,10 @@ void Simulation::simulate() {
 
         // beforeEventNewTimestep Plugin Call
         global_log -> debug() << "[BEFORE EVENT NEW TIMESTEP] Performing beforeEventNewTimestep plugin call" << endl;
-        for (auto plugin : _plugins) {
+        pluginHookCall(PluginBase::MoleculeVisitHook::BEFORE_EVENT_NEW_TIMESTEP, _simstep, [this](PluginBase* plugin) {
             global_log -> debug() << "[BEFORE EVENT NEW TIMESTEP] Plugin: " << plugin->getPluginName() << endl;
             plugin->beforeEventNewTimestep(_moleculeContainer, _domainDecomposition, _simstep);
-        }
+        });
 
         _ensemble->beforeEventNewTimestep(_moleculeContainer, _domainDecomposition, _simstep);
 
@@ -996,10 +1050,10 @@ void Simulation::simulate() {
 
         // beforeForces Plugin Call
         global_log -> debug() << "[BEFORE FORCES] Performing BeforeForces plugin call" << endl;
-        for (auto plugin : _plugins) {
+        pluginHookCall(PluginBase::MoleculeVisitHook::BEFORE_FORCES, _simstep, [this](PluginBase* plugin) {
             global_log -> debug() << "[BEFORE FORCES] Plugin: " << plugin->getPluginName() << endl;
             plugin->beforeForces(_moleculeContainer, _domainDecomposition, _simstep);
-        }
+        });
 
 		computationTimer->stop();
 
@@ -1045,6 +1099,12 @@ void Simulation::simulate() {
 			plugin->siteWiseForces(_moleculeContainer, _domainDecomposition, _simstep);
 		}
 
+		// SPME adds site-wise forces as well
+		if (_SPME != nullptr) {
+			global_log->debug() << "Performing SPME calculation" << endl;
+			_SPME->computeElectrostatics(_moleculeContainer);
+		}
+
 		// longRangeCorrection is a site-wise force plugin, so we have to call it before updateForces()
 		_longRangeCorrection->calculateLongRange();
 
@@ -1074,10 +1134,10 @@ void Simulation::simulate() {
 
 		//afterForces Plugin Call
 		global_log -> debug() << "[AFTER FORCES] Performing AfterForces plugin call" << endl;
-		for (auto plugin : _plugins) {
+		pluginHookCall(PluginBase::MoleculeVisitHook::AFTER_FORCES, _simstep, [this](PluginBase* plugin) {
 			global_log -> debug() << "[AFTER FORCES] Plugin: " << plugin->getPluginName() << endl;
 			plugin->afterForces(_moleculeContainer, _domainDecomposition, _simstep);
-		}
+		});
 
 		_ensemble->afterForces(_moleculeContainer, _domainDecomposition, _cellProcessor, _simstep);
 
@@ -1106,7 +1166,13 @@ void Simulation::simulate() {
 		// scale velocity and angular momentum
         // TODO: integrate into Temperature Control
 		if ( !_domain->NVE() && _temperatureControl == nullptr) {
-			if (_thermostatType ==VELSCALE_THERMOSTAT) {
+			Leapfrog* leapfrog = dynamic_cast<Leapfrog*>(_integrator);
+			if (_thermostatType == VELSCALE_THERMOSTAT and leapfrog != nullptr and leapfrog->defersVelocityScaling()) {
+				// the scaling is fused into the first half step of the next time step
+				global_log->debug() << "Deferring velocity scaling" << endl;
+				leapfrog->deferVelocityScaling(_domain);
+			}
+			else if (_thermostatType ==VELSCALE_THERMOSTAT) {
 				global_log->debug() << "Velocity scaling" << endl;
 				if (_domain->severalThermostats()) {
 					_velocityScalingThermostat.enableComponentwise();
@@ -1170,6 +1236,9 @@ void Simulation::simulate() {
 			/* force checkpoint for specified time */
 			string cpfile(_outputPrefix + ".timed.restart.dat");
 			global_log->info() << "Writing timed, forced checkpoint to file '" << cpfile << "'" << endl;
+			if (Leapfrog* leapfrog = dynamic_cast<Leapfrog*>(_integrator)) {
+				leapfrog->applyDeferredVelocityScaling(_moleculeContainer);
+			}
 			_domain->writeCheckpoint(cpfile, _moleculeContainer, _domainDecomposition, _simulationTime);
 			_forced_checkpoint_time = -1; /* disable for further timesteps */
 		}
@@ -1184,6 +1253,10 @@ void Simulation::simulate() {
 	global_simulation->timers()->registerTimer("SIMULATION_FINAL_IO", vector<string>{"SIMULATION_IO"}, new Timer());
 	global_simulation->timers()->setOutputString("SIMULATION_FINAL_IO", "Final IO took:");
 	global_simulation->timers()->getTimer("SIMULATION_FINAL_IO")->start();
+	// the final state has to contain the thermostatted velocities
+	if (Leapfrog* leapfrog = dynamic_cast<Leapfrog*>(_integrator)) {
+		leapfrog->applyDeferredVelocityScaling(_moleculeContainer);
+	}
     if( _finalCheckpoint ) {
         /* write final checkpoint */
         string cpfile(_outputPrefix + ".restart.dat");
@@ -1213,16 +1286,73 @@ void Simulation::simulate() {
 #endif /* WITH_PAPI */
 }
 
+void Simulation::pluginHookCall(PluginBase::MoleculeVisitHook hook, unsigned long simstep,
+		const std::function<void(PluginBase*)>& hookMethod) {
+	// plugins reading or writing velocities (e.g. checkpoints) must see the thermostatted ones
+	Leapfrog* leapfrog = dynamic_cast<Leapfrog*>(_integrator);
+	if (leapfrog != nullptr and leapfrog->hasDeferredVelocityScaling() and
+		std::any_of(_plugins.begin(), _plugins.end(), [hook](PluginBase* plugin) { return plugin->accessesVelocitiesAt(hook); })) {
+		leapfrog->applyDeferredVelocityScaling(_moleculeContainer);
+	}
+	callPluginHook(_plugins, _moleculeContainer, hook, simstep, hookMethod);
+}
+
+void Simulation::callPluginHook(const std::list<PluginBase*>& plugins, ParticleContainer* particleContainer,
+		PluginBase::MoleculeVisitHook hook, unsigned long simstep, const std::function<void(PluginBase*)>& hookMethod) {
+	const std::vector<PluginBase*> pluginVector(plugins.begin(), plugins.end());
+	std::vector<bool> visiting(pluginVector.size());
+	for (size_t i = 0; i < pluginVector.size(); ++i) {
+		visiting[i] = pluginVector[i]->beginMoleculeVisit(hook, simstep);
+	}
+
+	// plugins with a smaller index have already been visited
+	size_t visitedUntil = 0;
+	for (size_t i = 0; i < pluginVector.size(); ++i) {
+		if (visiting[i] and i >= visitedUntil) {
+			// the following plugins may share the pass, if no hook method called before their own one changes the molecules
+			std::vector<PluginBase*> visitingPlugins{pluginVector[i]};
+			size_t next = i + 1;
+			while (next < pluginVector.size() and visiting[next] and
+				   not pluginVector[next - 1]->modifiesMoleculesAt(hook)) {
+				visitingPlugins.push_back(pluginVector[next]);
+				++next;
+			}
+			visitedUntil = next;
+			visitMolecules(visitingPlugins, particleContainer, hook, simstep);
+		}
+		hookMethod(pluginVector[i]);
+	}
+}
+
+void Simulation::visitMolecules(const std::vector<PluginBase*>& visitingPlugins, ParticleContainer* particleContainer,
+		PluginBase::MoleculeVisitHook hook, unsigned long simstep) {
+	global_simulation->timers()->start("SIMULATION_PLUGIN_MOLECULE_VISIT");
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		const int threadNum = mardyn_get_thread_num();
+		for (auto it = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+			for (auto plugin : visitingPlugins) {
+				plugin->visitMolecule(hook, *it, threadNum);
+			}
+		}
+	}
+	global_simulation->timers()->stop("SIMULATION_PLUGIN_MOLECULE_VISIT");
+
+	for (auto plugin : visitingPlugins) {
+		plugin->endMoleculeVisit(hook, simstep);
+	}
+}
+
 void Simulation::pluginEndStepCall(unsigned long simstep) {
 
-	std::list<PluginBase*>::iterator pluginIter;
-	for (pluginIter = _plugins.begin(); pluginIter != _plugins.end(); pluginIter++) {
-		PluginBase* plugin = (*pluginIter);
+	pluginHookCall(PluginBase::MoleculeVisitHook::END_STEP, simstep, [this, simstep](PluginBase* plugin) {
 		global_log->debug() << "Plugin end of step: " << plugin->getPluginName() << endl;
 		global_simulation->timers()->start(plugin->getPluginName());
 		plugin->endStep(_moleculeContainer, _domainDecomposition, _domain, simstep);
 		global_simulation->timers()->stop(plugin->getPluginName());
-	}
+	});
 
 
 	if (_domain->thermostatWarning())
@@ -12,6 +12,7 @@
 #include "utils/SysMon.h"
 
 // plugins
+#include "plugins/PluginBase.h"
 #include "plugins/PluginFactory.h"
 
 #if !defined (SIMULATION_SRC) or defined (IN_IDE_PARSER)
@@ -28,6 +29,7 @@ class Ensemble;
 /** Reference to the global simulation object */
 #define _simulation (*global_simulation)
 
+#include <functional>
 #include <list>
 #include <vector>
 #include <string>
@@ -61,6 +63,10 @@ namespace bhfmm {
 class FastMultipoleMethod;
 } // bhfmm
 
+namespace spme {
+class SmoothParticleMeshEwald;
+} // spme
+
 
 /** @brief Controls the simulation process
  *  @author Martin Bernreuther <bernreuther@hlrs.de> et al. (2010)
@@ -103,6 +109,10 @@ public:
 	       <electrostatic type='ReactionField'>
 	         <epsilon>DOUBLE</epsilon>
 	       </electrostatic>
+	       <!-- optional, either of: -->
+	       <electrostatic type='FastMultipoleMethod'><!-- see bhfmm::FastMultipoleMethod class documentation --></electrostatic>
+	       <electrostatic type='SmoothParticleMeshEwald'><!-- see spme::SmoothParticleMeshEwald class documentation --></electrostatic>
+	       <precision>native|SPSP|SPDP|DPDP</precision><!-- precision of the vectorized cell processor, default native -->
 	       <datastructure type=STRING><!-- see ParticleContainer class documentation --></datastructure>
 	       <parallelisation type=STRING><!-- see DomainDecompBase class documentation -->
 	         <timerForLoad>STRING</timerForLoad><!-- Timer to use as load. Requires valid timer name! -->
@@ -190,6 +200,22 @@ public:
      */
 	void pluginEndStepCall(unsigned long simstep);
 
+	/** @brief call a hook method of all plugins in their order, see callPluginHook() */
+	void pluginHookCall(PluginBase::MoleculeVisitHook hook, unsigned long simstep,
+			const std::function<void(PluginBase*)>& hookMethod);
+
+	/** @brief call a hook method of all plugins in their order and visit the molecules for the plugins requesting it
+	 *
+	 * First, all plugins are asked with PluginBase::beginMoleculeVisit(). A visiting plugin sees the molecules in the
+	 * state right before its own hook method is called, exactly as if it iterated over them in the hook method. The
+	 * visits of consecutive plugins are done in one OpenMP parallel pass over the cells, as long as the hook methods of
+	 * the earlier ones do not change the molecules (PluginBase::modifiesMoleculesAt()).
+	 * @param hookMethod calls the hook method of the given plugin
+	 */
+	static void callPluginHook(const std::list<PluginBase*>& plugins, ParticleContainer* particleContainer,
+			PluginBase::MoleculeVisitHook hook, unsigned long simstep,
+			const std::function<void(PluginBase*)>& hookMethod);
+
 	/** @brief clean up simulation */
 	void finalize();
 
@@ -286,6 +312,9 @@ public:
 	void setEnsemble(Ensemble *ensemble) { _ensemble = ensemble; }
 	Ensemble* getEnsemble() { return _ensemble; }
 
+	//! smooth particle mesh Ewald for the charges, nullptr if it is not used
+	spme::SmoothParticleMeshEwald* getSPME() { return _SPME; }
+
 	std::shared_ptr<MemoryProfiler> getMemoryProfiler() {
 		return _memoryProfiler;
 	}
@@ -393,6 +422,9 @@ private:
 	/** The Fast Multipole Method object */
 	bhfmm::FastMultipoleMethod* _FMM;
 
+	/** Smooth particle mesh Ewald for the charges, the real space part is computed by the VectorizedCellProcessor */
+	spme::SmoothParticleMeshEwald* _SPME;
+
 	/** manager for all timers in the project except the MarDyn main timer */
 	TimerProfiler _timerProfiler;
 
@@ -460,6 +492,10 @@ public:
 	/** @brief Checks if Simsteps or MaxWallTime are reached */
 	bool keepRunning();
 
+	/** @brief visit all local molecules in one OpenMP parallel pass for the given plugins, which requested a visit */
+	static void visitMolecules(const std::vector<PluginBase*>& visitingPlugins, ParticleContainer* particleContainer,
+			PluginBase::MoleculeVisitHook hook, unsigned long simstep);
+
 private:
 
 	/// the timer used for the load calculation.
@@ -475,6 +511,9 @@ private:
 	/** use legacyCellProcessor instead of vectorizedCellProcessor */
 	bool _legacyCellProcessor = false;
 
+	/** precision of the vectorized cell processor, see VectorizedCellProcessor::Precision */
+	std::string _cellProcessorPrecision = "native";
+
 	/**
 	 * Specifies whether to use overlapping p2p (peer-to-peer) communication or not.
 	 * If false: overlapping is only performed for unpacking and packing of particles.
@@ -40,8 +40,13 @@ void FastMultipoleMethod::readXML(XMLfileUnits& xmlconfig) {
 
 	xmlconfig.getNodeValue("adaptiveContainer", _adaptive);
 	if (_adaptive == 1) {
-		global_log->warning() << "FastMultipoleMethod: adaptiveContainer is not debugged yet and certainly delivers WRONG results!" << endl;
-		global_log->warning() << "Unless you are in the process of debugging this container, please stop the simulation and restart with the uniform one" << endl;
+		global_log->info() << "FastMultipoleMethod: AdaptivePseudoParticleContainer selected" << endl;
+		xmlconfig.getNodeValue("adaptiveThreshold", _adaptiveThreshold);
+		if (_adaptiveThreshold < 0) {
+			global_log->error() << "FastMultipoleMethod: adaptiveThreshold must not be negative" << endl;
+			Simulation::exit(1);
+		}
+		global_log->info() << "FastMultipoleMethod: adaptiveThreshold: " << _adaptiveThreshold << endl;
 	} else {
 		global_log->info() << "FastMultipoleMethod: UniformPseudoParticleSelected " << endl;
 	}
@@ -52,14 +57,22 @@ void FastMultipoleMethod::readXML(XMLfileUnits& xmlconfig) {
 	} else {
 		global_log->info() << "FastMultipoleMethod: Periodicity is on." << endl;
 	}
+
+	xmlconfig.getNodeValue("useTaskGraph", _useTaskGraph);
+	if (_useTaskGraph) {
+		global_log->info() << "FastMultipoleMethod: running the FMM step as a task graph." << endl;
+	}
 }
 
 void FastMultipoleMethod::setParameters(unsigned LJSubdivisionFactor,
-		int orderOfExpansions, bool periodic, bool adaptive) {
+		int orderOfExpansions, bool periodic, bool adaptive, int adaptiveThreshold,
+		bool useTaskGraph) {
 	_LJCellSubdivisionFactor = LJSubdivisionFactor;
 	_order = orderOfExpansions;
 	_periodic = periodic;
 	_adaptive = adaptive;
+	_adaptiveThreshold = adaptiveThreshold;
+	_useTaskGraph = useTaskGraph;
 }
 
 void FastMultipoleMethod::init(double globalDomainLength[3], double bBoxMin[3],
@@ -79,6 +92,17 @@ void FastMultipoleMethod::init(double globalDomainLength[3], double bBoxMin[3],
 			<< pow(_LJCellSubdivisionFactor, 3)
 			<< " cells for electrostatic calculations in FMM" << endl;
 
+#if defined(QUICKSCHED) or defined(FMM_FFT)
+	if (_useTaskGraph) {
+		global_log->warning() << "FastMultipoleMethod: useTaskGraph is not available with QUICKSCHED or FMM_FFT, ignoring it." << endl;
+		_useTaskGraph = false;
+	}
+#endif
+	if (_useTaskGraph and _adaptive) {
+		global_log->warning() << "FastMultipoleMethod: useTaskGraph is only supported by the uniform container, ignoring it." << endl;
+		_useTaskGraph = false;
+	}
+
 	_P2PProcessor = new VectorizedChargeP2PCellProcessor(
 			*(global_simulation->getDomain()));
 #ifdef QUICKSCHED
@@ -98,6 +122,11 @@ void FastMultipoleMethod::init(double globalDomainLength[3], double bBoxMin[3],
                                                                       , _scheduler
 #endif
                                                                      );
+		if (_useTaskGraph and not static_cast<UniformPseudoParticleContainer*>(_pseudoParticleContainer)->isTaskGraphApplicable()) {
+			global_log->warning() << "FastMultipoleMethod: useTaskGraph does not support the neutral territory method, "
+					<< "the neighbourhood allreduce or MPI without MPI_THREAD_SERIALIZED, ignoring it." << endl;
+			_useTaskGraph = false;
+		}
 #ifdef TASKTIMINGPROFILE
 #ifdef QUICKSCHED
         global_simulation->getTaskTimingProfiler()->init(_scheduler->count);
@@ -107,15 +136,9 @@ void FastMultipoleMethod::init(double globalDomainLength[3], double bBoxMin[3],
 #endif
 
 	} else {
-		// TODO: Debugging in Progress!
-#if defined(ENABLE_MPI)
-		global_log->error() << "MPI in combination with adaptive is not supported yet" << endl;
-		Simulation::exit(-1);
-#endif
-		//int threshold = 100;
 		_pseudoParticleContainer = new AdaptivePseudoParticleContainer(
 				globalDomainLength, _order, LJCellLength,
-				_LJCellSubdivisionFactor, _periodic);
+				_LJCellSubdivisionFactor, _periodic, _adaptiveThreshold);
 	}
 
 	_P2MProcessor = new P2MCellProcessor(_pseudoParticleContainer);
@@ -146,15 +169,18 @@ void FastMultipoleMethod::computeElectrostatics(ParticleContainer* ljContainer)
 
 	global_simulation->timers()->stop("UNIFORM_PSEUDO_PARTICLE_CONTAINER_FMM_COMPLETE");
 #else
-    // P2M, M2P
-	_pseudoParticleContainer->upwardPass(_P2MProcessor);
-	if (_adaptive) {
-		_P2PProcessor->initTraversal();
+	if (_useTaskGraph) {
+		// all of the below as one task graph
+		static_cast<UniformPseudoParticleContainer*>(_pseudoParticleContainer)->runTaskGraph(
+				_P2MProcessor, _P2PProcessor, _L2PProcessor);
+	} else {
+		// P2M, M2P
+		_pseudoParticleContainer->upwardPass(_P2MProcessor);
+		// M2L, P2P
+		_pseudoParticleContainer->horizontalPass(_P2PProcessor);
+		// L2L, L2P
+		_pseudoParticleContainer->downwardPass(_L2PProcessor);
 	}
-	// M2L, P2P
-	_pseudoParticleContainer->horizontalPass(_P2PProcessor);
-	// L2L, L2P
-	_pseudoParticleContainer->downwardPass(_L2PProcessor);
 #endif
 
 }
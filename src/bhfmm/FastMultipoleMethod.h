@@ -47,7 +47,9 @@ public:
 	FastMultipoleMethod() : _order(-1),
                             _LJCellSubdivisionFactor(0),
                             _wellSeparated(0),
-                            _adaptive(false)
+                            _adaptive(false),
+                            _adaptiveThreshold(0),
+                            _useTaskGraph(false)
     {}
 	~FastMultipoleMethod();
 
@@ -58,13 +60,21 @@ public:
 	   <electrostatic type="FastMultipoleMethod">
 		 <orderOfExpansions>UNSIGNED INTEGER</orderOfExpansions>
 		 <LJCellSubdivisionFactor>INTEGER</LJCellSubdivisionFactor>
+		 <adaptiveContainer>0|1</adaptiveContainer> <!-- use the adaptive octree instead of the uniform grid (default: 0) -->
+		 <adaptiveThreshold>UNSIGNED INTEGER</adaptiveThreshold> <!-- adaptive only: leaves with more particles are refined further (default: 0 = no further refinement) -->
+		 <systemIsPeriodic>0|1</systemIsPeriodic>
+		 <useTaskGraph>0|1</useTaskGraph> <!-- uniform only: run the whole FMM step as a graph of OpenMP tasks (default: 0) -->
 	   </electrostatic>
 	   \endcode
+	 *
+	 * The adaptive container refines its octree at least down to the leaf cells of
+	 * the uniform one. Without a threshold it therefore computes the same interactions.
 	 */
 	void readXML(XMLfileUnits& xmlconfig);
 
 	void setParameters(unsigned LJSubdivisionFactor, int orderOfExpansions,
-			bool periodic = true, bool adaptive = false);
+			bool periodic = true, bool adaptive = false, int adaptiveThreshold = 0,
+			bool useTaskGraph = false);
 
 	void init(double globalDomainLength[3], double bBoxMin[3],
 			double bBoxMax[3], double LJCellLength[3], ParticleContainer* ljContainer);
@@ -94,6 +104,8 @@ private:
 	unsigned _LJCellSubdivisionFactor;
 	int _wellSeparated;
 	int _adaptive;
+	int _adaptiveThreshold;
+	bool _useTaskGraph;
 	int _periodic;
 
 	PseudoParticleContainer * _pseudoParticleContainer;
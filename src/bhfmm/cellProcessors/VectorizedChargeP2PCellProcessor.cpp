@@ -590,5 +590,37 @@ void VectorizedChargeP2PCellProcessor::processCellPair(ParticleCellPointers & c1
 	}
 }
 
+void VectorizedChargeP2PCellProcessor::processCellPairOneSided(ParticleCellPointers & targetCell, ParticleCellPointers & sourceCell) {
+	mardyn_assert(&targetCell != &sourceCell);
+	CellDataSoA& soa1 = targetCell.getCellDataSoA();
+	CellDataSoA& soa2 = sourceCell.getCellDataSoA();
+
+	if (soa1.getMolNum() == 0 or soa2.getMolNum() == 0) {
+		return;
+	}
+
+	// remember the macroscopic values so far, to keep only half of the contribution of this pair
+	VCP2PCPThreadData &my_threadData = *_threadData[mardyn_get_thread_num()];
+	vcp_real_accum upotXpolesBefore[_numVectorElements], virialBefore[_numVectorElements];
+	for (size_t j = 0; j < _numVectorElements; ++j) {
+		upotXpolesBefore[j] = my_threadData._upotXpolesV[j];
+		virialBefore[j] = my_threadData._virialV[j];
+	}
+
+	const bool ApplyCutoff = false;
+	const bool CalculateMacroscopic = true;
+
+	if (soa1.getMolNum() <= soa2.getMolNum()) {
+		_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2);
+	} else {
+		_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1);
+	}
+
+	for (size_t j = 0; j < _numVectorElements; ++j) {
+		my_threadData._upotXpolesV[j] = upotXpolesBefore[j] + 0.5 * (my_threadData._upotXpolesV[j] - upotXpolesBefore[j]);
+		my_threadData._virialV[j] = virialBefore[j] + 0.5 * (my_threadData._virialV[j] - virialBefore[j]);
+	}
+}
+
 } // namespace bhfmm
 
@@ -53,6 +53,14 @@ public:
 	 * \brief Calculate forces between pairs of Molecules in cell1 and cell2.
 	 */
 	void processCellPair(ParticleCellPointers& cell1, ParticleCellPointers& cell2);
+
+	/**
+	 * \brief Calculate forces between pairs of Molecules in targetCell and sourceCell,
+	 * of which only the ones on the Molecules of targetCell are meant to be postprocessed.
+	 * \details The pair is visited a second time with exchanged roles, hence
+	 * only half of its potential and virial is added to the macroscopic values.
+	 */
+	void processCellPairOneSided(ParticleCellPointers& targetCell, ParticleCellPointers& sourceCell);
 	/**
 	 * \brief Calculate forces between pairs of Molecules in cell.
 	 */
@@ -1,231 +1,519 @@
 #include "AdaptivePseudoParticleContainer.h"
 #include "particleContainer/ParticleContainer.h"
 #include "molecules/Molecule.h"
+#include "Simulation.h"
+#include "Domain.h"
+#include "parallel/DomainDecompBase.h"
+#include "utils/Logger.h"
+#include "WrapOpenMP.h"
+
+#include <algorithm>
+#include <climits>
+
+using Log::global_log;
 
 namespace bhfmm {
 
-const int split_target = 0, split_source = 1, split_internal = 3, NO_WORK = 5,
-		M2L = 6, P2P = 7, PUSH = 8, POP = 9;
+const double epsilon = 1e-8;
 
-const double epsilon = 0.001;
+//! number of levels, which the tree may be refined beyond the minimal depth due to the threshold
+const int maxRefinementLevels = 10;
 
-const bool debug = false;
+AdaptivePseudoParticleContainer::AdaptivePseudoParticleContainer(
+		double domainLength[3], int orderOfExpansions, double cellLength[3],
+		int subdivisionFactor, bool periodic, int threshold) :
+		PseudoParticleContainer(orderOfExpansions), _periodicBC(periodic), vc_p2p_cp(
+				nullptr), _threshold(threshold), root(nullptr), _domainLength(
+				domainLength), _cellLength(cellLength), _subdivisionFactor(
+				subdivisionFactor), _minDepth(-1), _parallelLevel(0), _rank(0) {
+	mardyn_assert(_threshold >= 0);
+	for (int d = 0; d < 3; ++d) {
+		_haloBinsLow[d] = 0;
+		_haloBinsNum[d] = 0;
+	}
+	int numProcs = 1;
+#ifdef ENABLE_MPI
+	_comm = global_simulation->domainDecomposition().getCommunicator();
+	MPI_CHECK(MPI_Comm_rank(_comm, &_rank));
+	MPI_CHECK(MPI_Comm_size(_comm, &numProcs));
+#endif
+	_boxMin.resize(numProcs);
+	_boxMax.resize(numProcs);
+	_remoteRoots.resize(numProcs, nullptr);
+
+	const int range = _periodicBC ? 1 : 0;
+	for (int z = -range; z <= range; z++) {
+		for (int y = -range; y <= range; y++) {
+			for (int x = -range; x <= range; x++) {
+				Vector3<double> shift;
+				shift[0] = _domainLength[0] * (double) x;
+				shift[1] = _domainLength[1] * (double) y;
+				shift[2] = _domainLength[2] * (double) z;
+				_shifts.push_back(shift);
+			}
+		}
+	}
+
+	// the subtrees below the first level with enough nodes for all threads are
+	// processed in parallel
+	const int numThreads = mardyn_get_max_threads();
+	while (numThreads > 1 and std::pow(8, _parallelLevel) < 4 * numThreads) {
+		++_parallelLevel;
+	}
+}
 
 void AdaptivePseudoParticleContainer::clear() {
-	//TODO FastMultipoleMethod.cpp calls this before computation
-	//_Cells.removeAllParticles();
-	//delete root;
-	//delete halo_node;
+	if (root != nullptr) {
+		root->clearExpansions();
+	}
+}
+
+int AdaptivePseudoParticleContainer::computeMinDepth(ParticleContainer* pc) {
+	// The leaves must not be larger than the cells of the uniform container. Their
+	// near field is then covered by the halo of the linked cells, unless the leaves are
+	// not aligned with the bounding box of this process: then a leaf reaches up to two
+	// leaf lengths beyond it.
+	int depth = 0;
+	for (; depth < 30; ++depth) {
+		bool fits = true;
+		for (int d = 0; d < 3; ++d) {
+			const double leafLength = _domainLength[d] / (1 << depth);
+			if (leafLength > _cellLength[d] / _subdivisionFactor * (1. + epsilon)) {
+				fits = false;
+				break;
+			}
+			bool aligned = true;
+			const double bounds[2] = { pc->getBoundingBoxMin(d), pc->getBoundingBoxMax(d) };
+			for (double b : bounds) {
+				aligned = aligned and std::abs(b / leafLength - std::round(b / leafLength)) < epsilon;
+			}
+			if (not aligned and 2. * leafLength > pc->get_halo_L(d) * (1. + epsilon)) {
+				fits = false;
+				break;
+			}
+		}
+		if (fits) {
+			break;
+		}
+	}
+#ifdef ENABLE_MPI
+	MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &depth, 1, MPI_INT, MPI_MAX, _comm));
+#endif
+	return depth;
 }
 
 void AdaptivePseudoParticleContainer::build(ParticleContainer* pc) {
-	double lowBound[3] = { 0.0, 0.0, 0.0 };
-	double highBound[3] = { _domainLength[0], _domainLength[1], _domainLength[2]};
+	deleteRemoteTrees();
+	delete root;
+	root = nullptr;
 
+	const int minDepth = computeMinDepth(pc);
+	if (minDepth != _minDepth) {
+		_minDepth = minDepth;
+		global_log->info() << "AdaptivePseudoParticleContainer: refining the tree uniformly down to depth "
+				<< _minDepth << std::endl;
+	}
 
-	for (auto tM = pc->iterator(ParticleIterator::ALL_CELLS); tM.isValid(); ++tM) {
-		if (tM->inBox(lowBound, highBound)) {
-			_particles.push_back(&(*tM));
-		}
+	std::vector<Molecule *> particles;
+	for (auto tM = pc->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); tM.isValid(); ++tM) {
+		particles.push_back(&(*tM));
 	}
 
 	Vector3<double> ctr = _domainLength * 0.5;
+	root = new DttNode(particles, 0, ctr, _domainLength, _maxOrd);
+	refineTree();
 
-	if (_threshold == 0) {
-		int depth = log2(
-				(_domainLength[0] / _cellLength[0]) * _subdivisionFactor);
-		root = new DttNode(_particles, _threshold, ctr, _domainLength, _maxOrd,
-				depth);
-	} else {
-		root = new DttNode(_particles, _threshold, ctr, _domainLength, _maxOrd,
-				0);
+	binHaloParticles(pc);
+	gatherBoundingBoxes(pc);
+}
+
+void AdaptivePseudoParticleContainer::refineTree() {
+	// refine level by level: the occupied nodes down to _minDepth, below only the crowded ones
+	std::vector<DttNode*> level(1, root);
+	while (not level.empty()) {
+		std::vector<DttNode*> next;
+		for (DttNode* node : level) {
+			const int depth = node->getLevel();
+			const bool refine = node->isOccupied()
+					and (depth < _minDepth
+							or (_threshold > 0 and node->getMpCell().occ > _threshold
+									and depth < _minDepth + maxRefinementLevels));
+			if (refine) {
+				node->split();
+				const std::vector<DttNode*>& children = node->getChildren();
+				next.insert(next.end(), children.begin(), children.end());
+			}
+		}
+		level.swap(next);
 	}
+}
 
-	TargetSourceTupel tst;
-	tst.source = root;
-	tst.target = root;
-	bhfmm::Vector3<double> shift;
-	for (int i = 0; i < 3; i++) {
-		shift[i] = 0.0;
+void AdaptivePseudoParticleContainer::gatherBoundingBoxes(ParticleContainer* pc) {
+	double box[6];
+	for (int d = 0; d < 3; ++d) {
+		box[d] = pc->getBoundingBoxMin(d);
+		box[3 + d] = pc->getBoundingBoxMax(d);
 	}
-	tst.shift = shift;
-	stack.push_back(tst);
 
-	if (_periodicBC) {
-		buildHaloTrees();
+	std::vector<double> boxes(box, box + 6);
+#ifdef ENABLE_MPI
+	boxes.resize(6 * _boxMin.size());
+	MPI_CHECK(MPI_Allgather(box, 6, MPI_DOUBLE, boxes.data(), 6, MPI_DOUBLE, _comm));
+#endif
+	for (size_t rank = 0; rank < _boxMin.size(); ++rank) {
+		for (int d = 0; d < 3; ++d) {
+			_boxMin[rank][d] = boxes[6 * rank + d];
+			_boxMax[rank][d] = boxes[6 * rank + 3 + d];
+		}
 	}
 }
 
-void AdaptivePseudoParticleContainer::upwardPass(P2MCellProcessor* /*cp*/) {
-	root->upwardPass();
+bool AdaptivePseudoParticleContainer::wellSeparatedFromProcess(const DttNode& node, int rank) const {
+	// The leaves of a process holding particles lie in its bounding box extended to
+	// the leaf grid at _minDepth and are not larger than these leaves. The node is
+	// well separated from all of them (see wellSeparated()), if it is for the largest
+	// possible leaf at the smallest possible distance, for every periodic shift.
+	Vector3<double> leafLength, low, high;
+	for (int d = 0; d < 3; ++d) {
+		leafLength[d] = _domainLength[d] / (1 << _minDepth);
+		low[d] = std::floor(_boxMin[rank][d] / leafLength[d]) * leafLength[d];
+		high[d] = std::ceil(_boxMax[rank][d] / leafLength[d]) * leafLength[d];
+	}
+
+	for (const Vector3<double>& shift : _shifts) {
+		bool separated = false;
+		for (int d = 0; d < 3 and not separated; ++d) {
+			const double nodeMin = node.getCenter()[d] + shift[d] - 0.5 * node.getSize(d);
+			const double nodeMax = node.getCenter()[d] + shift[d] + 0.5 * node.getSize(d);
+			const double gap = std::max(low[d] - nodeMax, nodeMin - high[d]);
+			// no tolerance here, wellSeparated() accepts slightly smaller gaps
+			separated = gap >= std::max(node.getSize(d), leafLength[d]);
+		}
+		if (not separated) {
+			return false;
+		}
+	}
+	return true;
 }
 
-void AdaptivePseudoParticleContainer::horizontalPass(
-		VectorizedChargeP2PCellProcessor* cp) {
-	// M2l and P2P
-	vc_p2p_cp = cp;
-	while (stack.size() > 0) {
-		work_on_stack();
+void AdaptivePseudoParticleContainer::exchangeLocallyEssentialTrees() {
+	deleteRemoteTrees();
+#ifdef ENABLE_MPI
+	const int numProcs = _remoteRoots.size();
+	std::vector<double> sendBuffer;
+	std::vector<int> sendCounts(numProcs, 0), sendDispls(numProcs, 0);
+	for (int rank = 0; rank < numProcs; ++rank) {
+		sendDispls[rank] = sendBuffer.size();
+		if (rank != _rank) {
+			root->writeToBuffer(sendBuffer, [this, rank](const DttNode& node) {
+				return not wellSeparatedFromProcess(node, rank);
+			});
+		}
+		sendCounts[rank] = sendBuffer.size() - sendDispls[rank];
+	}
+
+	std::vector<int> recvCounts(numProcs, 0), recvDispls(numProcs, 0);
+	MPI_CHECK(MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, _comm));
+	for (int rank = 1; rank < numProcs; ++rank) {
+		recvDispls[rank] = recvDispls[rank - 1] + recvCounts[rank - 1];
+	}
+	std::vector<double> recvBuffer(recvDispls[numProcs - 1] + recvCounts[numProcs - 1]);
+	MPI_CHECK(MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendDispls.data(), MPI_DOUBLE,
+			recvBuffer.data(), recvCounts.data(), recvDispls.data(), MPI_DOUBLE, _comm));
+
+	const Vector3<double> ctr = _domainLength * 0.5;
+	for (int rank = 0; rank < numProcs; ++rank) {
+		if (rank == _rank) {
+			continue;
+		}
+		_remoteRoots[rank] = new DttNode(std::vector<Molecule *>(), 0, ctr, _domainLength, _maxOrd);
+		int position = recvDispls[rank];
+		_remoteRoots[rank]->readFromBuffer(recvBuffer.data(), position);
+		mardyn_assert(position == recvDispls[rank] + recvCounts[rank]);
 	}
+#endif
 }
 
-void AdaptivePseudoParticleContainer::downwardPass(L2PCellProcessor* /*cp*/) {
-	// L2L and L2P
-	root->downwardPass();
+void AdaptivePseudoParticleContainer::deleteRemoteTrees() {
+	for (DttNode*& remoteRoot : _remoteRoots) {
+		delete remoteRoot;
+		remoteRoot = nullptr;
+	}
 }
 
-void AdaptivePseudoParticleContainer::buildHaloTrees() {
-	int root_depth = root->getMaxDepth();
-	double ctr[3] = { _domainLength[0] / 2, _domainLength[1] / 2,
-			_domainLength[2] / 2 };
+void AdaptivePseudoParticleContainer::binHaloParticles(ParticleContainer* pc) {
+	double bBoxMin[3], bBoxMax[3];
+	for (int d = 0; d < 3; ++d) {
+		bBoxMin[d] = pc->getBoundingBoxMin(d);
+		bBoxMax[d] = pc->getBoundingBoxMax(d);
+		_haloBinLength[d] = _domainLength[d] / (1 << _minDepth);
+	}
 
-	bhfmm::Vector3<double> shift;
-	halo_node = new DttNode(_particles, _threshold, ctr, _domainLength,
-			_maxOrd, root_depth, true);
-	TargetSourceTupel tst;
-	tst.target = root;
-	tst.source = halo_node;
+	std::vector<Molecule *> haloParticles;
+	int high[3] = { INT_MIN, INT_MIN, INT_MIN };
+	for (int d = 0; d < 3; ++d) {
+		_haloBinsLow[d] = INT_MAX;
+	}
+	for (auto tM = pc->iterator(ParticleIterator::ALL_CELLS); tM.isValid(); ++tM) {
+		if (tM->inBox(bBoxMin, bBoxMax)) {
+			continue;
+		}
+		haloParticles.push_back(&(*tM));
+		for (int d = 0; d < 3; ++d) {
+			const int index = std::floor(tM->r(d) / _haloBinLength[d]);
+			_haloBinsLow[d] = std::min(_haloBinsLow[d], index);
+			high[d] = std::max(high[d], index);
+		}
+	}
 
-	for (int x = -1; x <= 1; x++) {
-		shift[0] = _domainLength[0] * (double) x;
-		for (int y = -1; y <= 1; y++) {
-			shift[1] = _domainLength[1] * (double) y;
-			for (int z = -1; z <= 1; z++) {
-				if (x == 0 && y == 0 && z == 0)
-					continue;
+	_haloBins.clear();
+	if (haloParticles.empty()) {
+		for (int d = 0; d < 3; ++d) {
+			_haloBinsNum[d] = 0;
+		}
+		return;
+	}
+	for (int d = 0; d < 3; ++d) {
+		_haloBinsNum[d] = high[d] - _haloBinsLow[d] + 1;
+	}
+	_haloBins.resize(_haloBinsNum[0] * _haloBinsNum[1] * _haloBinsNum[2]);
+	for (Molecule* m : haloParticles) {
+		int index[3];
+		for (int d = 0; d < 3; ++d) {
+			index[d] = static_cast<int>(std::floor(m->r(d) / _haloBinLength[d])) - _haloBinsLow[d];
+		}
+		_haloBins[(index[2] * _haloBinsNum[1] + index[1]) * _haloBinsNum[0] + index[0]].push_back(m);
+	}
+}
 
-				shift[2] = _domainLength[2] * (double) z;
-				tst.shift = shift;
-				stack.push_back(tst);
+void AdaptivePseudoParticleContainer::collectHaloParticles(
+		const Vector3<double>& boxMin, const Vector3<double>& boxMax,
+		ParticleCellPointers& cell) const {
+	if (_haloBins.empty()) {
+		return;
+	}
+	int low[3], high[3];
+	double bMin[3], bMax[3];
+	for (int d = 0; d < 3; ++d) {
+		bMin[d] = boxMin[d];
+		bMax[d] = boxMax[d];
+		low[d] = std::max(static_cast<int>(std::floor(boxMin[d] / _haloBinLength[d])) - _haloBinsLow[d], 0);
+		high[d] = std::min(static_cast<int>(std::floor(boxMax[d] / _haloBinLength[d])) - _haloBinsLow[d],
+				_haloBinsNum[d] - 1);
+	}
+	for (int z = low[2]; z <= high[2]; ++z) {
+		for (int y = low[1]; y <= high[1]; ++y) {
+			for (int x = low[0]; x <= high[0]; ++x) {
+				for (Molecule* m : _haloBins[(z * _haloBinsNum[1] + y) * _haloBinsNum[0] + x]) {
+					if (m->inBox(bMin, bMax)) {
+						cell.addParticle(m);
+					}
+				}
 			}
 		}
 	}
 }
 
-void AdaptivePseudoParticleContainer::print_stack_op(int op,
-		DttNode * /*t*/, DttNode * /*s*/) {
-	if (!debug) {
+void AdaptivePseudoParticleContainer::collectNodes(DttNode * node,
+		std::vector<DttNode*>& nodes, int maxLevel) const {
+	nodes.push_back(node);
+	if (node->getLevel() < maxLevel) {
+		for (DttNode* child : node->getChildren()) {
+			collectNodes(child, nodes, maxLevel);
+		}
+	}
+}
+
+void AdaptivePseudoParticleContainer::upwardPass(P2MCellProcessor* /*cp*/) {
+	// P2M and M2M of the own particles in parallel subtrees
+	std::vector<DttNode*> nodes;
+	collectNodes(root, nodes, _parallelLevel);
+
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic)
+	#endif
+	for (size_t i = 0; i < nodes.size(); ++i) {
+		if (nodes[i]->getLevel() == _parallelLevel) {
+			nodes[i]->upwardPass();
+		}
+	}
+
+	// M2M above the subtrees, children before their parents
+	for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+		if ((*it)->getLevel() < _parallelLevel) {
+			(*it)->p2m_m2m();
+		}
+	}
+
+	exchangeLocallyEssentialTrees();
+}
+
+bool AdaptivePseudoParticleContainer::wellSeparated(DttNode * trg,
+		DttNode * src, const Vector3<double>& shift) const {
+	for (int d = 0; d < 3; ++d) {
+		const double dist = std::abs(trg->getCenter()[d] - (src->getCenter()[d] + shift[d]));
+		const double gap = dist - 0.5 * (trg->getSize(d) + src->getSize(d));
+		const double maxSize = std::max(trg->getSize(d), src->getSize(d));
+		if (gap >= maxSize * (1. - epsilon)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void AdaptivePseudoParticleContainer::horizontalPass(
+		VectorizedChargeP2PCellProcessor* cp) {
+	// M2L and P2P
+	vc_p2p_cp = cp;
+	vc_p2p_cp->initTraversal();
+
+	std::vector<ShiftedSource> sources;
+	for (int owner = 0; owner < static_cast<int>(_remoteRoots.size()); ++owner) {
+		for (const Vector3<double>& shift : _shifts) {
+			ShiftedSource s;
+			s.source = owner == _rank ? root : _remoteRoots[owner];
+			s.shift = shift;
+			s.owner = owner;
+			sources.push_back(s);
+		}
+	}
+
+	std::vector<TargetSourcesTupel> deferred;
+	if (root->getLocalOccupancy() > 0) {
+		traverse(root, sources, &deferred);
+	}
+
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic)
+	#endif
+	for (size_t i = 0; i < deferred.size(); ++i) {
+		traverse(deferred[i].target, deferred[i].sources, nullptr);
+	}
+
+	vc_p2p_cp->endTraversal();
+}
+
+void AdaptivePseudoParticleContainer::traverse(DttNode * trg,
+		const std::vector<ShiftedSource>& sources,
+		std::vector<TargetSourcesTupel>* deferred) {
+	if (deferred != nullptr and trg->getLevel() == _parallelLevel) {
+		TargetSourcesTupel tst;
+		tst.target = trg;
+		tst.sources = sources;
+		deferred->push_back(tst);
 		return;
 	}
-	switch (op) {
-	case NO_WORK:
-		std::cout << "		--NO WORK--" << std::endl;
-		break;
-	case M2L:
-		std::cout << "		--M2L--";
-		break;
-	case P2P:
-		std::cout << "		--P2P--" << std::endl;
-		break;
-	case PUSH:
-		std::cout << "    --PUSH--" << std::endl;
-		break;
-	case POP:
-		std::cout << "    --POP--" << std::endl;
-		break;
-	}
-}
-
-void AdaptivePseudoParticleContainer::push_on_stack(DttNode * trg,
-		DttNode * src, Vector3<double> shift, int split = split_target) {
-	std::vector<DttNode*> *src_chs = new std::vector<DttNode*>();
-	std::vector<DttNode*> *trg_chs = new std::vector<DttNode*>();
-
-	TargetSourceTupel tst;
-	tst.shift = shift;
-	switch (split) {
-	case split_target:
-		if (trg->get_children(*trg_chs)) {
-			tst.source = src;
-			for (unsigned int i = 0; i < trg_chs->size(); i++) {
-				tst.target = (*trg_chs)[i];
-				if (tst.target->isEmpty()) {
-					print_stack_op(NO_WORK, tst.target, tst.source);
-					continue;
-				}
-				print_stack_op(PUSH, tst.target, tst.source);
-				stack.push_back(tst);
+
+	std::vector<ShiftedSource> work(sources), near;
+	while (not work.empty()) {
+		ShiftedSource s = work.back();
+		work.pop_back();
+		DttNode* src = s.source;
+		if (src->isEmpty()) {
+			continue;
+		}
+
+		if (wellSeparated(trg, src, s.shift)) {
+			trg->m2l(src->getMpCell().multipole, s.shift);
+		} else if (trg->isLeafNode() and src->isLeafNode()) {
+			near.push_back(s);
+		} else if (trg->isLeafNode()
+				or (not src->isLeafNode() and src->getLevel() < trg->getLevel())) {
+			// split the source
+			for (DttNode* child : src->getChildren()) {
+				ShiftedSource c;
+				c.source = child;
+				c.shift = s.shift;
+				c.owner = s.owner;
+				work.push_back(c);
 			}
 		} else {
-			print_stack_op(P2P);
-			trg->p2p(src->getLeafParticleCells(), vc_p2p_cp, shift);
-		}
-		break;
-	case split_source:
-		if (src->get_children(*src_chs)) {
-			tst.target = trg;
-			for (unsigned int i = 0; i < src_chs->size(); i++) {
-				tst.source = (*src_chs)[i];
-				if (tst.source->isEmpty()) {
-					print_stack_op(NO_WORK, tst.target, tst.source);
-					continue;
-				}
-				print_stack_op(PUSH, tst.target, tst.source);
-				stack.push_back(tst);
+			// split the target
+			near.push_back(s);
+		}
+	}
+
+	if (trg->isLeafNode()) {
+		p2p(trg, near);
+	} else {
+		for (DttNode* child : trg->getChildren()) {
+			if (child->getLocalOccupancy() > 0) {
+				traverse(child, near, deferred);
 			}
-		} else {
-			print_stack_op(P2P);
-			trg->p2p(src->getLeafParticleCells(), vc_p2p_cp, shift);
-		}
-		break;
-	case split_internal:
-		if (trg->get_children(*trg_chs)) {
-			mardyn_assert(src->get_children(*src_chs));
-			for (unsigned int i = 0; i < trg_chs->size(); i++) {
-				for (unsigned int j = i; j < trg_chs->size(); j++) {
-					tst.target = (*trg_chs)[i];
-					tst.source = (*trg_chs)[j];
-					if (tst.target->isEmpty() or tst.source->isEmpty()) {
-						print_stack_op(NO_WORK, tst.target, tst.source);
-						continue;
-					}
-					print_stack_op(PUSH, tst.target, tst.source);
-					stack.push_back(tst);
+		}
+	}
+}
+
+void AdaptivePseudoParticleContainer::p2p(DttNode * trg,
+		const std::vector<ShiftedSource>& sources) {
+	// Only the forces on the own particles of the target are kept. Every pair of
+	// particles is visited once from either side, so sources are not postprocessed.
+	ParticleCellPointers& own = trg->getLeafParticles();
+	vc_p2p_cp->preprocessCell(own);
+
+	ParticleCellPointers src;
+	for (const ShiftedSource& s : sources) {
+		Vector3<double> boxMin = s.source->getCenter() + s.shift - s.source->getSize() * 0.5;
+		Vector3<double> boxMax = s.source->getCenter() + s.shift + s.source->getSize() * 0.5;
+		src.removeAllParticles();
+		src.setBoxMin(boxMin.data());
+		src.setBoxMax(boxMax.data());
+
+		const bool noShift = s.shift[0] == 0.0 and s.shift[1] == 0.0 and s.shift[2] == 0.0;
+		if (noShift and s.owner == _rank) {
+			if (s.source == trg) {
+				vc_p2p_cp->processCell(own);
+			} else {
+				ParticleCellPointers& srcOwn = s.source->getLeafParticles();
+				for (int i = 0; i < srcOwn.getMoleculeCount(); ++i) {
+					src.addParticle(&srcOwn.moleculesAt(i));
 				}
 			}
 		} else {
-			print_stack_op(P2P);
-			trg->p2p(vc_p2p_cp);
+			// the halo copies of the particles of the owner, seen under this shift
+			for (int d = 0; d < 3; ++d) {
+				boxMin[d] = std::max(boxMin[d], _boxMin[s.owner][d] + s.shift[d]);
+				boxMax[d] = std::min(boxMax[d], _boxMax[s.owner][d] + s.shift[d]);
+			}
+			collectHaloParticles(boxMin, boxMax, src);
+		}
+
+		if (not src.isEmpty()) {
+			vc_p2p_cp->preprocessCell(src);
+			vc_p2p_cp->processCellPairOneSided(own, src);
 		}
-		break;
-	default:
-		break;
 	}
-	delete src_chs;
-	delete trg_chs;
-}
 
-void AdaptivePseudoParticleContainer::work_on_stack() {
-	TargetSourceTupel tst = stack.back();
-	stack.pop_back();
-	print_stack_op(POP, tst.target, tst.source);
+	vc_p2p_cp->postprocessCell(own);
+}
 
-	double comp_r = tst.target->getMpCell().local.getRadius()
-			- tst.source->getMpCell().multipole.getRadius();
+void AdaptivePseudoParticleContainer::downwardPass(L2PCellProcessor* /*cp*/) {
+	// L2L and L2P
+	std::vector<DttNode*> nodes;
+	collectNodes(root, nodes, _parallelLevel);
 
-	//TODO: hardcoded cells of equal size
-	bool sameSize = std::abs(comp_r) <= epsilon;
+	double upotSum = 0.0;
+	double virialSum = 0.0;
 
-	double dist = (tst.target->getCenter() - (tst.source->getCenter() + tst.shift)).L2Norm();
+	// L2L above the parallel subtrees, parents before their children
+	for (DttNode* node : nodes) {
+		if (node->getLevel() < _parallelLevel) {
+			node->l2l_l2p(upotSum, virialSum);
+		}
+	}
 
-	if (dist > epsilon) {
-//		TODO: assuming cubic cells
-		if (((tst.target->getSize(0) + tst.source->getSize(0)) / dist < 1 + epsilon) and sameSize) {
-			print_stack_op(M2L);
-			tst.target->m2l(tst.source->getMpCell().multipole, tst.shift);
-			if (tst.shift[0] == 0.0 && tst.shift[1] == 0.0
-					&& tst.shift[2] == 0.0) {
-				tst.source->m2l(tst.target->getMpCell().multipole, tst.shift);
-			}
-		} else if (comp_r < -epsilon) {
-			push_on_stack(tst.target, tst.source, tst.shift, split_source);
-		} else {
-			push_on_stack(tst.target, tst.source, tst.shift, split_target);
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic) reduction(+:upotSum, virialSum)
+	#endif
+	for (size_t i = 0; i < nodes.size(); ++i) {
+		if (nodes[i]->getLevel() == _parallelLevel) {
+			nodes[i]->downwardPass(upotSum, virialSum);
 		}
-	} else {
-		push_on_stack(tst.target, tst.source, tst.shift, split_internal);
 	}
+
+	Domain* domain = global_simulation->getDomain();
+	domain->setLocalUpot(upotSum + domain->getLocalUpot());
+	domain->setLocalVirial(virialSum + domain->getLocalVirial());
 }
 
 } //namespace bhfmm
-
@@ -11,34 +11,56 @@
 #include <math.h>
 #include <stdlib.h>
 
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
 
 
 namespace bhfmm {
 
+//! a source node together with the periodic shift, under which it is seen by the target
 typedef struct {
-	DttNode *target, *source;
+	DttNode *source;
 	Vector3<double> shift;
-} TargetSourceTupel;
+	//! rank of the process owning the particles of the source
+	int owner;
+} ShiftedSource;
 
+//! a target node together with the sources it still has to interact with
+typedef struct {
+	DttNode *target;
+	std::vector<ShiftedSource> sources;
+} TargetSourcesTupel;
+
+/**
+ * \brief FMM on an adaptive octree, traversed by a dual tree traversal.
+ *
+ * The tree is refined uniformly down to the leaf size of the uniform container
+ * (LJ cell length divided by the subdivision factor), so that the near field of
+ * every leaf is covered by the halo of the linked cells. If a threshold is given,
+ * leaves holding more particles than the threshold are refined further.
+ *
+ * Under MPI, every process builds the tree of its own particles only. After the
+ * upward pass, it sends each other process a locally essential tree: the nodes
+ * of its own tree down to the first ones, which are well separated from every
+ * leaf the receiver can have in its bounding box. The far field of the own
+ * particles is then evaluated against the own tree and the received trees. The
+ * near field is computed from the own particles and the halo copies of the
+ * linked cells, which are assigned to the trees by the bounding boxes of the
+ * processes.
+ *
+ * Two nodes are well separated, if the gap between them in one dimension is at least
+ * the size of the larger node. For equal nodes this coincides with the
+ * well-separatedness criterion of the uniform container.
+ */
 class AdaptivePseudoParticleContainer: public PseudoParticleContainer {
 public:
-	AdaptivePseudoParticleContainer(double domainLength[3], int threshold,
-			int orderOfExpansions, bool periodic = true) :
-			PseudoParticleContainer(orderOfExpansions), _periodicBC(periodic), _threshold(
-					threshold), root(0), halo_node(0), _domainLength(
-					domainLength), _subdivisionFactor(0) {
-		mardyn_assert(_threshold > 0);
-	}
-
 	AdaptivePseudoParticleContainer(double domainLength[3],
 			int orderOfExpansions, double cellLength[3], int subdivisionFactor,
-			bool periodic) :
-			PseudoParticleContainer(orderOfExpansions), _periodicBC(periodic), _threshold(
-					0), root(0), _domainLength(domainLength), _cellLength(
-					cellLength), _subdivisionFactor(subdivisionFactor) {
-	}
+			bool periodic, int threshold = 0);
 
 	~AdaptivePseudoParticleContainer() {
+		deleteRemoteTrees();
 		delete root;
 	}
 	;
@@ -63,19 +85,50 @@ private:
 	bool _periodicBC;
 
 	VectorizedChargeP2PCellProcessor * vc_p2p_cp;
-	std::vector<Molecule *> _particles;
 	int _threshold;
-	std::vector<TargetSourceTupel> stack;
-	DttNode *root, *halo_node;
+	DttNode *root;
 	Vector3<double> _domainLength, _cellLength;
 	int _subdivisionFactor;
-
-	void buildHaloTrees();
-	void work_on_stack();
-	void push_on_stack(DttNode * trg, DttNode * src,
-			Vector3<double> shift, int split);
-	void print_stack_op(int op, DttNode * t = NULL,
-			DttNode * s = NULL);
+	//! depth down to which the tree is refined uniformly
+	int _minDepth;
+	//! subtrees below this level are processed in parallel
+	int _parallelLevel;
+	//! periodic shifts, under which the sources are seen
+	std::vector<Vector3<double> > _shifts;
+
+	int _rank;
+	//! bounding boxes of the linked cells of all processes
+	std::vector<Vector3<double> > _boxMin, _boxMax;
+	//! locally essential trees received from the other processes, nullptr for this process
+	std::vector<DttNode*> _remoteRoots;
+
+	//! halo copies of the linked cells, binned into cells of the size of the leaves at _minDepth
+	std::vector<std::vector<Molecule *> > _haloBins;
+	int _haloBinsLow[3], _haloBinsNum[3];
+	Vector3<double> _haloBinLength;
+
+#ifdef ENABLE_MPI
+	MPI_Comm _comm;
+#endif
+
+	int computeMinDepth(ParticleContainer* pc);
+	void refineTree();
+	void gatherBoundingBoxes(ParticleContainer* pc);
+	//! send the own tree pruned for every other process and rebuild the received trees
+	void exchangeLocallyEssentialTrees();
+	void deleteRemoteTrees();
+	//! true, if node is well separated from every leaf, which process rank can have
+	bool wellSeparatedFromProcess(const DttNode& node, int rank) const;
+	void binHaloParticles(ParticleContainer* pc);
+	void collectHaloParticles(const Vector3<double>& boxMin,
+			const Vector3<double>& boxMax, ParticleCellPointers& cell) const;
+	void collectNodes(DttNode * node, std::vector<DttNode*>& nodes,
+			int maxLevel) const;
+	bool wellSeparated(DttNode * trg, DttNode * src,
+			const Vector3<double>& shift) const;
+	void traverse(DttNode * trg, const std::vector<ShiftedSource>& sources,
+			std::vector<TargetSourcesTupel>* deferred);
+	void p2p(DttNode * trg, const std::vector<ShiftedSource>& sources);
 
 };
 //AdaptivePseudoParticleContainer
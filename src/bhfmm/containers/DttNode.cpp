@@ -10,28 +10,28 @@ static const bool debug = false;
 namespace bhfmm {
 
 DttNode::DttNode(const std::vector<Molecule*>& particles, int threshold, Vector3<double> ctr,
-		Vector3<double> domLen, int order, int depth, bool srcOnly) :
+		Vector3<double> domLen, int order, int depth, int level) :
 		_ctr(ctr), _domLen(domLen), _mpCell(order), _leafParticles(), _threshold(
-				threshold), _order(order), _isLeafNode(true), _depth(depth), _srcOnly(
-				srcOnly) {
+				threshold), _order(order), _isLeafNode(true), _depth(depth), _localOcc(
+				particles.size()), _level(level) {
 	_leafParticles.setBoxMin((_ctr - _domLen*0.5).data());
 	_leafParticles.setBoxMax((_ctr + _domLen*0.5).data());
 
+	// the expansions are set up for empty nodes as well: readFromBuffer()
+	// fills them with the particles of other processes
+	double radius = 0.5 * _domLen.L2Norm();
+
+	_mpCell.local.setCenter(_ctr);
+	_mpCell.local.setRadius(radius);
+	_mpCell.multipole.setCenter(_ctr);
+	_mpCell.multipole.setRadius(radius);
+
 	_mpCell.occ = particles.size();
 	if (isEmpty()) {
 		_isLeafNode = true;
 		return;
 	}
 
-	double radius = 0.5 * _domLen.L2Norm();
-
-	if (!_srcOnly) {
-		_mpCell.local.setCenter(_ctr);
-		_mpCell.local.setRadius(radius);
-	}
-	_mpCell.multipole.setCenter(_ctr);
-	_mpCell.multipole.setRadius(radius);
-
 	///////////// deactivate threshold for now
 	int pCount = particles.size();
 	if (threshold == 0) {
@@ -51,41 +51,72 @@ DttNode::DttNode(const std::vector<Molecule*>& particles, int threshold, Vector3
 		} // current particle closed
 
 	} else {
-		_isLeafNode = false;
+		createChildren(particles, _threshold, _depth - 1);
+	}
+}
+
+void DttNode::createChildren(const std::vector<Molecule*>& particles, int childThreshold, int childDepth) {
+	_isLeafNode = false;
+
+	std::array<std::vector<Molecule*>, 8> childParticles;
+	divideParticles(particles, childParticles);
+
+	Vector3<double> child_domLen(_domLen * 0.5);
+	Vector3<double> c_dL_half(child_domLen * 0.5);
+
+	for (int i = 0; i < 8; i++) {
+		bool left_right;
+		double sign;
+		Vector3<double> child_ctr(_ctr);
+
+		left_right = i % 2 == 0;
+		sign = left_right ? -1. : 1.;
+		child_ctr[0] += sign * c_dL_half[0];
+
+		left_right = i % 4 <= 1;
+		sign = left_right ? -1. : 1.;
+		child_ctr[1] += sign * c_dL_half[1];
+
+		left_right = i <= 3;
+		sign = left_right ? -1. : 1.;
+		child_ctr[2] += sign * c_dL_half[2];
+
+		_children.push_back(
+				new DttNode(childParticles[i], childThreshold,
+						child_ctr, child_domLen, _order, childDepth,
+						_level + 1));
+	}
+}
 
-		std::array<std::vector<Molecule*>, 8> childParticles;
-		divideParticles(particles, childParticles);
+void DttNode::split() {
+	mardyn_assert(_isLeafNode);
 
-		Vector3<double> child_domLen(_domLen * 0.5);
-		Vector3<double> c_dL_half(child_domLen * 0.5);
+	std::vector<Molecule*> particles;
+	particles.reserve(_leafParticles.getMoleculeCount());
+	for (int i = 0; i < _leafParticles.getMoleculeCount(); i++) {
+		particles.push_back(&_leafParticles.moleculesAt(i));
+	}
+	_leafParticles.removeAllParticles();
+
+	// the children are created as leaves
+	createChildren(particles, 0, 0);
+}
+
+void DttNode::upwardPass() {
+	if (_localOcc == 0) {
+		return;
+	}
 
+	if (not _isLeafNode) {
 		for (int i = 0; i < 8; i++) {
-			bool left_right;
-			double sign;
-			Vector3<double> child_ctr(_ctr);
-
-			left_right = i % 2 == 0;
-			sign = left_right ? -1. : 1.;
-			child_ctr[0] += sign * c_dL_half[0];
-
-			left_right = i % 4 <= 1;
-			sign = left_right ? -1. : 1.;
-			child_ctr[1] += sign * c_dL_half[1];
-
-			left_right = i <= 3;
-			sign = left_right ? -1. : 1.;
-			child_ctr[2] += sign * c_dL_half[2];
-
-			_children.push_back(
-					new DttNode(childParticles[i], _threshold,
-							child_ctr, child_domLen, _order, _depth - 1,
-							_srcOnly));
+			_children[i]->upwardPass();
 		}
 	}
+	p2m_m2m();
 }
 
-void DttNode::upwardPass() {
-	if (isEmpty()) {
+void DttNode::p2m_m2m() {
+	if (_localOcc == 0) {
 		return;
 	}
 
@@ -118,8 +149,7 @@ void DttNode::upwardPass() {
 	} else {
 		// M2M
 		for (int i = 0; i < 8; i++) {
-			if (_children[i]->isOccupied()) {
-				_children[i]->upwardPass();
+			if (_children[i]->_localOcc > 0) {
 				_mpCell.multipole.addMultipoleParticle(
 						_children[i]->_mpCell.multipole);
 			}
@@ -127,29 +157,39 @@ void DttNode::upwardPass() {
 	}
 }
 
-void DttNode::downwardPass() {
+void DttNode::downwardPass(double& upotSum, double& virialSum) {
+	if (_localOcc == 0) {
+		return;
+	}
+
+	l2l_l2p(upotSum, virialSum);
 	if (not _isLeafNode) {
-		// L2L
 		for (unsigned int i = 0; i < 8; i++) {
-			if (_children[i]->isEmpty())
+			_children[i]->downwardPass(upotSum, virialSum);
+		}
+	}
+}
+
+void DttNode::l2l_l2p(double& upotSum, double& virialSum) {
+	if (_localOcc == 0) {
+		return;
+	}
+
+	if (not _isLeafNode) {
+		// L2L, only to children holding particles of this process
+		for (unsigned int i = 0; i < 8; i++) {
+			if (_children[i]->_localOcc == 0)
 				continue;
 			_mpCell.local.actOnLocalParticle(_children[i]->_mpCell.local);
-			_children[i]->downwardPass();
 		}
 
 	} else {
 		// L2P
 
 		int currentParticleCount = _leafParticles.getMoleculeCount();
-		bhfmm::SolidHarmonicsExpansion leLocal(_order);
 		double u = 0;
-		double uSum = 0.0;
 		double f[3] = { 0.0, 0.0, 0.0 };
 		bhfmm::Vector3<double> f_vec3;
-		double virialSum = 0.0;
-		double P_xxSum = 0.0;
-		double P_yySum = 0.0;
-		double P_zzSum = 0.0;
 
 		for (int i = 0; i < currentParticleCount; i++) {
 			Molecule& molecule1 = _leafParticles.moleculesAt(i);
@@ -171,21 +211,66 @@ void DttNode::downwardPass() {
 				f[1] = f_vec3[1];
 				f[2] = f_vec3[2];
 
+				// taken at the molecule center like in the P2P part, see UniformPseudoParticleContainer
 				double virial = 0.0;
 				for (int l = 0; l < 3; l++) {
-					virial += -f[l] * dr[l];
+					virial += f[l] * molecule1.r(l);
 				}
-				P_xxSum += 0.5 * -f[0] * dr[0];
-				P_yySum += 0.5 * -f[1] * dr[1];
-				P_zzSum += 0.5 * -f[2] * dr[2];
 				molecule1.Fchargeadd(j, f);
-				uSum += 0.5 * u;
-				virialSum += 0.5 * virial;
+				upotSum += 0.5 * u;
+				virialSum += virial;
 			}
 		}
 	}
 }
 
+void DttNode::clearExpansions() {
+	_mpCell.multipole.clear();
+	_mpCell.local.clear();
+	for (unsigned int i = 0; i < _children.size(); i++) {
+		_children[i]->clearExpansions();
+	}
+}
+
+void DttNode::writeToBuffer(std::vector<double>& buffer,
+		const std::function<bool(const DttNode&)>& descend) const {
+	buffer.push_back(_mpCell.occ);
+	if (isEmpty()) {
+		return;
+	}
+
+	const bool children = not _isLeafNode and descend(*this);
+	buffer.push_back(children ? 1.0 : 0.0);
+	int position = buffer.size();
+	buffer.resize(position + _mpCell.multipole.getNumEntries());
+	_mpCell.multipole.writeValuesToMPIBuffer(buffer.data(), position);
+
+	if (children) {
+		for (unsigned int i = 0; i < 8; i++) {
+			_children[i]->writeToBuffer(buffer, descend);
+		}
+	}
+}
+
+void DttNode::readFromBuffer(double* buffer, int& position) {
+	mardyn_assert(_isLeafNode and _leafParticles.isEmpty());
+
+	_mpCell.occ = static_cast<int>(buffer[position++]);
+	if (isEmpty()) {
+		return;
+	}
+
+	const bool children = buffer[position++] != 0.0;
+	_mpCell.multipole.readValuesFromMPIBuffer(buffer, position);
+
+	if (children) {
+		createChildren(std::vector<Molecule*>(), 0, 0);
+		for (unsigned int i = 0; i < 8; i++) {
+			_children[i]->readFromBuffer(buffer, position);
+		}
+	}
+}
+
 std::vector<ParticleCellPointers> DttNode::getLeafParticleCells() {
 	std::vector<ParticleCellPointers> retval(0);
 	if (_isLeafNode) {
@@ -202,43 +287,6 @@ std::vector<ParticleCellPointers> DttNode::getLeafParticleCells() {
 	return retval;
 }
 
-void DttNode::p2p(bhfmm::VectorizedChargeP2PCellProcessor * v_c_p2p_c_p) {
-	// TODO
-//	_leafParticles.convertAoSToSoACharge();
-	v_c_p2p_c_p->preprocessCell(_leafParticles);
-	v_c_p2p_c_p->processCell(_leafParticles);
-	v_c_p2p_c_p->postprocessCell(_leafParticles);
-//	_leafParticles.convertSoAToAoSCharge();
-}
-
-void DttNode::p2p(std::vector<ParticleCellPointers> leafParticlesFar,
-		bhfmm::VectorizedChargeP2PCellProcessor * v_c_p2p_c_p,
-		bhfmm::Vector3<double> shift) {
-	std::vector<double> _shift;
-	for (int i = 0; i < 3; i++) {
-		_shift.push_back(shift[i]);
-	}
-	if (_isLeafNode) {
-		//TODO only convert once
-//		_leafParticles.convertAoSToSoACharge();
-		v_c_p2p_c_p->preprocessCell(_leafParticles);
-		for (unsigned int i = 0; i < leafParticlesFar.size(); i++) {
-			//TODO only convert once!! 
-//			leafParticlesFar[i].convertAoSToSoACharge(_shift);
-			v_c_p2p_c_p->preprocessCell(leafParticlesFar[i]);
-			v_c_p2p_c_p->processCellPair(_leafParticles, leafParticlesFar[i]);
-			v_c_p2p_c_p->postprocessCell(leafParticlesFar[i]);
-			//leafParticlesFar[i].convertSoAToAoSCharge(_shift);
-		}
-		v_c_p2p_c_p->postprocessCell(_leafParticles);
-//		_leafParticles.convertSoAToAoSCharge();
-	} else {
-		for (unsigned int i = 0; i < 8; i++) {
-			_children[i]->p2p(leafParticlesFar, v_c_p2p_c_p, shift);
-		}
-	}
-}
-
 void DttNode::m2l(const SHMultipoleParticle& multipole,
 		Vector3<double> periodicShift) {
 	_mpCell.local.addMultipoleParticle(multipole, periodicShift);
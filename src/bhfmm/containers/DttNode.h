@@ -2,12 +2,12 @@
 #define DTTNODE_H_
 
 #include "PseudoParticleContainer.h"
-#include "bhfmm/cellProcessors/VectorizedChargeP2PCellProcessor.h"
 #include "bhfmm/utils/Vector3.h"
 
 #include <vector>
 #include "utils/mardyn_assert.h"
 #include <array>
+#include <functional>
 
 class DttNodeTest;
 
@@ -15,16 +15,24 @@ namespace bhfmm {
 class DttNode;
 }
 
+/**
+ * \brief Node of the octree used by the AdaptivePseudoParticleContainer.
+ *
+ * Only the leaves store particles. In the tree of the own particles, the occupancy
+ * of the MpCell equals getLocalOccupancy(). Trees received from other processes
+ * (see readFromBuffer()) hold no particles: their occupancies and multipoles are
+ * the ones of the sender, and their local occupancy is zero.
+ */
 class bhfmm::DttNode {
 	friend class ::DttNodeTest;
 
 public:
 	DttNode(int o) :
-			_mpCell(o) {
+			_mpCell(o), _localOcc(0), _level(0) {
 	}
 
 	DttNode(const std::vector<Molecule *>& particles, int threshold, Vector3<double> ctr,
-			Vector3<double> domLen, int order, int depth = 0, bool srcOnly = false);
+			Vector3<double> domLen, int order, int depth = 0, int level = 0);
 
 	~DttNode() {
 		for (unsigned int i = 0; i < _children.size(); i++) {
@@ -37,16 +45,39 @@ public:
 		return not _isLeafNode;
 	}
 
+	const std::vector<DttNode*>& getChildren() const {
+		return _children;
+	}
+
+	//! turn this leaf into an inner node with eight leaf children, which take over its particles
+	void split();
+
 	void upwardPass();
-	void downwardPass();
-	void p2p(VectorizedChargeP2PCellProcessor * v_c_p2p_c_p);
-	void p2p(std::vector<ParticleCellPointers> leafParticlesFar,
-			VectorizedChargeP2PCellProcessor * v_c_p2p_c_p,
-			Vector3<double> shift);
+	void downwardPass(double& upotSum, double& virialSum);
+	//! P2M (leaf) or M2M (inner node) of this node only, the children have to be complete already
+	void p2m_m2m();
+	//! L2P (leaf) or L2L to the children of this node only
+	void l2l_l2p(double& upotSum, double& virialSum);
 	void m2l(const SHMultipoleParticle& multipole,
 			Vector3<double> periodicShift);
+	//! reset the multipole and the local expansion of the whole subtree
+	void clearExpansions();
+
+	/**
+	 * \brief Append the occupancy and the multipole expansion of this subtree to buffer.
+	 *
+	 * The children of an inner node only follow, if descend(node) is true. Otherwise
+	 * the node is written as a leaf. Empty nodes are written without expansion.
+	 */
+	void writeToBuffer(std::vector<double>& buffer,
+			const std::function<bool(const DttNode&)>& descend) const;
+	//! rebuild a subtree written by writeToBuffer() below this node, which has to be an empty leaf
+	void readFromBuffer(double* buffer, int& position);
 
 	std::vector<ParticleCellPointers> getLeafParticleCells();
+	ParticleCellPointers& getLeafParticles() {
+		return _leafParticles;
+	}
 	int getMaxDepth() const;
 	void printSplitable(bool print) const;
 
@@ -58,6 +89,19 @@ public:
 		return not isEmpty();
 	}
 
+	bool isLeafNode() const {
+		return _isLeafNode;
+	}
+
+	int getLocalOccupancy() const {
+		return _localOcc;
+	}
+
+	//! tree level of the node, the root has level 0
+	int getLevel() const {
+		return _level;
+	}
+
 	Vector3<double> getCenter() const {
 		return _ctr;
 	}
@@ -65,7 +109,7 @@ public:
 		return _domLen;
 	}
 	double getSize(int d) const {
-		mardyn_assert(d < 2 and d >= 0);
+		mardyn_assert(d < 3 and d >= 0);
 		return _domLen[d];
 	}
 	MpCell& getMpCell() {
@@ -82,10 +126,12 @@ private:
 	bool _isLeafNode;
 	std::vector<DttNode*> _children;
 	int _depth;
-	bool _srcOnly;
+	int _localOcc;
+	int _level;
 	//void initTree(ParticleCellPointers particles);
 	void divideParticles(const std::vector<Molecule *>& particles,
 			std::array<std::vector<Molecule *>, 8>& cell_container) const;
+	void createChildren(const std::vector<Molecule *>& particles, int childThreshold, int childDepth);
 };
 
 #endif /* DTTNODE_H_ */
@@ -22,6 +22,7 @@ namespace bhfmm {
 
 LeafNodesContainer::LeafNodesContainer(double bBoxMin[3],
 									   double bBoxMax[3],
+									   double globalDomainLength[3],
 									   double LJCellLength[3],
 									   unsigned subdivisionFactor,
 									   bool periodic
@@ -33,12 +34,13 @@ LeafNodesContainer::LeafNodesContainer(double bBoxMin[3],
 
 	_periodicBC = periodic; // a hack-in workaround to disable periodicity is
 	// simply to change the addParticle functionality to filter out by
-	// the bounding box, instead of by the HaloBoundingBox
+	// the global domain, instead of by the HaloBoundingBox only
 
 
 	for (int d = 0; d < 3; d++) {
 		_boundingBoxMin[d] = bBoxMin[d];
 		_boundingBoxMax[d] = bBoxMax[d];
+		_globalDomainLength[d] = globalDomainLength[d];
 	}
 
 	unsigned totNumCells = 1;
@@ -108,6 +110,7 @@ void LeafNodesContainer::initializeCells() {
 			for (int ix = 0; ix < _numCellsPerDimension[0]; ++ix) {
 
 				cellIndex = cellIndexOf3DIndex(ix, iy, iz);
+				_cells[cellIndex].setCellIndex(cellIndex); // the P2P cell processor decides by it which halo pair contributes the macroscopic values
 				_cells[cellIndex].skipCellFromHaloRegion();
 				_cells[cellIndex].skipCellFromBoundaryRegion();
 				_cells[cellIndex].skipCellFromInnerRegion();
@@ -178,11 +181,11 @@ long int LeafNodesContainer::cellIndexOf3DIndex(int xIndex, int yIndex, int zInd
 
 void LeafNodesContainer::addParticle(Molecule& particle) {
 
-	bool insert;
-	if(_periodicBC == true) {
-		insert = particle.inBox(_haloBoundingBoxMin, _haloBoundingBoxMax);
-	} else {
-		insert = particle.inBox(_boundingBoxMin, _boundingBoxMax);
+	bool insert = particle.inBox(_haloBoundingBoxMin, _haloBoundingBoxMax);
+	if(_periodicBC == false) {
+		// halo copies of the neighbouring processes are kept, periodic images are not
+		const double domainMin[3] = {0., 0., 0.};
+		insert = insert and particle.inBox(domainMin, _globalDomainLength);
 	}
 
 
@@ -338,6 +341,50 @@ void LeafNodesContainer::traverseCellPairsC08(VectorizedChargeP2PCellProcessor&
 	#endif
 }
 
+void LeafNodesContainer::traverseCellPairsTasks(VectorizedChargeP2PCellProcessor& cellProcessor) {
+	VectorizedChargeP2PCellProcessor* cp = &cellProcessor;
+
+	// preprocess all cells
+	for (long int cellIndex = 0; cellIndex < (long int) _cells.size(); ++cellIndex) {
+		ParticleCellPointers* cell = &_cells[cellIndex];
+		#if defined(_OPENMP)
+		#pragma omp task firstprivate(cell) depend(out: *cell)
+		#endif
+		cp->preprocessCell(*cell);
+	}
+
+	// a c08 step writes to the 2x2x2 block of cells starting at its base cell
+	const long int x   = cellIndexOf3DIndex(1,0,0);
+	const long int y   = cellIndexOf3DIndex(0,1,0);
+	const long int z   = cellIndexOf3DIndex(0,0,1);
+	const long int xy  = cellIndexOf3DIndex(1,1,0);
+	const long int yz  = cellIndexOf3DIndex(0,1,1);
+	const long int xz  = cellIndexOf3DIndex(1,0,1);
+	const long int xyz = cellIndexOf3DIndex(1,1,1);
+
+	for (unsigned col = 0; col < _numActiveColours; ++col) {
+		const int numIndicesOfThisColour = _cellIndicesPerColour[col].size();
+		for (int i = 0; i < numIndicesOfThisColour; ++i) {
+			long int baseIndex = _cellIndicesPerColour[col][i];
+			ParticleCellPointers* block = &_cells[baseIndex];
+			#if defined(_OPENMP)
+			#pragma omp task firstprivate(baseIndex) depend(inout: block[0], block[x], block[y], block[z], \
+					block[xy], block[yz], block[xz], block[xyz])
+			#endif
+			c08Step(baseIndex, *cp);
+		}
+	}
+
+	// postprocess all cells
+	for (long int cellIndex = 0; cellIndex < (long int) _cells.size(); ++cellIndex) {
+		ParticleCellPointers* cell = &_cells[cellIndex];
+		#if defined(_OPENMP)
+		#pragma omp task firstprivate(cell) depend(inout: *cell)
+		#endif
+		cp->postprocessCell(*cell);
+	}
+}
+
 void LeafNodesContainer::c08Step(long int baseIndex, VectorizedChargeP2PCellProcessor &cellProcessor) {
 	const int num_pairs = _cellPairOffsets.size();
 	for(int j = 0; j < num_pairs; ++j) {
@@ -26,6 +26,7 @@ class LeafNodesContainer {
 public:
 	LeafNodesContainer(double bBoxMin[3],
 					   double bBoxMax[3],
+					   double globalDomainLength[3],
 					   double LJCellLength[3],
 					   unsigned subdivisionFactor,
 					   bool periodic = true
@@ -46,6 +47,12 @@ public:
 	void traverseCellPairs(VectorizedChargeP2PCellProcessor& cellProcessor);
 	void traverseCellPairsOrig(VectorizedChargeP2PCellProcessor& cellProcessor);
 	void traverseCellPairsC08(VectorizedChargeP2PCellProcessor& cellProcessor);
+	/**
+	 * Creates the preprocessing, the c08 steps and the postprocessing as OpenMP tasks,
+	 * which use the cells as dependency objects. Has to be called by a single thread of
+	 * a parallel region, initTraversal and endTraversal are left to the caller.
+	 */
+	void traverseCellPairsTasks(VectorizedChargeP2PCellProcessor& cellProcessor);
 
     const int *getNumCellsPerDimension() const;
 
@@ -69,6 +76,8 @@ private:
 	double _boundingBoxMax[3];
 	double _haloBoundingBoxMin[3];
 	double _haloBoundingBoxMax[3];
+	//! without periodic boundaries, halo particles beyond the global domain are periodic images and are skipped
+	double _globalDomainLength[3];
 	double _cellLength[3];
 	int _numInnerCellsPerDimension[3];
 	int _numCellsPerDimension[3];
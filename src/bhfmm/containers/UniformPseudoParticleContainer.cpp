@@ -31,6 +31,11 @@ namespace bhfmm {
 #define IsOdd(x) ((x) & 1)
 #define ToEven(x) ((x) & ~1)
 
+// dereferenced entries of an array of pointers as list items of a depend clause
+#define DEPEND_LIST_8(a) *a[0], *a[1], *a[2], *a[3], *a[4], *a[5], *a[6], *a[7]
+#define DEPEND_LIST_27(a) DEPEND_LIST_8(a), *a[8], *a[9], *a[10], *a[11], *a[12], *a[13], *a[14], \
+	*a[15], *a[16], *a[17], *a[18], *a[19], *a[20], *a[21], *a[22], *a[23], *a[24], *a[25], *a[26]
+
 UniformPseudoParticleContainer::UniformPseudoParticleContainer(
 		double domainLength[3],
 		double bBoxMin[3],
@@ -145,6 +150,7 @@ UniformPseudoParticleContainer::UniformPseudoParticleContainer(
 #endif
 	_leafContainer = new LeafNodesContainer(bBoxMin,
 											bBoxMax,
+											domainLength,
 											LJCellLength,
 											LJSubdivisionFactor,
 											periodic
@@ -1214,6 +1220,11 @@ int UniformPseudoParticleContainer::optimizeAllReduce(/*ParticleContainer* ljCon
 void UniformPseudoParticleContainer::upwardPass(P2MCellProcessor* cp) {
 	// P2M
 	_leafContainer->traverseCells(*cp);
+	// M2M
+	upwardPassM2M();
+}
+
+void UniformPseudoParticleContainer::upwardPassM2M() {
 	global_simulation->timers()->start("UNIFORM_PSEUDO_PARTICLE_CONTAINER_COMBINE_MP_CELL_GLOBAL");
 
 	int curCellsEdge=_globalNumCellsPerDim;
@@ -1382,6 +1393,10 @@ void UniformPseudoParticleContainer::horizontalPass(
 	_leafContainer->traverseCellPairs(*cp);
 
 	// M2L
+	horizontalPassM2L();
+}
+
+void UniformPseudoParticleContainer::horizontalPassM2L() {
 	int curCellsEdge=1;
 	double cellWid[3];
 
@@ -1400,11 +1415,7 @@ void UniformPseudoParticleContainer::horizontalPass(
 			for(int j = 0; j < 3; j++){
 				curCellsEdgeLocal[j] = (int) (curCellsEdge/_numProcessorsPerDim[j])+4;
 			}
-#ifdef FMM_FFT
-			GatherWellSepLo_FFT_Local(cellWid, curCellsEdgeLocal, curLevel, 0);
-#else
-			GatherWellSepLo_Local(cellWid, curCellsEdgeLocal, curLevel, 0);
-#endif
+			M2L_Local(cellWid, curCellsEdgeLocal, curLevel, 0);
 		}
 	}
 #endif
@@ -1439,11 +1450,7 @@ void UniformPseudoParticleContainer::horizontalPass(
 					for(int j = 0; j < 3; j++){
 						curCellsEdgeLocal[j] = (int) (curCellsEdge/_numProcessorsPerDim[j])+4;
 					}
-#ifdef FMM_FFT
-					GatherWellSepLo_FFT_Local(cellWid, curCellsEdgeLocal, curLevel, 1);
-#else
-					GatherWellSepLo_Local(cellWid, curCellsEdgeLocal, curLevel, 1);
-#endif
+					M2L_Local(cellWid, curCellsEdgeLocal, curLevel, 1);
 				}
 			}
 			global_simulation->timers()->start("UNIFORM_PSEUDO_PARTICLE_CONTAINER_BUSY_WAITING");
@@ -1478,19 +1485,11 @@ void UniformPseudoParticleContainer::horizontalPass(
 
 #if defined(ENABLE_MPI)
 				if(curLevel <= _globalLevel){
-	#ifdef FMM_FFT
-					GatherWellSepLo_FFT_Global(cellWid, curCellsEdge, curLevel);
-	#else
-					GatherWellSepLo_Global(cellWid, curCellsEdge, curLevel);
-	#endif
+					M2L_Global(cellWid, curCellsEdge, curLevel);
 				}
 #else
-	#ifdef FMM_FFT
-					GatherWellSepLo_FFT_Global(cellWid, curCellsEdge, curLevel);
-	#else
-					GatherWellSepLo_Global(cellWid, curCellsEdge, curLevel);
-	#endif
-					finishedFlag = -1;
+				M2L_Global(cellWid, curCellsEdge, curLevel);
+				finishedFlag = -1;
 #endif
 #ifdef ENABLE_MPI
 				if(_doNTGlobal && _avoidAllReduce && _fuseGlobalCommunication && curLevel >= _stopLevel && curLevel <= _globalLevel){ //perform local allreduce for backwards communication
@@ -1586,6 +1585,22 @@ void UniformPseudoParticleContainer::horizontalPass(
 	//in case of neutral territory version exchange halo values
 }
 
+void UniformPseudoParticleContainer::M2L_Global(double *cellWid, int mpCells, int curLevel){
+#ifdef FMM_FFT
+	GatherWellSepLo_FFT_Global(cellWid, mpCells, curLevel);
+#else
+	GatherWellSepLo_Global(cellWid, mpCells, curLevel);
+#endif
+}
+
+void UniformPseudoParticleContainer::M2L_Local(double *cellWid, Vector3<int> localMpCells, int curLevel, int doHalos){
+#ifdef FMM_FFT
+	GatherWellSepLo_FFT_Local(cellWid, localMpCells, curLevel, doHalos);
+#else
+	GatherWellSepLo_Local(cellWid, localMpCells, curLevel, doHalos);
+#endif
+}
+
 int UniformPseudoParticleContainer::busyWaiting(){
 #ifdef ENABLE_MPI
 	//if program has dead lock comment this line in to see which flag causes dead lock
@@ -1667,6 +1682,15 @@ int UniformPseudoParticleContainer::busyWaiting(){
 
 void UniformPseudoParticleContainer::downwardPass(L2PCellProcessor* cp) {
 	// L2L
+	downwardPassL2L();
+
+	// L2P
+	_leafContainer->traverseCells(*cp);
+
+	global_simulation->timers()->stop("UNIFORM_PSEUDO_PARTICLE_CONTAINER_FMM_COMPLETE");
+}
+
+void UniformPseudoParticleContainer::downwardPassL2L() {
 	int curCellsEdge=1;
 	double cellWid[3];
 #ifdef ENABLE_MPI
@@ -1704,9 +1728,343 @@ void UniformPseudoParticleContainer::downwardPass(L2PCellProcessor* cp) {
 		PropagateCellLo_Global(cellWid, curCellsEdge, curLevel);
 #endif
 	}
+}
 
-	// L2P
-	_leafContainer->traverseCells(*cp);
+bool UniformPseudoParticleContainer::isTaskGraphApplicable() const {
+	if (_doNTGlobal or _avoidAllReduce) {
+		return false;
+	}
+#if defined(ENABLE_MPI)
+	// the leaves have to belong to the local tree, whose halo cells are exchanged
+	if (_doNTLocal or _maxLevel == _globalLevel) {
+		return false;
+	}
+#if defined(_OPENMP)
+	int provided;
+	MPI_CHECK(MPI_Query_thread(&provided));
+	if (provided < MPI_THREAD_SERIALIZED) {
+		return false;
+	}
+#endif
+#endif
+	return true;
+}
+
+void UniformPseudoParticleContainer::runTaskGraph(P2MCellProcessor* p2m,
+		VectorizedChargeP2PCellProcessor* p2p, L2PCellProcessor* l2p) {
+	std::vector<ParticleCellPointers>& leafCells = _leafContainer->getCells();
+	const long int numLeafCells = leafCells.size();
+	// levels of the local tree which are handled per subdomain; without MPI, the global tree reaches down to the leaves
+	const int minLocalLevel = std::max(_globalLevel, 1);
+
+	// number of cells per dimension of the local tree on a level, including the halo
+	auto localMpCells = [this](int level) {
+		Vector3<int> cells;
+		for (int d = 0; d < 3; ++d) {
+			cells[d] = (1 << level) / _numProcessorsPerDim[d] + 4;
+		}
+		return cells;
+	};
+	// cell of the own subdomain on a level at or below the global level, x, y, z count from its first inner cell
+	auto ownMpCell = [this, &localMpCells](int level, int x, int y, int z) -> MpCell& {
+		if (level == _globalLevel) {
+			const int row = 1 << level;
+			return _mpCellGlobalTop[level][((z + _processorPositionGlobalLevel[2]) * row + y
+					+ _processorPositionGlobalLevel[1]) * row + x + _processorPositionGlobalLevel[0]];
+		}
+		const Vector3<int> cells = localMpCells(level);
+		return _mpCellLocal[level - _globalLevel - 1][((z + 2) * cells[1] + y + 2) * cells[0] + x + 2];
+	};
+
+	p2m->initTraversal();
+	p2p->initTraversal();
+	l2p->initTraversal();
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#pragma omp master
+	#endif
+	{
+		// P2P, independent of the far field; every leaf cell is the dependency object of its particles
+		_leafContainer->traverseCellPairsTasks(*p2p);
+
+		// P2M
+		for (long int leafId = 0; leafId < numLeafCells; ++leafId) {
+			if (leafCells[leafId].isHaloCell())
+				continue;
+			SHMultipoleParticle* target = &getLeafMpCell(leafCells[leafId]).multipole;
+			#if defined(_OPENMP)
+			#pragma omp task firstprivate(leafId) depend(out: *target)
+			#endif
+			P2MCompleteCell(leafId);
+		}
+
+		// M2M of the local tree, bottom up; the own cells of the global level are its root
+		for (int level = _maxLevel - 1; level >= minLocalLevel; --level) {
+			const Vector3<int> cells = localMpCells(level);
+			const Vector3<int> offset = (level == _globalLevel) ? _processorPositionGlobalLevel : Vector3<int>(2);
+			for (int z = 0; z < cells[2] - 4; ++z) {
+				for (int y = 0; y < cells[1] - 4; ++y) {
+					for (int x = 0; x < cells[0] - 4; ++x) {
+						SHMultipoleParticle *children[8];
+						for (int i = 0; i < 8; ++i) {
+							children[i] = &ownMpCell(level + 1, 2 * x + IsOdd(i), 2 * y + IsOdd(i / 2), 2 * z + IsOdd(i / 4)).multipole;
+						}
+						SHMultipoleParticle* target = &ownMpCell(level, x, y, z).multipole;
+						#if defined(_OPENMP)
+						#pragma omp task firstprivate(cells, level, offset, x, y, z) depend(in: DEPEND_LIST_8(children)) \
+							depend(out: *target)
+						#endif
+						CombineMpCell_LocalCell(cells, level, offset, x, y, z);
+					}
+				}
+			}
+		}
+
+		// M2M of the global tree, bottom up
+		for (int level = _globalLevel - 1; level >= 1; --level) {
+			const int cellsPerDim = 1 << level;
+			for (int id = 0; id < cellsPerDim * cellsPerDim * cellsPerDim; ++id) {
+				SHMultipoleParticle *children[8];
+				for (int i = 0; i < 8; ++i) {
+					const int x = 2 * (id % cellsPerDim) + IsOdd(i);
+					const int y = 2 * ((id / cellsPerDim) % cellsPerDim) + IsOdd(i / 2);
+					const int z = 2 * (id / (cellsPerDim * cellsPerDim)) + IsOdd(i / 4);
+					children[i] = &_mpCellGlobalTop[level + 1][(z * 2 * cellsPerDim + y) * 2 * cellsPerDim + x].multipole;
+				}
+				#if defined(_OPENMP)
+				#pragma omp task firstprivate(id, level, cellsPerDim) depend(in: DEPEND_LIST_8(children)) \
+					depend(out: _mpCellGlobalTop[level][id].multipole)
+				#endif
+				M2MCompleteCell(id, level, cellsPerDim);
+			}
+		}
+
+#if defined(ENABLE_MPI)
+		// dependency objects of the communication; mpi orders all MPI calls,
+		// halo and global are released by the receives of the halo and the global multipoles
+		char mpi, halo, global;
+
+		// all multipoles of the subdomain and of the global tree are complete with the ones of level 1
+		SHMultipoleParticle *top[8];
+		for (int i = 0; i < 8; ++i) {
+			top[i] = (_globalLevel >= 1) ? &_mpCellGlobalTop[1][i].multipole
+					: &ownMpCell(1, IsOdd(i), IsOdd(i / 2), IsOdd(i / 4)).multipole;
+		}
+		#if defined(_OPENMP)
+		#pragma omp task depend(in: DEPEND_LIST_8(top)) depend(inout: mpi)
+		#endif
+		{
+			communicateHalos();
+			AllReduceMultipoleMomentsLevelToTop(_globalLevelNumCells, _globalLevel);
+		}
+
+		#if defined(_OPENMP)
+		#pragma omp task depend(inout: mpi) depend(out: halo)
+		#endif
+		{
+			while (not (_multipoleRecBufferOverlap->testIfFinished() and _multipoleBufferOverlap->testIfFinished())) {
+				#if defined(_OPENMP)
+				#pragma omp taskyield
+				#endif
+			}
+			communicateHalosOverlapSetHalos();
+			//start receiving for next iteration; important for ready send
+			_multipoleRecBufferOverlap->communicate(false);
+		}
+
+		#if defined(_OPENMP)
+		#pragma omp task depend(inout: mpi) depend(out: global)
+		#endif
+		if (_globalLevel > 0) {
+			int finished = 0;
+			while (not finished) {
+				MPI_CHECK(MPI_Test(&_allReduceRequest, &finished, MPI_STATUS_IGNORE));
+				#if defined(_OPENMP)
+				#pragma omp taskyield
+				#endif
+			}
+			AllReduceMultipoleMomentsSetValues(_globalLevelNumCells, _globalLevel);
+		}
+
+		// M2L of the global tree, only the ancestors of the own subdomain are occupied
+		for (int level = 1; level <= _globalLevel; ++level) {
+			const int cellsPerDim = 1 << level;
+			double cellWid[3];
+			for (int d = 0; d < 3; ++d) {
+				cellWid[d] = _domain->getGlobalLength(d) / cellsPerDim;
+			}
+			for (int id = 0; id < cellsPerDim * cellsPerDim * cellsPerDim; ++id) {
+				#if defined(_OPENMP)
+				#pragma omp task firstprivate(id, level, cellsPerDim, cellWid) depend(in: global) \
+					depend(inout: _mpCellGlobalTop[level][id].local)
+				#endif
+				GatherWellSepLo_GlobalCell(cellWid, cellsPerDim, level, id);
+			}
+		}
+
+		// M2L of the local tree; the sources of a cell are the children of the neighbours of its parent,
+		// which are complete as soon as these neighbours are. The sources in the halo are available
+		// after the receive, so the border cells get a second task for them.
+		for (int level = _globalLevel + 1; level <= _maxLevel; ++level) {
+			const Vector3<int> cells = localMpCells(level);
+			const int localLevel = level - _globalLevel - 1;
+			for (int z = 0; z < cells[2] - 4; ++z) {
+				for (int y = 0; y < cells[1] - 4; ++y) {
+					for (int x = 0; x < cells[0] - 4; ++x) {
+						SHMultipoleParticle *sources[27];
+						int numSources = 0;
+						if (level == 1) {
+							for (int i = 0; i < 8; ++i) {
+								sources[numSources++] = &ownMpCell(1, IsOdd(i), IsOdd(i / 2), IsOdd(i / 4)).multipole;
+							}
+						} else {
+							const Vector3<int> parentCells = localMpCells(level - 1);
+							for (int dz = -1; dz <= 1; ++dz) {
+								for (int dy = -1; dy <= 1; ++dy) {
+									for (int dx = -1; dx <= 1; ++dx) {
+										const int parent[3] = {x / 2 + dx, y / 2 + dy, z / 2 + dz};
+										bool inHalo = false;
+										for (int d = 0; d < 3; ++d) {
+											inHalo = inHalo or parent[d] < 0 or parent[d] >= parentCells[d] - 4;
+										}
+										if (inHalo)
+											continue;
+										sources[numSources++] = &ownMpCell(level - 1, parent[0], parent[1], parent[2]).multipole;
+									}
+								}
+							}
+						}
+						for (int i = numSources; i < 27; ++i) {
+							sources[i] = sources[0];
+						}
+						SHLocalParticle* target = &ownMpCell(level, x, y, z).local;
+						#if defined(_OPENMP)
+						#pragma omp task firstprivate(cells, localLevel, x, y, z) depend(in: DEPEND_LIST_27(sources)) \
+							depend(inout: *target)
+						#endif
+						GatherWellSepLo_LocalCell(cells, localLevel, 0, x + 2, y + 2, z + 2);
+
+						// cells farther away from the halo than the inner pass reaches only have inner sources
+						if (x >= 2 and y >= 2 and z >= 2 and x < cells[0] - 6 and y < cells[1] - 6 and z < cells[2] - 6)
+							continue;
+						#if defined(_OPENMP)
+						#pragma omp task firstprivate(cells, localLevel, x, y, z) depend(in: halo) depend(inout: *target)
+						#endif
+						GatherWellSepLo_LocalCell(cells, localLevel, 1, x + 2, y + 2, z + 2);
+					}
+				}
+			}
+		}
+#else
+		// M2L, the sources of a cell are the children of the neighbours of its parent,
+		// which are complete as soon as these neighbours are
+		for (int level = 1; level <= _maxLevel; ++level) {
+			const int cellsPerDim = 1 << level;
+			const int parentsPerDim = cellsPerDim / 2;
+			double cellWid[3];
+			for (int d = 0; d < 3; ++d) {
+				cellWid[d] = _domain->getGlobalLength(d) / cellsPerDim;
+			}
+			for (int id = 0; id < cellsPerDim * cellsPerDim * cellsPerDim; ++id) {
+				SHMultipoleParticle *sources[27];
+				int numSources = 0;
+				if (level == 1) {
+					for (int i = 0; i < 8; ++i) {
+						sources[numSources++] = &_mpCellGlobalTop[1][i].multipole;
+					}
+				} else {
+					const int parent[3] = {(id % cellsPerDim) / 2,
+							((id / cellsPerDim) % cellsPerDim) / 2,
+							(id / (cellsPerDim * cellsPerDim)) / 2};
+					for (int dz = -1; dz <= 1; ++dz) {
+						for (int dy = -1; dy <= 1; ++dy) {
+							for (int dx = -1; dx <= 1; ++dx) {
+								int neighbour[3] = {parent[0] + dx, parent[1] + dy, parent[2] + dz};
+								bool outside = false;
+								for (int d = 0; d < 3; ++d) {
+									if (neighbour[d] < 0 or neighbour[d] >= parentsPerDim) {
+										outside = true;
+										neighbour[d] = (neighbour[d] + parentsPerDim) % parentsPerDim;
+									}
+								}
+								if (outside and not _periodicBC)
+									continue;
+								sources[numSources++] = &_mpCellGlobalTop[level - 1][(neighbour[2] * parentsPerDim
+										+ neighbour[1]) * parentsPerDim + neighbour[0]].multipole;
+							}
+						}
+					}
+				}
+				for (int i = numSources; i < 27; ++i) {
+					sources[i] = sources[0];
+				}
+				#if defined(_OPENMP)
+				#pragma omp task firstprivate(id, level, cellsPerDim, cellWid) depend(in: DEPEND_LIST_27(sources)) \
+					depend(inout: _mpCellGlobalTop[level][id].local)
+				#endif
+				GatherWellSepLo_GlobalCell(cellWid, cellsPerDim, level, id);
+			}
+		}
+#endif
+
+		// L2L of the global tree, top down
+		for (int level = 1; level < _globalLevel; ++level) {
+			const int cellsPerDim = 1 << level;
+			for (int id = 0; id < cellsPerDim * cellsPerDim * cellsPerDim; ++id) {
+				SHLocalParticle *children[8];
+				for (int i = 0; i < 8; ++i) {
+					const int x = 2 * (id % cellsPerDim) + IsOdd(i);
+					const int y = 2 * ((id / cellsPerDim) % cellsPerDim) + IsOdd(i / 2);
+					const int z = 2 * (id / (cellsPerDim * cellsPerDim)) + IsOdd(i / 4);
+					children[i] = &_mpCellGlobalTop[level + 1][(z * 2 * cellsPerDim + y) * 2 * cellsPerDim + x].local;
+				}
+				#if defined(_OPENMP)
+				#pragma omp task firstprivate(id, level, cellsPerDim) depend(in: _mpCellGlobalTop[level][id].local) \
+					depend(inout: DEPEND_LIST_8(children))
+				#endif
+				L2LCompleteCell(id, level, cellsPerDim);
+			}
+		}
+
+		// L2L of the local tree, top down from the own cells of the global level
+		for (int level = minLocalLevel; level < _maxLevel; ++level) {
+			const Vector3<int> cells = localMpCells(level);
+			const Vector3<int> offset = (level == _globalLevel) ? _processorPositionGlobalLevel : Vector3<int>(2);
+			for (int z = 0; z < cells[2] - 4; ++z) {
+				for (int y = 0; y < cells[1] - 4; ++y) {
+					for (int x = 0; x < cells[0] - 4; ++x) {
+						SHLocalParticle *children[8];
+						for (int i = 0; i < 8; ++i) {
+							children[i] = &ownMpCell(level + 1, 2 * x + IsOdd(i), 2 * y + IsOdd(i / 2), 2 * z + IsOdd(i / 4)).local;
+						}
+						SHLocalParticle* source = &ownMpCell(level, x, y, z).local;
+						#if defined(_OPENMP)
+						#pragma omp task firstprivate(cells, level, offset, x, y, z) depend(in: *source) \
+							depend(inout: DEPEND_LIST_8(children))
+						#endif
+						PropagateCellLo_LocalCell(cells, level, offset, x, y, z);
+					}
+				}
+			}
+		}
+
+		// L2P, mutually exclusive with the P2P of the same cell
+		for (long int leafId = 0; leafId < numLeafCells; ++leafId) {
+			ParticleCellPointers* cell = &leafCells[leafId];
+			if (cell->isHaloCell())
+				continue;
+			SHLocalParticle* source = &getLeafMpCell(*cell).local;
+			#if defined(_OPENMP)
+			#pragma omp task firstprivate(leafId) depend(in: *source) depend(inout: *cell)
+			#endif
+			L2PCompleteCell(leafId);
+		}
+	} // end pragma omp parallel
+
+	l2p->endTraversal();
+	p2p->endTraversal();
+	p2m->endTraversal();
 
 	global_simulation->timers()->stop("UNIFORM_PSEUDO_PARTICLE_CONTAINER_FMM_COMPLETE");
 }
@@ -1750,11 +2108,23 @@ void UniformPseudoParticleContainer::CombineMpCell_Global(double */*cellWid*/, i
 }
 
 void UniformPseudoParticleContainer::CombineMpCell_Local(double* /*cellWid*/, Vector3<int> localMpCells, int curLevel, Vector3<int> offset){
+	int m1x, m1y, m1z;
+	int numInnerCells[3];
+	for(int d = 0; d < 3; ++d){
+		numInnerCells[d] = localMpCells[d] - 4;
+	}
+
+	for (int mloop = 0 ; mloop < numInnerCells[0] * numInnerCells[1] * numInnerCells[2]; mloop++){
+		m1x = mloop % numInnerCells[0];
+		m1y = (mloop / numInnerCells[0]) % numInnerCells[1];
+		m1z = mloop / (numInnerCells[0] * numInnerCells[1]);
+		CombineMpCell_LocalCell(localMpCells, curLevel, offset, m1x, m1y, m1z);
+	} // mloop closed
+}
+
+void UniformPseudoParticleContainer::CombineMpCell_LocalCell(Vector3<int> localMpCells, int curLevel, Vector3<int> offset, int m1x, int m1y, int m1z){
 	int iDir,
 		m1     = 0,
-		m1x,
-		m1y,
-		m1z,
 		m2     = 0;
 	int m2v[3] = {0, 0, 0};
 	//take care of halo cells
@@ -1779,41 +2149,30 @@ void UniformPseudoParticleContainer::CombineMpCell_Local(double* /*cellWid*/, Ve
 		//adjust level to local tree
 		curLevel = curLevel - _globalLevel - 1;
 	}
-	//current level plus 1
-	int numInnerCells[3];
-	for(int d = 0; d < 3; ++d){
-		numInnerCells[d] = localMpCells[d] - 4;
-	}
-
-	for (int mloop = 0 ; mloop < numInnerCells[0] * numInnerCells[1] * numInnerCells[2]; mloop++){
-		m1x = mloop % numInnerCells[0];
-		m1y = (mloop / numInnerCells[0]) % numInnerCells[1];
-		m1z = mloop / (numInnerCells[0] * numInnerCells[1]);
-		m1=((m1z+offset[2])*localMpCellsRow[1] + m1y+offset[1])*localMpCellsRow[0] + m1x+offset[0];
+	m1=((m1z+offset[2])*localMpCellsRow[1] + m1y+offset[1])*localMpCellsRow[0] + m1x+offset[0];
 
-		for(iDir=0; iDir<8; ++iDir){ //iterate over children
+	for(iDir=0; iDir<8; ++iDir){ //iterate over children
 
-			m2v[0]=2*m1x+2;
-			m2v[1]=2*m1y+2;
-			m2v[2]=2*m1z+2;
+		m2v[0]=2*m1x+2;
+		m2v[1]=2*m1y+2;
+		m2v[2]=2*m1z+2;
 
-			if(IsOdd(iDir  )) m2v[0]=m2v[0]+1;
-			if(IsOdd(iDir/2)) m2v[1]=m2v[1]+1;
-			if(IsOdd(iDir/4)) m2v[2]=m2v[2]+1;
+		if(IsOdd(iDir  )) m2v[0]=m2v[0]+1;
+		if(IsOdd(iDir/2)) m2v[1]=m2v[1]+1;
+		if(IsOdd(iDir/4)) m2v[2]=m2v[2]+1;
 
 
-			m2=(m2v[2]*localMpCellsN[1] + m2v[1])*localMpCellsN[0] + m2v[0];
+		m2=(m2v[2]*localMpCellsN[1] + m2v[1])*localMpCellsN[0] + m2v[0];
 
-			if(_mpCellLocal[curLevelp1][m2].occ==0) continue;
+		if(_mpCellLocal[curLevelp1][m2].occ==0) continue;
 
-			(*mpCellCurLevel)[curLevel][m1].occ +=_mpCellLocal[curLevelp1][m2].occ;
-			(*mpCellCurLevel)[curLevel][m1].multipole.addMultipoleParticle(_mpCellLocal[curLevelp1][m2].multipole);
+		(*mpCellCurLevel)[curLevel][m1].occ +=_mpCellLocal[curLevelp1][m2].occ;
+		(*mpCellCurLevel)[curLevel][m1].multipole.addMultipoleParticle(_mpCellLocal[curLevelp1][m2].multipole);
 
-		} // iDir closed
-		if(curLevel == _globalLevel){
-			(*mpCellCurLevel)[curLevel][m1].occ++; //ensure that complete subtree is never considered to be empty
-		}
-	} // mloop closed
+	} // iDir closed
+	if(curLevel == _globalLevel){
+		(*mpCellCurLevel)[curLevel][m1].occ++; //ensure that complete subtree is never considered to be empty
+	}
 }
 
 #define HiLim(t) ToEven(m1v[t])+ 2*_wellSep+1
@@ -1821,6 +2180,13 @@ void UniformPseudoParticleContainer::CombineMpCell_Local(double* /*cellWid*/, Ve
 
 void UniformPseudoParticleContainer::GatherWellSepLo_Global(double *cellWid, int mpCells, int curLevel){
 	global_simulation->timers()->start("UNIFORM_PSEUDO_PARTICLE_CONTAINER_GATHER_WELL_SEP_LO_GLOBAL");
+	for (int m1Loop = 0; m1Loop < mpCells * mpCells * mpCells; m1Loop++) {
+		GatherWellSepLo_GlobalCell(cellWid, mpCells, curLevel, m1Loop);
+	}
+	global_simulation->timers()->stop("UNIFORM_PSEUDO_PARTICLE_CONTAINER_GATHER_WELL_SEP_LO_GLOBAL");
+} // GatherWellSepLo closed
+
+void UniformPseudoParticleContainer::GatherWellSepLo_GlobalCell(double *cellWid, int mpCells, int curLevel, int m1Loop){
 	int m1v[3];
 	int m2v[3];
 	int m1,
@@ -1828,100 +2194,93 @@ void UniformPseudoParticleContainer::GatherWellSepLo_Global(double *cellWid, int
 		m2x,
 		m2y,
 		m2z;
-	// int m1x, m1y, m1z;
 	int m22x,
 		m22y,
 		m22z; // for periodic image
-	int _row_length;
-	_row_length = mpCells * mpCells * mpCells;
-	DomainDecompBase &domainDecomp = global_simulation->domainDecomposition();
 	Vector3<double> periodicShift;
-	for (int        m1Loop         = 0; m1Loop < _row_length; m1Loop++) {
 
-		m1v[0] = m1Loop % mpCells;
-		m1v[1] = (m1Loop / mpCells) % mpCells;
-		m1v[2] = (m1Loop / (mpCells * mpCells)) % mpCells;
-		if (_mpCellGlobalTop[curLevel][m1Loop].occ == 0)
-			continue;
-		int offsetEnd, offsetStart;
-		if (!_doNTGlobal or curLevel < _stopLevel) { // no NT in this case
-			offsetEnd   = 0;
-			offsetStart = 0;
-		} else { //iterate over tower if NT case
-			offsetStart = -2;
-			offsetEnd   = 3;
+	m1v[0] = m1Loop % mpCells;
+	m1v[1] = (m1Loop / mpCells) % mpCells;
+	m1v[2] = (m1Loop / (mpCells * mpCells)) % mpCells;
+	if (_mpCellGlobalTop[curLevel][m1Loop].occ == 0)
+		return;
+	int offsetEnd, offsetStart;
+	if (!_doNTGlobal or curLevel < _stopLevel) { // no NT in this case
+		offsetEnd   = 0;
+		offsetStart = 0;
+	} else { //iterate over tower if NT case
+		offsetStart = -2;
+		offsetEnd   = 3;
+	}
+	int      m1v1_local = m1v[1];
+	for (int yOffset    = offsetStart; yOffset <= offsetEnd; yOffset++) { //iterate over tower
+
+		if (offsetEnd != 0 or offsetStart != 0) {
+			m1v[1] = (m1v1_local & ~1) + yOffset;
+			int m11y = ((m1v1_local & ~1) + yOffset + mpCells) % mpCells;
+			m1 = (m1v[2] * mpCells + m11y) * mpCells + m1v[0];
+		} else {
+			m1 = (m1v[2] * mpCells + m1v[1]) * mpCells + m1v[0];
 		}
-		int      m1v1_local = m1v[1];
-		for (int yOffset    = offsetStart; yOffset <= offsetEnd; yOffset++) { //iterate over tower
-
-			if (offsetEnd != 0 or offsetStart != 0) {
-				m1v[1] = (m1v1_local & ~1) + yOffset;
-				int m11y = ((m1v1_local & ~1) + yOffset + mpCells) % mpCells;
-				m1 = (m1v[2] * mpCells + m11y) * mpCells + m1v[0];
+		for (m2z = LoLim(2); m2z <= HiLim(2); m2z++) {
+			if (_periodicBC == false and (m2z < 0 or m2z >= mpCells)) {
+				continue;
+			}
+			// to get periodic image
+			m22z = (mpCells + m2z) % mpCells;
+			periodicShift[2]                     = 0.0;
+			if (m2z < 0) periodicShift[2]        = -mpCells * cellWid[2];
+			if (m2z >= mpCells) periodicShift[2] = mpCells * cellWid[2];
+
+			m2v[2]   = m2z;
+			int m2yStart, m2yEnd;
+			if (_doNTGlobal && curLevel >= _stopLevel) { //guarantees that m2y stays in y interval of plate
+				m2yStart = m2yEnd = m1v1_local;
 			} else {
-				m1 = (m1v[2] * mpCells + m1v[1]) * mpCells + m1v[0];
+				m2yStart = LoLim(1);
+				m2yEnd   = HiLim(1);
 			}
-			for (m2z = LoLim(2); m2z <= HiLim(2); m2z++) {
-				if (_periodicBC == false and (m2z < 0 or m2z >= mpCells)) {
+			for (m2y = m2yStart; m2y <= m2yEnd; m2y++) {
+				if (_periodicBC == false and (m2y < 0 or m2y >= mpCells)) {
 					continue;
 				}
 				// to get periodic image
-				m22z = (mpCells + m2z) % mpCells;
-				periodicShift[2]                     = 0.0;
-				if (m2z < 0) periodicShift[2]        = -mpCells * cellWid[2];
-				if (m2z >= mpCells) periodicShift[2] = mpCells * cellWid[2];
-
-				m2v[2]   = m2z;
-				int m2yStart, m2yEnd;
+				m22y = (mpCells + m2y) % mpCells;
+				periodicShift[1] = 0.0;
 				if (_doNTGlobal && curLevel >= _stopLevel) { //guarantees that m2y stays in y interval of plate
-					m2yStart = m2yEnd = m1v1_local;
+					if (m1v[1] < 0) periodicShift[1]        = mpCells * cellWid[1];
+					if (m1v[1] >= mpCells) periodicShift[1] = -mpCells * cellWid[1];
 				} else {
-					m2yStart = LoLim(1);
-					m2yEnd   = HiLim(1);
+					if (m2y < 0) periodicShift[1]        = -mpCells * cellWid[1];
+					if (m2y >= mpCells) periodicShift[1] = mpCells * cellWid[1];
 				}
-				for (m2y = m2yStart; m2y <= m2yEnd; m2y++) {
-					if (_periodicBC == false and (m2y < 0 or m2y >= mpCells)) {
+				m2v[1]           = m2y;
+				for (m2x = LoLim(0); m2x <= HiLim(0); m2x++) {
+					if (_periodicBC == false and (m2x < 0 or m2x >= mpCells)) {
 						continue;
 					}
 					// to get periodic image
-					m22y = (mpCells + m2y) % mpCells;
-					periodicShift[1] = 0.0;
-					if (_doNTGlobal && curLevel >= _stopLevel) { //guarantees that m2y stays in y interval of plate
-						if (m1v[1] < 0) periodicShift[1]        = mpCells * cellWid[1];
-						if (m1v[1] >= mpCells) periodicShift[1] = -mpCells * cellWid[1];
-					} else {
-						if (m2y < 0) periodicShift[1]        = -mpCells * cellWid[1];
-						if (m2y >= mpCells) periodicShift[1] = mpCells * cellWid[1];
+					m22x = (mpCells + m2x) % mpCells;
+					periodicShift[0]                     = 0.0;
+					if (m2x < 0) periodicShift[0]        = -mpCells * cellWid[0];
+					if (m2x >= mpCells) periodicShift[0] = mpCells * cellWid[0];
+					//
+					m2v[0]                               = m2x;
+					m2 = (m22z * mpCells + m22y) * mpCells + m22x;
+					if (filterM2Global(curLevel, m2v, m1v, m2x, m2y, m2z, m2, yOffset)) {
+						continue;
 					}
-					m2v[1]           = m2y;
-					for (m2x = LoLim(0); m2x <= HiLim(0); m2x++) {
-						if (_periodicBC == false and (m2x < 0 or m2x >= mpCells)) {
-							continue;
-						}
-						// to get periodic image
-						m22x = (mpCells + m2x) % mpCells;
-						periodicShift[0]                     = 0.0;
-						if (m2x < 0) periodicShift[0]        = -mpCells * cellWid[0];
-						if (m2x >= mpCells) periodicShift[0] = mpCells * cellWid[0];
-						//
-						m2v[0]                               = m2x;
-						m2 = (m22z * mpCells + m22y) * mpCells + m22x;
-						if (filterM2Global(curLevel, m2v, m1v, m2x, m2y, m2z, m2, yOffset)) {
-							continue;
-						}
-						_mpCellGlobalTop[curLevel][m1].local.addMultipoleParticle(
-								_mpCellGlobalTop[curLevel][m2].multipole, periodicShift);
-						if (_doNTGlobal && curLevel >= _stopLevel) { //for NT do both directions
-							_mpCellGlobalTop[curLevel][m2].local.addMultipoleParticle(
-									_mpCellGlobalTop[curLevel][m1].multipole, -1 * periodicShift);
-						}
-					} // m2x closed
-				} // m2y closed
-			} // m2z closed
-		} // tower closed
-	} //m1 closed
-	global_simulation->timers()->stop("UNIFORM_PSEUDO_PARTICLE_CONTAINER_GATHER_WELL_SEP_LO_GLOBAL");
-} // GatherWellSepLo closed
+					_mpCellGlobalTop[curLevel][m1].local.addMultipoleParticle(
+							_mpCellGlobalTop[curLevel][m2].multipole, periodicShift);
+					if (_doNTGlobal && curLevel >= _stopLevel) { //for NT do both directions
+						_mpCellGlobalTop[curLevel][m2].local.addMultipoleParticle(
+								_mpCellGlobalTop[curLevel][m1].multipole, -1 * periodicShift);
+					}
+				} // m2x closed
+			} // m2y closed
+		} // m2z closed
+	} // tower closed
+}
 
 bool UniformPseudoParticleContainer::filterM2Global(int curLevel, int *m2v, int *m1v, int m2x, int m2y, int m2z, int m2, int yOffset){
 	//check if well separated
@@ -1982,6 +2341,19 @@ bool UniformPseudoParticleContainer::filterM2Local(bool doHalos, int m1, int m1x
 	if (_mpCellLocal[curLevel][m2].occ == 0){
 		return true;
 	}
+	//without periodic boundaries, the halo cells beyond the domain hold periodic images
+	if (not _periodicBC){
+		const int level = curLevel + _globalLevel + 1;
+		const int m1v[3] = {m1x, m1y, m1z};
+		const int m2v[3] = {m2x, m2y, m2z};
+		for (int d = 0; d < 3; d++){
+			const int firstCell = rint(_bBoxMin[d] / (_cellLength[d] * (1 << (_maxLevel - level)))) - 2;
+			if (firstCell + m1v[d] < 0 or firstCell + m1v[d] >= (1 << level) or
+				firstCell + m2v[d] < 0 or firstCell + m2v[d] >= (1 << level)){
+				return true;
+			}
+		}
+	}
 	return false;
 }
 
@@ -1991,12 +2363,8 @@ void UniformPseudoParticleContainer::GatherWellSepLo_Local(double* /*cellWid*/,
 		global_simulation->timers()->start("UNIFORM_PSEUDO_PARTICLE_CONTAINER_HALO_GATHER");
 	}
 	int m1x, m1y, m1z;
-	int m1v[3];
 	//adjust for local level
 	curLevel = curLevel - _globalLevel - 1;
-	int             m1, m2, m2x, m2y, m2z;
-	int             _row_length;
-	Vector3<double> periodicShift(0.0);
 	int             offset;
 	if (_doNTLocal) {
 		offset = 0;
@@ -2013,71 +2381,77 @@ void UniformPseudoParticleContainer::GatherWellSepLo_Local(double* /*cellWid*/,
 		m1x = mloop % xEnd + xStart;
 		m1y = (mloop / xEnd) % yEnd + yStart;
 		m1z = mloop / (xEnd * yEnd) + zStart;
-		m1 = ((m1z) * localMpCells[1] + m1y) * localMpCells[0] + m1x;
-		if (filterM1Local(doHalos, m1, m1x, m1y, m1z, localMpCells, curLevel)) { //check if m1 should be skipped
-			continue;
+		GatherWellSepLo_LocalCell(localMpCells, curLevel, doHalos, m1x, m1y, m1z);
+	} //mloop closed
+	global_simulation->timers()->stop("UNIFORM_PSEUDO_PARTICLE_CONTAINER_GATHER_WELL_SEP_LO_LOKAL");
+	if (doHalos) {
+		global_simulation->timers()->stop("UNIFORM_PSEUDO_PARTICLE_CONTAINER_HALO_GATHER");
+	}
+} // GatherWellSepLo closed
+
+void UniformPseudoParticleContainer::GatherWellSepLo_LocalCell(Vector3<int> localMpCells, int curLevel, int doHalos, int m1x, int m1y, int m1z){
+	int m1v[3];
+	int             m1, m2, m2x, m2y, m2z;
+	Vector3<double> periodicShift(0.0);
+	m1 = ((m1z) * localMpCells[1] + m1y) * localMpCells[0] + m1x;
+	if (filterM1Local(doHalos, m1, m1x, m1y, m1z, localMpCells, curLevel)) { //check if m1 should be skipped
+		return;
+	}
+	m1v[0] = m1x;
+	m1v[1] = m1y;
+	m1v[2] = m1z;
+	bool inHaloz, inHaloy, inHalox; //shows if current cell is in halo area in respective coordinate axis
+	inHaloz  = inHaloy = inHalox = 0;
+	for (m2z = LoLim(2); m2z <= HiLim(2); m2z++) {
+		if ((m2z < 2 or m2z >= localMpCells[2] - 2)) { //halo cell
+			if (!doHalos) {
+				continue;
+			}
+			if (doHalos) {
+				inHaloz = 1;
+			}
 		}
-		m1v[0] = m1x;
-		m1v[1] = m1y;
-		m1v[2] = m1z;
-		bool inHaloz, inHaloy, inHalox; //shows if current cell is in halo area in respective coordinate axis
-		inHaloz  = inHaloy = inHalox = 0;
-		for (m2z = LoLim(2); m2z <= HiLim(2); m2z++) {
-			if ((m2z < 2 or m2z >= localMpCells[2] - 2)) { //halo cell
+		for (m2y = LoLim(1); m2y <= HiLim(1); m2y++) {
+			if ((m2y < 2 or m2y >= localMpCells[1] - 2)) { //halo cell
 				if (!doHalos) {
 					continue;
 				}
 				if (doHalos) {
-					inHaloz = 1;
+					if (_doNTLocal) {//m2 not in y halo allowed in NT (m2 in plate and not in tower)
+						continue;
+					} else {
+						inHaloy = 1;
+					}
 				}
 			}
-			for (m2y = LoLim(1); m2y <= HiLim(1); m2y++) {
-				if ((m2y < 2 or m2y >= localMpCells[1] - 2)) { //halo cell
+			for (m2x = LoLim(0); m2x <= HiLim(0); m2x++) {
+				if ((m2x < 2 or m2x >= localMpCells[0] - 2)) { //halo cell
 					if (!doHalos) {
 						continue;
 					}
 					if (doHalos) {
-						if (_doNTLocal) {//m2 not in y halo allowed in NT (m2 in plate and not in tower)
-							continue;
-						} else {
-							inHaloy = 1;
-						}
+						inHalox = 1;
 					}
 				}
-				for (m2x = LoLim(0); m2x <= HiLim(0); m2x++) {
-					if ((m2x < 2 or m2x >= localMpCells[0] - 2)) { //halo cell
-						if (!doHalos) {
-							continue;
-						}
-						if (doHalos) {
-							inHalox = 1;
-						}
-					}
-					m2      = (m2z * localMpCells[1] + m2y) * localMpCells[0] + m2x;
-					if (filterM2Local(doHalos, m1, m1x, m1y, m1z, m2, m2x, m2y, m2z, localMpCells, curLevel, inHaloz,
-									  inHaloy, inHalox)) { //check if this m2 value needs to be skipped
-						inHalox = 0;
-						continue;
-					}
+				m2      = (m2z * localMpCells[1] + m2y) * localMpCells[0] + m2x;
+				if (filterM2Local(doHalos, m1, m1x, m1y, m1z, m2, m2x, m2y, m2z, localMpCells, curLevel, inHaloz,
+								  inHaloy, inHalox)) { //check if this m2 value needs to be skipped
 					inHalox = 0;
-					_mpCellLocal[curLevel][m1].local.addMultipoleParticle(
-							_mpCellLocal[curLevel][m2].multipole, periodicShift);
-					if (_doNTLocal and doHalos) {
-						_mpCellLocal[curLevel][m2].local.addMultipoleParticle(
-								_mpCellLocal[curLevel][m1].multipole, -1 * periodicShift);
-					}
-				} // m2x closed
-				inHaloy  = 0;
-			} // m2y closed
-			inHaloz  = 0;
-		} // m2z closed
-
-	} //mloop closed
-	global_simulation->timers()->stop("UNIFORM_PSEUDO_PARTICLE_CONTAINER_GATHER_WELL_SEP_LO_LOKAL");
-	if (doHalos) {
-		global_simulation->timers()->stop("UNIFORM_PSEUDO_PARTICLE_CONTAINER_HALO_GATHER");
-	}
-} // GatherWellSepLo closed
+					continue;
+				}
+				inHalox = 0;
+				_mpCellLocal[curLevel][m1].local.addMultipoleParticle(
+						_mpCellLocal[curLevel][m2].multipole, periodicShift);
+				if (_doNTLocal and doHalos) {
+					_mpCellLocal[curLevel][m2].local.addMultipoleParticle(
+							_mpCellLocal[curLevel][m1].multipole, -1 * periodicShift);
+				}
+			} // m2x closed
+			inHaloy  = 0;
+		} // m2y closed
+		inHaloz  = 0;
+	} // m2z closed
+}
 
 #ifdef FMM_FFT
 void UniformPseudoParticleContainer::GatherWellSepLo_FFT_Global(double *cellWid, int mpCells, int curLevel) {
@@ -3110,10 +3484,24 @@ void UniformPseudoParticleContainer::P2MCompleteCell(int sourceId) {
 
 void UniformPseudoParticleContainer::PropagateCellLo_Local(double* /*cellWid*/, Vector3<int> localMpCells, int curLevel, Vector3<int> offset){
 	global_simulation->timers()->start("UNIFORM_PSEUDO_PARTICLE_CONTAINER_PROPAGATE_CELL_LO_LOKAL");
-	//	int m1v[3];
+	int m1x, m1y, m1z;
+	int      numInnerCells[3];
+	for (int d     = 0; d < 3; d++) {
+		numInnerCells[d] = localMpCells[d] - 4;
+	}
+	for (int mloop = 0; mloop < numInnerCells[0] * numInnerCells[1] * numInnerCells[2]; mloop++) {
+		m1x = mloop % numInnerCells[0];
+		m1y = (mloop / numInnerCells[0]) % numInnerCells[1];
+		m1z = mloop / (numInnerCells[0] * numInnerCells[1]);
+		PropagateCellLo_LocalCell(localMpCells, curLevel, offset, m1x, m1y, m1z);
+	}
+	global_simulation->timers()->stop("UNIFORM_PSEUDO_PARTICLE_CONTAINER_PROPAGATE_CELL_LO_LOKAL");
+} // PropogateCellLo_MPI
+
+void UniformPseudoParticleContainer::PropagateCellLo_LocalCell(Vector3<int> localMpCells, int curLevel, Vector3<int> offset, int m1x, int m1y, int m1z){
 	int m2v[3];
 
-	int iDir, m1, m1x, m1y, m1z, m2;
+	int iDir, m1, m2;
 
 	Vector3<int> localMpCellsN;
 	for (int     i = 0; i < 3; i++) {
@@ -3136,40 +3524,30 @@ void UniformPseudoParticleContainer::PropagateCellLo_Local(double* /*cellWid*/,
 		//adjust level to local tree
 		curLevel        = curLevel - _globalLevel - 1;
 	}
-	int      numInnerCells[3];
-	for (int d     = 0; d < 3; d++) {
-		numInnerCells[d] = localMpCells[d] - 4;
-	}
-	for (int mloop = 0; mloop < numInnerCells[0] * numInnerCells[1] * numInnerCells[2]; mloop++) {
-		m1x = mloop % numInnerCells[0];
-		m1y = (mloop / numInnerCells[0]) % numInnerCells[1];
-		m1z = mloop / (numInnerCells[0] * numInnerCells[1]);
-		m1 = ((m1z + offset[2]) * localMpCellsRow[1] + m1y + offset[1]) * localMpCellsRow[0] + m1x + offset[0];
+	m1 = ((m1z + offset[2]) * localMpCellsRow[1] + m1y + offset[1]) * localMpCellsRow[0] + m1x + offset[0];
 
-		if ((*mpCellCurLevel)[curLevel][m1].occ == 0) { //only iterate over non empty cells
-			continue;
-		}
+	if ((*mpCellCurLevel)[curLevel][m1].occ == 0) { //only iterate over non empty cells
+		return;
+	}
 
-		for (iDir = 0; iDir < 8; iDir++) { //iterate over 8 children of m1
-			//adjust for halo
-			m2v[0] = 2 * m1x + 2;
-			m2v[1] = 2 * m1y + 2;
-			m2v[2] = 2 * m1z + 2;
+	for (iDir = 0; iDir < 8; iDir++) { //iterate over 8 children of m1
+		//adjust for halo
+		m2v[0] = 2 * m1x + 2;
+		m2v[1] = 2 * m1y + 2;
+		m2v[2] = 2 * m1z + 2;
 
-			if (IsOdd(iDir)) m2v[0]     = m2v[0] + 1;
-			if (IsOdd(iDir / 2)) m2v[1] = m2v[1] + 1;
-			if (IsOdd(iDir / 4)) m2v[2] = m2v[2] + 1;
+		if (IsOdd(iDir)) m2v[0]     = m2v[0] + 1;
+		if (IsOdd(iDir / 2)) m2v[1] = m2v[1] + 1;
+		if (IsOdd(iDir / 4)) m2v[2] = m2v[2] + 1;
 
-			m2 = (m2v[2] * localMpCellsN[1] + m2v[1]) * localMpCellsN[0] + m2v[0];
+		m2 = (m2v[2] * localMpCellsN[1] + m2v[1]) * localMpCellsN[0] + m2v[0];
 
-			(*mpCellCurLevel)[curLevel][m1].local.actOnLocalParticle(
-					_mpCellLocal[curLevelp1][m2].local); //L2L operation
-		} // iDir
-	}
-	global_simulation->timers()->stop("UNIFORM_PSEUDO_PARTICLE_CONTAINER_PROPAGATE_CELL_LO_LOKAL");
-} // PropogateCellLo_MPI
+		(*mpCellCurLevel)[curLevel][m1].local.actOnLocalParticle(
+				_mpCellLocal[curLevelp1][m2].local); //L2L operation
+	} // iDir
+}
 
-void UniformPseudoParticleContainer::processMultipole(ParticleCellPointers& cell){
+MpCell& UniformPseudoParticleContainer::getLeafMpCell(ParticleCellPointers& cell){
 	int                               cellIndexV[3];
 	std::vector<std::vector<MpCell> > *mpCellMaxLevel;
 	int                               maxLevel;
@@ -3213,7 +3591,11 @@ void UniformPseudoParticleContainer::processMultipole(ParticleCellPointers& cell
 #else
 	int cellIndex = ((_globalNumCellsPerDim * cellIndexV[2] + cellIndexV[1]) * _globalNumCellsPerDim) + cellIndexV[0];
 #endif
+	return (*mpCellMaxLevel)[maxLevel][cellIndex];
+}
 
+void UniformPseudoParticleContainer::processMultipole(ParticleCellPointers& cell){
+	MpCell& mpCell = getLeafMpCell(cell);
 
 //	mardyn_assert(cell.isInActiveWindow());
 
@@ -3236,54 +3618,16 @@ void UniformPseudoParticleContainer::processMultipole(ParticleCellPointers& cell
 			}    // for k closed
 
 			bhfmm::Vector3<double> site_pos_vec3(dr);
-			(*mpCellMaxLevel)[maxLevel][cellIndex].multipole.addSource(site_pos_vec3, chargei.q());
+			mpCell.multipole.addSource(site_pos_vec3, chargei.q());
 
 		}// for j closed
 	} // current particle closed
 
-	(*mpCellMaxLevel)[maxLevel][cellIndex].occ = Occupied;
+	mpCell.occ = Occupied;
 }
 
 void UniformPseudoParticleContainer::processFarField(ParticleCellPointers& cell) {
-	int                               cellIndexV[3];
-	std::vector<std::vector<MpCell> > *mpCellMaxLevel;
-
-	int maxLevel;
-	if (_maxLevel == _globalLevel) {
-		mpCellMaxLevel = &_mpCellGlobalTop;
-		maxLevel       = _maxLevel;
-	} else {
-		mpCellMaxLevel = &_mpCellLocal;
-		maxLevel       = _maxLevel - _globalLevel - 1;
-	}
-	for (int i = 0; i < 3; i++) {
-#if defined(ENABLE_MPI)
-		if(_maxLevel == _globalLevel){
-			cellIndexV[i] = rint(cell.getBoxMin(i) / _cellLength[i]);
-		}
-		else{
-			cellIndexV[i] = rint((cell.getBoxMin(i)-_bBoxMin[i]) / _cellLength[i]) + 2;
-		}
-#else
-		cellIndexV[i] = rint(cell.getBoxMin(i) / _cellLength[i]);
-#endif
-	}
-
-#if defined(ENABLE_MPI)
-	int cellIndex;
-	if (_maxLevel == _globalLevel){
-		cellIndex = ((_globalNumCellsPerDim * cellIndexV[2] + cellIndexV[1]) * _globalNumCellsPerDim) + cellIndexV[0];
-	}
-	else{
-		Vector3<int> numCellsOnLocalMaxLevel;
-		for(int i = 0; i < 3; i++){
-			numCellsOnLocalMaxLevel[i] = (_globalNumCellsPerDim / _numProcessorsPerDim[i] + 4);
-		}
-		cellIndex = ((numCellsOnLocalMaxLevel[1] * cellIndexV[2] + cellIndexV[1])	* numCellsOnLocalMaxLevel[0]) + cellIndexV[0];
-	}
-#else
-	int cellIndex = ((_globalNumCellsPerDim * cellIndexV[2] + cellIndexV[1]) * _globalNumCellsPerDim) + cellIndexV[0];
-#endif
+	MpCell& mpCell = getLeafMpCell(cell);
 
 	SolidHarmonicsExpansion leLocal(_maxOrd);
 
@@ -3311,26 +3655,33 @@ void UniformPseudoParticleContainer::processFarField(ParticleCellPointers& cell)
 				dr[k] = molecule1.r(k) + dii[k];
 			}       // for k closed
 
-			(*mpCellMaxLevel)[maxLevel][cellIndex].local.actOnTarget(dr, chargei.q(), u, f_vec3);
+			mpCell.local.actOnTarget(dr, chargei.q(), u, f_vec3);
 			f[0] = f_vec3[0];
 			f[1] = f_vec3[1];
 			f[2] = f_vec3[2];
 
+			// like the P2P part, the virial is taken at the molecule center. Summed over all
+			// targets, this covers both ends of every far field pair, hence no factor 0.5.
 			double   virial = 0.0;
 			for (int l      = 0; l < 3; l++) {
-				virial += -f[l] * dr[l];
+				virial += f[l] * molecule1.r(l);
 			}
-			P_xxSum += 0.5 * -f[0] * dr[0];
-			P_yySum += 0.5 * -f[1] * dr[1];
-			P_zzSum += 0.5 * -f[2] * dr[2];
+			P_xxSum += f[0] * molecule1.r(0);
+			P_yySum += f[1] * molecule1.r(1);
+			P_zzSum += f[2] * molecule1.r(2);
 			molecule1.Fchargeadd(j, f);
 			uSum += 0.5 * u;
-			virialSum += 0.5 * virial;
+			virialSum += virial;
 		}// for j closed
 	} // current particle closed
 
+	#if defined(_OPENMP)
+	#pragma omp critical
+	#endif
+	{
 		_domain->setLocalUpot(uSum + _domain->getLocalUpot());
 		_domain->setLocalVirial(virialSum + _domain->getLocalVirial());
+	}
 	//	_domain->addLocalP_xx(P_xxSum);
 	//	_domain->addLocalP_yy(P_yySum);
 	//	_domain->addLocalP_zz(P_zzSum);
@@ -55,6 +55,27 @@ public:
 	void horizontalPass(VectorizedChargeP2PCellProcessor * cp);
 	void downwardPass(L2PCellProcessor *cp);
 
+	/**
+	 * \brief Complete FMM step (P2P, P2M, M2M, M2L, L2L, L2P) as one graph of OpenMP tasks.
+	 *
+	 * The near field tasks do not depend on the far field and fill the gaps of the tree passes.
+	 * Every cell of every level gets its own P2M, M2M, M2L, L2L and L2P task, which only
+	 * waits for the cells it reads. With MPI, the halo exchange and the allreduce of the
+	 * global tree are tasks as well: they start once the multipoles of the own subdomain are
+	 * complete, and their receives are the dependencies of the M2L tasks which need halo or
+	 * global multipoles. All MPI calls are issued from one task at a time.
+	 * Only call it if isTaskGraphApplicable().
+	 */
+	void runTaskGraph(P2MCellProcessor* p2m, VectorizedChargeP2PCellProcessor* p2p, L2PCellProcessor* l2p);
+
+	/**
+	 * \brief Whether runTaskGraph supports the current configuration.
+	 *
+	 * The task graph does not cover the neutral territory method and the neighbourhood
+	 * allreduce, and with MPI and OpenMP it needs MPI_THREAD_SERIALIZED.
+	 */
+	bool isTaskGraphApplicable() const;
+
 	// P2M
 	void processMultipole(ParticleCellPointers& cell);
 
@@ -146,12 +167,21 @@ private:
 	// M2M
 	void CombineMpCell_Local(double *cellWid, Vector3<int> localMpCells, int curLevel, Vector3<int> offset);
 
+	// M2M of a single inner cell, m1x, m1y, m1z count from the first inner cell
+	void CombineMpCell_LocalCell(Vector3<int> localMpCells, int curLevel, Vector3<int> offset, int m1x, int m1y, int m1z);
+
 	// M2L
 	void GatherWellSepLo_Global(double *cellWid, int mpCells, int curLevel);
 
+	// M2L of a single target cell m1Loop
+	void GatherWellSepLo_GlobalCell(double *cellWid, int mpCells, int curLevel, int m1Loop);
+
 	// M2L
 	void GatherWellSepLo_Local(double *cellWid, Vector3<int> localMpCells, int curLevel, int doHalos);
 
+	// M2L of a single target cell, curLevel is already the level of the local tree
+	void GatherWellSepLo_LocalCell(Vector3<int> localMpCells, int curLevel, int doHalos, int m1x, int m1y, int m1z);
+
 
 #ifdef FMM_FFT
 	// M2L
@@ -166,12 +196,27 @@ private:
 	void GatherWellSepLo_FFT_Local_template(double *cellWid, Vector3<int> localMpCells, int curLevel, int doHalos);
 #endif /* FMM_FFT */
 
+	// M2L of one level, dispatches to the FFT accelerated or the direct variant
+	void M2L_Global(double *cellWid, int mpCells, int curLevel);
+	void M2L_Local(double *cellWid, Vector3<int> localMpCells, int curLevel, int doHalos);
+
+	// the three passes without the leaf operations P2M, P2P and L2P
+	void upwardPassM2M();
+	void horizontalPassM2L();
+	void downwardPassL2L();
+
 	// L2L
 	void PropagateCellLo_Global(double *cellWid, int mpCells, int curLevel);
 
 	// L2L
 	void PropagateCellLo_Local(double *cellWid, Vector3<int> localMpCells, int curLevel, Vector3<int> offset);
 
+	// L2L of a single inner cell, m1x, m1y, m1z count from the first inner cell
+	void PropagateCellLo_LocalCell(Vector3<int> localMpCells, int curLevel, Vector3<int> offset, int m1x, int m1y, int m1z);
+
+	// the expansions of the leaf cell
+	MpCell& getLeafMpCell(ParticleCellPointers& cell);
+
 	// for parallelization
 	void AllReduceMultipoleMoments();
 	void AllReduceLocalMoments(int mpCells, int _curLevel);
@@ -188,3 +188,54 @@ void DttNodeTest::testDivideParticles() {
 
 	delete container;
 }
+
+void DttNodeTest::testBufferRoundTrip() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "not executing testBufferRoundTrip for more than 1 proc" << std::endl;
+		return;
+	}
+
+	double globalDomainLength[3] = {8., 8., 8.};
+	double ctr[3] = {4., 4., 4.};
+	bhfmm::Vector3<double> gDL_vec3(globalDomainLength);
+	bhfmm::Vector3<double> ctr_vec3(ctr);
+	int orderOfExpansions = 2;
+
+	ParticleContainer * container = initializeFromFile(ParticleContainerFactory::LinkedCell, "FMMCharge.inp", 1.0);
+
+	std::vector<Molecule *> particles;
+	for(auto it = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+		particles.push_back(&(*it));
+	}
+
+	bhfmm::DttNode tree(particles, 0, ctr_vec3, gDL_vec3, orderOfExpansions, 3);
+	tree.upwardPass();
+
+	const std::vector<std::function<bool(const bhfmm::DttNode&)> > descends = {
+		[](const bhfmm::DttNode&) {return true;},
+		[](const bhfmm::DttNode& node) {return node.getLevel() < 2;},
+		[](const bhfmm::DttNode&) {return false;}
+	};
+	const int expectedDepths[3] = {3, 2, 0};
+	for (int i = 0; i < 3; ++i) {
+		std::vector<double> buffer;
+		tree.writeToBuffer(buffer, descends[i]);
+
+		bhfmm::DttNode copy(std::vector<Molecule *>(), 0, ctr_vec3, gDL_vec3, orderOfExpansions);
+		int position = 0;
+		copy.readFromBuffer(buffer.data(), position);
+		ASSERT_EQUAL(static_cast<int>(buffer.size()), position);
+		ASSERT_EQUAL(expectedDepths[i], copy.getMaxDepth());
+		ASSERT_EQUAL(3, copy.getMpCell().occ);
+		ASSERT_EQUAL(0, copy.getLocalOccupancy());
+
+		std::vector<double> copyBuffer;
+		copy.writeToBuffer(copyBuffer, descends[0]);
+		ASSERT_EQUAL(buffer.size(), copyBuffer.size());
+		for (size_t j = 0; j < buffer.size(); ++j) {
+			ASSERT_DOUBLES_EQUAL(buffer[j], copyBuffer[j], 0.0);
+		}
+	}
+
+	delete container;
+}
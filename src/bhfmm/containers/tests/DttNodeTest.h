@@ -25,6 +25,8 @@ class DttNodeTest : public utils::TestWithSimulationSetup {
 
 	TEST_METHOD(testUpwardDownwardWithNoInteraction);
 
+	TEST_METHOD(testBufferRoundTrip);
+
 	TEST_SUITE_END();
 
 public:
@@ -39,6 +41,8 @@ public:
 
 	void testSoAConvertions();
 	void testUpwardDownwardWithNoInteraction();
+	//! a tree written by writeToBuffer() and rebuilt by readFromBuffer() is written the same again
+	void testBufferRoundTrip();
 private:
 	void testDepth(double cutoffRadius);
 };
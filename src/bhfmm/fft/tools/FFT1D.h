@@ -0,0 +1,229 @@
+/*
+ * FFT1D.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef FFT1D_H_
+#define FFT1D_H_
+
+#include "WrapOpenMP.h"
+
+#ifdef FFTW
+#include "bhfmm/fft/tools/FFTW_API.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+/**
+ * Unnormalized complex 1D FFTs of a fixed length, applied in place to strided lines
+ * (used by the smooth particle mesh Ewald method, see spme::SmoothParticleMeshEwald)
+ *
+ * With FFTW (FFTW, see makefile/fft.mk), every thread transforms its lines with its own FFTW_API,
+ * as the FFT acceleration of the FMM does (see FakedOptFFT).
+ * Without it, a recursive mixed radix Cooley-Tukey transform is used, which is fast for lengths
+ * with small prime factors only (see goodSize()).
+ *
+ * Header only, since the sources in fft directories are only compiled for the FFT acceleration of the FMM.
+ * transform() may be called concurrently by the threads of the OpenMP team.
+ */
+class FFT1D {
+public:
+	typedef std::complex<double> Complex;
+
+	explicit FFT1D(int n) :
+			_n(n) {
+#ifdef FFTW
+		// planning is not thread safe, so all plans are made here
+		for (int i = 0; i < mardyn_get_max_threads(); ++i) {
+			_fftw_api.push_back(new FFTW_API(n, 1));
+		}
+#else
+		// radix 4 first, it has the cheapest butterfly per point
+		int rest = n;
+		while (rest % 4 == 0) {
+			_factors.push_back(4);
+			rest /= 4;
+		}
+		for (int r = 2; r * r <= rest; ++r) {
+			while (rest % r == 0) {
+				_factors.push_back(r);
+				rest /= r;
+			}
+		}
+		if (rest > 1) {
+			_factors.push_back(rest);
+		}
+		_maxFactor = 1;
+		for (int r : _factors) {
+			_maxFactor = std::max(_maxFactor, r);
+		}
+
+		for (int s = 0; s < 2; ++s) {
+			_twiddles[s].resize(n);
+			for (int j = 0; j < n; ++j) {
+				const double phi = (s == 0 ? -2.0 : 2.0) * M_PI * j / n;
+				_twiddles[s][j] = Complex(std::cos(phi), std::sin(phi));
+			}
+		}
+		_scratch.resize(mardyn_get_max_threads());
+#endif
+	}
+
+	~FFT1D() {
+#ifdef FFTW
+		for (FFTW_API* api : _fftw_api) {
+			delete api;
+		}
+#endif
+	}
+
+	FFT1D(const FFT1D&) = delete;
+	FFT1D& operator=(const FFT1D&) = delete;
+
+	int size() const {
+		return _n;
+	}
+
+	/**
+	 * Transform the line data[0], data[stride], ..., data[(n-1)*stride] in place
+	 *
+	 * @param sign -1 for the forward transform (exp(-2 pi i jk/n)), +1 for the backward one
+	 */
+	void transform(Complex* data, int stride, int sign) {
+#ifdef FFTW
+		FFTW_API& api = *_fftw_api[mardyn_get_thread_num()];
+		auto in = sign < 0 ? api.getIn_Forward() : api.getIn_Backward();
+		for (int j = 0; j < _n; ++j) {
+			in[j][0] = data[j * stride].real();
+			in[j][1] = data[j * stride].imag();
+		}
+		auto out = sign < 0 ? api.FFTAndGetOutput_Forward() : api.FFTAndGetOutput_Backward();
+		for (int j = 0; j < _n; ++j) {
+			data[j * stride] = Complex(out[j][0], out[j][1]);
+		}
+#else
+		std::vector<Complex>& scratch = _scratch[mardyn_get_thread_num()];
+		if (scratch.size() < static_cast<size_t>(2 * _n + _maxFactor)) {
+			scratch.resize(2 * _n + _maxFactor);
+		}
+		Complex* in = scratch.data();
+		Complex* out = in + _n;
+
+		for (int j = 0; j < _n; ++j) {
+			in[j] = data[j * stride];
+		}
+		recurse(in, 1, out, _n, 0, sign, out + _n);
+		for (int j = 0; j < _n; ++j) {
+			data[j * stride] = out[j];
+		}
+#endif
+	}
+
+	//! Smallest n' >= n, which has no prime factors other than 2, 3 and 5
+	static int goodSize(int n) {
+		for (int candidate = std::max(n, 1);; ++candidate) {
+			int rest = candidate;
+			for (int r : {2, 3, 5}) {
+				while (rest % r == 0) {
+					rest /= r;
+				}
+			}
+			if (rest == 1) {
+				return candidate;
+			}
+		}
+	}
+
+private:
+	int _n;
+
+#ifdef FFTW
+	//! one per thread
+	std::vector<FFTW_API*> _fftw_api;
+#else
+	//! radices of the recursion, from the outermost to the innermost
+	std::vector<int> _factors;
+	int _maxFactor;
+	//! exp(-2 pi i j/n) and exp(2 pi i j/n) for j = 0..n-1
+	std::vector<Complex> _twiddles[2];
+	//! one buffer per thread
+	std::vector<std::vector<Complex> > _scratch;
+
+	//! complex product without the inf / nan handling of std::complex
+	static Complex mul(const Complex& a, const Complex& b) {
+		return Complex(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+	}
+
+	void recurse(const Complex* in, int inStride, Complex* out, int n, int factor, int sign, Complex* tmp) const {
+		if (n == 1) {
+			out[0] = in[0];
+			return;
+		}
+
+		// decimation in time: r transforms of length m of the subsequences in[q], in[q + r], ...
+		const int r = _factors[factor];
+		const int m = n / r;
+		if (m == 1) {
+			for (int q = 0; q < r; ++q) {
+				out[q] = in[q * inStride];
+			}
+		} else {
+			for (int q = 0; q < r; ++q) {
+				recurse(in + q * inStride, inStride * r, out + q * m, m, factor + 1, sign, tmp);
+			}
+		}
+
+		const Complex* twiddles = _twiddles[sign < 0 ? 0 : 1].data();
+		const int step = _n / n;
+		for (int k = 0; k < m; ++k) {
+			tmp[0] = out[k];
+			for (int q = 1; q < r; ++q) {
+				tmp[q] = mul(out[q * m + k], twiddles[q * k * step]);
+			}
+
+			switch (r) {
+			case 2:
+				out[k] = tmp[0] + tmp[1];
+				out[m + k] = tmp[0] - tmp[1];
+				break;
+			case 3: {
+				// exp(+-2 pi i / 3) = -1/2 +- i sqrt(3)/2
+				const Complex sum = tmp[1] + tmp[2];
+				const Complex diff = (tmp[1] - tmp[2]) * (sign * 0.5 * std::sqrt(3.0));
+				const Complex base = tmp[0] - 0.5 * sum;
+				out[k] = tmp[0] + sum;
+				out[m + k] = Complex(base.real() - diff.imag(), base.imag() + diff.real());
+				out[2 * m + k] = Complex(base.real() + diff.imag(), base.imag() - diff.real());
+				break;
+			}
+			case 4: {
+				// exp(+-2 pi i / 4) = +-i
+				const Complex a = tmp[0] + tmp[2], b = tmp[0] - tmp[2];
+				const Complex c = tmp[1] + tmp[3], d = (tmp[1] - tmp[3]) * static_cast<double>(sign);
+				out[k] = a + c;
+				out[m + k] = Complex(b.real() - d.imag(), b.imag() + d.real());
+				out[2 * m + k] = a - c;
+				out[3 * m + k] = Complex(b.real() + d.imag(), b.imag() - d.real());
+				break;
+			}
+			default: {
+				const int radixStep = _n / r;
+				for (int p = 0; p < r; ++p) {
+					Complex sum = tmp[0];
+					for (int q = 1; q < r; ++q) {
+						sum += mul(tmp[q], twiddles[((q * p) % r) * radixStep]);
+					}
+					out[p * m + k] = sum;
+				}
+			}
+			}
+		}
+	}
+#endif
+};
+
+#endif
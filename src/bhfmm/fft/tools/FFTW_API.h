@@ -76,8 +76,7 @@ public:
 		fftw_free(_f_out);
 		fftw_free(_b_in);
 		fftw_free(_b_out);
-
-		fftw_cleanup();
+		// no fftw_cleanup() here, the plans of the other instances (e.g. one per thread) are still in use
 #endif
 	}
 
@@ -6,11 +6,12 @@
  */
 
 #include "CompareFMMContainersTest.h"
+#include "Domain.h"
 #include "molecules/Molecule.h"
 #include "bhfmm/FastMultipoleMethod.h"
 #include "parallel/DomainDecompBase.h"
 
-//TEST_SUITE_REGISTRATION(CompareFMMContainersTest);
+TEST_SUITE_REGISTRATION(CompareFMMContainersTest);
 
 CompareFMMContainersTest::CompareFMMContainersTest() {
 	// TODO Auto-generated constructor stub
@@ -21,21 +22,26 @@ CompareFMMContainersTest::~CompareFMMContainersTest() {
 	// TODO Auto-generated destructor stub
 }
 
-void CompareFMMContainersTest::compare(double cutoffRadius, bool periodic) {
-	if (this->_domainDecomposition->getNumProcs() != 1) {
-		test_log->info() << "Not executing CompareFMMContainerTest for more than 1 proc" << std::endl;
-		return;
-	}
-
-	double globalDomainLength[3] = {8., 8., 8.};
-	double bBoxMin[3] = {0., 0., 0.};
-	double bBoxMax[3] = {8., 8., 8.};
+void CompareFMMContainersTest::compare(double cutoffRadius, bool periodic, int adaptiveThreshold,
+		const std::string& inputFile, int orderOfExpansions, double forceTolerance, double energyTolerance) {
+	double globalDomainLength[3];
+	double bBoxMin[3];
+	double bBoxMax[3];
 	double LJCellLength[3] = {cutoffRadius, cutoffRadius, cutoffRadius};
 	unsigned LJSubdivisionFactor = 1;
-	int orderOfExpansions = 2;
 
 	// Uniform container
-	ParticleContainer * LCUniform = initializeFromFile(ParticleContainerFactory::LinkedCell, "FMMCharge.inp", cutoffRadius);
+	ParticleContainer * LCUniform = initializeFromFile(ParticleContainerFactory::LinkedCell, inputFile, cutoffRadius);
+	// the near field of both containers is computed from the halo copies of the linked cells
+	_domainDecomposition->balanceAndExchange(0., true, LCUniform, _domain);
+	// as in the simulation, the caches have to be rebuilt after the exchange, otherwise the
+	// halo copies still refer to the force storage of their originals
+	LCUniform->updateMoleculeCaches();
+	for (int d = 0; d < 3; ++d) {
+		globalDomainLength[d] = _domain->getGlobalLength(d);
+		bBoxMin[d] = _domainDecomposition->getBoundingBoxMin(d, _domain);
+		bBoxMax[d] = _domainDecomposition->getBoundingBoxMax(d, _domain);
+	}
 	bool adaptiveArg = false;
 
 	bhfmm::FastMultipoleMethod uniform;
@@ -46,31 +52,55 @@ void CompareFMMContainersTest::compare(double cutoffRadius, bool periodic) {
 	for (auto m = LCUniform->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
 		m->calcFM();
 	}
+	_domainDecomposition->collCommInit(2);
+	_domainDecomposition->collCommAppendDouble(_domain->getLocalUpot());
+	_domainDecomposition->collCommAppendDouble(_domain->getLocalVirial());
+	_domainDecomposition->collCommAllreduceSum();
+	const double upotUniform = _domainDecomposition->collCommGetDouble();
+	const double virialUniform = _domainDecomposition->collCommGetDouble();
+	_domainDecomposition->collCommFinalize();
 
 	// reset variables, which are not visible here
 	tearDown();
 	setUp();
 
 	// Adaptive container
-	ParticleContainer * LCAdaptive = initializeFromFile(ParticleContainerFactory::LinkedCell, "FMMCharge.inp", cutoffRadius);
+	ParticleContainer * LCAdaptive = initializeFromFile(ParticleContainerFactory::LinkedCell, inputFile, cutoffRadius);
+	_domainDecomposition->balanceAndExchange(0., true, LCAdaptive, _domain);
+	LCAdaptive->updateMoleculeCaches();
 	adaptiveArg = true;
 
 	bhfmm::FastMultipoleMethod adaptive;
-	adaptive.setParameters(LJSubdivisionFactor, orderOfExpansions, periodic, adaptiveArg);
+	adaptive.setParameters(LJSubdivisionFactor, orderOfExpansions, periodic, adaptiveArg, adaptiveThreshold);
 	adaptive.init(globalDomainLength, bBoxMin, bBoxMax, LJCellLength, LCAdaptive);
 
 	adaptive.computeElectrostatics(LCAdaptive);
 	for (auto m = LCAdaptive->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
 		m->calcFM();
 	}
-
-	// traverse molecules and compare forces
+	_domainDecomposition->collCommInit(2);
+	_domainDecomposition->collCommAppendDouble(_domain->getLocalUpot());
+	_domainDecomposition->collCommAppendDouble(_domain->getLocalVirial());
+	_domainDecomposition->collCommAllreduceSum();
+	const double upotAdaptive = _domainDecomposition->collCommGetDouble();
+	const double virialAdaptive = _domainDecomposition->collCommGetDouble();
+	_domainDecomposition->collCommFinalize();
+
+	// traverse molecules and compare forces, the decomposition of both runs is the same
 	auto itUniform  = LCUniform-> iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY);
 	auto itAdaptive = LCAdaptive->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY);
 	for(; itUniform.isValid() and itAdaptive.isValid(); ++itUniform, ++itAdaptive) {
-		ASSERT_DOUBLES_EQUAL_MSG("Force component x should be equal", itUniform->F(0), itAdaptive->F(0), 1e-12);
-		ASSERT_DOUBLES_EQUAL_MSG("Force component y should be equal", itUniform->F(1), itAdaptive->F(1), 1e-12);
-		ASSERT_DOUBLES_EQUAL_MSG("Force component z should be equal", itUniform->F(2), itAdaptive->F(2), 1e-12);
+		ASSERT_EQUAL(itUniform->getID(), itAdaptive->getID());
+		ASSERT_DOUBLES_EQUAL_MSG("Force component x should be equal", itUniform->F(0), itAdaptive->F(0), forceTolerance);
+		ASSERT_DOUBLES_EQUAL_MSG("Force component y should be equal", itUniform->F(1), itAdaptive->F(1), forceTolerance);
+		ASSERT_DOUBLES_EQUAL_MSG("Force component z should be equal", itUniform->F(2), itAdaptive->F(2), forceTolerance);
+	}
+	ASSERT_TRUE(not itUniform.isValid() and not itAdaptive.isValid());
+	ASSERT_DOUBLES_EQUAL_MSG("Potential should be equal", upotUniform, upotAdaptive, energyTolerance);
+	// the far field virial is taken at the absolute molecule positions, for interactions with
+	// periodic images it therefore only agrees if both containers split near and far field alike
+	if (not periodic or adaptiveThreshold == 0) {
+		ASSERT_DOUBLES_EQUAL_MSG("Virial should be equal", virialUniform, virialAdaptive, energyTolerance);
 	}
 
 	delete LCUniform;
@@ -86,6 +116,11 @@ void CompareFMMContainersTest::compareAtRadius2() {
 }
 
 void CompareFMMContainersTest::compareAtRadius4() {
+	// the linked cells need two cells per dimension, a subdomain of the 8^3 box is smaller
+	if (this->_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "Not executing compareAtRadius4 for more than 1 proc" << std::endl;
+		return;
+	}
 	compare(4.0);
 }
 
@@ -98,5 +133,94 @@ void CompareFMMContainersTest::compareAtRadius2WithoutPeriodicBC() {
 }
 
 void CompareFMMContainersTest::compareAtRadius4WithoutPeriodicBC() {
+	// the linked cells need two cells per dimension, a subdomain of the 8^3 box is smaller
+	if (this->_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "Not executing compareAtRadius4WithoutPeriodicBC for more than 1 proc" << std::endl;
+		return;
+	}
 	compare(4.0, false);
 }
+
+void CompareFMMContainersTest::compareWithThreshold() {
+	// the leaves of the adaptive tree are refined below the leaves of the uniform
+	// container, the interactions between them are then approximated by M2L. The
+	// forces (at most 4.2e-3 here) agree within 2.2e-5, potential and virial within 4e-4.
+	const double cutoffRadius = 134.266123 / 4.;
+	compare(cutoffRadius, true, 2, "VectorizationCharge.inp", 10, 5e-5, 1e-3);
+}
+
+void CompareFMMContainersTest::compareWithThresholdWithoutPeriodicBC() {
+	const double cutoffRadius = 134.266123 / 4.;
+	compare(cutoffRadius, false, 2, "VectorizationCharge.inp", 10, 5e-5, 1e-3);
+}
+
+void CompareFMMContainersTest::compareTaskGraph(double cutoffRadius, bool periodic) {
+	double globalDomainLength[3] = {8., 8., 8.};
+	double bBoxMin[3];
+	double bBoxMax[3];
+	double LJCellLength[3] = {cutoffRadius, cutoffRadius, cutoffRadius};
+	unsigned LJSubdivisionFactor = 1;
+	int orderOfExpansions = 2;
+
+	// uniform container, computed pass by pass
+	ParticleContainer * LCPasses = initializeFromFile(ParticleContainerFactory::LinkedCell, "FMMCharge.inp", cutoffRadius);
+	_domainDecomposition->balanceAndExchange(0., true, LCPasses, _domain);
+	LCPasses->updateMoleculeCaches();
+	for (int d = 0; d < 3; ++d) {
+		bBoxMin[d] = _domainDecomposition->getBoundingBoxMin(d, _domain);
+		bBoxMax[d] = _domainDecomposition->getBoundingBoxMax(d, _domain);
+	}
+
+	bhfmm::FastMultipoleMethod passes;
+	passes.setParameters(LJSubdivisionFactor, orderOfExpansions, periodic, false, 0, false);
+	passes.init(globalDomainLength, bBoxMin, bBoxMax, LJCellLength, LCPasses);
+
+	passes.computeElectrostatics(LCPasses);
+	for (auto m = LCPasses->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+		m->calcFM();
+	}
+	const double upotPasses = _domain->getLocalUpot();
+	const double virialPasses = _domain->getLocalVirial();
+
+	// reset variables, which are not visible here
+	tearDown();
+	setUp();
+
+	// uniform container, computed as task graph
+	ParticleContainer * LCTasks = initializeFromFile(ParticleContainerFactory::LinkedCell, "FMMCharge.inp", cutoffRadius);
+	_domainDecomposition->balanceAndExchange(0., true, LCTasks, _domain);
+	LCTasks->updateMoleculeCaches();
+
+	bhfmm::FastMultipoleMethod tasks;
+	tasks.setParameters(LJSubdivisionFactor, orderOfExpansions, periodic, false, 0, true);
+	tasks.init(globalDomainLength, bBoxMin, bBoxMax, LJCellLength, LCTasks);
+
+	tasks.computeElectrostatics(LCTasks);
+	for (auto m = LCTasks->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+		m->calcFM();
+	}
+
+	// every rank compares its own molecules, the decomposition of both runs is the same
+	auto itPasses = LCPasses->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY);
+	auto itTasks  = LCTasks-> iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY);
+	for(; itPasses.isValid() and itTasks.isValid(); ++itPasses, ++itTasks) {
+		ASSERT_EQUAL(itPasses->getID(), itTasks->getID());
+		ASSERT_DOUBLES_EQUAL_MSG("Force component x should be equal", itPasses->F(0), itTasks->F(0), 1e-12);
+		ASSERT_DOUBLES_EQUAL_MSG("Force component y should be equal", itPasses->F(1), itTasks->F(1), 1e-12);
+		ASSERT_DOUBLES_EQUAL_MSG("Force component z should be equal", itPasses->F(2), itTasks->F(2), 1e-12);
+	}
+	ASSERT_TRUE(not itPasses.isValid() and not itTasks.isValid());
+	ASSERT_DOUBLES_EQUAL_MSG("Potential should be equal", upotPasses, _domain->getLocalUpot(), 1e-10);
+	ASSERT_DOUBLES_EQUAL_MSG("Virial should be equal", virialPasses, _domain->getLocalVirial(), 1e-10);
+
+	delete LCPasses;
+	delete LCTasks;
+}
+
+void CompareFMMContainersTest::compareTaskGraphAtRadius2() {
+	compareTaskGraph(2.0);
+}
+
+void CompareFMMContainersTest::compareTaskGraphAtRadius2WithoutPeriodicBC() {
+	compareTaskGraph(2.0, false);
+}
@@ -21,6 +21,12 @@ class CompareFMMContainersTest: public utils::TestWithSimulationSetup {
 	TEST_METHOD(compareAtRadius2);
 	TEST_METHOD(compareAtRadius1);
 
+	TEST_METHOD(compareWithThreshold);
+	TEST_METHOD(compareWithThresholdWithoutPeriodicBC);
+
+	TEST_METHOD(compareTaskGraphAtRadius2);
+	TEST_METHOD(compareTaskGraphAtRadius2WithoutPeriodicBC);
+
 	TEST_SUITE_END();
 
 public:
@@ -33,9 +39,21 @@ public:
 	void compareAtRadius1WithoutPeriodicBC();
 	void compareAtRadius2WithoutPeriodicBC();
 	void compareAtRadius4WithoutPeriodicBC();
+	void compareWithThreshold();
+	void compareWithThresholdWithoutPeriodicBC();
+	void compareTaskGraphAtRadius2();
+	void compareTaskGraphAtRadius2WithoutPeriodicBC();
 
 private:
-	void compare(double cutoffRadius, bool periodic = true);
+	/**
+	 * adaptive container with the given threshold against the uniform container. The
+	 * forces have to agree within forceTolerance, potential and virial within energyTolerance.
+	 */
+	void compare(double cutoffRadius, bool periodic = true, int adaptiveThreshold = 0,
+			const std::string& inputFile = "FMMCharge.inp", int orderOfExpansions = 2,
+			double forceTolerance = 1e-12, double energyTolerance = 1e-12);
+	//! uniform container with and without the task graph
+	void compareTaskGraph(double cutoffRadius, bool periodic = true);
 
 };
 
@@ -471,6 +471,16 @@ void ChemicalPotential::grandcanonicalStep(
 	bool hasInsertion = true;
 	double ins[3];
 	unsigned nextid = 0;
+
+	// The Widom method neither deletes nor inserts molecules, so all test insertions see the same
+	// configuration and are evaluated as one batch.
+	if (this->isWidom()) {
+		widomInsertions(moleculeContainer, T, domain, cellProcessor, &particlePairsHandler);
+		return;
+	}
+
+	std::vector<Molecule> testMolecules(1);
+	std::vector<double> testEnergies(1);
 	while (hasDeletion || hasInsertion) {
 		if (hasDeletion) {
 			auto m = this->getDeletion(moleculeContainer, minco, maxco);
@@ -554,8 +564,9 @@ void ChemicalPotential::grandcanonicalStep(
 
 //			unsigned long cellid = moleculeContainer->getCellIndexOfMolecule(m);
 //			moleculeContainer->_cells[cellid].addParticle(m);
-			DeltaUpot = moleculeContainer->getEnergy(&particlePairsHandler, mit,
-					*cellProcessor);
+			testMolecules[0] = *mit;
+			moleculeContainer->getEnergies(&particlePairsHandler, testMolecules, testEnergies, *cellProcessor);
+			DeltaUpot = testEnergies[0];
 			domain->submitDU(this->getComponentID(), DeltaUpot, ins);
 			accept = this->decideInsertion(DeltaUpot / T);
 
@@ -598,6 +609,42 @@ void ChemicalPotential::grandcanonicalStep(
 #endif
 }
 
+void ChemicalPotential::widomInsertions(ParticleContainer* moleculeContainer, double T, Domain* domain,
+		CellProcessor* cellProcessor, ParticlePairsHandler* particlePairsHandler)
+{
+	if (!this->hasSample()) {
+		for (auto mit = moleculeContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); mit.isValid(); ++mit) {
+			if (mit->componentid() == this->getComponentID()) {
+				this->storeMolecule(*mit);
+				break;
+			}
+		}
+	}
+
+	std::vector<Molecule> testMolecules;
+	testMolecules.reserve(_remainingInsertionIDs.size());
+	double ins[3];
+	unsigned long nextid;
+	while ((nextid = this->getInsertion(ins)) > 0) {
+		Molecule tmp = this->loadMolecule();
+		for (int d = 0; d < 3; d++)
+			tmp.setr(d, ins[d]);
+		tmp.setid(nextid);
+		tmp.check(nextid);
+		testMolecules.push_back(tmp);
+	}
+
+	std::vector<double> energies;
+	moleculeContainer->getEnergies(particlePairsHandler, testMolecules, energies, *cellProcessor);
+
+	for (size_t i = 0; i < testMolecules.size(); i++) {
+		for (int d = 0; d < 3; d++)
+			ins[d] = testMolecules[i].r(d);
+		domain->submitDU(this->getComponentID(), energies[i], ins);
+		this->decideInsertion(energies[i] / T); // always rejected, but consumes the decision
+	}
+}
+
 unsigned ChemicalPotential::countParticles(
 		ParticleContainer* moleculeContainer, unsigned int cid) const
 {
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <list>
+#include <vector>
 
 #include "utils/Random.h"
 #include "molecules/Molecule.h"
@@ -9,6 +10,7 @@
 class DomainDecompBase;
 class ParticleContainer;
 class CellProcessor;
+class ParticlePairsHandler;
 class Domain;
 class ParticleIterator;
 
@@ -89,6 +91,10 @@ private:
 
 	bool moleculeStrictlyNotInBox(const Molecule& m, const double l[3], const double u[3]) const;
 
+	//! @brief evaluates all remaining test insertions of the Widom method as one batch
+	void widomInsertions(ParticleContainer* moleculeContainer, double T, Domain* domain,
+			CellProcessor* cellProcessor, ParticlePairsHandler* particlePairsHandler);
+
 	int _ownrank;  // only for debugging purposes (indicate rank in console output)
 
 	double _h;  // Plancksches Wirkungsquantum
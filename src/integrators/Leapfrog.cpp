@@ -1,6 +1,7 @@
 #include "Leapfrog.h"
 
 #include <map>
+#include <vector>
 
 #include "Domain.h"
 #include "ensemble/EnsembleBase.h"
@@ -21,6 +22,7 @@ Leapfrog::Leapfrog(double timestepLength) :	Integrator(timestepLength) {
 void Leapfrog::init() {
 	// set starting state
 	_state = STATE_POST_FORCE_CALCULATION;
+	_pendingVelocityScaling = false;
 }
 
 Leapfrog::~Leapfrog() {}
@@ -30,6 +32,12 @@ void Leapfrog::readXML(XMLfileUnits& xmlconfig) {
 	xmlconfig.getNodeValueReduced("timestep", _timestepLength);
 	global_log->info() << "Timestep: " << _timestepLength << endl;
 	mardyn_assert(_timestepLength > 0);
+
+	_deferVelocityScaling = false;
+	xmlconfig.getNodeValue("deferVelocityScaling", _deferVelocityScaling);
+	if (_deferVelocityScaling) {
+		global_log->info() << "Velocity scaling thermostat is applied at the beginning of the next time step." << endl;
+	}
 }
 
 void Leapfrog::eventForcesCalculated(ParticleContainer* molCont, Domain* domain) {
@@ -51,12 +59,31 @@ void Leapfrog::transition1to2(ParticleContainer* molCont, Domain* /*domain*/) {
 		return;
 	}
 
-	#if defined(_OPENMP)
-	#pragma omp parallel
-	#endif
-	{
-		for (auto i = molCont->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); i.isValid(); ++i) {
-			i->upd_preF(_timestepLength);
+	if (_pendingVelocityScaling) {
+		const double * const betaTrans = _pendingBetaTrans.data();
+		const double * const betaRot = _pendingBetaRot.data();
+
+		#if defined(_OPENMP)
+		#pragma omp parallel
+		#endif
+		{
+			for (auto i = molCont->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); i.isValid(); ++i) {
+				const unsigned cid = i->componentid();
+				i->scale_v(betaTrans[cid]);
+				i->scale_D(betaRot[cid]);
+				i->upd_preF(_timestepLength);
+			}
+		}
+		_pendingVelocityScaling = false;
+	}
+	else {
+		#if defined(_OPENMP)
+		#pragma omp parallel
+		#endif
+		{
+			for (auto i = molCont->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); i.isValid(); ++i) {
+				i->upd_preF(_timestepLength);
+			}
 		}
 	}
 
@@ -83,33 +110,46 @@ void Leapfrog::transition2to3(ParticleContainer* molCont, Domain* domain) {
 	map<int, double> sumIw2;
 	double dt_half = 0.5 * this->_timestepLength;
 	if (domain->severalThermostats()) {
+		// accumulate per component, so that no map lookup is needed per molecule
+		std::vector<Component>& components = *(_simulation.getEnsemble()->getComponents());
+		const size_t numComponents = components.size();
+		std::vector<unsigned long> N_c(numComponents, 0);
+		std::vector<double> summv2_c(numComponents, 0.0);
+		std::vector<double> sumIw2_c(numComponents, 0.0);
+
 		#if defined(_OPENMP)
 		#pragma omp parallel
 		#endif
 		{
-			map<int, unsigned long> N_l;
-			map<int, unsigned long> rotDOF_l;
-			map<int, double> summv2_l;
-			map<int, double> sumIw2_l;
+			std::vector<unsigned long> N_l(numComponents, 0);
+			std::vector<double> summv2_l(numComponents, 0.0);
+			std::vector<double> sumIw2_l(numComponents, 0.0);
 
 			for (auto tM = molCont->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); tM.isValid(); ++tM) {
-				int cid = tM->componentid();
-				int thermostat = domain->getThermostat(cid);
-				tM->upd_postF(dt_half, summv2_l[thermostat], sumIw2_l[thermostat]);
-				N_l[thermostat]++;
-				rotDOF_l[thermostat] += tM->component()->getRotationalDegreesOfFreedom();
+				const unsigned cid = tM->componentid();
+				tM->upd_postF(dt_half, summv2_l[cid], sumIw2_l[cid]);
+				N_l[cid]++;
 			}
 
 			#if defined(_OPENMP)
 			#pragma omp critical (thermostat)
 			#endif
 			{
-				for (auto & it : N_l) N[it.first] += it.second;
-				for (auto & it : rotDOF_l) rotDOF[it.first] += it.second;
-				for (auto & it : summv2_l) summv2[it.first] += it.second;
-				for (auto & it : sumIw2_l) sumIw2[it.first] += it.second;
+				for (size_t cid = 0; cid < numComponents; ++cid) {
+					N_c[cid] += N_l[cid];
+					summv2_c[cid] += summv2_l[cid];
+					sumIw2_c[cid] += sumIw2_l[cid];
+				}
 			}
 		}
+
+		for (size_t cid = 0; cid < numComponents; ++cid) {
+			int thermostat = domain->getThermostat(cid);
+			N[thermostat] += N_c[cid];
+			rotDOF[thermostat] += N_c[cid] * components[cid].getRotationalDegreesOfFreedom();
+			summv2[thermostat] += summv2_c[cid];
+			sumIw2[thermostat] += sumIw2_c[cid];
+		}
 	}
 	else {
 		#if defined(_OPENMP)
@@ -156,4 +196,42 @@ void Leapfrog::transition3to1(ParticleContainer* /*molCont*/, Domain* /*domain*/
 	else {
 		global_log->error() << "Leapfrog::transition3to1(...): Wrong state for state transition" << endl;
 	}
-}
\ No newline at end of file
+}
+
+void Leapfrog::deferVelocityScaling(Domain* domain) {
+	std::vector<Component>& components = *(_simulation.getEnsemble()->getComponents());
+	_pendingBetaTrans.resize(components.size());
+	_pendingBetaRot.resize(components.size());
+	for (size_t cid = 0; cid < components.size(); ++cid) {
+		if (domain->severalThermostats()) {
+			int thermostat = domain->getThermostat(cid);
+			_pendingBetaTrans[cid] = domain->getGlobalBetaTrans(thermostat);
+			_pendingBetaRot[cid] = domain->getGlobalBetaRot(thermostat);
+		}
+		else {
+			_pendingBetaTrans[cid] = domain->getGlobalBetaTrans();
+			_pendingBetaRot[cid] = domain->getGlobalBetaRot();
+		}
+	}
+	_pendingVelocityScaling = true;
+}
+
+void Leapfrog::applyDeferredVelocityScaling(ParticleContainer* molCont) {
+	if (not _pendingVelocityScaling) {
+		return;
+	}
+	const double * const betaTrans = _pendingBetaTrans.data();
+	const double * const betaRot = _pendingBetaRot.data();
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		for (auto i = molCont->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); i.isValid(); ++i) {
+			const unsigned cid = i->componentid();
+			i->scale_v(betaTrans[cid]);
+			i->scale_D(betaRot[cid]);
+		}
+	}
+	_pendingVelocityScaling = false;
+}
@@ -3,6 +3,8 @@
 
 #include "integrators/Integrator.h"
 
+#include <vector>
+
 /**
  *  TODO: unnecessarily complicated and cluttered:
  *  * remove states, transition*to*, they serve no purpose.
@@ -30,6 +32,12 @@
  *      have been calculated. The automaton can then do all necessary computations
  *      that have to be done do get from the current state to the next state
  *
+ * If deferVelocityScaling is enabled, the velocity scaling thermostat does not walk over all molecules on its own.
+ * Instead, the scaling factors are stored per component and applied in the same pass as the next "preF" step.
+ * Together with the thermostat sums, which are collected during "postF", each time step then needs only two passes
+ * over all molecules. Before plugins accessing the velocities at the end of a time step or before the next one (see
+ * PluginBase::accessesVelocitiesAt()), the pending factors are applied in a pass of their own.
+ *
  * For details about the algorithm see David Fincham's paper "Leapfrog rotational algorithms".
  * @cite Fincham-1993
  */
@@ -56,6 +64,7 @@ public:
 	 * \code{.xml}
 	   <integrator type="Leapfrog" >
 	     <timestep>DOUBLE</timestep>
+	     <deferVelocityScaling>BOOL</deferVelocityScaling> <!-- apply the velocity scaling thermostat at the beginning of the next time step; default: false -->
 	   </integrator>
 	   \endcode
 	 */
@@ -73,13 +82,44 @@ public:
 	//! checks whether the current state of the integrator allows that this method is called
 	void eventNewTimestep(ParticleContainer* molCont, Domain* domain);
 
+	//! @brief whether the velocity scaling thermostat should be applied lazily by the integrator
+	bool defersVelocityScaling() const {
+		return _deferVelocityScaling;
+	}
+
+	//! @brief store the current thermostat scaling factors of the domain for all components
+	//!
+	//! The factors are applied within the next call of eventNewTimestep, or by applyDeferredVelocityScaling.
+	void deferVelocityScaling(Domain* domain);
+
+	//! @brief apply pending velocity scaling factors immediately (e.g. before writing a checkpoint)
+	void applyDeferredVelocityScaling(ParticleContainer* molCont);
+
+	//! @brief whether scaling factors are pending, i.e. the velocities are not yet thermostatted
+	bool hasDeferredVelocityScaling() const {
+		return _pendingVelocityScaling;
+	}
+
 private:
 
+	//! apply the velocity scaling thermostat at the beginning of the next time step
+	bool _deferVelocityScaling = false;
+
+	//! whether _pendingBetaTrans and _pendingBetaRot still have to be applied
+	bool _pendingVelocityScaling = false;
+
+	//! velocity scaling factors per component
+	std::vector<double> _pendingBetaTrans;
+
+	//! angular momentum scaling factors per component
+	std::vector<double> _pendingBetaRot;
+
 	//! state in which the integrator is
 	int _state;
 
 	//! @brief calculate new positions and the first velocity halfstep
 	//!
+	//! Pending velocity scaling factors are applied in the same pass.
 	//! This method also checks whether the state is 1. If so, the calculations are done and
 	//! the state is set to 2, otherwise, an error is printed
 	void transition1to2(ParticleContainer* molCont, Domain* domain);
@@ -0,0 +1,99 @@
+/*
+ * LeapfrogTest.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#include "integrators/tests/LeapfrogTest.h"
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include "Simulation.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+
+TEST_SUITE_REGISTRATION(LeapfrogTest);
+
+LeapfrogTest::Velocities LeapfrogTest::runSimulation(const std::string& name, bool defer, const std::string& phaseSpace,
+		unsigned long steps) {
+	const std::string prefix = getTestDataFilename(name, false);
+	Simulation* simulation = new Simulation();
+	if (simulation->domainDecomposition().getRank() == 0) {
+		// the checkpoints at the end of every fifth step (<prefix>-<step/5>.restart.dat) are written by a plugin, i.e.
+		// before the velocity scaling is applied within the next time step
+		std::ofstream xml(prefix + ".xml");
+		xml << "<?xml version='1.0' encoding='UTF-8'?>\n"
+			   "<mardyn version=\"20100525\">\n"
+			   "<refunits type=\"SI\"><length unit=\"nm\">0.1</length><mass unit=\"u\">1</mass><energy unit=\"K\">1</energy></refunits>\n"
+			   "<simulation type=\"MD\">\n"
+			   "<integrator type=\"Leapfrog\"><timestep unit=\"reduced\">0.01</timestep>"
+			   "<deferVelocityScaling>" << (defer ? "true" : "false") << "</deferVelocityScaling></integrator>\n"
+			   "<run><currenttime>0</currenttime><production><steps>" << steps << "</steps></production></run>\n"
+			   "<ensemble type=\"NVT\"><temperature unit=\"reduced\">1.0</temperature>\n"
+			   "<domain type=\"box\"><lx>97</lx><ly>97</ly><lz>97</lz></domain>\n"
+			   "<components><moleculetype id=\"1\" name=\"LJ\"><site type=\"LJ126\" id=\"1\">"
+			   "<coords><x>0.0</x><y>0.0</y><z>0.0</z></coords><mass>10000.0</mass><sigma>1.0</sigma><epsilon>1.0</epsilon>"
+			   "<shifted>0</shifted></site>"
+			   "<momentsofinertia rotaxes=\"xyz\"><Ixx>0.0</Ixx><Iyy>0.0</Iyy><Izz>0.0</Izz></momentsofinertia>"
+			   "</moleculetype></components>\n"
+			   "<phasespacepoint>" << phaseSpace << "</phasespacepoint>\n"
+			   "</ensemble>\n"
+			   "<algorithm><parallelisation type=\"DomainDecomposition\"></parallelisation>"
+			   "<datastructure type=\"LinkedCells\"><cellsInCutoffRadius>1</cellsInCutoffRadius></datastructure>"
+			   "<cutoffs type=\"CenterOfMass\"><radiusLJ unit=\"reduced\">5.0</radiusLJ></cutoffs>"
+			   "<electrostatic type=\"ReactionField\"><epsilon>1.0e+10</epsilon></electrostatic></algorithm>\n"
+			   "<output><outputplugin name=\"CheckpointWriter\"><type>binary</type><writefrequency>5</writefrequency>"
+			   "<outputprefix>" << prefix << "</outputprefix><incremental>1</incremental></outputplugin></output>\n"
+			   "</simulation>\n"
+			   "</mardyn>" << std::endl;
+	}
+	simulation->domainDecomposition().barrier();
+	simulation->readConfigFile(prefix + ".xml");
+	simulation->setOutputPrefix(prefix);
+	simulation->disableFinalCheckpoint();
+	simulation->prepare_start();
+	simulation->simulate();
+
+	Velocities velocities;
+	ParticleContainer* particleContainer = simulation->getMoleculeContainer();
+	for (auto it = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+		velocities[it->getID()] = {it->v(0), it->v(1), it->v(2)};
+	}
+	delete simulation;
+	global_simulation = nullptr;
+	return velocities;
+}
+
+void LeapfrogTest::testDeferredVelocityScalingRestart() {
+	const std::string inputFile = getTestDataFilename("simple-lj-tiny.inp");
+	const std::string asciiPhaseSpace = "<file type=\"ASCII\">" + inputFile + "</file>";
+	const Velocities eager = runSimulation("leapfrog.test.eager", false, asciiPhaseSpace, 10);
+	runSimulation("leapfrog.test.deferred", true, asciiPhaseSpace, 5);
+
+	// the checkpoint of the fifth step is the same
+	std::ifstream eagerCheckpoint(getTestDataFilename("leapfrog.test.eager-1.restart.dat"), std::ios::binary);
+	std::ifstream deferredCheckpoint(getTestDataFilename("leapfrog.test.deferred-1.restart.dat"), std::ios::binary);
+	const std::string eagerData((std::istreambuf_iterator<char>(eagerCheckpoint)), std::istreambuf_iterator<char>());
+	const std::string deferredData((std::istreambuf_iterator<char>(deferredCheckpoint)), std::istreambuf_iterator<char>());
+	ASSERT_TRUE(not eagerData.empty());
+	ASSERT_TRUE_MSG("checkpoint with deferred velocity scaling differs from the eager one", eagerData == deferredData);
+
+	// and continuing from it gives the state of the eager run after ten steps
+	const std::string deferredPrefix = getTestDataFilename("leapfrog.test.deferred-1.restart", false);
+	const std::string binaryPhaseSpace = "<file type=\"binary\"><header>" + deferredPrefix + ".header.xml</header><data>"
+			+ deferredPrefix + ".dat</data></file>";
+	const Velocities restarted = runSimulation("leapfrog.test.restarted", false, binaryPhaseSpace, 5);
+	ASSERT_EQUAL(eager.size(), restarted.size());
+	for (const auto& idVelocity : restarted) {
+		ASSERT_EQUAL(1ul, static_cast<unsigned long>(eager.count(idVelocity.first)));
+		for (int d = 0; d < 3; ++d) {
+			std::stringstream message;
+			message << "Molecule id=" << idVelocity.first << " v[" << d << "]";
+			ASSERT_DOUBLES_EQUAL_MSG(message.str(), eager.at(idVelocity.first)[d], idVelocity.second[d],
+					1e-12 * std::abs(eager.at(idVelocity.first)[d]));
+		}
+	}
+}
@@ -0,0 +1,51 @@
+/*
+ * LeapfrogTest.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_INTEGRATORS_TESTS_LEAPFROGTEST_H_
+#define SRC_INTEGRATORS_TESTS_LEAPFROGTEST_H_
+
+#include "utils/Testing.h"
+
+#include <array>
+#include <map>
+#include <string>
+
+/**
+ * Runs short NVT simulations with the velocity scaling thermostat and compares the deferred scaling (see
+ * Leapfrog::deferVelocityScaling()) with the eager one.
+ */
+class LeapfrogTest : public utils::Test {
+
+	TEST_SUITE(LeapfrogTest);
+	TEST_METHOD(testDeferredVelocityScalingRestart);
+	TEST_SUITE_END();
+
+public:
+	LeapfrogTest() = default;
+
+	virtual ~LeapfrogTest() = default;
+
+	/**
+	 * A checkpoint written by a plugin at the end of a time step contains the thermostatted velocities, i.e. is the
+	 * same as with eager scaling, and a restart from it continues like the eager run.
+	 */
+	void testDeferredVelocityScalingRestart();
+
+private:
+	//! velocities of the own molecules by ID
+	typedef std::map<unsigned long, std::array<double, 3>> Velocities;
+
+	/**
+	 * Run the simulation and return the final velocities.
+	 * @param name prefix of the configuration and of all output files
+	 * @param defer defer the velocity scaling
+	 * @param phaseSpace the phasespacepoint/file element
+	 * @param steps number of time steps
+	 */
+	Velocities runSimulation(const std::string& name, bool defer, const std::string& phaseSpace, unsigned long steps);
+};
+
+#endif /* SRC_INTEGRATORS_TESTS_LEAPFROGTEST_H_ */
@@ -0,0 +1,118 @@
+/*
+ * AsyncCheckpointFile.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifdef ENABLE_MPI
+
+#include "io/AsyncCheckpointFile.h"
+
+#include <cstdio>
+#include <vector>
+
+#include "io/CheckpointIndex.h"
+#include "utils/Logger.h"
+#include "utils/MPI_LargeCount.h"
+#include "utils/MPI_Info_object.h"
+
+AsyncCheckpointFile::AsyncCheckpointFile() :
+		_prefix(), _publishHeader(false), _buffer(), _fileHandle(MPI_FILE_NULL), _request(MPI_REQUEST_NULL),
+		_pending(false) {
+}
+
+void AsyncCheckpointFile::start(const std::string& prefix, ParticleContainer* particleContainer, bool writeIndex,
+		double indexBlockLength, bool publishHeader) {
+	complete();
+	_prefix = prefix;
+	_publishHeader = publishHeader;
+
+	int rank = 0;
+	MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+	if (_publishHeader and rank == 0) {
+		// the header of an older checkpoint with the same name must not refer to the data being written now
+		std::remove((prefix + ".header.xml").c_str());
+	}
+
+	// serialize the own molecules grouped by index blocks, so that every block is one contiguous range of the file
+	std::vector<CheckpointIndex::Entry> entries;
+	uint32_t moleculeSize = CheckpointIndex::serializeMolecules(particleContainer, indexBlockLength, _buffer, entries);
+	// processes without molecules need the size, too
+	MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &moleculeSize, 1, MPI_UINT32_T, MPI_MAX, MPI_COMM_WORLD));
+	if (moleculeSize == 0) {
+		// no molecules at all
+		if (_publishHeader) {
+			publishStagedHeader();
+		}
+		return;
+	}
+
+	uint64_t numMolecules_local = _buffer.size() / moleculeSize;
+	uint64_t numMolecules_exscan = 0;
+	uint64_t numMolecules_global = 0;
+	MPI_CHECK(MPI_Exscan(&numMolecules_local, &numMolecules_exscan, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD));
+	MPI_CHECK(MPI_Allreduce(&numMolecules_local, &numMolecules_global, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD));
+	if (rank == 0) {
+		numMolecules_exscan = 0;  // undefined on rank 0
+	}
+
+	MPI_Datatype moleculeType;
+	MPI_CHECK(MPI_Type_contiguous(moleculeSize, MPI_BYTE, &moleculeType));
+	MPI_CHECK(MPI_Type_commit(&moleculeType));
+	// the whole staging buffer as one element, the number of molecules may exceed the int range
+	MPI_Datatype bufferType;
+	createLargeContiguousType(numMolecules_local, moleculeType, &bufferType);
+
+	const std::string filename = prefix + ".dat";
+	MPI_Info_object mpiinfo;
+	MPI_CHECK(MPI_File_open(MPI_COMM_WORLD, filename.c_str(), MPI_MODE_WRONLY | MPI_MODE_CREATE, mpiinfo, &_fileHandle));
+	MPI_CHECK(MPI_File_set_size(_fileHandle, numMolecules_global * moleculeSize));
+	MPI_CHECK(MPI_File_iwrite_at_all(_fileHandle, numMolecules_exscan * moleculeSize, _buffer.data(), 1, bufferType,
+			&_request));
+	// the pending request keeps its own reference to the types
+	MPI_CHECK(MPI_Type_free(&bufferType));
+	MPI_CHECK(MPI_Type_free(&moleculeType));
+	_pending = true;
+
+	const std::string indexFilename = CheckpointIndex::getIndexFilename(filename);
+	if (writeIndex) {
+		CheckpointIndex::writeIndexFileMPI(indexFilename, moleculeSize, entries, numMolecules_exscan);
+	} else if (rank == 0) {
+		// an index of an older checkpoint with the same name would not match the new data
+		std::remove(indexFilename.c_str());
+	}
+}
+
+void AsyncCheckpointFile::progress() {
+	if (_pending and _request != MPI_REQUEST_NULL) {
+		int done = 0;
+		MPI_CHECK(MPI_Test(&_request, &done, MPI_STATUS_IGNORE));
+	}
+}
+
+void AsyncCheckpointFile::complete() {
+	if (not _pending) {
+		return;
+	}
+	MPI_CHECK(MPI_Wait(&_request, MPI_STATUS_IGNORE));
+	// closing is collective, so it is only done here and never depending on local progress
+	MPI_CHECK(MPI_File_close(&_fileHandle));
+	_buffer.clear();
+	_buffer.shrink_to_fit();
+	_pending = false;
+	if (_publishHeader) {
+		publishStagedHeader();
+	}
+}
+
+void AsyncCheckpointFile::publishStagedHeader() {
+	MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
+	int rank = 0;
+	MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+	if (rank == 0 and std::rename(getStagedHeaderFilename(_prefix).c_str(), (_prefix + ".header.xml").c_str()) != 0) {
+		Log::global_log->error() << "AsyncCheckpointFile: could not publish the header of " << _prefix << ".dat" << std::endl;
+	}
+	_publishHeader = false;
+}
+
+#endif /* ENABLE_MPI */
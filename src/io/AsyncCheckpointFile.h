@@ -0,0 +1,79 @@
+/*
+ * AsyncCheckpointFile.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_IO_ASYNCCHECKPOINTFILE_H_
+#define SRC_IO_ASYNCCHECKPOINTFILE_H_
+
+#ifdef ENABLE_MPI
+
+#include <mpi.h>
+#include <string>
+
+class ParticleContainer;
+
+/**
+ * Binary checkpoint data file (<prefix>.dat) written with a non-blocking collective MPI-IO request.
+ *
+ * start() copies the own molecules into a staging buffer owned by this object and starts the write, so the
+ * simulation can continue while the data is transferred. The staging buffer is released by complete(). A checkpoint
+ * writer keeping two of these objects has at most two snapshots in memory (double buffering).
+ *
+ * If asked to, the header staged in <prefix>.header.xml.part is published as <prefix>.header.xml only after the data
+ * is complete, so a header never refers to a data file which is still being written.
+ *
+ * All methods except progress() are collective over MPI_COMM_WORLD.
+ */
+class AsyncCheckpointFile {
+public:
+	AsyncCheckpointFile();
+	~AsyncCheckpointFile() = default;
+
+	AsyncCheckpointFile(const AsyncCheckpointFile&) = delete;
+	AsyncCheckpointFile& operator=(const AsyncCheckpointFile&) = delete;
+
+	/**
+	 * Snapshot the molecules and start writing them to <prefix>.dat. The spatial index is written synchronously.
+	 * A pending write of this object is completed first.
+	 * @param prefix file name without ".dat"
+	 * @param particleContainer molecules to be written (inner and boundary)
+	 * @param writeIndex also write the spatial index <prefix>.dat.idx, see CheckpointIndex
+	 * @param indexBlockLength edge length of the index blocks
+	 * @param publishHeader rename the header staged in getStagedHeaderFilename(prefix) to <prefix>.header.xml when the
+	 *        data is complete; an existing <prefix>.header.xml is removed right away
+	 */
+	void start(const std::string& prefix, ParticleContainer* particleContainer, bool writeIndex,
+			double indexBlockLength, bool publishHeader = false);
+
+	//! let the MPI library advance the pending write (local, never blocks)
+	void progress();
+
+	//! wait for the pending write, close the file and release the staging buffer
+	void complete();
+
+	bool isPending() const { return _pending; }
+
+	//! prefix of the checkpoint started last
+	const std::string& getPrefix() const { return _prefix; }
+
+	//! file the header has to be written to before start() is called with publishHeader
+	static std::string getStagedHeaderFilename(const std::string& prefix) { return prefix + ".header.xml.part"; }
+
+private:
+	//! make the staged header visible, collective to make sure that all processes closed the data file
+	void publishStagedHeader();
+
+	std::string _prefix;
+	bool _publishHeader;
+	//! serialized molecules, must stay untouched until the write is complete
+	std::string _buffer;
+	MPI_File _fileHandle;
+	MPI_Request _request;
+	bool _pending;
+};
+
+#endif /* ENABLE_MPI */
+
+#endif /* SRC_IO_ASYNCCHECKPOINTFILE_H_ */
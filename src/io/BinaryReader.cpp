@@ -20,15 +20,21 @@
 #ifdef ENABLE_MPI
 #include "parallel/ParticleData.h"
 #include "parallel/DomainDecompBase.h"
+#include "utils/MPI_Info_object.h"
+#include "utils/MPI_LargeCount.h"
 #endif
 
+#include "io/CheckpointIndex.h"
+
 #include "particleContainer/ParticleContainer.h"
 #include "utils/Logger.h"
 #include "utils/Timer.h"
 #include "utils/xmlfileUnits.h"
 
+#include <algorithm>
 #include <climits>
 #include <cstdint>
+#include <cstring>
 #include <string>
 
 using Log::global_log;
@@ -38,8 +44,57 @@ enum MoleculeFormat : uint32_t {
 	ICRVQD, IRV, ICRV
 };
 
+namespace {
+//! bytes per molecule in the data file
+uint32_t getMoleculeSize(uint32_t format) {
+	switch (format) {
+		case ICRVQD:
+			return 8 + 4 + 13 * 8;
+		case ICRV:
+			return 8 + 4 + 6 * 8;
+		case IRV:
+			return 8 + 6 * 8;
+		default:
+			return 0;
+	}
+}
+
+template <typename T>
+void readValue(const char*& data, T& value) {
+	std::memcpy(&value, data, sizeof(T));
+	data += sizeof(T);
+}
+
+//! decode one molecule of the data file, the component id is returned as stored (starting at 1)
+void decodeMolecule(const char* data, uint32_t format, uint64_t& id, uint32_t& componentid, double r[3], double v[3],
+		double q[4], double D[3]) {
+	readValue(data, id);
+	componentid = 1;
+	if (format != IRV) {
+		readValue(data, componentid);
+	}
+	for (int d = 0; d < 3; ++d) {
+		readValue(data, r[d]);
+	}
+	for (int d = 0; d < 3; ++d) {
+		readValue(data, v[d]);
+	}
+	q[0] = 1.;
+	q[1] = q[2] = q[3] = 0.;
+	D[0] = D[1] = D[2] = 0.;
+	if (format == ICRVQD) {
+		for (int i = 0; i < 4; ++i) {
+			readValue(data, q[i]);
+		}
+		for (int d = 0; d < 3; ++d) {
+			readValue(data, D[d]);
+		}
+	}
+}
+}
+
 BinaryReader::BinaryReader()
-		: _nMoleculeFormat(ICRVQD) {
+		: _useMPIIO(true), _nMoleculeFormat(ICRVQD) {
 	// TODO Auto-generated constructor stub
 }
 
@@ -63,6 +118,10 @@ void BinaryReader::readXML(XMLfileUnits& xmlconfig) {
 	global_log->info() << "phase space data file: " << pspfile << endl;
 	setPhaseSpaceHeaderFile(pspheaderfile);
 	setPhaseSpaceFile(pspfile);
+
+	int useMPIIO = 1;
+	xmlconfig.getNodeValue("mpiio", useMPIIO);
+	_useMPIIO = (useMPIIO != 0);
 }
 
 void BinaryReader::setPhaseSpaceFile(string filename) {
@@ -122,6 +181,17 @@ void BinaryReader::readPhaseSpaceHeader(Domain* domain, double timestep) {
 unsigned long
 BinaryReader::readPhaseSpace(ParticleContainer* particleContainer, Domain* domain, DomainDecompBase* domainDecomp) {
 
+#ifdef ENABLE_MPI
+	if (_useMPIIO) {
+		if (_simulation.getEnsemble()->getType() == muVT) {
+			// the grand canonical ensemble needs a sample molecule of every component on every process
+			global_log->info() << "muVT ensemble: reading the phase space on rank 0 and broadcasting it." << endl;
+		} else {
+			return readPhaseSpaceMPIIO(particleContainer, domain, domainDecomp);
+		}
+	}
+#endif
+
 	Timer inputTimer;
 	inputTimer.start();
 
@@ -319,3 +389,239 @@ BinaryReader::readPhaseSpace(ParticleContainer* particleContainer, Domain* domai
 #endif
 	return maxid;
 }
+
+#ifdef ENABLE_MPI
+unsigned long BinaryReader::readPhaseSpaceMPIIO(ParticleContainer* particleContainer, Domain* domain,
+		DomainDecompBase* domainDecomp) {
+	Timer inputTimer;
+	inputTimer.start();
+
+	vector<Component>& dcomponents = *(_simulation.getEnsemble()->getComponents());
+	const size_t numcomponents = dcomponents.size();
+	const int rank = domainDecomp->getRank();
+	const int numProcs = domainDecomp->getNumProcs();
+	const uint32_t moleculeSize = getMoleculeSize(_nMoleculeFormat);
+	const uint64_t numMolecules = domain->getglobalNumMolecules();
+
+	double boxMin[3];
+	double boxMax[3];
+	for (int d = 0; d < 3; ++d) {
+		boxMin[d] = particleContainer->getBoundingBoxMin(d);
+		boxMax[d] = particleContainer->getBoundingBoxMax(d);
+	}
+
+	// rank 0 reads the spatial index (if there is a valid one) and distributes it
+	const std::string indexFile = CheckpointIndex::getIndexFilename(_phaseSpaceFile);
+	std::vector<CheckpointIndex::Entry> entries;
+	uint64_t numEntries = 0;
+	if (rank == 0) {
+		CheckpointIndex::Header header;
+		if (CheckpointIndex::readIndexFile(indexFile, header, entries)) {
+			uint64_t numIndexed = 0;
+			for (const auto& entry : entries) {
+				numIndexed += entry.numMolecules;
+			}
+			if (header.moleculeSize != moleculeSize) {
+				global_log->warning() << "Ignoring index " << indexFile << ": molecule size " << header.moleculeSize
+									  << " does not match the format (" << moleculeSize << ")." << endl;
+			} else if (numIndexed != numMolecules) {
+				global_log->warning() << "Ignoring index " << indexFile << ": it describes " << numIndexed
+									  << " molecules instead of " << numMolecules << "." << endl;
+			} else {
+				numEntries = entries.size();
+			}
+		}
+	}
+	MPI_CHECK(MPI_Bcast(&numEntries, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD));
+	entries.resize(numEntries);
+	MPI_CHECK(MPI_Bcast(entries.data(), numEntries * sizeof(CheckpointIndex::Entry), MPI_BYTE, 0, MPI_COMM_WORLD));
+
+	MPI_Datatype moleculeType;
+	MPI_CHECK(MPI_Type_contiguous(moleculeSize, MPI_BYTE, &moleculeType));
+	MPI_CHECK(MPI_Type_commit(&moleculeType));
+
+	MPI_File mpifh;
+	MPI_Info_object mpiinfo;
+	if (MPI_File_open(MPI_COMM_WORLD, _phaseSpaceFile.c_str(), MPI_MODE_RDONLY, mpiinfo, &mpifh) != MPI_SUCCESS) {
+		global_log->error() << "Could not open phaseSpaceFile " << _phaseSpaceFile << endl;
+		Simulation::exit(1);
+	}
+
+	std::vector<char> buffer;
+	if (numEntries > 0) {
+		global_log->info() << "Reading phase space file " << _phaseSpaceFile << " with MPI-IO, using the index "
+						   << indexFile << endl;
+		// only the entries overlapping the own subdomain, in file order
+		std::vector<std::pair<MPI_Aint, int>> blocks;
+		for (const auto& entry : entries) {
+			if (entry.numMolecules > 0 and CheckpointIndex::overlaps(entry, boxMin, boxMax)) {
+				blocks.emplace_back(entry.firstMolecule * moleculeSize, static_cast<int>(entry.numMolecules));
+			}
+		}
+		std::sort(blocks.begin(), blocks.end());
+		std::vector<MPI_Aint> displacements;
+		std::vector<int> blocklengths;
+		uint64_t numLocal = 0;
+		for (const auto& block : blocks) {
+			displacements.push_back(block.first);
+			blocklengths.push_back(block.second);
+			numLocal += block.second;
+		}
+
+		MPI_Datatype fileType;
+		MPI_CHECK(MPI_Type_create_hindexed(blocks.size(), blocklengths.data(), displacements.data(), moleculeType,
+				&fileType));
+		MPI_CHECK(MPI_Type_commit(&fileType));
+		MPI_CHECK(MPI_File_set_view(mpifh, 0, moleculeType, fileType, "native", mpiinfo));
+		buffer.resize(numLocal * moleculeSize);
+		MPI_Datatype bufferType;
+		createLargeContiguousType(numLocal, moleculeType, &bufferType);
+		MPI_CHECK(MPI_File_read_all(mpifh, buffer.data(), 1, bufferType, MPI_STATUS_IGNORE));
+		MPI_CHECK(MPI_Type_free(&bufferType));
+		MPI_CHECK(MPI_Type_free(&fileType));
+	} else {
+		global_log->info() << "Reading phase space file " << _phaseSpaceFile
+						   << " with MPI-IO, no index found: distributing the molecules after reading." << endl;
+		const uint64_t first = numMolecules * rank / numProcs;
+		const uint64_t last = numMolecules * (rank + 1) / numProcs;
+		buffer.resize((last - first) * moleculeSize);
+		MPI_Datatype bufferType;
+		createLargeContiguousType(last - first, moleculeType, &bufferType);
+		MPI_CHECK(MPI_File_read_at_all(mpifh, first * moleculeSize, buffer.data(), 1, bufferType, MPI_STATUS_IGNORE));
+		MPI_CHECK(MPI_Type_free(&bufferType));
+	}
+	MPI_CHECK(MPI_File_close(&mpifh));
+	MPI_CHECK(MPI_Type_free(&moleculeType));
+
+	// decode the molecules read by this process
+	std::vector<Molecule> molecules;
+	const size_t numRead = buffer.size() / moleculeSize;
+	molecules.reserve(numRead);
+	for (size_t i = 0; i < numRead; ++i) {
+		uint64_t id;
+		uint32_t componentid;
+		double r[3], v[3], q[4], D[3];
+		decodeMolecule(&buffer[i * moleculeSize], _nMoleculeFormat, id, componentid, r, v, q, D);
+
+		if (componentid > numcomponents || componentid == 0) {
+			global_log->error() << "Molecule id " << id << " has wrong componentid: " << componentid << ">"
+								<< numcomponents << endl;
+			Simulation::exit(1);
+		}
+		// with an index, overlapping entries contain molecules of other processes, too
+		if (numEntries > 0 and not particleContainer->isInBoundingBox(r)) {
+			continue;
+		}
+		molecules.push_back(Molecule(id, &dcomponents[componentid - 1], r[0], r[1], r[2], v[0], v[1], v[2], q[0], q[1],
+				q[2], q[3], D[0], D[1], D[2]));
+	}
+	buffer.clear();
+	buffer.shrink_to_fit();
+
+	if (numEntries == 0) {
+		// send every molecule to the process whose bounding box contains it
+		std::vector<double> boxes(6 * numProcs);
+		double ownBox[6] = {boxMin[0], boxMin[1], boxMin[2], boxMax[0], boxMax[1], boxMax[2]};
+		MPI_CHECK(MPI_Allgather(ownBox, 6, MPI_DOUBLE, boxes.data(), 6, MPI_DOUBLE, MPI_COMM_WORLD));
+		auto isInBox = [&boxes](int proc, const std::array<double, 3>& r) {
+			for (int d = 0; d < 3; ++d) {
+				if (r[d] < boxes[6 * proc + d] or r[d] >= boxes[6 * proc + 3 + d]) {
+					return false;
+				}
+			}
+			return true;
+		};
+
+		std::vector<int> owners(molecules.size(), -1);
+		std::vector<int> sendCounts(numProcs, 0);
+		int lastOwner = rank;
+		for (size_t i = 0; i < molecules.size(); ++i) {
+			const std::array<double, 3> r = molecules[i].r_arr();
+			// molecules of the file are grouped spatially, so the owner of the previous molecule is a good guess
+			if (not isInBox(lastOwner, r)) {
+				lastOwner = -1;
+				for (int proc = 0; proc < numProcs; ++proc) {
+					if (isInBox(proc, r)) {
+						lastOwner = proc;
+						break;
+					}
+				}
+				if (lastOwner == -1) {
+					global_log->warning() << "Molecule " << molecules[i].getID() << " out of box: " << r[0] << ";"
+										  << r[1] << ";" << r[2] << endl;
+					lastOwner = rank;
+					continue;
+				}
+			}
+			owners[i] = lastOwner;
+			++sendCounts[lastOwner];
+		}
+
+		std::vector<int> sendDispls(numProcs, 0);
+		for (int proc = 1; proc < numProcs; ++proc) {
+			sendDispls[proc] = sendDispls[proc - 1] + sendCounts[proc - 1];
+		}
+		std::vector<ParticleData> sendBuffer(sendDispls[numProcs - 1] + sendCounts[numProcs - 1]);
+		std::vector<int> fill(sendDispls);
+		for (size_t i = 0; i < molecules.size(); ++i) {
+			if (owners[i] >= 0) {
+				ParticleData::MoleculeToParticleData(sendBuffer[fill[owners[i]]++], molecules[i]);
+			}
+		}
+		molecules.clear();
+
+		std::vector<int> recvCounts(numProcs);
+		MPI_CHECK(MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, MPI_COMM_WORLD));
+		std::vector<int> recvDispls(numProcs, 0);
+		for (int proc = 1; proc < numProcs; ++proc) {
+			recvDispls[proc] = recvDispls[proc - 1] + recvCounts[proc - 1];
+		}
+		std::vector<ParticleData> recvBuffer(recvDispls[numProcs - 1] + recvCounts[numProcs - 1]);
+
+		MPI_Datatype mpi_Particle;
+		ParticleData::getMPIType(mpi_Particle);
+		MPI_CHECK(MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendDispls.data(), mpi_Particle,
+				recvBuffer.data(), recvCounts.data(), recvDispls.data(), mpi_Particle, MPI_COMM_WORLD));
+		MPI_CHECK(MPI_Type_free(&mpi_Particle));
+
+		molecules.resize(recvBuffer.size());
+		for (size_t i = 0; i < recvBuffer.size(); ++i) {
+			ParticleData::ParticleDataToMolecule(recvBuffer[i], molecules[i]);
+		}
+	}
+
+	unsigned long maxid = 0;
+	std::vector<unsigned long> numMoleculesPerComponent(numcomponents, 0);
+	for (auto& m : molecules) {
+		particleContainer->addParticle(m, true, false);
+		++numMoleculesPerComponent[m.componentid()];
+		maxid = std::max(maxid, static_cast<unsigned long>(m.getID()));
+	}
+
+	// the component counts and the rotational degrees of freedom are global values
+	MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, numMoleculesPerComponent.data(), numcomponents, MPI_UNSIGNED_LONG, MPI_SUM,
+			MPI_COMM_WORLD));
+	MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &maxid, 1, MPI_UNSIGNED_LONG, MPI_MAX, MPI_COMM_WORLD));
+	unsigned long numAdded = 0;
+	for (size_t cid = 0; cid < numcomponents; ++cid) {
+		dcomponents[cid].setNumMolecules(dcomponents[cid].getNumMolecules() + numMoleculesPerComponent[cid]);
+		domain->setglobalRotDOF(domain->getglobalRotDOF()
+				+ numMoleculesPerComponent[cid] * dcomponents[cid].getRotationalDegreesOfFreedom());
+		numAdded += numMoleculesPerComponent[cid];
+	}
+	if (numAdded != numMolecules) {
+		global_log->warning() << "Read " << numAdded << " of " << numMolecules << " molecules, the others are out of box."
+							  << endl;
+	}
+	global_log->info() << "Reading Molecules done" << endl;
+
+	if(domain->getglobalRho() == 0.) {
+		domain->setglobalRho(domain->getglobalNumMolecules() / domain->getGlobalVolume());
+		global_log->info() << "Calculated Rho_global = " << domain->getglobalRho() << endl;
+	}
+
+	inputTimer.stop();
+	global_log->info() << "Initial IO took:                 " << inputTimer.get_etime() << " sec" << endl;
+	return maxid;
+}
+#endif
@@ -21,6 +21,18 @@ public:
 
 	~BinaryReader();
 
+	/** @brief Read in XML configuration for BinaryReader.
+	 *
+	 * The following xml object structure is handled by this method:
+	 * \code{.xml}
+	   <file type="binary">
+	     <header>STRING</header>
+	     <data>STRING</data>
+	     <!-- MPI only: read collectively with MPI-IO (default) or on rank 0 with broadcasts (0) -->
+	     <mpiio>INTEGER</mpiio>
+	   </file>
+	   \endcode
+	 */
 	void readXML(XMLfileUnits& xmlconfig);
 
 	//! @brief gets a filename and opens an ifstream associated with the given file
@@ -89,6 +101,17 @@ public:
 	unsigned long readPhaseSpace(ParticleContainer* particleContainer, Domain* domain, DomainDecompBase* domainDecomp);
 
 private:
+#ifdef ENABLE_MPI
+	//! @brief parallel version of readPhaseSpace using collective MPI-IO
+	//!
+	//! If a spatial index (see CheckpointIndex) exists next to the data file, every process only reads the parts of the
+	//! file overlapping its own subdomain. Otherwise, every process reads a contiguous 1/P of the file and the molecules
+	//! are sent to their owners with one MPI_Alltoallv. In both cases no process has to read or receive all molecules.
+	unsigned long readPhaseSpaceMPIIO(ParticleContainer* particleContainer, Domain* domain, DomainDecompBase* domainDecomp);
+#endif
+
+	//! use readPhaseSpaceMPIIO() in MPI builds (default), instead of reading on rank 0 and broadcasting everything
+	bool _useMPIIO;
 
 	uint32_t _nMoleculeFormat;
 	std::string _moleculeFormat;
@@ -0,0 +1,170 @@
+/*
+ * CheckpointIndex.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#include "io/CheckpointIndex.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+#include "molecules/Molecule.h"
+#include "particleContainer/ParticleContainer.h"
+
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#include "utils/Logger.h"
+#include "utils/MPI_Info_object.h"
+#include "utils/MPI_LargeCount.h"
+#endif
+
+namespace {
+const char indexMagic[8] = {'M', 'D', 'C', 'K', 'P', 'I', 'D', 'X'};
+}
+
+std::string CheckpointIndex::getIndexFilename(const std::string& dataFilename) {
+	return dataFilename + ".idx";
+}
+
+CheckpointIndex::Header CheckpointIndex::createHeader(uint32_t moleculeSize, uint64_t numEntries) {
+	Header header;
+	std::memcpy(header.magic, indexMagic, sizeof(header.magic));
+	header.version = version;
+	header.moleculeSize = moleculeSize;
+	header.numEntries = numEntries;
+	return header;
+}
+
+bool CheckpointIndex::isValid(const Header& header) {
+	return std::memcmp(header.magic, indexMagic, sizeof(header.magic)) == 0 and header.version == version;
+}
+
+uint32_t CheckpointIndex::serializeMolecules(ParticleContainer* particleContainer, double blockLength,
+		std::string& buffer, std::vector<Entry>& entries) {
+	entries.clear();
+
+	// serialize in container order and remember the block of every molecule
+	std::ostringstream stream(std::ios_base::binary);
+	std::vector<std::array<long, 3>> blocks;
+	std::vector<std::array<double, 3>> positions;
+	for (auto it = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+		it->writeBinary(stream);
+		std::array<long, 3> block = {0, 0, 0};
+		if (blockLength > 0.) {
+			for (int d = 0; d < 3; ++d) {
+				block[d] = static_cast<long>(std::floor(it->r(d) / blockLength));
+			}
+		}
+		// z major, so that blocks of the same slab are adjacent
+		blocks.push_back({block[2], block[1], block[0]});
+		positions.push_back(it->r_arr());
+	}
+	std::string serialized = stream.str();
+
+	const size_t numMolecules = blocks.size();
+	if (numMolecules == 0) {
+		buffer.clear();
+		return 0;
+	}
+	const size_t moleculeSize = serialized.size() / numMolecules;
+
+	// order by blocks (stable, to keep the cell order within a block)
+	std::vector<size_t> order(numMolecules);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&blocks](size_t a, size_t b) { return blocks[a] < blocks[b]; });
+
+	buffer.resize(serialized.size());
+	for (size_t i = 0; i < numMolecules; ++i) {
+		const size_t m = order[i];
+		std::memcpy(&buffer[i * moleculeSize], &serialized[m * moleculeSize], moleculeSize);
+
+		if (i == 0 or blocks[m] != blocks[order[i - 1]]) {
+			Entry entry;
+			for (int d = 0; d < 3; ++d) {
+				entry.boxMin[d] = positions[m][d];
+				entry.boxMax[d] = positions[m][d];
+			}
+			entry.firstMolecule = i;
+			entry.numMolecules = 0;
+			entries.push_back(entry);
+		}
+		Entry& entry = entries.back();
+		for (int d = 0; d < 3; ++d) {
+			entry.boxMin[d] = std::min(entry.boxMin[d], positions[m][d]);
+			entry.boxMax[d] = std::max(entry.boxMax[d], positions[m][d]);
+		}
+		++entry.numMolecules;
+	}
+	return static_cast<uint32_t>(moleculeSize);
+}
+
+bool CheckpointIndex::overlaps(const Entry& entry, const double boxMin[3], const double boxMax[3]) {
+	for (int d = 0; d < 3; ++d) {
+		if (entry.boxMax[d] < boxMin[d] or entry.boxMin[d] > boxMax[d]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool CheckpointIndex::readIndexFile(const std::string& filename, Header& header, std::vector<Entry>& entries) {
+	std::ifstream file(filename.c_str(), std::ios::binary | std::ios::in);
+	if (not file.is_open()) {
+		return false;
+	}
+	file.read(reinterpret_cast<char*>(&header), sizeof(Header));
+	if (not file or not isValid(header)) {
+		return false;
+	}
+	entries.resize(header.numEntries);
+	file.read(reinterpret_cast<char*>(entries.data()), header.numEntries * sizeof(Entry));
+	return static_cast<bool>(file);
+}
+
+void CheckpointIndex::writeIndexFile(const std::string& filename, uint32_t moleculeSize,
+		const std::vector<Entry>& entries) {
+	const Header header = createHeader(moleculeSize, entries.size());
+	std::ofstream file(filename.c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+}
+
+#ifdef ENABLE_MPI
+void CheckpointIndex::writeIndexFileMPI(const std::string& filename, uint32_t moleculeSize, std::vector<Entry>& entries,
+		uint64_t firstMolecule) {
+	int rank = 0;
+	MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+	uint64_t numEntries_local = entries.size();
+	uint64_t numEntries_exscan = 0;
+	uint64_t numEntries_global = 0;
+	MPI_CHECK(MPI_Exscan(&numEntries_local, &numEntries_exscan, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD));
+	MPI_CHECK(MPI_Allreduce(&numEntries_local, &numEntries_global, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD));
+	if (rank == 0) {
+		numEntries_exscan = 0;  // undefined on rank 0
+	}
+	for (auto& entry : entries) {
+		entry.firstMolecule += firstMolecule;
+	}
+
+	MPI_File mpifh;
+	MPI_Info_object mpiinfo;
+	MPI_CHECK(MPI_File_open(MPI_COMM_WORLD, filename.c_str(), MPI_MODE_WRONLY | MPI_MODE_CREATE, mpiinfo, &mpifh));
+	MPI_CHECK(MPI_File_set_size(mpifh, sizeof(Header) + numEntries_global * sizeof(Entry)));
+	if (rank == 0) {
+		const Header header = createHeader(moleculeSize, numEntries_global);
+		MPI_CHECK(MPI_File_write_at(mpifh, 0, &header, sizeof(header), MPI_BYTE, MPI_STATUS_IGNORE));
+	}
+	MPI_Datatype entriesType;
+	createLargeContiguousType(numEntries_local * sizeof(Entry), MPI_BYTE, &entriesType);
+	MPI_CHECK(MPI_File_write_at_all(mpifh, sizeof(Header) + numEntries_exscan * sizeof(Entry), entries.data(), 1,
+			entriesType, MPI_STATUS_IGNORE));
+	MPI_CHECK(MPI_Type_free(&entriesType));
+	MPI_CHECK(MPI_File_close(&mpifh));
+}
+#endif
@@ -0,0 +1,92 @@
+/*
+ * CheckpointIndex.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_IO_CHECKPOINTINDEX_H_
+#define SRC_IO_CHECKPOINTINDEX_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ParticleContainer;
+
+/**
+ * Spatial index of a binary checkpoint, written next to the data file as "<data file>.idx".
+ *
+ * The molecules of the data file are grouped into blocks of a global grid with a given edge length (or into one block
+ * per process, if no edge length is given). Every index entry describes the molecules of one block written by one
+ * process: the bounding box of their positions and their position in the data file. A parallel reader only has to read
+ * the entries overlapping its own subdomain.
+ *
+ * File layout (native byte order, like the data file): one Header followed by Header::numEntries entries.
+ */
+namespace CheckpointIndex {
+
+struct Header {
+	char magic[8];
+	uint32_t version;
+	//! bytes per molecule in the data file
+	uint32_t moleculeSize;
+	uint64_t numEntries;
+};
+
+struct Entry {
+	double boxMin[3];
+	double boxMax[3];
+	//! index of the first molecule of the entry in the data file
+	uint64_t firstMolecule;
+	uint64_t numMolecules;
+};
+
+static_assert(sizeof(Header) == 24, "unexpected padding in CheckpointIndex::Header");
+static_assert(sizeof(Entry) == 64, "unexpected padding in CheckpointIndex::Entry");
+
+constexpr uint32_t version = 1;
+
+//! name of the index file belonging to a binary data file
+std::string getIndexFilename(const std::string& dataFilename);
+
+//! header for an index with numEntries entries
+Header createHeader(uint32_t moleculeSize, uint64_t numEntries);
+
+//! check magic number and version of a header
+bool isValid(const Header& header);
+
+/**
+ * Serialize all own molecules (inner and boundary) of the container with Molecule::writeBinary(), grouped by blocks.
+ * @param particleContainer container with the molecules
+ * @param blockLength edge length of the blocks, <= 0 puts all molecules into one block
+ * @param buffer serialized molecules, ordered by blocks
+ * @param entries one entry per non-empty block, firstMolecule counts from the beginning of the buffer
+ * @return bytes per molecule, 0 if the container is empty
+ */
+uint32_t serializeMolecules(ParticleContainer* particleContainer, double blockLength, std::string& buffer,
+		std::vector<Entry>& entries);
+
+//! true if the bounding box of the entry overlaps the box [boxMin, boxMax]
+bool overlaps(const Entry& entry, const double boxMin[3], const double boxMax[3]);
+
+/**
+ * Read an index file.
+ * @return false if the file does not exist or is not a valid index
+ */
+bool readIndexFile(const std::string& filename, Header& header, std::vector<Entry>& entries);
+
+//! write an index file from a single process
+void writeIndexFile(const std::string& filename, uint32_t moleculeSize, const std::vector<Entry>& entries);
+
+#ifdef ENABLE_MPI
+/**
+ * Write an index file collectively, every process contributes its own entries.
+ * @param firstMolecule position of the first molecule of this process in the data file, added to all entries
+ */
+void writeIndexFileMPI(const std::string& filename, uint32_t moleculeSize, std::vector<Entry>& entries,
+		uint64_t firstMolecule);
+#endif
+
+} // namespace CheckpointIndex
+
+#endif /* SRC_IO_CHECKPOINTINDEX_H_ */
@@ -8,6 +8,7 @@
 #include "Common.h"
 #include "Domain.h"
 #include "parallel/DomainDecompBase.h"
+#include "plugins/compression.h"
 #include "utils/Logger.h"
 
 
@@ -26,14 +27,19 @@ void CheckpointWriter::readXML(XMLfileUnits& xmlconfig) {
 	
 	std::string checkpointType = "unknown";
 	xmlconfig.getNodeValue("type", checkpointType);
+	_useCompactFormat = false;
 	if("ASCII" == checkpointType) {
 		_useBinaryFormat = false;
 	}
 	else if("binary" == checkpointType) {
 		_useBinaryFormat = true;
 	}
+	else if("compact" == checkpointType) {
+		_useBinaryFormat = false;
+		_useCompactFormat = true;
+	}
 	else {
-		global_log->error() << "Unknown CheckpointWriter type '" << checkpointType << "', expected: ASCII|binary." << endl;
+		global_log->error() << "Unknown CheckpointWriter type '" << checkpointType << "', expected: ASCII|binary|compact." << endl;
 		Simulation::exit(-1);
 	}
 
@@ -54,6 +60,57 @@ void CheckpointWriter::readXML(XMLfileUnits& xmlconfig) {
 		_appendTimestamp = false;
 	}
 	global_log->info() << "Append timestamp: " << _appendTimestamp << endl;
+
+	int writeIndex = 0;
+	xmlconfig.getNodeValue("index", writeIndex);
+	_writeIndex = (writeIndex != 0);
+	_indexBlockLength = 0.;
+	xmlconfig.getNodeValue("indexBlockLength", _indexBlockLength);
+	if (_writeIndex) {
+		if (not _useBinaryFormat) {
+			global_log->warning() << "The spatial index is only written for binary checkpoints." << endl;
+			_writeIndex = false;
+		} else {
+			global_log->info() << "Writing spatial index with block length " << _indexBlockLength << endl;
+		}
+	}
+
+	int async = 0;
+	xmlconfig.getNodeValue("async", async);
+	_async = (async != 0);
+	if (_async) {
+#ifdef ENABLE_MPI
+		if (not _useBinaryFormat) {
+			global_log->warning() << "Asynchronous checkpoints are only written in binary format." << endl;
+			_async = false;
+		} else {
+			global_log->info() << "Writing checkpoints asynchronously." << endl;
+		}
+#else
+		global_log->warning() << "Asynchronous checkpoints are only available in the MPI version." << endl;
+		_async = false;
+#endif
+	}
+
+	if (_useCompactFormat) {
+#ifdef ENABLE_LZ4
+		_compactOptions.compression = "LZ4";
+#endif
+		xmlconfig.getNodeValue("compression", _compactOptions.compression);
+		try {
+			Compression::create(_compactOptions.compression);
+		} catch (const std::invalid_argument& e) {
+			global_log->error() << "CheckpointWriter: compression '" << _compactOptions.compression
+								<< "' not available: " << e.what() << endl;
+			Simulation::exit(-1);
+		}
+		int quantize = 0;
+		xmlconfig.getNodeValue("quantize", quantize);
+		_compactOptions.quantize = (quantize != 0);
+		xmlconfig.getNodeValue("chunkLength", _compactOptions.chunkLength);
+		global_log->info() << "Compact checkpoints: compression " << _compactOptions.compression << ", quantized positions "
+						   << _compactOptions.quantize << ", chunk length " << _compactOptions.chunkLength << endl;
+	}
 }
 
 void CheckpointWriter::init(ParticleContainer * /*particleContainer*/, DomainDecompBase * /*domainDecomp*/,
@@ -61,6 +118,11 @@ void CheckpointWriter::init(ParticleContainer * /*particleContainer*/, DomainDec
 
 void CheckpointWriter::endStep(ParticleContainer *particleContainer, DomainDecompBase *domainDecomp, Domain *domain,
                                unsigned long simstep) {
+#ifdef ENABLE_MPI
+	for (auto& file : _asyncFiles) {
+		file.progress();
+	}
+#endif
 	if( simstep % _writeFrequency == 0 ) {
 		stringstream filenamestream;
 		filenamestream << _outputPrefix;
@@ -77,15 +139,52 @@ void CheckpointWriter::endStep(ParticleContainer *particleContainer, DomainDecom
 
 		if (_useBinaryFormat) {
 			filenamestream << ".restart";
+		} else if (_useCompactFormat) {
+			filenamestream << ".restart.ckp";
 		} else { /* ASCII mode */
 			filenamestream << ".restart.dat";
 		}
 
 		string filename = filenamestream.str();
-		domain->writeCheckpoint(filename, particleContainer, domainDecomp, _simulation.getSimulationTime(), _useBinaryFormat);
+		if (_useCompactFormat) {
+			domainDecomp->assertDisjunctivity(particleContainer);
+			const double globalLength[3] = {domain->getGlobalLength(0), domain->getGlobalLength(1),
+											domain->getGlobalLength(2)};
+			CompactCheckpoint::write(filename, particleContainer, domainDecomp, _simulation.getSimulationTime(),
+					globalLength, _compactOptions);
+			return;
+		}
+#ifdef ENABLE_MPI
+		if (_async) {
+			// a checkpoint with the same name (e.g. not incremental) still in flight has to be finished first,
+			// otherwise both writes and headers race for the same files
+			for (auto& file : _asyncFiles) {
+				if (file.isPending() and file.getPrefix() == filename) {
+					file.complete();
+				}
+			}
+			// the header is staged right away and published when the molecules, which are snapshotted and written
+			// in the background, are complete
+			domainDecomp->assertDisjunctivity(particleContainer);
+			domain->updateglobalNumMolecules(particleContainer, domainDecomp);
+			domain->writeCheckpointHeaderXML(AsyncCheckpointFile::getStagedHeaderFilename(filename), particleContainer,
+					domainDecomp, _simulation.getSimulationTime());
+			// waits for the checkpoint before the previous one, if it is still being written
+			_asyncFiles[_nextAsyncFile].start(filename, particleContainer, _writeIndex, _indexBlockLength, true);
+			_nextAsyncFile = (_nextAsyncFile + 1) % _asyncFiles.size();
+			return;
+		}
+#endif
+		domain->writeCheckpoint(filename, particleContainer, domainDecomp, _simulation.getSimulationTime(), _useBinaryFormat,
+				_writeIndex, _indexBlockLength);
 	}
 }
 
 void CheckpointWriter::finish(ParticleContainer * /*particleContainer*/, DomainDecompBase * /*domainDecomp*/,
 							  Domain * /*domain*/) {
+#ifdef ENABLE_MPI
+	for (auto& file : _asyncFiles) {
+		file.complete();
+	}
+#endif
 }
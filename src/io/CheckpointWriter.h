@@ -1,9 +1,14 @@
 #ifndef SRC_IO_CHECKPOINTWRITER_H_
 #define SRC_IO_CHECKPOINTWRITER_H_
 
+#include <array>
 #include <string>
 
+#include "io/CompactCheckpoint.h"
 #include "plugins/PluginBase.h"
+#ifdef ENABLE_MPI
+#include "io/AsyncCheckpointFile.h"
+#endif
 
 
 class CheckpointWriter : public PluginBase {
@@ -18,11 +23,26 @@ public:
 	 * The following xml object structure is handled by this method:
 	 * \code{.xml}
 	   <outputplugin name="CheckpointWriter">
-	     <type>ASCII|binary</type>
+	     <type>ASCII|binary|compact</type>
 	     <writefrequency>INTEGER</writefrequency>
 	     <outputprefix>STRING</outputprefix>
 	     <incremental>INTEGER</incremental>
 	     <appendTimestamp>INTEGER</appendTimestamp>
+	     <!-- binary only: write a spatial index (<prefix>.restart.dat.idx), so that a parallel BinaryReader
+	          only reads the parts of the file overlapping its subdomain -->
+	     <index>INTEGER</index>
+	     <!-- edge length of the index blocks; default 0: one block per process -->
+	     <indexBlockLength>DOUBLE</indexBlockLength>
+	     <!-- binary and MPI only: snapshot the molecules and write them with non-blocking MPI-IO while the
+	          simulation continues; at most two checkpoints are held in memory -->
+	     <async>INTEGER</async>
+	     <!-- compact only (<prefix>.restart.ckp, see CompactCheckpoint): compression of the chunks, default LZ4 if
+	          available -->
+	     <compression>None|LZ4</compression>
+	     <!-- compact only: store positions as 32 bit integers relative to the chunk bounding box (lossy) -->
+	     <quantize>INTEGER</quantize>
+	     <!-- compact only: edge length of the chunks; default 0: one chunk per process -->
+	     <chunkLength>DOUBLE</chunkLength>
 	   </outputplugin>
 	   \endcode
 	 */
@@ -46,8 +66,18 @@ private:
 	std::string _outputPrefix;
 	unsigned long _writeFrequency;
     bool    _useBinaryFormat;
+	bool	_useCompactFormat;
+	CompactCheckpoint::Options _compactOptions;
 	bool	_incremental;
 	bool	_appendTimestamp;
+	bool	_writeIndex;
+	double	_indexBlockLength;
+	bool	_async;
+#ifdef ENABLE_MPI
+	//! double buffer of checkpoints in flight, used round robin
+	std::array<AsyncCheckpointFile, 2> _asyncFiles;
+	unsigned _nextAsyncFile = 0;
+#endif
 };
 
 #endif  // SRC_IO_CHECKPOINTWRITER_H_
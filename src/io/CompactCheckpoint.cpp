@@ -0,0 +1,308 @@
+/*
+ * CompactCheckpoint.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#include "io/CompactCheckpoint.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <utility>
+
+#include "Simulation.h"
+#include "molecules/Component.h"
+#include "molecules/Molecule.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+#include "plugins/compression.h"
+#include "utils/Logger.h"
+
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#include "utils/MPI_Info_object.h"
+#include "utils/MPI_LargeCount.h"
+#endif
+
+using Log::global_log;
+
+namespace {
+const char compactMagic[8] = {'M', 'D', 'C', 'K', 'P', 'C', 'M', 'P'};
+//! largest quantized coordinate
+constexpr double quantizationSteps = 4294967295.;
+
+template <typename T>
+void append(std::vector<char>& buffer, const T& value) {
+	const char* bytes = reinterpret_cast<const char*>(&value);
+	buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+//! copy n values from the payload, checking its end
+template <typename T>
+void take(const char*& data, const char* end, size_t n, std::vector<T>& values) {
+	if (data + n * sizeof(T) > end) {
+		global_log->error() << "Compact checkpoint: chunk payload too short, file corrupted?" << std::endl;
+		Simulation::exit(1);
+	}
+	values.resize(n);
+	std::memcpy(values.data(), data, n * sizeof(T));
+	data += n * sizeof(T);
+}
+
+std::unique_ptr<Compression> createCompression(const std::string& encoding) {
+	try {
+		return Compression::create(encoding);
+	} catch (const std::invalid_argument& e) {
+		global_log->error() << "Compact checkpoint: compression " << encoding << " not available (" << e.what() << ")."
+							<< std::endl;
+		Simulation::exit(1);
+	}
+	return nullptr;
+}
+
+//! serialize the molecules of one chunk (uncompressed) and set the bounding box of the chunk
+void encodeChunk(const std::vector<Molecule*>& molecules, bool quantize, CompactCheckpoint::Chunk& chunk,
+		std::vector<char>& payload) {
+	payload.clear();
+	for (int d = 0; d < 3; ++d) {
+		chunk.boxMin[d] = molecules.front()->r(d);
+		chunk.boxMax[d] = molecules.front()->r(d);
+	}
+	for (const Molecule* m : molecules) {
+		for (int d = 0; d < 3; ++d) {
+			chunk.boxMin[d] = std::min(chunk.boxMin[d], m->r(d));
+			chunk.boxMax[d] = std::max(chunk.boxMax[d], m->r(d));
+		}
+	}
+	chunk.numMolecules = molecules.size();
+
+	for (const Molecule* m : molecules) {
+		append(payload, static_cast<uint64_t>(m->getID()));
+	}
+	for (const Molecule* m : molecules) {
+		append(payload, static_cast<uint32_t>(m->componentid()));
+	}
+	for (int d = 0; d < 3; ++d) {
+		const double extent = chunk.boxMax[d] - chunk.boxMin[d];
+		for (const Molecule* m : molecules) {
+			if (quantize) {
+				const double scaled = extent > 0. ? (m->r(d) - chunk.boxMin[d]) / extent * quantizationSteps : 0.;
+				append(payload, static_cast<uint32_t>(std::llround(scaled)));
+			} else {
+				append(payload, m->r(d));
+			}
+		}
+	}
+	for (int d = 0; d < 3; ++d) {
+		for (const Molecule* m : molecules) {
+			append(payload, m->v(d));
+		}
+	}
+	// orientation and angular momentum only for molecules that can rotate
+	for (int i = 0; i < 4; ++i) {
+		for (const Molecule* m : molecules) {
+			if (m->component()->getRotationalDegreesOfFreedom() > 0) {
+				const Quaternion& q = m->q();
+				append(payload, i == 0 ? q.qw() : i == 1 ? q.qx() : i == 2 ? q.qy() : q.qz());
+			}
+		}
+	}
+	for (int d = 0; d < 3; ++d) {
+		for (const Molecule* m : molecules) {
+			if (m->component()->getRotationalDegreesOfFreedom() > 0) {
+				append(payload, m->D(d));
+			}
+		}
+	}
+}
+}
+
+bool CompactCheckpoint::isValid(const Header& header) {
+	return std::memcmp(header.magic, compactMagic, sizeof(header.magic)) == 0 and header.version == version;
+}
+
+void CompactCheckpoint::write(const std::string& filename, ParticleContainer* particleContainer,
+		DomainDecompBase* domainDecomp, double time, const double globalLength[3], const Options& options) {
+	// group the own molecules by chunks, z major
+	std::vector<std::pair<std::array<long, 3>, Molecule*>> keyedMolecules;
+	for (auto it = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+		std::array<long, 3> key = {0, 0, 0};
+		if (options.chunkLength > 0.) {
+			for (int d = 0; d < 3; ++d) {
+				key[2 - d] = static_cast<long>(std::floor(it->r(d) / options.chunkLength));
+			}
+		}
+		keyedMolecules.emplace_back(key, &(*it));
+	}
+	std::stable_sort(keyedMolecules.begin(), keyedMolecules.end(),
+			[](const std::pair<std::array<long, 3>, Molecule*>& a, const std::pair<std::array<long, 3>, Molecule*>& b) {
+				return a.first < b.first;
+			});
+
+	// encode and compress every chunk; offsets are relative to the own data for now
+	std::unique_ptr<Compression> compression = createCompression(options.compression);
+	std::vector<Chunk> chunks;
+	std::vector<char> data;
+	std::vector<Molecule*> chunkMolecules;
+	std::vector<char> payload;
+	std::vector<char> compressed;
+	for (size_t begin = 0; begin < keyedMolecules.size();) {
+		size_t end = begin;
+		chunkMolecules.clear();
+		while (end < keyedMolecules.size() and keyedMolecules[end].first == keyedMolecules[begin].first) {
+			chunkMolecules.push_back(keyedMolecules[end].second);
+			++end;
+		}
+		Chunk chunk;
+		encodeChunk(chunkMolecules, options.quantize, chunk, payload);
+		compression->compress(payload.begin(), payload.end(), compressed);
+		chunk.offset = data.size();
+		chunk.size = compressed.size();
+		data.insert(data.end(), compressed.begin(), compressed.end());
+		chunks.push_back(chunk);
+		begin = end;
+	}
+
+	// global layout: header, all chunk descriptors (ordered by process), all payloads (ordered by process)
+	uint64_t local[3] = {chunks.size(), data.size(), keyedMolecules.size()};
+	uint64_t exscan[3] = {0, 0, 0};
+	uint64_t global[3] = {local[0], local[1], local[2]};
+#ifdef ENABLE_MPI
+	MPI_CHECK(MPI_Exscan(local, exscan, 3, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD));
+	MPI_CHECK(MPI_Allreduce(local, global, 3, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD));
+	if (domainDecomp->getRank() == 0) {
+		exscan[0] = exscan[1] = exscan[2] = 0;  // undefined on rank 0
+	}
+#endif
+	const uint64_t dataBegin = sizeof(Header) + global[0] * sizeof(Chunk);
+	for (auto& chunk : chunks) {
+		chunk.offset += dataBegin + exscan[1];
+	}
+
+	Header header;
+	std::memcpy(header.magic, compactMagic, sizeof(header.magic));
+	header.version = version;
+	header.flags = (options.compression == "LZ4" ? FLAG_LZ4 : 0) | (options.quantize ? FLAG_QUANTIZED : 0);
+	header.numMolecules = global[2];
+	header.numChunks = global[0];
+	header.time = time;
+	for (int d = 0; d < 3; ++d) {
+		header.globalLength[d] = globalLength[d];
+	}
+
+#ifdef ENABLE_MPI
+	MPI_File mpifh;
+	MPI_Info_object mpiinfo;
+	MPI_CHECK(MPI_File_open(MPI_COMM_WORLD, filename.c_str(), MPI_MODE_WRONLY | MPI_MODE_CREATE, mpiinfo, &mpifh));
+	MPI_CHECK(MPI_File_set_size(mpifh, dataBegin + global[1]));
+	if (domainDecomp->getRank() == 0) {
+		MPI_CHECK(MPI_File_write_at(mpifh, 0, &header, sizeof(header), MPI_BYTE, MPI_STATUS_IGNORE));
+	}
+	MPI_Datatype chunksType, dataType;
+	createLargeContiguousType(chunks.size() * sizeof(Chunk), MPI_BYTE, &chunksType);
+	createLargeContiguousType(data.size(), MPI_BYTE, &dataType);
+	MPI_CHECK(MPI_File_write_at_all(mpifh, sizeof(Header) + exscan[0] * sizeof(Chunk), chunks.data(), 1, chunksType,
+			MPI_STATUS_IGNORE));
+	MPI_CHECK(MPI_File_write_at_all(mpifh, dataBegin + exscan[1], data.data(), 1, dataType, MPI_STATUS_IGNORE));
+	MPI_CHECK(MPI_Type_free(&chunksType));
+	MPI_CHECK(MPI_Type_free(&dataType));
+	MPI_CHECK(MPI_File_close(&mpifh));
+#else
+	std::ofstream file(filename.c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(chunks.data()), chunks.size() * sizeof(Chunk));
+	file.write(data.data(), data.size());
+#endif
+	global_log->info() << "Compact checkpoint " << filename << ": " << header.numMolecules << " molecules in "
+					   << header.numChunks << " chunks, " << dataBegin + global[1] << " bytes" << std::endl;
+}
+
+bool CompactCheckpoint::readHeader(const std::string& filename, Header& header) {
+	std::ifstream file(filename.c_str(), std::ios::binary | std::ios::in);
+	if (not file.is_open()) {
+		return false;
+	}
+	file.read(reinterpret_cast<char*>(&header), sizeof(Header));
+	return file and isValid(header);
+}
+
+void CompactCheckpoint::decodeChunk(const Header& header, const Chunk& chunk, std::vector<char>& payload,
+		std::vector<Component>& components, std::vector<Molecule>& molecules) {
+	std::unique_ptr<Compression> compression = createCompression((header.flags & FLAG_LZ4) ? "LZ4" : "None");
+	std::vector<char> decompressed;
+	compression->decompress(payload.begin(), payload.end(), decompressed);
+	const char* data = decompressed.data();
+	const char* end = data + decompressed.size();
+	const size_t n = chunk.numMolecules;
+
+	std::vector<uint64_t> ids;
+	std::vector<uint32_t> cids;
+	take(data, end, n, ids);
+	take(data, end, n, cids);
+	size_t numRotating = 0;
+	for (const uint32_t cid : cids) {
+		if (cid >= components.size()) {
+			global_log->error() << "Compact checkpoint: wrong component id " << cid << " >= " << components.size()
+								<< std::endl;
+			Simulation::exit(1);
+		}
+		if (components[cid].getRotationalDegreesOfFreedom() > 0) {
+			++numRotating;
+		}
+	}
+
+	std::array<std::vector<double>, 3> r;
+	std::array<std::vector<double>, 3> v;
+	std::array<std::vector<double>, 4> q;
+	std::array<std::vector<double>, 3> D;
+	for (int d = 0; d < 3; ++d) {
+		if (header.flags & FLAG_QUANTIZED) {
+			std::vector<uint32_t> quantized;
+			take(data, end, n, quantized);
+			const double extent = chunk.boxMax[d] - chunk.boxMin[d];
+			r[d].resize(n);
+			for (size_t i = 0; i < n; ++i) {
+				// clamp, so that rounding never moves a molecule out of the chunk
+				r[d][i] = std::min(chunk.boxMin[d] + quantized[i] * (extent / quantizationSteps), chunk.boxMax[d]);
+			}
+		} else {
+			take(data, end, n, r[d]);
+		}
+	}
+	for (int d = 0; d < 3; ++d) {
+		take(data, end, n, v[d]);
+	}
+	for (int i = 0; i < 4; ++i) {
+		take(data, end, numRotating, q[i]);
+	}
+	for (int d = 0; d < 3; ++d) {
+		take(data, end, numRotating, D[d]);
+	}
+	if (data != end) {
+		global_log->error() << "Compact checkpoint: chunk payload too long, file corrupted?" << std::endl;
+		Simulation::exit(1);
+	}
+
+	molecules.reserve(molecules.size() + n);
+	size_t rotating = 0;
+	for (size_t i = 0; i < n; ++i) {
+		Component* component = &components[cids[i]];
+		double qi[4] = {1., 0., 0., 0.};
+		double Di[3] = {0., 0., 0.};
+		if (component->getRotationalDegreesOfFreedom() > 0) {
+			for (int k = 0; k < 4; ++k) {
+				qi[k] = q[k][rotating];
+			}
+			for (int d = 0; d < 3; ++d) {
+				Di[d] = D[d][rotating];
+			}
+			++rotating;
+		}
+		molecules.push_back(Molecule(ids[i], component, r[0][i], r[1][i], r[2][i], v[0][i], v[1][i], v[2][i],
+				qi[0], qi[1], qi[2], qi[3], Di[0], Di[1], Di[2]));
+	}
+}
@@ -0,0 +1,107 @@
+/*
+ * CompactCheckpoint.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_IO_COMPACTCHECKPOINT_H_
+#define SRC_IO_COMPACTCHECKPOINT_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "molecules/MoleculeForwardDeclaration.h"
+
+class Component;
+class DomainDecompBase;
+class ParticleContainer;
+
+/**
+ * Compact, chunked checkpoint format (file ending ".restart.ckp").
+ *
+ * The molecules are grouped into chunks of a global grid with a given edge length (or one chunk per process). Every
+ * chunk is stored as one independently decodable payload, so a parallel reader only has to read and decode the chunks
+ * overlapping its own subdomain.
+ *
+ * File layout (native byte order): one Header, Header::numChunks chunk descriptors (Chunk) and the payloads.
+ *
+ * Payload of a chunk with n molecules, m of them with rotational degrees of freedom, arrays in this order:
+ * - id: uint64[n]
+ * - component id (starting at 0): uint32[n]
+ * - positions x[n], y[n], z[n]: double or, if quantized, uint32 relative to the bounding box of the chunk
+ * - velocities x[n], y[n], z[n]: double
+ * - quaternions w[m], x[m], y[m], z[m] and angular momenta x[m], y[m], z[m]: double, only for the m molecules
+ *   whose component has rotational degrees of freedom
+ *
+ * The payload is compressed with the Compression wrapper (plugins/compression.h), if requested.
+ */
+namespace CompactCheckpoint {
+
+enum Flags : uint32_t {
+	//! payloads compressed with LZ4
+	FLAG_LZ4 = 1,
+	//! positions stored as 32 bit integers relative to the chunk bounding box
+	FLAG_QUANTIZED = 2,
+};
+
+struct Header {
+	char magic[8];
+	uint32_t version;
+	uint32_t flags;
+	uint64_t numMolecules;
+	uint64_t numChunks;
+	double time;
+	double globalLength[3];
+};
+
+struct Chunk {
+	//! bounding box of the molecule positions, also the frame of quantized positions
+	double boxMin[3];
+	double boxMax[3];
+	//! position of the payload in the file
+	uint64_t offset;
+	//! size of the (compressed) payload in bytes
+	uint64_t size;
+	uint64_t numMolecules;
+};
+
+static_assert(sizeof(Header) == 64, "unexpected padding in CompactCheckpoint::Header");
+static_assert(sizeof(Chunk) == 72, "unexpected padding in CompactCheckpoint::Chunk");
+
+constexpr uint32_t version = 1;
+
+//! options of the writer
+struct Options {
+	//! "None" or "LZ4", see Compression::create()
+	std::string compression = "None";
+	bool quantize = false;
+	//! edge length of the chunks, <= 0: one chunk per process
+	double chunkLength = 0.;
+};
+
+//! check magic number and version of a header
+bool isValid(const Header& header);
+
+/**
+ * Write all own molecules (inner and boundary) of all processes into one file. Collective in MPI builds.
+ */
+void write(const std::string& filename, ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
+		double time, const double globalLength[3], const Options& options);
+
+/**
+ * Read the header of a file.
+ * @return false if the file does not exist or is not a valid compact checkpoint
+ */
+bool readHeader(const std::string& filename, Header& header);
+
+/**
+ * Decode one payload (as stored in the file) into molecules.
+ * @param components components of the simulation, to assign the molecules and to know which of them rotate
+ */
+void decodeChunk(const Header& header, const Chunk& chunk, std::vector<char>& payload,
+		std::vector<Component>& components, std::vector<Molecule>& molecules);
+
+} // namespace CompactCheckpoint
+
+#endif /* SRC_IO_COMPACTCHECKPOINT_H_ */
@@ -0,0 +1,212 @@
+/*
+ * CompactCheckpointReader.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#include "io/CompactCheckpointReader.h"
+
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#include "utils/MPI_Info_object.h"
+#include "utils/MPI_LargeCount.h"
+#endif
+
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <vector>
+
+#include "Domain.h"
+#include "Simulation.h"
+#include "ensemble/EnsembleBase.h"
+#include "molecules/Molecule.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+#include "utils/Logger.h"
+#include "utils/String_utils.h"
+#include "utils/Timer.h"
+#include "utils/xmlfileUnits.h"
+
+using Log::global_log;
+
+namespace {
+bool overlaps(const CompactCheckpoint::Chunk& chunk, const double boxMin[3], const double boxMax[3]) {
+	for (int d = 0; d < 3; ++d) {
+		if (chunk.boxMax[d] < boxMin[d] or chunk.boxMin[d] > boxMax[d]) {
+			return false;
+		}
+	}
+	return true;
+}
+}
+
+CompactCheckpointReader::CompactCheckpointReader() : _phaseSpaceFile(), _header() {
+}
+
+void CompactCheckpointReader::readXML(XMLfileUnits& xmlconfig) {
+	std::string pspfile;
+	xmlconfig.getNodeValue("data", pspfile);
+	pspfile = string_utils::trim(pspfile);
+	// only prefix xml dir if path is not absolute
+	if (pspfile[0] != '/') {
+		pspfile.insert(0, xmlconfig.getDir());
+	}
+	global_log->info() << "phase space data file (compact): " << pspfile << std::endl;
+	setPhaseSpaceFile(pspfile);
+}
+
+void CompactCheckpointReader::readPhaseSpaceHeader(Domain* domain, double /*timestep*/) {
+	if (not CompactCheckpoint::readHeader(_phaseSpaceFile, _header)) {
+		global_log->error() << "Could not read compact checkpoint " << _phaseSpaceFile
+							<< ": missing file, wrong magic number or unsupported version." << std::endl;
+		Simulation::exit(1);
+	}
+	if ((_header.flags & CompactCheckpoint::FLAG_LZ4) != 0) {
+		global_log->info() << "Compact checkpoint is compressed with LZ4." << std::endl;
+	}
+
+	_simulation.setSimulationTime(_header.time);
+	for (int d = 0; d < 3; ++d) {
+		domain->setGlobalLength(d, _header.globalLength[d]);
+	}
+	domain->setglobalNumMolecules(_header.numMolecules);
+}
+
+unsigned long CompactCheckpointReader::readPhaseSpace(ParticleContainer* particleContainer, Domain* domain,
+		DomainDecompBase* domainDecomp) {
+	Timer inputTimer;
+	inputTimer.start();
+
+	std::vector<Component>& dcomponents = *(_simulation.getEnsemble()->getComponents());
+	const size_t numcomponents = dcomponents.size();
+	// under muVT every process needs samples of all molecules, see storeSample()
+	const bool readAll = _simulation.getEnsemble()->getType() == muVT;
+
+	double boxMin[3];
+	double boxMax[3];
+	for (int d = 0; d < 3; ++d) {
+		boxMin[d] = particleContainer->getBoundingBoxMin(d);
+		boxMax[d] = particleContainer->getBoundingBoxMax(d);
+	}
+
+	// rank 0 reads the chunk table and distributes it
+	std::vector<CompactCheckpoint::Chunk> chunks(_header.numChunks);
+	if (domainDecomp->getRank() == 0) {
+		std::ifstream file(_phaseSpaceFile.c_str(), std::ios::binary | std::ios::in);
+		file.seekg(sizeof(CompactCheckpoint::Header));
+		file.read(reinterpret_cast<char*>(chunks.data()), chunks.size() * sizeof(CompactCheckpoint::Chunk));
+		if (not file) {
+			global_log->error() << "Could not read the chunk table of " << _phaseSpaceFile << std::endl;
+			Simulation::exit(1);
+		}
+	}
+#ifdef ENABLE_MPI
+	MPI_CHECK(MPI_Bcast(chunks.data(), chunks.size() * sizeof(CompactCheckpoint::Chunk), MPI_BYTE, 0, MPI_COMM_WORLD));
+#endif
+
+	// only the chunks overlapping the own subdomain, the table is in file order
+	std::vector<CompactCheckpoint::Chunk> selected;
+	size_t numBytes = 0;
+	for (const auto& chunk : chunks) {
+		if (chunk.numMolecules > 0 and (readAll or overlaps(chunk, boxMin, boxMax))) {
+			selected.push_back(chunk);
+			numBytes += chunk.size;
+		}
+	}
+	global_log->info() << "Reading " << selected.size() << " of " << chunks.size() << " chunks of " << _phaseSpaceFile
+					   << std::endl;
+
+	std::vector<char> buffer(numBytes);
+#ifdef ENABLE_MPI
+	std::vector<MPI_Aint> displacements;
+	std::vector<int> blocklengths;
+	for (const auto& chunk : selected) {
+		if (chunk.size > INT_MAX) {
+			global_log->error() << "Compact checkpoint: chunk larger than 2 GiB, use a smaller chunkLength." << std::endl;
+			Simulation::exit(1);
+		}
+		displacements.push_back(chunk.offset);
+		blocklengths.push_back(static_cast<int>(chunk.size));
+	}
+	MPI_File mpifh;
+	MPI_Info_object mpiinfo;
+	if (MPI_File_open(MPI_COMM_WORLD, _phaseSpaceFile.c_str(), MPI_MODE_RDONLY, mpiinfo, &mpifh) != MPI_SUCCESS) {
+		global_log->error() << "Could not open phaseSpaceFile " << _phaseSpaceFile << std::endl;
+		Simulation::exit(1);
+	}
+	MPI_Datatype fileType;
+	MPI_CHECK(MPI_Type_create_hindexed(selected.size(), blocklengths.data(), displacements.data(), MPI_BYTE,
+			&fileType));
+	MPI_CHECK(MPI_Type_commit(&fileType));
+	MPI_CHECK(MPI_File_set_view(mpifh, 0, MPI_BYTE, fileType, "native", mpiinfo));
+	MPI_Datatype bufferType;
+	createLargeContiguousType(numBytes, MPI_BYTE, &bufferType);
+	MPI_CHECK(MPI_File_read_all(mpifh, buffer.data(), 1, bufferType, MPI_STATUS_IGNORE));
+	MPI_CHECK(MPI_Type_free(&bufferType));
+	MPI_CHECK(MPI_Type_free(&fileType));
+	MPI_CHECK(MPI_File_close(&mpifh));
+#else
+	std::ifstream file(_phaseSpaceFile.c_str(), std::ios::binary | std::ios::in);
+	size_t readPosition = 0;
+	for (const auto& chunk : selected) {
+		file.seekg(chunk.offset);
+		file.read(buffer.data() + readPosition, chunk.size);
+		readPosition += chunk.size;
+	}
+	if (not file) {
+		global_log->error() << "Could not read the payloads of " << _phaseSpaceFile << std::endl;
+		Simulation::exit(1);
+	}
+#endif
+
+	unsigned long maxid = 0;
+	std::vector<unsigned long> numMoleculesPerComponent(numcomponents, 0);
+	std::vector<char> payload;
+	std::vector<Molecule> molecules;
+	size_t position = 0;
+	for (const auto& chunk : selected) {
+		payload.assign(buffer.begin() + position, buffer.begin() + position + chunk.size);
+		position += chunk.size;
+		molecules.clear();
+		CompactCheckpoint::decodeChunk(_header, chunk, payload, dcomponents, molecules);
+		for (auto& m : molecules) {
+			if (particleContainer->isInBoundingBox(m.r_arr().data())) {
+				particleContainer->addParticle(m, true, false);
+				++numMoleculesPerComponent[m.componentid()];
+				maxid = std::max(maxid, static_cast<unsigned long>(m.getID()));
+			}
+			if (readAll) {
+				_simulation.getEnsemble()->storeSample(&m, m.componentid());
+			}
+		}
+	}
+
+	// the component counts and the rotational degrees of freedom are global values
+#ifdef ENABLE_MPI
+	MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, numMoleculesPerComponent.data(), numcomponents, MPI_UNSIGNED_LONG, MPI_SUM,
+			MPI_COMM_WORLD));
+	MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &maxid, 1, MPI_UNSIGNED_LONG, MPI_MAX, MPI_COMM_WORLD));
+#endif
+	unsigned long numAdded = 0;
+	for (size_t cid = 0; cid < numcomponents; ++cid) {
+		dcomponents[cid].setNumMolecules(dcomponents[cid].getNumMolecules() + numMoleculesPerComponent[cid]);
+		domain->setglobalRotDOF(domain->getglobalRotDOF()
+				+ numMoleculesPerComponent[cid] * dcomponents[cid].getRotationalDegreesOfFreedom());
+		numAdded += numMoleculesPerComponent[cid];
+	}
+	if (numAdded != _header.numMolecules) {
+		global_log->warning() << "Read " << numAdded << " of " << _header.numMolecules
+							  << " molecules, the others are out of box." << std::endl;
+	}
+	global_log->info() << "Reading Molecules done" << std::endl;
+
+	if (domain->getglobalRho() == 0.) {
+		domain->setglobalRho(domain->getglobalNumMolecules() / domain->getGlobalVolume());
+		global_log->info() << "Calculated Rho_global = " << domain->getglobalRho() << std::endl;
+	}
+
+	inputTimer.stop();
+	global_log->info() << "Initial IO took:                 " << inputTimer.get_etime() << " sec" << std::endl;
+	return maxid;
+}
@@ -0,0 +1,52 @@
+/*
+ * CompactCheckpointReader.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_IO_COMPACTCHECKPOINTREADER_H_
+#define SRC_IO_COMPACTCHECKPOINTREADER_H_
+
+#include <string>
+
+#include "io/CompactCheckpoint.h"
+#include "io/InputBase.h"
+
+/**
+ * Reader for compact checkpoints (see CompactCheckpoint and CheckpointWriter with type compact).
+ *
+ * Every process only reads and decodes the chunks overlapping its own subdomain, in MPI builds with one collective
+ * MPI-IO read. The components are taken from the XML configuration, as for the binary format.
+ */
+class CompactCheckpointReader : public InputBase {
+public:
+	CompactCheckpointReader();
+	~CompactCheckpointReader() override = default;
+
+	/** @brief Read in XML configuration for CompactCheckpointReader.
+	 *
+	 * The following xml object structure is handled by this method:
+	 * \code{.xml}
+	   <file type="compact">
+	     <data>STRING</data>   <!-- e.g. checkpoint.restart.ckp -->
+	   </file>
+	   \endcode
+	 */
+	void readXML(XMLfileUnits& xmlconfig) override;
+
+	void setPhaseSpaceFile(std::string filename) { _phaseSpaceFile = filename; }
+
+	//! @brief reads the file header: simulation time, box length and number of molecules
+	void readPhaseSpaceHeader(Domain* domain, double timestep) override;
+
+	//! @brief reads the molecules of the chunks overlapping the own subdomain
+	//! @return Highest molecule ID found in the input phase space file.
+	unsigned long readPhaseSpace(ParticleContainer* particleContainer, Domain* domain,
+			DomainDecompBase* domainDecomp) override;
+
+private:
+	std::string _phaseSpaceFile;
+	CompactCheckpoint::Header _header;
+};
+
+#endif /* SRC_IO_COMPACTCHECKPOINTREADER_H_ */
@@ -48,6 +48,9 @@ public:
 		return std::string("DecompWriter");
 	}
 	static PluginBase* createInstance() { return new DecompWriter(); }
+
+	//! only the decomposition is written
+	bool accessesVelocitiesAt(MoleculeVisitHook) { return false; }
 private:
 	unsigned long _writeFrequency;
 	bool _appendTimestamp;
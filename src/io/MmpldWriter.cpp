@@ -14,12 +14,16 @@
 #endif
 
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <vector>
 #include <array>
 #include <iostream>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
 
 #include "Common.h"
 #include "Domain.h"
@@ -35,6 +39,8 @@
 #define MMPLD_DEFAULT_VERSION 100
 #define MMPLD_HEADER_DATA_SIZE 60
 #define MMPLD_SEEK_TABLE_OFFSET MMPLD_HEADER_DATA_SIZE
+// default write granularity of the aggregators (typical Lustre stripe size)
+#define MMPLD_DEFAULT_STRIPE_SIZE 1048576
 
 using Log::global_log;
 using namespace std;
@@ -48,16 +54,26 @@ std::string MmpldWriter::getOutputFilename() {
 MmpldWriter::MmpldWriter() :
 		_startTimestep(0), _writeFrequency(1000), _stopTimestep(0), _writeBufferSize(32768), _outputPrefix("unknown"),
 		_bInitSphereData(ISD_READ_FROM_XML), _bWriteControlPrepared(false),
-		_fileCount(1), _numFramesPerFile(0), _mmpldversion(MMPLD_DEFAULT_VERSION), _vertex_type(MMPLD_VERTEX_FLOAT_XYZ), _color_type(MMPLD_COLOR_NONE)
-{}
+		_fileCount(1), _numFramesPerFile(0), _mmpldversion(MMPLD_DEFAULT_VERSION), _vertex_type(MMPLD_VERTEX_FLOAT_XYZ), _color_type(MMPLD_COLOR_NONE),
+		_aggregate(false), _stripeSize(0)
+{
+#ifdef ENABLE_MPI
+	_nodeComm = MPI_COMM_NULL;
+	_aggregatorComm = MPI_COMM_NULL;
+#endif
+}
 
 MmpldWriter::MmpldWriter(uint64_t startTimestep, uint64_t writeFrequency, uint64_t stopTimestep, uint64_t numFramesPerFile,
 		std::string outputPrefix)
 		:	_startTimestep(startTimestep), _writeFrequency(writeFrequency), _stopTimestep(stopTimestep), _writeBufferSize(32768),
 		_outputPrefix(outputPrefix), _bInitSphereData(ISD_READ_FROM_XML), _bWriteControlPrepared(false),
 		_fileCount(1),_numFramesPerFile(numFramesPerFile),  _vertex_type(MMPLD_VERTEX_FLOAT_XYZ),
-		_color_type(MMPLD_COLOR_NONE)
+		_color_type(MMPLD_COLOR_NONE), _aggregate(false), _stripeSize(0)
 {
+#ifdef ENABLE_MPI
+	_nodeComm = MPI_COMM_NULL;
+	_aggregatorComm = MPI_COMM_NULL;
+#endif
 	if (0 == _writeFrequency) {
 		Simulation::exit(-1);
 	}
@@ -130,6 +146,7 @@ void MmpldWriter::readXML(XMLfileUnits& xmlconfig)
 		std::array<float, 2> intRange = { {intensity_min, intensity_max} };
 		_global_intensity_range.push_back(intRange);
 	}
+	xmlconfig.changecurrentnode(oldpath);
 
 	if(xmlconfig.changecurrentnode("mpi_info")) {
 #ifdef ENABLE_MPI
@@ -140,6 +157,31 @@ void MmpldWriter::readXML(XMLfileUnits& xmlconfig)
 #endif
 		xmlconfig.changecurrentnode("..");
 	}
+
+	int aggregate = 0;
+	xmlconfig.getNodeValue("aggregate", aggregate);
+	_aggregate = (aggregate != 0);
+	xmlconfig.getNodeValue("stripesize", _stripeSize);
+#ifdef ENABLE_MPI
+	if(_aggregate) {
+		if(_stripeSize <= 0 && static_cast<MPI_Info>(_mpiinfo) != MPI_INFO_NULL) {
+			char value[MPI_MAX_INFO_VAL + 1];
+			int flag = 0;
+			MPI_Info_get(_mpiinfo, "striping_unit", MPI_MAX_INFO_VAL, value, &flag);
+			if(flag) {
+				_stripeSize = atol(value);
+			}
+		}
+		if(_stripeSize <= 0) {
+			_stripeSize = MMPLD_DEFAULT_STRIPE_SIZE;
+		}
+		global_log->info() << "[MMPLD Writer] Aggregated collective writes, stripe size: " << _stripeSize << " Byte" << endl;
+	}
+#else
+	if(_aggregate) {
+		global_log->info() << "[MMPLD Writer] aggregate only used in parallel/MPI version" << endl;
+	}
+#endif
 }
 
 //Header Information
@@ -183,6 +225,9 @@ void MmpldWriter::init(ParticleContainer *particleContainer,
 	_seekTable.at(0) = MMPLD_HEADER_DATA_SIZE + get_seekTable_size();
 
 #ifdef ENABLE_MPI
+	if(_aggregate) {
+		createAggregatorComms();
+	}
 	int rank = domainDecomp->getRank();
 	if (rank == 0){
 #endif
@@ -233,7 +278,12 @@ void MmpldWriter::write_frame(ParticleContainer* particleContainer, DomainDecomp
 #ifdef ENABLE_MPI
 	int rank = domainDecomp->getRank();
 
-	MPI_File_open(MPI_COMM_WORLD, const_cast<char*>(filename.c_str()), MPI_MODE_WRONLY|MPI_MODE_CREATE, _mpiinfo, &_mpifh);
+	// in aggregate mode only the aggregators access the file
+	const bool accessFile = (not _aggregate) || (_aggregatorComm != MPI_COMM_NULL);
+	if(accessFile) {
+		MPI_Comm fileComm = _aggregate ? _aggregatorComm : MPI_COMM_WORLD;
+		MPI_File_open(fileComm, const_cast<char*>(filename.c_str()), MPI_MODE_WRONLY|MPI_MODE_CREATE, _mpiinfo, &_mpifh);
+	}
 
 	//distribute global component particle count and offset counts for distrubted write
 	std::vector<uint64_t> globalNumCompSpheres(_numSphereTypes);
@@ -245,50 +295,55 @@ void MmpldWriter::write_frame(ParticleContainer* particleContainer, DomainDecomp
 	int lastrank = domainDecomp->getNumProcs() - 1;
 	MPI_Bcast(globalNumCompSpheres.data(), _numSphereTypes, MPI_UINT64_T, lastrank, MPI_COMM_WORLD);
 
-	if(rank == 0) {
-		MPI_File_seek(_mpifh, _seekTable.at(_frameCount), MPI_SEEK_SET);
-		write_frame_header(_numSphereTypes);
-	}
-
 	/* positions of data lists relative to frame begin */
 	std::vector<uint64_t> dataListBeginOffsets(_numSphereTypes);
 	dataListBeginOffsets[0] = get_data_frame_header_size();
 	for(int i = 1; i < _numSphereTypes; ++i) {
 		dataListBeginOffsets[i] = dataListBeginOffsets[i-1] + get_data_list_header_size() + get_data_list_size(globalNumCompSpheres[i-1]);
 	}
-	/* calculate write positions inside data lists for this process */
-	std::vector<uint64_t> dataListWriteOffsets(_numSphereTypes);
-	for(int i = 0; i < _numSphereTypes; ++i) {
-		dataListWriteOffsets[i] = get_data_list_header_size() + get_data_list_size(exscanNumCompSpheres[i]);
-	}
 
-	char* writeBuffer = new char[_writeBufferSize];
-	long buffer_pos = 0;
-	/* write particle list for each component|site (sphere type)`*/
-	for (uint8_t sphereTypeId = 0; sphereTypeId < _numSphereTypes; ++sphereTypeId){
-		//write particle list header
+	if(_aggregate) {
+		write_frame_aggregated(particleContainer, rank, globalNumCompSpheres, exscanNumCompSpheres, dataListBeginOffsets);
+	} else {
 		if(rank == 0) {
-			long offset = _seekTable.at(_frameCount) + dataListBeginOffsets[sphereTypeId];
-			MPI_File_seek(_mpifh, offset, MPI_SEEK_SET);
-			write_particle_list_header(globalNumCompSpheres[sphereTypeId], sphereTypeId);
+			MPI_File_seek(_mpifh, _seekTable.at(_frameCount), MPI_SEEK_SET);
+			write_frame_header(_numSphereTypes);
 		}
-		long offset = _seekTable.at(_frameCount) + dataListBeginOffsets[sphereTypeId] + dataListWriteOffsets[sphereTypeId];
-		MPI_File_seek(_mpifh, offset, MPI_SEEK_SET);
-		buffer_pos = 0;
-		for (auto moleculeIter = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); moleculeIter.isValid(); ++moleculeIter) {
-			if(true == GetSpherePos(reinterpret_cast<float*>(&writeBuffer[buffer_pos]), &(*moleculeIter), sphereTypeId)) {
-				buffer_pos += get_particle_data_size();
-				if(buffer_pos > _writeBufferSize - get_particle_data_size()) {
-					MPI_Status status;
-					MPI_File_write(_mpifh, writeBuffer, buffer_pos, MPI_BYTE, &status);
-					buffer_pos = 0;
+
+		/* calculate write positions inside data lists for this process */
+		std::vector<uint64_t> dataListWriteOffsets(_numSphereTypes);
+		for(int i = 0; i < _numSphereTypes; ++i) {
+			dataListWriteOffsets[i] = get_data_list_header_size() + get_data_list_size(exscanNumCompSpheres[i]);
+		}
+
+		char* writeBuffer = new char[_writeBufferSize];
+		long buffer_pos = 0;
+		/* write particle list for each component|site (sphere type)`*/
+		for (uint8_t sphereTypeId = 0; sphereTypeId < _numSphereTypes; ++sphereTypeId){
+			//write particle list header
+			if(rank == 0) {
+				long offset = _seekTable.at(_frameCount) + dataListBeginOffsets[sphereTypeId];
+				MPI_File_seek(_mpifh, offset, MPI_SEEK_SET);
+				write_particle_list_header(globalNumCompSpheres[sphereTypeId], sphereTypeId);
+			}
+			long offset = _seekTable.at(_frameCount) + dataListBeginOffsets[sphereTypeId] + dataListWriteOffsets[sphereTypeId];
+			MPI_File_seek(_mpifh, offset, MPI_SEEK_SET);
+			buffer_pos = 0;
+			for (auto moleculeIter = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); moleculeIter.isValid(); ++moleculeIter) {
+				if(true == GetSpherePos(reinterpret_cast<float*>(&writeBuffer[buffer_pos]), &(*moleculeIter), sphereTypeId)) {
+					buffer_pos += get_particle_data_size();
+					if(buffer_pos > _writeBufferSize - get_particle_data_size()) {
+						MPI_Status status;
+						MPI_File_write(_mpifh, writeBuffer, buffer_pos, MPI_BYTE, &status);
+						buffer_pos = 0;
+					}
 				}
 			}
+			MPI_Status status;
+			MPI_File_write(_mpifh, writeBuffer, buffer_pos, MPI_BYTE, &status);
 		}
-		MPI_Status status;
-		MPI_File_write(_mpifh, writeBuffer, buffer_pos, MPI_BYTE, &status);
+		delete[] writeBuffer;
 	}
-	delete[] writeBuffer;
 	// data of frame is written
 	_frameCount++;
 	uint64_t frame_offset = dataListBeginOffsets.back() + get_data_list_header_size() + get_data_list_size(globalNumCompSpheres.back());
@@ -301,10 +356,197 @@ void MmpldWriter::write_frame(ParticleContainer* particleContainer, DomainDecomp
 		// 8: frame count position in file header
 		MPI_File_write_at(_mpifh, 8, &frameCount, sizeof(frameCount), MPI_BYTE, &status);
 	}
-	MPI_File_close(&_mpifh);
+	if(accessFile) {
+		MPI_File_close(&_mpifh);
+	}
 #endif
 }
 
+#ifdef ENABLE_MPI
+void MmpldWriter::write_frame_aggregated(ParticleContainer* particleContainer, int rank,
+		const std::vector<uint64_t>& globalNumCompSpheres, const std::vector<uint64_t>& exscanNumCompSpheres,
+		const std::vector<uint64_t>& dataListBeginOffsets)
+{
+	const uint64_t frameBegin = _seekTable.at(_frameCount);
+	const uint64_t frameEnd = frameBegin + dataListBeginOffsets.back() + get_data_list_header_size()
+		+ get_data_list_size(globalNumCompSpheres.back());
+
+	// local pieces of the frame: (file offset, length) pairs and their data
+	std::vector<uint64_t> pieces;
+	std::vector<char> data;
+	if(rank == 0) {
+		pieces.push_back(frameBegin);
+		get_frame_header(_numSphereTypes, data);
+		pieces.push_back(data.size());
+	}
+	const long particleDataSize = get_particle_data_size();
+	for(uint8_t sphereTypeId = 0; sphereTypeId < _numSphereTypes; ++sphereTypeId) {
+		size_t dataBegin = data.size();
+		if(rank == 0) {
+			pieces.push_back(frameBegin + dataListBeginOffsets[sphereTypeId]);
+			get_particle_list_header(globalNumCompSpheres[sphereTypeId], sphereTypeId, data);
+			pieces.push_back(data.size() - dataBegin);
+			dataBegin = data.size();
+		}
+		for(auto moleculeIter = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); moleculeIter.isValid(); ++moleculeIter) {
+			float spherePos[8] = {0.f};
+			if(GetSpherePos(spherePos, &(*moleculeIter), sphereTypeId)) {
+				data.insert(data.end(), reinterpret_cast<char*>(spherePos), reinterpret_cast<char*>(spherePos) + particleDataSize);
+			}
+		}
+		if(data.size() > dataBegin) {
+			pieces.push_back(frameBegin + dataListBeginOffsets[sphereTypeId] + get_data_list_header_size()
+				+ get_data_list_size(exscanNumCompSpheres[sphereTypeId]));
+			pieces.push_back(data.size() - dataBegin);
+		}
+	}
+
+	// phase 1: gather the pieces of all processes of the node on the aggregator
+	int nodeSize = 0;
+	MPI_Comm_size(_nodeComm, &nodeSize);
+	int localCounts[2] = {static_cast<int>(pieces.size()), static_cast<int>(data.size())};
+	std::vector<int> nodeCounts(2 * nodeSize);
+	MPI_Gather(localCounts, 2, MPI_INT, nodeCounts.data(), 2, MPI_INT, 0, _nodeComm);
+	std::vector<int> pieceCounts(nodeSize), pieceDispls(nodeSize), dataCounts(nodeSize), dataDispls(nodeSize);
+	for(int i = 0; i < nodeSize; ++i) {
+		pieceCounts[i] = nodeCounts[2*i];
+		dataCounts[i] = nodeCounts[2*i + 1];
+		pieceDispls[i] = (i == 0) ? 0 : pieceDispls[i-1] + pieceCounts[i-1];
+		dataDispls[i] = (i == 0) ? 0 : dataDispls[i-1] + dataCounts[i-1];
+	}
+	std::vector<uint64_t> nodePieces(pieceDispls.back() + pieceCounts.back());
+	std::vector<char> nodeData(dataDispls.back() + dataCounts.back());
+	MPI_Gatherv(pieces.data(), localCounts[0], MPI_UINT64_T, nodePieces.data(), pieceCounts.data(), pieceDispls.data(),
+			MPI_UINT64_T, 0, _nodeComm);
+	MPI_Gatherv(data.data(), localCounts[1], MPI_BYTE, nodeData.data(), dataCounts.data(), dataDispls.data(),
+			MPI_BYTE, 0, _nodeComm);
+	pieces.clear();
+	data.clear();
+	if(_aggregatorComm == MPI_COMM_NULL) {
+		return;
+	}
+
+	// phase 2: redistribute among the aggregators, so that each one owns a contiguous range of the frame whose
+	// boundaries are multiples of the stripe size
+	int numAggregators = 0;
+	int aggregatorRank = 0;
+	MPI_Comm_size(_aggregatorComm, &numAggregators);
+	MPI_Comm_rank(_aggregatorComm, &aggregatorRank);
+	std::vector<uint64_t> domainBounds(numAggregators + 1);
+	for(int a = 0; a <= numAggregators; ++a) {
+		uint64_t bound = frameBegin + (frameEnd - frameBegin) * a / numAggregators;
+		bound = (bound + _stripeSize - 1) / _stripeSize * _stripeSize;
+		domainBounds[a] = std::min(std::max(bound, frameBegin), frameEnd);
+	}
+	domainBounds.front() = frameBegin;
+	domainBounds.back() = frameEnd;
+
+	std::vector<std::vector<uint64_t>> sendPieces(numAggregators);
+	std::vector<std::vector<char>> sendData(numAggregators);
+	uint64_t pieceData = 0;
+	for(size_t i = 0; i < nodePieces.size(); i += 2) {
+		uint64_t offset = nodePieces[i];
+		uint64_t length = nodePieces[i+1];
+		const char* pieceBegin = nodeData.data() + pieceData;
+		pieceData += length;
+		int a = std::upper_bound(domainBounds.begin(), domainBounds.end(), offset) - domainBounds.begin() - 1;
+		while(length > 0) {
+			const uint64_t chunk = std::min(length, domainBounds[a+1] - offset);
+			if(chunk > 0) {
+				sendPieces[a].push_back(offset);
+				sendPieces[a].push_back(chunk);
+				sendData[a].insert(sendData[a].end(), pieceBegin, pieceBegin + chunk);
+			}
+			offset += chunk;
+			pieceBegin += chunk;
+			length -= chunk;
+			++a;
+		}
+	}
+	nodePieces.clear();
+	nodeData.clear();
+
+	std::vector<int> sendCounts(2 * numAggregators), recvCounts(2 * numAggregators);
+	for(int a = 0; a < numAggregators; ++a) {
+		sendCounts[2*a] = sendPieces[a].size();
+		sendCounts[2*a + 1] = sendData[a].size();
+	}
+	MPI_Alltoall(sendCounts.data(), 2, MPI_INT, recvCounts.data(), 2, MPI_INT, _aggregatorComm);
+	std::vector<int> sendPieceCounts(numAggregators), sendPieceDispls(numAggregators);
+	std::vector<int> sendDataCounts(numAggregators), sendDataDispls(numAggregators);
+	std::vector<int> recvPieceCounts(numAggregators), recvPieceDispls(numAggregators);
+	std::vector<int> recvDataCounts(numAggregators), recvDataDispls(numAggregators);
+	for(int a = 0; a < numAggregators; ++a) {
+		sendPieceCounts[a] = sendCounts[2*a];
+		sendDataCounts[a] = sendCounts[2*a + 1];
+		recvPieceCounts[a] = recvCounts[2*a];
+		recvDataCounts[a] = recvCounts[2*a + 1];
+		sendPieceDispls[a] = (a == 0) ? 0 : sendPieceDispls[a-1] + sendPieceCounts[a-1];
+		sendDataDispls[a] = (a == 0) ? 0 : sendDataDispls[a-1] + sendDataCounts[a-1];
+		recvPieceDispls[a] = (a == 0) ? 0 : recvPieceDispls[a-1] + recvPieceCounts[a-1];
+		recvDataDispls[a] = (a == 0) ? 0 : recvDataDispls[a-1] + recvDataCounts[a-1];
+	}
+	std::vector<uint64_t> sendPieceBuffer, recvPieceBuffer(recvPieceDispls.back() + recvPieceCounts.back());
+	std::vector<char> sendDataBuffer, recvDataBuffer(recvDataDispls.back() + recvDataCounts.back());
+	for(int a = 0; a < numAggregators; ++a) {
+		sendPieceBuffer.insert(sendPieceBuffer.end(), sendPieces[a].begin(), sendPieces[a].end());
+		sendDataBuffer.insert(sendDataBuffer.end(), sendData[a].begin(), sendData[a].end());
+	}
+	sendPieces.clear();
+	sendData.clear();
+	MPI_Alltoallv(sendPieceBuffer.data(), sendPieceCounts.data(), sendPieceDispls.data(), MPI_UINT64_T,
+			recvPieceBuffer.data(), recvPieceCounts.data(), recvPieceDispls.data(), MPI_UINT64_T, _aggregatorComm);
+	MPI_Alltoallv(sendDataBuffer.data(), sendDataCounts.data(), sendDataDispls.data(), MPI_BYTE,
+			recvDataBuffer.data(), recvDataCounts.data(), recvDataDispls.data(), MPI_BYTE, _aggregatorComm);
+
+	// the pieces cover the frame without gaps, so the own domain is one dense buffer
+	const uint64_t domainBegin = domainBounds[aggregatorRank];
+	std::vector<char> domainBuffer(domainBounds[aggregatorRank + 1] - domainBegin);
+	uint64_t recvData = 0;
+	for(size_t i = 0; i < recvPieceBuffer.size(); i += 2) {
+		std::memcpy(domainBuffer.data() + (recvPieceBuffer[i] - domainBegin), recvDataBuffer.data() + recvData, recvPieceBuffer[i+1]);
+		recvData += recvPieceBuffer[i+1];
+	}
+
+	// phase 3: one collective write of all aggregators
+	if(domainBuffer.size() > INT_MAX) {
+		global_log->error() << "[MMPLD Writer] File domain of " << domainBuffer.size() << " Byte too large for one write." << endl;
+		Simulation::exit(1);
+	}
+	MPI_Status status;
+	MPI_File_write_at_all(_mpifh, domainBegin, domainBuffer.data(), domainBuffer.size(), MPI_BYTE, &status);
+}
+
+void MmpldWriter::createAggregatorComms()
+{
+	if(_nodeComm != MPI_COMM_NULL) {
+		return;
+	}
+	int rank = 0;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &_nodeComm);
+	int nodeRank = 0;
+	MPI_Comm_rank(_nodeComm, &nodeRank);
+	// rank 0 is always an aggregator, it writes the file header and seek table
+	MPI_Comm_split(MPI_COMM_WORLD, (nodeRank == 0) ? 0 : MPI_UNDEFINED, rank, &_aggregatorComm);
+	if(_aggregatorComm != MPI_COMM_NULL && rank == 0) {
+		int numAggregators = 0;
+		MPI_Comm_size(_aggregatorComm, &numAggregators);
+		global_log->info() << "[MMPLD Writer] Number of aggregators: " << numAggregators << endl;
+	}
+}
+
+void MmpldWriter::freeAggregatorComms()
+{
+	if(_nodeComm != MPI_COMM_NULL) {
+		MPI_Comm_free(&_nodeComm);
+	}
+	if(_aggregatorComm != MPI_COMM_NULL) {
+		MPI_Comm_free(&_aggregatorComm);
+	}
+}
+#endif
+
 void MmpldWriter::endStep(ParticleContainer *particleContainer,
                           DomainDecompBase *domainDecomp, Domain *domain,
                           unsigned long simstep)
@@ -346,6 +588,7 @@ void MmpldWriter::finish(ParticleContainer * /*particleContainer*/, DomainDecomp
 		MPI_File_close(&_mpifh);
 	}
 	_seekTable.clear();
+	freeAggregatorComms();
 #endif
 }
 
@@ -482,15 +725,42 @@ long MmpldWriter::get_data_list_size(uint64_t particle_count) {
 }
 
 
-void MmpldWriter::write_frame_header(uint32_t num_data_lists) {
-#ifdef ENABLE_MPI
-	MPI_Status status;
+template<typename T>
+static void append_bytes(std::vector<char>& buffer, const T& value) {
+	const char* bytes = reinterpret_cast<const char*>(&value);
+	buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void MmpldWriter::get_frame_header(uint32_t num_data_lists, std::vector<char>& buffer) {
 	if (_mmpldversion == 102){
 		float frameHeader_timestamp = _simulation.getSimulationTime();
-		MPI_File_write(_mpifh, &frameHeader_timestamp, 1, MPI_FLOAT, &status);
+		append_bytes(buffer, frameHeader_timestamp);
 	}
 	uint32_t num_data_lists_le = htole32(num_data_lists);
-	MPI_File_write(_mpifh, &num_data_lists_le, sizeof(num_data_lists_le), MPI_BYTE, &status);
+	append_bytes(buffer, num_data_lists_le);
+}
+
+void MmpldWriter::get_particle_list_header(uint64_t particle_count, int sphereId, std::vector<char>& buffer) {
+	append_bytes(buffer, _vertex_type);
+	append_bytes(buffer, _color_type);
+	if(_vertex_type == MMPLD_VERTEX_FLOAT_XYZ || _vertex_type == MMPLD_VERTEX_SHORT_XYZ) {
+		append_bytes(buffer, _global_radius[sphereId]);
+	}
+	if(_color_type == MMPLD_COLOR_NONE) {
+		append_bytes(buffer, _global_rgba[sphereId]);
+	} else if(_color_type == MMPLD_COLOR_FLOAT_I) {
+		append_bytes(buffer, _global_intensity_range[sphereId]);
+	}
+	uint64_t particle_count_le = htole64(particle_count);
+	append_bytes(buffer, particle_count_le);
+}
+
+void MmpldWriter::write_frame_header(uint32_t num_data_lists) {
+#ifdef ENABLE_MPI
+	std::vector<char> buffer;
+	get_frame_header(num_data_lists, buffer);
+	MPI_Status status;
+	MPI_File_write(_mpifh, buffer.data(), buffer.size(), MPI_BYTE, &status);
 #else
 	/** @todo need to implement serial version */
 #endif
@@ -511,19 +781,11 @@ void MmpldWriter::writeSeekTableEntry(int id, uint64_t offset) {
 
 void MmpldWriter::write_particle_list_header(uint64_t particle_count, int sphereId) {
 #ifdef ENABLE_MPI
+	// one write per header instead of one per field
+	std::vector<char> buffer;
+	get_particle_list_header(particle_count, sphereId, buffer);
 	MPI_Status status;
-	MPI_File_write(_mpifh, &_vertex_type,  1, MPI_BYTE, &status);
-	MPI_File_write(_mpifh, &_color_type,   1, MPI_BYTE, &status);
-	if(_vertex_type == MMPLD_VERTEX_FLOAT_XYZ || _vertex_type == MMPLD_VERTEX_SHORT_XYZ) {
-		MPI_File_write(_mpifh, &_global_radius[sphereId], 4, MPI_BYTE, &status);
-	}
-	if(_color_type == MMPLD_COLOR_NONE) {
-		MPI_File_write(_mpifh, &_global_rgba[sphereId],   4, MPI_BYTE, &status);
-	} else if(_color_type == MMPLD_COLOR_FLOAT_I) {
-		MPI_File_write(_mpifh, &_global_intensity_range[sphereId],   8, MPI_BYTE, &status);
-	}
-	uint64_t particle_count_le = htole64(particle_count);
-	MPI_File_write(_mpifh, &particle_count_le, sizeof(particle_count_le), MPI_BYTE, &status);
+	MPI_File_write(_mpifh, buffer.data(), buffer.size(), MPI_BYTE, &status);
 #else
 	/** @todo need to implement serial version */
 #endif
@@ -63,6 +63,20 @@ protected:
 	void InitSphereData();
 
 public:
+	/** @brief Read in XML configuration for MmpldWriter.
+	 *
+	 * Besides write control, output prefix and sphere parameters, the following MPI-IO settings are handled:
+	 * \code{.xml}
+	   <outputplugin name="MmpldWriter" type="simple|multi">
+	     <!-- 1: gather the frame on one aggregator process per node and write it with large, stripe aligned
+	          collective writes (MPI_File_write_at_all); 0 (default): every process writes its own data -->
+	     <aggregate>INTEGER</aggregate>
+	     <!-- file system stripe size in bytes for aggregate mode; default: hint striping_unit, else 1 MiB -->
+	     <stripesize>INTEGER</stripesize>
+	     <mpi_info> <pair> <key>STRING</key> <value>STRING</value> </pair> </mpi_info>
+	   </outputplugin>
+	   \endcode
+	 */
 	void readXML(XMLfileUnits& xmlconfig);
 
 	void init(ParticleContainer *particleContainer,
@@ -95,9 +109,21 @@ protected:
 	long get_data_list_header_size();
 	long get_particle_data_size();
 	long get_data_list_size(uint64_t particle_count);
+	void get_frame_header(uint32_t num_data_lists, std::vector<char>& buffer);
+	void get_particle_list_header(uint64_t particle_count, int sphereId, std::vector<char>& buffer);
 	void write_frame_header(uint32_t num_data_lists);
 	void write_particle_list_header(uint64_t particle_count, int sphereId);
 	void write_frame(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp);
+#ifdef ENABLE_MPI
+	//! @brief write the data of the current frame in two phases: all processes of a node send their part (including
+	//! the headers from rank 0) to the node's aggregator, the aggregators redistribute the data into contiguous,
+	//! stripe aligned file domains and write them with one MPI_File_write_at_all.
+	void write_frame_aggregated(ParticleContainer* particleContainer, int rank,
+			const std::vector<uint64_t>& globalNumCompSpheres, const std::vector<uint64_t>& exscanNumCompSpheres,
+			const std::vector<uint64_t>& dataListBeginOffsets);
+	void createAggregatorComms();
+	void freeAggregatorComms();
+#endif
 
 protected:
 	/** First time step to be recorded */
@@ -132,9 +158,18 @@ protected:
 	std::vector< std::array<float, 2> > _global_intensity_range;
 
 
+	//! gather frames on node aggregators and write them collectively, see write_frame_aggregated()
+	bool _aggregate;
+	//! write granularity of the aggregators in bytes, 0: determine from MPI info hint or default
+	long _stripeSize;
+
 #ifdef ENABLE_MPI
 	MPI_File _mpifh;
 	MPI_Info_object _mpiinfo;
+	//! processes of the same (shared memory) node
+	MPI_Comm _nodeComm;
+	//! the first process of every node, MPI_COMM_NULL on all others
+	MPI_Comm _aggregatorComm;
 #endif
 };
 
@@ -59,6 +59,9 @@ public:
 	}
 	static PluginBase* createInstance() { return new ResultWriter(); }
 
+	//! only the global values of the domain are written
+	bool accessesVelocitiesAt(MoleculeVisitHook) { return false; }
+
 private:
 	std::ofstream _resultStream;
 	unsigned long _writeFrequency;
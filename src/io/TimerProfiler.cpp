@@ -162,6 +162,7 @@ void TimerProfiler::readInitialTimersFromFile(string fileName){
 		"COMMUNICATION_PARTNER",
 		"SIMULATION",
 		"UNIFORM_PSEUDO_PARTICLE_CONTAINER",
+		"SMOOTH_PARTICLE_MESH_EWALD",
 		"GENERATORS",
 		"CELL_PROCESSORS",
 		"TUNERS",
@@ -199,6 +200,7 @@ void TimerProfiler::readInitialTimersFromFile(string fileName){
 		make_tuple("QUICKSCHED", vector<string>{"SIMULATION_LOOP"}, true),
 #endif
 		make_tuple("SIMULATION_PER_STEP_IO", vector<string>{"SIMULATION_LOOP"}, true),
+		make_tuple("SIMULATION_PLUGIN_MOLECULE_VISIT", vector<string>{"SIMULATION_LOOP"}, true),
 		make_tuple("SIMULATION_IO", vector<string>{"SIMULATION"}, true),
 		make_tuple("SIMULATION_UPDATE_CONTAINER", vector<string>{"SIMULATION_DECOMPOSITION"}, true),
 		make_tuple("SIMULATION_MPI_OMP_COMMUNICATION", vector<string>{"SIMULATION_DECOMPOSITION"}, true),
@@ -226,7 +228,12 @@ void TimerProfiler::readInitialTimersFromFile(string fileName){
 		make_tuple("UNIFORM_PSEUDO_PARTICLE_CONTAINER_GATHER_EVAL_M", vector<string>{"UNIFORM_PSEUDO_PARTICLE_CONTAINER"}, true),
 		make_tuple("UNIFORM_PSEUDO_PARTICLE_CONTAINER_GATHER_EVAL_LM", vector<string>{"UNIFORM_PSEUDO_PARTICLE_CONTAINER"}, true),
 		make_tuple("UNIFORM_PSEUDO_PARTICLE_CONTAINER_ALL_REDUCE_ME", vector<string>{"UNIFORM_PSEUDO_PARTICLE_CONTAINER"}, true),
-		make_tuple("UNIFORM_PSEUDO_PARTICLE_CONTAINER_STOP_LEVEL", vector<string>{"UNIFORM_PSEUDO_PARTICLE_CONTAINER"}, true)
+		make_tuple("UNIFORM_PSEUDO_PARTICLE_CONTAINER_STOP_LEVEL", vector<string>{"UNIFORM_PSEUDO_PARTICLE_CONTAINER"}, true),
+		make_tuple("SMOOTH_PARTICLE_MESH_EWALD_COMPLETE", vector<string>{"SMOOTH_PARTICLE_MESH_EWALD"}, true),
+		make_tuple("SMOOTH_PARTICLE_MESH_EWALD_SPREAD", vector<string>{"SMOOTH_PARTICLE_MESH_EWALD"}, true),
+		make_tuple("SMOOTH_PARTICLE_MESH_EWALD_FFT", vector<string>{"SMOOTH_PARTICLE_MESH_EWALD"}, true),
+		make_tuple("SMOOTH_PARTICLE_MESH_EWALD_COMMUNICATION", vector<string>{"SMOOTH_PARTICLE_MESH_EWALD"}, true),
+		make_tuple("SMOOTH_PARTICLE_MESH_EWALD_GATHER", vector<string>{"SMOOTH_PARTICLE_MESH_EWALD"}, true)
 	};
 
 	for (auto timerClass : timerClasses){
@@ -50,6 +50,7 @@ public:
 
 	std::string getPluginName() override { return std::string("TimerWriter"); }
 	static PluginBase *createInstance() { return new TimerWriter(); }
+	bool accessesVelocitiesAt(MoleculeVisitHook) override { return false; }
 
 private:
 	unsigned long _writeFrequency{0ul};
@@ -8,9 +8,16 @@
  */
 
 #include "Domain.h"
+#include "io/CompactCheckpoint.h"
+#include "io/CompactCheckpointReader.h"
+#include "io/CheckpointWriter.h"
+#include "particleContainer/LinkedCells.h"
 #include "particleContainer/ParticleContainer.h"
 #include "parallel/DomainDecompBase.h"
+#include <array>
+#include <fstream>
 #include <iostream>
+#include <map>
 
 #include "io/tests/CheckpointRestartTest.h"
 
@@ -37,18 +44,96 @@ void CheckpointRestartTest::testCheckpointRestartBinary() {
 	testCheckpointRestart(true);
 }
 
+/*
+ * This tests if a written checkpoint can successfully be read again using binary with a spatial index.
+ */
+void CheckpointRestartTest::testCheckpointRestartBinaryIndexed() {
+	testCheckpointRestart(true, true);
+}
+
+/*
+ * This tests if a compact checkpoint (chunked, compressed if LZ4 is available) restores all molecules exactly.
+ */
+void CheckpointRestartTest::testCheckpointRestartCompact() {
+	testCompactCheckpointRestart(false);
+}
+
+/*
+ * This tests if a compact checkpoint with quantized positions restores all molecules up to the quantization error.
+ */
+void CheckpointRestartTest::testCheckpointRestartCompactQuantized() {
+	testCompactCheckpointRestart(true);
+}
+
+#ifdef ENABLE_MPI
+/*
+ * Two asynchronous checkpoints in a row to the same file: the second write must neither race with the first one nor
+ * be described by its header. Both orders (shrinking and growing file) are written and read back.
+ */
+void CheckpointRestartTest::testCheckpointRestartAsyncSameFile() {
+	constexpr double cutoff = 10.5;
+	const std::string xmlFilename = getTestDataFilename("restart.test.async.xml", false);
+	if (_domainDecomposition->getRank() == 0) {
+		std::ofstream xml(xmlFilename);
+		xml << "<outputplugin name=\"CheckpointWriter\">"
+			   "<type>binary</type><writefrequency>1</writefrequency>"
+			   "<outputprefix>" << getTestDataFilename("restart.test.async", false) << "</outputprefix>"
+			   "<incremental>0</incremental><async>1</async></outputplugin>" << endl;
+	}
+	XMLfileUnits xmlconfig(xmlFilename);
+	xmlconfig.changecurrentnode("/outputplugin");
+	CheckpointWriter writer;
+	writer.readXML(xmlconfig);
+
+	// two distinguishable checkpoints of different size: all molecules and every second one with changed velocity
+	std::array<ParticleContainer*, 2> particleContainers;
+	std::array<std::map<unsigned long, double>, 2> velocities;
+	for (int i = 0; i < 2; ++i) {
+		particleContainers[i] = initializeFromFile(ParticleContainerFactory::LinkedCell,
+				"VectorizationMultiComponentMultiPotentials_50_molecules.inp", cutoff);
+		for (auto it = particleContainers[i]->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+			if (i == 1 and it->getID() % 2 == 1) {
+				particleContainers[i]->deleteMolecule(it, false);
+				continue;
+			}
+			it->setv(0, it->v(0) + i);
+			velocities[i][it->getID()] = it->v(0);
+		}
+	}
+
+	unsigned long simstep = 0;
+	for (int last = 0; last < 2; ++last) {
+		const int first = 1 - last;
+		writer.endStep(particleContainers[first], _domainDecomposition, _domain, ++simstep);
+		writer.endStep(particleContainers[last], _domainDecomposition, _domain, ++simstep);
+		writer.finish(particleContainers[last], _domainDecomposition, _domain);
+
+		ParticleContainer* restarted
+			= initializeFromFile(ParticleContainerFactory::LinkedCell, "restart.test.async.restart", cutoff, true);
+		ASSERT_EQUAL(getGlobalParticleNumber(particleContainers[last]), getGlobalParticleNumber(restarted));
+		for (auto it = restarted->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+			ASSERT_EQUAL(1ul, static_cast<unsigned long>(velocities[last].count(it->getID())));
+			ASSERT_DOUBLES_EQUAL(velocities[last][it->getID()], it->v(0), 0.);
+		}
+		delete restarted;
+	}
+	delete particleContainers[0];
+	delete particleContainers[1];
+}
+#endif
+
 /*
  * Actual test if a written checkpoint can successfully be read again.
  */
-void CheckpointRestartTest::testCheckpointRestart(bool binary) {
+void CheckpointRestartTest::testCheckpointRestart(bool binary, bool writeIndex) {
 	constexpr double cutoff = 10.5;
 	ParticleContainer* particleContainer
 		= initializeFromFile(ParticleContainerFactory::LinkedCell, "VectorizationMultiComponentMultiPotentials_50_molecules.inp", cutoff);
 	auto initialParticleCount = getGlobalParticleNumber(particleContainer);
 
-	std::string filename = binary ? "restart.test" : "restart.test.dat";
+	std::string filename = binary ? (writeIndex ? "restart.test.indexed" : "restart.test") : "restart.test.dat";
 	_domain->writeCheckpoint(getTestDataFilename(filename, false), particleContainer, _domainDecomposition,
-	                         0., binary);
+	                         0., binary, writeIndex, cutoff);
 
 	delete particleContainer;
 
@@ -60,6 +145,64 @@ void CheckpointRestartTest::testCheckpointRestart(bool binary) {
 	delete particleContainer2;
 }
 
+void CheckpointRestartTest::testCompactCheckpointRestart(bool quantize) {
+	constexpr double cutoff = 10.5;
+	ParticleContainer* particleContainer
+		= initializeFromFile(ParticleContainerFactory::LinkedCell, "VectorizationMultiComponentMultiPotentials_50_molecules.inp", cutoff);
+	auto initialParticleCount = getGlobalParticleNumber(particleContainer);
+	std::map<unsigned long, std::array<double, 10>> initialMolecules;
+	for (auto it = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+		initialMolecules[it->getID()] = {it->r(0), it->r(1), it->r(2), it->v(0), it->v(1), it->v(2),
+										 it->q().qw(), it->D(0), it->D(1), it->D(2)};
+	}
+
+	CompactCheckpoint::Options options;
+#ifdef ENABLE_LZ4
+	options.compression = "LZ4";
+#endif
+	options.quantize = quantize;
+	options.chunkLength = cutoff;  // several chunks
+	const double globalLength[3] = {_domain->getGlobalLength(0), _domain->getGlobalLength(1), _domain->getGlobalLength(2)};
+	const std::string filename = getTestDataFilename(quantize ? "restart.test.quantized.ckp" : "restart.test.ckp", false);
+	CompactCheckpoint::write(filename, particleContainer, _domainDecomposition, 0., globalLength, options);
+	delete particleContainer;
+
+	CompactCheckpointReader reader;
+	reader.setPhaseSpaceFile(filename);
+	reader.readPhaseSpaceHeader(_domain, 1.0);
+	double bBoxMin[3];
+	double bBoxMax[3];
+	for (int d = 0; d < 3; d++) {
+		ASSERT_DOUBLES_EQUAL(globalLength[d], _domain->getGlobalLength(d), 0.);
+		bBoxMin[d] = _domainDecomposition->getBoundingBoxMin(d, _domain);
+		bBoxMax[d] = _domainDecomposition->getBoundingBoxMax(d, _domain);
+	}
+	ParticleContainer* particleContainer2 = new LinkedCells(bBoxMin, bBoxMax, cutoff);
+	reader.readPhaseSpace(particleContainer2, _domain, _domainDecomposition);
+	particleContainer2->update();
+
+	auto restartedParticleCount = getGlobalParticleNumber(particleContainer2);
+	ASSERT_EQUAL(initialParticleCount, restartedParticleCount);
+	// quantization error: 2^-32 of a chunk extent, chunks are at most cutoff wide
+	const double tolerance = quantize ? 1e-8 : 0.;
+	for (auto it = particleContainer2->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+		ASSERT_EQUAL(1ul, static_cast<unsigned long>(initialMolecules.count(it->getID())));
+		const auto& initial = initialMolecules[it->getID()];
+		for (int d = 0; d < 3; ++d) {
+			ASSERT_DOUBLES_EQUAL(initial[d], it->r(d), tolerance);
+			ASSERT_DOUBLES_EQUAL(initial[3 + d], it->v(d), 0.);
+		}
+		// orientation and angular momentum are only stored for molecules that can rotate
+		if (it->component()->getRotationalDegreesOfFreedom() > 0) {
+			ASSERT_DOUBLES_EQUAL(initial[6], it->q().qw(), 0.);
+			for (int d = 0; d < 3; ++d) {
+				ASSERT_DOUBLES_EQUAL(initial[7 + d], it->D(d), 0.);
+			}
+		}
+	}
+	delete particleContainer2;
+}
+
 unsigned long CheckpointRestartTest::getGlobalParticleNumber(ParticleContainer* particleContainer){
 	unsigned long localParticleCount = particleContainer->getNumberOfParticles();
 	_domainDecomposition->collCommInit(1);
@@ -21,6 +21,20 @@ class CheckpointRestartTest : public utils::TestWithSimulationSetup {
 	// add a method which perform test
 	TEST_METHOD(testCheckpointRestartBinary);
 
+	// add a method which perform test
+	TEST_METHOD(testCheckpointRestartBinaryIndexed);
+
+	// add a method which perform test
+	TEST_METHOD(testCheckpointRestartCompact);
+
+	// add a method which perform test
+	TEST_METHOD(testCheckpointRestartCompactQuantized);
+
+#ifdef ENABLE_MPI
+	// add a method which perform test
+	TEST_METHOD(testCheckpointRestartAsyncSameFile);
+#endif
+
 	// end suite declaration
 	TEST_SUITE_END();
 
@@ -31,8 +45,19 @@ public:
 	void testCheckpointRestartASCII();
 
 	void testCheckpointRestartBinary();
+
+	void testCheckpointRestartBinaryIndexed();
+
+	void testCheckpointRestartCompact();
+
+	void testCheckpointRestartCompactQuantized();
+
+#ifdef ENABLE_MPI
+	void testCheckpointRestartAsyncSameFile();
+#endif
 private:
 
-	void testCheckpointRestart(bool binary);
+	void testCheckpointRestart(bool binary, bool writeIndex = false);
+	void testCompactCheckpointRestart(bool quantize);
 	unsigned long getGlobalParticleNumber(ParticleContainer* particleContainer);
 };
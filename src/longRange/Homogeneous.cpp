@@ -34,15 +34,18 @@ void Homogeneous::init() {
 		unsigned int numchargesi = ci.numCharges();
 		unsigned int numdipolesi = ci.numDipoles();
 
-		// effective dipoles computed from point charge distributions
+		// effective dipoles computed from point charge distributions,
+		// unless the charges are part of an Ewald sum and have no reaction field
 		double chargeBalance[3];
 		for (unsigned d = 0; d < 3; d++) {
 			chargeBalance[d] = 0;
 		}
-		for (unsigned int si = 0; si < numchargesi; si++) {
-			double tq = ci.charge(si).q();
-			for (unsigned d = 0; d < 3; d++) {
-				chargeBalance[d] += tq * ci.charge(si).r()[d];
+		if (global_simulation->getSPME() == nullptr) {
+			for (unsigned int si = 0; si < numchargesi; si++) {
+				double tq = ci.charge(si).q();
+				for (unsigned d = 0; d < 3; d++) {
+					chargeBalance[d] += tq * ci.charge(si).r()[d];
+				}
 			}
 		}
 		// point dipoles
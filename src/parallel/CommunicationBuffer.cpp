@@ -10,7 +10,11 @@
 #include "Simulation.h"
 #include "ensemble/EnsembleBase.h"
 
+#include <algorithm>
 #include <climits> /* UINT64_MAX */
+#include <cmath>
+#include <cstdint>
+#include <limits>
 
 #ifdef ENABLE_REDUCED_MEMORY_MODE
 // position, velocity, id
@@ -34,13 +38,52 @@ size_t CommunicationBuffer::_numBytesHalo = 7 * sizeof(double) + sizeof(int)
 size_t CommunicationBuffer::_numBytesForces = sizeof(unsigned long) + 12 * sizeof(double);
 #endif
 
+bool CommunicationBuffer::_haloLayoutSoA = false;
+bool CommunicationBuffer::_reducedPrecision = false;
+bool CommunicationBuffer::_sendHaloIDs = true;
+
+namespace {
+// quaternion components are in [-1, 1] and are sent as 16-bit fixed point numbers
+constexpr double quaternionScale = 32767.;
+
+int16_t encodeQuaternionComponent(double q) {
+	return static_cast<int16_t>(std::lround(std::max(-1., std::min(1., q)) * quaternionScale));
+}
+
+double decodeQuaternionComponent(int16_t q) {
+	return static_cast<double>(q) / quaternionScale;
+}
+}  // namespace
+
+double CommunicationBuffer::roundToReducedPosition(double r, double origin, double low, double high) {
+	mardyn_assert(low < high);
+	float offset = static_cast<float>(r - origin);
+	double rounded = origin + offset;
+	while (rounded < low) {
+		offset = std::nextafter(offset, std::numeric_limits<float>::max());
+		rounded = origin + offset;
+	}
+	while (rounded >= high) {
+		offset = std::nextafter(offset, std::numeric_limits<float>::lowest());
+		rounded = origin + offset;
+	}
+	return rounded;
+}
+
+void CommunicationBuffer::setReducedPrecisionEncoding(bool reduced) {
+	_reducedPrecision = reduced;
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	// id and position stay exact, forces, torques and virials are sent as floats
+	_numBytesForces = sizeof(unsigned long) + 3 * sizeof(double) + 9 * (reduced ? sizeof(float) : sizeof(double));
+#endif
+}
 
 unsigned char* CommunicationBuffer::getDataForSending() {
-	return _buffer.data();
+	return bufferData();
 }
 
 size_t CommunicationBuffer::getNumElementsForSending() {
-	return _buffer.size();
+	return bufferSize();
 }
 
 void CommunicationBuffer::clear() {
@@ -48,13 +91,51 @@ void CommunicationBuffer::clear() {
 	_numLeaving = 0;
 	_numForces = 0;
 	_buffer.clear();
+	_externalSize = 0;
 }
 
 void CommunicationBuffer::resizeForRawBytes(unsigned long numBytes) {
+	if (_external != nullptr) {
+		if (numBytes <= _externalCapacity) {
+			_externalSize = numBytes;
+			return;
+		}
+		moveExternalToOwnStorage();
+	}
 	_buffer.reserve(numBytes);
 	_buffer.resize(numBytes);
 }
 
+void CommunicationBuffer::reserveRawBytes(unsigned long numBytes) {
+	if (_external != nullptr) {
+		if (numBytes <= _externalCapacity) {
+			return;
+		}
+		moveExternalToOwnStorage();
+	}
+	_buffer.reserve(numBytes);
+}
+
+void CommunicationBuffer::attachExternalStorage(unsigned char* data, size_t capacity, size_t size) {
+	mardyn_assert(size <= capacity);
+	_buffer.clear();
+	_external = data;
+	_externalCapacity = capacity;
+	_externalSize = size;
+}
+
+void CommunicationBuffer::detachExternalStorage() {
+	_external = nullptr;
+	_externalSize = _externalCapacity = 0;
+	_buffer.clear();
+}
+
+void CommunicationBuffer::moveExternalToOwnStorage() {
+	_buffer.assign(_external, _external + _externalSize);
+	_external = nullptr;
+	_externalSize = _externalCapacity = 0;
+}
+
 void CommunicationBuffer::resizeForReceivingMolecules(unsigned long& numLeaving, unsigned long& numHalo) { // adjust for force exchange?
 	// message has been received
 
@@ -72,7 +153,7 @@ void CommunicationBuffer::resizeForReceivingMolecules(unsigned long& numForces)
 	// read _numForces
 	size_t i_runningByte = 0;
 	//i_runningByte = readValue(i_runningByte, _numForces);
-	_numForces = _buffer.size() / _numBytesForces;
+	_numForces = bufferSize() / _numBytesForces;
 	numForces = _numForces;
 }
 
@@ -115,7 +196,7 @@ void CommunicationBuffer::addLeavingMolecule(size_t indexOfMolecule, const Molec
 	mardyn_assert(indexOfMolecule < _numLeaving);
 
 	size_t i_firstByte = getStartPosition(ParticleType_t::LEAVING, indexOfMolecule);
-	mardyn_assert(i_firstByte + _numBytesLeaving <= _buffer.capacity());
+	mardyn_assert(i_firstByte + _numBytesLeaving <= bufferCapacity());
 
 	size_t i_runningByte = i_firstByte;
 #ifdef ENABLE_REDUCED_MEMORY_MODE
@@ -152,7 +233,7 @@ void CommunicationBuffer::addHaloMolecule(size_t indexOfMolecule, const Molecule
 	mardyn_assert(indexOfMolecule < _numHalo);
 
 	size_t i_firstByte = getStartPosition(ParticleType_t::HALO, indexOfMolecule);
-	mardyn_assert(i_firstByte + _numBytesHalo <= _buffer.capacity());
+	mardyn_assert(i_firstByte + _numBytesHalo <= bufferCapacity());
 
 	size_t i_runningByte = i_firstByte;
 #ifdef ENABLE_REDUCED_MEMORY_MODE
@@ -200,6 +281,18 @@ void CommunicationBuffer::addForceMolecule(size_t indexOfMolecule, const Molecul
 	i_runningByte = emplaceValue(i_runningByte, m.r(0));
 	i_runningByte = emplaceValue(i_runningByte, m.r(1));
 	i_runningByte = emplaceValue(i_runningByte, m.r(2));
+	if (_reducedPrecision) {
+		for (int d = 0; d < 3; d++) {
+			i_runningByte = emplaceValue(i_runningByte, static_cast<float>(m.F(d)));
+		}
+		for (int d = 0; d < 3; d++) {
+			i_runningByte = emplaceValue(i_runningByte, static_cast<float>(m.M(d)));
+		}
+		for (int d = 0; d < 3; d++) {
+			i_runningByte = emplaceValue(i_runningByte, static_cast<float>(m.Vi(d)));
+		}
+		return;
+	}
 	i_runningByte = emplaceValue(i_runningByte, m.F(0));
 	i_runningByte = emplaceValue(i_runningByte, m.F(1));
 	i_runningByte = emplaceValue(i_runningByte, m.F(2));
@@ -216,7 +309,7 @@ void CommunicationBuffer::readLeavingMolecule(size_t indexOfMolecule, Molecule&
 	mardyn_assert(indexOfMolecule < _numLeaving);
 
 	size_t i_firstByte = getStartPosition(ParticleType_t::LEAVING, indexOfMolecule);
-	mardyn_assert(i_firstByte + _numBytesLeaving <= _buffer.capacity());
+	mardyn_assert(i_firstByte + _numBytesLeaving <= bufferCapacity());
 
 	size_t i_runningByte = i_firstByte;
 #ifdef ENABLE_REDUCED_MEMORY_MODE
@@ -271,7 +364,7 @@ void CommunicationBuffer::readHaloMolecule(size_t indexOfMolecule, Molecule& m)
 	mardyn_assert(indexOfMolecule < _numHalo);
 
 	size_t i_firstByte = getStartPosition(ParticleType_t::HALO, indexOfMolecule);
-	mardyn_assert(i_firstByte + _numBytesHalo <= _buffer.capacity());
+	mardyn_assert(i_firstByte + _numBytesHalo <= bufferCapacity());
 
 	// add id, r, v
 	size_t i_runningByte = i_firstByte;
@@ -319,6 +412,212 @@ void CommunicationBuffer::readHaloMolecule(size_t indexOfMolecule, Molecule& m)
 	mardyn_assert(i_runningByte - i_firstByte == _numBytesHalo);
 }
 
+void CommunicationBuffer::setHaloMoleculesSoA(const std::vector<const Molecule*>& molecules,
+		const std::vector<std::array<double, 3>>& positions, const double* offsetOrigin) {
+	mardyn_assert(_numHalo == 0ul);  // assumption: all halo molecules are written at once, after the leaving ones
+	mardyn_assert(molecules.size() == positions.size());
+	const size_t numHalo = molecules.size();
+	// the flags tell the receiver which parts of the reduced-precision encoding are used for this message
+	unsigned char flags = 0;
+	if (_reducedPrecision) {
+		flags |= haloFlagReducedQuaternions;
+		if (offsetOrigin != nullptr) {
+			flags |= haloFlagReducedPositions;
+		}
+		if (offsetOrigin == nullptr or _sendHaloIDs) {
+			flags |= haloFlagIDs;
+		}
+	}
+	const bool sendIDs = not _reducedPrecision or (flags & haloFlagIDs);
+	const bool reducedPositions = flags & haloFlagReducedPositions;
+
+	size_t numBytesHalo = 0;
+	size_t numRotating = 0;
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+	numBytesHalo = numHalo * 3 * sizeof(vcp_real_calc);
+#else
+	for (const Molecule* m : molecules) {
+		if (m->component()->getRotationalDegreesOfFreedom() > 0) {
+			++numRotating;
+		}
+	}
+	if (_reducedPrecision) {
+		numBytesHalo = sizeof(flags) + numHalo * sizeof(unsigned int) + numRotating * 4 * sizeof(int16_t);
+		numBytesHalo += reducedPositions ? 3 * sizeof(double) + numHalo * 3 * sizeof(float) : numHalo * 3 * sizeof(double);
+	} else {
+		numBytesHalo = numHalo * (sizeof(unsigned int) + 3 * sizeof(double)) + numRotating * 4 * sizeof(double);
+	}
+#endif
+#ifdef LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES
+	if (sendIDs) {
+		numBytesHalo += numHalo * sizeof(unsigned long);
+	}
+#endif
+	_numHalo = numHalo;
+	resizeForRawBytes(sizeof(_numHalo) + sizeof(_numLeaving) + _numLeaving * _numBytesLeaving + numBytesHalo);
+
+	// store _numHalo
+	emplaceValue(sizeof(_numLeaving), _numHalo);
+
+	size_t i_runningByte = getStartPosition(ParticleType_t::HALO, 0);
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	if (_reducedPrecision) {
+		i_runningByte = emplaceValue(i_runningByte, flags);
+	}
+#endif
+#ifdef LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES
+	if (sendIDs) {
+		for (const Molecule* m : molecules) {
+			i_runningByte = emplaceValue(i_runningByte, m->getID());
+		}
+	}
+#endif
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+	for (int d = 0; d < 3; ++d) {
+		for (const auto& r : positions) {
+			i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_calc>(r[d]));
+		}
+	}
+#else
+	for (const Molecule* m : molecules) {
+		i_runningByte = emplaceValue(i_runningByte, m->componentid());
+	}
+	if (reducedPositions) {
+		for (int d = 0; d < 3; ++d) {
+			i_runningByte = emplaceValue(i_runningByte, offsetOrigin[d]);
+		}
+		for (int d = 0; d < 3; ++d) {
+			for (const auto& r : positions) {
+				mardyn_assert(r[d] >= offsetOrigin[d]);
+				i_runningByte = emplaceValue(i_runningByte, static_cast<float>(r[d] - offsetOrigin[d]));
+			}
+		}
+	} else {
+		for (int d = 0; d < 3; ++d) {
+			for (const auto& r : positions) {
+				i_runningByte = emplaceValue(i_runningByte, r[d]);
+			}
+		}
+	}
+	// orientations are only needed for molecules that can rotate
+	for (const Molecule* m : molecules) {
+		if (m->component()->getRotationalDegreesOfFreedom() > 0) {
+			const Quaternion& q = m->q();
+			if (_reducedPrecision) {
+				i_runningByte = emplaceValue(i_runningByte, encodeQuaternionComponent(q.qw()));
+				i_runningByte = emplaceValue(i_runningByte, encodeQuaternionComponent(q.qx()));
+				i_runningByte = emplaceValue(i_runningByte, encodeQuaternionComponent(q.qy()));
+				i_runningByte = emplaceValue(i_runningByte, encodeQuaternionComponent(q.qz()));
+			} else {
+				i_runningByte = emplaceValue(i_runningByte, q.qw());
+				i_runningByte = emplaceValue(i_runningByte, q.qx());
+				i_runningByte = emplaceValue(i_runningByte, q.qy());
+				i_runningByte = emplaceValue(i_runningByte, q.qz());
+			}
+		}
+	}
+#endif
+
+	mardyn_assert(i_runningByte == bufferSize());
+}
+
+void CommunicationBuffer::readHaloMoleculesSoA(std::vector<Molecule>& molecules) const {
+	const size_t numHalo = _numHalo;
+	size_t i_runningByte = getStartPosition(ParticleType_t::HALO, 0);
+
+	unsigned char flags = 0;
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	if (_reducedPrecision) {
+		i_runningByte = readValue(i_runningByte, flags);
+	}
+#endif
+
+	std::vector<unsigned long> ids(numHalo, UINT64_MAX);
+#ifdef LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES
+	if (not _reducedPrecision or (flags & haloFlagIDs)) {
+		for (size_t i = 0; i < numHalo; ++i) {
+			i_runningByte = readValue(i_runningByte, ids[i]);
+		}
+	}
+#endif
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+	std::vector<vcp_real_calc> r[3];
+	for (int d = 0; d < 3; ++d) {
+		r[d].resize(numHalo);
+		for (size_t i = 0; i < numHalo; ++i) {
+			i_runningByte = readValue(i_runningByte, r[d][i]);
+		}
+	}
+#else
+	std::vector<unsigned int> cids(numHalo);
+	for (size_t i = 0; i < numHalo; ++i) {
+		i_runningByte = readValue(i_runningByte, cids[i]);
+	}
+	std::vector<double> r[3];
+	if (flags & haloFlagReducedPositions) {
+		double origin[3];
+		for (int d = 0; d < 3; ++d) {
+			i_runningByte = readValue(i_runningByte, origin[d]);
+		}
+		for (int d = 0; d < 3; ++d) {
+			r[d].resize(numHalo);
+			for (size_t i = 0; i < numHalo; ++i) {
+				float offset;
+				i_runningByte = readValue(i_runningByte, offset);
+				r[d][i] = origin[d] + offset;
+			}
+		}
+	} else {
+		for (int d = 0; d < 3; ++d) {
+			r[d].resize(numHalo);
+			for (size_t i = 0; i < numHalo; ++i) {
+				i_runningByte = readValue(i_runningByte, r[d][i]);
+			}
+		}
+	}
+#endif
+
+	molecules.resize(numHalo);
+	for (size_t i = 0; i < numHalo; ++i) {
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+		molecules[i].setid(ids[i]);
+		for (int d = 0; d < 3; ++d) {
+			molecules[i].setr(d, r[d][i]);
+		}
+#else
+		Component* component = _simulation.getEnsemble()->getComponent(cids[i]);
+		double qbuf[4] = {1., 0., 0., 0.};
+		if (component->getRotationalDegreesOfFreedom() > 0) {
+			if (flags & haloFlagReducedQuaternions) {
+				int16_t qcompressed[4];
+				for (int j = 0; j < 4; ++j) {
+					i_runningByte = readValue(i_runningByte, qcompressed[j]);
+				}
+				Quaternion q(decodeQuaternionComponent(qcompressed[0]), decodeQuaternionComponent(qcompressed[1]),
+						decodeQuaternionComponent(qcompressed[2]), decodeQuaternionComponent(qcompressed[3]));
+				q.normalize();
+				qbuf[0] = q.qw();
+				qbuf[1] = q.qx();
+				qbuf[2] = q.qy();
+				qbuf[3] = q.qz();
+			} else {
+				for (int j = 0; j < 4; ++j) {
+					i_runningByte = readValue(i_runningByte, qbuf[j]);
+				}
+			}
+		}
+		molecules[i] = Molecule(ids[i], component,
+			r[0][i], r[1][i], r[2][i],
+			0., 0., 0.,
+			qbuf[0], qbuf[1], qbuf[2], qbuf[3],
+			0., 0., 0.
+		);
+#endif
+	}
+
+	mardyn_assert(i_runningByte == bufferSize());
+}
+
 void CommunicationBuffer::readForceMolecule(size_t indexOfMolecule, Molecule& m) const {
 	// some mardyn assert
 	size_t i_firstByte = getStartPosition(ParticleType_t::FORCE, indexOfMolecule);
@@ -354,15 +653,27 @@ void CommunicationBuffer::readForceMolecule(size_t indexOfMolecule, Molecule& m)
 	i_runningByte = readValue(i_runningByte, rbuf[0]);
 	i_runningByte = readValue(i_runningByte, rbuf[1]);
 	i_runningByte = readValue(i_runningByte, rbuf[2]);
-	i_runningByte = readValue(i_runningByte, Fbuf[0]);
-	i_runningByte = readValue(i_runningByte, Fbuf[1]);
-	i_runningByte = readValue(i_runningByte, Fbuf[2]);
-	i_runningByte = readValue(i_runningByte, Mbuf[0]);
-	i_runningByte = readValue(i_runningByte, Mbuf[1]);
-	i_runningByte = readValue(i_runningByte, Mbuf[2]);
-	i_runningByte = readValue(i_runningByte, Vibuf[0]);
-	i_runningByte = readValue(i_runningByte, Vibuf[1]);
-	i_runningByte = readValue(i_runningByte, Vibuf[2]);
+	if (_reducedPrecision) {
+		float fbuf[9];
+		for (int j = 0; j < 9; j++) {
+			i_runningByte = readValue(i_runningByte, fbuf[j]);
+		}
+		for (int d = 0; d < 3; d++) {
+			Fbuf[d] = fbuf[d];
+			Mbuf[d] = fbuf[3 + d];
+			Vibuf[d] = fbuf[6 + d];
+		}
+	} else {
+		i_runningByte = readValue(i_runningByte, Fbuf[0]);
+		i_runningByte = readValue(i_runningByte, Fbuf[1]);
+		i_runningByte = readValue(i_runningByte, Fbuf[2]);
+		i_runningByte = readValue(i_runningByte, Mbuf[0]);
+		i_runningByte = readValue(i_runningByte, Mbuf[1]);
+		i_runningByte = readValue(i_runningByte, Mbuf[2]);
+		i_runningByte = readValue(i_runningByte, Vibuf[0]);
+		i_runningByte = readValue(i_runningByte, Vibuf[1]);
+		i_runningByte = readValue(i_runningByte, Vibuf[2]);
+	}
 	m.setid(idbuf);
 	for(int d = 0; d < 3; d++) {
 		m.setr(d, rbuf[d]);
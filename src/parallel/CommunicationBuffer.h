@@ -11,6 +11,7 @@
 #include "molecules/MoleculeForwardDeclaration.h" 
 #include "utils/mardyn_assert.h" 
 
+#include <array>
 #include <vector>
 #include <stddef.h>
 #include <mpi.h>
@@ -33,6 +34,17 @@
  * due to CHAR conversion.
  *
  * Stores two unsigned long integers, then leaving molecules, then halo molecules.
+ *
+ * The halo molecules are either stored molecule by molecule (default) or, if setHaloLayoutSoA(true) was called, as
+ * one block of arrays written by setHaloMoleculesSoA(): ids, component ids, x, y, z and the quaternions only of the
+ * molecules whose component has rotational degrees of freedom.
+ *
+ * With the reduced-precision encoding (setReducedPrecisionEncoding(true), requires the SoA layout) the halo block
+ * starts with a flag byte and stores the quaternions as 16-bit fixed point numbers. Unless the halo copies have to
+ * be matched to their originals later (force exchange), the positions are stored as float offsets to the lower
+ * corner of the halo regions (stored once as doubles) and, if setSendHaloIDs(false) was called, the ids are
+ * dropped. Force messages keep the id and the exact position (needed to find the molecule on the receiving side),
+ * but send forces, torques and virials as floats.
  */
 class CommunicationBuffer {
 
@@ -53,6 +65,21 @@ public:
 	unsigned char * getDataForSending();
 	size_t getNumElementsForSending();
 	void resizeForRawBytes(unsigned long numBytes);
+	//! make sure, that the buffer can take numBytes without reallocation
+	void reserveRawBytes(unsigned long numBytes);
+
+	/**
+	 * Let the buffer work on external memory (e.g. a shared memory slot) instead of its own storage, so that a
+	 * message can be packed into or read from it in place. The first size bytes are the content of the buffer.
+	 * If the buffer has to grow beyond capacity, the content is copied to its own storage and it detaches.
+	 */
+	void attachExternalStorage(unsigned char* data, size_t capacity, size_t size);
+	//! go back to the own storage, which is empty afterwards
+	void detachExternalStorage();
+	//! @return whether the buffer still works on the memory passed to attachExternalStorage()
+	bool isExternalStorage() const {
+		return _external != nullptr;
+	}
 
 	// write
 	void addLeavingMolecule(size_t indexOfMolecule, const Molecule& m);
@@ -64,6 +91,48 @@ public:
 	void readHaloMolecule(size_t indexOfMolecule, Molecule& m) const;
 	void readForceMolecule(size_t indexOfMolecule, Molecule& m) const;
 
+	//! write all halo molecules at once in the SoA layout, after all leaving molecules
+	//! @param positions positions to be sent (shifted for periodic boundaries), one per molecule
+	//! @param offsetOrigin reduced-precision encoding only: origin of the float offsets of the positions, which have
+	//! to be at or above it in all dimensions. If nullptr, exact positions and ids are sent, e.g. because the forces
+	//! on the halo copies are sent back and matched to the original molecules.
+	void setHaloMoleculesSoA(const std::vector<const Molecule*>& molecules,
+			const std::vector<std::array<double, 3>>& positions, const double* offsetOrigin = nullptr);
+	//! read all halo molecules written with setHaloMoleculesSoA()
+	void readHaloMoleculesSoA(std::vector<Molecule>& molecules) const;
+
+	//! select the layout of the halo molecules, has to be the same on all processes
+	static void setHaloLayoutSoA(bool soa) {
+		_haloLayoutSoA = soa;
+	}
+
+	static bool isHaloLayoutSoA() {
+		return _haloLayoutSoA;
+	}
+
+	//! select the reduced-precision encoding of halo and force messages, has to be the same on all processes
+	static void setReducedPrecisionEncoding(bool reduced);
+
+	static bool isReducedPrecisionEncoding() {
+		return _reducedPrecision;
+	}
+
+	//! whether the reduced-precision encoding sends the ids of the halo copies
+	static void setSendHaloIDs(bool sendIDs) {
+		_sendHaloIDs = sendIDs;
+	}
+
+	static bool isSendHaloIDs() {
+		return _sendHaloIDs;
+	}
+
+	/**
+	 * Rounds a coordinate to the value the receiver will decode from its float offset to origin.
+	 * The result is moved by single float steps, until it lies in [low, high), so that a halo copy does not end up on
+	 * the wrong side of a subdomain boundary.
+	 */
+	static double roundToReducedPosition(double r, double origin, double low, double high);
+
 	void resizeForReceivingMolecules(unsigned long& numLeaving, unsigned long& numHalo); 
 	void resizeForReceivingMolecules(unsigned long& numForces);
 
@@ -87,8 +156,16 @@ private:
 	static size_t _numBytesHalo;
 	static size_t _numBytesLeaving;
         static size_t _numBytesForces; // where is this set?
+	static bool _haloLayoutSoA;
+	static bool _reducedPrecision;
+	static bool _sendHaloIDs;
 
 	enum class ParticleType_t {HALO=0, LEAVING=1, FORCE=3};
+
+	//! flags written in front of a halo block in the reduced-precision encoding
+	enum HaloFlags : unsigned char {
+		haloFlagIDs = 1, haloFlagReducedPositions = 2, haloFlagReducedQuaternions = 4
+	};
 	size_t getStartPosition(ParticleType_t type, size_t indexOfMolecule) const;
 
 	/**
@@ -102,6 +179,24 @@ private:
 
 	typedef unsigned char byte_t;
 	std::vector<byte_t> _buffer;
+	// external storage, see attachExternalStorage()
+	byte_t* _external{nullptr};
+	size_t _externalSize{0}, _externalCapacity{0};
+
+	byte_t* bufferData() {
+		return _external != nullptr ? _external : _buffer.data();
+	}
+	const byte_t* bufferData() const {
+		return _external != nullptr ? _external : _buffer.data();
+	}
+	size_t bufferSize() const {
+		return _external != nullptr ? _externalSize : _buffer.size();
+	}
+	size_t bufferCapacity() const {
+		return _external != nullptr ? _externalCapacity : _buffer.capacity();
+	}
+	//! copy the content of the external storage to the own one and detach
+	void moveExternalToOwnStorage();
 	size_t _numLeaving, _numHalo, _numForces;
 };
 
@@ -110,11 +205,12 @@ inline size_t CommunicationBuffer::emplaceValue(size_t indexInBytes, T passByVal
 	const size_t numBytesOfT = sizeof(T);
 	size_t ret = indexInBytes + numBytesOfT;
 
-	mardyn_assert(_buffer.size() >= ret);
+	mardyn_assert(bufferSize() >= ret);
 
 	const byte_t * pointer = reinterpret_cast<byte_t *> (&passByValue);
+	byte_t * data = bufferData();
 	for (size_t i = 0; i < numBytesOfT; ++i) {
-		_buffer[indexInBytes + i] = pointer[i];
+		data[indexInBytes + i] = pointer[i];
 	}
 
 	return ret;
@@ -125,11 +221,12 @@ inline size_t CommunicationBuffer::readValue(size_t indexInBytes, T& passByRefer
 	const size_t numBytesOfT = sizeof(T);
 	size_t ret = indexInBytes + numBytesOfT;
 
-	mardyn_assert(_buffer.size() >= ret);
+	mardyn_assert(bufferSize() >= ret);
 
 	byte_t * pointer = reinterpret_cast<byte_t *> (&passByReference);
+	const byte_t * data = bufferData();
 	for (size_t i = 0; i < numBytesOfT; ++i) {
-		pointer[i] = _buffer[indexInBytes + i];
+		pointer[i] = data[indexInBytes + i];
 	}
 
 	return ret;
@@ -6,8 +6,12 @@
  */
 
 #include "CommunicationPartner.h"
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <limits>
 #include <sstream>
+#include <thread>
 #include "Domain.h"
 #include "ForceHelper.h"
 #include "ParticleData.h"
@@ -100,6 +104,8 @@ CommunicationPartner::CommunicationPartner(const CommunicationPartner& o) {
 	_rank = o._rank;
 
 	_haloInfo = o._haloInfo;
+	// the mode is copied, the persistent requests are not
+	_persistentRequests = o._persistentRequests;
 
 	// some values, to silence the warnings:
 	_sendRequest = new MPI_Request;
@@ -115,6 +121,9 @@ CommunicationPartner& CommunicationPartner::operator =(const CommunicationPartne
 	if (this != &o) {
 		_rank = o._rank;
 		_haloInfo = o._haloInfo;
+		freePersistentRequests();
+		_persistentRequests = o._persistentRequests;
+		resetSharedMemory();
 		delete _sendRequest;
 		delete _recvRequest;
 		delete _sendStatus;
@@ -130,6 +139,7 @@ CommunicationPartner& CommunicationPartner::operator =(const CommunicationPartne
 }
 
 CommunicationPartner::~CommunicationPartner() {
+	freePersistentRequests();
 	delete _sendRequest;
 	delete _recvRequest;
 	delete _sendStatus;
@@ -140,6 +150,33 @@ void CommunicationPartner::initSend(ParticleContainer* moleculeContainer, const
 									const MPI_Datatype& type, MessageType msgType,
 									std::vector<Molecule>& invalidParticles, bool mightUseInvalidParticles,
 									bool doHaloPositionCheck, bool removeFromContainer) {
+	if (_sharedMemorySendSlot != nullptr) {
+		// pack directly into the slot, see publishSharedMemory()
+		waitForSharedMemoryAck();
+		_sendBuf.attachExternalStorage(reinterpret_cast<unsigned char*>(_sharedMemorySendSlot) + sizeof(SharedMemorySlotHeader),
+				_sharedMemoryCapacity, 0);
+	}
+	prepareSend(moleculeContainer, msgType, invalidParticles, mightUseInvalidParticles, doHaloPositionCheck,
+			removeFromContainer);
+
+	if (_sharedMemorySendSlot != nullptr and publishSharedMemory()) {
+		_msgSent = true;
+		_isSending = false;
+		return;
+	}
+
+	if (_persistentRequests) {
+		startPersistentSend(comm);
+	} else {
+		MPI_CHECK(MPI_Isend(_sendBuf.getDataForSending(), (int ) _sendBuf.getNumElementsForSending(), _sendBuf.getMPIDataType(), _rank, 99, comm, _sendRequest));
+	}
+	_msgSent = false;
+	_isSending = true;
+}
+
+void CommunicationPartner::prepareSend(ParticleContainer* moleculeContainer, MessageType msgType,
+									   std::vector<Molecule>& invalidParticles, bool mightUseInvalidParticles,
+									   bool doHaloPositionCheck, bool removeFromContainer) {
 	global_log->debug() << _rank << std::endl;
 	_sendBuf.clear();
 
@@ -159,6 +196,10 @@ void CommunicationPartner::initSend(ParticleContainer* moleculeContainer, const
 			}
 
 			// then halo particles/copies:
+			if (CommunicationBuffer::isHaloLayoutSoA()) {
+				collectHaloMoleculesSoA(moleculeContainer, doHaloPositionCheck);
+				break;
+			}
 			for (unsigned int p = 0; p < numHaloInfo; p++) {
 				collectMoleculesInRegion(moleculeContainer, _haloInfo[p]._copiesLow, _haloInfo[p]._copiesHigh,
 						_haloInfo[p]._shift, false, HALO, doHaloPositionCheck);
@@ -180,6 +221,10 @@ void CommunicationPartner::initSend(ParticleContainer* moleculeContainer, const
 		}
 		case MessageType::HALO_COPIES: {
 			global_log->debug() << "sending halo particles only" << std::endl;
+			if (CommunicationBuffer::isHaloLayoutSoA()) {
+				collectHaloMoleculesSoA(moleculeContainer, doHaloPositionCheck);
+				break;
+			}
 			for(unsigned int p = 0; p < numHaloInfo; p++){
 				collectMoleculesInRegion(moleculeContainer, _haloInfo[p]._copiesLow, _haloInfo[p]._copiesHigh,
 						_haloInfo[p]._shift, false, HALO, doHaloPositionCheck);
@@ -211,25 +256,217 @@ void CommunicationPartner::initSend(ParticleContainer* moleculeContainer, const
 
 		global_log->debug() << "and " << numHalo << " halo particles with IDs " << std::endl;
 		std::ostringstream buf2;
-		for (int i = 0; i < numHalo; ++i) {
-			Molecule m;
-			_sendBuf.readHaloMolecule(i, m);
-			buf2 << m.getID() << " ";
+		if (CommunicationBuffer::isHaloLayoutSoA()) {
+			std::vector<Molecule> haloMolecules;
+			_sendBuf.readHaloMoleculesSoA(haloMolecules);
+			for (auto& m : haloMolecules) {
+				buf2 << m.getID() << " ";
+			}
+		} else {
+			for (int i = 0; i < numHalo; ++i) {
+				Molecule m;
+				_sendBuf.readHaloMolecule(i, m);
+				buf2 << m.getID() << " ";
+			}
 		}
 		global_log->debug() << buf2.str() << std::endl;
 
 
 	#endif
+}
 
-	MPI_CHECK(MPI_Isend(_sendBuf.getDataForSending(), (int ) _sendBuf.getNumElementsForSending(), _sendBuf.getMPIDataType(), _rank, 99, comm, _sendRequest));
-	_msgSent = false;
-	_isSending = true;
+void CommunicationPartner::setSharedMemorySlots(MPI_Win window, char* sendSlot, char* recvSlot, size_t capacity) {
+	mardyn_assert(not _persistentRequests);
+	resetSharedMemory();
+	_sharedMemoryWindow = window;
+	_sharedMemorySendSlot = sendSlot;
+	_sharedMemoryRecvSlot = recvSlot;
+	_sharedMemoryCapacity = capacity;
+}
+
+void CommunicationPartner::resetSharedMemory() {
+	_sendBuf.detachExternalStorage();
+	_recvBuf.detachExternalStorage();
+	_sharedMemoryWindow = MPI_WIN_NULL;
+	_sharedMemorySendSlot = _sharedMemoryRecvSlot = nullptr;
+	_sharedMemoryCapacity = 0;
+	_sharedMemorySendEpoch = _sharedMemoryRecvEpoch = 0;
+	_sharedMemoryReceived = _sharedMemoryRecvViaMPI = false;
+}
+
+void CommunicationPartner::waitForSharedMemoryAck() {
+	volatile auto* header = reinterpret_cast<volatile SharedMemorySlotHeader*>(_sharedMemorySendSlot);
+	// the slot may only be overwritten, once the partner has read the previous message.
+	// The partner acknowledges only after unpacking, so back off from busy polling if that takes longer.
+	unsigned int polls = 0;
+	while (header->ack != _sharedMemorySendEpoch) {
+		MPI_CHECK(MPI_Win_sync(_sharedMemoryWindow));
+		++polls;
+		if (polls > sharedMemorySpinPolls + sharedMemoryYieldPolls) {
+			const unsigned int shift = std::min(polls - sharedMemorySpinPolls - sharedMemoryYieldPolls, 10u);
+			std::this_thread::sleep_for(std::chrono::microseconds(1u << shift));
+		} else if (polls > sharedMemorySpinPolls) {
+			std::this_thread::yield();
+		}
+	}
+	MPI_CHECK(MPI_Win_sync(_sharedMemoryWindow));
+}
+
+bool CommunicationPartner::publishSharedMemory() {
+	volatile auto* header = reinterpret_cast<volatile SharedMemorySlotHeader*>(_sharedMemorySendSlot);
+	// the send buffer detaches from the slot, if the message did not fit
+	const bool fits = _sendBuf.isExternalStorage();
+	header->size = fits ? _sendBuf.getNumElementsForSending() : sharedMemoryViaMPI;
+	if (fits) {
+		_sendBuf.detachExternalStorage();
+	}
+	// message and size have to be visible before the epoch
+	MPI_CHECK(MPI_Win_sync(_sharedMemoryWindow));
+	header->epoch = ++_sharedMemorySendEpoch;
+	MPI_CHECK(MPI_Win_sync(_sharedMemoryWindow));
+	return fits;
+}
+
+bool CommunicationPartner::receiveSharedMemory() {
+	volatile auto* header = reinterpret_cast<volatile SharedMemorySlotHeader*>(_sharedMemoryRecvSlot);
+	MPI_CHECK(MPI_Win_sync(_sharedMemoryWindow));
+	if (header->epoch == _sharedMemoryRecvEpoch) {
+		// nothing new
+		return false;
+	}
+	MPI_CHECK(MPI_Win_sync(_sharedMemoryWindow));
+	++_sharedMemoryRecvEpoch;
+	const uint64_t size = header->size;
+	if (size == sharedMemoryViaMPI) {
+		_sharedMemoryRecvViaMPI = true;
+		// nothing to read from the slot
+		acknowledgeSharedMemory();
+	} else {
+		// read in place, the slot is released in acknowledgeSharedMemory() after unpacking
+		_recvBuf.attachExternalStorage(reinterpret_cast<unsigned char*>(_sharedMemoryRecvSlot) + sizeof(SharedMemorySlotHeader),
+				size, size);
+		_sharedMemoryReceived = true;
+	}
+	return _sharedMemoryReceived;
+}
+
+void CommunicationPartner::acknowledgeSharedMemory() {
+	volatile auto* header = reinterpret_cast<volatile SharedMemorySlotHeader*>(_sharedMemoryRecvSlot);
+	_recvBuf.detachExternalStorage();
+	// all reads of the message have to be finished before the partner may overwrite it
+	MPI_CHECK(MPI_Win_sync(_sharedMemoryWindow));
+	header->ack = _sharedMemoryRecvEpoch;
+	MPI_CHECK(MPI_Win_sync(_sharedMemoryWindow));
+}
+
+void CommunicationPartner::setPersistentRequests(bool persistentRequests) {
+	if (persistentRequests != _persistentRequests) {
+		freePersistentRequests();
+		_persistentRequests = persistentRequests;
+	}
+}
+
+void CommunicationPartner::freePersistentRequests() {
+	int finalized = 0;
+	MPI_CHECK(MPI_Finalized(&finalized));
+	for (MPI_Request* request : {&_persistentSendRequests[0], &_persistentSendRequests[1], &_persistentRecvRequests[0],
+			&_persistentRecvRequests[1]}) {
+		if (*request != MPI_REQUEST_NULL and not finalized) {
+			MPI_CHECK(MPI_Request_free(request));
+		}
+		*request = MPI_REQUEST_NULL;
+	}
+	_persistentComm = MPI_COMM_NULL;
+	_persistentSendData = _persistentRecvData = nullptr;
+	_persistentSendCount = _persistentRecvCount = 0;
+}
+
+void CommunicationPartner::startPersistentSend(const MPI_Comm& comm) {
+	if (comm != _persistentComm) {
+		freePersistentRequests();
+		_persistentComm = comm;
+	}
+	if (_persistentSendRequests[0] == MPI_REQUEST_NULL) {
+		MPI_CHECK(MPI_Send_init(_sendSizes, 2, MPI_UNSIGNED_LONG, _rank, 98, comm, &_persistentSendRequests[0]));
+	}
+	// A persistent send has a fixed count. The message is padded to it and the size header tells the receiver how
+	// much of it is used. The count is only renewed with some headroom, if the message does not fit anymore or
+	// would be mostly padding.
+	const unsigned long size = _sendBuf.getNumElementsForSending();
+	bool renew = _persistentSendRequests[1] == MPI_REQUEST_NULL;
+	if (renew or size > _persistentSendCount or size < _persistentSendCount / 2) {
+		_persistentSendCount = size + size / 4;
+		renew = true;
+	}
+	_sendBuf.resizeForRawBytes(_persistentSendCount);
+	if (renew or _persistentSendData != _sendBuf.getDataForSending()) {
+		if (_persistentSendRequests[1] != MPI_REQUEST_NULL) {
+			MPI_CHECK(MPI_Request_free(&_persistentSendRequests[1]));
+		}
+		_persistentSendData = _sendBuf.getDataForSending();
+		MPI_CHECK(MPI_Send_init(_sendBuf.getDataForSending(), (int) _persistentSendCount, _sendBuf.getMPIDataType(),
+				_rank, 99, comm, &_persistentSendRequests[1]));
+	}
+	_sendSizes[0] = size;
+	_sendSizes[1] = _persistentSendCount;
+	MPI_CHECK(MPI_Startall(2, _persistentSendRequests));
+}
+
+bool CommunicationPartner::testRecvSize(const MPI_Comm& comm) {
+	mardyn_assert(_persistentRequests);
+	if (_recvSizeReceived) {
+		return true;
+	}
+	if (not _recvSizeStarted) {
+		if (comm != _persistentComm) {
+			freePersistentRequests();
+			_persistentComm = comm;
+		}
+		if (_persistentRecvRequests[0] == MPI_REQUEST_NULL) {
+			MPI_CHECK(MPI_Recv_init(_recvSizes, 2, MPI_UNSIGNED_LONG, _rank, 98, comm, &_persistentRecvRequests[0]));
+		}
+		MPI_CHECK(MPI_Start(&_persistentRecvRequests[0]));
+		_recvSizeStarted = true;
+		_isReceiving = true;
+	}
+	int flag = 0;
+	MPI_CHECK(MPI_Test(&_persistentRecvRequests[0], &flag, MPI_STATUS_IGNORE));
+	_recvSizeReceived = flag != 0;
+	return _recvSizeReceived;
+}
+
+void CommunicationPartner::startRecv(const MPI_Comm& comm) {
+	mardyn_assert(_recvSizeReceived);
+	if (_countReceived) {
+		return;
+	}
+	// the padded message, its count already contains the headroom of the sender
+	_recvBuf.resizeForRawBytes(_recvSizes[1]);
+	// the count of a persistent receive is an upper bound, it is the capacity of the buffer, so the request is only
+	// renewed when the buffer grows
+	if (_persistentRecvRequests[1] == MPI_REQUEST_NULL or _persistentRecvData != _recvBuf.getDataForSending()
+			or _persistentRecvCount != _recvBuf.getDynamicSize()) {
+		if (_persistentRecvRequests[1] != MPI_REQUEST_NULL) {
+			MPI_CHECK(MPI_Request_free(&_persistentRecvRequests[1]));
+		}
+		_persistentRecvData = _recvBuf.getDataForSending();
+		_persistentRecvCount = _recvBuf.getDynamicSize();
+		MPI_CHECK(MPI_Recv_init(_recvBuf.getDataForSending(), (int) _persistentRecvCount, _sendBuf.getMPIDataType(),
+				_rank, 99, comm, &_persistentRecvRequests[1]));
+	}
+	MPI_CHECK(MPI_Start(&_persistentRecvRequests[1]));
+	_countReceived = true;
+	_countTested = 0;
 }
 
 bool CommunicationPartner::testSend() {
 	if (not _msgSent) {
 		int flag = 0;
-		MPI_CHECK(MPI_Test(_sendRequest, &flag, _sendStatus)); // THIS CAUSES A SEG FAULT IN PUSH_PULL_NEIGHBOURS
+		if (_persistentRequests) {
+			MPI_CHECK(MPI_Testall(2, _persistentSendRequests, &flag, MPI_STATUSES_IGNORE));
+		} else {
+			MPI_CHECK(MPI_Test(_sendRequest, &flag, _sendStatus)); // THIS CAUSES A SEG FAULT IN PUSH_PULL_NEIGHBOURS
+		}
 		if (flag == 1) {
 			_msgSent = true;
 			_isSending = false;
@@ -241,9 +478,21 @@ bool CommunicationPartner::testSend() {
 
 void CommunicationPartner::resetReceive() {
 	_countReceived = _msgReceived = _isReceiving = false;
+	_recvSizeStarted = _recvSizeReceived = false;
+	_sharedMemoryReceived = _sharedMemoryRecvViaMPI = false;
 }
 
 bool CommunicationPartner::iprobeCount(const MPI_Comm& comm, const MPI_Datatype& /*type*/) {
+	if (not _countReceived and _sharedMemoryRecvSlot != nullptr and not _sharedMemoryRecvViaMPI) {
+		_isReceiving = true;
+		if (receiveSharedMemory()) {
+			_countReceived = true;
+			_countTested = 0;
+		}
+		if (not _sharedMemoryRecvViaMPI) {
+			return _countReceived;
+		}
+	}
 	if (not _countReceived) {
 		_isReceiving = true;
 		int flag = 0;
@@ -267,125 +516,154 @@ bool CommunicationPartner::testRecv(ParticleContainer* moleculeContainer, bool r
 	using Log::global_log;
 	if (_countReceived and not _msgReceived) {
 		int flag = 1;
-		if (_countTested > 10) {
+		MPI_Request* recvRequest = _persistentRequests ? &_persistentRecvRequests[1] : _recvRequest;
+		if (_sharedMemoryReceived) {
+			// the shared memory slot is read in place
+			flag = 1;
+		} else if (_countTested > 10) {
 			// some MPI (Intel, IBM) implementations can produce deadlocks using MPI_Test without any MPI_Wait
 			// this fallback just ensures, that messages get received properly.
-			MPI_Wait(_recvRequest, _recvStatus);
+			MPI_Wait(recvRequest, _recvStatus);
 			_countTested = 0;
 			flag = 1;
 		} else {
-			MPI_CHECK(MPI_Test(_recvRequest, &flag, _recvStatus));
+			MPI_CHECK(MPI_Test(recvRequest, &flag, _recvStatus));
 		}
 		if (flag != 0) {
 			_msgReceived = true;
 			_isReceiving = false;
+			if (_persistentRequests and not _sharedMemoryReceived) {
+				// strip the padding of the sender
+				_recvBuf.resizeForRawBytes(_recvSizes[0]);
+			}
+			unpackRecvBuffer(moleculeContainer, removeRecvDuplicates, force);
+			if (_sharedMemoryReceived) {
+				acknowledgeSharedMemory();
+			}
+		} else {
+			++_countTested;
+		}
+	}
+	return _msgReceived;
+}
 
-			if(!force) { // Buffer is particle data
+void CommunicationPartner::unpackRecvBuffer(ParticleContainer* moleculeContainer, bool removeRecvDuplicates,
+		bool force) {
+	using Log::global_log;
+	if(!force) { // Buffer is particle data
 
-				unsigned long numHalo, numLeaving;
-				_recvBuf.resizeForReceivingMolecules(numLeaving, numHalo);
+		unsigned long numHalo, numLeaving;
+		_recvBuf.resizeForReceivingMolecules(numLeaving, numHalo);
 
 #ifndef NDEBUG
-				global_log->debug() << "Receiving particles from " << _rank << std::endl;
-				global_log->debug() << "Buffer contains " << numLeaving << " leaving particles with IDs " << std::endl;
-				std::ostringstream buf1;
-				for (unsigned long i = 0; i < numLeaving; ++i) {
-					Molecule m;
-					_recvBuf.readLeavingMolecule(i, m);
-					buf1 << m.getID() << " ";
-				}
-				global_log->debug() << buf1.str() << std::endl;
-
-				global_log->debug() << "and " << numHalo << " halo particles with IDs " << std::endl;
-				std::ostringstream buf2;
-				for (unsigned long i = 0; i < numHalo; ++i) {
-					Molecule m;
-					_recvBuf.readHaloMolecule(i, m);
-					buf2 << m.getID() << " ";
-				}
-				global_log->debug() << buf2.str() << std::endl;
+		global_log->debug() << "Receiving particles from " << _rank << std::endl;
+		global_log->debug() << "Buffer contains " << numLeaving << " leaving particles with IDs " << std::endl;
+		std::ostringstream buf1;
+		for (unsigned long i = 0; i < numLeaving; ++i) {
+			Molecule m;
+			_recvBuf.readLeavingMolecule(i, m);
+			buf1 << m.getID() << " ";
+		}
+		global_log->debug() << buf1.str() << std::endl;
+
+		global_log->debug() << "and " << numHalo << " halo particles with IDs " << std::endl;
+		std::ostringstream buf2;
+		if (CommunicationBuffer::isHaloLayoutSoA()) {
+			std::vector<Molecule> haloMolecules;
+			_recvBuf.readHaloMoleculesSoA(haloMolecules);
+			for (auto& m : haloMolecules) {
+				buf2 << m.getID() << " ";
+			}
+		} else {
+			for (unsigned long i = 0; i < numHalo; ++i) {
+				Molecule m;
+				_recvBuf.readHaloMolecule(i, m);
+				buf2 << m.getID() << " ";
+			}
+		}
+		global_log->debug() << buf2.str() << std::endl;
 #endif
 
-				global_simulation->timers()->start("COMMUNICATION_PARTNER_TEST_RECV");
-				unsigned long totalNumMols = numLeaving + numHalo;
-
-
-				/*#if defined(_OPENMP) and not defined (ADVANCED_OVERLAPPING)
-				#pragma omp parallel for schedule(static)
-				#endif*/
-				for (unsigned long i = 0; i < totalNumMols; i++) {
-					Molecule m;
-					if (i < numLeaving) {
-						// leaving
-						_recvBuf.readLeavingMolecule(i, m);
-						moleculeContainer->addParticle(m, false, removeRecvDuplicates);
-					} else {
-						// halo
-						_recvBuf.readHaloMolecule(i - numLeaving, m);
-						moleculeContainer->addHaloParticle(m, false, removeRecvDuplicates);
-					}
-				}
-			} else { // Buffer is force data
+		global_simulation->timers()->start("COMMUNICATION_PARTNER_TEST_RECV");
+		unsigned long totalNumMols = numLeaving + numHalo;
 
-				/*
-				#if defined(_OPENMP)
-				#pragma omp for schedule(static)
-				#endif
-				*/
+		// the SoA layout can only be decoded as a whole
+		std::vector<Molecule> haloMolecules;
+		if (CommunicationBuffer::isHaloLayoutSoA()) {
+			_recvBuf.readHaloMoleculesSoA(haloMolecules);
+		}
 
-				unsigned long numForces;
-				_recvBuf.resizeForReceivingMolecules(numForces);
+		/*#if defined(_OPENMP) and not defined (ADVANCED_OVERLAPPING)
+		#pragma omp parallel for schedule(static)
+		#endif*/
+		for (unsigned long i = 0; i < totalNumMols; i++) {
+			Molecule m;
+			if (i < numLeaving) {
+				// leaving
+				_recvBuf.readLeavingMolecule(i, m);
+				moleculeContainer->addParticle(m, false, removeRecvDuplicates);
+			} else if (CommunicationBuffer::isHaloLayoutSoA()) {
+				moleculeContainer->addHaloParticle(haloMolecules[i - numLeaving], false, removeRecvDuplicates);
+			} else {
+				// halo
+				_recvBuf.readHaloMolecule(i - numLeaving, m);
+				moleculeContainer->addHaloParticle(m, false, removeRecvDuplicates);
+			}
+		}
+	} else { // Buffer is force data
 
+		/*
+		#if defined(_OPENMP)
+		#pragma omp for schedule(static)
+		#endif
+		*/
 
-#ifndef NDEBUG
-				global_log->debug() << "Receiving particles from " << _rank << std::endl;
-				global_log->debug() << "Buffer contains " << numForces << " force particles with IDs " << std::endl;
-				std::ostringstream buf1;
-
-				for(unsigned long i = 0; i < numForces; ++i) {
-					Molecule m;
-					_recvBuf.readForceMolecule(i, m);
-					buf1 << m.getID() << " ";
-				}
-				global_log->debug() << buf1.str() << std::endl;
+		unsigned long numForces;
+		_recvBuf.resizeForReceivingMolecules(numForces);
 
 
-#endif
-				global_simulation->timers()->start("COMMUNICATION_PARTNER_TEST_RECV");
-				//mols.resize(numForces);
+#ifndef NDEBUG
+		global_log->debug() << "Receiving particles from " << _rank << std::endl;
+		global_log->debug() << "Buffer contains " << numForces << " force particles with IDs " << std::endl;
+		std::ostringstream buf1;
 
-				/*#if defined(_OPENMP) and not defined (ADVANCED_OVERLAPPING)
-				#pragma omp parallel for schedule(static)
-				#endif*/
+		for(unsigned long i = 0; i < numForces; ++i) {
+			Molecule m;
+			_recvBuf.readForceMolecule(i, m);
+			buf1 << m.getID() << " ";
+		}
+		global_log->debug() << buf1.str() << std::endl;
 
-				double pos[3];
-				decltype(moleculeContainer->getMoleculeAtPosition(pos)) originalPreviousIter{};
 
-				for(unsigned i = 0; i < numForces; ++i) {
-					Molecule m;
-					_recvBuf.readForceMolecule(i, m);
-					//mols[i] = m;
-					const double position[3] = { m.r(0), m.r(1), m.r(2) };
+#endif
+		global_simulation->timers()->start("COMMUNICATION_PARTNER_TEST_RECV");
+		//mols.resize(numForces);
 
-					originalPreviousIter =
-						addValuesAndGetIterator(moleculeContainer, position, originalPreviousIter, m);
-				}
+		/*#if defined(_OPENMP) and not defined (ADVANCED_OVERLAPPING)
+		#pragma omp parallel for schedule(static)
+		#endif*/
 
-				//moleculeContainer->addParticles(mols, removeRecvDuplicates);
+		double pos[3];
+		decltype(moleculeContainer->getMoleculeAtPosition(pos)) originalPreviousIter{};
 
-			}
+		for(unsigned i = 0; i < numForces; ++i) {
+			Molecule m;
+			_recvBuf.readForceMolecule(i, m);
+			//mols[i] = m;
+			const double position[3] = { m.r(0), m.r(1), m.r(2) };
 
+			originalPreviousIter =
+				addValuesAndGetIterator(moleculeContainer, position, originalPreviousIter, m);
+		}
 
+		//moleculeContainer->addParticles(mols, removeRecvDuplicates);
 
-			_recvBuf.clear();
-			global_simulation->timers()->stop("COMMUNICATION_PARTNER_TEST_RECV");
+	}
 
 
-		} else {
-			++_countTested;
-		}
-	}
-	return _msgReceived;
+
+	_recvBuf.clear();
+	global_simulation->timers()->stop("COMMUNICATION_PARTNER_TEST_RECV");
 }
 
 void CommunicationPartner::initRecv(int numParticles, const MPI_Comm& comm, const MPI_Datatype& type) {
@@ -578,6 +856,88 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 	global_simulation->timers()->stop("COMMUNICATION_PARTNER_INIT_SEND");
 }
 
+void CommunicationPartner::collectHaloMoleculesSoA(ParticleContainer* moleculeContainer, bool doHaloPositionCheck) {
+	using std::vector;
+	global_simulation->timers()->start("COMMUNICATION_PARTNER_INIT_SEND");
+	vector<vector<const Molecule*>> threadMolecules;
+	vector<vector<std::array<double, 3>>> threadPositions;
+
+	// Reduced-precision positions are sent as float offsets to the lower corner of the halo regions. They are not used
+	// if the forces on the halo copies are sent back, as these are matched to the original molecules by position.
+	const bool reducedPositions =
+		CommunicationBuffer::isReducedPrecisionEncoding() and not moleculeContainer->requiresForceExchange();
+	double offsetOrigin[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+		std::numeric_limits<double>::max()};
+	for (const auto& haloInfo : _haloInfo) {
+		for (int dim = 0; dim < 3; dim++) {
+			offsetOrigin[dim] = std::min(offsetOrigin[dim], haloInfo._copiesLow[dim] + haloInfo._shift[dim]);
+		}
+	}
+
+	#if defined (_OPENMP)
+	#pragma omp parallel shared(threadMolecules, threadPositions)
+	#endif
+	{
+		// see collectMoleculesInRegion()
+		const ParticleIterator::Type iteratorType = moleculeContainer->isInvalidParticleReturner()
+				? ParticleIterator::Type::ONLY_INNER_AND_BOUNDARY
+				: ParticleIterator::Type::ALL_CELLS;
+		const int threadNum = mardyn_get_thread_num();
+
+		#if defined (_OPENMP)
+		#pragma omp master
+		#endif
+		{
+			threadMolecules.resize(mardyn_get_num_threads());
+			threadPositions.resize(mardyn_get_num_threads());
+		}
+
+		#if defined (_OPENMP)
+		#pragma omp barrier
+		#endif
+
+		Domain* domain = global_simulation->getDomain();
+		auto& molecules = threadMolecules[threadNum];
+		auto& positions = threadPositions[threadNum];
+		for (const auto& haloInfo : _haloInfo) {
+			const double* shift = haloInfo._shift;
+			for (auto i = moleculeContainer->regionIterator(haloInfo._copiesLow, haloInfo._copiesHigh, iteratorType);
+					i.isValid(); ++i) {
+				mardyn_assert(i->inBox(haloInfo._copiesLow, haloInfo._copiesHigh));
+				std::array<double, 3> r;
+				for (int dim = 0; dim < 3; dim++) {
+					r[dim] = i->r(dim) + shift[dim];
+					// same correction of rounding errors as in collectMoleculesInRegion()
+					if (doHaloPositionCheck) {
+						if (shift[dim] < 0. and r[dim] >= 0.) {
+							vcp_real_calc rBoundary = 0;
+							r[dim] = std::nexttoward(rBoundary, rBoundary - 1.f);
+						} else if (shift[dim] > 0. and r[dim] < domain->getGlobalLength(dim)) {
+							vcp_real_calc rBoundary = domain->getGlobalLength(dim);
+							r[dim] = std::nexttoward(rBoundary, rBoundary + 1.f);
+						}
+					}
+					if (reducedPositions) {
+						r[dim] = CommunicationBuffer::roundToReducedPosition(r[dim], offsetOrigin[dim],
+							haloInfo._copiesLow[dim] + shift[dim], haloInfo._copiesHigh[dim] + shift[dim]);
+					}
+				}
+				molecules.push_back(&(*i));
+				positions.push_back(r);
+			}
+		}
+	}
+
+	vector<const Molecule*> molecules;
+	vector<std::array<double, 3>> positions;
+	for (size_t t = 0; t < threadMolecules.size(); ++t) {
+		molecules.insert(molecules.end(), threadMolecules[t].begin(), threadMolecules[t].end());
+		positions.insert(positions.end(), threadPositions[t].begin(), threadPositions[t].end());
+	}
+	_sendBuf.setHaloMoleculesSoA(molecules, positions, reducedPositions ? offsetOrigin : nullptr);
+	global_simulation->timers()->stop("COMMUNICATION_PARTNER_INIT_SEND");
+}
+
 void CommunicationPartner::collectLeavingMoleculesFromInvalidParticles(std::vector<Molecule>& invalidParticles, double* lowCorner,
                                                                        double* highCorner, double* shift) {
 
@@ -9,6 +9,7 @@
 #define COMMUNICATIONPARTNER_H_
 
 #include <mpi.h>
+#include <cstdint>
 #include <vector>
 #include <stddef.h>
 #include "CommunicationBuffer.h"
@@ -54,12 +55,69 @@ public:
 				  MessageType msgType, std::vector<Molecule>& invalidParticles, bool mightUseInvalidParticles,
 				  bool doHaloPositionCheck, bool removeFromContainer = false);
 
+	//! Pack the molecules for this partner into the send buffer, without sending them (see initSend()).
+	void prepareSend(ParticleContainer* moleculeContainer, MessageType msgType, std::vector<Molecule>& invalidParticles,
+					 bool mightUseInvalidParticles, bool doHaloPositionCheck, bool removeFromContainer = false);
+
+	//! Insert the content of the receive buffer into the container and clear the buffer.
+	//! @param force true if the buffer contains forces, false if it contains molecules
+	void unpackRecvBuffer(ParticleContainer* moleculeContainer, bool removeRecvDuplicates, bool force);
+
+	//! header of a slot in a shared memory window, followed by the message
+	struct SharedMemorySlotHeader {
+		//! number of messages written by the producer
+		uint64_t epoch;
+		//! size of the last message in bytes, sharedMemoryViaMPI if it was too large for the slot
+		uint64_t size;
+		//! number of messages read by the consumer
+		uint64_t ack;
+	};
+	static constexpr uint64_t sharedMemoryViaMPI = UINT64_MAX;
+
+	/**
+	 * Exchange the messages with this partner (on the same node) through slots in a shared memory window instead of
+	 * MPI messages. The producer packs the message directly into its slot and increments the epoch; the consumer
+	 * waits for the epoch, unpacks the message from the slot and then acknowledges it. Before packing the next
+	 * message, the producer waits for that acknowledgement. Messages larger than the slot are sent as MPI messages;
+	 * the slot then only signals that. Not to be combined with persistent requests.
+	 * @param window window containing both slots, locked with MPI_Win_lock_all
+	 * @param sendSlot slot written by this process and read by the partner
+	 * @param recvSlot slot written by the partner and read by this process
+	 * @param capacity number of bytes after the header of sendSlot
+	 */
+	void setSharedMemorySlots(MPI_Win window, char* sendSlot, char* recvSlot, size_t capacity);
+
+	//! buffers for communication done outside of this class, see prepareSend() and unpackRecvBuffer()
+	CommunicationBuffer& getSendBuffer() {
+		return _sendBuf;
+	}
+
+	CommunicationBuffer& getRecvBuffer() {
+		return _recvBuf;
+	}
+
 	bool testSend();
 
 	void resetReceive();
 
 	bool iprobeCount(const MPI_Comm& comm, const MPI_Datatype& type);
 
+	/**
+	 * Use persistent requests (MPI_Send_init/MPI_Recv_init) instead of MPI_Isend and MPI_Iprobe + MPI_Irecv.
+	 * The size of every message is sent ahead in a small message of its own. A receiver has to call testRecvSize()
+	 * until the size arrived and then startRecv(), before testRecv() can complete. iprobeCount() must not be used.
+	 * Messages are padded to the fixed count of the send request, which has some headroom, so the requests are only
+	 * renewed if a message outgrows the count (or shrinks below half of it) or the buffers are reallocated.
+	 */
+	void setPersistentRequests(bool persistentRequests);
+
+	//! persistent mode: start receiving the size of the next message (if not yet done) and test for it
+	//! @return true if the size has been received
+	bool testRecvSize(const MPI_Comm& comm);
+
+	//! persistent mode: start receiving the message, the size has to be received already
+	void startRecv(const MPI_Comm& comm);
+
 	bool testRecv(ParticleContainer* moleculeContainer, bool removeRecvDuplicates, bool force = false);
 
 	void initRecv(int numParticles, const MPI_Comm& comm, const MPI_Datatype& type);
@@ -127,6 +185,10 @@ private:
 			const double highCorner[3], const double shift[3], bool removeFromContainer,
 			HaloOrLeavingCorrection haloLeaveCorr, bool doHaloPositionCheck = true);
 
+	//! Collect the halo copies of all regions of _haloInfo and write them to the send buffer in the SoA layout, see
+	//! CommunicationBuffer::setHaloMoleculesSoA(). The molecules are referenced in place, not copied.
+	void collectHaloMoleculesSoA(ParticleContainer* moleculeContainer, bool doHaloPositionCheck);
+
 	int _rank;
 	int _countTested;
 	std::vector<PositionInfo> _haloInfo;
@@ -139,6 +201,46 @@ private:
 
 	void collectLeavingMoleculesFromInvalidParticles(std::vector<Molecule>& invalidParticles, double lowCorner [3], double highCorner [3], double shift [3]);
 
+	//! start the persistent requests for the size and the content of the send buffer
+	void startPersistentSend(const MPI_Comm& comm);
+	void freePersistentRequests();
+
+	// persistent mode, see setPersistentRequests()
+	bool _persistentRequests{false};
+	bool _recvSizeStarted{false}, _recvSizeReceived{false};
+	//! size header sent and received by the requests at index 0: used size and padded count of the message in bytes
+	unsigned long _sendSizes[2]{0, 0}, _recvSizes[2]{0, 0};
+	//! index 0: size, index 1: buffer
+	MPI_Request _persistentSendRequests[2]{MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+	MPI_Request _persistentRecvRequests[2]{MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+	//! communicator, buffers and counts for which the requests were created
+	MPI_Comm _persistentComm{MPI_COMM_NULL};
+	const void* _persistentSendData{nullptr};
+	const void* _persistentRecvData{nullptr};
+	unsigned long _persistentSendCount{0}, _persistentRecvCount{0};
+
+	//! wait until the partner has read the last message from the send slot, polling with backoff
+	void waitForSharedMemoryAck();
+	//! publish the message packed into the send slot, @return false if it did not fit and has to be sent as MPI message
+	bool publishSharedMemory();
+	//! @return true if a message is in the receive slot, the receive buffer then points to it
+	bool receiveSharedMemory();
+	//! release the receive slot to the partner
+	void acknowledgeSharedMemory();
+	void resetSharedMemory();
+
+	//! polls of waitForSharedMemoryAck() before yielding / before sleeping with exponentially growing intervals
+	static constexpr unsigned int sharedMemorySpinPolls = 1000, sharedMemoryYieldPolls = 10000;
+
+	// shared memory slots, see setSharedMemorySlots()
+	MPI_Win _sharedMemoryWindow{MPI_WIN_NULL};
+	char* _sharedMemorySendSlot{nullptr};
+	char* _sharedMemoryRecvSlot{nullptr};
+	size_t _sharedMemoryCapacity{0};
+	uint64_t _sharedMemorySendEpoch{0}, _sharedMemoryRecvEpoch{0};
+	//! the current message has been read from the slot / announced to come as MPI message
+	bool _sharedMemoryReceived{false}, _sharedMemoryRecvViaMPI{false};
+
 	friend class NeighborAcquirerTest;
 };
 
@@ -10,10 +10,12 @@
 #include "utils/mardyn_assert.h"
 #include "ZonalMethods/FullShell.h"
 #include "ForceHelper.h"
+#include "io/CheckpointIndex.h"
 
 #ifdef ENABLE_MPI
 #include <mpi.h>
 #include "utils/MPI_Info_object.h"
+#include "io/AsyncCheckpointFile.h"
 #endif
 
 DomainDecompBase::DomainDecompBase() : _rank(0), _numProcs(1) {
@@ -451,62 +453,19 @@ int DomainDecompBase::getNumProcs() const {
 void DomainDecompBase::barrier() const {
 }
 #ifdef ENABLE_MPI
-void DomainDecompBase::writeMoleculesToMPIFileBinary(const std::string& filename, ParticleContainer* moleculeContainer) const {
-	int rank = getRank();
-
-	MPI_File mpifh;
-	MPI_Info_object mpiinfo;
-	auto extfilename = filename + ".dat";
-	MPI_File_open(MPI_COMM_WORLD, extfilename.c_str(), MPI_MODE_WRONLY | MPI_MODE_CREATE, mpiinfo,
-	              &mpifh);
-
-	uint64_t numParticles_local = 0;
-	uint64_t numParticles_exscan = 0;
-	auto begin = moleculeContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY);
-	for (auto it = begin; it.isValid(); ++it) numParticles_local++;
-
-	MPI_Exscan(&numParticles_local, &numParticles_exscan, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
-
-	uint16_t particle_data_size = 0;
-	// if no particle is found (begin is not valid) particle_data_size is zero and provides no problem.
-	if(begin.isValid())
-	{
-		std::stringstream str;
-		begin->writeBinary(str);
-		particle_data_size = str.str().size();
-	}
-	uint64_t buffer_size = 32768;
-	std::string __dummy(buffer_size, '\0');  // __dummy for preallocation of internal buffer with buffer_size.
-	std::ostringstream write_buffer(__dummy, ios_base::binary);
-	__dummy.clear();
-	__dummy.shrink_to_fit();
-	//char* write_buffer = new char[buffer_size];
-	uint64_t offset = numParticles_exscan * particle_data_size;
-	MPI_File_seek(mpifh, offset, MPI_SEEK_SET);
-	uint64_t buffer_pos = 0;
-
-	for (auto it = begin; it.isValid(); ++it) {
-		it->writeBinary(write_buffer);
-		buffer_pos += particle_data_size;
-
-		if (buffer_pos > buffer_size - particle_data_size) {
-			// we cannot add any more particles to this buffer, so we write the buffer.
-			MPI_File_write(mpifh, write_buffer.str().c_str(), buffer_pos, MPI_BYTE, MPI_STATUS_IGNORE);
-			// reset buffer position and clear stream.
-			buffer_pos = 0;
-			write_buffer.str("");
-		}
-	}
-	MPI_File_write(mpifh, write_buffer.str().c_str(), buffer_pos, MPI_BYTE, MPI_STATUS_IGNORE);
-
-	MPI_File_close(&mpifh);
+void DomainDecompBase::writeMoleculesToMPIFileBinary(const std::string& filename, ParticleContainer* moleculeContainer,
+		bool writeIndex, double indexBlockLength) const {
+	// one collective write per process instead of many small independent ones
+	AsyncCheckpointFile file;
+	file.start(filename, moleculeContainer, writeIndex, indexBlockLength);
+	file.complete();
 }
 #endif
 void DomainDecompBase::writeMoleculesToFile(const std::string& filename, ParticleContainer* moleculeContainer,
-                                            bool binary) const {
+                                            bool binary, bool writeIndex, double indexBlockLength) const {
 #ifdef ENABLE_MPI
 	if (binary) {
-		writeMoleculesToMPIFileBinary(filename, moleculeContainer);
+		writeMoleculesToMPIFileBinary(filename, moleculeContainer, writeIndex, indexBlockLength);
 	} else {
 #else
 		{
@@ -525,12 +484,23 @@ void DomainDecompBase::writeMoleculesToFile(const std::string& filename, Particl
 					checkpointfilestream.precision(20);
 				}
 
-				for (auto tempMolecule = moleculeContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY);
-				     tempMolecule.isValid(); ++tempMolecule) {
-					if (binary) {
-						tempMolecule->writeBinary(checkpointfilestream);
-					} else {
-						tempMolecule->write(checkpointfilestream);
+				if (binary and writeIndex) {
+					// only reached without MPI, i.e., by a single process
+					std::string buffer;
+					std::vector<CheckpointIndex::Entry> entries;
+					const uint32_t moleculeSize =
+						CheckpointIndex::serializeMolecules(moleculeContainer, indexBlockLength, buffer, entries);
+					checkpointfilestream.write(buffer.data(), buffer.size());
+					CheckpointIndex::writeIndexFile(CheckpointIndex::getIndexFilename(filename + ".dat"), moleculeSize,
+							entries);
+				} else {
+					for (auto tempMolecule = moleculeContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY);
+					     tempMolecule.isValid(); ++tempMolecule) {
+						if (binary) {
+							tempMolecule->writeBinary(checkpointfilestream);
+						} else {
+							tempMolecule->write(checkpointfilestream);
+						}
 					}
 				}
 				checkpointfilestream.close();
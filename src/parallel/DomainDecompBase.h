@@ -180,7 +180,10 @@ public:
 	//! This version uses, MPI IO.
 	//! @param filename name of the file into which the data will be written
 	//! @param moleculeContainer all Particles from this container will be written to the file
-	void writeMoleculesToMPIFileBinary(const std::string& filename, ParticleContainer* moleculeContainer) const;
+	//! @param writeIndex write the spatial index "<filename>.dat.idx" (see CheckpointIndex)
+	//! @param indexBlockLength edge length of the index blocks, <= 0: one block per process
+	void writeMoleculesToMPIFileBinary(const std::string& filename, ParticleContainer* moleculeContainer,
+			bool writeIndex = false, double indexBlockLength = 0.) const;
 #endif // ENABLE_MPI
 
 	//! @brief appends molecule data to the file. The format is the same as that of the input file
@@ -190,7 +193,10 @@ public:
 	//! @param filename name of the file into which the data will be written
 	//! @param moleculeContainer all Particles from this container will be written to the file
 	//! @param binary flag, that is true if the output shall be binary
-	void writeMoleculesToFile(const std::string& filename, ParticleContainer* moleculeContainer, bool binary = false) const;
+	//! @param writeIndex binary only: write the spatial index "<filename>.dat.idx" (see CheckpointIndex)
+	//! @param indexBlockLength edge length of the index blocks, <= 0: one block per process
+	void writeMoleculesToFile(const std::string& filename, ParticleContainer* moleculeContainer, bool binary = false,
+			bool writeIndex = false, double indexBlockLength = 0.) const;
 
 
 	void updateSendLeavingWithCopies(bool sendTogether){
@@ -21,6 +21,7 @@
 #include "parallel/ZonalMethods/Midpoint.h"
 #include "parallel/ZonalMethods/NeutralTerritory.h"
 #include "parallel/CollectiveCommunication.h"
+#include "parallel/CommunicationBuffer.h"
 #include "parallel/CollectiveCommunicationNonBlocking.h"
 
 using Log::global_log;
@@ -108,6 +109,10 @@ void DomainDecompMPIBase::readXML(XMLfileUnits& xmlconfig) {
 		global_log->info() << "Enforcing direct-pp neighborcommunicationscheme, because NT is used!" << std::endl;
 		neighbourCommunicationScheme = "direct-pp";
 	}
+	xmlconfig.getNodeValue("persistentRequests", _usePersistentRequests);
+	global_log->info() << "DomainDecompMPIBase: persistent requests: " << (_usePersistentRequests ? "yes" : "no") << endl;
+	xmlconfig.getNodeValue("sharedMemoryHalo", _useSharedMemoryHalo);
+	xmlconfig.getNodeValue("sharedMemorySlotSize", _sharedMemorySlotSize);
 	setCommunicationScheme(neighbourCommunicationScheme, zonalMethod);
 	_neighbourCommunicationScheme->setSequentialFallback(useSequentialFallback);
 
@@ -126,6 +131,56 @@ void DomainDecompMPIBase::readXML(XMLfileUnits& xmlconfig) {
 	} else {
 		global_log->info() << "DomainDecompMPIBase: NOT Using Overlapping Collectives" << endl;
 	}
+
+	std::string haloLayout = "aos";
+	xmlconfig.getNodeValue("haloLayout", haloLayout);
+	transform(haloLayout.begin(), haloLayout.end(), haloLayout.begin(), ::tolower);
+	if (haloLayout == "soa") {
+		CommunicationBuffer::setHaloLayoutSoA(true);
+	} else if (haloLayout == "aos") {
+		CommunicationBuffer::setHaloLayoutSoA(false);
+	} else {
+		global_log->error() << "DomainDecompMPIBase: unknown haloLayout " << haloLayout << ", use aos or soa." << endl;
+		Simulation::exit(1);
+	}
+	global_log->info() << "DomainDecompMPIBase: halo layout: " << haloLayout << endl;
+
+	std::string haloEncoding = "full";
+	xmlconfig.getNodeValue("haloEncoding", haloEncoding);
+	transform(haloEncoding.begin(), haloEncoding.end(), haloEncoding.begin(), ::tolower);
+	if (haloEncoding != "full" and haloEncoding != "reduced") {
+		global_log->error() << "DomainDecompMPIBase: unknown haloEncoding " << haloEncoding << ", use full or reduced."
+							<< endl;
+		Simulation::exit(1);
+	}
+	bool reducedEncoding = haloEncoding == "reduced";
+	bool dropHaloIDs = false;
+	xmlconfig.getNodeValue("dropHaloIDs", dropHaloIDs);
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+	if (reducedEncoding) {
+		global_log->warning() << "DomainDecompMPIBase: the reduced memory mode already sends single precision halo "
+								 "copies, using the full haloEncoding." << endl;
+		reducedEncoding = false;
+	}
+#endif
+	if (reducedEncoding and not CommunicationBuffer::isHaloLayoutSoA()) {
+		global_log->info() << "DomainDecompMPIBase: the reduced haloEncoding requires the soa halo layout, using it."
+						   << endl;
+		CommunicationBuffer::setHaloLayoutSoA(true);
+	}
+	// all processes have to encode and decode the messages in the same way
+	int encodingSettings[2] = {reducedEncoding, dropHaloIDs};
+	int minEncodingSettings[2], maxEncodingSettings[2];
+	MPI_CHECK(MPI_Allreduce(encodingSettings, minEncodingSettings, 2, MPI_INT, MPI_MIN, _comm));
+	MPI_CHECK(MPI_Allreduce(encodingSettings, maxEncodingSettings, 2, MPI_INT, MPI_MAX, _comm));
+	if (minEncodingSettings[0] != maxEncodingSettings[0] or minEncodingSettings[1] != maxEncodingSettings[1]) {
+		global_log->error() << "DomainDecompMPIBase: haloEncoding and dropHaloIDs differ between the processes." << endl;
+		Simulation::exit(1);
+	}
+	CommunicationBuffer::setReducedPrecisionEncoding(reducedEncoding);
+	CommunicationBuffer::setSendHaloIDs(not dropHaloIDs);
+	global_log->info() << "DomainDecompMPIBase: halo encoding: " << (reducedEncoding ? "reduced" : "full")
+					   << (reducedEncoding and dropHaloIDs ? ", without ids of halo copies" : "") << endl;
 }
 
 int DomainDecompMPIBase::getNonBlockingStageCount() {
@@ -160,14 +215,47 @@ void DomainDecompMPIBase::setCommunicationScheme(const std::string& scheme, cons
 	} else if(scheme=="direct-pp") {
 		global_log->info() << "DomainDecompMPIBase: Using DirectCommunicationScheme with push-pull neighbors" << std::endl;
 		_neighbourCommunicationScheme = std::make_unique<DirectNeighbourCommunicationScheme>(zonalMethodP, true);
+	} else if(scheme=="neighbour-collective") {
+#if MPI_VERSION >= 3
+		global_log->info() << "DomainDecompMPIBase: Using NeighbourCollectiveCommunicationScheme" << std::endl;
+		_neighbourCommunicationScheme = std::make_unique<NeighbourCollectiveCommunicationScheme>(zonalMethodP);
+#else
+		global_log->error() << "DomainDecompMPIBase: neighbour-collective needs MPI 3." << std::endl;
+		Simulation::exit(1);
+#endif
 	} else if(scheme=="indirect") {
 		global_log->info() << "DomainDecompMPIBase: Using IndirectCommunicationScheme" << std::endl;
 		_neighbourCommunicationScheme = std::make_unique<IndirectNeighbourCommunicationScheme>(zonalMethodP);
 	} else {
-		global_log->error() << "DomainDecompMPIBase: invalid NeighbourCommunicationScheme specified. Valid values are 'direct' and 'indirect'"
+		global_log->error() << "DomainDecompMPIBase: invalid NeighbourCommunicationScheme specified. Valid values are 'direct', 'direct-pp', 'neighbour-collective' and 'indirect'"
 				<< std::endl;
 		Simulation::exit(1);
 	}
+	_neighbourCommunicationScheme->setPersistentRequests(_usePersistentRequests);
+
+	bool useSharedMemoryHalo = _useSharedMemoryHalo;
+	if (useSharedMemoryHalo and (scheme == "direct-pp" or scheme == "neighbour-collective" or _usePersistentRequests)) {
+		global_log->warning() << "DomainDecompMPIBase: sharedMemoryHalo is only supported by the direct and indirect "
+								 "schemes without persistent requests, disabling it." << std::endl;
+		useSharedMemoryHalo = false;
+	}
+	if (useSharedMemoryHalo) {
+		global_log->info() << "DomainDecompMPIBase: exchanging messages on the node through shared memory, slot size "
+						   << _sharedMemorySlotSize << " bytes" << std::endl;
+	}
+	_neighbourCommunicationScheme->setSharedMemory(useSharedMemoryHalo, _sharedMemorySlotSize);
+}
+
+void DomainDecompMPIBase::setPersistentRequests(bool usePersistentRequests) {
+	_usePersistentRequests = usePersistentRequests;
+	_neighbourCommunicationScheme->setPersistentRequests(_usePersistentRequests);
+}
+
+void DomainDecompMPIBase::setSharedMemoryHalo(bool useSharedMemoryHalo, size_t slotSize) {
+	_useSharedMemoryHalo = useSharedMemoryHalo;
+	_sharedMemorySlotSize = slotSize;
+	_neighbourCommunicationScheme->setSharedMemory(_useSharedMemoryHalo and not _usePersistentRequests,
+			_sharedMemorySlotSize);
 }
 
 unsigned DomainDecompMPIBase::Ndistribution(unsigned localN, float* minrnd, float* maxrnd) {
@@ -193,13 +193,25 @@ public:
 	 * \code{.xml}
 	   <parallelisation type="DomainDecomposition" OR "KDDecomposition">
 	     <!--default: indirect, unless in autopas mode-->
-	   	 <CommunicationScheme>indirect OR direct OR direct-pp</CommunicationScheme>
+	   	 <CommunicationScheme>indirect OR direct OR direct-pp OR neighbour-collective</CommunicationScheme>
 	   	 <!--default: no-->
 	   	 <overlappingCollectives>yes OR no</overlappingCollectives>
 	   	 <!--default: 5-->
 	   	 <overlappingStartAtStep></overlappingStartAtStep>
 	   	 <!--default: yes-->
 	   	 <useSequentialFallback>yes OR no</useSequentialFallback>
+	   	 <!--default: no; yes: persistent MPI requests and a preceding exchange of the message sizes instead of probing-->
+	   	 <persistentRequests>yes OR no</persistentRequests>
+	   	 <!--default: no; yes: messages to processes on the same node go through shared memory (direct and indirect only)-->
+	   	 <sharedMemoryHalo>yes OR no</sharedMemoryHalo>
+	   	 <!--default: 4194304; bytes per message slot in shared memory, larger messages are sent via MPI-->
+	   	 <sharedMemorySlotSize>4194304</sharedMemorySlotSize>
+	   	 <!--default: aos; soa sends the halo copies as arrays, without quaternions of non-rotating molecules-->
+	   	 <haloLayout>aos OR soa</haloLayout>
+	   	 <!--default: full; reduced sends float offsets as halo positions, 16-bit quaternions and float forces (implies soa)-->
+	   	 <haloEncoding>full OR reduced</haloEncoding>
+	   	 <!--default: false; true: the reduced encoding drops the ids of halo copies, if their forces are not sent back-->
+	   	 <dropHaloIDs>true OR false</dropHaloIDs>
 	     <!-- structure handled by DomainDecomposition or KDDecomposition -->
 	   </parallelisation>
 	   \endcode
@@ -214,6 +226,19 @@ public:
 	 */
 	virtual void setCommunicationScheme(const std::string& scheme, const std::string& comScheme);
 
+	/**
+	 * Use persistent requests for the neighbour communication, see NeighbourCommunicationScheme::setPersistentRequests().
+	 * Also applies to communication schemes set later on.
+	 */
+	void setPersistentRequests(bool usePersistentRequests);
+
+	/**
+	 * Exchange messages with processes on the same node through shared memory, see
+	 * NeighbourCommunicationScheme::setSharedMemory(). Only for the direct scheme without push-pull partners and the
+	 * indirect scheme, ignored together with persistent requests. Takes effect with the next initCommunicationPartners().
+	 */
+	void setSharedMemoryHalo(bool useSharedMemoryHalo, size_t slotSize);
+
 	// documentation in base class
 	virtual int getNonBlockingStageCount() override;
 
@@ -264,6 +289,9 @@ protected:
 	 * @note Intended to be used in `readXML()`.
 	 */
 	bool _forceDirectPP{false};
+
+	//! complete pending collectives (see overlappingCollectives), must be called before a derived class frees _comm
+	void finalizeCollectiveCommunication() { _collCommunication.reset(); }
 private:
 	std::unique_ptr<CollectiveCommunicationInterface> _collCommunication;
 	/// Defines when to start the overlapping collective communication.
@@ -271,6 +299,11 @@ private:
 	/// To prevent large deviations from a simulation without overlapping collectives, overlapping collectives can be disabled at the start.
 	/// Typically, around five steps are reasonable for this.
 	unsigned long _overlappingStartAtStep {5ul};
+
+	bool _usePersistentRequests{false};
+
+	bool _useSharedMemoryHalo{false};
+	size_t _sharedMemorySlotSize{4194304};
 };
 
 #endif /* DOMAINDECOMPMPIBASE_H_ */
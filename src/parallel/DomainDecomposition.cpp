@@ -41,6 +41,7 @@ void DomainDecomposition::initMPIGridDims() {
 }
 
 DomainDecomposition::~DomainDecomposition() {
+	finalizeCollectiveCommunication();
 	MPI_Comm_free(&_comm);
 }
 
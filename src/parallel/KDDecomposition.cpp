@@ -6,6 +6,7 @@
 #include <climits>
 #include <cmath>
 #include <limits>
+#include <utility>
 
 #ifdef ENABLE_MPI
 #include <mpi.h>
@@ -19,6 +20,7 @@
 #include "utils/Logger.h"
 #include "utils/xmlfileUnits.h"
 #include "particleContainer/adapter/FlopCounter.h"
+#include "parallel/CommunicationBuffer.h"
 #include "parallel/NeighbourCommunicationScheme.h"
 #include "parallel/HaloRegion.h"
 #include "WrapOpenMP.h"
@@ -59,7 +61,9 @@ void KDDecomposition::init(Domain* domain){
         coversWholeDomain[dim] = true;
     }
 
-    _numParticlesPerCell.resize(_numParticleTypes * _globalNumCells);
+    if (not _distributedCostGathering) {
+        _numParticlesPerCell.resize(_numParticleTypes * _globalNumCells);
+    }
 
     // create initial decomposition
     // ensure that enough cells for the number of procs are available
@@ -148,6 +152,12 @@ void KDDecomposition::readXML(XMLfileUnits& xmlconfig) {
 	if(_heterogeneousSystems){
 		global_log->warning() << "The old version of the heterogeneous KDDecomposition shouldn't be used with the vectorization tuner!" << endl;
 	}
+	xmlconfig.getNodeValue("distributedCostGathering", _distributedCostGathering);
+	global_log->info() << "KDDecomposition gathers cell costs distributed?: " << (_distributedCostGathering?"yes":"no") << endl;
+	if(_distributedCostGathering and _clusteredHeterogeneouseSystems){
+		global_log->error() << "KDDecomposition: distributedCostGathering is not compatible with clusterHetSys!" << endl;
+		Simulation::exit(46);
+	}
 	xmlconfig.getNodeValue("splitBiggestDimension", _splitBiggest);
 	global_log->info() << "KDDecomposition splits along biggest domain?: " << (_splitBiggest?"yes":"no") << endl;
 	xmlconfig.getNodeValue("forceRatio", _forceRatio);
@@ -192,6 +202,11 @@ void KDDecomposition::readXML(XMLfileUnits& xmlconfig) {
 					   << (_measureLoadIncreasingTimeValues ? "yes" : "no") << endl;
 
 	DomainDecompMPIBase::readXML(xmlconfig);
+	if (not CommunicationBuffer::isSendHaloIDs()) {
+		// the ids are needed to remove duplicate halo copies
+		global_log->warning() << "KDDecomposition: the ids of halo copies are always sent." << endl;
+		CommunicationBuffer::setSendHaloIDs(true);
+	}
 
 	string oldPath(xmlconfig.getcurrentnodepath());
 
@@ -313,7 +328,11 @@ void KDDecomposition::balanceAndExchange(double lastTraversalTime, bool forceReb
 		KDNode * newDecompRoot = nullptr;
 		KDNode * newOwnLeaf = nullptr;
 
-		calcNumParticlesPerCell(moleculeContainer);
+		if (_distributedCostGathering) {
+			calcDistributedCellCounts(moleculeContainer);
+		} else {
+			calcNumParticlesPerCell(moleculeContainer);
+		}
 		constructNewTree(newDecompRoot, newOwnLeaf, moleculeContainer);
 		bool migrationSuccessful = migrateParticles(*newDecompRoot, *newOwnLeaf, moleculeContainer, domain);
 		if (not migrationSuccessful) {
@@ -383,12 +402,29 @@ bool KDDecomposition::migrateParticles(const KDNode& newRoot, const KDNode& newO
 				high[d] = *(indexIt++);
 			}
 			int numMols = 0;
-			for (int iz = low[2]; iz <= high[2]; ++iz) {
-				for (int iy = low[1]; iy <= high[1]; ++iy) {
-					for (int ix = low[0]; ix <= high[0]; ++ ix) {
-						numMols += _numParticlesPerCell[(iz * _globalCellsPerDim[1] + iy) * _globalCellsPerDim[0] + ix];
-						if(_numParticleTypes >= 2){
-							numMols += _numParticlesPerCell[_globalNumCells + (iz * _globalCellsPerDim[1] + iy) * _globalCellsPerDim[0] + ix];
+			if (_distributedCostGathering) {
+				// the block of the own leaf contains all cells of newOwnLeaf
+				const CellCountsBlock& leaf = _newOwnLeafCellCounts;
+				const int lenX = leaf.highCorner[0] - leaf.lowCorner[0] + 1;
+				const int lenY = leaf.highCorner[1] - leaf.lowCorner[1] + 1;
+				for (int iz = low[2]; iz <= high[2]; ++iz) {
+					for (int iy = low[1]; iy <= high[1]; ++iy) {
+						for (int ix = low[0]; ix <= high[0]; ++ ix) {
+							const long cell = ((iz - leaf.lowCorner[2]) * lenY + (iy - leaf.lowCorner[1])) * lenX + (ix - leaf.lowCorner[0]);
+							for (int slot = 0; slot < getNumCountSlots(); ++slot) {
+								numMols += leaf.counts[cell * getNumCountSlots() + slot];
+							}
+						}
+					}
+				}
+			} else {
+				for (int iz = low[2]; iz <= high[2]; ++iz) {
+					for (int iy = low[1]; iy <= high[1]; ++iy) {
+						for (int ix = low[0]; ix <= high[0]; ++ ix) {
+							numMols += _numParticlesPerCell[(iz * _globalCellsPerDim[1] + iy) * _globalCellsPerDim[0] + ix];
+							if(_numParticleTypes >= 2){
+								numMols += _numParticlesPerCell[_globalNumCells + (iz * _globalCellsPerDim[1] + iy) * _globalCellsPerDim[0] + ix];
+							}
 						}
 					}
 				}
@@ -796,6 +832,9 @@ bool KDDecomposition::decompose(KDNode* fatherNode, KDNode*& ownArea, MPI_Comm c
 		// own area must belong to this process!
 		mardyn_assert(fatherNode->_owningProc == _rank);
 		ownArea = fatherNode;
+		if (_distributedCostGathering) {
+			_newOwnLeafCellCounts = _heldCellCounts;
+		}
 		fatherNode->calculateDeviation(&_processorSpeeds, _totalMeanProcessorSpeed);
 		return domainTooSmall;
 	}
@@ -806,6 +845,12 @@ bool KDDecomposition::decompose(KDNode* fatherNode, KDNode*& ownArea, MPI_Comm c
 
 	KDNode* bestSubdivision = nullptr;
 	double minimalDeviation = globalMinimalDeviation;
+	// for distributed cost gathering: cell counts of the father node and of the best own leaf found so far
+	CellCountsBlock fatherCellCounts;
+	CellCountsBlock bestOwnLeafCellCounts;
+	if (_distributedCostGathering) {
+		fatherCellCounts = std::move(_heldCellCounts);
+	}
 	auto iter = possibleSubdivisions.begin();
 	int iterations = 0;
 	int log2proc = 0;// calculates the logarithm of _numProcs (base 2)
@@ -863,6 +908,12 @@ bool KDDecomposition::decompose(KDNode* fatherNode, KDNode*& ownArea, MPI_Comm c
 		MPI_CHECK( MPI_Group_incl(origGroup, newNumProcs, &origRanks[0], &newGroup) );//create new MPI group based on rank (as calculated before)
 		MPI_CHECK( MPI_Comm_create(commGroup, newGroup, &newComm) );
 
+		if (_distributedCostGathering) {
+			// pass the cell counts of the father node on to the process groups of both children
+			const std::vector<const KDNode*> children = {(*iter)->_child1, (*iter)->_child2};
+			_heldCellCounts = redistributeCellCounts(fatherCellCounts, children, fatherNode->_owningProc, commGroup);
+		}
+
 		KDNode* newOwnArea = nullptr;
 		double deviationChildren[] = {0.0, 0.0};
 
@@ -898,6 +949,9 @@ bool KDDecomposition::decompose(KDNode* fatherNode, KDNode*& ownArea, MPI_Comm c
 			bestSubdivision = *iter;
 			minimalDeviation = (*iter)->_deviation;
 			ownArea = newOwnArea;
+			if (_distributedCostGathering) {
+				bestOwnLeafCellCounts = std::move(_newOwnLeafCellCounts);
+			}
 		} else {
 			delete *iter;
 		}
@@ -909,6 +963,11 @@ bool KDDecomposition::decompose(KDNode* fatherNode, KDNode*& ownArea, MPI_Comm c
 		iter++;
 	}
 
+	if (_distributedCostGathering) {
+		_heldCellCounts = std::move(fatherCellCounts);
+		_newOwnLeafCellCounts = std::move(bestOwnLeafCellCounts);
+	}
+
 	// reassign children and delete cloned node, if a solution
 	// was found in this subtree.
 	if (bestSubdivision == nullptr) {
@@ -1119,6 +1178,10 @@ bool KDDecomposition::calculateAllPossibleSubdivisions(KDNode* node, std::list<K
  * - then calculate the costs for all possible subdivisions.
  */
 void KDDecomposition::calculateCostsPar(KDNode* area, vector<vector<double> >& costsLeft, vector<vector<double> >& costsRight, MPI_Comm commGroup) {
+	if (_distributedCostGathering) {
+		calculateCostsDistributed(area, costsLeft, costsRight, commGroup);
+		return;
+	}
 	vector<vector<double> > cellCosts;
 	cellCosts.resize(3);
 
@@ -1428,6 +1491,214 @@ void KDDecomposition::calcNumParticlesPerCell(ParticleContainer* moleculeContain
 	MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE, _numParticlesPerCell.data(), _globalNumCells * _numParticleTypes, MPI_UNSIGNED, MPI_SUM, MPI_COMM_WORLD) );
 }
 
+void KDDecomposition::calcDistributedCellCounts(ParticleContainer* moleculeContainer) {
+	const int numSlots = getNumCountSlots();
+	CellCountsBlock ownCellCounts;
+	int len[3];
+	long numOwnCells = 1;
+	for (int dim = 0; dim < 3; dim++) {
+		ownCellCounts.lowCorner[dim] = _ownArea->_lowCorner[dim];
+		ownCellCounts.highCorner[dim] = _ownArea->_highCorner[dim];
+		len[dim] = _ownArea->_highCorner[dim] - _ownArea->_lowCorner[dim] + 1;
+		numOwnCells *= len[dim];
+	}
+	ownCellCounts.counts.resize(numOwnCells * numSlots, 0);
+
+	double bBMin[3]; // haloBoundingBoxMin
+	for (int dim = 0; dim < 3; dim++) {
+		bBMin[dim] = moleculeContainer->getBoundingBoxMin(dim);
+	}
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		for(auto molPtr = moleculeContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); molPtr.isValid(); ++molPtr) {
+			int localCellIndex[3];
+			for (int dim = 0; dim < 3; dim++) {
+				localCellIndex[dim] = (int) floor((molPtr->r(dim) - bBMin[dim]) / _cellSize[dim]);
+				// particles exactly at the boundary of the own area are counted for the own boundary cell
+				localCellIndex[dim] = std::max(0, std::min(len[dim] - 1, localCellIndex[dim]));
+			}
+			const long cell = (static_cast<long>(localCellIndex[2]) * len[1] + localCellIndex[1]) * len[0] + localCellIndex[0];
+			const int slot = std::min(molPtr->componentid() == 0 ? 0 : 1, numSlots - 1);
+			#if defined(_OPENMP)
+			#pragma omp atomic
+			#endif
+			ownCellCounts.counts[cell * numSlots + slot]++;
+		}
+	}
+
+	// block-distribute the counts of the whole domain over all processes
+	const std::vector<const KDNode*> root = {_decompTree};
+	_heldCellCounts = redistributeCellCounts(ownCellCounts, root, 0, MPI_COMM_WORLD);
+}
+
+void KDDecomposition::getCellBlockRange(const KDNode* targetArea, int groupRank, int groupSize, long& firstCell, long& endCell) {
+	long numCells = 1;
+	for (int dim = 0; dim < KDDIM; dim++) {
+		numCells *= targetArea->_highCorner[dim] - targetArea->_lowCorner[dim] + 1;
+	}
+	// cell c is held by group rank (c * groupSize) / numCells
+	firstCell = (groupRank * numCells + groupSize - 1) / groupSize;
+	endCell = ((groupRank + 1) * numCells + groupSize - 1) / groupSize;
+}
+
+KDDecomposition::CellCountsBlock KDDecomposition::redistributeCellCounts(const CellCountsBlock& source,
+		const std::vector<const KDNode*>& targets, int commBaseRank, MPI_Comm comm) const {
+	const int numSlots = getNumCountSlots();
+	const int entrySize = numSlots + 1;  // target cell index followed by the counts
+
+	int commSize;
+	MPI_CHECK( MPI_Comm_size(comm, &commSize) );
+
+	int sourceLen[3];
+	for (int dim = 0; dim < 3; dim++) {
+		sourceLen[dim] = source.highCorner[dim] - source.lowCorner[dim] + 1;
+	}
+	std::vector<long> targetNumCells(targets.size(), 1);
+	for (size_t t = 0; t < targets.size(); t++) {
+		for (int dim = 0; dim < 3; dim++) {
+			targetNumCells[t] *= targets[t]->_highCorner[dim] - targets[t]->_lowCorner[dim] + 1;
+		}
+	}
+
+	// determine destination and target cell index of all source cells
+	const long numSourceCells = source.numCells(numSlots);
+	std::vector<int> destinations(numSourceCells, -1);
+	std::vector<unsigned int> targetCells(numSourceCells, 0);
+	std::vector<int> sendCounts(commSize, 0);
+	for (long i = 0; i < numSourceCells; i++) {
+		const long cell = source.firstCell + i;
+		const int coords[3] = {
+			source.lowCorner[0] + static_cast<int>(cell % sourceLen[0]),
+			source.lowCorner[1] + static_cast<int>((cell / sourceLen[0]) % sourceLen[1]),
+			source.lowCorner[2] + static_cast<int>(cell / (static_cast<long>(sourceLen[0]) * sourceLen[1]))
+		};
+		for (size_t t = 0; t < targets.size(); t++) {
+			const KDNode* target = targets[t];
+			bool inside = true;
+			for (int dim = 0; dim < 3; dim++) {
+				inside = inside and coords[dim] >= target->_lowCorner[dim] and coords[dim] <= target->_highCorner[dim];
+			}
+			if (not inside) {
+				continue;
+			}
+			const int lenX = target->_highCorner[0] - target->_lowCorner[0] + 1;
+			const int lenY = target->_highCorner[1] - target->_lowCorner[1] + 1;
+			const long targetCell = (static_cast<long>(coords[2] - target->_lowCorner[2]) * lenY
+					+ (coords[1] - target->_lowCorner[1])) * lenX + (coords[0] - target->_lowCorner[0]);
+			const int groupRank = static_cast<int>(targetCell * target->_numProcs / targetNumCells[t]);
+			destinations[i] = target->_owningProc - commBaseRank + groupRank;
+			targetCells[i] = static_cast<unsigned int>(targetCell);
+			sendCounts[destinations[i]] += entrySize;
+			break;
+		}
+	}
+
+	std::vector<int> sendDispls(commSize, 0);
+	for (int r = 1; r < commSize; r++) {
+		sendDispls[r] = sendDispls[r - 1] + sendCounts[r - 1];
+	}
+	std::vector<unsigned int> sendBuffer(sendDispls[commSize - 1] + sendCounts[commSize - 1]);
+	{
+		std::vector<int> fill(sendDispls);
+		for (long i = 0; i < numSourceCells; i++) {
+			if (destinations[i] < 0) {
+				continue;
+			}
+			unsigned int* entry = &sendBuffer[fill[destinations[i]]];
+			entry[0] = targetCells[i];
+			for (int slot = 0; slot < numSlots; slot++) {
+				entry[slot + 1] = source.counts[i * numSlots + slot];
+			}
+			fill[destinations[i]] += entrySize;
+		}
+	}
+
+	std::vector<int> recvCounts(commSize, 0);
+	MPI_CHECK( MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, comm) );
+	std::vector<int> recvDispls(commSize, 0);
+	for (int r = 1; r < commSize; r++) {
+		recvDispls[r] = recvDispls[r - 1] + recvCounts[r - 1];
+	}
+	std::vector<unsigned int> recvBuffer(recvDispls[commSize - 1] + recvCounts[commSize - 1]);
+	MPI_CHECK( MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendDispls.data(), MPI_UNSIGNED,
+			recvBuffer.data(), recvCounts.data(), recvDispls.data(), MPI_UNSIGNED, comm) );
+
+	CellCountsBlock result;
+	for (const KDNode* target : targets) {
+		if (_rank < target->_owningProc or _rank >= target->_owningProc + target->_numProcs) {
+			continue;
+		}
+		long endCell;
+		getCellBlockRange(target, _rank - target->_owningProc, target->_numProcs, result.firstCell, endCell);
+		for (int dim = 0; dim < 3; dim++) {
+			result.lowCorner[dim] = target->_lowCorner[dim];
+			result.highCorner[dim] = target->_highCorner[dim];
+		}
+		result.counts.assign((endCell - result.firstCell) * numSlots, 0);
+	}
+	for (size_t e = 0; e < recvBuffer.size(); e += entrySize) {
+		const long cell = static_cast<long>(recvBuffer[e]) - result.firstCell;
+		mardyn_assert(cell >= 0 and cell < result.numCells(numSlots));
+		for (int slot = 0; slot < numSlots; slot++) {
+			result.counts[cell * numSlots + slot] += recvBuffer[e + slot + 1];
+		}
+	}
+	return result;
+}
+
+double KDDecomposition::getCellCost(int numParts1, int numParts2) const {
+	// as in calculateCostsPar, the costs of all 26 neighbour interactions only depend on the particle numbers of the cell itself
+	return _loadCalc->getOwn(numParts1, numParts2) + 6. * _loadCalc->getFace(numParts1, numParts2)
+		   + 12. * _loadCalc->getEdge(numParts1, numParts2) + 8. * _loadCalc->getCorner(numParts1, numParts2);
+}
+
+void KDDecomposition::calculateCostsDistributed(KDNode* area, vector<vector<double> >& costsLeft, vector<vector<double> >& costsRight, MPI_Comm commGroup) {
+	const int numSlots = getNumCountSlots();
+	const CellCountsBlock& block = _heldCellCounts;
+	int len[3];
+	for (int dim = 0; dim < 3; dim++) {
+		mardyn_assert(block.lowCorner[dim] == area->_lowCorner[dim] and block.highCorner[dim] == area->_highCorner[dim]);
+		len[dim] = area->_highCorner[dim] - area->_lowCorner[dim] + 1;
+	}
+	const int layerOffset[3] = {0, len[0], len[0] + len[1]};
+
+	// costs of all layers in x, y and z direction, reduced in one go
+	vector<double> layerCosts(len[0] + len[1] + len[2], 0.0);
+	for (long i = 0; i < block.numCells(numSlots); i++) {
+		const long cell = block.firstCell + i;
+		const int index[3] = {
+			static_cast<int>(cell % len[0]),
+			static_cast<int>((cell / len[0]) % len[1]),
+			static_cast<int>(cell / (static_cast<long>(len[0]) * len[1]))
+		};
+		const int numParts1 = (int) block.counts[i * numSlots];
+		const int numParts2 = numSlots == 1 ? 0 : (int) block.counts[i * numSlots + 1];
+		_maxPars = max(_maxPars, numParts1);
+		_maxPars2 = max(_maxPars2, numParts2);
+		const double cellCost = getCellCost(numParts1, numParts2);
+		for (int dim = 0; dim < 3; dim++) {
+			layerCosts[layerOffset[dim] + index[dim]] += cellCost;
+		}
+	}
+	MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE, layerCosts.data(), layerCosts.size(), MPI_DOUBLE, MPI_SUM, commGroup) );
+
+	for (int dim = 0; dim < 3; dim++) {
+		costsLeft[dim].resize(len[dim], 0.0);
+		costsRight[dim].resize(len[dim], 0.0);
+		double sum = 0.;
+		for (int i_dim = 0; i_dim < len[dim]; i_dim++) {
+			sum += layerCosts[layerOffset[dim] + i_dim];
+			costsLeft[dim][i_dim] = sum;
+		}
+		for (int i_dim = 0; i_dim < len[dim]; i_dim++) {
+			costsRight[dim][i_dim] = sum - costsLeft[dim][i_dim];
+		}
+	}
+}
+
 std::vector<int> KDDecomposition::getNeighbourRanks() {
 	//global_log->error() << "not implemented \n";
 	Simulation::exit(-1);
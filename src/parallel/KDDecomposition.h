@@ -139,6 +139,14 @@ class KDDecomposition: public DomainDecompMPIBase {
 		      might lead to worse load balance or can make a domain splitting impossible.
 		      Default: 1-->
 		 <minNumCellsPerDimension>UINT</minNumCellsPerDimension>
+		 <!-- Gather the particle numbers per cell for the cost model in a distributed way. Instead of reducing the
+		      particle numbers of all global cells on all processes, every process only holds the particle numbers of
+		      a block of cells of the node that is currently decomposed. The blocks are passed on to the process
+		      groups of the children during the decomposition and only the per-layer costs are reduced within the
+		      process group of a node. Recommended for large process counts, where the global cell grid does not fit
+		      into the memory of every process. Not compatible with clusterHetSys.
+		      Default: False-->
+		 <distributedCostGathering>BOOL</distributedCostGathering>
 	   </parallelisation>
 	   \endcode
 	 */
@@ -203,6 +211,46 @@ private:
 
 	void calculateCostsPar(KDNode* area, std::vector<std::vector<double> >& costsLeft, std::vector<std::vector<double> >& costsRight, MPI_Comm commGroup);
 
+	//! @brief particle numbers of a contiguous block of cells of a cuboid region of global cells
+	//!
+	//! Cells are numbered lexicographically within the region (x fastest). The block holds the
+	//! cells [firstCell, firstCell + numCells) with getNumCountSlots() entries per cell.
+	struct CellCountsBlock {
+		int lowCorner[KDDIM]{};
+		int highCorner[KDDIM]{};
+		long firstCell{0};
+		std::vector<unsigned int> counts;
+
+		long numCells(int numSlots) const { return static_cast<long>(counts.size()) / numSlots; }
+	};
+
+	//! @brief distributed counterpart of calculateCostsPar
+	//!
+	//! Uses the block of cells of area held by this process (_heldCellCounts) and reduces only
+	//! the per-layer costs of the area within commGroup.
+	void calculateCostsDistributed(KDNode* area, std::vector<std::vector<double> >& costsLeft, std::vector<std::vector<double> >& costsRight, MPI_Comm commGroup);
+
+	//! @brief block of the cells of targetArea which is held by process groupRank of a group of groupSize processes
+	static void getCellBlockRange(const KDNode* targetArea, int groupRank, int groupSize, long& firstCell, long& endCell);
+
+	//! @brief redistribute the cell counts of source into the blocks of the given target areas
+	//!
+	//! The cells of each target area are block-distributed over the processes owning the target area.
+	//! Ranks of comm are assumed to be the global ranks shifted by commBaseRank (as for the process
+	//! groups in decompose). Every process of comm has to call this method.
+	//! @return the block of the target area owned by this process
+	CellCountsBlock redistributeCellCounts(const CellCountsBlock& source, const std::vector<const KDNode*>& targets, int commBaseRank, MPI_Comm comm) const;
+
+	//! @brief distributed counterpart of calcNumParticlesPerCell, fills _heldCellCounts for the root area
+	void calcDistributedCellCounts(ParticleContainer* moleculeContainer);
+
+	//! @brief total load of a cell with the given particle numbers (own cell and all 26 neighbours)
+	double getCellCost(int numParts1, int numParts2) const;
+
+	//! @brief number of particle counts per cell: like in calcNumParticlesPerCell, all components except
+	//! the first one are counted together
+	int getNumCountSlots() const { return std::min(_numParticleTypes, 2); }
+
 
 	//! @brief calculates the index of a certain cell in the global cell array
 	//!
@@ -337,6 +385,15 @@ private:
 	//! Number of particles for each cell (including halo?)
 	std::vector<unsigned int> _numParticlesPerCell;
 
+	//! If true, _numParticlesPerCell is not used, see distributedCostGathering in readXML.
+	bool _distributedCostGathering{false};
+
+	//! Block of cell counts of the node which is currently decomposed, held by this process.
+	CellCountsBlock _heldCellCounts;
+
+	//! Cell counts of the own leaf found by the last call of decompose (all cells of the leaf).
+	CellCountsBlock _newOwnLeafCellCounts;
+
 	/* TODO: This may not be equal to the number simulation steps if balanceAndExchange
 	 * is not called exactly once in every simulation step! */
 	//! number of simulation steps. Can be used to trigger load-balancing every _frequency steps
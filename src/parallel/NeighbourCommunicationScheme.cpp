@@ -9,6 +9,8 @@ class DirectNeighbourCommunicationScheme;
 class IndirectNeighbourCommunicationScheme;
 
 #include <mpi.h>
+#include <algorithm>
+#include <cstring>
 #include "NeighbourCommunicationScheme.h"
 #include "Domain.h"
 #include "DomainDecompMPIBase.h"
@@ -60,6 +62,15 @@ NeighbourCommunicationScheme::~NeighbourCommunicationScheme() {
 		delete _neighbours;
 	}
 	delete _zonalMethod;
+
+	int finalized = 0;
+	MPI_CHECK(MPI_Finalized(&finalized));
+	if (not finalized) {
+		freeSharedMemory();
+		if (_nodeComm != MPI_COMM_NULL) {
+			MPI_CHECK(MPI_Comm_free(&_nodeComm));
+		}
+	}
 }
 
 void printNeigbours(std::ofstream& stream,
@@ -232,17 +243,8 @@ void DirectNeighbourCommunicationScheme::initExchangeMoleculesMPI(ParticleContai
 	}
 
 
-	// 1Stage=> only _neighbours[0] exists!
-	const int numNeighbours = (*_neighbours)[0].size();
-	// send only if neighbour is actually a neighbour.
-	for (int i = 0; i < numNeighbours; ++i) {
-		if (not _useSequentialFallback or (*_neighbours)[0][i].getRank() != domainDecomp->getRank()) {
-			global_log->debug() << "Rank " << domainDecomp->getRank() << " is initiating communication to" << std::endl;
-			(*_neighbours)[0][i].initSend(moleculeContainer, domainDecomp->getCommunicator(),
-					domainDecomp->getMPIParticleType(), msgType, invalidParticles, true, doHaloPositionCheck);
-		}
+	sendToNeighbours(moleculeContainer, msgType, invalidParticles, domainDecomp, doHaloPositionCheck);
 
-	}
 	if(not invalidParticles.empty()){
 		global_log->error_always_output() << "NeighbourCommunicationScheme: Invalid particles that should have been "
 											 "removed, are still existent. They would be lost. Aborting..."
@@ -264,6 +266,21 @@ void DirectNeighbourCommunicationScheme::initExchangeMoleculesMPI(ParticleContai
 
 }
 
+void DirectNeighbourCommunicationScheme::sendToNeighbours(ParticleContainer* moleculeContainer, MessageType msgType,
+		std::vector<Molecule>& invalidParticles, DomainDecompMPIBase* domainDecomp, bool doHaloPositionCheck) {
+	// 1Stage=> only _neighbours[0] exists!
+	const int numNeighbours = (*_neighbours)[0].size();
+	// send only if neighbour is actually a neighbour.
+	for (int i = 0; i < numNeighbours; ++i) {
+		if (not _useSequentialFallback or (*_neighbours)[0][i].getRank() != domainDecomp->getRank()) {
+			global_log->debug() << "Rank " << domainDecomp->getRank() << " is initiating communication to" << std::endl;
+			(*_neighbours)[0][i].initSend(moleculeContainer, domainDecomp->getCommunicator(),
+					domainDecomp->getMPIParticleType(), msgType, invalidParticles, true, doHaloPositionCheck);
+		}
+
+	}
+}
+
 void DirectNeighbourCommunicationScheme::finalizeExchangeMoleculesMPI(ParticleContainer* moleculeContainer,
 		Domain* /*domain*/, MessageType msgType, bool removeRecvDuplicates, DomainDecompMPIBase* domainDecomp) {
 	// msg type is fixed by the fuction call, but this needs to be done for both import and export
@@ -337,10 +354,14 @@ void DirectNeighbourCommunicationScheme::finalizeExchangeMoleculesMPI(ParticleCo
 		}
 
 		// get the counts and issue the Irecv-s
-		forAllRealNeighbors([&](auto& neighbor) {
-			// import neighbors required
-			allDone &= neighbor.iprobeCount(domainDecomp->getCommunicator(), domainDecomp->getMPIParticleType());
-		});
+		if (_usePersistentRequests) {
+			allDone &= receiveSizesAndStartRecvs(forAllRealNeighbors, domainDecomp->getCommunicator());
+		} else {
+			forAllRealNeighbors([&](auto& neighbor) {
+				// import neighbors required
+				allDone &= neighbor.iprobeCount(domainDecomp->getCommunicator(), domainDecomp->getMPIParticleType());
+			});
+		}
 
 		// unpack molecules
 		forAllRealNeighbors([&](auto& neighbor) {
@@ -397,6 +418,104 @@ void DirectNeighbourCommunicationScheme::finalizeExchangeMoleculesMPI(ParticleCo
 	global_log->set_mpi_output_root(0);
 }
 
+void NeighbourCommunicationScheme::setPersistentRequests(bool usePersistentRequests) {
+	_usePersistentRequests = usePersistentRequests;
+	applyPersistentRequests();
+}
+
+void NeighbourCommunicationScheme::applyPersistentRequests() {
+	for (auto* neighbourLists : {_neighbours, _haloExportForceImportNeighbours, _haloImportForceExportNeighbours,
+			_leavingExportNeighbours, _leavingImportNeighbours}) {
+		if (neighbourLists == nullptr) {
+			continue;
+		}
+		for (auto& neighbourList : *neighbourLists) {
+			for (auto& neighbour : neighbourList) {
+				neighbour.setPersistentRequests(_usePersistentRequests);
+			}
+		}
+	}
+}
+
+void NeighbourCommunicationScheme::freeSharedMemory() {
+	if (_sharedMemoryWindow != MPI_WIN_NULL) {
+		MPI_CHECK(MPI_Win_unlock_all(_sharedMemoryWindow));
+		MPI_CHECK(MPI_Win_free(&_sharedMemoryWindow));
+	}
+}
+
+void NeighbourCommunicationScheme::setupSharedMemory(DomainDecompMPIBase* domainDecomp) {
+	freeSharedMemory();
+	if (not _useSharedMemory) {
+		return;
+	}
+	mardyn_assert(not _pushPull and not _usePersistentRequests);
+
+	const MPI_Comm comm = domainDecomp->getCommunicator();
+	const int ownRank = domainDecomp->getRank();
+	if (_nodeComm == MPI_COMM_NULL) {
+		MPI_CHECK(MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, ownRank, MPI_INFO_NULL, &_nodeComm));
+	}
+	int nodeSize = 0;
+	MPI_CHECK(MPI_Comm_size(_nodeComm, &nodeSize));
+	std::vector<int> ranksOnNode(nodeSize);
+	MPI_CHECK(MPI_Allgather(&ownRank, 1, MPI_INT, ranksOnNode.data(), 1, MPI_INT, _nodeComm));
+
+	// one slot per partner on the same node (the own process is handled by the sequential fallback or MPI)
+	struct Slot {
+		CommunicationPartner* partner;
+		int stage;
+		int nodeRank;
+	};
+	std::vector<Slot> slots;
+	for (size_t d = 0; d < _neighbours->size(); ++d) {
+		for (auto& partner : (*_neighbours)[d]) {
+			auto it = std::find(ranksOnNode.begin(), ranksOnNode.end(), partner.getRank());
+			if (partner.getRank() != ownRank and it != ranksOnNode.end()) {
+				slots.push_back({&partner, static_cast<int>(d), static_cast<int>(it - ranksOnNode.begin())});
+			}
+		}
+	}
+
+	// keep the slots on separate cache lines
+	const size_t slotBytes =
+		(sizeof(CommunicationPartner::SharedMemorySlotHeader) + _sharedMemorySlotSize + 63) / 64 * 64;
+	char* base = nullptr;
+	MPI_CHECK(MPI_Win_allocate_shared(slots.size() * slotBytes, 1, MPI_INFO_NULL, _nodeComm, &base,
+			&_sharedMemoryWindow));
+	MPI_CHECK(MPI_Win_lock_all(MPI_MODE_NOCHECK, _sharedMemoryWindow));
+	if (not slots.empty()) {
+		std::memset(base, 0, slots.size() * slotBytes);
+	}
+	MPI_CHECK(MPI_Win_sync(_sharedMemoryWindow));
+
+	// tell every partner, which of our slots it has to read
+	std::vector<MPI_Aint> sendOffsets(slots.size()), recvOffsets(slots.size());
+	std::vector<MPI_Request> requests(2 * slots.size());
+	for (size_t i = 0; i < slots.size(); ++i) {
+		sendOffsets[i] = i * slotBytes;
+		MPI_CHECK(MPI_Irecv(&recvOffsets[i], 1, MPI_AINT, slots[i].partner->getRank(), 200 + slots[i].stage, comm,
+				&requests[2 * i]));
+		MPI_CHECK(MPI_Isend(&sendOffsets[i], 1, MPI_AINT, slots[i].partner->getRank(), 200 + slots[i].stage, comm,
+				&requests[2 * i + 1]));
+	}
+	MPI_CHECK(MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE));
+	// all slots are initialized
+	MPI_CHECK(MPI_Barrier(_nodeComm));
+
+	for (size_t i = 0; i < slots.size(); ++i) {
+		MPI_Aint partnerSize = 0;
+		int partnerDispUnit = 0;
+		char* partnerBase = nullptr;
+		MPI_CHECK(MPI_Win_shared_query(_sharedMemoryWindow, slots[i].nodeRank, &partnerSize, &partnerDispUnit,
+				&partnerBase));
+		slots[i].partner->setSharedMemorySlots(_sharedMemoryWindow, base + sendOffsets[i],
+				partnerBase + recvOffsets[i], _sharedMemorySlotSize);
+	}
+	global_log->debug() << "NeighbourCommunicationScheme: rank " << ownRank << " uses shared memory for "
+						<< slots.size() << " partners" << std::endl;
+}
+
 void NeighbourCommunicationScheme::selectNeighbours(MessageType msgType, bool import) {
 	switch(msgType) {
 		case LEAVING_ONLY:
@@ -491,7 +610,8 @@ void DirectNeighbourCommunicationScheme::initCommunicationPartners(double cutoff
 		//we could squeeze the fullShellNeighbours if we would want to (might however screw up FMM)
 		(*_neighbours)[0] = NeighborAcquirer::squeezePartners(commPartners);
 	}
-
+	applyPersistentRequests();
+	setupSharedMemory(domainDecomp);
 }
 
 void IndirectNeighbourCommunicationScheme::initExchangeMoleculesMPI1D(ParticleContainer* moleculeContainer,
@@ -565,9 +685,18 @@ void IndirectNeighbourCommunicationScheme::finalizeExchangeMoleculesMPI1D(Partic
 		}
 
 		// get the counts and issue the Irecv-s
-		for (int i = 0; i < numNeighbours; ++i) {
-			allDone &= (*_neighbours)[d][i].iprobeCount(domainDecomp->getCommunicator(),
-					domainDecomp->getMPIParticleType());
+		if (_usePersistentRequests) {
+			auto forAllNeighbours = [&](auto&& f) {
+				for (int i = 0; i < numNeighbours; ++i) {
+					f((*_neighbours)[d][i]);
+				}
+			};
+			allDone &= receiveSizesAndStartRecvs(forAllNeighbours, domainDecomp->getCommunicator());
+		} else {
+			for (int i = 0; i < numNeighbours; ++i) {
+				allDone &= (*_neighbours)[d][i].iprobeCount(domainDecomp->getCommunicator(),
+						domainDecomp->getMPIParticleType());
+			}
 		}
 
 		// unpack molecules
@@ -684,4 +813,102 @@ void IndirectNeighbourCommunicationScheme::initCommunicationPartners(double cuto
 	for (unsigned int d = 0; d < _commDimms; d++) {
 		(*_neighbours)[d]= NeighborAcquirer::squeezePartners((*_neighbours)[d]);
 	}
+	applyPersistentRequests();
+	setupSharedMemory(domainDecomp);
+}
+
+#if MPI_VERSION >= 3
+NeighbourCollectiveCommunicationScheme::NeighbourCollectiveCommunicationScheme(ZonalMethod* zonalMethod) :
+		DirectNeighbourCommunicationScheme(zonalMethod, false) {
+}
+
+NeighbourCollectiveCommunicationScheme::~NeighbourCollectiveCommunicationScheme() {
+	int finalized = 0;
+	MPI_CHECK(MPI_Finalized(&finalized));
+	if (_graphComm != MPI_COMM_NULL and not finalized) {
+		MPI_CHECK(MPI_Comm_free(&_graphComm));
+	}
+}
+
+void NeighbourCollectiveCommunicationScheme::initCommunicationPartners(double cutoffRadius, Domain* domain,
+		DomainDecompMPIBase* domainDecomp, ParticleContainer* moleculeContainer) {
+	DirectNeighbourCommunicationScheme::initCommunicationPartners(cutoffRadius, domain, domainDecomp,
+			moleculeContainer);
+
+	// the partners are squeezed, so every rank occurs at most once and the graph is symmetric
+	_graphPartners.clear();
+	std::vector<int> ranks;
+	for (size_t i = 0; i < (*_neighbours)[0].size(); ++i) {
+		const int rank = (*_neighbours)[0][i].getRank();
+		if (not _useSequentialFallback or rank != domainDecomp->getRank()) {
+			_graphPartners.push_back(i);
+			ranks.push_back(rank);
+		}
+	}
+
+	if (_graphComm != MPI_COMM_NULL) {
+		MPI_CHECK(MPI_Comm_free(&_graphComm));
+	}
+	const int numGraphNeighbours = ranks.size();
+	MPI_CHECK(MPI_Dist_graph_create_adjacent(domainDecomp->getCommunicator(), numGraphNeighbours, ranks.data(),
+			MPI_UNWEIGHTED, numGraphNeighbours, ranks.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, 0 /*no reordering*/,
+			&_graphComm));
+	global_log->debug() << "NeighbourCollectiveCommunicationScheme: rank " << domainDecomp->getRank() << " has "
+						<< numGraphNeighbours << " graph neighbours" << std::endl;
+}
+
+void NeighbourCollectiveCommunicationScheme::sendToNeighbours(ParticleContainer* moleculeContainer,
+		MessageType msgType, std::vector<Molecule>& invalidParticles, DomainDecompMPIBase* /*domainDecomp*/,
+		bool doHaloPositionCheck) {
+	const size_t numGraphNeighbours = _graphPartners.size();
+	_sendCounts.assign(numGraphNeighbours, 0);
+	_sendDispls.assign(numGraphNeighbours, 0);
+	_recvCounts.assign(numGraphNeighbours, 0);
+	_recvDispls.assign(numGraphNeighbours, 0);
+
+	size_t totalSendBytes = 0;
+	for (size_t i = 0; i < numGraphNeighbours; ++i) {
+		CommunicationPartner& partner = (*_neighbours)[0][_graphPartners[i]];
+		partner.prepareSend(moleculeContainer, msgType, invalidParticles, true, doHaloPositionCheck);
+		_sendCounts[i] = partner.getSendBuffer().getNumElementsForSending();
+		_sendDispls[i] = totalSendBytes;
+		totalSendBytes += _sendCounts[i];
+	}
+	_sendData.resize(totalSendBytes);
+	for (size_t i = 0; i < numGraphNeighbours; ++i) {
+		CommunicationBuffer& sendBuf = (*_neighbours)[0][_graphPartners[i]].getSendBuffer();
+		std::memcpy(_sendData.data() + _sendDispls[i], sendBuf.getDataForSending(), _sendCounts[i]);
+		sendBuf.clear();
+	}
+
+	// sizes first, then the messages themselves
+	MPI_CHECK(MPI_Neighbor_alltoall(_sendCounts.data(), 1, MPI_INT, _recvCounts.data(), 1, MPI_INT, _graphComm));
+	size_t totalRecvBytes = 0;
+	for (size_t i = 0; i < numGraphNeighbours; ++i) {
+		_recvDispls[i] = totalRecvBytes;
+		totalRecvBytes += _recvCounts[i];
+	}
+	_recvData.resize(totalRecvBytes);
+	MPI_CHECK(MPI_Ineighbor_alltoallv(_sendData.data(), _sendCounts.data(), _sendDispls.data(),
+			CommunicationBuffer::getMPIDataType(), _recvData.data(), _recvCounts.data(), _recvDispls.data(),
+			CommunicationBuffer::getMPIDataType(), _graphComm, &_request));
+}
+
+void NeighbourCollectiveCommunicationScheme::finalizeExchangeMoleculesMPI(ParticleContainer* moleculeContainer,
+		Domain* /*domain*/, MessageType msgType, bool removeRecvDuplicates, DomainDecompMPIBase* domainDecomp) {
+	MPI_CHECK(MPI_Wait(&_request, MPI_STATUS_IGNORE));
+
+	// see DirectNeighbourCommunicationScheme::finalizeExchangeMoleculesMPI()
+	for (auto& neighbour : (*_neighbours)[0]) {
+		removeRecvDuplicates |= (domainDecomp->getRank() == neighbour.getRank());
+	}
+
+	for (size_t i = 0; i < _graphPartners.size(); ++i) {
+		CommunicationPartner& partner = (*_neighbours)[0][_graphPartners[i]];
+		CommunicationBuffer& recvBuf = partner.getRecvBuffer();
+		recvBuf.resizeForRawBytes(_recvCounts[i]);
+		std::memcpy(recvBuf.getDataForSending(), _recvData.data() + _recvDispls[i], _recvCounts[i]);
+		partner.unpackRecvBuffer(moleculeContainer, removeRecvDuplicates, msgType == FORCES);
+	}
 }
+#endif
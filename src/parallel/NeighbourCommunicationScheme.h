@@ -93,6 +93,22 @@ public:
 		_useSequentialFallback = useSequentialFallback;
 	}
 
+	//! Use persistent requests and a preceding exchange of the message sizes instead of probing for messages, see
+	//! CommunicationPartner::setPersistentRequests(). Applies to the current and all future communication partners.
+	void setPersistentRequests(bool usePersistentRequests);
+
+	/**
+	 * Exchange messages with partners on the same node through slots in a shared memory window, see
+	 * CommunicationPartner::setSharedMemorySlots(). Takes effect with the next initCommunicationPartners().
+	 * Only for schemes, in which every partner sends and receives with initSend() and testRecv(), i.e., not for
+	 * push-pull partners, and not together with persistent requests.
+	 * @param slotSize message bytes per slot, larger messages are sent as MPI messages
+	 */
+	void setSharedMemory(bool useSharedMemory, size_t slotSize) {
+		_useSharedMemory = useSharedMemory;
+		_sharedMemorySlotSize = slotSize;
+	}
+
 protected:
 
 	//! vector of neighbours. The first dimension should be of size getCommDims().
@@ -107,6 +123,29 @@ protected:
 	void selectNeighbours(MessageType msgType, bool import);
 	// -------------------------------------------------------------------------
 
+	//! pass _usePersistentRequests to all communication partners
+	void applyPersistentRequests();
+
+	//! (re)create the shared memory window for the current partners in _neighbours, collective over the node
+	void setupSharedMemory(DomainDecompMPIBase* domainDecomp);
+	void freeSharedMemory();
+
+	/**
+	 * Receive the sizes of the messages of all given partners and, once all of them are known, start all receives in
+	 * the order of the partners. Only for persistent requests.
+	 * @param forAllPartners function calling its argument for every partner
+	 * @return true if all receives have been started
+	 */
+	template <typename ForAllPartners>
+	bool receiveSizesAndStartRecvs(ForAllPartners&& forAllPartners, const MPI_Comm& comm) {
+		bool allSizesReceived = true;
+		forAllPartners([&](CommunicationPartner& partner) { allSizesReceived &= partner.testRecvSize(comm); });
+		if (allSizesReceived) {
+			forAllPartners([&](CommunicationPartner& partner) { partner.startRecv(comm); });
+		}
+		return allSizesReceived;
+	}
+
 	//! flag, which tells whether a processor covers the whole domain along a dimension
 	//! if true, we will use the methods provided by the base class for handling the
 	//! respective dimension, instead of packing and unpacking messages to self
@@ -123,6 +162,14 @@ protected:
 	bool _pushPull;
 
 	bool _useSequentialFallback{true};
+
+	bool _usePersistentRequests{false};
+
+	bool _useSharedMemory{false};
+	size_t _sharedMemorySlotSize{0};
+	//! processes sharing memory with this one
+	MPI_Comm _nodeComm{MPI_COMM_NULL};
+	MPI_Win _sharedMemoryWindow{MPI_WIN_NULL};
 };
 
 class DirectNeighbourCommunicationScheme: public NeighbourCommunicationScheme {
@@ -158,11 +205,16 @@ public:
 			bool removeRecvDuplicates, DomainDecompMPIBase* domainDecomp, bool doHaloPositionCheck=true) override;
 
 protected:
-	void finalizeExchangeMoleculesMPI(ParticleContainer* moleculeContainer, Domain* /*domain*/, MessageType /*msgType*/,
-			bool removeRecvDuplicates, DomainDecompMPIBase* domainDecomp);
+	virtual void finalizeExchangeMoleculesMPI(ParticleContainer* moleculeContainer, Domain* /*domain*/,
+			MessageType /*msgType*/, bool removeRecvDuplicates, DomainDecompMPIBase* domainDecomp);
 	void initExchangeMoleculesMPI(ParticleContainer* moleculeContainer, Domain* /*domain*/, MessageType msgType,
 			bool /*removeRecvDuplicates*/, DomainDecompMPIBase* domainDecomp, bool doHaloPositionCheck);
 
+	//! Send the molecules to all neighbours, except the own process if the sequential fallback is used.
+	//! Called by initExchangeMoleculesMPI() after the sequential fallback has been handled.
+	virtual void sendToNeighbours(ParticleContainer* moleculeContainer, MessageType msgType,
+			std::vector<Molecule>& invalidParticles, DomainDecompMPIBase* domainDecomp, bool doHaloPositionCheck);
+
 private:
 	void doDirectFallBackExchange(const std::vector<HaloRegion>& haloRegions, MessageType msgType,
 								  DomainDecompMPIBase* domainDecomp, ParticleContainer*& moleculeContainer,
@@ -213,3 +265,38 @@ protected:
 			std::vector<std::vector<CommunicationPartner>>& neighbours, HaloRegion& ownRegion, double cutoffRadius);
 
 };
+
+#if MPI_VERSION >= 3
+/**
+ * Direct communication scheme (full shell neighbours, without push-pull partners), in which all messages of an
+ * exchange are transferred by one MPI-3 neighbourhood collective (MPI_Ineighbor_alltoallv) on a distributed graph
+ * communicator spanned by the neighbour ranks. The message sizes are exchanged beforehand by MPI_Neighbor_alltoall.
+ * Packing and unpacking of the messages is done by the communication partners, as in the direct scheme.
+ */
+class NeighbourCollectiveCommunicationScheme: public DirectNeighbourCommunicationScheme {
+public:
+	explicit NeighbourCollectiveCommunicationScheme(ZonalMethod* zonalMethod);
+	~NeighbourCollectiveCommunicationScheme() override;
+
+	void initCommunicationPartners(double cutoffRadius, Domain * domain,
+			DomainDecompMPIBase* domainDecomp,
+			ParticleContainer* moleculeContainer) override;
+
+protected:
+	void finalizeExchangeMoleculesMPI(ParticleContainer* moleculeContainer, Domain* /*domain*/, MessageType msgType,
+			bool removeRecvDuplicates, DomainDecompMPIBase* domainDecomp) override;
+
+	void sendToNeighbours(ParticleContainer* moleculeContainer, MessageType msgType,
+			std::vector<Molecule>& invalidParticles, DomainDecompMPIBase* domainDecomp,
+			bool doHaloPositionCheck) override;
+
+private:
+	//! indices into (*_neighbours)[0] of the partners communicated with, in the order of the graph neighbours
+	std::vector<size_t> _graphPartners;
+	MPI_Comm _graphComm{MPI_COMM_NULL};
+	MPI_Request _request{MPI_REQUEST_NULL};
+	//! all messages of the current exchange, in the order of _graphPartners
+	std::vector<char> _sendData, _recvData;
+	std::vector<int> _sendCounts, _sendDispls, _recvCounts, _recvDispls;
+};
+#endif
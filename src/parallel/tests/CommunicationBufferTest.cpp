@@ -15,6 +15,7 @@
 #include "ensemble/EnsembleBase.h"
 #include "ensemble/CanonicalEnsemble.h"
 
+#include <cmath>
 #include <iostream>
 using namespace std;
 
@@ -120,6 +121,139 @@ void CommunicationBufferTest::testHalo() {
 	}
 }
 
+void CommunicationBufferTest::testHaloSoA() {
+	Component dummyComponent(0);
+	dummyComponent.addLJcenter(0, 0, 0, 1, 1, 1, 0, false);
+	global_simulation->getEnsemble()->addComponent(dummyComponent);
+
+	CommunicationBuffer buf;
+	buf.resizeForAppendingLeavingMolecules(1);
+
+	Molecule m[3];
+	m[0] = Molecule(0, global_simulation->getEnsemble()->getComponent(0), 1.,
+			2., 3., -1., -2., -3.);
+	m[1] = Molecule(1, global_simulation->getEnsemble()->getComponent(0), 11.,
+			12., 13., -11., -12., -13.);
+	m[2] = Molecule(2, global_simulation->getEnsemble()->getComponent(0), 21.,
+			22., 23., -21., -22., -23.);
+	buf.addLeavingMolecule(0, m[0]);
+
+	// the halo copies are sent with shifted positions
+	std::vector<const Molecule*> halo = {&m[1], &m[2]};
+	std::vector<std::array<double, 3>> positions = {{{111., 12., 13.}}, {{21., -78., 23.}}};
+	buf.setHaloMoleculesSoA(halo, positions);
+	ASSERT_EQUAL(1ul, buf.getNumLeaving());
+	ASSERT_EQUAL(2ul, buf.getNumHalo());
+
+	Molecule leavingRead;
+	buf.readLeavingMolecule(0, leavingRead);
+	ASSERT_EQUAL(m[0].getID(), leavingRead.getID());
+
+	std::vector<Molecule> haloRead;
+	buf.readHaloMoleculesSoA(haloRead);
+	ASSERT_EQUAL(halo.size(), haloRead.size());
+	for (size_t i = 0; i < halo.size(); ++i) {
+#ifdef LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES
+		ASSERT_EQUAL(halo[i]->getID(), haloRead[i].getID());
+#else
+		ASSERT_EQUAL(UINT64_MAX, haloRead[i].getID());
+#endif
+		for (int d = 0; d < 3; ++d) {
+			ASSERT_DOUBLES_EQUAL(positions[i][d], haloRead[i].r(d), 1e-16);
+			ASSERT_DOUBLES_EQUAL(0.0, haloRead[i].v(d), 1e-16);
+		}
+	}
+}
+
+void CommunicationBufferTest::testReducedPrecision() {
+#ifndef ENABLE_REDUCED_MEMORY_MODE  // the reduced memory mode neither sends quaternions nor torques
+	// two sites, so that the molecules can rotate
+	Component dummyComponent(0);
+	dummyComponent.addLJcenter(0, 0, -0.5, 1, 1, 1, 0, false);
+	dummyComponent.addLJcenter(0, 0, 0.5, 1, 1, 1, 0, false);
+	global_simulation->getEnsemble()->addComponent(dummyComponent);
+	Component* component = global_simulation->getEnsemble()->getComponent(0);
+	ASSERT_TRUE(component->getRotationalDegreesOfFreedom() > 0);
+
+	CommunicationBuffer::setReducedPrecisionEncoding(true);
+	CommunicationBuffer::setSendHaloIDs(false);
+
+	const double qnorm = std::sqrt(30.);
+	Molecule m[2];
+	m[0] = Molecule(0, component, 1., 2., 3., 0., 0., 0., 1. / qnorm, 2. / qnorm, 3. / qnorm, 4. / qnorm, 0., 0., 0.);
+	m[1] = Molecule(1, component, 11., 12., 13., 0., 0., 0., 1., 0., 0., 0., 0., 0., 0.);
+	std::vector<const Molecule*> halo = {&m[0], &m[1]};
+
+	// halo region [-2, 0) x [10, 30) x [0, 30), the first molecule lies directly below the upper boundary in x
+	const double origin[3] = {-2., 10., 0.};
+	const double low[3] = {-2., 10., 0.};
+	const double high[3] = {0., 30., 30.};
+	std::vector<std::array<double, 3>> exactPositions = {{{std::nextafter(0., -1.), 12.3456789, 13.}},
+		{{-1.2345678, 29.87654321, 0.}}};
+	std::vector<std::array<double, 3>> positions = exactPositions;
+	for (auto& r : positions) {
+		for (int d = 0; d < 3; ++d) {
+			r[d] = CommunicationBuffer::roundToReducedPosition(r[d], origin[d], low[d], high[d]);
+			ASSERT_TRUE(r[d] >= low[d] and r[d] < high[d]);
+		}
+	}
+
+	CommunicationBuffer buf;
+	buf.setHaloMoleculesSoA(halo, positions, origin);
+	std::vector<Molecule> haloRead;
+	buf.readHaloMoleculesSoA(haloRead);
+	ASSERT_EQUAL(halo.size(), haloRead.size());
+	for (size_t i = 0; i < halo.size(); ++i) {
+		ASSERT_EQUAL(UINT64_MAX, haloRead[i].getID());
+		for (int d = 0; d < 3; ++d) {
+			// the rounded positions are decoded exactly
+			ASSERT_EQUAL(positions[i][d], haloRead[i].r(d));
+			ASSERT_DOUBLES_EQUAL(exactPositions[i][d], haloRead[i].r(d), 1e-5);
+		}
+		ASSERT_DOUBLES_EQUAL(halo[i]->q().qw(), haloRead[i].q().qw(), 1e-4);
+		ASSERT_DOUBLES_EQUAL(halo[i]->q().qx(), haloRead[i].q().qx(), 1e-4);
+		ASSERT_DOUBLES_EQUAL(halo[i]->q().qy(), haloRead[i].q().qy(), 1e-4);
+		ASSERT_DOUBLES_EQUAL(halo[i]->q().qz(), haloRead[i].q().qz(), 1e-4);
+	}
+
+	// without an origin, the halo copies are sent exactly and with ids
+	CommunicationBuffer exactBuf;
+	exactBuf.setHaloMoleculesSoA(halo, exactPositions);
+	exactBuf.readHaloMoleculesSoA(haloRead);
+	for (size_t i = 0; i < halo.size(); ++i) {
+#ifdef LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES
+		ASSERT_EQUAL(halo[i]->getID(), haloRead[i].getID());
+#endif
+		for (int d = 0; d < 3; ++d) {
+			ASSERT_EQUAL(exactPositions[i][d], haloRead[i].r(d));
+		}
+	}
+
+	// forces, torques and virials are sent as floats, id and position exactly
+	double F[3] = {1.23456789, -2.3456789, 3.456789e3};
+	double M[3] = {0.1, 0.2, -0.3};
+	double Vi[3] = {4., 5., 6.};
+	m[1].setF(F);
+	m[1].setM(M);
+	m[1].setVi(Vi);
+	CommunicationBuffer forceBuf;
+	forceBuf.resizeForAppendingForceMolecules(1);
+	forceBuf.addForceMolecule(0, m[1]);
+	Molecule forceRead;
+	forceBuf.readForceMolecule(0, forceRead);
+	ASSERT_EQUAL(m[1].getID(), forceRead.getID());
+	for (int d = 0; d < 3; ++d) {
+		ASSERT_EQUAL(m[1].r(d), forceRead.r(d));
+		ASSERT_DOUBLES_EQUAL(F[d], forceRead.F(d), 1e-6 * std::fabs(F[d]));
+		ASSERT_DOUBLES_EQUAL(M[d], forceRead.M(d), 1e-6 * std::fabs(M[d]));
+		ASSERT_DOUBLES_EQUAL(Vi[d], forceRead.Vi(d), 1e-6 * std::fabs(Vi[d]));
+	}
+
+	CommunicationBuffer::setReducedPrecisionEncoding(false);
+	CommunicationBuffer::setSendHaloIDs(true);
+#endif
+}
+
 void CommunicationBufferTest::testLeaving() {
 	Component dummyComponent(0);
 	dummyComponent.addLJcenter(0, 0, 0, 1, 1, 1, 0, false);
@@ -302,3 +436,68 @@ void CommunicationBufferTest::testPackSendRecvUnpack() {
 
 	//MPI_Barrier(MPI_COMM_WORLD);
 }
+
+void CommunicationBufferTest::testExternalStorage() {
+	Component dummyComponent(0);
+	dummyComponent.addLJcenter(0, 0, 0, 1, 1, 1, 0, false);
+	global_simulation->getEnsemble()->addComponent(dummyComponent);
+
+	Molecule m[3];
+	m[0] = Molecule(0, global_simulation->getEnsemble()->getComponent(0), 1., 2., 3., -1., -2., -3.);
+	m[1] = Molecule(1, global_simulation->getEnsemble()->getComponent(0), 11., 12., 13., -11., -12., -13.);
+	m[2] = Molecule(2, global_simulation->getEnsemble()->getComponent(0), 21., 22., 23., -21., -22., -23.);
+
+	std::vector<unsigned char> external(4096);
+
+	// pack in place
+	CommunicationBuffer sendBuf;
+	sendBuf.attachExternalStorage(external.data(), external.size(), 0);
+	sendBuf.clear();
+	sendBuf.resizeForAppendingLeavingMolecules(3);
+	for (int i = 0; i < 3; ++i) {
+		sendBuf.addLeavingMolecule(i, m[i]);
+	}
+	ASSERT_TRUE(sendBuf.isExternalStorage());
+	ASSERT_TRUE(sendBuf.getDataForSending() == external.data());
+	const size_t size = sendBuf.getNumElementsForSending();
+	sendBuf.detachExternalStorage();
+	ASSERT_EQUAL(0ul, sendBuf.getNumElementsForSending());
+
+	// read in place
+	CommunicationBuffer recvBuf;
+	recvBuf.attachExternalStorage(external.data(), size, size);
+	unsigned long numLeaving, numHalo;
+	recvBuf.resizeForReceivingMolecules(numLeaving, numHalo);
+	ASSERT_EQUAL(3ul, numLeaving);
+	ASSERT_EQUAL(0ul, numHalo);
+	for (int i = 0; i < 3; ++i) {
+		Molecule mread;
+		recvBuf.readLeavingMolecule(i, mread);
+		ASSERT_EQUAL(m[i].getID(), mread.getID());
+		for (int d = 0; d < 3; ++d) {
+			ASSERT_DOUBLES_EQUAL(m[i].r(d), mread.r(d), 1e-16);
+			ASSERT_DOUBLES_EQUAL(m[i].v(d), mread.v(d), 1e-16);
+		}
+	}
+	recvBuf.detachExternalStorage();
+
+	// external memory too small for all molecules: the buffer moves to its own storage
+	CommunicationBuffer smallBuf;
+	smallBuf.attachExternalStorage(external.data(), size - 1, 0);
+	smallBuf.resizeForAppendingLeavingMolecules(2);
+	smallBuf.addLeavingMolecule(0, m[0]);
+	smallBuf.addLeavingMolecule(1, m[1]);
+	ASSERT_TRUE(smallBuf.isExternalStorage());
+	smallBuf.resizeForAppendingLeavingMolecules(1);
+	smallBuf.addLeavingMolecule(2, m[2]);
+	ASSERT_TRUE(not smallBuf.isExternalStorage());
+	ASSERT_EQUAL(size, smallBuf.getNumElementsForSending());
+	smallBuf.resizeForReceivingMolecules(numLeaving, numHalo);
+	ASSERT_EQUAL(3ul, numLeaving);
+	for (int i = 0; i < 3; ++i) {
+		Molecule mread;
+		smallBuf.readLeavingMolecule(i, mread);
+		ASSERT_EQUAL(m[i].getID(), mread.getID());
+		ASSERT_DOUBLES_EQUAL(m[i].r(0), mread.r(0), 1e-16);
+	}
+}
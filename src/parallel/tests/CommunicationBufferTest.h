@@ -14,9 +14,12 @@ class CommunicationBufferTest : public utils::TestWithSimulationSetup {
 	TEST_SUITE(CommunicationBufferTest);
 	TEST_METHOD(testEmplaceRead);
 	TEST_METHOD(testHalo);
+	TEST_METHOD(testHaloSoA);
+	TEST_METHOD(testReducedPrecision);
 	TEST_METHOD(testLeaving);
 	TEST_METHOD(testLeavingAndHalo);
 	TEST_METHOD(testPackSendRecvUnpack);
+	TEST_METHOD(testExternalStorage);
 	TEST_SUITE_END();
 
 public:
@@ -27,12 +30,20 @@ public:
 	void testEmplaceRead();
 
 	void testHalo();
+	void testHaloSoA();
+	void testReducedPrecision();
 
 	void testLeaving();
 
 	void testLeavingAndHalo();
 
 	void testPackSendRecvUnpack();
+
+	/**
+	 * Pack into and read from external memory in place, and check that a buffer outgrowing the external memory keeps
+	 * its content.
+	 */
+	void testExternalStorage();
 };
 
 #endif /* SRC_PARALLEL_TESTS_COMMUNICATIONBUFFERTEST_H_ */
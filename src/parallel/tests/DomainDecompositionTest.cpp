@@ -34,6 +34,17 @@ void DomainDecompositionTest::testNoDuplicatedParticlesFilename(const char * fil
 	_domainDecomposition->collCommFinalize();
 
 	_domainDecomposition->balanceAndExchange(0., true, container.get(), _domain);
+
+	unsigned long numMolsWithHalo = 0;
+	for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+		++numMolsWithHalo;
+	}
+	_domainDecomposition->collCommInit(1);
+	_domainDecomposition->collCommAppendUnsLong(numMolsWithHalo);
+	_domainDecomposition->collCommAllreduceSum();
+	numMolsWithHalo = _domainDecomposition->collCommGetUnsLong();
+	_domainDecomposition->collCommFinalize();
+
 	container->deleteOuterParticles();
 
 	auto newNumMols = container->getNumberOfParticles();
@@ -53,8 +64,12 @@ void DomainDecompositionTest::testNoDuplicatedParticles() {
 	testNoDuplicatedParticlesFilename("H20_NaBr_0.01_T_293.15_DD.inp", 5.0);
 }
 
-void DomainDecompositionTest::testNoLostParticlesFilename(const char * filename, double cutoff) {
-	_domainDecomposition = new DomainDecomposition();
+unsigned long DomainDecompositionTest::testNoLostParticlesFilename(const char * filename, double cutoff,
+		bool persistentRequests, size_t sharedMemorySlotSize) {
+	auto* domainDecomposition = new DomainDecomposition();
+	domainDecomposition->setPersistentRequests(persistentRequests);
+	domainDecomposition->setSharedMemoryHalo(sharedMemorySlotSize > 0, sharedMemorySlotSize);
+	_domainDecomposition = domainDecomposition;
 
 	std::unique_ptr<ParticleContainer> container{
 		initializeFromFile(ParticleContainerFactory::LinkedCell, filename, cutoff)};
@@ -100,6 +115,17 @@ void DomainDecompositionTest::testNoLostParticlesFilename(const char * filename,
 	container->update();
 
 	_domainDecomposition->balanceAndExchange(0., true, container.get(), _domain);
+
+	unsigned long numMolsWithHalo = 0;
+	for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+		++numMolsWithHalo;
+	}
+	_domainDecomposition->collCommInit(1);
+	_domainDecomposition->collCommAppendUnsLong(numMolsWithHalo);
+	_domainDecomposition->collCommAllreduceSum();
+	numMolsWithHalo = _domainDecomposition->collCommGetUnsLong();
+	_domainDecomposition->collCommFinalize();
+
 	container->deleteOuterParticles();
 
 	auto newNumMols = container->getNumberOfParticles();
@@ -126,12 +152,25 @@ void DomainDecompositionTest::testNoLostParticlesFilename(const char * filename,
 	}
 
 	delete _domainDecomposition;
+	return numMolsWithHalo;
 }
 
 void DomainDecompositionTest::testNoLostParticles() {
 	testNoLostParticlesFilename("H20_NaBr_0.01_T_293.15_DD_2.inp", 3.0);
 }
 
+void DomainDecompositionTest::testNoLostParticlesPersistentRequests() {
+	testNoLostParticlesFilename("H20_NaBr_0.01_T_293.15_DD_2.inp", 3.0, true);
+}
+
+void DomainDecompositionTest::testNoLostParticlesSharedMemory() {
+	const unsigned long numMolsWithHalo = testNoLostParticlesFilename("H20_NaBr_0.01_T_293.15_DD_2.inp", 3.0);
+	// messages are packed into and read from the slots in place
+	ASSERT_EQUAL(numMolsWithHalo, testNoLostParticlesFilename("H20_NaBr_0.01_T_293.15_DD_2.inp", 3.0, false, 4194304));
+	// every message is larger than the slot and is sent via MPI
+	ASSERT_EQUAL(numMolsWithHalo, testNoLostParticlesFilename("H20_NaBr_0.01_T_293.15_DD_2.inp", 3.0, false, 16));
+}
+
 void DomainDecompositionTest::testExchangeMolecules1Proc() {
 	if (_domainDecomposition->getNumProcs() != 1) {
 		test_log->info() << "DomainDecompositionTest::testExchangeMolecules1Proc()"
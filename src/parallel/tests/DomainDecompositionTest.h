@@ -15,6 +15,8 @@ class DomainDecompositionTest: public utils::TestWithSimulationSetup {
 	TEST_SUITE(DomainDecompositionTest);
 	TEST_METHOD(testNoDuplicatedParticles);
 	TEST_METHOD(testNoLostParticles);
+	TEST_METHOD(testNoLostParticlesPersistentRequests);
+	TEST_METHOD(testNoLostParticlesSharedMemory);
 	TEST_METHOD(testExchangeMolecules1Proc);
 	TEST_SUITE_END();
 
@@ -26,13 +28,28 @@ public:
 
 	void testNoDuplicatedParticles();
 	void testNoLostParticles();
+	/**
+	 * Same as testNoLostParticles(), but with persistent requests for the neighbour communication.
+	 */
+	void testNoLostParticlesPersistentRequests();
+	/**
+	 * Same as testNoLostParticles(), but with the messages on the node exchanged through shared memory, once with
+	 * slots large enough for all messages and once with slots so small, that all messages fall back to MPI.
+	 * Also checks, that the same halo copies arrive as without shared memory.
+	 */
+	void testNoLostParticlesSharedMemory();
 	/**
 	 * Test the particle exchange if running with 1 process.
 	 */
 	void testExchangeMolecules1Proc();
 private:
 	void testNoDuplicatedParticlesFilename(const char * filename, double cutoff);
-	void testNoLostParticlesFilename(const char * filename, double cutoff);
+	/**
+	 * @param sharedMemorySlotSize if > 0, exchange through shared memory with slots of that size
+	 * @return global number of particles including the halo copies after the exchange
+	 */
+	unsigned long testNoLostParticlesFilename(const char * filename, double cutoff, bool persistentRequests = false,
+			size_t sharedMemorySlotSize = 0);
 };
 
 #endif /* DOMAINDECOMPOSITIONTEST_H_ */
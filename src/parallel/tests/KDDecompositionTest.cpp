@@ -480,6 +480,88 @@ void KDDecompositionTest::testbalanceAndExchange() {
 
 }
 
+void KDDecompositionTest::testDistributedCostGathering() {
+
+	// INIT
+	KDDecomposition * kdd;
+	ParticleContainer * moleculeContainer;
+	const double boxL = 1241.26574;
+	const double cutOff = 26.4562;
+	int fullSearchThreshold = 3;
+
+	_domain->setGlobalLength(0, boxL);
+	_domain->setGlobalLength(1, boxL);
+	_domain->setGlobalLength(2, boxL);
+	kdd = new KDDecomposition(cutOff, 1, 1, fullSearchThreshold);
+	kdd->_splitBiggest = false;
+	kdd->init(_domain);
+
+	double bBoxMin[3];
+	double bBoxMax[3];
+	for (int i = 0; i < 3; i++) {
+		bBoxMin[i] = kdd->getBoundingBoxMin(i, _domain);
+		bBoxMax[i] = kdd->getBoundingBoxMax(i, _domain);
+	}
+#ifndef MARDYN_AUTOPAS
+	moleculeContainer = new LinkedCells(bBoxMin, bBoxMax, cutOff);
+#else
+	moleculeContainer = new AutoPasContainer(cutOff);
+	moleculeContainer->rebuild(bBoxMin, bBoxMax);
+#endif
+	_rank = kdd->_rank;
+	srand(42);
+	initCoeffs(_currentCoeffs);
+	setNumParticlesPerCell(kdd->_numParticlesPerCell, kdd->_globalCellsPerDim);
+
+	// TEST
+	KDNode * globalRoot = nullptr;
+	KDNode * globalOwnLeaf = nullptr;
+	kdd->constructNewTree(globalRoot, globalOwnLeaf, moleculeContainer);
+
+	// hand the block of the root area to every process, as calcDistributedCellCounts does
+	kdd->_distributedCostGathering = true;
+	long firstCell, endCell;
+	KDDecomposition::getCellBlockRange(kdd->_decompTree, _rank, kdd->_numProcs, firstCell, endCell);
+	for (int d = 0; d < 3; ++d) {
+		kdd->_heldCellCounts.lowCorner[d] = kdd->_decompTree->_lowCorner[d];
+		kdd->_heldCellCounts.highCorner[d] = kdd->_decompTree->_highCorner[d];
+	}
+	kdd->_heldCellCounts.firstCell = firstCell;
+	kdd->_heldCellCounts.counts.assign(kdd->_numParticlesPerCell.begin() + firstCell,
+			kdd->_numParticlesPerCell.begin() + endCell);
+
+	KDNode * distributedRoot = nullptr;
+	KDNode * distributedOwnLeaf = nullptr;
+	kdd->constructNewTree(distributedRoot, distributedOwnLeaf, moleculeContainer);
+
+	ASSERT_TRUE(globalRoot->equals(*distributedRoot));
+	ASSERT_TRUE(globalOwnLeaf->equals(*distributedOwnLeaf));
+
+	// the own leaf has to hold the particle numbers of all its cells
+	const KDDecomposition::CellCountsBlock& leaf = kdd->_newOwnLeafCellCounts;
+	ASSERT_EQUAL(0l, leaf.firstCell);
+	long numLeafCells = 1;
+	for (int d = 0; d < 3; ++d) {
+		numLeafCells *= distributedOwnLeaf->_highCorner[d] - distributedOwnLeaf->_lowCorner[d] + 1;
+	}
+	ASSERT_EQUAL(numLeafCells, leaf.numCells(1));
+	long i = 0;
+	for (int z = leaf.lowCorner[2]; z <= leaf.highCorner[2]; ++z) {
+		for (int y = leaf.lowCorner[1]; y <= leaf.highCorner[1]; ++y) {
+			for (int x = leaf.lowCorner[0]; x <= leaf.highCorner[0]; ++x) {
+				const int globalIndex = (z * kdd->_globalCellsPerDim[1] + y) * kdd->_globalCellsPerDim[0] + x;
+				ASSERT_EQUAL(kdd->_numParticlesPerCell[globalIndex], leaf.counts[i++]);
+			}
+		}
+	}
+
+	// SHUTDOWN
+	delete globalRoot;
+	delete distributedRoot;
+	delete moleculeContainer;
+	delete kdd;
+}
+
 void KDDecompositionTest::initCoeffs(std::vector<double>& c) const {
 	for (int i = 0; i < 10; ++i)
 		c.push_back(myRand(-1.0, 1.0));
@@ -24,6 +24,7 @@ class KDDecompositionTest : public utils::TestWithSimulationSetup {
 	TEST_METHOD(testCompleteTreeInfo);
 	TEST_METHOD(testRebalancingDeadlocks);
 	TEST_METHOD(testbalanceAndExchange);
+	TEST_METHOD(testDistributedCostGathering);
 	TEST_SUITE_END();
 
 public:
@@ -52,6 +53,12 @@ public:
 
 	void testbalanceAndExchange();
 
+	/**
+	 * The decomposition with distributed cost gathering has to be the same as the one using
+	 * the global particle numbers of all cells.
+	 */
+	void testDistributedCostGathering();
+
 private:
 
 	void testNoDuplicatedParticlesFilename(const char * filename, double cutoff, double domainLength);
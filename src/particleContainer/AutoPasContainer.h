@@ -94,6 +94,8 @@ public:
 
 	double getSkin() const override;
 
+	unsigned getRebuildFrequency() const override { return _verletRebuildFrequency; }
+
 	void deleteMolecule(ParticleIterator &moleculeIter, const bool &rebuildCaches) override;
 
 	double getEnergy(ParticlePairsHandler *particlePairsHandler, Molecule *m1, CellProcessor &cellProcessor) override;
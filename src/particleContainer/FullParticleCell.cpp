@@ -12,12 +12,15 @@
 #include "Simulation.h"
 
 #include "utils/mardyn_assert.h"
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 using namespace std;
 
 FullParticleCell::FullParticleCell() :
-		_molecules(), _cellDataSoA(0, 0, 0, 0, 0) {
+		_molecules(), _cellDataSoA(0, 0, 0, 0, 0), _soaLayoutValid(false),
+		_soaLayoutVersion(0), _verletDisplacement(0.0), _verletClusterLists(), _exclusiveAccesses(0) {
 }
 
 FullParticleCell::~FullParticleCell() {
@@ -28,6 +31,7 @@ FullParticleCell::~FullParticleCell() {
 
 void FullParticleCell::deallocateAllParticles() {
 	_molecules.clear();
+	invalidateSoALayout();
 }
 
 bool FullParticleCell::findMoleculeByID(size_t& index, unsigned long molid) const {
@@ -67,6 +71,9 @@ bool FullParticleCell::addParticle(Molecule& particle, bool checkWhetherDuplicat
 			wasInserted = true;
 		}
 	}
+	if (wasInserted) {
+		invalidateSoALayout();
+	}
 	return wasInserted;
 }
 
@@ -84,6 +91,7 @@ bool FullParticleCell::deleteMoleculeByIndex(size_t index) {
 
 	bool found = true;
 	UnorderedVector::fastRemove(_molecules, index);
+	invalidateSoALayout();
 	return found;
 }
 
@@ -142,6 +150,10 @@ void FullParticleCell::getRegion(double lowCorner[3], double highCorner[3], std:
 
 void FullParticleCell::buildSoACaches() {
 
+	if (_soaLayoutValid and refreshSoACaches()) {
+		return;
+	}
+
 	// Determine the total number of centers.
 	size_t numMolecules = _molecules.size();
 	size_t nLJCenters = 0;
@@ -158,12 +170,15 @@ void FullParticleCell::buildSoACaches() {
 
 	// Construct the SoA.
 	_cellDataSoA.resize(numMolecules,nLJCenters,nCharges,nDipoles,nQuadrupoles);
+	_cellDataSoA.clearAccumulators();
 
 	size_t iLJCenters = 0;
 	size_t iCharges = 0;
 	size_t iDipoles = 0;
 	size_t iQuadrupoles = 0;
 
+	double zero[3] = {0.0, 0.0, 0.0};
+
 	// For each molecule iterate over all its centers.
 	for (size_t i = 0; i < _molecules.size(); ++i) {
 		Molecule & M = _molecules[i];
@@ -188,8 +203,114 @@ void FullParticleCell::buildSoACaches() {
 		iDipoles += mol_dipoles_num;
 		iQuadrupoles += mol_quadrupoles_num;
 
-		M.clearFM();
+		// the SoA accumulators have been cleared in bulk above
+		M.setF(zero);
+		M.setM(zero);
+		M.setVi(zero);
+	}
+
+	_soaLayoutValid = true;
+	++_soaLayoutVersion;
+}
+
+//! site offset relative to the molecule center -> absolute site position
+static std::array<double, 3> siteToGlobal(const Molecule& M, std::array<double, 3> offset) {
+	offset[0] += M.r(0);
+	offset[1] += M.r(1);
+	offset[2] += M.r(2);
+	return offset;
+}
+
+bool FullParticleCell::refreshSoACaches() {
+	const size_t numMolecules = _molecules.size();
+	if (numMolecules != _cellDataSoA.getMolNum()) {
+		return false;
+	}
+
+	size_t iLJCenters = 0;
+	size_t iCharges = 0;
+	size_t iDipoles = 0;
+	size_t iQuadrupoles = 0;
+
+	double zero[3] = {0.0, 0.0, 0.0};
+	double maxDisplacementSquare = 0.0;
+
+	for (size_t i = 0; i < numMolecules; ++i) {
+		Molecule & M = _molecules[i];
+		const size_t mol_ljc_num = _cellDataSoA._mol_ljc_num[i];
+		const size_t mol_charges_num = _cellDataSoA._mol_charges_num[i];
+		const size_t mol_dipoles_num = _cellDataSoA._mol_dipoles_num[i];
+		const size_t mol_quadrupoles_num = _cellDataSoA._mol_quadrupoles_num[i];
+
+		// e.g. a plugin might have changed the component of a molecule in place
+		if (M.numLJcenters() != mol_ljc_num or M.numCharges() != mol_charges_num
+				or M.numDipoles() != mol_dipoles_num or M.numQuadrupoles() != mol_quadrupoles_num) {
+			_soaLayoutValid = false;
+			return false;
+		}
+
+		// _mol_pos still holds the position of the last refresh
+		const double dx = M.r(0) - _cellDataSoA._mol_pos.x(i);
+		const double dy = M.r(1) - _cellDataSoA._mol_pos.y(i);
+		const double dz = M.r(2) - _cellDataSoA._mol_pos.z(i);
+		maxDisplacementSquare = std::max(maxDisplacementSquare, dx * dx + dy * dy + dz * dz);
+
+		_cellDataSoA._mol_pos.x(i) = M.r(0);
+		_cellDataSoA._mol_pos.y(i) = M.r(1);
+		_cellDataSoA._mol_pos.z(i) = M.r(2);
+
+		// the layout is unchanged, so only the site positions and orientations are written,
+		// the constant site data (lookup ids, charges, moments) stays in place
+		M.setSoA(&_cellDataSoA);
+		M.setStartIndexSoA_LJ(iLJCenters);
+		M.setStartIndexSoA_C(iCharges);
+		M.setStartIndexSoA_D(iDipoles);
+		M.setStartIndexSoA_Q(iQuadrupoles);
+		M.normalizeQuaternion();
+
+		const std::array<vcp_real_calc, 3> molPos = Molecule::convert_double_to_vcp_real_calc(M.r_arr());
+		for (size_t j = 0; j < mol_ljc_num; ++j) {
+			_cellDataSoA.setSitePositions(ConcSites::SiteType::LJC, iLJCenters + j, molPos,
+					Molecule::convert_double_to_vcp_real_calc(siteToGlobal(M, M.computeLJcenter_d(j))));
+		}
+		for (size_t j = 0; j < mol_charges_num; ++j) {
+			_cellDataSoA.setSitePositions(ConcSites::SiteType::CHARGE, iCharges + j, molPos,
+					Molecule::convert_double_to_vcp_real_calc(siteToGlobal(M, M.computeCharge_d(j))));
+		}
+		for (size_t j = 0; j < mol_dipoles_num; ++j) {
+			_cellDataSoA.setSitePositions(ConcSites::SiteType::DIPOLE, iDipoles + j, molPos,
+					Molecule::convert_double_to_vcp_real_calc(siteToGlobal(M, M.computeDipole_d(j))));
+			_cellDataSoA.setDipoleOrientation(iDipoles + j, Molecule::convert_double_to_vcp_real_calc(M.computeDipole_e(j)));
+		}
+		for (size_t j = 0; j < mol_quadrupoles_num; ++j) {
+			_cellDataSoA.setSitePositions(ConcSites::SiteType::QUADRUPOLE, iQuadrupoles + j, molPos,
+					Molecule::convert_double_to_vcp_real_calc(siteToGlobal(M, M.computeQuadrupole_d(j))));
+			_cellDataSoA.setQuadrupoleOrientation(iQuadrupoles + j, Molecule::convert_double_to_vcp_real_calc(M.computeQuadrupole_e(j)));
+		}
+
+		iLJCenters += mol_ljc_num;
+		iCharges += mol_charges_num;
+		iDipoles += mol_dipoles_num;
+		iQuadrupoles += mol_quadrupoles_num;
+
+		M.setF(zero);
+		M.setM(zero);
+		M.setVi(zero);
+	}
+
+	_cellDataSoA.clearAccumulators();
+	_verletDisplacement += std::sqrt(maxDisplacementSquare);
+	return true;
+}
+
+VerletClusterList& FullParticleCell::getVerletClusterList(unsigned long otherCellIndex) {
+	for (auto& list : _verletClusterLists) {
+		if (list.getOtherCellIndex() == otherCellIndex) {
+			return list;
+		}
 	}
+	_verletClusterLists.emplace_back(otherCellIndex);
+	return _verletClusterLists.back();
 }
 
 void FullParticleCell::increaseMoleculeStorage(size_t numExtraMols) {
@@ -13,7 +13,9 @@
 #include "Cell.h"
 #include "particleContainer/ParticleCellBase.h"
 #include "particleContainer/adapter/CellDataSoA.h"
+#include "particleContainer/adapter/VerletClusterList.h"
 #include "SingleCellIterator.h"
+#include "utils/mardyn_assert.h"
 
 //! @brief FullParticleCell data structure. Renamed from ParticleCell.
 //! @author Martin Buchholz
@@ -86,6 +88,57 @@ public:
 		return _cellDataSoA;
 	}
 
+	/**
+	 * \brief Counter which is increased whenever the SoA layout is rebuilt from scratch.
+	 * \details Data referring to SoA indices (e.g. VerletClusterList) is only valid for the same version.
+	 */
+	unsigned long getSoALayoutVersion() const {
+		return _soaLayoutVersion;
+	}
+
+	/**
+	 * \brief Upper bound for the distance any molecule of this cell moved since a given point in time.
+	 * \details Sum over all SoA refreshes of the maximal per-refresh displacement. Monotonically increasing,
+	 * so the difference of two values bounds the displacement in between.
+	 */
+	double getVerletDisplacement() const {
+		return _verletDisplacement;
+	}
+
+	/**
+	 * \brief Get the Verlet cluster list of this cell (as first cell) with the cell otherCellIndex.
+	 * \details The list is created if it does not exist yet. It has to be checked for validity before use.
+	 * Creating a list modifies this cell, so the caller needs exclusive access to it, as it needs for writing the
+	 * forces anyway. This holds for all traversals which are valid for a cell processor writing to both cells of
+	 * a pair (e.g. c08); in debug builds it is checked via beginExclusiveAccess().
+	 */
+	VerletClusterList& getVerletClusterList(unsigned long otherCellIndex);
+
+	/**
+	 * \brief Mark the begin of exclusive access to this cell by the calling thread.
+	 * \details Only checked in debug builds: fails, if another thread accesses the cell at the same time.
+	 */
+	void beginExclusiveAccess() {
+#ifndef NDEBUG
+		int accesses;
+		#if defined(_OPENMP)
+		#pragma omp atomic capture
+		#endif
+		accesses = ++_exclusiveAccesses;
+		mardyn_assert(accesses == 1);
+#endif
+	}
+
+	//! \brief Mark the end of exclusive access, see beginExclusiveAccess().
+	void endExclusiveAccess() {
+#ifndef NDEBUG
+		#if defined(_OPENMP)
+		#pragma omp atomic
+		#endif
+		--_exclusiveAccesses;
+#endif
+	}
+
 	void preUpdateLeavingMolecules() override;
 
 	void updateLeavingMoleculesBase(ParticleCellBase& otherCell) override;
@@ -95,6 +148,13 @@ public:
 	void getRegion(double lowCorner[3], double highCorner[3],
 			std::vector<Molecule*> &particlePtrs, bool removeFromContainer = false) override;
 
+	/**
+	 * \brief Build or refresh the structure of arrays for VectorizedCellProcessor.
+	 *
+	 * The SoA layout (number of molecules and sites, per-molecule site counts, site offsets)
+	 * is kept alive between time steps. As long as no molecule has been added to or removed
+	 * from this cell, only positions, orientations and accumulators are refreshed.
+	 */
 	void buildSoACaches() override;
 
 	void increaseMoleculeStorage(size_t numExtraMols) override;
@@ -118,6 +178,17 @@ private:
 
 	void updateLeavingMolecules(FullParticleCell& otherCell);
 
+	/**
+	 * \brief Refresh the SoA of an unchanged molecule layout.
+	 * \return false if a molecule's site counts no longer match the layout, in which case a full rebuild is needed.
+	 */
+	bool refreshSoACaches();
+
+	//! invalidate the persistent SoA layout, has to be called whenever _molecules changes structurally
+	void invalidateSoALayout() {
+		_soaLayoutValid = false;
+	}
+
 	/**
 	 * \brief A vector of pointers to the Molecules in this cell.
 	 */
@@ -133,6 +204,25 @@ private:
 	 * \author Johannes Heckl
 	 */
 	CellDataSoA _cellDataSoA;
+
+	/**
+	 * \brief Whether _cellDataSoA still matches the order and site counts of _molecules.
+	 */
+	bool _soaLayoutValid;
+
+	//! see getSoALayoutVersion()
+	unsigned long _soaLayoutVersion;
+
+	//! see getVerletDisplacement()
+	double _verletDisplacement;
+
+	/**
+	 * \brief Verlet cluster lists of this cell with its neighbours, see VerletClusterList.
+	 */
+	std::vector<VerletClusterList> _verletClusterLists;
+
+	//! number of threads currently accessing this cell, see beginExclusiveAccess()
+	int _exclusiveAccesses;
 };
 
 #endif /* SRC_PARTICLECONTAINER_FULLPARTICLECELL_H_ */
@@ -36,6 +36,11 @@ protected:
 	template <bool eighthShell=false>
 	void processBaseCell(CellProcessor& cellProcessor, unsigned long cellIndex) const;
 
+	//! offsets of the 8 cells processed by processBaseCell() relative to the base cell
+	const std::array<unsigned long, 8>& getCellOffsets8Pack() const {
+		return _cellOffsets8Pack;
+	}
+
 private:
 	void computeOffsets();
 
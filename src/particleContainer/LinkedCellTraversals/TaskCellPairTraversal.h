@@ -0,0 +1,187 @@
+/*
+ * TaskCellPairTraversal.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_PARTICLECONTAINER_LINKEDCELLTRAVERSALS_TASKCELLPAIRTRAVERSAL_H_
+#define SRC_PARTICLECONTAINER_LINKEDCELLTRAVERSALS_TASKCELLPAIRTRAVERSAL_H_
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "C08BasedTraversals.h"
+#include "utils/mardyn_assert.h"
+#include "utils/threeDimensionalMapping.h"
+
+struct TaskCellPairTraversalData : CellPairTraversalData {
+};
+
+/**
+ * \brief Dependency-driven C08 traversal without the QuickSched library.
+ * \details Every C08 base step (the 2x2x2 block of cells starting at a base cell, see C08BasedTraversals) is one
+ * OpenMP task. Instead of eight colours separated by barriers, a task only waits for those tasks, whose blocks
+ * share a cell with its own block (task dependencies on the cells). Idle threads take any ready task, so a single
+ * crowded block no longer stalls a whole colour.
+ *
+ * The cost of a block is estimated as the squared number of molecules in it. Tasks are created in order of
+ * decreasing cost, so expensive blocks are started first and cheap ones fill the gaps at the end of the traversal.
+ * Blocks without any molecule are skipped.
+ */
+template <class CellTemplate>
+class TaskCellPairTraversal : public C08BasedTraversals<CellTemplate> {
+public:
+	TaskCellPairTraversal(
+			std::vector<CellTemplate>& cells,
+			const std::array<unsigned long, 3>& dims) :
+			C08BasedTraversals<CellTemplate>(cells, dims), _tasks() {
+	}
+	~TaskCellPairTraversal() = default;
+
+	using C08BasedTraversals<CellTemplate>::rebuild;
+
+	void traverseCellPairs(CellProcessor& cellProcessor) override;
+	void traverseCellPairsOuter(CellProcessor& cellProcessor) override;
+	void traverseCellPairsInner(CellProcessor& cellProcessor, unsigned stage, unsigned stageCount) override;
+
+private:
+	/**
+	 * \brief Process all base cells within [start, end) for which isSelected(x, y, z) returns true.
+	 */
+	template <typename Selector>
+	void traverseCellPairsBackend(CellProcessor& cellProcessor,
+			const std::array<unsigned long, 3>& start,
+			const std::array<unsigned long, 3>& end,
+			Selector isSelected);
+
+	//! (cost estimate, base cell index) of all tasks of the current traversal, reused between traversals
+	std::vector<std::pair<unsigned long, unsigned long>> _tasks;
+};
+
+
+template<class CellTemplate>
+void TaskCellPairTraversal<CellTemplate>::traverseCellPairs(CellProcessor& cellProcessor) {
+	const std::array<unsigned long, 3> start = {0, 0, 0};
+	const std::array<unsigned long, 3> end = {this->_dims[0] - 1, this->_dims[1] - 1, this->_dims[2] - 1};
+
+	traverseCellPairsBackend(cellProcessor, start, end,
+			[](unsigned long, unsigned long, unsigned long) { return true; });
+}
+
+template<class CellTemplate>
+void TaskCellPairTraversal<CellTemplate>::traverseCellPairsOuter(CellProcessor& cellProcessor) {
+	const unsigned long minsize = std::min(this->_dims[0], std::min(this->_dims[1], this->_dims[2]));
+
+	if (minsize <= 5) {
+		// iterating in the inner region doesn't do anything. Iterate normally.
+		traverseCellPairs(cellProcessor);
+		return;
+	}
+
+	const std::array<unsigned long, 3> start = {0, 0, 0};
+	const std::array<unsigned long, 3> end = {this->_dims[0] - 1, this->_dims[1] - 1, this->_dims[2] - 1};
+	const std::array<unsigned long, 3> dims = this->_dims;
+
+	// same base cells as C08CellPairTraversal::traverseCellPairsOuter: all that touch halo or boundary cells
+	traverseCellPairsBackend(cellProcessor, start, end,
+			[&dims](unsigned long x, unsigned long y, unsigned long z) {
+				return x < 2 or y < 2 or z < 2 or x >= dims[0] - 3 or y >= dims[1] - 3 or z >= dims[2] - 3;
+			});
+}
+
+template<class CellTemplate>
+void TaskCellPairTraversal<CellTemplate>::traverseCellPairsInner(CellProcessor& cellProcessor, unsigned stage,
+		unsigned stageCount) {
+	unsigned long splitdim = 0;
+	unsigned long maxcellsize = this->_dims[0];
+	for (unsigned long i = 1; i < 3; i++) {
+		if (this->_dims[i] > maxcellsize) {
+			splitdim = i;
+			maxcellsize = this->_dims[i];
+		}
+	}
+	const unsigned long splitsize = maxcellsize - 5;
+	const unsigned long minsize = std::min(this->_dims[0], std::min(this->_dims[1], this->_dims[2]));
+
+	mardyn_assert(minsize >= 4);  // there should be at least 4 cells in each dimension, otherwise we did something stupid!
+
+	if (minsize <= 5) {
+		return;  // we can not iterate over any inner cells, that do not depend on boundary or halo cells
+	}
+
+	std::array<unsigned long, 3> lower;
+	std::array<unsigned long, 3> upper;
+	for (unsigned long i = 0; i < 3; i++) {
+		lower[i] = 2;
+		upper[i] = this->_dims[i] - 3;
+	}
+	lower[splitdim] = 2 + splitsize * stage / stageCount;
+	upper[splitdim] = 2 + splitsize * (stage + 1) / stageCount;
+
+	traverseCellPairsBackend(cellProcessor, lower, upper,
+			[](unsigned long, unsigned long, unsigned long) { return true; });
+}
+
+template<class CellTemplate>
+template<typename Selector>
+void TaskCellPairTraversal<CellTemplate>::traverseCellPairsBackend(CellProcessor& cellProcessor,
+		const std::array<unsigned long, 3>& start, const std::array<unsigned long, 3>& end,
+		Selector isSelected) {
+	using threeDimensionalMapping::threeToOneD;
+
+	const std::array<unsigned long, 8>& offsets = this->getCellOffsets8Pack();
+
+	// gather the non-empty blocks together with their cost estimate
+	_tasks.clear();
+	for (unsigned long z = start[2]; z < end[2]; ++z) {
+		for (unsigned long y = start[1]; y < end[1]; ++y) {
+			for (unsigned long x = start[0]; x < end[0]; ++x) {
+				if (not isSelected(x, y, z)) {
+					continue;
+				}
+				const unsigned long baseIndex = threeToOneD(x, y, z, this->_dims);
+				unsigned long numMolecules = 0;
+				for (const unsigned long offset : offsets) {
+					numMolecules += this->_cells->at(baseIndex + offset).getMoleculeCount();
+				}
+				if (numMolecules > 0) {
+					_tasks.emplace_back(numMolecules * numMolecules, baseIndex);
+				}
+			}
+		}
+	}
+
+	// most expensive blocks first
+	std::sort(_tasks.begin(), _tasks.end(), std::greater<std::pair<unsigned long, unsigned long>>());
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#pragma omp single
+	#endif
+	{
+		for (const auto& task : _tasks) {
+			const unsigned long baseIndex = task.second;
+			#if defined(_OPENMP)
+			CellTemplate * const cells = this->_cells->data();
+			// the 8 cells of the block; blocks sharing a cell must not be processed concurrently
+			CellTemplate * const c0 = cells + baseIndex + offsets[0];
+			CellTemplate * const c1 = cells + baseIndex + offsets[1];
+			CellTemplate * const c2 = cells + baseIndex + offsets[2];
+			CellTemplate * const c3 = cells + baseIndex + offsets[3];
+			CellTemplate * const c4 = cells + baseIndex + offsets[4];
+			CellTemplate * const c5 = cells + baseIndex + offsets[5];
+			CellTemplate * const c6 = cells + baseIndex + offsets[6];
+			CellTemplate * const c7 = cells + baseIndex + offsets[7];
+			#pragma omp task default(shared) firstprivate(baseIndex) \
+				depend(inout: c0[0:1], c1[0:1], c2[0:1], c3[0:1], c4[0:1], c5[0:1], c6[0:1], c7[0:1])
+			#endif
+			{
+				this->template processBaseCell<false>(cellProcessor, baseIndex);
+			}
+		}
+	} // end pragma omp single / parallel; implicit barrier waits for all tasks
+}
+
+#endif /* SRC_PARTICLECONTAINER_LINKEDCELLTRAVERSALS_TASKCELLPAIRTRAVERSAL_H_ */
@@ -10,6 +10,7 @@
 #include "parallel/DomainDecompBase.h"
 #include "particleContainer/adapter/CellProcessor.h"
 #include "particleContainer/adapter/LegacyCellProcessor.h"
+#include "particleContainer/adapter/VectorizedCellProcessor.h"
 #include "particleContainer/adapter/ParticlePairs2PotForceAdapter.h"
 #include "particleContainer/handlerInterfaces/ParticlePairsHandler.h"
 #include "utils/Logger.h"
@@ -129,6 +130,13 @@ void LinkedCells::readXML(XMLfileUnits& xmlconfig) {
 	_cellsInCutoff = xmlconfig.getNodeValue_int("cellsInCutoffRadius", 1); // new
 	mardyn_assert(_cellsInCutoff>=1); // new
 
+	_skin = xmlconfig.getNodeValue_double("skin", 0.);
+	_rebuildFrequency = xmlconfig.getNodeValue_int("rebuildFrequency", 10);
+	if (_skin > 0.) {
+		global_log->info() << "LinkedCells: Verlet cluster lists with skin " << _skin << " and rebuild frequency "
+				<< _rebuildFrequency << endl;
+	}
+
 	_traversalTuner = std::unique_ptr<TraversalTuner<ParticleCell>>(new TraversalTuner<ParticleCell>()); // new way to assign _traversalTuner
 	_traversalTuner->readXML(xmlconfig);
 }
@@ -149,7 +157,10 @@ bool LinkedCells::rebuild(double bBoxMin[3], double bBoxMax[3]) {
 	int numberOfCells = 1;
 
 	global_log->info() << "Using " << _cellsInCutoff << " cells in cutoff." << endl;
-	float rc = (_cutoffRadius / _cellsInCutoff);
+	float rc = (_cutoffRadius / _cellsInCutoff) * _cellSizeFactor;
+	if (_cellSizeFactor != 1.0) {
+		global_log->info() << "Cell size factor: " << _cellSizeFactor << endl;
+	}
 
 	for (int dim = 0; dim < 3; dim++) {
 		_boxWidthInNumCells[dim] = floor((_boundingBoxMax[dim] - _boundingBoxMin[dim]) / rc);
@@ -203,6 +214,48 @@ bool LinkedCells::rebuild(double bBoxMin[3], double bBoxMax[3]) {
 
 }
 
+bool LinkedCells::isCellSizeFactorApplicable(double cellSizeFactor) const {
+	// the halo stays one layer of cells, so the cells must not become too coarse to send leaving and halo
+	// particles together (see rebuild)
+	const double rc = (_cutoffRadius / _cellsInCutoff) * cellSizeFactor;
+	for (int d = 0; d < 3; ++d) {
+		if (floor((_boundingBoxMax[d] - _boundingBoxMin[d]) / rc) < 2 * _haloWidthInNumCells[d]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void LinkedCells::applyCellSizeFactor() {
+	double cellSizeFactor = _traversalTuner->getCellSizeFactor();
+	while (cellSizeFactor != _cellSizeFactor and cellSizeFactor != 1.0
+			and not isCellSizeFactorApplicable(cellSizeFactor)) {
+		_traversalTuner->rejectCellSizeFactor(cellSizeFactor);
+		cellSizeFactor = _traversalTuner->getCellSizeFactor();
+	}
+	if (cellSizeFactor == _cellSizeFactor) {
+		return;
+	}
+
+	// the halo has been cleared after the last step, so this collects the own particles
+	std::vector<Molecule> molecules;
+	molecules.reserve(getNumberOfParticles());
+	for (auto it = iterator(ParticleIterator::ALL_CELLS); it.isValid(); ++it) {
+		molecules.push_back(*it);
+	}
+	clear();
+
+	_cellSizeFactor = cellSizeFactor;
+	double bBoxMin[3];
+	double bBoxMax[3];
+	for (int d = 0; d < 3; ++d) {
+		bBoxMin[d] = _boundingBoxMin[d];
+		bBoxMax[d] = _boundingBoxMax[d];
+	}
+	rebuild(bBoxMin, bBoxMax);
+	addParticles(molecules);
+}
+
 void LinkedCells::check_molecules_in_box() {
 	std::vector<Molecule> badMolecules;
 	unsigned numBadMolecules = 0;
@@ -245,6 +298,15 @@ void LinkedCells::update() {
 	check_molecules_in_box();
 #endif
 
+	if (_traversalTuner->isAutotuning()) {
+		double volume = 1.0;
+		for (int d = 0; d < 3; ++d) {
+			volume *= _boundingBoxMax[d] - _boundingBoxMin[d];
+		}
+		_traversalTuner->finishStep(getNumberOfParticles() / volume);
+		applyCellSizeFactor();
+	}
+
 	// TODO: replace via a cellProcessor and a traverseCells call ?
 #ifndef ENABLE_REDUCED_MEMORY_MODE
 	update_via_copies();
@@ -419,7 +481,7 @@ void LinkedCells::update_via_sliced_traversal() {
 	if (_resortCellProcessorSliced == nullptr) {
 		_resortCellProcessorSliced = new ResortCellProcessorSliced(this);
 	}
-	_traversalTuner->traverseCellPairs(*_resortCellProcessorSliced);
+	_traversalTuner->traverseCellPairs(_traversalTuner->getSelectedTraversal(), *_resortCellProcessorSliced);
 }
 
 void LinkedCells::update_via_traversal() {
@@ -439,7 +501,7 @@ void LinkedCells::update_via_traversal() {
 		void endTraversal() {}
 
 	} resortCellProcessor;
-	_traversalTuner->traverseCellPairs(resortCellProcessor);
+	_traversalTuner->traverseCellPairs(_traversalTuner->getSelectedTraversal(), resortCellProcessor);
 }
 
 bool LinkedCells::addParticle(Molecule& particle, bool inBoxCheckedAlready, bool checkWhetherDuplicate, const bool& rebuildCaches) {
@@ -1051,6 +1113,65 @@ double LinkedCells::getEnergy(ParticlePairsHandler* particlePairsHandler, Molecu
 	return u;
 }
 
+void LinkedCells::getEnergies(ParticlePairsHandler* particlePairsHandler, std::vector<Molecule>& testMolecules,
+		std::vector<double>& energies, CellProcessor& cellProcessor) {
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	VectorizedCellProcessor* vcp = dynamic_cast<VectorizedCellProcessor*>(&cellProcessor);
+#else
+	VectorizedCellProcessor* vcp = nullptr;
+#endif
+	if (vcp == nullptr) {
+		ParticleContainer::getEnergies(particlePairsHandler, testMolecules, energies, cellProcessor);
+		return;
+	}
+
+	energies.resize(testMolecules.size());
+
+	vector<long> forwardNeighbourOffsets;
+	vector<long> backwardNeighbourOffsets;
+	calculateNeighbourIndices(forwardNeighbourOffsets, backwardNeighbourOffsets);
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		CellDataSoA testSoA(0, 0, 0, 0, 0);
+
+		#if defined(_OPENMP)
+		#pragma omp for schedule(dynamic, 16)
+		#endif
+		for (size_t i = 0; i < testMolecules.size(); ++i) {
+			Molecule testMolecule = testMolecules[i];
+			const unsigned long cellIndex = getCellIndexOfMolecule(&testMolecule);
+			mardyn_assert(not _cells[cellIndex].isHaloCell());
+
+			const size_t nLJ = testMolecule.numLJcenters();
+			const size_t nC = testMolecule.numCharges();
+			const size_t nD = testMolecule.numDipoles();
+			const size_t nQ = testMolecule.numQuadrupoles();
+			testSoA.resize(1, nLJ, nC, nD, nQ);
+			testSoA._mol_ljc_num[0] = nLJ;
+			testSoA._mol_charges_num[0] = nC;
+			testSoA._mol_dipoles_num[0] = nD;
+			testSoA._mol_quadrupoles_num[0] = nQ;
+			testSoA._mol_pos.x(0) = testMolecule.r(0);
+			testSoA._mol_pos.y(0) = testMolecule.r(1);
+			testSoA._mol_pos.z(0) = testMolecule.r(2);
+			testMolecule.setupSoACache(&testSoA, 0, 0, 0, 0);
+
+			double u = vcp->processTestMolecule(testSoA, _cells[cellIndex]);
+			for (auto offset : forwardNeighbourOffsets) {
+				u += vcp->processTestMolecule(testSoA, _cells[cellIndex + offset]);
+			}
+			for (auto offset : backwardNeighbourOffsets) {
+				u += vcp->processTestMolecule(testSoA, _cells[cellIndex - offset]);
+			}
+			mardyn_assert(not std::isnan(u));
+			energies[i] = u;
+		}
+	}
+}
+
 void LinkedCells::updateInnerMoleculeCaches() {
 	#if defined(_OPENMP)
 	#pragma omp parallel for schedule(static)
@@ -104,6 +104,11 @@ public:
 	 * \code{.xml}
 		<datastructure type="LinkedCells">
 			<cellsInCutoffRadius>INTEGER</cellsInCutoffRadius>
+			<!-- optional: use Verlet cluster lists for the force calculation of inner cell pairs,
+				built with cutoff + skin and rebuilt after at most rebuildFrequency steps
+				or once a molecule moved further than skin/2 (default skin: 0 = disabled) -->
+			<skin>DOUBLE</skin>
+			<rebuildFrequency>INTEGER</rebuildFrequency>
 			<!-- from TraversalTuner: -->
 			<!-- select traversal algorithm
 				possible values are:
@@ -116,8 +121,22 @@ public:
 				- hs         (half shell method)
 				- mp         (mid point method)
 				- nt         (neutral territory method)
+				- task       (c08 base steps as OpenMP tasks, ordered by cost)
+				- auto       (online autotuning, see below)
 			-->
 			<traversalSelector>c08</traversalSelector>
+			<!-- only for traversalSelector auto: every candidate (traversal x cell size factor) is measured for
+				samples time steps (plus one discarded warm-up step) and the fastest one is used until the interval
+				has passed (0 = never), the number of threads changes or the particle density changes by more than
+				densityChangeThreshold (relative). Only traversals with full shell halo exchange can be tuned.
+				Cell size factors >= 1 enlarge the cells, requires cellsInCutoffRadius 1. -->
+			<autotuning>
+				<traversals>c08,c04,sliced,task</traversals>
+				<cellSizeFactors>1,1.5,2</cellSizeFactors>
+				<samples>3</samples>
+				<interval>5000</interval>
+				<densityChangeThreshold>0.2</densityChangeThreshold>
+			</autotuning>
 			<!-- override default block size (2x2x2) for quicksched tasks -->
 			<traversalData type="quicksched">
 				<taskBlockSize>
@@ -191,12 +210,23 @@ public:
 	double get_halo_L(int index) const override;
 
 	double getCutoff() const override { return _cutoffRadius; }
+	double getSkin() const override { return _skin; }
+	unsigned getRebuildFrequency() const override { return _rebuildFrequency; }
 	void setCutoff(double rc) override { _cutoffRadius = rc; }
 
 	void deleteMolecule(ParticleIterator &moleculeIter, const bool& rebuildCaches) override;
 	/* TODO: The particle container should not contain any physics, search a new place for this. */
 	double getEnergy(ParticlePairsHandler* particlePairsHandler, Molecule* m1, CellProcessor& cellProcessor) override;
 
+	/**
+	 * \brief Batched version of getEnergy() for test molecules, which are not part of the container.
+	 * \details If cellProcessor is a VectorizedCellProcessor, the test molecules are evaluated (in parallel) against the
+	 * SoA caches of the cells with the vectorized kernels, so the caches have to be up to date (as after the force
+	 * calculation). Otherwise this falls back to ParticleContainer::getEnergies().
+	 */
+	void getEnergies(ParticlePairsHandler* particlePairsHandler, std::vector<Molecule>& testMolecules,
+			std::vector<double>& energies, CellProcessor& cellProcessor) override;
+
 	int* getBoxWidthInNumCells() {
 		return _boxWidthInNumCells;
 	}
@@ -280,6 +310,12 @@ private:
 
 	void initializeTraversal();
 
+	//! check whether cells enlarged by cellSizeFactor still leave at least two layers of inner cells
+	bool isCellSizeFactorApplicable(double cellSizeFactor) const;
+
+	//! rebuild the cells, if the traversal autotuning asks for a different cell size factor
+	void applyCellSizeFactor();
+
 	//! @brief Calculate neighbour indices.
 	//!
 	//! This method is executed once for the molecule container and not for
@@ -352,6 +388,9 @@ private:
 	double _cellLengthReciprocal[3]; //!< 1.0 / _cellLength, to speed-up particle sorting
 	double _cutoffRadius; //!< RDF/electrostatics cutoff radius
 	unsigned _cellsInCutoff = 1; //!< Cells in cutoff radius -> cells with size cutoff / cellsInCutoff
+	double _cellSizeFactor = 1.0; //!< Cells are enlarged by this factor, chosen by the traversal autotuning
+	double _skin = 0.; //!< skin of the Verlet cluster lists of the VectorizedCellProcessor, 0 = no lists
+	unsigned _rebuildFrequency = 10; //!< maximal number of time steps between two rebuilds of the Verlet cluster lists
 
 	//! @brief True if all Particles are in the right cell
 	//!
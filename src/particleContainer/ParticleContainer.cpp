@@ -43,6 +43,14 @@ bool ParticleContainer::isInBoundingBox(double r[3]) const {
 	}
 }
 
+void ParticleContainer::getEnergies(ParticlePairsHandler* particlePairsHandler, std::vector<Molecule>& testMolecules,
+		std::vector<double>& energies, CellProcessor& cellProcessor) {
+	energies.resize(testMolecules.size());
+	for (size_t i = 0; i < testMolecules.size(); ++i) {
+		energies[i] = getEnergy(particlePairsHandler, &testMolecules[i], cellProcessor);
+	}
+}
+
 int ParticleContainer::getHaloWidthNumCells() {
 	return 0;
 }
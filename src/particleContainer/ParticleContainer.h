@@ -199,12 +199,25 @@ public:
 
 	virtual double getSkin() const {return 0.;}
 
+	//! maximal number of time steps between two rebuilds of neighbour lists (if the container uses any)
+	virtual unsigned getRebuildFrequency() const {return 1;}
+
     /* TODO: Have a look on this */
 	virtual void deleteMolecule(ParticleIterator& moleculeIter, const bool& rebuildCaches) = 0;
 
     /* TODO goes into grand canonical ensemble */
 	virtual double getEnergy(ParticlePairsHandler* particlePairsHandler, Molecule* m1, CellProcessor& cellProcessor) = 0;
 
+	/**
+	 * \brief Potential energies of a batch of test molecules (e.g. Widom test insertions).
+	 * \details The test molecules must not be part of the container, they only provide position, orientation and
+	 * component. The default implementation calls getEnergy() for each of them.
+	 * @param testMolecules molecules to be tested
+	 * @param energies is resized to testMolecules.size() and holds the energy of each test molecule
+	 */
+	virtual void getEnergies(ParticlePairsHandler* particlePairsHandler, std::vector<Molecule>& testMolecules,
+			std::vector<double>& energies, CellProcessor& cellProcessor);
+
 	//! @brief Update the caches of the molecules, that lie in inner cells.
 	//! The caches of boundary and halo cells is not updated.
 	//! This method is used for a multi-step scheme of overlapping mpi communication
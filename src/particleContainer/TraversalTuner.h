@@ -2,10 +2,14 @@
 #define TRAVERSALTUNER_H_
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <utility>
 #include <vector>
 
 #include <utils/Logger.h>
+#include <utils/String_utils.h>
+#include <utils/Timer.h>
 #include <Simulation.h>
 #include "LinkedCellTraversals/CellPairTraversals.h"
 #include "LinkedCellTraversals/QuickschedTraversal.h"
@@ -16,6 +20,7 @@
 #include "LinkedCellTraversals/MidpointTraversal.h"
 #include "LinkedCellTraversals/NeutralTerritoryTraversal.h"
 #include "LinkedCellTraversals/SlicedCellPairTraversal.h"
+#include "LinkedCellTraversals/TaskCellPairTraversal.h"
 
 using Log::global_log;
 
@@ -34,8 +39,9 @@ public:
 		MP       = 5,
 		C08ES    = 6,
 		NT       = 7,
+		TASK     = 8,
 		// quicksched has to be the last traversal!
-		QSCHED   = 8,
+		QSCHED   = 9,
 	};
 
 	TraversalTuner();
@@ -58,6 +64,10 @@ public:
 
 	void traverseCellPairs(CellProcessor &cellProcessor);
 
+	/**
+	 * \brief Traverse the cell pairs with the given traversal, e.g. for resorting the particles.
+	 * \details These traversals are not part of the autotuning measurement, which only measures the force calculation.
+	 */
 	void traverseCellPairs(traversalNames name, CellProcessor &cellProcessor);
 
 	void traverseCellPairsOuter(CellProcessor &cellProcessor);
@@ -72,9 +82,74 @@ public:
 		return selectedTraversal;
 	}
 
-	CellPairTraversals<ParticleCell> *getCurrentOptimalTraversal() { return _optimalTraversal; }
+	//! the traversal is selected here, if no cells were traversed since the last rebuild
+	CellPairTraversals<ParticleCell> *getCurrentOptimalTraversal() {
+		if (not _optimalTraversal) {
+			findOptimalTraversal();
+		}
+		return _optimalTraversal;
+	}
+
+	//! true, if the traversal (and cell size) is chosen by online autotuning (traversalSelector "auto")
+	bool isAutotuning() const {
+		return _autotuning;
+	}
+
+	/**
+	 * \brief Finish the measurement of one time step in autotuning mode.
+	 * \details Has to be called once per time step before the cell structure is updated. All traversals since the
+	 * last call form one sample of the current candidate. Outside of a tuning phase, a new tuning phase is started
+	 * if the tuning interval has passed, or if the particle density or the number of threads changed.
+	 * The first call stems from the initial container update and the traversals up to the second call from the
+	 * initial force calculation, so neither of them is counted as a time step.
+	 * @param density current number density of the particles in the container
+	 */
+	void finishStep(double density);
+
+	/**
+	 * \brief Cell size factor (cell length relative to cutoff / cellsInCutoffRadius) to be used by the container.
+	 * \details Differs from 1 only in autotuning mode, the container has to rebuild its cells if it changes.
+	 */
+	double getCellSizeFactor() const {
+		return _cellSizeFactor;
+	}
+
+	/**
+	 * \brief Skip all candidates with the given cell size factor, as the container can not use it.
+	 */
+	void rejectCellSizeFactor(double cellSizeFactor);
 
 private:
+	//! one candidate of the autotuning
+	struct TuningConfiguration {
+		traversalNames traversal;
+		double cellSizeFactor;
+		//! fastest sample in seconds, infinity if not measured or not applicable
+		double time;
+	};
+
+	static traversalNames traversalFromString(const std::string& name);
+	static std::string traversalToString(traversalNames name);
+
+	void startTuning(const std::string& reason);
+	void applyTuningConfiguration();
+	void nextTuningConfiguration();
+	void finishTuning();
+
+	void startTimer() {
+		if (_autotuning) {
+			_traversalTimer.reset();
+			_traversalTimer.start();
+		}
+	}
+
+	void stopTimer() {
+		if (_autotuning) {
+			_traversalTimer.stop();
+			_stepTime += _traversalTimer.get_etime();
+		}
+	}
+
 	std::vector<CellTemplate>* _cells;
 	std::array<unsigned long, 3> _dims;
 
@@ -85,6 +160,33 @@ private:
 	CellPairTraversals<CellTemplate> *_optimalTraversal;
 
 	unsigned _cellsInCutoff = 1;
+
+	// autotuning settings
+	bool _autotuning = false;
+	std::vector<traversalNames> _candidateTraversals;
+	std::vector<double> _candidateCellSizeFactors;
+	unsigned _tuningSamples = 3;
+	unsigned long _tuningInterval = 5000;
+	double _densityChangeThreshold = 0.2;
+
+	// autotuning state
+	bool _tuning = false;
+	std::vector<TuningConfiguration> _tuningConfigurations;
+	size_t _currentConfiguration = 0;
+	//! samples of the current configuration, including the warm-up sample
+	unsigned _samplesTaken = 0;
+	//! false, if the current candidate can not be used for the current cell dimensions
+	bool _currentApplicable = true;
+	double _cellSizeFactor = 1.0;
+	//! traversal time accumulated during the current time step
+	double _stepTime = 0.0;
+	unsigned long _stepsSinceTuning = 0;
+	//! calls of finishStep which belong to the initialization of the simulation and are not measured
+	unsigned _initializationSteps = 2;
+	double _density = 0.0;
+	double _tunedDensity = 0.0;
+	int _tunedNumThreads = 0;
+	Timer _traversalTimer;
 };
 
 template<class CellTemplate>
@@ -101,6 +203,7 @@ TraversalTuner<CellTemplate>::TraversalTuner() : _cells(nullptr), _dims(), _opti
 	auto *mpData = new MidpointTraversalData;
 	auto *ntData = new NeutralTerritoryTraversalData;
 	auto *c08esData = new C08CellPairTraversalData;
+	auto *taskData = new TaskCellPairTraversalData;
 
 	_traversals = {
 			make_pair(nullptr, origData),
@@ -110,7 +213,8 @@ TraversalTuner<CellTemplate>::TraversalTuner() : _cells(nullptr), _dims(), _opti
 			make_pair(nullptr, hsData),
 			make_pair(nullptr, mpData),
 			make_pair(nullptr, ntData),
-			make_pair(nullptr, c08esData)
+			make_pair(nullptr, c08esData),
+			make_pair(nullptr, taskData)
 	};
 #ifdef QUICKSCHED
 	struct QuickschedTraversalData *quiData = new QuickschedTraversalData;
@@ -137,6 +241,16 @@ void TraversalTuner<CellTemplate>::findOptimalTraversal() {
 
 	_optimalTraversal = _traversals[selectedTraversal].first;
 
+	if (_tuning) {
+		// candidates which do not fit the current cell dimensions are skipped with the next call of finishStep
+		_currentApplicable = isTraversalApplicable(selectedTraversal, _dims)
+				and _cellsInCutoff <= _optimalTraversal->maxCellsInCutoff();
+		if (not _currentApplicable) {
+			_optimalTraversal = _traversals[C08].first;
+		}
+		return;
+	}
+
 	// log traversal
 	if (dynamic_cast<HalfShellTraversal<CellTemplate> *>(_optimalTraversal))
 		global_log->info() << "Using HalfShellTraversal." << endl;
@@ -152,6 +266,8 @@ void TraversalTuner<CellTemplate>::findOptimalTraversal() {
 		global_log->info() << "Using MidpointTraversal." << endl;
 	else if (dynamic_cast<NeutralTerritoryTraversal<CellTemplate> *>(_optimalTraversal))
 		global_log->info() << "Using NeutralTerritoryTraversal." << endl;
+	else if (dynamic_cast<TaskCellPairTraversal<CellTemplate> *>(_optimalTraversal))
+		global_log->info() << "Using TaskCellPairTraversal." << endl;
 	else if (dynamic_cast<QuickschedTraversal<CellTemplate> *>(_optimalTraversal)) {
 		global_log->info() << "Using QuickschedTraversal." << endl;
 #ifndef QUICKSCHED
@@ -179,7 +295,9 @@ void TraversalTuner<CellTemplate>::readXML(XMLfileUnits &xmlconfig) {
 	xmlconfig.getNodeValue("traversalSelector", traversalType);
 	transform(traversalType.begin(), traversalType.end(), traversalType.begin(), ::tolower);
 
-	if (traversalType.find("c08es") != string::npos)
+	if (traversalType.find("auto") != string::npos) {
+		_autotuning = true;
+	} else if (traversalType.find("c08es") != string::npos)
 		selectedTraversal = C08ES;
 	else if (traversalType.find("c08") != string::npos)
 		selectedTraversal = C08;
@@ -197,6 +315,8 @@ void TraversalTuner<CellTemplate>::readXML(XMLfileUnits &xmlconfig) {
 		selectedTraversal = MP;
 	else if (traversalType.find("nt") != string::npos) {
 		selectedTraversal = NT;
+	} else if (traversalType.find("task") != string::npos) {
+		selectedTraversal = TASK;
 	} else {
 		// selector already set in constructor, just print a warning here
 		if (mardyn_get_max_threads() > 1) {
@@ -208,6 +328,52 @@ void TraversalTuner<CellTemplate>::readXML(XMLfileUnits &xmlconfig) {
 
 	_cellsInCutoff = xmlconfig.getNodeValue_int("cellsInCutoffRadius", 1); // This is currently only used for an assert
 
+	if (_autotuning) {
+		if (_cellsInCutoff != 1) {
+			global_log->error() << "Traversal autotuning requires cellsInCutoffRadius 1, but value is chosen as "
+								<< _cellsInCutoff << std::endl;
+			Simulation::exit(45);
+		}
+
+		// only traversals using the full shell halo exchange can be exchanged at runtime
+		std::string traversals = "c08,c04,sliced,task";
+#ifdef QUICKSCHED
+		traversals += ",quicksched";
+#endif
+		std::string cellSizeFactors = "1";
+		xmlconfig.getNodeValue("autotuning/traversals", traversals);
+		xmlconfig.getNodeValue("autotuning/cellSizeFactors", cellSizeFactors);
+		_tuningSamples = xmlconfig.getNodeValue_int("autotuning/samples", _tuningSamples);
+		_tuningInterval = xmlconfig.getNodeValue_int("autotuning/interval", _tuningInterval);
+		_densityChangeThreshold = xmlconfig.getNodeValue_double("autotuning/densityChangeThreshold",
+				_densityChangeThreshold);
+
+		_candidateTraversals.clear();
+		for (const auto& traversal : string_utils::split(traversals, ',')) {
+			_candidateTraversals.push_back(traversalFromString(string_utils::toLowercase(string_utils::trim(traversal))));
+		}
+		_candidateCellSizeFactors.clear();
+		for (const auto& factor : string_utils::split(cellSizeFactors, ',')) {
+			_candidateCellSizeFactors.push_back(std::stod(factor));
+			if (_candidateCellSizeFactors.back() < 1.0) {
+				global_log->error() << "Cell size factors smaller than 1 are not supported by the autotuning: "
+									<< factor << std::endl;
+				Simulation::exit(1);
+			}
+		}
+		if (_candidateTraversals.empty() or _candidateCellSizeFactors.empty() or _tuningSamples < 1) {
+			global_log->error() << "Traversal autotuning needs at least one traversal, one cell size factor and one sample."
+								<< std::endl;
+			Simulation::exit(1);
+		}
+
+		global_log->info() << "Traversal autotuning: traversals " << traversals << ", cell size factors "
+						   << cellSizeFactors << ", " << _tuningSamples << " samples per candidate, retuning every "
+						   << _tuningInterval << " steps or if the density changes by more than "
+						   << _densityChangeThreshold * 100. << "%" << std::endl;
+		startTuning("initial tuning");
+	}
+
 	// workaround for stupid iterator:
 	// since
 	// xmlconfig.changecurrentnode(traversalIterator);
@@ -301,6 +467,9 @@ void TraversalTuner<CellTemplate>::rebuild(std::vector<CellTemplate> &cells, con
 				case traversalNames::C08ES:
 					traversalPointerReference = new C08CellPairTraversal<CellTemplate, true>(cells, dims);
 					break;
+				case traversalNames::TASK:
+					traversalPointerReference = new TaskCellPairTraversal<CellTemplate>(cells, dims);
+					break;
 				case traversalNames::QSCHED: {
 					mardyn_assert((is_base_of<ParticleCellBase, CellTemplate>::value));
 					auto *quiData = dynamic_cast<QuickschedTraversalData *>(traversalData);
@@ -321,14 +490,16 @@ void TraversalTuner<CellTemplate>::traverseCellPairs(CellProcessor &cellProcesso
 	if (not _optimalTraversal) {
 		findOptimalTraversal();
 	}
+	startTimer();
 	_optimalTraversal->traverseCellPairs(cellProcessor);
+	stopTimer();
 }
 
 template<class CellTemplate>
 inline void TraversalTuner<CellTemplate>::traverseCellPairs(traversalNames name,
 		CellProcessor& cellProcessor) {
 	if (name == getSelectedTraversal()) {
-		traverseCellPairs(cellProcessor);
+		getCurrentOptimalTraversal()->traverseCellPairs(cellProcessor);
 	} else {
 		SlicedCellPairTraversal<CellTemplate> slicedTraversal(*_cells, _dims);
 		switch(name) {
@@ -348,7 +519,9 @@ void TraversalTuner<CellTemplate>::traverseCellPairsOuter(CellProcessor &cellPro
 	if (not _optimalTraversal) {
 		findOptimalTraversal();
 	}
+	startTimer();
 	_optimalTraversal->traverseCellPairsOuter(cellProcessor);
+	stopTimer();
 }
 
 template<class CellTemplate>
@@ -357,7 +530,9 @@ void TraversalTuner<CellTemplate>::traverseCellPairsInner(CellProcessor &cellPro
 	if (not _optimalTraversal) {
 		findOptimalTraversal();
 	}
+	startTimer();
 	_optimalTraversal->traverseCellPairsInner(cellProcessor, stage, stageCount);
+	stopTimer();
 }
 
 template<class CellTemplate>
@@ -384,10 +559,192 @@ inline bool TraversalTuner<CellTemplate>::isTraversalApplicable(
 	case ORIGINAL:
 		ret = true;
 		break;
+	case TASK:
+		ret = true;
+		break;
 	default:
 		global_log->warning() << "unknown traversal given in TraversalTuner::isTraversalApplicable, assuming that is applicable" << std::endl;
 	}
 	return ret;
 }
 
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::finishStep(double density) {
+	if (not _autotuning) {
+		return;
+	}
+	_density = density;
+
+	if (_initializationSteps > 0) {
+		--_initializationSteps;
+		_stepTime = 0.0;
+		return;
+	}
+
+	if (_tuning) {
+		TuningConfiguration& configuration = _tuningConfigurations[_currentConfiguration];
+		if (not _currentApplicable) {
+			global_log->info() << "Traversal autotuning: " << traversalToString(configuration.traversal)
+							   << " with cell size factor " << configuration.cellSizeFactor
+							   << " is not applicable, skipping it." << std::endl;
+			nextTuningConfiguration();
+		} else if (_stepTime > 0.0) {
+			// the first sample after a switch is a warm-up (caches, SoAs, Verlet lists) and is discarded
+			++_samplesTaken;
+			if (_samplesTaken > 1) {
+				configuration.time = std::min(configuration.time, _stepTime);
+			}
+			if (_samplesTaken > _tuningSamples) {
+				global_log->info() << "Traversal autotuning: " << traversalToString(configuration.traversal)
+								   << " with cell size factor " << configuration.cellSizeFactor << " took "
+								   << configuration.time << " s per step." << std::endl;
+				nextTuningConfiguration();
+			}
+		}
+	} else {
+		++_stepsSinceTuning;
+		const int numThreads = mardyn_get_max_threads();
+		if (_tuningInterval > 0 and _stepsSinceTuning >= _tuningInterval) {
+			startTuning("tuning interval of " + std::to_string(_tuningInterval) + " steps passed");
+		} else if (numThreads != _tunedNumThreads) {
+			startTuning("number of threads changed from " + std::to_string(_tunedNumThreads) + " to "
+					+ std::to_string(numThreads));
+		} else if (std::abs(density - _tunedDensity) > _densityChangeThreshold * _tunedDensity) {
+			startTuning("density changed from " + std::to_string(_tunedDensity) + " to " + std::to_string(density));
+		}
+	}
+	_stepTime = 0.0;
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::rejectCellSizeFactor(double cellSizeFactor) {
+	global_log->info() << "Traversal autotuning: cell size factor " << cellSizeFactor
+					   << " is not applicable to the container, skipping it." << std::endl;
+	if (_tuning) {
+		while (_tuning and _tuningConfigurations[_currentConfiguration].cellSizeFactor == cellSizeFactor) {
+			nextTuningConfiguration();
+		}
+	} else {
+		// should not happen, as only measured factors can be selected
+		_cellSizeFactor = 1.0;
+	}
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::startTuning(const std::string& reason) {
+	global_log->info() << "Traversal autotuning: starting tuning phase (" << reason << ")." << std::endl;
+
+	// start with the current cell size factor, so that the cells are rebuilt as rarely as possible
+	std::vector<double> cellSizeFactors = _candidateCellSizeFactors;
+	std::stable_partition(cellSizeFactors.begin(), cellSizeFactors.end(),
+			[this](double factor) { return factor == _cellSizeFactor; });
+
+	_tuningConfigurations.clear();
+	for (const double factor : cellSizeFactors) {
+		for (const traversalNames traversal : _candidateTraversals) {
+			_tuningConfigurations.push_back({traversal, factor, std::numeric_limits<double>::infinity()});
+		}
+	}
+	_tuning = true;
+	_currentConfiguration = 0;
+	applyTuningConfiguration();
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::applyTuningConfiguration() {
+	const TuningConfiguration& configuration = _tuningConfigurations[_currentConfiguration];
+	selectedTraversal = configuration.traversal;
+	_cellSizeFactor = configuration.cellSizeFactor;
+	_samplesTaken = 0;
+	_currentApplicable = true;
+	_optimalTraversal = nullptr;
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::nextTuningConfiguration() {
+	++_currentConfiguration;
+	if (_currentConfiguration < _tuningConfigurations.size()) {
+		applyTuningConfiguration();
+	} else {
+		finishTuning();
+	}
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::finishTuning() {
+	auto best = std::min_element(_tuningConfigurations.begin(), _tuningConfigurations.end(),
+			[](const TuningConfiguration& a, const TuningConfiguration& b) { return a.time < b.time; });
+
+	_tuning = false;
+	_stepsSinceTuning = 0;
+	_tunedDensity = _density;
+	_tunedNumThreads = mardyn_get_max_threads();
+	_optimalTraversal = nullptr;
+
+	if (std::isinf(best->time)) {
+		global_log->warning() << "Traversal autotuning: no candidate could be measured, using c08." << std::endl;
+		selectedTraversal = C08;
+		_cellSizeFactor = 1.0;
+		return;
+	}
+	selectedTraversal = best->traversal;
+	_cellSizeFactor = best->cellSizeFactor;
+	global_log->info() << "Traversal autotuning: selected " << traversalToString(selectedTraversal)
+					   << " with cell size factor " << _cellSizeFactor << " (" << best->time << " s per step) for density "
+					   << _tunedDensity << " and " << _tunedNumThreads << " threads." << std::endl;
+}
+
+template<class CellTemplate>
+typename TraversalTuner<CellTemplate>::traversalNames TraversalTuner<CellTemplate>::traversalFromString(
+		const std::string& name) {
+	if (name == "original") {
+		return ORIGINAL;
+	} else if (name == "c08") {
+		return C08;
+	} else if (name == "c04") {
+		return C04;
+	} else if (name == "sliced") {
+		return SLICED;
+	} else if (name == "task") {
+		return TASK;
+	} else if (name == "quicksched") {
+#ifndef QUICKSCHED
+		global_log->error() << "MarDyn was compiled without Quicksched Support. Aborting!" << endl;
+		Simulation::exit(1);
+#endif
+		return QSCHED;
+	}
+	global_log->error() << "Traversal \"" << name << "\" can not be used for autotuning. Possible values: "
+						<< "original, c08, c04, sliced, task, quicksched." << std::endl;
+	Simulation::exit(1);
+	return C08;
+}
+
+template<class CellTemplate>
+std::string TraversalTuner<CellTemplate>::traversalToString(traversalNames name) {
+	switch (name) {
+	case ORIGINAL:
+		return "original";
+	case C08:
+		return "c08";
+	case C04:
+		return "c04";
+	case SLICED:
+		return "sliced";
+	case HS:
+		return "hs";
+	case MP:
+		return "mp";
+	case C08ES:
+		return "c08es";
+	case NT:
+		return "nt";
+	case TASK:
+		return "task";
+	case QSCHED:
+		return "quicksched";
+	}
+	return "unknown";
+}
+
 #endif //TRAVERSALTUNER_H_
@@ -176,6 +176,32 @@ public:
 		_quadrupoles_e.z(index) = orientation[2];
 	}
 
+	/**
+	 * \brief	Overwrite only the positions of the site at index, its constant data (ids, moments) is kept
+	 */
+	void setSitePositions(SiteType st, const size_t index, std::array<vcp_real_calc,3> moleculePos, std::array<vcp_real_calc,3> centerPos) {
+		setTripletCalc(moleculePos, QuantityType::MOL_POSITION, st, index);
+		setTripletCalc(centerPos, QuantityType::CENTER_POSITION, st, index);
+	}
+
+	/**
+	 * \brief	Overwrite only the orientation of the dipole at index
+	 */
+	void setDipoleOrientation(const size_t index, std::array<vcp_real_calc,3> orientation) {
+		_dipoles_e.x(index) = orientation[0];
+		_dipoles_e.y(index) = orientation[1];
+		_dipoles_e.z(index) = orientation[2];
+	}
+
+	/**
+	 * \brief	Overwrite only the orientation of the quadrupole at index
+	 */
+	void setQuadrupoleOrientation(const size_t index, std::array<vcp_real_calc,3> orientation) {
+		_quadrupoles_e.x(index) = orientation[0];
+		_quadrupoles_e.y(index) = orientation[1];
+		_quadrupoles_e.z(index) = orientation[2];
+	}
+
 	void vcp_inline initDistLookupPointers(
 			AlignedArray<vcp_lookupOrMask_single>& centers_dist_lookup,
 			vcp_lookupOrMask_single*& ljc_dist_lookup,
@@ -246,6 +272,16 @@ public:
 
 	}
 
+	/**
+	 * \brief	Zero all force, virial and torque accumulators in one contiguous sweep per array.
+	 */
+	void clearAccumulators() {
+		_centers_f.zero();
+		_centers_V.zero();
+		_dipoles_M.AlignedArray<vcp_real_accum>::zero(0);
+		_quadrupoles_M.AlignedArray<vcp_real_accum>::zero(0);
+	}
+
 	size_t getDynamicSize() const {
 		size_t total = 0;
 
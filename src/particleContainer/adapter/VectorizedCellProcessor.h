@@ -12,8 +12,8 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <string>
 #include "vectorization/SIMD_TYPES.h"
-#include "vectorization/SIMD_VectorizedCellProcessorHelpers.h"
 #include "WrapOpenMP.h"
 
 #include "molecules/MoleculeForwardDeclaration.h"
@@ -21,6 +21,8 @@ class Component;
 class Domain;
 class Comp2Param;
 class CellDataSoA;
+class FullParticleCell;
+class VerletClusterList;
 
 /**
  * \brief Vectorized calculation of the force.
@@ -31,6 +33,73 @@ class VectorizedCellProcessor : public CellProcessor {
 public:
 	typedef std::vector<Component> ComponentList;
 
+	/**
+	 * \brief Floating point precision of the force calculation.
+	 * \details NATIVE uses the intrinsics kernels in the precision the binary was built with (see SIMD_TYPES.h).
+	 * SPSP, SPDP and DPDP (calculation / accumulation in single or double precision) select a compiler-vectorized
+	 * Lennard-Jones kernel, which is instantiated for all three modes, so they can be chosen at runtime.
+	 * The CellDataSoA keeps the precision of the build.
+	 */
+	enum class Precision {
+		NATIVE, SPSP, SPDP, DPDP
+	};
+
+	/**
+	 * \brief Instruction set of the kernels.
+	 * \details The kernels (intrinsics and compiler-vectorized ones) are compiled for the flags of the build (DEFAULT)
+	 * and, where the compiler supports it, additionally for AVX2 and AVX512F (see VectorizedCellProcessorKernel.h).
+	 * The best instruction set supported by the CPU is selected at construction.
+	 */
+	enum class InstructionSet {
+		DEFAULT, AVX2, AVX512F
+	};
+
+	/**
+	 * \brief Parameters of the kernels, independent of the instruction set.
+	 */
+	struct KernelParameters {
+		const std::vector<AlignedArray<vcp_real_calc> >& _eps_sig;
+		const std::vector<AlignedArray<vcp_real_calc> >& _shift6;
+		double _LJCutoffRadiusSquare;
+		double _cutoffRadiusSquare;
+		double _epsRFInvrc3;
+		double _ewaldAlpha;
+	};
+
+	/**
+	 * \brief Per thread data of the kernels. The kernels add their macroscopic values to these sums.
+	 * \details The kernels derive from it to store the data depending on their instruction set.
+	 */
+	struct KernelThreadData {
+		double _upot6lj = 0.0;
+		double _upotXpoles = 0.0;
+		double _virial = 0.0;
+		double _myRF = 0.0;
+	};
+
+	/**
+	 * \brief Kernels compiled for one instruction set.
+	 * \details calculatePairs computes the pairs of a single cell, if soa1 and soa2 are the same, and of a cell pair
+	 * otherwise. calculatePairsLJ does the same with the compiler-vectorized Lennard-Jones kernel of the given
+	 * precision (not NATIVE). calculateTestMolecule returns the potential energy of the molecule in testSoA.
+	 */
+	struct KernelTable {
+		//! instruction set the kernels were actually compiled for
+		InstructionSet instructionSet;
+		//! number of sites per vector of the intrinsics kernels
+		size_t vectorSize;
+		//! name of the intrinsics for the log
+		const char* name;
+		KernelThreadData* (*createThreadData)();
+		void (*deleteThreadData)(KernelThreadData* threadData);
+		void (*calculatePairs)(const KernelParameters& parameters, KernelThreadData& threadData,
+				CellDataSoA& soa1, CellDataSoA& soa2, const VerletClusterList* verletList, bool calculateMacroscopic);
+		void (*calculatePairsLJ)(const KernelParameters& parameters, KernelThreadData& threadData,
+				CellDataSoA& soa1, CellDataSoA& soa2, Precision precision, bool calculateMacroscopic);
+		double (*calculateTestMolecule)(const KernelParameters& parameters, KernelThreadData& threadData,
+				CellDataSoA& testSoA, CellDataSoA& soa);
+	};
+
 	VectorizedCellProcessor& operator=(const VectorizedCellProcessor&) = delete;
 
 	/**
@@ -70,6 +139,72 @@ public:
 	 */
 	void endTraversal();
 
+	/**
+	 * \brief Enable Verlet cluster lists (see VerletClusterList) for pairs of non-halo cells.
+	 * \param skin skin added to both cutoff radii when building the lists, 0 disables the lists
+	 * \param rebuildFrequency number of time steps after which the lists are rebuilt at the latest
+	 */
+	void setVerletListParameters(double skin, unsigned rebuildFrequency);
+
+	/**
+	 * \brief Largest alpha * cutoff radius supported by setEwaldSplitting.
+	 * \details The erfc of the charge kernel is accurate to 2e-14 (relative) up to this argument.
+	 * erfc(6) = 2.2e-17, so any attainable real space tolerance needs a smaller value.
+	 */
+	static constexpr double maxEwaldAlphaCutoff = 6.0;
+
+	/**
+	 * \brief Compute only the real space part erfc(alpha r) / r of the charge-charge interactions.
+	 * \details Used with an Ewald method, which provides the rest (see spme::SmoothParticleMeshEwald). alpha = 0 restores
+	 * the plain Coulomb interaction. Interactions involving dipoles or quadrupoles are not affected.
+	 * Exits, if alpha is negative or alpha times the cutoff radius exceeds maxEwaldAlphaCutoff.
+	 */
+	void setEwaldSplitting(double alpha);
+
+	double getEwaldSplitting() const {
+		return _ewaldAlpha;
+	}
+
+	/**
+	 * \brief Potential energy of the test molecule in testSoA with all molecules of cell.
+	 * \details testSoA has to contain exactly one molecule, which is not part of cell (e.g. a Widom test insertion).
+	 * Only the energy is computed: neither cell, nor the macroscopic values of the current traversal are modified,
+	 * so this may be called concurrently by several threads for the same cell.
+	 */
+	double processTestMolecule(CellDataSoA& testSoA, ParticleCell& cell);
+
+	/**
+	 * \brief Select the precision of the force calculation.
+	 * \details All modes but NATIVE support Lennard-Jones centers only and do not use Verlet cluster lists.
+	 * Test insertions always use NATIVE.
+	 */
+	void setPrecision(Precision precision);
+
+	Precision getPrecision() const {
+		return _precision;
+	}
+
+	/**
+	 * \brief Select the instruction set of the kernels.
+	 * \details Instruction sets not supported by the CPU are replaced by the best supported one.
+	 */
+	void setInstructionSet(InstructionSet instructionSet);
+
+	//! \brief Instruction set the selected kernels were compiled for, which may exceed the requested one.
+	InstructionSet getInstructionSet() const {
+		return _kernels->instructionSet;
+	}
+
+	//! \brief Best instruction set of the kernels supported by the CPU (cpuid).
+	static InstructionSet detectInstructionSet();
+
+	static std::string instructionSetToString(InstructionSet instructionSet);
+
+	//! \brief Parse "native", "SPSP", "SPDP" or "DPDP" (case insensitive), exits on unknown values.
+	static Precision precisionFromString(const std::string& precision);
+
+	static std::string precisionToString(Precision precision);
+
 
 private:
 	/**
@@ -137,186 +272,60 @@ private:
 	 */
 	double _myRF;
 
-	struct VLJCPThreadData {
-	public:
-		VLJCPThreadData(): _ljc_dist_lookup(nullptr), _charges_dist_lookup(nullptr), _dipoles_dist_lookup(nullptr), _quadrupoles_dist_lookup(nullptr){
-			_upot6ljV.resize(_numVectorElements);
-			_upotXpolesV.resize(_numVectorElements);
-			_virialV.resize(_numVectorElements);
-			_myRFV.resize(_numVectorElements);
-
-			for (size_t j = 0; j < _numVectorElements; ++j) {
-				_upot6ljV[j] = 0.0;
-				_upotXpolesV[j] = 0.0;
-				_virialV[j] = 0.0;
-				_myRFV[j] = 0.0;
-			}
-		}
-
-		/**
-		 * \brief array, that stores the dist_lookup.
-		 * For all vectorization methods, that utilize masking, this stores masks.
-		 * To utilize the gather operations of the KNL architecture, the dist_lookup is able to store the indices of the required particles.
-		 */
-		AlignedArray<vcp_lookupOrMask_single> _centers_dist_lookup;
-
-		/**
-		 * \brief pointer to the starting point of the dist_lookup of the lennard jones particles.
-		 */
-		vcp_lookupOrMask_single* _ljc_dist_lookup;
-
-		/**
-		 * \brief pointer to the starting point of the dist_lookup of the charge particles.
-		 */
-		vcp_lookupOrMask_single* _charges_dist_lookup;
-
-		/**
-		 * \brief pointer to the starting point of the dist_lookup of the dipole particles.
-		 */
-		vcp_lookupOrMask_single* _dipoles_dist_lookup;
-
-		/**
-		 * \brief pointer to the starting point of the dist_lookup of the quadrupole particles.
-		 */
-		vcp_lookupOrMask_single* _quadrupoles_dist_lookup;
-
-		AlignedArray<vcp_real_accum> _upot6ljV, _upotXpolesV, _virialV, _myRFV;
-	};
+	/**
+	 * \brief Ewald parameter of the real space part of the charge-charge interaction, 0 for plain Coulomb.
+	 */
+	double _ewaldAlpha;
+
+	/**
+	 * \brief Skin of the Verlet cluster lists, 0 if they are not used.
+	 */
+	double _verletSkin;
+
+	/**
+	 * \brief Maximal age (in time steps) of a Verlet cluster list.
+	 */
+	unsigned _verletRebuildFrequency;
 
-	std::vector<VLJCPThreadData *> _threadData;
-
-	static const size_t _numVectorElements = VCP_VEC_SIZE;
-	size_t _numThreads;
-
-	template<bool calculateMacroscopic>
-	inline void _loopBodyLJ(
-			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
-			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
-			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
-			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
-			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
-			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
-			RealAccumVec& sum_upot6lj, RealAccumVec& sum_virial,
-			const MaskCalcVec& forceMask,
-			const RealCalcVec& eps_24, const RealCalcVec& sig2,
-			const RealCalcVec& shift6);
-
-	template<bool calculateMacroscopic>
-	inline void _loopBodyCharge(
-		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
-		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
-		const RealCalcVec& qii,
-		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
-		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
-		const RealCalcVec& qjj,
-		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
-		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
-		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
-		const MaskCalcVec& forceMask);
-
-	template<bool calculateMacroscopic>
-	inline void _loopBodyChargeDipole(
-		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
-		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
-		const RealCalcVec& q,
-		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
-		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
-		const RealCalcVec& e_x, const RealCalcVec& e_y, const RealCalcVec& e_z,
-		const RealCalcVec& p,
-		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
-		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
-		RealAccumVec& M_x, RealAccumVec& M_y, RealAccumVec& M_z,
-		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
-		const MaskCalcVec& forceMask);
-
-	template<bool calculateMacroscopic>
-	inline void _loopBodyDipole(
-		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
-		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
-		const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
-		const RealCalcVec& pii,
-		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
-		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
-		const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
-		const RealCalcVec& pjj,
-		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
-		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
-		RealAccumVec& M1_x, RealAccumVec& M1_y, RealAccumVec& M1_z,
-		RealAccumVec& M2_x, RealAccumVec& M2_y, RealAccumVec& M2_z,
-		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial, RealAccumVec& sum_myRF,
-		const MaskCalcVec& forceMask,
-		const RealCalcVec& epsRFInvrc3);
-
-	template<bool calculateMacroscopic>
-	inline void _loopBodyChargeQuadrupole(
-		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
-		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
-		const RealCalcVec& q,
-		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
-		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
-		const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
-		const RealCalcVec& m,
-		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
-		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
-		RealAccumVec& M_x, RealAccumVec& M_y, RealAccumVec& M_z,
-		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
-		const MaskCalcVec& forceMask);
-
-	template<bool calculateMacroscopic>
-	inline void _loopBodyDipoleQuadrupole(
-		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
-		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
-		const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
-		const RealCalcVec& p,
-		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
-		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
-		const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
-		const RealCalcVec& m,
-		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
-		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
-		RealAccumVec& M1_x, RealAccumVec& M1_y, RealAccumVec& M1_z,
-		RealAccumVec& M2_x, RealAccumVec& M2_y, RealAccumVec& M2_z,
-		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
-		const MaskCalcVec& forceMask);
-
-	template<bool calculateMacroscopic>
-	inline void _loopBodyQuadrupole(
-		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
-		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
-		const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
-		const RealCalcVec& mii,
-		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
-		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
-		const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
-		const RealCalcVec& mjj,
-		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
-		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
-		RealAccumVec& Mii_x, RealAccumVec& Mii_y, RealAccumVec& Mii_z,
-		RealAccumVec& Mjj_x, RealAccumVec& Mjj_y, RealAccumVec& Mjj_z,
-		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
-		const MaskCalcVec& forceMask);
-
-	/**
-	 * \brief Force calculation with abstraction of cell pairs.
-	 * \details The differences between single cell and cell pair calculation<br>
-	 * have been moved into two policy class templates.<br>
-	 * <br>
-	 * The ForcePolicy class must provide the following methods:<br>
-	 * <br>
-	 * static size_t InitJ(size_t i);<br>
-	 * Returns the value which j is to be initialized as in the inner loop<br>
-	 * depending on the vectorization method.<br>
-	 * <br>
-	 * If the code is to be vectorized:<br>
-	 * static DoubleVec GetForceMask(DoubleVec m_r2, DoubleVec rc2);<br>
-	 * Returns the mask indicating which pairs to calculate in the vectorized code.<br>
-	 * <br>
-	 * The boolean CalculateMacroscopic should specify, whether macroscopic values are to be calculated or not.
-	 * <br>
-	 * The class MaskGatherChooser is a class, that specifies the used loading,storing and masking routines.
-	 */
-	template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser>
-	void _calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2);
+	/**
+	 * \brief Precision of the force calculation, see setPrecision().
+	 */
+	Precision _precision;
+
+	/**
+	 * \brief Kernels of the selected instruction set, see setInstructionSet().
+	 */
+	const KernelTable* _kernels;
+
+	/**
+	 * \brief Data of the kernels for each thread, created by _kernels.
+	 */
+	std::vector<KernelThreadData*> _threadData;
+
+	//! kernels compiled for the flags of the build and for AVX2 and AVX512F (VectorizedCellProcessorKernel*.cpp)
+	static const KernelTable& kernelTableDefault();
+	static const KernelTable& kernelTableAVX2();
+	static const KernelTable& kernelTableAVX512F();
+
+	//! kernels for instructionSet, if they were compiled for it, otherwise those of the build
+	static const KernelTable& kernelTable(InstructionSet instructionSet);
+
+	//! (re)create the thread data with _kernels
+	void createThreadData();
+	void deleteThreadData();
+
+	KernelParameters kernelParameters() const;
+
+	/**
+	 * \brief Get an up-to-date Verlet cluster list for the pair (c1, c2) stored in c1, rebuild it if necessary.
+	 */
+	const VerletClusterList* getVerletClusterList(FullParticleCell& c1, FullParticleCell& c2);
+
+	/**
+	 * \brief Call the kernel for _precision on a single cell (&soa1 == &soa2) or a cell pair.
+	 */
+	void _calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2, bool calculateMacroscopic,
+			const VerletClusterList* verletList = nullptr);
 
 }; /* end of class VectorizedCellProcessor */
 
@@ -0,0 +1,3163 @@
+/*
+ * VectorizedCellProcessorKernel.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_PARTICLECONTAINER_ADAPTER_VECTORIZEDCELLPROCESSORKERNEL_H_
+#define SRC_PARTICLECONTAINER_ADAPTER_VECTORIZEDCELLPROCESSORKERNEL_H_
+
+#include "VectorizedCellProcessor.h"
+#include "CellDataSoA.h"
+#include "VerletClusterList.h"
+#include "WrapOpenMP.h"
+#include "vectorization/SIMD_TYPES.h"
+#include "vectorization/SIMD_VectorizedCellProcessorHelpers.h"
+#include "vectorization/MaskGatherChooser.h"
+
+namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
+
+/**
+ * \brief Force kernels of the VectorizedCellProcessor for the instruction set of the including translation unit.
+ * \details This header is included by one translation unit per instruction set (VectorizedCellProcessorKernel*.cpp),
+ * each compiled with its own flags. All vector types live in the inline namespace VCP_ISA_NAMESPACE, so the
+ * instantiations do not collide; the VectorizedCellProcessor calls them through the KernelTable returned by table().
+ * Nothing in here may be initialized at program start, since the CPU may not support the instruction set.
+ * Inline functions of ISA independent classes used here (e.g. AlignedArray) may be emitted with the flags of these
+ * translation units, too. The linker keeps the first definition, so they are linked after all other objects.
+ * If the flags of the build already imply the instruction set of a kernel translation unit, both define the same
+ * (inline) functions.
+ */
+class VectorizedCellProcessorKernel {
+public:
+	typedef VectorizedCellProcessor::KernelParameters KernelParameters;
+	typedef VectorizedCellProcessor::KernelThreadData KernelThreadData;
+	typedef VectorizedCellProcessor::KernelTable KernelTable;
+	typedef VectorizedCellProcessor::Precision Precision;
+
+	//! \brief Thread data of the kernels: the macroscopic sums and the dist lookup of the instruction set.
+	struct ThreadData : public KernelThreadData {
+		ThreadData() : _ljc_dist_lookup(nullptr), _charges_dist_lookup(nullptr), _dipoles_dist_lookup(nullptr),
+				_quadrupoles_dist_lookup(nullptr) {}
+
+		/**
+		 * \brief array, that stores the dist_lookup.
+		 * For all vectorization methods, that utilize masking, this stores masks.
+		 * To utilize the gather operations of the KNL architecture, the dist_lookup is able to store the indices of the required particles.
+		 */
+		AlignedArray<vcp_lookupOrMask_single> _centers_dist_lookup;
+
+		/**
+		 * \brief pointer to the starting point of the dist_lookup of the lennard jones particles.
+		 */
+		vcp_lookupOrMask_single* _ljc_dist_lookup;
+
+		/**
+		 * \brief pointer to the starting point of the dist_lookup of the charge particles.
+		 */
+		vcp_lookupOrMask_single* _charges_dist_lookup;
+
+		/**
+		 * \brief pointer to the starting point of the dist_lookup of the dipole particles.
+		 */
+		vcp_lookupOrMask_single* _dipoles_dist_lookup;
+
+		/**
+		 * \brief pointer to the starting point of the dist_lookup of the quadrupole particles.
+		 */
+		vcp_lookupOrMask_single* _quadrupoles_dist_lookup;
+	};
+
+	//! \brief Kernels of this instruction set, see VectorizedCellProcessor::KernelTable.
+	static const KernelTable& table();
+
+private:
+	VectorizedCellProcessorKernel(const KernelParameters& parameters, KernelThreadData& threadData) :
+			_eps_sig(parameters._eps_sig), _shift6(parameters._shift6),
+			_LJCutoffRadiusSquare(parameters._LJCutoffRadiusSquare), _cutoffRadiusSquare(parameters._cutoffRadiusSquare),
+			_epsRFInvrc3(parameters._epsRFInvrc3), _ewaldAlpha(parameters._ewaldAlpha),
+			_threadData(static_cast<ThreadData&>(threadData)),
+			zero(RealCalcVec::zero()), one(RealCalcVec::set1(1.0)), two(RealCalcVec::set1(2.0)),
+			three(RealCalcVec::set1(3.0)), four(RealCalcVec::set1(4.0)), five(RealCalcVec::set1(5.0)),
+			six(RealCalcVec::set1(6.0)), ten(RealCalcVec::set1(10.0)), _05(RealCalcVec::set1(0.5)),
+			_075(RealCalcVec::set1(0.75)), _1pt5(RealCalcVec::set1(1.5)), _15(RealCalcVec::set1(15.0)) {}
+
+	static KernelThreadData* createThreadData();
+
+	static void deleteThreadData(KernelThreadData* threadData);
+
+	static void calculatePairs(const KernelParameters& parameters, KernelThreadData& threadData,
+			CellDataSoA& soa1, CellDataSoA& soa2, const VerletClusterList* verletList, bool calculateMacroscopic);
+
+	static void calculatePairsLJ(const KernelParameters& parameters, KernelThreadData& threadData,
+			CellDataSoA& soa1, CellDataSoA& soa2, Precision precision, bool calculateMacroscopic);
+
+	static double calculateTestMolecule(const KernelParameters& parameters, KernelThreadData& threadData,
+			CellDataSoA& testSoA, CellDataSoA& soa);
+
+	//! _calculatePairs for the policies of a single cell (&soa1 == &soa2) or a cell pair
+	template<bool CalculateMacroscopic, bool EwaldSplitting>
+	void _calculatePairsCells(CellDataSoA& soa1, CellDataSoA& soa2, const VerletClusterList* verletList);
+
+	//! _calculatePairsLJ for the policies of a single cell (&soa1 == &soa2) or a cell pair
+	template<typename calc_t, typename accum_t, bool CalculateMacroscopic>
+	void _calculatePairsLJCells(CellDataSoA& soa1, CellDataSoA& soa2);
+
+	/**
+	 * \brief Epsilon and sigma for pairs of LJcenters, see VectorizedCellProcessor.
+	 */
+	const std::vector<AlignedArray<vcp_real_calc> >& _eps_sig;
+
+	/**
+	 * \brief Shift for pairs of LJcenters, see VectorizedCellProcessor.
+	 */
+	const std::vector<AlignedArray<vcp_real_calc> >& _shift6;
+
+	const double _LJCutoffRadiusSquare;
+	const double _cutoffRadiusSquare;
+	const double _epsRFInvrc3;
+	const double _ewaldAlpha;
+
+	ThreadData& _threadData;
+
+	// constants of the loop bodies, members instead of globals, so that they are only set up on CPUs running the kernel
+	//const RealCalcVec minus_one; //currently not used, would produce warning
+	const RealCalcVec zero;
+	const RealCalcVec one;
+	const RealCalcVec two;
+	const RealCalcVec three;
+	const RealCalcVec four;
+	const RealCalcVec five;
+	const RealCalcVec six;
+	const RealCalcVec ten;
+	const RealCalcVec _05;
+	const RealCalcVec _075;
+	const RealCalcVec _1pt5;
+	const RealCalcVec _15;
+
+	template<bool calculateMacroscopic>
+	inline void _loopBodyLJ(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& sum_upot6lj, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask,
+			const RealCalcVec& eps_24, const RealCalcVec& sig2,
+			const RealCalcVec& shift6);
+
+	//! exp(-x) for 0 <= x <= maxEwaldAlphaCutoff^2, from the intrinsics available for all vector types
+	static inline RealCalcVec _expMinus(const RealCalcVec& x);
+
+	//! exp(x^2) erfc(x) for 0 <= x <= maxEwaldAlphaCutoff
+	static inline RealCalcVec _erfcExpPlus(const RealCalcVec& x);
+
+	//! ewaldSplitting selects the real space part of the Ewald sum (see setEwaldSplitting) over plain Coulomb
+	template<bool calculateMacroscopic, bool ewaldSplitting>
+	inline void _loopBodyCharge(
+		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+		const RealCalcVec& qii,
+		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+		const RealCalcVec& qjj,
+		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+		const MaskCalcVec& forceMask);
+
+	template<bool calculateMacroscopic>
+	inline void _loopBodyChargeDipole(
+		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+		const RealCalcVec& q,
+		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+		const RealCalcVec& e_x, const RealCalcVec& e_y, const RealCalcVec& e_z,
+		const RealCalcVec& p,
+		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+		RealAccumVec& M_x, RealAccumVec& M_y, RealAccumVec& M_z,
+		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+		const MaskCalcVec& forceMask);
+
+	template<bool calculateMacroscopic>
+	inline void _loopBodyDipole(
+		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+		const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
+		const RealCalcVec& pii,
+		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+		const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
+		const RealCalcVec& pjj,
+		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+		RealAccumVec& M1_x, RealAccumVec& M1_y, RealAccumVec& M1_z,
+		RealAccumVec& M2_x, RealAccumVec& M2_y, RealAccumVec& M2_z,
+		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial, RealAccumVec& sum_myRF,
+		const MaskCalcVec& forceMask,
+		const RealCalcVec& epsRFInvrc3);
+
+	template<bool calculateMacroscopic>
+	inline void _loopBodyChargeQuadrupole(
+		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+		const RealCalcVec& q,
+		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+		const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
+		const RealCalcVec& m,
+		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+		RealAccumVec& M_x, RealAccumVec& M_y, RealAccumVec& M_z,
+		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+		const MaskCalcVec& forceMask);
+
+	template<bool calculateMacroscopic>
+	inline void _loopBodyDipoleQuadrupole(
+		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+		const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
+		const RealCalcVec& p,
+		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+		const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
+		const RealCalcVec& m,
+		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+		RealAccumVec& M1_x, RealAccumVec& M1_y, RealAccumVec& M1_z,
+		RealAccumVec& M2_x, RealAccumVec& M2_y, RealAccumVec& M2_z,
+		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+		const MaskCalcVec& forceMask);
+
+	template<bool calculateMacroscopic>
+	inline void _loopBodyQuadrupole(
+		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+		const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
+		const RealCalcVec& mii,
+		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+		const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
+		const RealCalcVec& mjj,
+		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+		RealAccumVec& Mii_x, RealAccumVec& Mii_y, RealAccumVec& Mii_z,
+		RealAccumVec& Mjj_x, RealAccumVec& Mjj_y, RealAccumVec& Mjj_z,
+		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+		const MaskCalcVec& forceMask);
+
+	/**
+	 * \brief Force calculation with abstraction of cell pairs.
+	 * \details The differences between single cell and cell pair calculation<br>
+	 * have been moved into two policy class templates.<br>
+	 * <br>
+	 * The ForcePolicy class must provide the following methods:<br>
+	 * <br>
+	 * static size_t InitJ(size_t i);<br>
+	 * Returns the value which j is to be initialized as in the inner loop<br>
+	 * depending on the vectorization method.<br>
+	 * <br>
+	 * If the code is to be vectorized:<br>
+	 * static DoubleVec GetForceMask(DoubleVec m_r2, DoubleVec rc2);<br>
+	 * Returns the mask indicating which pairs to calculate in the vectorized code.<br>
+	 * <br>
+	 * The boolean CalculateMacroscopic should specify, whether macroscopic values are to be calculated or not.
+	 * <br>
+	 * The class MaskGatherChooser is a class, that specifies the used loading,storing and masking routines.
+	 * <br>
+	 * EwaldSplitting has to be true if and only if _ewaldAlpha > 0, the check is kept out of the inner loops.
+	 */
+	template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser, bool EwaldSplitting>
+	void _calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2, const VerletClusterList* verletList = nullptr);
+
+	/**
+	 * \brief Lennard-Jones force calculation with calculation type calc_t and accumulation type accum_t.
+	 * \details Plain loops over the centers, vectorized by the compiler (omp simd) for the flags of the translation unit.
+	 * Differences of the positions are taken in the precision of the SoA, results are accumulated into the SoA and the
+	 * thread data. The ForcePolicy has to provide FirstJ(i) and Condition(m_r2, rc2).
+	 */
+	template<typename calc_t, typename accum_t, class ForcePolicy, bool CalculateMacroscopic>
+	vcp_inline void _calculatePairsLJ(CellDataSoA & soa1, CellDataSoA & soa2);
+
+}; /* end of class VectorizedCellProcessorKernel */
+
+
+	template<bool calculateMacroscopic>
+	vcp_inline void VectorizedCellProcessorKernel :: _loopBodyLJ(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& sum_upot6lj, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask,
+			const RealCalcVec& eps_24, const RealCalcVec& sig2,
+			const RealCalcVec& shift6)
+	{
+		const RealCalcVec c_dx = r1_x - r2_x;
+		const RealCalcVec c_dy = r1_y - r2_y;
+		const RealCalcVec c_dz = r1_z - r2_z;
+
+		const RealCalcVec c_r2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+
+		const RealCalcVec r2_inv = RealCalcVec::fastReciprocal_mask(c_r2, forceMask);
+
+		const RealCalcVec lj2 = sig2 * r2_inv;//1FP (scale)
+		const RealCalcVec lj4 = lj2 * lj2;//1FP (scale)
+		const RealCalcVec lj6 = lj4 * lj2;//1FP (scale)
+		const RealCalcVec lj12 = lj6 * lj6;//1FP (scale)
+		const RealCalcVec lj12m6 = lj12 - lj6;//1FP (scale)
+
+		const RealCalcVec eps24r2inv = eps_24 * r2_inv;//1FP (scale)
+		const RealCalcVec lj12lj12m6 = lj12 + lj12m6;//1FP (scale)
+		const RealCalcVec scale = eps24r2inv * lj12lj12m6;//1FP (scale)
+
+		f_x = c_dx * scale;//1FP (apply scale)
+		f_y = c_dy * scale;//1FP (apply scale)
+		f_z = c_dz * scale;//1FP (apply scale)
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;//1FP (virial) (does not count)
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;//1FP (virial) (does not count)
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;//1FP (virial) (does not count)
+
+		V_x = RealAccumVec::convertCalcToAccum(m_dx * f_x);//1FP (virial)
+		V_y = RealAccumVec::convertCalcToAccum(m_dy * f_y);//1FP (virial)
+		V_z = RealAccumVec::convertCalcToAccum(m_dz * f_z);//1FP (virial)
+
+		// Check if we have to add the macroscopic values up
+		if (calculateMacroscopic) {
+
+			const RealCalcVec upot_sh = RealCalcVec::fmadd(eps_24, lj12m6, shift6); //2 FP upot				//shift6 is not masked -> we have to mask upot_shifted
+			const RealCalcVec upot_masked = RealCalcVec::apply_mask(upot_sh, forceMask); //mask it
+			const RealAccumVec upot_accum = RealAccumVec::convertCalcToAccum(upot_masked);
+
+			sum_upot6lj = sum_upot6lj + upot_accum;//1FP (sum macro)
+
+			sum_virial = sum_virial + V_x + V_y + V_z;//1 FP (sum macro) + 2 FP (virial)
+		}
+	}
+
+
+	vcp_inline RealCalcVec VectorizedCellProcessorKernel :: _expMinus(const RealCalcVec& x) {
+		// exp(-x) = exp(-x / 64)^64, the Taylor series of degree 16 of exp(-x / 64) keeps the relative error
+		// below 2e-14 for x <= maxEwaldAlphaCutoff^2 = 36
+		const RealCalcVec y = x * RealCalcVec::set1(-1.0 / 64.0);
+		RealCalcVec e = RealCalcVec::set1(1.0 / 20922789888000.0);
+		const double invFactorials[] = {1.0 / 1307674368000.0, 1.0 / 87178291200.0, 1.0 / 6227020800.0,
+				1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0, 1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0,
+				1.0 / 720.0, 1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5, 1.0, 1.0};
+		for (double c : invFactorials) {
+			e = RealCalcVec::fmadd(e, y, RealCalcVec::set1(c));
+		}
+		for (int i = 0; i < 6; ++i) {
+			e = e * e;
+		}
+		return e;
+	}
+
+	vcp_inline RealCalcVec VectorizedCellProcessorKernel :: _erfcExpPlus(const RealCalcVec& x) {
+		// Chebyshev series of exp(x^2) erfc(x) in u = (16 / (2 + x) - 5) / 3, which maps [0, 6] to [-1, 1],
+		// evaluated by Clenshaw's recurrence. Relative error below 2e-14 for 0 <= x <= maxEwaldAlphaCutoff.
+		static const double coefficients[] = {
+				4.62651061701537621e-01, 4.45944590537599867e-01, 8.39224456318148990e-02, 7.75945373481469589e-03,
+				-1.88082761534561078e-04, -9.37209106206350168e-05, 2.98349417065775332e-06, 1.41105459744464419e-06,
+				-1.28427777616920642e-07, -1.82804603771923232e-08, 4.35903206148312736e-09, -4.98940964698906289e-11,
+				-9.75325758154167606e-11, 1.41504888080247454e-11, 4.99405177907897958e-13, -4.59485515409378588e-13,
+				6.15815795115718682e-14, 2.57389127863192650e-15, -2.29825530248313811e-15, 3.58395128585758552e-16};
+		const int numCoefficients = sizeof(coefficients) / sizeof(coefficients[0]);
+
+		const RealCalcVec u = RealCalcVec::fmsub(RealCalcVec::set1(16.0 / 3.0),
+				RealCalcVec::set1(1.0) / (RealCalcVec::set1(2.0) + x), RealCalcVec::set1(5.0 / 3.0));
+		const RealCalcVec twoU = u + u;
+		RealCalcVec b1 = RealCalcVec::zero();
+		RealCalcVec b2 = RealCalcVec::zero();
+		for (int j = numCoefficients - 1; j > 0; --j) {
+			const RealCalcVec tmp = b1;
+			b1 = RealCalcVec::fmsub(twoU, b1, b2) + RealCalcVec::set1(coefficients[j]);
+			b2 = tmp;
+		}
+		return RealCalcVec::fmsub(u, b1, b2) + RealCalcVec::set1(coefficients[0]);
+	}
+
+	template<bool calculateMacroscopic, bool ewaldSplitting>
+	vcp_inline void VectorizedCellProcessorKernel :: _loopBodyCharge(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& qii,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			const RealCalcVec& qjj,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask)
+	{
+		const RealCalcVec c_dx = r1_x - r2_x;
+		const RealCalcVec c_dy = r1_y - r2_y;
+		const RealCalcVec c_dz = r1_z - r2_z;//fma not possible since they will be reused...
+
+		const RealCalcVec c_dr2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+
+		const RealCalcVec c_dr2_inv = RealCalcVec::fastReciprocal_mask(c_dr2, forceMask);//masked
+#if VCP_VEC_TYPE == VCP_VEC_AVX2 or \
+	VCP_VEC_TYPE == VCP_VEC_KNL or \
+	VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+	    const RealCalcVec c_dr_inv = RealCalcVec::fastReciprocSqrt_mask(c_dr2, forceMask);//masked
+#else
+	    const RealCalcVec c_dr_inv = RealCalcVec::sqrt(c_dr2_inv);//masked
+#endif
+
+		const RealCalcVec q1q2per4pie0 = qii * qjj;
+		RealCalcVec upot, fac;
+		if (ewaldSplitting) {
+			// real space part of the Ewald sum: erfc(alpha r) / r. exp(-(alpha r)^2) is shared by erfc and
+			// its derivative, so the force is the derivative of the potential up to the error of the erfc series.
+			const RealCalcVec alpha = RealCalcVec::set1(static_cast<vcp_real_calc>(_ewaldAlpha));
+			// the distances of the masked lanes may be infinite, so mask alpha r explicitly
+			const RealCalcVec alpha_r = RealCalcVec::apply_mask(alpha * (c_dr2 * c_dr_inv), forceMask);
+			const RealCalcVec expm = _expMinus(alpha_r * alpha_r);
+			const RealCalcVec erfc = _erfcExpPlus(alpha_r) * expm;
+
+			const RealCalcVec twoAlphaPerSqrtPi = RealCalcVec::set1(static_cast<vcp_real_calc>(_ewaldAlpha * M_2_SQRTPI));
+			upot = q1q2per4pie0 * c_dr_inv * erfc;//masked
+			fac = RealCalcVec::fmadd(q1q2per4pie0 * twoAlphaPerSqrtPi, expm, upot) * c_dr2_inv;//masked
+		} else {
+			upot = q1q2per4pie0 * c_dr_inv;//masked
+			fac = upot * c_dr2_inv;//masked
+		}
+
+		f_x = c_dx * fac;
+		f_y = c_dy * fac;
+		f_z = c_dz * fac;
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		V_x = RealAccumVec::convertCalcToAccum(m_dx * f_x);
+		V_y = RealAccumVec::convertCalcToAccum(m_dy * f_y);
+		V_z = RealAccumVec::convertCalcToAccum(m_dz * f_z);
+		// Check if we have to add the macroscopic values up
+		if (calculateMacroscopic) {
+			RealAccumVec upot_accum = RealAccumVec::convertCalcToAccum(upot);
+			sum_upotXpoles = sum_upotXpoles + upot_accum;
+			sum_virial = sum_virial + V_x + V_y + V_z;//DoubleVec::scal_prod(m_dx, m_dy, m_dz, f_x, f_y, f_z);
+		}
+	}
+
+	template<bool calculateMacroscopic>
+	vcp_inline void VectorizedCellProcessorKernel :: _loopBodyChargeDipole(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& q,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			const RealCalcVec& e_x, const RealCalcVec& e_y, const RealCalcVec& e_z,
+			const RealCalcVec& p,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& M_x, RealAccumVec& M_y, RealAccumVec& M_z,
+			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask)
+	{
+		const RealCalcVec dx = r1_x - r2_x;
+		const RealCalcVec dy = r1_y - r2_y;
+		const RealCalcVec dz = r1_z - r2_z;
+
+		const RealCalcVec dr2 = RealCalcVec::scal_prod(dx, dy, dz, dx, dy, dz);
+
+		const RealCalcVec dr2_inv = RealCalcVec::fastReciprocal_mask(dr2, forceMask);
+#if VCP_VEC_TYPE == VCP_VEC_AVX2 or \
+	VCP_VEC_TYPE == VCP_VEC_KNL or \
+	VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+		const RealCalcVec dr_inv = RealCalcVec::fastReciprocSqrt_mask(dr2, forceMask);
+#else
+	    const RealCalcVec dr_inv = RealCalcVec::sqrt(dr2_inv);
+#endif
+		const RealCalcVec dr3_inv = dr2_inv * dr_inv;
+
+		const RealCalcVec re = RealCalcVec::scal_prod(dx, dy, dz, e_x, e_y, e_z);
+
+		const RealCalcVec qpper4pie0 = q * p;
+		const RealCalcVec qpper4pie0dr3 = qpper4pie0 * dr3_inv;
+
+		const RealCalcVec fac = dr2_inv * three * re;
+
+		f_x = qpper4pie0dr3 * RealCalcVec::fnmadd(dx, fac, e_x);
+		f_y = qpper4pie0dr3 * RealCalcVec::fnmadd(dy, fac, e_y);
+		f_z = qpper4pie0dr3 * RealCalcVec::fnmadd(dz, fac, e_z);
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		V_x = RealAccumVec::convertCalcToAccum(m_dx * f_x);
+		V_y = RealAccumVec::convertCalcToAccum(m_dy * f_y);
+		V_z = RealAccumVec::convertCalcToAccum(m_dz * f_z);
+
+		// Check if we have to add the macroscopic values up.
+		if (calculateMacroscopic)
+		{
+			const RealCalcVec minusUpot =  qpper4pie0dr3 * re;//already masked
+			RealAccumVec upot_accum = RealAccumVec::convertCalcToAccum(minusUpot);
+			sum_upotXpoles = sum_upotXpoles - upot_accum;
+			sum_virial = sum_virial + V_x + V_y + V_z; //DoubleVec::scal_prod(m_dx, m_dy, m_dz, f_x, f_y, f_z);//already masked
+		}
+
+		const RealCalcVec e_x_dy_minus_e_y_dx = RealCalcVec::fmsub(e_x, dy, e_y * dx);
+		const RealCalcVec e_y_dz_minus_e_z_dy = RealCalcVec::fmsub(e_y, dz, e_z * dy);
+		const RealCalcVec e_z_dx_minus_e_x_dz = RealCalcVec::fmsub(e_z, dx, e_x * dz);
+
+		M_x = RealAccumVec::convertCalcToAccum(qpper4pie0dr3 * e_y_dz_minus_e_z_dy);
+		M_y = RealAccumVec::convertCalcToAccum(qpper4pie0dr3 * e_z_dx_minus_e_x_dz);
+		M_z = RealAccumVec::convertCalcToAccum(qpper4pie0dr3 * e_x_dy_minus_e_y_dx);
+	}
+
+	template<bool calculateMacroscopic>
+	vcp_inline void VectorizedCellProcessorKernel :: _loopBodyDipole(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
+			const RealCalcVec& pii,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
+			const RealCalcVec& pjj,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& M1_x, RealAccumVec& M1_y, RealAccumVec& M1_z,
+			RealAccumVec& M2_x, RealAccumVec& M2_y, RealAccumVec& M2_z,
+			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial, RealAccumVec& sum_myRF,
+			const MaskCalcVec& forceMask,
+			const RealCalcVec& epsRFInvrc3)
+	{
+		const RealCalcVec dx = r1_x - r2_x;
+		const RealCalcVec dy = r1_y - r2_y;
+		const RealCalcVec dz = r1_z - r2_z;
+
+		const RealCalcVec dr2 = RealCalcVec::scal_prod(dx, dy, dz, dx, dy, dz);
+
+		const RealCalcVec dr2_inv = RealCalcVec::fastReciprocal_mask(dr2, forceMask);
+#if VCP_VEC_TYPE == VCP_VEC_AVX2 or \
+	VCP_VEC_TYPE == VCP_VEC_KNL or \
+	VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+	    const RealCalcVec dr_inv = RealCalcVec::fastReciprocSqrt_mask(dr2, forceMask);
+#else
+	    const RealCalcVec dr_inv = RealCalcVec::sqrt(dr2_inv);
+#endif
+		const RealCalcVec dr2three_inv = three * dr2_inv;
+
+		const RealCalcVec p1p2 = RealCalcVec::apply_mask(pii * pjj, forceMask);
+		const RealCalcVec p1p2per4pie0 = p1p2;
+		const RealCalcVec rffac = p1p2 * epsRFInvrc3;
+
+		const RealCalcVec p1p2per4pie0r3 = p1p2per4pie0 * dr_inv * dr2_inv;
+		const RealCalcVec p1p2threeper4pie0r5 = p1p2per4pie0r3 * dr2three_inv;
+
+		const RealCalcVec e1e2 = RealCalcVec::scal_prod(eii_x, eii_y, eii_z, ejj_x, ejj_y, ejj_z);
+		const RealCalcVec re1 = RealCalcVec::scal_prod(dx, dy, dz, eii_x, eii_y, eii_z);
+		const RealCalcVec re2 = RealCalcVec::scal_prod(dx, dy, dz, ejj_x, ejj_y, ejj_z);
+
+		const RealCalcVec re1threeperr2 = re1 * dr2three_inv;
+		const RealCalcVec re2threeperr2 = re2 * dr2three_inv;
+		const RealCalcVec re1re2perr2 = dr2_inv * re1 * re2;
+
+		const RealCalcVec e1e2minus5re1re2perr2 = RealCalcVec::fnmadd(five, re1re2perr2, e1e2);//-five*re1+e1e2
+
+
+		f_x = p1p2threeper4pie0r5 * RealCalcVec::scal_prod(dx, eii_x, ejj_x, e1e2minus5re1re2perr2, re2, re1);
+		f_y = p1p2threeper4pie0r5 * RealCalcVec::scal_prod(dy, eii_y, ejj_y, e1e2minus5re1re2perr2, re2, re1);
+		f_z = p1p2threeper4pie0r5 * RealCalcVec::scal_prod(dz, eii_z, ejj_z, e1e2minus5re1re2perr2, re2, re1);
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		V_x = RealAccumVec::convertCalcToAccum(m_dx * f_x);
+		V_y = RealAccumVec::convertCalcToAccum(m_dy * f_y);
+		V_z = RealAccumVec::convertCalcToAccum(m_dz * f_z);
+
+		// Check if we have to add the macroscopic values up
+		if (calculateMacroscopic) {
+
+			// can we precompute some of this?
+			const RealCalcVec upot = p1p2per4pie0r3 * RealCalcVec::fnmadd(three, re1re2perr2, e1e2);//already masked
+			const RealAccumVec upot_accum = RealAccumVec::convertCalcToAccum(upot);
+
+			sum_upotXpoles = sum_upotXpoles + upot_accum;
+
+			//const DoubleVec virial = DoubleVec::scal_prod(m_dx, m_dy, m_dz, f_x, f_y, f_z);//already masked
+			sum_virial = sum_virial + V_x + V_y + V_z;
+
+			RealAccumVec rf_accum = RealAccumVec::convertCalcToAccum(rffac * e1e2);
+			sum_myRF = sum_myRF + rf_accum;
+		}
+
+		const RealCalcVec e1_x_e2_y_minus_e1_y_e2_x = RealCalcVec::fmsub(eii_x, ejj_y, eii_y * ejj_x);
+		const RealCalcVec e1_y_e2_z_minus_e1_z_e2_y = RealCalcVec::fmsub(eii_y, ejj_z, eii_z * ejj_y);
+		const RealCalcVec e1_z_e2_x_minus_e1_x_e2_z = RealCalcVec::fmsub(eii_z, ejj_x, eii_x * ejj_z);
+
+		M1_x = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(p1p2per4pie0r3, RealCalcVec::fmsub(re2threeperr2, RealCalcVec::fmsub(eii_y, dz, eii_z * dy), e1_y_e2_z_minus_e1_z_e2_y), rffac * e1_y_e2_z_minus_e1_z_e2_y));
+		M1_y = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(p1p2per4pie0r3, RealCalcVec::fmsub(re2threeperr2, RealCalcVec::fmsub(eii_z, dx, eii_x * dz), e1_z_e2_x_minus_e1_x_e2_z), rffac * e1_z_e2_x_minus_e1_x_e2_z));
+		M1_z = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(p1p2per4pie0r3, RealCalcVec::fmsub(re2threeperr2, RealCalcVec::fmsub(eii_x, dy, eii_y * dx), e1_x_e2_y_minus_e1_y_e2_x), rffac * e1_x_e2_y_minus_e1_y_e2_x));
+
+		M2_x = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(p1p2per4pie0r3, RealCalcVec::fmadd(re1threeperr2, RealCalcVec::fmsub(ejj_y, dz, ejj_z * dy), e1_y_e2_z_minus_e1_z_e2_y), rffac * e1_y_e2_z_minus_e1_z_e2_y));
+		M2_y = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(p1p2per4pie0r3, RealCalcVec::fmadd(re1threeperr2, RealCalcVec::fmsub(ejj_z, dx, ejj_x * dz), e1_z_e2_x_minus_e1_x_e2_z), rffac * e1_z_e2_x_minus_e1_x_e2_z));
+		M2_z = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(p1p2per4pie0r3, RealCalcVec::fmadd(re1threeperr2, RealCalcVec::fmsub(ejj_x, dy, ejj_y * dx), e1_x_e2_y_minus_e1_y_e2_x), rffac * e1_x_e2_y_minus_e1_y_e2_x));
+	}
+
+	template<bool calculateMacroscopic>
+	vcp_inline void VectorizedCellProcessorKernel :: _loopBodyChargeQuadrupole(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& q,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
+			const RealCalcVec& m,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& M_x, RealAccumVec& M_y, RealAccumVec& M_z,
+			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask) {
+
+		const RealCalcVec c_dx = r1_x - r2_x;
+		const RealCalcVec c_dy = r1_y - r2_y;
+		const RealCalcVec c_dz = r1_z - r2_z;//fma not possible since they will be reused...
+
+		const RealCalcVec c_dr2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+
+		const RealCalcVec invdr2 = RealCalcVec::fastReciprocal_mask(c_dr2, forceMask);
+#if VCP_VEC_TYPE == VCP_VEC_AVX2 or \
+	VCP_VEC_TYPE == VCP_VEC_KNL or \
+	VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+	    const RealCalcVec invdr = RealCalcVec::fastReciprocSqrt_mask(c_dr2, forceMask);
+#else
+	    const RealCalcVec invdr = RealCalcVec::sqrt(invdr2);
+#endif
+
+		const RealCalcVec qQ05per4pie0 = _05 * q * m;
+
+		RealCalcVec costj = RealCalcVec::scal_prod(ejj_x, ejj_y, ejj_z, c_dx, c_dy, c_dz);
+		costj = costj * invdr;
+
+		const RealCalcVec qQinv4dr3 = qQ05per4pie0 * invdr * invdr2;
+		const RealCalcVec part1 = three * costj * costj;
+		const RealCalcVec upot = qQinv4dr3 * (part1 - one);
+
+		/**********
+		 * Force
+		 **********/
+		const RealCalcVec minus_partialRijInvdr = three * upot * invdr2;
+		const RealCalcVec partialTjInvdr = six * costj * qQinv4dr3 * invdr;
+
+		const RealCalcVec fac = RealCalcVec::fmadd(costj * partialTjInvdr, invdr, minus_partialRijInvdr);
+
+		f_x = RealCalcVec::fmsub(fac, c_dx, partialTjInvdr * ejj_x);
+		f_y = RealCalcVec::fmsub(fac, c_dy, partialTjInvdr * ejj_y);
+		f_z = RealCalcVec::fmsub(fac, c_dz, partialTjInvdr * ejj_z);
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		V_x = RealAccumVec::convertCalcToAccum(m_dx * f_x);
+		V_y = RealAccumVec::convertCalcToAccum(m_dy * f_y);
+		V_z = RealAccumVec::convertCalcToAccum(m_dz * f_z);
+
+		// Check if we have to add the macroscopic values up
+		if (calculateMacroscopic) {
+			const RealAccumVec upot_accum = RealAccumVec::convertCalcToAccum(upot);
+
+			sum_upotXpoles = sum_upotXpoles + upot_accum;
+
+			sum_virial = sum_virial + V_x + V_y + V_z;
+		}
+
+		/**********
+		 * Torque
+		 **********/
+		const RealCalcVec minuseXrij_x = RealCalcVec::fmsub(ejj_z, c_dy, ejj_y * c_dz);
+		const RealCalcVec minuseXrij_y = RealCalcVec::fmsub(ejj_x, c_dz, ejj_z * c_dx);
+		const RealCalcVec minuseXrij_z = RealCalcVec::fmsub(ejj_y, c_dx, ejj_x * c_dy);
+
+		M_x = RealAccumVec::convertCalcToAccum(partialTjInvdr * minuseXrij_x);
+		M_y = RealAccumVec::convertCalcToAccum(partialTjInvdr * minuseXrij_y);
+		M_z = RealAccumVec::convertCalcToAccum(partialTjInvdr * minuseXrij_z);
+	}
+
+	template<bool calculateMacroscopic>
+	vcp_inline void VectorizedCellProcessorKernel :: _loopBodyDipoleQuadrupole(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
+			const RealCalcVec& p,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
+			const RealCalcVec& m,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& M1_x, RealAccumVec& M1_y, RealAccumVec& M1_z,
+			RealAccumVec& M2_x, RealAccumVec& M2_y, RealAccumVec& M2_z,
+			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask) {
+
+
+		const RealCalcVec c_dx = r1_x - r2_x;
+		const RealCalcVec c_dy = r1_y - r2_y;
+		const RealCalcVec c_dz = r1_z - r2_z;
+
+		const RealCalcVec c_dr2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+
+		const RealCalcVec invdr2 = RealCalcVec::fastReciprocal_mask(c_dr2, forceMask);
+#if VCP_VEC_TYPE == VCP_VEC_AVX2 or \
+	VCP_VEC_TYPE == VCP_VEC_KNL or \
+	VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+	    const RealCalcVec invdr = RealCalcVec::fastReciprocSqrt_mask(c_dr2, forceMask);
+#else
+	    const RealCalcVec invdr = RealCalcVec::sqrt(invdr2);
+#endif
+
+		const RealCalcVec myqfac = _1pt5 * p * m * invdr2 * invdr2;
+
+		RealCalcVec costi = RealCalcVec::scal_prod(eii_x, eii_y, eii_z, c_dx, c_dy, c_dz);
+		costi = costi * invdr;
+
+		RealCalcVec costj = RealCalcVec::scal_prod(ejj_x, ejj_y, ejj_z, c_dx, c_dy, c_dz);
+		costj = costj * invdr;
+
+		const RealCalcVec cos2tj = costj * costj;
+
+		const RealCalcVec cosgij = RealCalcVec::scal_prod(eii_x, eii_y, eii_z, ejj_x, ejj_y, ejj_z);
+
+		/************
+		 * Potential
+		 ************/
+		// TODO: Check if upot has to be multiplied by -1 according to DISS_STOLL S.178.
+		// This affects also the implementation in potforce.h
+		const RealCalcVec _5cos2tjminus1 = RealCalcVec::fmsub(five, cos2tj, one);
+		const RealCalcVec _2costj = two * costj;
+
+		RealCalcVec part1 = costi * _5cos2tjminus1;
+		RealCalcVec part2 = _2costj * cosgij;
+
+		RealCalcVec const upot = myqfac * (part2 - part1);
+
+		const RealCalcVec myqfacXinvdr = myqfac * invdr;
+		const RealCalcVec minus_partialRijInvdr = four * upot * invdr2;
+		const RealCalcVec minus_partialTiInvdr = myqfacXinvdr * _5cos2tjminus1;
+
+		part1 = RealCalcVec::fmsub(five, costi * costj, cosgij); // *-1!
+
+		const RealCalcVec minus_partialTjInvdr = myqfacXinvdr * two * part1;
+		const RealCalcVec partialGij = myqfac * _2costj;
+
+		RealCalcVec part3 = RealCalcVec::fmadd(costi, minus_partialTiInvdr, costj * minus_partialTjInvdr);
+		const RealCalcVec fac = RealCalcVec::fnmadd(part3, invdr, minus_partialRijInvdr);//minus_pRI - part3*infdr
+
+		// Force components
+		f_x = RealCalcVec::scal_prod(fac, minus_partialTiInvdr, minus_partialTjInvdr, c_dx, eii_x, ejj_x);
+
+		f_y = RealCalcVec::scal_prod(fac, minus_partialTiInvdr, minus_partialTjInvdr, c_dy, eii_y, ejj_y);
+
+		f_z = RealCalcVec::scal_prod(fac, minus_partialTiInvdr, minus_partialTjInvdr, c_dz, eii_z, ejj_z);
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		V_x = RealAccumVec::convertCalcToAccum(m_dx * f_x);
+		V_y = RealAccumVec::convertCalcToAccum(m_dy * f_y);
+		V_z = RealAccumVec::convertCalcToAccum(m_dz * f_z);
+
+		// Check if we have to add the macroscopic values up
+		if (calculateMacroscopic) {
+			const RealAccumVec upot_accum = RealAccumVec::convertCalcToAccum(upot);
+
+			sum_upotXpoles = sum_upotXpoles + upot_accum;
+
+			sum_virial = sum_virial + V_x + V_y + V_z;
+		}
+
+		/**********
+		 * Torque
+		 **********/
+		const RealCalcVec eii_x_ejj_y_minus_eii_y_ejj_x = RealCalcVec::fmsub(eii_x, ejj_y, eii_y * ejj_x);
+		const RealCalcVec eii_y_ejj_z_minus_eii_z_ejj_y = RealCalcVec::fmsub(eii_y, ejj_z, eii_z * ejj_y);
+		const RealCalcVec eii_z_ejj_x_minus_eii_x_ejj_z = RealCalcVec::fmsub(eii_z, ejj_x, eii_x * ejj_z);
+
+		const RealCalcVec partialGij_eiXej_x = partialGij * eii_y_ejj_z_minus_eii_z_ejj_y;
+		const RealCalcVec partialGij_eiXej_y = partialGij * eii_z_ejj_x_minus_eii_x_ejj_z;
+		const RealCalcVec partialGij_eiXej_z = partialGij * eii_x_ejj_y_minus_eii_y_ejj_x;
+
+		RealCalcVec eXrij_x = RealCalcVec::fmsub(eii_y, c_dz, eii_z * c_dy);
+		RealCalcVec eXrij_y = RealCalcVec::fmsub(eii_z, c_dx, eii_x * c_dz);
+		RealCalcVec eXrij_z = RealCalcVec::fmsub(eii_x, c_dy, eii_y * c_dx);
+
+		M1_x = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(minus_partialTiInvdr, eXrij_x, partialGij_eiXej_x));
+		M1_y = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(minus_partialTiInvdr, eXrij_y, partialGij_eiXej_y));
+		M1_z = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(minus_partialTiInvdr, eXrij_z, partialGij_eiXej_z));
+
+		eXrij_x = RealCalcVec::fmsub(ejj_y, c_dz, ejj_z * c_dy);
+		eXrij_y = RealCalcVec::fmsub(ejj_z, c_dx, ejj_x * c_dz);
+		eXrij_z = RealCalcVec::fmsub(ejj_x, c_dy, ejj_y * c_dx);
+
+		M2_x = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(minus_partialTjInvdr, eXrij_x, partialGij_eiXej_x));
+		M2_y = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(minus_partialTjInvdr, eXrij_y, partialGij_eiXej_y));
+		M2_z = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(minus_partialTjInvdr, eXrij_z, partialGij_eiXej_z));
+	}
+
+	template<bool calculateMacroscopic>
+	vcp_inline void VectorizedCellProcessorKernel :: _loopBodyQuadrupole(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
+			const RealCalcVec& mii,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
+			const RealCalcVec& mjj,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& Mii_x, RealAccumVec& Mii_y, RealAccumVec& Mii_z,
+			RealAccumVec& Mjj_x, RealAccumVec& Mjj_y, RealAccumVec& Mjj_z,
+			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask)
+	{
+		const RealCalcVec c_dx = r1_x - r2_x;
+		const RealCalcVec c_dy = r1_y - r2_y;
+		const RealCalcVec c_dz = r1_z - r2_z;
+
+		const RealCalcVec c_dr2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+
+		const RealCalcVec invdr2 = RealCalcVec::fastReciprocal_mask(c_dr2, forceMask);
+#if VCP_VEC_TYPE == VCP_VEC_AVX2 or \
+	VCP_VEC_TYPE == VCP_VEC_KNL or \
+	VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+	    const RealCalcVec invdr = RealCalcVec::fastReciprocSqrt_mask(c_dr2, forceMask);
+#else
+	    const RealCalcVec invdr = RealCalcVec::sqrt(invdr2);
+#endif
+
+		RealCalcVec qfac = _075 * invdr;
+		qfac = qfac * (mii * mjj);
+		qfac = qfac * (invdr2 * invdr2);
+
+		RealCalcVec costi = RealCalcVec::scal_prod(eii_x, eii_y, eii_z, c_dx, c_dy, c_dz);
+		costi = costi * invdr;
+
+		RealCalcVec costj = RealCalcVec::scal_prod(ejj_x, ejj_y, ejj_z, c_dx, c_dy, c_dz);
+		costj = costj * invdr;
+
+		const RealCalcVec cos2ti = costi * costi;
+		const RealCalcVec cos2tj = costj * costj;
+
+		const RealCalcVec cosgij = RealCalcVec::scal_prod(eii_x, eii_y, eii_z, ejj_x, ejj_y, ejj_z);
+
+		RealCalcVec term = five * (costi * costj);
+		term = cosgij - term;
+
+		/************
+		 * Potential
+		 ************/
+		RealCalcVec part2 = _15 * cos2ti * cos2tj;
+		RealCalcVec part3 = two * term * term;
+		RealCalcVec upot = RealCalcVec::fmadd(five, (cos2ti + cos2tj), part2);
+		upot = (one + part3) - upot;
+		upot = qfac * upot;
+
+		/**********
+		 * Force
+		 **********/
+		const RealCalcVec minus_partialRijInvdr = five * upot * invdr2;
+
+		// partialTiInvdr & partialTjInvdr
+		RealCalcVec part1 = qfac * ten * invdr;
+		part2 = two * term;
+
+		// partialTiInvdr only
+		part3 = three * costi * cos2tj;
+		RealCalcVec part4 = costi + RealCalcVec::fmadd(part2, costj, part3);
+		const RealCalcVec minus_partialTiInvdr = part1 * part4;
+
+		// partialTjInvdr only
+		part3 = three * costj * cos2ti;
+		part4 = costj + RealCalcVec::fmadd(part2, costi, part3);
+		const RealCalcVec minus_partialTjInvdr = part1 * part4;
+
+		const RealCalcVec partialGij = qfac * four * term;
+
+		// fac
+		part1 = minus_partialTiInvdr * costi;
+		part2 = minus_partialTjInvdr * costj;
+		//part3 = (part1 + part2) * invdr;
+		const RealCalcVec fac = RealCalcVec::fnmadd((part1 + part2), invdr, minus_partialRijInvdr); //min - part3 = -part3 + min
+
+		// Force components
+
+
+		f_x = RealCalcVec::scal_prod(fac, minus_partialTiInvdr, minus_partialTjInvdr, c_dx, eii_x, ejj_x);
+
+		f_y = RealCalcVec::scal_prod(fac, minus_partialTiInvdr, minus_partialTjInvdr, c_dy, eii_y, ejj_y);
+
+		f_z = RealCalcVec::scal_prod(fac, minus_partialTiInvdr, minus_partialTjInvdr, c_dz, eii_z, ejj_z);
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		V_x = RealAccumVec::convertCalcToAccum(m_dx * f_x);
+		V_y = RealAccumVec::convertCalcToAccum(m_dy * f_y);
+		V_z = RealAccumVec::convertCalcToAccum(m_dz * f_z);
+
+		// Check if we have to add the macroscopic values up for at least one of this pairs
+		if (calculateMacroscopic) {
+			const RealAccumVec upot_accum = RealAccumVec::convertCalcToAccum(upot);
+
+			sum_upotXpoles = sum_upotXpoles + upot_accum;
+
+
+			sum_virial = sum_virial + V_x + V_y + V_z;
+		}
+
+		/**********
+		 * Torque
+		 **********/
+
+		const RealCalcVec eii_x_ejj_y_minus_eii_y_ejj_x = RealCalcVec::fmsub(eii_x, ejj_y, eii_y * ejj_x);
+		const RealCalcVec eii_y_ejj_z_minus_eii_z_ejj_y = RealCalcVec::fmsub(eii_y, ejj_z, eii_z * ejj_y);
+		const RealCalcVec eii_z_ejj_x_minus_eii_x_ejj_z = RealCalcVec::fmsub(eii_z, ejj_x, eii_x * ejj_z);
+
+		const RealCalcVec partialGij_eiXej_x = partialGij * eii_y_ejj_z_minus_eii_z_ejj_y;
+		const RealCalcVec partialGij_eiXej_y = partialGij * eii_z_ejj_x_minus_eii_x_ejj_z;
+		const RealCalcVec partialGij_eiXej_z = partialGij * eii_x_ejj_y_minus_eii_y_ejj_x;
+
+		RealCalcVec eXrij_x = RealCalcVec::fmsub(eii_y, c_dz, eii_z * c_dy);
+		RealCalcVec eXrij_y = RealCalcVec::fmsub(eii_z, c_dx, eii_x * c_dz);
+		RealCalcVec eXrij_z = RealCalcVec::fmsub(eii_x, c_dy, eii_y * c_dx);
+
+		Mii_x = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(minus_partialTiInvdr, eXrij_x, partialGij_eiXej_x));
+		Mii_y = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(minus_partialTiInvdr, eXrij_y, partialGij_eiXej_y));
+		Mii_z = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(minus_partialTiInvdr, eXrij_z, partialGij_eiXej_z));
+
+		eXrij_x = RealCalcVec::fmsub(ejj_y, c_dz, ejj_z * c_dy);
+		eXrij_y = RealCalcVec::fmsub(ejj_z, c_dx, ejj_x * c_dz);
+		eXrij_z = RealCalcVec::fmsub(ejj_x, c_dy, ejj_y * c_dx);
+
+		Mjj_x = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(minus_partialTjInvdr, eXrij_x, partialGij_eiXej_x));
+		Mjj_y = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(minus_partialTjInvdr, eXrij_y, partialGij_eiXej_y));
+		Mjj_z = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(minus_partialTjInvdr, eXrij_z, partialGij_eiXej_z));
+	}
+
+template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser, bool EwaldSplitting>
+void VectorizedCellProcessorKernel::_calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2, const VerletClusterList* verletList) {
+	ThreadData &my_threadData = _threadData;
+	mardyn_assert(verletList == nullptr or verletList->getChunkSize() == VCP_VEC_SIZE);
+
+	// initialize dist lookups
+	soa2.initDistLookupPointers(my_threadData._centers_dist_lookup,
+			my_threadData._ljc_dist_lookup, my_threadData._charges_dist_lookup,
+			my_threadData._dipoles_dist_lookup,
+			my_threadData._quadrupoles_dist_lookup);
+
+	// Pointer for molecules
+	const vcp_real_calc * const soa1_mol_pos_x = soa1._mol_pos.xBegin();
+	const vcp_real_calc * const soa1_mol_pos_y = soa1._mol_pos.yBegin();
+	const vcp_real_calc * const soa1_mol_pos_z = soa1._mol_pos.zBegin();
+
+	//for better readability:
+	typedef ConcSites::SiteType SiteType;
+	typedef ConcSites::CoordinateType Coordinate;
+	typedef CellDataSoA::QuantityType QuantityType;
+
+	// Pointer for LJ centers
+	const vcp_real_calc * const soa1_ljc_r_x = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc * const soa1_ljc_r_y = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc * const soa1_ljc_r_z = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa1_ljc_f_x = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa1_ljc_f_y = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa1_ljc_f_z = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa1_ljc_V_x = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa1_ljc_V_y = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa1_ljc_V_z = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Z);
+	const int * const soa1_mol_ljc_num = soa1._mol_ljc_num;
+	const vcp_ljc_id_t * const soa1_ljc_id = soa1._ljc_id;
+
+
+	const vcp_real_calc * const soa2_ljc_m_r_x = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc * const soa2_ljc_m_r_y = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc * const soa2_ljc_m_r_z = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::Z);
+	const vcp_real_calc * const soa2_ljc_r_x = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc * const soa2_ljc_r_y = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc * const soa2_ljc_r_z = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa2_ljc_f_x = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa2_ljc_f_y = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa2_ljc_f_z = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa2_ljc_V_x = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa2_ljc_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa2_ljc_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Z);
+	const vcp_ljc_id_t * const soa2_ljc_id = soa2._ljc_id;
+
+	vcp_lookupOrMask_single* const soa2_ljc_dist_lookup = my_threadData._ljc_dist_lookup;
+
+	// Pointer for charges
+	const vcp_real_calc * const soa1_charges_r_x = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::CHARGE, Coordinate::X);
+	const vcp_real_calc * const soa1_charges_r_y = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::CHARGE, Coordinate::Y);
+	const vcp_real_calc * const soa1_charges_r_z = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::CHARGE, Coordinate::Z);
+		 vcp_real_accum * const soa1_charges_f_x = soa1.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::X);
+		 vcp_real_accum * const soa1_charges_f_y = soa1.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::Y);
+		 vcp_real_accum * const soa1_charges_f_z = soa1.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::Z);
+		 vcp_real_accum * const soa1_charges_V_x = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::X);
+		 vcp_real_accum * const soa1_charges_V_y = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::Y);
+		 vcp_real_accum * const soa1_charges_V_z = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::Z);
+	const vcp_real_calc * const soa1_charges_q = soa1._charges_q;
+	const int * const soa1_mol_charges_num = soa1._mol_charges_num;
+
+	const vcp_real_calc * const soa2_charges_m_r_x = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::CHARGE, Coordinate::X);
+	const vcp_real_calc * const soa2_charges_m_r_y = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::CHARGE, Coordinate::Y);
+	const vcp_real_calc * const soa2_charges_m_r_z = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::CHARGE, Coordinate::Z);
+	const vcp_real_calc * const soa2_charges_r_x = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::CHARGE, Coordinate::X);
+	const vcp_real_calc * const soa2_charges_r_y = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::CHARGE, Coordinate::Y);
+	const vcp_real_calc * const soa2_charges_r_z = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::CHARGE, Coordinate::Z);
+		 vcp_real_accum * const soa2_charges_f_x = soa2.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::X);
+		 vcp_real_accum * const soa2_charges_f_y = soa2.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::Y);
+		 vcp_real_accum * const soa2_charges_f_z = soa2.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::Z);
+		 vcp_real_accum * const soa2_charges_V_x = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::X);
+		 vcp_real_accum * const soa2_charges_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::Y);
+		 vcp_real_accum * const soa2_charges_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::Z);
+	const vcp_real_calc * const soa2_charges_q = soa2._charges_q;
+
+	vcp_lookupOrMask_single* const soa2_charges_dist_lookup = my_threadData._charges_dist_lookup;
+
+	// Pointer for dipoles
+	const vcp_real_calc * const soa1_dipoles_r_x = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::DIPOLE, Coordinate::X);
+	const vcp_real_calc * const soa1_dipoles_r_y = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::DIPOLE, Coordinate::Y);
+	const vcp_real_calc * const soa1_dipoles_r_z = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::DIPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa1_dipoles_f_x = soa1.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::X);
+		 vcp_real_accum * const soa1_dipoles_f_y = soa1.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa1_dipoles_f_z = soa1.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa1_dipoles_V_x = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::X);
+		 vcp_real_accum * const soa1_dipoles_V_y = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa1_dipoles_V_z = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::Z);
+	const vcp_real_calc * const soa1_dipoles_p = soa1._dipoles_p;
+	const vcp_real_calc * const soa1_dipoles_e_x = soa1._dipoles_e.xBegin();
+	const vcp_real_calc * const soa1_dipoles_e_y = soa1._dipoles_e.yBegin();
+	const vcp_real_calc * const soa1_dipoles_e_z = soa1._dipoles_e.zBegin();
+	vcp_real_accum * const soa1_dipoles_M_x = soa1._dipoles_M.xBegin();
+	vcp_real_accum * const soa1_dipoles_M_y = soa1._dipoles_M.yBegin();
+	vcp_real_accum * const soa1_dipoles_M_z = soa1._dipoles_M.zBegin();
+	const int * const soa1_mol_dipoles_num = soa1._mol_dipoles_num;
+
+	const vcp_real_calc * const soa2_dipoles_m_r_x = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::DIPOLE, Coordinate::X);
+	const vcp_real_calc * const soa2_dipoles_m_r_y = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::DIPOLE, Coordinate::Y);
+	const vcp_real_calc * const soa2_dipoles_m_r_z = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::DIPOLE, Coordinate::Z);
+	const vcp_real_calc * const soa2_dipoles_r_x = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::DIPOLE, Coordinate::X);
+	const vcp_real_calc * const soa2_dipoles_r_y = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::DIPOLE, Coordinate::Y);
+	const vcp_real_calc * const soa2_dipoles_r_z = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::DIPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa2_dipoles_f_x = soa2.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::X);
+		 vcp_real_accum * const soa2_dipoles_f_y = soa2.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa2_dipoles_f_z = soa2.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa2_dipoles_V_x = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::X);
+		 vcp_real_accum * const soa2_dipoles_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa2_dipoles_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::Z);
+	const vcp_real_calc * const soa2_dipoles_p = soa2._dipoles_p;
+	const vcp_real_calc * const soa2_dipoles_e_x = soa2._dipoles_e.xBegin();
+	const vcp_real_calc * const soa2_dipoles_e_y = soa2._dipoles_e.yBegin();
+	const vcp_real_calc * const soa2_dipoles_e_z = soa2._dipoles_e.zBegin();
+	vcp_real_accum * const soa2_dipoles_M_x = soa2._dipoles_M.xBegin();
+	vcp_real_accum * const soa2_dipoles_M_y = soa2._dipoles_M.yBegin();
+	vcp_real_accum * const soa2_dipoles_M_z = soa2._dipoles_M.zBegin();
+
+	vcp_lookupOrMask_single* const soa2_dipoles_dist_lookup = my_threadData._dipoles_dist_lookup;
+
+	// Pointer for quadrupoles
+	const vcp_real_calc * const soa1_quadrupoles_r_x = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::QUADRUPOLE, Coordinate::X);
+	const vcp_real_calc * const soa1_quadrupoles_r_y = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::QUADRUPOLE, Coordinate::Y);
+	const vcp_real_calc * const soa1_quadrupoles_r_z = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::QUADRUPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa1_quadrupoles_f_x = soa1.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::X);
+		 vcp_real_accum * const soa1_quadrupoles_f_y = soa1.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa1_quadrupoles_f_z = soa1.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa1_quadrupoles_V_x = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::X);
+		 vcp_real_accum * const soa1_quadrupoles_V_y = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa1_quadrupoles_V_z = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::Z);
+	const vcp_real_calc * const soa1_quadrupoles_m = soa1._quadrupoles_m;
+	const vcp_real_calc * const soa1_quadrupoles_e_x = soa1._quadrupoles_e.xBegin();
+	const vcp_real_calc * const soa1_quadrupoles_e_y = soa1._quadrupoles_e.yBegin();
+	const vcp_real_calc * const soa1_quadrupoles_e_z = soa1._quadrupoles_e.zBegin();
+	     vcp_real_accum * const soa1_quadrupoles_M_x = soa1._quadrupoles_M.xBegin();
+	     vcp_real_accum * const soa1_quadrupoles_M_y = soa1._quadrupoles_M.yBegin();
+	     vcp_real_accum * const soa1_quadrupoles_M_z = soa1._quadrupoles_M.zBegin();
+	const int * const soa1_mol_quadrupoles_num = soa1._mol_quadrupoles_num;
+
+
+	const vcp_real_calc * const soa2_quadrupoles_m_r_x = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::QUADRUPOLE, Coordinate::X);
+	const vcp_real_calc * const soa2_quadrupoles_m_r_y = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::QUADRUPOLE, Coordinate::Y);
+	const vcp_real_calc * const soa2_quadrupoles_m_r_z = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::QUADRUPOLE, Coordinate::Z);
+	const vcp_real_calc * const soa2_quadrupoles_r_x = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::QUADRUPOLE, Coordinate::X);
+	const vcp_real_calc * const soa2_quadrupoles_r_y = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::QUADRUPOLE, Coordinate::Y);
+	const vcp_real_calc * const soa2_quadrupoles_r_z = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::QUADRUPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa2_quadrupoles_f_x = soa2.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::X);
+		 vcp_real_accum * const soa2_quadrupoles_f_y = soa2.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa2_quadrupoles_f_z = soa2.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa2_quadrupoles_V_x = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::X);
+		 vcp_real_accum * const soa2_quadrupoles_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa2_quadrupoles_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::Z);
+	const vcp_real_calc * const soa2_quadrupoles_m = soa2._quadrupoles_m;
+	const vcp_real_calc * const soa2_quadrupoles_e_x = soa2._quadrupoles_e.xBegin();
+	const vcp_real_calc * const soa2_quadrupoles_e_y = soa2._quadrupoles_e.yBegin();
+	const vcp_real_calc * const soa2_quadrupoles_e_z = soa2._quadrupoles_e.zBegin();
+	     vcp_real_accum * const soa2_quadrupoles_M_x = soa2._quadrupoles_M.xBegin();
+	     vcp_real_accum * const soa2_quadrupoles_M_y = soa2._quadrupoles_M.yBegin();
+	     vcp_real_accum * const soa2_quadrupoles_M_z = soa2._quadrupoles_M.zBegin();
+
+	vcp_lookupOrMask_single* const soa2_quadrupoles_dist_lookup = my_threadData._quadrupoles_dist_lookup;
+
+
+
+
+	RealAccumVec sum_upot6lj = RealAccumVec::zero();
+	RealAccumVec sum_upotXpoles = RealAccumVec::zero();
+	RealAccumVec sum_virial = RealAccumVec::zero();
+	RealAccumVec sum_myRF = RealAccumVec::zero();
+
+	const RealCalcVec ljrc2 = RealCalcVec::set1(static_cast<vcp_real_calc>(_LJCutoffRadiusSquare));
+	const RealCalcVec cutoffRadiusSquare = RealCalcVec::set1(static_cast<vcp_real_calc>(_cutoffRadiusSquare));
+	const RealCalcVec epsRFInvrc3 = RealCalcVec::set1(static_cast<vcp_real_calc>(_epsRFInvrc3));
+
+	/*
+	 *  Here different end values for the loops are defined. For loops, which do not vectorize over the last (possibly "uneven") amount of indices, the normal values are computed. These mark the end of the vectorized part.
+	 *  The longloop values mark the end of the vectorized part, if vectorization is performed for all elements. For these, various conditions have to be fulfilled, to be sure, that no NaN values are stored and no segfaults arise:
+	 *  * arrays have to be long enough
+	 *  * arrays have to be filled with something
+	 *  * _ljc_id has to be set to existing values for each index
+	 *  All of these conditions are fulfilled by setting the non existing values within CellDataSoA.h and AlignedArray.h to zero.
+	 */
+	const size_t end_ljc_j = vcp_floor_to_vec_size(soa2._ljc_num);
+	const size_t end_ljc_j_longloop = vcp_ceil_to_vec_size(soa2._ljc_num);//this is ceil _ljc_num, VCP_VEC_SIZE
+
+	const size_t end_charges_j = vcp_floor_to_vec_size(soa2._charges_num);
+	const size_t end_charges_j_longloop = vcp_ceil_to_vec_size(soa2._charges_num);//this is ceil _charges_num, VCP_VEC_SIZE
+
+	const size_t end_dipoles_j = vcp_floor_to_vec_size(soa2._dipoles_num);
+	const size_t end_dipoles_j_longloop = vcp_ceil_to_vec_size(soa2._dipoles_num);//this is ceil _dipoles_num, VCP_VEC_SIZE
+
+	const size_t end_quadrupoles_j = vcp_floor_to_vec_size(soa2._quadrupoles_num);
+	const size_t end_quadrupoles_j_longloop = vcp_ceil_to_vec_size(soa2._quadrupoles_num);//this is ceil _quadrupoles_num, VCP_VEC_SIZE
+
+	size_t i_ljc_idx = 0;
+	size_t i_charge_idx = 0;
+	size_t i_charge_dipole_idx = 0;
+	size_t i_charge_quadrupole_idx = 0;
+	size_t i_dipole_charge_idx = 0;
+	size_t i_dipole_idx = 0;
+	size_t i_dipole_quadrupole_idx = 0;
+	size_t i_quadrupole_charge_idx = 0;
+	size_t i_quadrupole_dipole_idx = 0;
+	size_t i_quadrupole_idx = 0;
+
+	//if(soa1.getMolNum() < 8){
+	//	printf("less than 8\n");
+	//}
+
+	// Iterate over each center in the first cell.
+	const size_t soa1_mol_num = soa1.getMolNum();
+	for (size_t i = 0; i < soa1_mol_num; ++i) {//over the molecules
+		const RealCalcVec m1_r_x = RealCalcVec::broadcast(soa1_mol_pos_x + i);
+		const RealCalcVec m1_r_y = RealCalcVec::broadcast(soa1_mol_pos_y + i);
+		const RealCalcVec m1_r_z = RealCalcVec::broadcast(soa1_mol_pos_z + i);
+		// Iterate over centers of second cell
+		const countertype32 compute_molecule_ljc = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_ljc_idx, soa2._ljc_num,
+				soa2_ljc_dist_lookup, soa2_ljc_m_r_x, soa2_ljc_m_r_y, soa2_ljc_m_r_z,
+				ljrc2, end_ljc_j, m1_r_x, m1_r_y, m1_r_z,
+				verletList ? verletList->getChunkMask(i, SiteType::LJC) : nullptr);
+		const countertype32 compute_molecule_charges = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_charge_idx, soa2._charges_num,
+				soa2_charges_dist_lookup, soa2_charges_m_r_x, soa2_charges_m_r_y, soa2_charges_m_r_z,
+				cutoffRadiusSquare,	end_charges_j, m1_r_x, m1_r_y, m1_r_z,
+				verletList ? verletList->getChunkMask(i, SiteType::CHARGE) : nullptr);
+		const countertype32 compute_molecule_dipoles = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_dipole_idx, soa2._dipoles_num,
+				soa2_dipoles_dist_lookup, soa2_dipoles_m_r_x, soa2_dipoles_m_r_y, soa2_dipoles_m_r_z,
+				cutoffRadiusSquare,	end_dipoles_j, m1_r_x, m1_r_y, m1_r_z,
+				verletList ? verletList->getChunkMask(i, SiteType::DIPOLE) : nullptr);
+		const countertype32 compute_molecule_quadrupoles = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_quadrupole_idx, soa2._quadrupoles_num,
+				soa2_quadrupoles_dist_lookup, soa2_quadrupoles_m_r_x, soa2_quadrupoles_m_r_y, soa2_quadrupoles_m_r_z,
+				cutoffRadiusSquare, end_quadrupoles_j, m1_r_x, m1_r_y, m1_r_z,
+				verletList ? verletList->getChunkMask(i, SiteType::QUADRUPOLE) : nullptr);
+
+		size_t end_ljc_loop = MaskGatherChooser::getEndloop(end_ljc_j_longloop, compute_molecule_ljc);
+		size_t end_charges_loop = MaskGatherChooser::getEndloop(end_charges_j_longloop, compute_molecule_charges);
+		size_t end_dipoles_loop = MaskGatherChooser::getEndloop(end_dipoles_j_longloop, compute_molecule_dipoles);
+		size_t end_quadrupoles_loop = MaskGatherChooser::getEndloop(end_quadrupoles_j_longloop, compute_molecule_quadrupoles);
+
+		if (compute_molecule_ljc==0) {
+			i_ljc_idx += soa1_mol_ljc_num[i];
+		}
+		else {
+			// LJ force computation
+			for (int local_i = 0; local_i < soa1_mol_ljc_num[i]; local_i++) {//over the number of lj-centers in the molecule i
+				RealAccumVec sum_fx1 = RealAccumVec::zero();
+				RealAccumVec sum_fy1 = RealAccumVec::zero();
+				RealAccumVec sum_fz1 = RealAccumVec::zero();
+
+				RealAccumVec sum_Vx1 = RealAccumVec::zero();
+				RealAccumVec sum_Vy1 = RealAccumVec::zero();
+				RealAccumVec sum_Vz1 = RealAccumVec::zero();
+
+				const RealCalcVec c_r_x1 = RealCalcVec::broadcast(soa1_ljc_r_x + i_ljc_idx);
+				const RealCalcVec c_r_y1 = RealCalcVec::broadcast(soa1_ljc_r_y + i_ljc_idx);
+				const RealCalcVec c_r_z1 = RealCalcVec::broadcast(soa1_ljc_r_z + i_ljc_idx);
+
+				// Iterate over each pair of centers in the second cell.
+				size_t j = ForcePolicy::InitJ2(i_ljc_idx);
+				for (; j < end_ljc_loop; j += VCP_VEC_SIZE) {//over (all/some) lj-centers -- amount depends on ForcePolicy::InitJ (two cells: all, within one cell: only do i,j not j,i)
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_ljc_dist_lookup, j);
+					// Only go on if at least 1 of the forces has to be calculated.
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+						const RealCalcVec c_r_x2 = MaskGatherChooser::load(soa2_ljc_r_x, j, lookupORforceMask);
+						const RealCalcVec c_r_y2 = MaskGatherChooser::load(soa2_ljc_r_y, j, lookupORforceMask);
+						const RealCalcVec c_r_z2 = MaskGatherChooser::load(soa2_ljc_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m_r_x2 = MaskGatherChooser::load(soa2_ljc_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m_r_y2 = MaskGatherChooser::load(soa2_ljc_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m_r_z2 = MaskGatherChooser::load(soa2_ljc_m_r_z, j, lookupORforceMask);
+
+						const vcp_ljc_id_t id_i = soa1_ljc_id[i_ljc_idx];
+						RealCalcVec fx, fy, fz;
+						RealAccumVec Vx, Vy, Vz;
+
+						RealCalcVec eps_24;
+						RealCalcVec sig2;
+						unpackEps24Sig2<MaskGatherChooser>(eps_24, sig2, _eps_sig[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, lookupORforceMask);
+
+						RealCalcVec shift6;
+						unpackShift6<MaskGatherChooser>(shift6, _shift6[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, lookupORforceMask);
+
+						_loopBodyLJ<CalculateMacroscopic>(
+							m1_r_x, m1_r_y, m1_r_z, c_r_x1, c_r_y1, c_r_z1,
+							m_r_x2, m_r_y2, m_r_z2, c_r_x2, c_r_y2, c_r_z2,
+							fx, fy, fz,
+							Vx, Vy, Vz,
+							sum_upot6lj, sum_virial,
+							MaskGatherChooser::getForceMask(lookupORforceMask),
+							eps_24, sig2,
+							shift6);
+
+						RealAccumVec a_fx = RealAccumVec::convertCalcToAccum(fx);
+						RealAccumVec a_fy = RealAccumVec::convertCalcToAccum(fy);
+						RealAccumVec a_fz = RealAccumVec::convertCalcToAccum(fz);
+
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_ljc_f_x, j, a_fx, lookupORforceMask);
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_ljc_f_y, j, a_fy, lookupORforceMask);
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_ljc_f_z, j, a_fz, lookupORforceMask);
+
+						sum_fx1 = sum_fx1 + a_fx;
+						sum_fy1 = sum_fy1 + a_fy;
+						sum_fz1 = sum_fz1 + a_fz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_x, j, Vx, lookupORforceMask);
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_y, j, Vy, lookupORforceMask);
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_z, j, Vz, lookupORforceMask);
+
+						sum_Vx1 = sum_Vx1 + Vx;
+						sum_Vy1 = sum_Vy1 + Vy;
+						sum_Vz1 = sum_Vz1 + Vz;
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_ljc);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_ljc);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_ljc_dist_lookup, j, remainderM);
+
+						const RealCalcVec c_r_x2 = MaskGatherChooser::load(soa2_ljc_r_x, j, lookupORforceMask);
+						const RealCalcVec c_r_y2 = MaskGatherChooser::load(soa2_ljc_r_y, j, lookupORforceMask);
+						const RealCalcVec c_r_z2 = MaskGatherChooser::load(soa2_ljc_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m_r_x2 = MaskGatherChooser::load(soa2_ljc_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m_r_y2 = MaskGatherChooser::load(soa2_ljc_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m_r_z2 = MaskGatherChooser::load(soa2_ljc_m_r_z, j, lookupORforceMask);
+
+						const size_t id_i = soa1_ljc_id[i_ljc_idx];
+						RealCalcVec fx, fy, fz;
+						RealAccumVec Vx, Vy, Vz;
+
+						RealCalcVec eps_24;
+						RealCalcVec sig2;
+						unpackEps24Sig2<MaskGatherChooser>(eps_24, sig2, _eps_sig[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, lookupORforceMask);
+
+						RealCalcVec shift6;
+						unpackShift6<MaskGatherChooser>(shift6, _shift6[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, lookupORforceMask);
+
+						_loopBodyLJ<CalculateMacroscopic>(
+							m1_r_x, m1_r_y, m1_r_z, c_r_x1, c_r_y1, c_r_z1,
+							m_r_x2, m_r_y2, m_r_z2, c_r_x2, c_r_y2, c_r_z2,
+							fx, fy, fz,
+							Vx, Vy, Vz,
+							sum_upot6lj, sum_virial,
+							remainderM,//use remainder mask as forcemask
+							eps_24, sig2,
+							shift6);
+
+						RealAccumVec a_fx = RealAccumVec::convertCalcToAccum(fx);
+						RealAccumVec a_fy = RealAccumVec::convertCalcToAccum(fy);
+						RealAccumVec a_fz = RealAccumVec::convertCalcToAccum(fz);
+
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_ljc_f_x, j, a_fx, lookupORforceMask, remainderM);
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_ljc_f_y, j, a_fy, lookupORforceMask, remainderM);
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_ljc_f_z, j, a_fz, lookupORforceMask, remainderM);
+
+						sum_fx1 = sum_fx1 + a_fx;
+						sum_fy1 = sum_fy1 + a_fy;
+						sum_fz1 = sum_fz1 + a_fz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_ljc_V_x, j, Vx, lookupORforceMask, remainderM);
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_ljc_V_y, j, Vy, lookupORforceMask, remainderM);
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_ljc_V_z, j, Vz, lookupORforceMask, remainderM);
+
+
+						sum_Vx1 = sum_Vx1 + Vx;
+						sum_Vy1 = sum_Vy1 + Vy;
+						sum_Vz1 = sum_Vz1 + Vz;
+
+					}
+				}
+#endif
+
+				hSum_Add_Store(soa1_ljc_f_x + i_ljc_idx, sum_fx1);
+				hSum_Add_Store(soa1_ljc_f_y + i_ljc_idx, sum_fy1);
+				hSum_Add_Store(soa1_ljc_f_z + i_ljc_idx, sum_fz1);
+
+				hSum_Add_Store(soa1_ljc_V_x + i_ljc_idx, sum_Vx1);
+				hSum_Add_Store(soa1_ljc_V_y + i_ljc_idx, sum_Vy1);
+				hSum_Add_Store(soa1_ljc_V_z + i_ljc_idx, sum_Vz1);
+
+				i_ljc_idx++;
+			}
+		}
+		// Computation of site interactions with charges
+
+		if (compute_molecule_charges == 0) {
+			i_charge_idx += soa1_mol_charges_num[i];
+			i_dipole_charge_idx += soa1_mol_dipoles_num[i];
+			i_quadrupole_charge_idx += soa1_mol_quadrupoles_num[i];
+		}
+		else {
+			// Computation of charge-charge interactions
+
+			// Iterate over centers of actual molecule
+			for (int local_i = 0; local_i < soa1_mol_charges_num[i]; local_i++) {
+
+				const RealCalcVec q1 = RealCalcVec::broadcast(soa1_charges_q + i_charge_idx + local_i);
+				const RealCalcVec r1_x = RealCalcVec::broadcast(soa1_charges_r_x + i_charge_idx + local_i);
+				const RealCalcVec r1_y = RealCalcVec::broadcast(soa1_charges_r_y + i_charge_idx + local_i);
+				const RealCalcVec r1_z = RealCalcVec::broadcast(soa1_charges_r_z + i_charge_idx + local_i);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				// Iterate over centers of second cell
+				size_t j = ForcePolicy::InitJ2(i_charge_idx + local_i);
+
+				for (; j < end_charges_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_charges_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+						const RealCalcVec q2 = MaskGatherChooser::load(soa2_charges_q, j, lookupORforceMask);
+
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_charges_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_charges_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_charges_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_charges_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_charges_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_charges_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyCharge<CalculateMacroscopic, EwaldSplitting>(
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, q1,
+								m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, q2,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask));
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_charges_f_x, j, a_f_x, lookupORforceMask);
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_charges_f_y, j, a_f_y, lookupORforceMask);
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_charges_f_z, j, a_f_z, lookupORforceMask);
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask);
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask);
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask);
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_charges);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_charges);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_charges_dist_lookup, j, remainderM);
+
+						const RealCalcVec q2 = MaskGatherChooser::load(soa2_charges_q, j, lookupORforceMask);
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_charges_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_charges_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_charges_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_charges_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_charges_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_charges_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyCharge<CalculateMacroscopic, EwaldSplitting>(
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, q1,
+								m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, q2,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								sum_upotXpoles, sum_virial,
+								remainderM);
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_charges_f_x, j, a_f_x, lookupORforceMask, remainderM);
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_charges_f_y, j, a_f_y, lookupORforceMask, remainderM);
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_charges_f_z, j, a_f_z, lookupORforceMask, remainderM);
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask, remainderM);
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask, remainderM);
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask, remainderM);
+					}
+				}
+#endif
+
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_charges_f_x + i_charge_idx + local_i, sum_f1_x);
+				hSum_Add_Store(soa1_charges_f_y + i_charge_idx + local_i, sum_f1_y);
+				hSum_Add_Store(soa1_charges_f_z + i_charge_idx + local_i, sum_f1_z);
+				// Add old virial and summed calculated virials for center 1
+				hSum_Add_Store(soa1_charges_V_x + i_charge_idx + local_i, sum_V1_x);
+				hSum_Add_Store(soa1_charges_V_y + i_charge_idx + local_i, sum_V1_y);
+				hSum_Add_Store(soa1_charges_V_z + i_charge_idx + local_i, sum_V1_z);
+
+			}
+
+			// Computation of dipole-charge interactions
+
+			for (int local_i = 0; local_i < soa1_mol_dipoles_num[i]; local_i++)
+			{
+				const RealCalcVec p = RealCalcVec::broadcast(soa1_dipoles_p + i_dipole_charge_idx);
+				const RealCalcVec e_x = RealCalcVec::broadcast(soa1_dipoles_e_x + i_dipole_charge_idx);
+				const RealCalcVec e_y = RealCalcVec::broadcast(soa1_dipoles_e_y + i_dipole_charge_idx);
+				const RealCalcVec e_z = RealCalcVec::broadcast(soa1_dipoles_e_z + i_dipole_charge_idx);
+				const RealCalcVec r1_x = RealCalcVec::broadcast(soa1_dipoles_r_x + i_dipole_charge_idx);
+				const RealCalcVec r1_y = RealCalcVec::broadcast(soa1_dipoles_r_y + i_dipole_charge_idx);
+				const RealCalcVec r1_z = RealCalcVec::broadcast(soa1_dipoles_r_z + i_dipole_charge_idx);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_M_x = RealAccumVec::zero();
+				RealAccumVec sum_M_y = RealAccumVec::zero();
+				RealAccumVec sum_M_z = RealAccumVec::zero();
+
+				size_t j = ForcePolicy::InitJ2(i_charge_idx);
+				for (; j < end_charges_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_charges_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+
+						const RealCalcVec q = MaskGatherChooser::load(soa2_charges_q, j, lookupORforceMask);
+
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_charges_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_charges_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_charges_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_charges_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_charges_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_charges_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M_x, M_y, M_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyChargeDipole<CalculateMacroscopic>(
+								m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, q,
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, e_x, e_y, e_z, p,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M_x, M_y, M_z,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask));
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x - a_f_x;//negative, since dipole-charge, not charge-dipole -> direction inversed
+						sum_f1_y = sum_f1_y - a_f_y;
+						sum_f1_z = sum_f1_z - a_f_z;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_f_x, j, a_f_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_f_y, j, a_f_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_f_z, j, a_f_z, lookupORforceMask);//newton 3
+
+						//store virials
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask);//newton 3
+
+						// Store torque
+
+						sum_M_x = sum_M_x + M_x;
+						sum_M_y = sum_M_y + M_y;
+						sum_M_z = sum_M_z + M_z;
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_charges);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_charges);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_charges_dist_lookup, j, remainderM);
+						const RealCalcVec q = MaskGatherChooser::load(soa2_charges_q, j, lookupORforceMask);
+
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_charges_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_charges_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_charges_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_charges_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_charges_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_charges_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M_x, M_y, M_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyChargeDipole<CalculateMacroscopic>(
+								m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, q,
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, e_x, e_y, e_z, p,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M_x, M_y, M_z,
+								sum_upotXpoles, sum_virial,
+								remainderM);
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x - a_f_x;
+						sum_f1_y = sum_f1_y - a_f_y;
+						sum_f1_z = sum_f1_z - a_f_z;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_f_x, j, a_f_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_f_y, j, a_f_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_f_z, j, a_f_z, lookupORforceMask, remainderM);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+
+						// Store torque
+
+						sum_M_x = sum_M_x + M_x;
+						sum_M_y = sum_M_y + M_y;
+						sum_M_z = sum_M_z + M_z;
+					}
+				}
+#endif
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_dipoles_f_x + i_dipole_charge_idx, sum_f1_x);
+				hSum_Add_Store(soa1_dipoles_f_y + i_dipole_charge_idx, sum_f1_y);
+				hSum_Add_Store(soa1_dipoles_f_z + i_dipole_charge_idx, sum_f1_z);
+
+				// Add old virials and summed calculated virials for center 1
+				hSum_Add_Store(soa1_dipoles_V_x + i_dipole_charge_idx, sum_V1_x);
+				hSum_Add_Store(soa1_dipoles_V_y + i_dipole_charge_idx, sum_V1_y);
+				hSum_Add_Store(soa1_dipoles_V_z + i_dipole_charge_idx, sum_V1_z);
+
+				// Add old torques and summed calculated torques for center 1
+				hSum_Add_Store(soa1_dipoles_M_x + i_dipole_charge_idx, sum_M_x);
+				hSum_Add_Store(soa1_dipoles_M_y + i_dipole_charge_idx, sum_M_y);
+				hSum_Add_Store(soa1_dipoles_M_z + i_dipole_charge_idx, sum_M_z);
+
+				i_dipole_charge_idx++;
+			}
+
+			// Computation of quadrupole-charge interactions
+
+			for (int local_i = 0; local_i < soa1_mol_quadrupoles_num[i]; local_i++)
+			{
+				const RealCalcVec m = RealCalcVec::broadcast(soa1_quadrupoles_m + i_quadrupole_charge_idx);
+				const RealCalcVec e_x = RealCalcVec::broadcast(soa1_quadrupoles_e_x + i_quadrupole_charge_idx);
+				const RealCalcVec e_y = RealCalcVec::broadcast(soa1_quadrupoles_e_y + i_quadrupole_charge_idx);
+				const RealCalcVec e_z = RealCalcVec::broadcast(soa1_quadrupoles_e_z + i_quadrupole_charge_idx);
+				const RealCalcVec r1_x = RealCalcVec::broadcast(soa1_quadrupoles_r_x + i_quadrupole_charge_idx);
+				const RealCalcVec r1_y = RealCalcVec::broadcast(soa1_quadrupoles_r_y + i_quadrupole_charge_idx);
+				const RealCalcVec r1_z = RealCalcVec::broadcast(soa1_quadrupoles_r_z + i_quadrupole_charge_idx);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_M1_x = RealAccumVec::zero();
+				RealAccumVec sum_M1_y = RealAccumVec::zero();
+				RealAccumVec sum_M1_z = RealAccumVec::zero();
+
+				size_t j = ForcePolicy::InitJ2(i_charge_idx);
+				for (; j < end_charges_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_charges_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+
+						const RealCalcVec q = MaskGatherChooser::load(soa2_charges_q, j, lookupORforceMask);
+
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_charges_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_charges_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_charges_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_charges_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_charges_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_charges_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M_x, M_y, M_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyChargeQuadrupole<CalculateMacroscopic>(
+								m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, q,
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, e_x, e_y, e_z, m,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M_x, M_y, M_z,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask));
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x - a_f_x;
+						sum_f1_y = sum_f1_y - a_f_y;
+						sum_f1_z = sum_f1_z - a_f_z;
+
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_f_x, j, a_f_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_f_y, j, a_f_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_f_z, j, a_f_z, lookupORforceMask);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask);//newton 3
+
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M_x;
+						sum_M1_y = sum_M1_y + M_y;
+						sum_M1_z = sum_M1_z + M_z;
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_charges);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_charges);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_charges_dist_lookup, j, remainderM);
+						const RealCalcVec q = MaskGatherChooser::load(soa2_charges_q, j, lookupORforceMask);
+
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_charges_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_charges_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_charges_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_charges_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_charges_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_charges_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M_x, M_y, M_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyChargeQuadrupole<CalculateMacroscopic>(
+								m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, q,
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, e_x, e_y, e_z, m,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M_x, M_y, M_z,
+								sum_upotXpoles, sum_virial,
+								remainderM);
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x - a_f_x;
+						sum_f1_y = sum_f1_y - a_f_y;
+						sum_f1_z = sum_f1_z - a_f_z;
+
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_f_x, j, a_f_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_f_y, j, a_f_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_f_z, j, a_f_z, lookupORforceMask, remainderM);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M_x;
+						sum_M1_y = sum_M1_y + M_y;
+						sum_M1_z = sum_M1_z + M_z;
+
+					}
+				}
+#endif
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_quadrupoles_f_x + i_quadrupole_charge_idx, sum_f1_x);
+				hSum_Add_Store(soa1_quadrupoles_f_y + i_quadrupole_charge_idx, sum_f1_y);
+				hSum_Add_Store(soa1_quadrupoles_f_z + i_quadrupole_charge_idx, sum_f1_z);
+
+				// Add old virials and summed calculated virials for center 1
+				hSum_Add_Store(soa1_quadrupoles_V_x + i_quadrupole_charge_idx, sum_V1_x);
+				hSum_Add_Store(soa1_quadrupoles_V_y + i_quadrupole_charge_idx, sum_V1_y);
+				hSum_Add_Store(soa1_quadrupoles_V_z + i_quadrupole_charge_idx, sum_V1_z);
+
+				// Add old torques and summed calculated torques for center 1
+				hSum_Add_Store(soa1_quadrupoles_M_x + i_quadrupole_charge_idx, sum_M1_x);
+				hSum_Add_Store(soa1_quadrupoles_M_y + i_quadrupole_charge_idx, sum_M1_y);
+				hSum_Add_Store(soa1_quadrupoles_M_z + i_quadrupole_charge_idx, sum_M1_z);
+
+				i_quadrupole_charge_idx++;
+			}
+
+			i_charge_idx += soa1_mol_charges_num[i];
+		}
+
+		// Computation of site interactions with dipoles
+
+		// Continue with next molecule if no force has to be calculated
+		if (compute_molecule_dipoles==0) {
+			i_dipole_idx += soa1_mol_dipoles_num[i];
+			i_charge_dipole_idx += soa1_mol_charges_num[i];
+			i_quadrupole_dipole_idx += soa1_mol_quadrupoles_num[i];
+		}
+		else {
+			// Computation of dipole-dipole interactions
+
+			// Iterate over centers of actual molecule
+			for (int local_i = 0; local_i < soa1_mol_dipoles_num[i]; local_i++) {
+
+				const RealCalcVec p1 = RealCalcVec::broadcast(soa1_dipoles_p + i_dipole_idx + local_i);
+				const RealCalcVec e1_x = RealCalcVec::broadcast(soa1_dipoles_e_x + i_dipole_idx + local_i);
+				const RealCalcVec e1_y = RealCalcVec::broadcast(soa1_dipoles_e_y + i_dipole_idx + local_i);
+				const RealCalcVec e1_z = RealCalcVec::broadcast(soa1_dipoles_e_z + i_dipole_idx + local_i);
+				const RealCalcVec r1_x = RealCalcVec::broadcast(soa1_dipoles_r_x + i_dipole_idx + local_i);
+				const RealCalcVec r1_y = RealCalcVec::broadcast(soa1_dipoles_r_y + i_dipole_idx + local_i);
+				const RealCalcVec r1_z = RealCalcVec::broadcast(soa1_dipoles_r_z + i_dipole_idx + local_i);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_M1_x = RealAccumVec::zero();
+				RealAccumVec sum_M1_y = RealAccumVec::zero();
+				RealAccumVec sum_M1_z = RealAccumVec::zero();
+
+				// Iterate over centers of second cell
+				size_t j = ForcePolicy::InitJ2(i_dipole_idx + local_i);
+				for (; j < end_dipoles_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_dipoles_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+						const RealCalcVec p2 = MaskGatherChooser::load(soa2_dipoles_p, j, lookupORforceMask);
+						const RealCalcVec e2_x = MaskGatherChooser::load(soa2_dipoles_e_x, j, lookupORforceMask);
+						const RealCalcVec e2_y = MaskGatherChooser::load(soa2_dipoles_e_y, j, lookupORforceMask);
+						const RealCalcVec e2_z = MaskGatherChooser::load(soa2_dipoles_e_z, j, lookupORforceMask);
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_dipoles_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_dipoles_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_dipoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_dipoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_dipoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_dipoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M1_x, M1_y, M1_z, M2_x, M2_y, M2_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyDipole<CalculateMacroscopic>(
+							m1_r_x, m1_r_y, m1_r_z, r1_x, r1_y, r1_z, e1_x, e1_y, e1_z, p1,
+							m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, e2_x, e2_y, e2_z, p2,
+							f_x, f_y, f_z,
+							Vx, Vy, Vz,
+							M1_x, M1_y, M1_z,
+							M2_x, M2_y, M2_z,
+							sum_upotXpoles, sum_virial, sum_myRF,
+							MaskGatherChooser::getForceMask(lookupORforceMask),
+							epsRFInvrc3);
+
+					RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+					RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+					RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_dipoles_f_x, j, a_f_x, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_dipoles_f_y, j, a_f_y, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_dipoles_f_z, j, a_f_z, lookupORforceMask);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask);//newton 3
+
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M1_x;
+						sum_M1_y = sum_M1_y + M1_y;
+						sum_M1_z = sum_M1_z + M1_z;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_x, j, M2_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_y, j, M2_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_z, j, M2_z, lookupORforceMask);//newton 3
+
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_dipoles);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_dipoles);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_dipoles_dist_lookup, j, remainderM);
+						const RealCalcVec p2 = MaskGatherChooser::load(soa2_dipoles_p, j, lookupORforceMask);
+						const RealCalcVec e2_x = MaskGatherChooser::load(soa2_dipoles_e_x, j, lookupORforceMask);
+						const RealCalcVec e2_y = MaskGatherChooser::load(soa2_dipoles_e_y, j, lookupORforceMask);
+						const RealCalcVec e2_z = MaskGatherChooser::load(soa2_dipoles_e_z, j, lookupORforceMask);
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_dipoles_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_dipoles_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_dipoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_dipoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_dipoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_dipoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M1_x, M1_y, M1_z, M2_x, M2_y, M2_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyDipole<CalculateMacroscopic>(
+							m1_r_x, m1_r_y, m1_r_z, r1_x, r1_y, r1_z, e1_x, e1_y, e1_z, p1,
+							m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, e2_x, e2_y, e2_z, p2,
+							f_x, f_y, f_z,
+							Vx, Vy, Vz,
+							M1_x, M1_y, M1_z,
+							M2_x, M2_y, M2_z,
+							sum_upotXpoles, sum_virial, sum_myRF,
+							remainderM,
+							epsRFInvrc3);
+
+					RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+					RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+					RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_dipoles_f_x, j, a_f_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_dipoles_f_y, j, a_f_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_dipoles_f_z, j, a_f_z, lookupORforceMask, remainderM);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M1_x;
+						sum_M1_y = sum_M1_y + M1_y;
+						sum_M1_z = sum_M1_z + M1_z;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_x, j, M2_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_y, j, M2_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_z, j, M2_z, lookupORforceMask, remainderM);//newton 3
+
+					}
+				}
+#endif
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_dipoles_f_x + i_dipole_idx + local_i, sum_f1_x);
+				hSum_Add_Store(soa1_dipoles_f_y + i_dipole_idx + local_i, sum_f1_y);
+				hSum_Add_Store(soa1_dipoles_f_z + i_dipole_idx + local_i, sum_f1_z);
+
+				// Add old virials and summed calculated virials for center 1
+				hSum_Add_Store(soa1_dipoles_V_x + i_dipole_idx + local_i, sum_V1_x);
+				hSum_Add_Store(soa1_dipoles_V_y + i_dipole_idx + local_i, sum_V1_y);
+				hSum_Add_Store(soa1_dipoles_V_z + i_dipole_idx + local_i, sum_V1_z);
+
+				// Add old torques and summed calculated torques for center 1
+				hSum_Add_Store(soa1_dipoles_M_x + i_dipole_idx + local_i, sum_M1_x);
+				hSum_Add_Store(soa1_dipoles_M_y + i_dipole_idx + local_i, sum_M1_y);
+				hSum_Add_Store(soa1_dipoles_M_z + i_dipole_idx + local_i, sum_M1_z);
+
+			}
+
+			// Computation of charge-dipole interactions
+
+			for (int local_i = 0; local_i < soa1_mol_charges_num[i]; local_i++)
+			{
+
+				const RealCalcVec q = RealCalcVec::broadcast(soa1_charges_q + i_charge_dipole_idx);
+				const RealCalcVec r1_x = RealCalcVec::broadcast(soa1_charges_r_x + i_charge_dipole_idx);
+				const RealCalcVec r1_y = RealCalcVec::broadcast(soa1_charges_r_y + i_charge_dipole_idx);
+				const RealCalcVec r1_z = RealCalcVec::broadcast(soa1_charges_r_z + i_charge_dipole_idx);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				size_t j = ForcePolicy::InitJ2(i_dipole_idx);
+				for (; j < end_dipoles_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_dipoles_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+
+						const RealCalcVec p = MaskGatherChooser::load(soa2_dipoles_p, j, lookupORforceMask);
+
+						const RealCalcVec e_x = MaskGatherChooser::load(soa2_dipoles_e_x, j, lookupORforceMask);
+						const RealCalcVec e_y = MaskGatherChooser::load(soa2_dipoles_e_y, j, lookupORforceMask);
+						const RealCalcVec e_z = MaskGatherChooser::load(soa2_dipoles_e_z, j, lookupORforceMask);
+
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_dipoles_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_dipoles_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_dipoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_dipoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_dipoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_dipoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M_x, M_y, M_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyChargeDipole<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, r1_x, r1_y, r1_z, q,
+								m2_r_x, m2_r_y, m2_r_z,	r2_x, r2_y, r2_z, e_x, e_y, e_z, p,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M_x, M_y, M_z,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask));
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_dipoles_f_x, j, a_f_x, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_dipoles_f_y, j, a_f_y, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_dipoles_f_z, j, a_f_z, lookupORforceMask);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask);//newton 3
+
+						// Store torque
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_x, j, M_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_y, j, M_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_z, j, M_z, lookupORforceMask);//newton 3
+
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_dipoles);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_dipoles);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_dipoles_dist_lookup, j, remainderM);
+						const RealCalcVec p = MaskGatherChooser::load(soa2_dipoles_p, j, lookupORforceMask);
+
+						const RealCalcVec e_x = MaskGatherChooser::load(soa2_dipoles_e_x, j, lookupORforceMask);
+						const RealCalcVec e_y = MaskGatherChooser::load(soa2_dipoles_e_y, j, lookupORforceMask);
+						const RealCalcVec e_z = MaskGatherChooser::load(soa2_dipoles_e_z, j, lookupORforceMask);
+
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_dipoles_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_dipoles_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_dipoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_dipoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_dipoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_dipoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M_x, M_y, M_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyChargeDipole<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, r1_x, r1_y, r1_z, q,
+								m2_r_x, m2_r_y, m2_r_z,	r2_x, r2_y, r2_z, e_x, e_y, e_z, p,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M_x, M_y, M_z,
+								sum_upotXpoles, sum_virial,
+								remainderM);
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_dipoles_f_x, j, a_f_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_dipoles_f_y, j, a_f_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_dipoles_f_z, j, a_f_z, lookupORforceMask, remainderM);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+
+						// Store torque
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_x, j, M_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_y, j, M_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_z, j, M_z, lookupORforceMask, remainderM);//newton 3
+					}
+				}
+#endif
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_charges_f_x + i_charge_dipole_idx, sum_f1_x);
+				hSum_Add_Store(soa1_charges_f_y + i_charge_dipole_idx, sum_f1_y);
+				hSum_Add_Store(soa1_charges_f_z + i_charge_dipole_idx, sum_f1_z);
+
+				// Add old virials and summed calculated virials for center 1
+				hSum_Add_Store(soa1_charges_V_x + i_charge_dipole_idx, sum_V1_x);
+				hSum_Add_Store(soa1_charges_V_y + i_charge_dipole_idx, sum_V1_y);
+				hSum_Add_Store(soa1_charges_V_z + i_charge_dipole_idx, sum_V1_z);
+
+				i_charge_dipole_idx++;
+			}
+
+			// Computation of quadrupole-dipole interactions
+
+			// Iterate over centers of actual molecule
+			for (int local_i = 0; local_i < soa1_mol_quadrupoles_num[i]; local_i++) {
+
+				const RealCalcVec m = RealCalcVec::broadcast(soa1_quadrupoles_m + i_quadrupole_dipole_idx);
+				const RealCalcVec e1_x = RealCalcVec::broadcast(soa1_quadrupoles_e_x + i_quadrupole_dipole_idx);
+				const RealCalcVec e1_y = RealCalcVec::broadcast(soa1_quadrupoles_e_y + i_quadrupole_dipole_idx);
+				const RealCalcVec e1_z = RealCalcVec::broadcast(soa1_quadrupoles_e_z + i_quadrupole_dipole_idx);
+				const RealCalcVec r1_x = RealCalcVec::broadcast(soa1_quadrupoles_r_x + i_quadrupole_dipole_idx);
+				const RealCalcVec r1_y = RealCalcVec::broadcast(soa1_quadrupoles_r_y + i_quadrupole_dipole_idx);
+				const RealCalcVec r1_z = RealCalcVec::broadcast(soa1_quadrupoles_r_z + i_quadrupole_dipole_idx);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_M1_x = RealAccumVec::zero();
+				RealAccumVec sum_M1_y = RealAccumVec::zero();
+				RealAccumVec sum_M1_z = RealAccumVec::zero();
+
+				// Iterate over centers of second cell
+				size_t j = ForcePolicy::InitJ2(i_dipole_idx);
+				for (; j < end_dipoles_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_dipoles_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+						const RealCalcVec p = MaskGatherChooser::load(soa2_dipoles_p, j, lookupORforceMask);
+						const RealCalcVec e2_x = MaskGatherChooser::load(soa2_dipoles_e_x, j, lookupORforceMask);
+						const RealCalcVec e2_y = MaskGatherChooser::load(soa2_dipoles_e_y, j, lookupORforceMask);
+						const RealCalcVec e2_z = MaskGatherChooser::load(soa2_dipoles_e_z, j, lookupORforceMask);
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_dipoles_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_dipoles_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_dipoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_dipoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_dipoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_dipoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M1_x, M1_y, M1_z, M2_x, M2_y, M2_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyDipoleQuadrupole<CalculateMacroscopic>(
+								m2_r_x, m2_r_y, m2_r_z,	r2_x, r2_y, r2_z, e2_x, e2_y, e2_z, p,
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, e1_x, e1_y, e1_z, m,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M2_x, M2_y, M2_z, M1_x, M1_y, M1_z,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask));
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x - a_f_x;
+						sum_f1_y = sum_f1_y - a_f_y;
+						sum_f1_z = sum_f1_z - a_f_z;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_f_x, j, a_f_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_f_y, j, a_f_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_f_z, j, a_f_z, lookupORforceMask);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask);//newton 3
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M1_x;
+						sum_M1_y = sum_M1_y + M1_y;
+						sum_M1_z = sum_M1_z + M1_z;
+
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_x, j, M2_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_y, j, M2_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_z, j, M2_z, lookupORforceMask);//newton 3
+
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_dipoles);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_dipoles);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_dipoles_dist_lookup, j, remainderM);
+						const RealCalcVec p = MaskGatherChooser::load(soa2_dipoles_p, j, lookupORforceMask);
+						const RealCalcVec e2_x = MaskGatherChooser::load(soa2_dipoles_e_x, j, lookupORforceMask);
+						const RealCalcVec e2_y = MaskGatherChooser::load(soa2_dipoles_e_y, j, lookupORforceMask);
+						const RealCalcVec e2_z = MaskGatherChooser::load(soa2_dipoles_e_z, j, lookupORforceMask);
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_dipoles_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_dipoles_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_dipoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_dipoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_dipoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_dipoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M1_x, M1_y, M1_z, M2_x, M2_y, M2_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyDipoleQuadrupole<CalculateMacroscopic>(
+								m2_r_x, m2_r_y, m2_r_z,	r2_x, r2_y, r2_z, e2_x, e2_y, e2_z, p,
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, e1_x, e1_y, e1_z, m,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M2_x, M2_y, M2_z, M1_x, M1_y, M1_z,
+								sum_upotXpoles, sum_virial,
+								remainderM);
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x - a_f_x;
+						sum_f1_y = sum_f1_y - a_f_y;
+						sum_f1_z = sum_f1_z - a_f_z;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_f_x, j, a_f_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_f_y, j, a_f_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_f_z, j, a_f_z, lookupORforceMask, remainderM);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+
+
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M1_x;
+						sum_M1_y = sum_M1_y + M1_y;
+						sum_M1_z = sum_M1_z + M1_z;
+
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_x, j, M2_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_y, j, M2_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_z, j, M2_z, lookupORforceMask, remainderM);//newton 3
+
+					}
+				}
+#endif
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_quadrupoles_f_x + i_quadrupole_dipole_idx, sum_f1_x);
+				hSum_Add_Store(soa1_quadrupoles_f_y + i_quadrupole_dipole_idx, sum_f1_y);
+				hSum_Add_Store(soa1_quadrupoles_f_z + i_quadrupole_dipole_idx, sum_f1_z);
+
+				// Add old virials and summed calculated virials for center 1
+				hSum_Add_Store(soa1_quadrupoles_V_x + i_quadrupole_dipole_idx, sum_V1_x);
+				hSum_Add_Store(soa1_quadrupoles_V_y + i_quadrupole_dipole_idx, sum_V1_y);
+				hSum_Add_Store(soa1_quadrupoles_V_z + i_quadrupole_dipole_idx, sum_V1_z);
+
+				// Add old torques and summed calculated torques for center 1
+				hSum_Add_Store(soa1_quadrupoles_M_x + i_quadrupole_dipole_idx, sum_M1_x);
+				hSum_Add_Store(soa1_quadrupoles_M_y + i_quadrupole_dipole_idx, sum_M1_y);
+				hSum_Add_Store(soa1_quadrupoles_M_z + i_quadrupole_dipole_idx, sum_M1_z);
+
+				i_quadrupole_dipole_idx++;
+
+			}
+
+			i_dipole_idx += soa1_mol_dipoles_num[i];
+		}
+
+		// Computation of site interactions with quadrupoles
+
+		if (compute_molecule_quadrupoles==0) {
+			i_quadrupole_idx += soa1_mol_quadrupoles_num[i];
+			i_charge_quadrupole_idx += soa1_mol_charges_num[i];
+			i_dipole_quadrupole_idx += soa1_mol_dipoles_num[i];
+		}
+		else {
+			// Computation of quadrupole-quadrupole interactions
+
+			// Iterate over centers of actual molecule
+			for (int local_i = 0; local_i < soa1_mol_quadrupoles_num[i]; local_i++)
+			{
+				const RealCalcVec mii = RealCalcVec::broadcast(soa1_quadrupoles_m + i_quadrupole_idx + local_i);
+				const RealCalcVec eii_x = RealCalcVec::broadcast(soa1_quadrupoles_e_x + i_quadrupole_idx + local_i);
+				const RealCalcVec eii_y = RealCalcVec::broadcast(soa1_quadrupoles_e_y + i_quadrupole_idx + local_i);
+				const RealCalcVec eii_z = RealCalcVec::broadcast(soa1_quadrupoles_e_z + i_quadrupole_idx + local_i);
+				const RealCalcVec rii_x = RealCalcVec::broadcast(soa1_quadrupoles_r_x + i_quadrupole_idx + local_i);
+				const RealCalcVec rii_y = RealCalcVec::broadcast(soa1_quadrupoles_r_y + i_quadrupole_idx + local_i);
+				const RealCalcVec rii_z = RealCalcVec::broadcast(soa1_quadrupoles_r_z + i_quadrupole_idx + local_i);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_M1_x = RealAccumVec::zero();
+				RealAccumVec sum_M1_y = RealAccumVec::zero();
+				RealAccumVec sum_M1_z = RealAccumVec::zero();
+
+				// Iterate over centers of second cell
+				size_t j = ForcePolicy::InitJ2(i_quadrupole_idx + local_i);
+				for (; j < end_quadrupoles_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_quadrupoles_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+
+						const RealCalcVec mjj = MaskGatherChooser::load(soa2_quadrupoles_m, j, lookupORforceMask);
+						const RealCalcVec ejj_x = MaskGatherChooser::load(soa2_quadrupoles_e_x, j, lookupORforceMask);
+						const RealCalcVec ejj_y = MaskGatherChooser::load(soa2_quadrupoles_e_y, j, lookupORforceMask);
+						const RealCalcVec ejj_z = MaskGatherChooser::load(soa2_quadrupoles_e_z, j, lookupORforceMask);
+						const RealCalcVec rjj_x = MaskGatherChooser::load(soa2_quadrupoles_r_x, j, lookupORforceMask);
+						const RealCalcVec rjj_y = MaskGatherChooser::load(soa2_quadrupoles_r_y, j, lookupORforceMask);
+						const RealCalcVec rjj_z = MaskGatherChooser::load(soa2_quadrupoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_quadrupoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_quadrupoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_quadrupoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M1_x, M1_y, M1_z, M2_x, M2_y, M2_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyQuadrupole<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, rii_x, rii_y, rii_z, eii_x, eii_y, eii_z, mii,
+								m2_r_x, m2_r_y, m2_r_z,	rjj_x, rjj_y, rjj_z, ejj_x, ejj_y, ejj_z, mjj,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M1_x, M1_y, M1_z, M2_x, M2_y, M2_z,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask));
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_x, j, a_f_x, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_y, j, a_f_y, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_z, j, a_f_z, lookupORforceMask);//newton 3
+
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask);//newton 3
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M1_x;
+						sum_M1_y = sum_M1_y + M1_y;
+						sum_M1_z = sum_M1_z + M1_z;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_x, j, M2_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_y, j, M2_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_z, j, M2_z, lookupORforceMask);//newton 3
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_quadrupoles);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_quadrupoles);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_quadrupoles_dist_lookup, j, remainderM);
+						const RealCalcVec mjj = MaskGatherChooser::load(soa2_quadrupoles_m, j, lookupORforceMask);
+						const RealCalcVec ejj_x = MaskGatherChooser::load(soa2_quadrupoles_e_x, j, lookupORforceMask);
+						const RealCalcVec ejj_y = MaskGatherChooser::load(soa2_quadrupoles_e_y, j, lookupORforceMask);
+						const RealCalcVec ejj_z = MaskGatherChooser::load(soa2_quadrupoles_e_z, j, lookupORforceMask);
+						const RealCalcVec rjj_x = MaskGatherChooser::load(soa2_quadrupoles_r_x, j, lookupORforceMask);
+						const RealCalcVec rjj_y = MaskGatherChooser::load(soa2_quadrupoles_r_y, j, lookupORforceMask);
+						const RealCalcVec rjj_z = MaskGatherChooser::load(soa2_quadrupoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_quadrupoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_quadrupoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_quadrupoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M1_x, M1_y, M1_z, M2_x, M2_y, M2_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyQuadrupole<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, rii_x, rii_y, rii_z, eii_x, eii_y, eii_z, mii,
+								m2_r_x, m2_r_y, m2_r_z,	rjj_x, rjj_y, rjj_z, ejj_x, ejj_y, ejj_z, mjj,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M1_x, M1_y, M1_z, M2_x, M2_y, M2_z,
+								sum_upotXpoles, sum_virial,
+								remainderM);
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_x, j, a_f_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_y, j, a_f_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_z, j, a_f_z, lookupORforceMask, remainderM);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M1_x;
+						sum_M1_y = sum_M1_y + M1_y;
+						sum_M1_z = sum_M1_z + M1_z;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_x, j, M2_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_y, j, M2_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_z, j, M2_z, lookupORforceMask, remainderM);//newton 3
+					}
+				}
+#endif
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_quadrupoles_f_x + i_quadrupole_idx + local_i, sum_f1_x);
+				hSum_Add_Store(soa1_quadrupoles_f_y + i_quadrupole_idx + local_i, sum_f1_y);
+				hSum_Add_Store(soa1_quadrupoles_f_z + i_quadrupole_idx + local_i, sum_f1_z);
+
+				// Add old virials and summed calculated virials for center 1
+				hSum_Add_Store(soa1_quadrupoles_V_x + i_quadrupole_idx + local_i, sum_V1_x);
+				hSum_Add_Store(soa1_quadrupoles_V_y + i_quadrupole_idx + local_i, sum_V1_y);
+				hSum_Add_Store(soa1_quadrupoles_V_z + i_quadrupole_idx + local_i, sum_V1_z);
+
+				// Add old torques and summed calculated torques for center 1
+				hSum_Add_Store(soa1_quadrupoles_M_x + i_quadrupole_idx + local_i, sum_M1_x);
+				hSum_Add_Store(soa1_quadrupoles_M_y + i_quadrupole_idx + local_i, sum_M1_y);
+				hSum_Add_Store(soa1_quadrupoles_M_z + i_quadrupole_idx + local_i, sum_M1_z);
+
+			}
+
+			// Computation of charge-quadrupole interactions
+
+			for (int local_i = 0; local_i < soa1_mol_charges_num[i]; local_i++)
+			{
+				const RealCalcVec q = RealCalcVec::broadcast(soa1_charges_q + i_charge_quadrupole_idx);
+				const RealCalcVec r1_x = RealCalcVec::broadcast(soa1_charges_r_x + i_charge_quadrupole_idx);
+				const RealCalcVec r1_y = RealCalcVec::broadcast(soa1_charges_r_y + i_charge_quadrupole_idx);
+				const RealCalcVec r1_z = RealCalcVec::broadcast(soa1_charges_r_z + i_charge_quadrupole_idx);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				size_t j = ForcePolicy::InitJ2(i_quadrupole_idx);
+				for (; j < end_quadrupoles_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_quadrupoles_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+
+						const RealCalcVec m = MaskGatherChooser::load(soa2_quadrupoles_m, j, lookupORforceMask);
+						const RealCalcVec e_x = MaskGatherChooser::load(soa2_quadrupoles_e_x, j, lookupORforceMask);
+						const RealCalcVec e_y = MaskGatherChooser::load(soa2_quadrupoles_e_y, j, lookupORforceMask);
+						const RealCalcVec e_z = MaskGatherChooser::load(soa2_quadrupoles_e_z, j, lookupORforceMask);
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_quadrupoles_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_quadrupoles_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_quadrupoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_quadrupoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_quadrupoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_quadrupoles_m_r_z, j, lookupORforceMask);
+
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M_x, M_y, M_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyChargeQuadrupole<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, q,
+								m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, e_x, e_y, e_z, m,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M_x, M_y, M_z,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask));
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_x, j, a_f_x, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_y, j, a_f_y, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_z, j, a_f_z, lookupORforceMask);//newton 3
+
+						// Store forces
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask);//newton 3
+
+
+						// Store torque
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_x, j, M_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_y, j, M_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_z, j, M_z, lookupORforceMask);//newton 3
+
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_quadrupoles);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_quadrupoles);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_quadrupoles_dist_lookup, j, remainderM);
+						const RealCalcVec m = MaskGatherChooser::load(soa2_quadrupoles_m, j, lookupORforceMask);
+						const RealCalcVec e_x = MaskGatherChooser::load(soa2_quadrupoles_e_x, j, lookupORforceMask);
+						const RealCalcVec e_y = MaskGatherChooser::load(soa2_quadrupoles_e_y, j, lookupORforceMask);
+						const RealCalcVec e_z = MaskGatherChooser::load(soa2_quadrupoles_e_z, j, lookupORforceMask);
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_quadrupoles_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_quadrupoles_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_quadrupoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_quadrupoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_quadrupoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_quadrupoles_m_r_z, j, lookupORforceMask);
+
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M_x, M_y, M_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyChargeQuadrupole<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, q,
+								m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, e_x, e_y, e_z, m,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M_x, M_y, M_z,
+								sum_upotXpoles, sum_virial,
+								remainderM);
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_x, j, a_f_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_y, j, a_f_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_z, j, a_f_z, lookupORforceMask, remainderM);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+
+
+						// Store torque
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_x, j, M_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_y, j, M_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_z, j, M_z, lookupORforceMask, remainderM);//newton 3
+
+					}
+				}
+#endif
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_charges_f_x + i_charge_quadrupole_idx, sum_f1_x);
+				hSum_Add_Store(soa1_charges_f_y + i_charge_quadrupole_idx, sum_f1_y);
+				hSum_Add_Store(soa1_charges_f_z + i_charge_quadrupole_idx, sum_f1_z);
+				// Add old virials and summed calculated virials for center 1
+				hSum_Add_Store(soa1_charges_V_x + i_charge_quadrupole_idx, sum_V1_x);
+				hSum_Add_Store(soa1_charges_V_y + i_charge_quadrupole_idx, sum_V1_y);
+				hSum_Add_Store(soa1_charges_V_z + i_charge_quadrupole_idx, sum_V1_z);
+
+				i_charge_quadrupole_idx++;
+			}
+
+			// Computation of dipole-quadrupole interactions
+
+			// Iterate over centers of actual molecule
+			for (int local_i = 0; local_i < soa1_mol_dipoles_num[i]; local_i++)
+			{
+				const RealCalcVec p = RealCalcVec::broadcast(soa1_dipoles_p + i_dipole_quadrupole_idx);
+				const RealCalcVec eii_x = RealCalcVec::broadcast(soa1_dipoles_e_x + i_dipole_quadrupole_idx);
+				const RealCalcVec eii_y = RealCalcVec::broadcast(soa1_dipoles_e_y + i_dipole_quadrupole_idx);
+				const RealCalcVec eii_z = RealCalcVec::broadcast(soa1_dipoles_e_z + i_dipole_quadrupole_idx);
+				const RealCalcVec rii_x = RealCalcVec::broadcast(soa1_dipoles_r_x + i_dipole_quadrupole_idx);
+				const RealCalcVec rii_y = RealCalcVec::broadcast(soa1_dipoles_r_y + i_dipole_quadrupole_idx);
+				const RealCalcVec rii_z = RealCalcVec::broadcast(soa1_dipoles_r_z + i_dipole_quadrupole_idx);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_M1_x = RealAccumVec::zero();
+				RealAccumVec sum_M1_y = RealAccumVec::zero();
+				RealAccumVec sum_M1_z = RealAccumVec::zero();
+
+				// Iterate over centers of second cell
+				size_t j = ForcePolicy::InitJ2(i_quadrupole_idx);
+				for (; j < end_quadrupoles_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_quadrupoles_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+
+						const RealCalcVec m = MaskGatherChooser::load(soa2_quadrupoles_m, j, lookupORforceMask);
+						const RealCalcVec ejj_x = MaskGatherChooser::load(soa2_quadrupoles_e_x, j, lookupORforceMask);
+						const RealCalcVec ejj_y = MaskGatherChooser::load(soa2_quadrupoles_e_y, j, lookupORforceMask);
+						const RealCalcVec ejj_z = MaskGatherChooser::load(soa2_quadrupoles_e_z, j, lookupORforceMask);
+						const RealCalcVec rjj_x = MaskGatherChooser::load(soa2_quadrupoles_r_x, j, lookupORforceMask);
+						const RealCalcVec rjj_y = MaskGatherChooser::load(soa2_quadrupoles_r_y, j, lookupORforceMask);
+						const RealCalcVec rjj_z = MaskGatherChooser::load(soa2_quadrupoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_quadrupoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_quadrupoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_quadrupoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M1_x, M1_y, M1_z, M2_x, M2_y, M2_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyDipoleQuadrupole<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, rii_x, rii_y, rii_z, eii_x, eii_y, eii_z, p,
+								m2_r_x, m2_r_y, m2_r_z,	rjj_x, rjj_y, rjj_z, ejj_x, ejj_y, ejj_z, m,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M1_x, M1_y, M1_z, M2_x, M2_y, M2_z,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask));
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_x, j, a_f_x, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_y, j, a_f_y, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_z, j, a_f_z, lookupORforceMask);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask);//newton 3
+
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M1_x;
+						sum_M1_y = sum_M1_y + M1_y;
+						sum_M1_z = sum_M1_z + M1_z;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_x, j, M2_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_y, j, M2_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_z, j, M2_z, lookupORforceMask);//newton 3
+
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_quadrupoles);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_quadrupoles);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_quadrupoles_dist_lookup, j, remainderM);
+						const RealCalcVec m = MaskGatherChooser::load(soa2_quadrupoles_m, j, lookupORforceMask);
+						const RealCalcVec ejj_x = MaskGatherChooser::load(soa2_quadrupoles_e_x, j, lookupORforceMask);
+						const RealCalcVec ejj_y = MaskGatherChooser::load(soa2_quadrupoles_e_y, j, lookupORforceMask);
+						const RealCalcVec ejj_z = MaskGatherChooser::load(soa2_quadrupoles_e_z, j, lookupORforceMask);
+						const RealCalcVec rjj_x = MaskGatherChooser::load(soa2_quadrupoles_r_x, j, lookupORforceMask);
+						const RealCalcVec rjj_y = MaskGatherChooser::load(soa2_quadrupoles_r_y, j, lookupORforceMask);
+						const RealCalcVec rjj_z = MaskGatherChooser::load(soa2_quadrupoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_quadrupoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_quadrupoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_quadrupoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M1_x, M1_y, M1_z, M2_x, M2_y, M2_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyDipoleQuadrupole<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, rii_x, rii_y, rii_z, eii_x, eii_y, eii_z, p,
+								m2_r_x, m2_r_y, m2_r_z,	rjj_x, rjj_y, rjj_z, ejj_x, ejj_y, ejj_z, m,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M1_x, M1_y, M1_z, M2_x, M2_y, M2_z,
+								sum_upotXpoles, sum_virial,
+								remainderM);
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_x, j, a_f_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_y, j, a_f_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_z, j, a_f_z, lookupORforceMask, remainderM);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M1_x;
+						sum_M1_y = sum_M1_y + M1_y;
+						sum_M1_z = sum_M1_z + M1_z;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_x, j, M2_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_y, j, M2_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_z, j, M2_z, lookupORforceMask, remainderM);//newton 3
+
+					}
+				}
+#endif
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_dipoles_f_x + i_dipole_quadrupole_idx, sum_f1_x);
+				hSum_Add_Store(soa1_dipoles_f_y + i_dipole_quadrupole_idx, sum_f1_y);
+				hSum_Add_Store(soa1_dipoles_f_z + i_dipole_quadrupole_idx, sum_f1_z);
+
+				// Add old virials and summed calculated virials for center 1
+				hSum_Add_Store(soa1_dipoles_V_x + i_dipole_quadrupole_idx, sum_V1_x);
+				hSum_Add_Store(soa1_dipoles_V_y + i_dipole_quadrupole_idx, sum_V1_y);
+				hSum_Add_Store(soa1_dipoles_V_z + i_dipole_quadrupole_idx, sum_V1_z);
+
+				// Add old torques and summed calculated torques for center 1
+				hSum_Add_Store(soa1_dipoles_M_x + i_dipole_quadrupole_idx, sum_M1_x);
+				hSum_Add_Store(soa1_dipoles_M_y + i_dipole_quadrupole_idx, sum_M1_y);
+				hSum_Add_Store(soa1_dipoles_M_z + i_dipole_quadrupole_idx, sum_M1_z);
+
+				i_dipole_quadrupole_idx++;
+
+			}
+
+			i_quadrupole_idx += soa1_mol_quadrupoles_num[i];
+		}
+	}
+
+	vcp_real_accum upot6lj = 0.0, upotXpoles = 0.0, virial = 0.0, myRF = 0.0;
+	hSum_Add_Store(&upot6lj, sum_upot6lj);
+	hSum_Add_Store(&upotXpoles, sum_upotXpoles);
+	hSum_Add_Store(&virial, sum_virial);
+	hSum_Add_Store(&myRF, sum_myRF);
+	my_threadData._upot6lj += upot6lj;
+	my_threadData._upotXpoles += upotXpoles;
+	my_threadData._virial += virial;
+	my_threadData._myRF -= myRF;
+
+} // void LennardJonesCellHandler::CalculatePairs_(LJSoA & soa1, LJSoA & soa2)
+
+template<typename calc_t, typename accum_t, class ForcePolicy, bool CalculateMacroscopic>
+vcp_inline void VectorizedCellProcessorKernel::_calculatePairsLJ(CellDataSoA & soa1, CellDataSoA & soa2) {
+	ThreadData &my_threadData = _threadData;
+
+	typedef ConcSites::SiteType SiteType;
+	typedef ConcSites::CoordinateType Coordinate;
+	typedef CellDataSoA::QuantityType QuantityType;
+
+	const vcp_real_calc * const soa1_ljc_m_r_x = soa1.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc * const soa1_ljc_m_r_y = soa1.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc * const soa1_ljc_m_r_z = soa1.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::Z);
+	const vcp_real_calc * const soa1_ljc_r_x = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc * const soa1_ljc_r_y = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc * const soa1_ljc_r_z = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Z);
+	vcp_real_accum * const soa1_ljc_f_x = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::X);
+	vcp_real_accum * const soa1_ljc_f_y = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Y);
+	vcp_real_accum * const soa1_ljc_f_z = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Z);
+	vcp_real_accum * const soa1_ljc_V_x = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::X);
+	vcp_real_accum * const soa1_ljc_V_y = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Y);
+	vcp_real_accum * const soa1_ljc_V_z = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Z);
+	const vcp_ljc_id_t * const soa1_ljc_id = soa1._ljc_id;
+
+	const vcp_real_calc * const soa2_ljc_m_r_x = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc * const soa2_ljc_m_r_y = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc * const soa2_ljc_m_r_z = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::Z);
+	const vcp_real_calc * const soa2_ljc_r_x = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc * const soa2_ljc_r_y = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc * const soa2_ljc_r_z = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Z);
+	vcp_real_accum * const soa2_ljc_f_x = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::X);
+	vcp_real_accum * const soa2_ljc_f_y = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Y);
+	vcp_real_accum * const soa2_ljc_f_z = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Z);
+	vcp_real_accum * const soa2_ljc_V_x = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::X);
+	vcp_real_accum * const soa2_ljc_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Y);
+	vcp_real_accum * const soa2_ljc_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Z);
+	const vcp_ljc_id_t * const soa2_ljc_id = soa2._ljc_id;
+
+	const size_t soa1_ljc_num = soa1._ljc_num;
+	const size_t soa2_ljc_num = soa2._ljc_num;
+	const calc_t rc2 = static_cast<calc_t>(_LJCutoffRadiusSquare);
+
+	accum_t sum_upot6lj = 0, sum_virial = 0;
+
+	for (size_t i = 0; i < soa1_ljc_num; ++i) {
+		const vcp_real_calc m1_r_x = soa1_ljc_m_r_x[i];
+		const vcp_real_calc m1_r_y = soa1_ljc_m_r_y[i];
+		const vcp_real_calc m1_r_z = soa1_ljc_m_r_z[i];
+		const vcp_real_calc c1_r_x = soa1_ljc_r_x[i];
+		const vcp_real_calc c1_r_y = soa1_ljc_r_y[i];
+		const vcp_real_calc c1_r_z = soa1_ljc_r_z[i];
+		const vcp_real_calc * const eps_sig = _eps_sig[soa1_ljc_id[i]];
+		const vcp_real_calc * const shift6 = _shift6[soa1_ljc_id[i]];
+
+		accum_t sum_f_x = 0, sum_f_y = 0, sum_f_z = 0;
+		accum_t sum_V_x = 0, sum_V_y = 0, sum_V_z = 0;
+
+		#pragma omp simd reduction(+ : sum_f_x, sum_f_y, sum_f_z, sum_V_x, sum_V_y, sum_V_z, sum_upot6lj, sum_virial)
+		for (size_t j = ForcePolicy::FirstJ(i); j < soa2_ljc_num; ++j) {
+			const calc_t m_dx = static_cast<calc_t>(m1_r_x - soa2_ljc_m_r_x[j]);
+			const calc_t m_dy = static_cast<calc_t>(m1_r_y - soa2_ljc_m_r_y[j]);
+			const calc_t m_dz = static_cast<calc_t>(m1_r_z - soa2_ljc_m_r_z[j]);
+			const calc_t m_r2 = m_dx * m_dx + m_dy * m_dy + m_dz * m_dz;
+			const bool forceMask = ForcePolicy::Condition(m_r2, rc2);
+
+			const calc_t c_dx = static_cast<calc_t>(c1_r_x - soa2_ljc_r_x[j]);
+			const calc_t c_dy = static_cast<calc_t>(c1_r_y - soa2_ljc_r_y[j]);
+			const calc_t c_dz = static_cast<calc_t>(c1_r_z - soa2_ljc_r_z[j]);
+			const calc_t c_r2 = c_dx * c_dx + c_dy * c_dy + c_dz * c_dz;
+			const calc_t r2_inv = forceMask ? calc_t(1) / c_r2 : calc_t(0);
+
+			const vcp_ljc_id_t id_j = soa2_ljc_id[j];
+			const calc_t eps_24 = static_cast<calc_t>(eps_sig[2 * id_j]);
+			const calc_t sig2 = static_cast<calc_t>(eps_sig[2 * id_j + 1]);
+
+			const calc_t lj2 = sig2 * r2_inv;
+			const calc_t lj6 = lj2 * lj2 * lj2;
+			const calc_t lj12 = lj6 * lj6;
+			const calc_t lj12m6 = lj12 - lj6;
+			const calc_t scale = eps_24 * r2_inv * (lj12 + lj12m6);
+
+			const calc_t f_x = c_dx * scale;
+			const calc_t f_y = c_dy * scale;
+			const calc_t f_z = c_dz * scale;
+			const accum_t V_x = static_cast<accum_t>(m_dx * f_x);
+			const accum_t V_y = static_cast<accum_t>(m_dy * f_y);
+			const accum_t V_z = static_cast<accum_t>(m_dz * f_z);
+
+			soa2_ljc_f_x[j] -= f_x;
+			soa2_ljc_f_y[j] -= f_y;
+			soa2_ljc_f_z[j] -= f_z;
+			soa2_ljc_V_x[j] += V_x;
+			soa2_ljc_V_y[j] += V_y;
+			soa2_ljc_V_z[j] += V_z;
+
+			sum_f_x += f_x;
+			sum_f_y += f_y;
+			sum_f_z += f_z;
+			sum_V_x += V_x;
+			sum_V_y += V_y;
+			sum_V_z += V_z;
+
+			if (CalculateMacroscopic) {
+				const calc_t upot = forceMask ? eps_24 * lj12m6 + static_cast<calc_t>(shift6[id_j]) : calc_t(0);
+				sum_upot6lj += upot;
+				sum_virial += V_x + V_y + V_z;
+			}
+		}
+
+		soa1_ljc_f_x[i] += sum_f_x;
+		soa1_ljc_f_y[i] += sum_f_y;
+		soa1_ljc_f_z[i] += sum_f_z;
+		soa1_ljc_V_x[i] += sum_V_x;
+		soa1_ljc_V_y[i] += sum_V_y;
+		soa1_ljc_V_z[i] += sum_V_z;
+	}
+
+	if (CalculateMacroscopic) {
+		my_threadData._upot6lj += sum_upot6lj;
+		my_threadData._virial += sum_virial;
+	}
+}
+
+template<bool CalculateMacroscopic, bool EwaldSplitting>
+void VectorizedCellProcessorKernel::_calculatePairsCells(CellDataSoA& soa1, CellDataSoA& soa2,
+		const VerletClusterList* verletList) {
+	const bool ApplyCutoff = true;
+	if (&soa1 == &soa2) {
+		_calculatePairs<SingleCellPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC, EwaldSplitting>(soa1, soa2, verletList);
+	} else {
+		_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC, EwaldSplitting>(soa1, soa2, verletList);
+	}
+}
+
+template<typename calc_t, typename accum_t, bool CalculateMacroscopic>
+void VectorizedCellProcessorKernel::_calculatePairsLJCells(CellDataSoA& soa1, CellDataSoA& soa2) {
+	const bool ApplyCutoff = true;
+	if (&soa1 == &soa2) {
+		_calculatePairsLJ<calc_t, accum_t, SingleCellPolicy_<ApplyCutoff>, CalculateMacroscopic>(soa1, soa2);
+	} else {
+		_calculatePairsLJ<calc_t, accum_t, CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic>(soa1, soa2);
+	}
+}
+
+inline VectorizedCellProcessorKernel::KernelThreadData* VectorizedCellProcessorKernel::createThreadData() {
+	return new ThreadData();
+}
+
+inline void VectorizedCellProcessorKernel::deleteThreadData(KernelThreadData* threadData) {
+	delete static_cast<ThreadData*>(threadData);
+}
+
+inline void VectorizedCellProcessorKernel::calculatePairs(const KernelParameters& parameters, KernelThreadData& threadData,
+		CellDataSoA& soa1, CellDataSoA& soa2, const VerletClusterList* verletList, bool calculateMacroscopic) {
+	VectorizedCellProcessorKernel kernel(parameters, threadData);
+	if (calculateMacroscopic) {
+		if (kernel._ewaldAlpha > 0.0) {
+			kernel._calculatePairsCells<true, true>(soa1, soa2, verletList);
+		} else {
+			kernel._calculatePairsCells<true, false>(soa1, soa2, verletList);
+		}
+	} else {
+		if (kernel._ewaldAlpha > 0.0) {
+			kernel._calculatePairsCells<false, true>(soa1, soa2, verletList);
+		} else {
+			kernel._calculatePairsCells<false, false>(soa1, soa2, verletList);
+		}
+	}
+}
+
+inline void VectorizedCellProcessorKernel::calculatePairsLJ(const KernelParameters& parameters, KernelThreadData& threadData,
+		CellDataSoA& soa1, CellDataSoA& soa2, Precision precision, bool calculateMacroscopic) {
+	VectorizedCellProcessorKernel kernel(parameters, threadData);
+	switch (precision) {
+	case Precision::SPSP:
+		if (calculateMacroscopic) {
+			kernel._calculatePairsLJCells<float, float, true>(soa1, soa2);
+		} else {
+			kernel._calculatePairsLJCells<float, float, false>(soa1, soa2);
+		}
+		break;
+	case Precision::SPDP:
+		if (calculateMacroscopic) {
+			kernel._calculatePairsLJCells<float, double, true>(soa1, soa2);
+		} else {
+			kernel._calculatePairsLJCells<float, double, false>(soa1, soa2);
+		}
+		break;
+	default:
+		mardyn_assert(precision == Precision::DPDP);
+		if (calculateMacroscopic) {
+			kernel._calculatePairsLJCells<double, double, true>(soa1, soa2);
+		} else {
+			kernel._calculatePairsLJCells<double, double, false>(soa1, soa2);
+		}
+	}
+}
+
+inline double VectorizedCellProcessorKernel::calculateTestMolecule(const KernelParameters& parameters,
+		KernelThreadData& threadData, CellDataSoA& testSoA, CellDataSoA& soa) {
+	// _calculatePairs adds to the sums of the thread, keep those of an ongoing traversal
+	const KernelThreadData sums = threadData;
+	threadData._upot6lj = threadData._upotXpoles = threadData._virial = threadData._myRF = 0.0;
+
+	VectorizedCellProcessorKernel kernel(parameters, threadData);
+	const bool CalculateMacroscopic = true;
+	const bool ApplyCutoff = true;
+	if (kernel._ewaldAlpha > 0.0) {
+		kernel._calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, ReadOnlyChooser<MaskGatherC>, true>(testSoA, soa);
+	} else {
+		kernel._calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, ReadOnlyChooser<MaskGatherC>, false>(testSoA, soa);
+	}
+
+	const double upot = threadData._upot6lj / 6.0 + threadData._upotXpoles + threadData._myRF;
+	threadData = sums;
+	return upot;
+}
+
+inline const VectorizedCellProcessorKernel::KernelTable& VectorizedCellProcessorKernel::table() {
+	// function-local, so that nothing is set up at program start
+	static const KernelTable kernels = {
+#if VCP_VEC_WIDTH == VCP_VEC_W_512
+		VectorizedCellProcessor::InstructionSet::AVX512F,
+#elif VCP_VEC_TYPE == VCP_VEC_AVX2
+		VectorizedCellProcessor::InstructionSet::AVX2,
+#else
+		VectorizedCellProcessor::InstructionSet::DEFAULT,
+#endif
+		VCP_VEC_SIZE,
+#if VCP_VEC_TYPE == VCP_NOVEC
+		"no",
+#elif VCP_VEC_TYPE == VCP_VEC_SSE3
+		"SSE3",
+#elif VCP_VEC_TYPE == VCP_VEC_AVX
+		"AVX",
+#elif VCP_VEC_TYPE == VCP_VEC_AVX2
+		"AVX2",
+#elif VCP_VEC_TYPE == VCP_VEC_KNL or VCP_VEC_TYPE == VCP_VEC_KNL_GATHER
+		"KNL",
+#else
+		"SKX",
+#endif
+		&createThreadData, &deleteThreadData, &calculatePairs, &calculatePairsLJ, &calculateTestMolecule
+	};
+	return kernels;
+}
+
+} /* namespace VCP_ISA_NAMESPACE */
+} /* namespace vcp */
+
+#endif /* SRC_PARTICLECONTAINER_ADAPTER_VECTORIZEDCELLPROCESSORKERNEL_H_ */
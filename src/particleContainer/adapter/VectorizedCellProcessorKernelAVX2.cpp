@@ -0,0 +1,16 @@
+/*
+ * VectorizedCellProcessorKernelAVX2.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+/*
+ * Kernels of the VectorizedCellProcessor for AVX2, compiled with the additional flags
+ * CXXFLAGS_VCP_KERNEL_AVX2 (makefile/cfg) or the corresponding COMPILE_OPTIONS (src/CMakeLists.txt).
+ */
+
+#include "VectorizedCellProcessorKernel.h"
+
+const VectorizedCellProcessor::KernelTable& VectorizedCellProcessor::kernelTableAVX2() {
+	return vcp::VectorizedCellProcessorKernel::table();
+}
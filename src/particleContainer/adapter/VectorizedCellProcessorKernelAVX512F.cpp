@@ -0,0 +1,16 @@
+/*
+ * VectorizedCellProcessorKernelAVX512F.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+/*
+ * Kernels of the VectorizedCellProcessor for AVX-512 (F and DQ), compiled with the additional flags
+ * CXXFLAGS_VCP_KERNEL_AVX512F (makefile/cfg) or the corresponding COMPILE_OPTIONS (src/CMakeLists.txt).
+ */
+
+#include "VectorizedCellProcessorKernel.h"
+
+const VectorizedCellProcessor::KernelTable& VectorizedCellProcessor::kernelTableAVX512F() {
+	return vcp::VectorizedCellProcessorKernel::table();
+}
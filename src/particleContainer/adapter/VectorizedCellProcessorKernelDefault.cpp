@@ -0,0 +1,15 @@
+/*
+ * VectorizedCellProcessorKernelDefault.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+/*
+ * Kernels of the VectorizedCellProcessor for the flags of the build.
+ */
+
+#include "VectorizedCellProcessorKernel.h"
+
+const VectorizedCellProcessor::KernelTable& VectorizedCellProcessor::kernelTableDefault() {
+	return vcp::VectorizedCellProcessorKernel::table();
+}
@@ -0,0 +1,74 @@
+/*
+ * VerletClusterList.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#include "VerletClusterList.h"
+#include "CellDataSoA.h"
+
+#include <algorithm>
+
+VerletClusterList::VerletClusterList(unsigned long otherCellIndex) :
+		_otherCellIndex(otherCellIndex), _built(false), _layoutVersion1(0), _layoutVersion2(0),
+		_displacement1(0.0), _displacement2(0.0), _buildStep(0), _chunkSize(0), _wordsPerMolecule(0), _typeOffset{0, 0, 0, 0}, _masks() {
+}
+
+void VerletClusterList::build(const CellDataSoA& soa1, const CellDataSoA& soa2, double ljcRadiusSquare, double radiusSquare,
+		size_t chunkSize) {
+	typedef ConcSites::SiteType SiteType;
+	typedef ConcSites::CoordinateType Coordinate;
+	typedef CellDataSoA::QuantityType QuantityType;
+
+	const std::array<SiteType, 4> siteTypes = {SiteType::LJC, SiteType::CHARGE, SiteType::DIPOLE, SiteType::QUADRUPOLE};
+	const std::array<size_t, 4> numSites = {soa2._ljc_num, soa2._charges_num, soa2._dipoles_num, soa2._quadrupoles_num};
+
+	std::array<size_t, 4> numChunks;
+	_wordsPerMolecule = 0;
+	for (int t = 0; t < 4; ++t) {
+		numChunks[t] = (numSites[t] + chunkSize - 1) / chunkSize;
+		_typeOffset[t] = _wordsPerMolecule;
+		_wordsPerMolecule += (numChunks[t] + 63) / 64;
+	}
+
+	const size_t numMolecules = soa1.getMolNum();
+	_masks.assign(numMolecules * _wordsPerMolecule, 0ul);
+
+	const vcp_real_calc * const soa1_mol_pos_x = soa1._mol_pos.xBegin();
+	const vcp_real_calc * const soa1_mol_pos_y = soa1._mol_pos.yBegin();
+	const vcp_real_calc * const soa1_mol_pos_z = soa1._mol_pos.zBegin();
+
+	for (int t = 0; t < 4; ++t) {
+		if (numSites[t] == 0) {
+			continue;
+		}
+		const double rc2 = (siteTypes[t] == SiteType::LJC) ? ljcRadiusSquare : radiusSquare;
+		const vcp_real_calc * const soa2_m_r_x = soa2.getBeginCalc(QuantityType::MOL_POSITION, siteTypes[t], Coordinate::X);
+		const vcp_real_calc * const soa2_m_r_y = soa2.getBeginCalc(QuantityType::MOL_POSITION, siteTypes[t], Coordinate::Y);
+		const vcp_real_calc * const soa2_m_r_z = soa2.getBeginCalc(QuantityType::MOL_POSITION, siteTypes[t], Coordinate::Z);
+
+		for (size_t i = 0; i < numMolecules; ++i) {
+			const double m1_r_x = soa1_mol_pos_x[i];
+			const double m1_r_y = soa1_mol_pos_y[i];
+			const double m1_r_z = soa1_mol_pos_z[i];
+			uint64_t * const chunkMask = _masks.data() + i * _wordsPerMolecule + _typeOffset[t];
+
+			for (size_t c = 0; c < numChunks[t]; ++c) {
+				const size_t jBegin = c * chunkSize;
+				const size_t jEnd = std::min(jBegin + chunkSize, numSites[t]);
+				int inRange = 0;
+				for (size_t j = jBegin; j < jEnd; ++j) {
+					const double dx = m1_r_x - soa2_m_r_x[j];
+					const double dy = m1_r_y - soa2_m_r_y[j];
+					const double dz = m1_r_z - soa2_m_r_z[j];
+					inRange |= static_cast<int>(dx * dx + dy * dy + dz * dz < rc2);
+				}
+				if (inRange) {
+					chunkMask[c >> 6] |= (1ul << (c & 63));
+				}
+			}
+		}
+	}
+	_chunkSize = chunkSize;
+	_built = true;
+}
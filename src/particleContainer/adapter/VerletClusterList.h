@@ -0,0 +1,117 @@
+/*
+ * VerletClusterList.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_PARTICLECONTAINER_ADAPTER_VERLETCLUSTERLIST_H_
+#define SRC_PARTICLECONTAINER_ADAPTER_VERLETCLUSTERLIST_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "utils/ConcatenatedSites.h"
+
+class CellDataSoA;
+
+/**
+ * \brief Verlet list for one (ordered) pair of cells, used by the VectorizedCellProcessor.
+ * \details The list does not store particle pointers, but - for every molecule i of the first cell and every
+ * site type - a bit mask over the SIMD chunks (one vector of consecutive sites of the kernel in use) of the second cell.
+ * A bit is set, if at least one site of the chunk lies within cutoff + skin of molecule i at build time.
+ * During force calculation only the distances of flagged chunks are computed, the actual cutoff test is
+ * still done by the regular dist lookup, so the kernels themselves stay unchanged.
+ *
+ * The indices refer to the CellDataSoA layouts of both cells, so a list is only valid as long as neither
+ * layout has been rebuilt (see FullParticleCell::getSoALayoutVersion()) and as long as no molecule of either
+ * cell moved further than skin/2 since the list was built (see FullParticleCell::getVerletDisplacement()).
+ */
+class VerletClusterList {
+public:
+	explicit VerletClusterList(unsigned long otherCellIndex = 0);
+
+	/**
+	 * \brief Build the list for all molecules of soa1 against all sites of soa2.
+	 * \param ljcRadiusSquare squared interaction radius (LJ cutoff + skin) for LJ centers
+	 * \param radiusSquare squared interaction radius (cutoff + skin) for charges, dipoles and quadrupoles
+	 * \param chunkSize number of sites per chunk, the vector size of the kernel using the list
+	 */
+	void build(const CellDataSoA& soa1, const CellDataSoA& soa2, double ljcRadiusSquare, double radiusSquare,
+			size_t chunkSize);
+
+	/**
+	 * \brief Check whether the list can be reused.
+	 * \param layoutVersion1 current layout version of the first cell
+	 * \param layoutVersion2 current layout version of the second cell
+	 * \param displacement1 current accumulated displacement of the first cell
+	 * \param displacement2 current accumulated displacement of the second cell
+	 * \param halfSkin half of the skin
+	 * \param step current simulation step
+	 * \param rebuildFrequency maximum number of steps after which the list is rebuilt anyway
+	 */
+	bool isValid(unsigned long layoutVersion1, unsigned long layoutVersion2, double displacement1, double displacement2,
+			double halfSkin, unsigned long step, unsigned rebuildFrequency) const {
+		return _built
+				and layoutVersion1 == _layoutVersion1 and layoutVersion2 == _layoutVersion2
+				and displacement1 - _displacement1 <= halfSkin and displacement2 - _displacement2 <= halfSkin
+				and step - _buildStep < rebuildFrequency;
+	}
+
+	//! remember the state of both cells at build time
+	void setBuildState(unsigned long layoutVersion1, unsigned long layoutVersion2, double displacement1,
+			double displacement2, unsigned long step) {
+		_layoutVersion1 = layoutVersion1;
+		_layoutVersion2 = layoutVersion2;
+		_displacement1 = displacement1;
+		_displacement2 = displacement2;
+		_buildStep = step;
+	}
+
+	/**
+	 * \brief Get the chunk mask of molecule i of the first cell for one site type of the second cell.
+	 */
+	const uint64_t* getChunkMask(size_t i, ConcSites::SiteType st) const {
+		return _masks.data() + i * _wordsPerMolecule + _typeOffset[static_cast<int>(st)];
+	}
+
+	//! chunk size of the last build, 0 if the list was never built
+	size_t getChunkSize() const {
+		return _chunkSize;
+	}
+
+	unsigned long getOtherCellIndex() const {
+		return _otherCellIndex;
+	}
+
+	size_t getDynamicSize() const {
+		return _masks.capacity() * sizeof(uint64_t);
+	}
+
+	//! test bit c of a chunk mask
+	static bool isChunkSet(const uint64_t* chunkMask, size_t c) {
+		return (chunkMask[c >> 6] >> (c & 63)) & 1ul;
+	}
+
+private:
+	unsigned long _otherCellIndex;
+
+	bool _built;
+	unsigned long _layoutVersion1;
+	unsigned long _layoutVersion2;
+	double _displacement1;
+	double _displacement2;
+	unsigned long _buildStep;
+	size_t _chunkSize;
+
+	//! number of 64 bit words per molecule (sum over all site types)
+	size_t _wordsPerMolecule;
+
+	//! offset (in words) of each site type within the words of one molecule
+	std::array<size_t, 4> _typeOffset;
+
+	std::vector<uint64_t> _masks;
+};
+
+#endif /* SRC_PARTICLECONTAINER_ADAPTER_VERLETCLUSTERLIST_H_ */
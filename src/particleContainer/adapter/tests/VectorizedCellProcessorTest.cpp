@@ -13,6 +13,10 @@
 #include "particleContainer/adapter/LegacyCellProcessor.h"
 #include "particleContainer/adapter/VectorizedCellProcessor.h"
 
+#include <array>
+#include <cmath>
+#include <vector>
+
 #ifndef ENABLE_REDUCED_MEMORY_MODE
 TEST_SUITE_REGISTRATION(VectorizedCellProcessorTest);
 #else
@@ -218,6 +222,74 @@ void VectorizedCellProcessorTest::testLennardJonesVectorization() {
 	delete container_2;
 }
 
+void VectorizedCellProcessorTest::testLennardJonesInstructionSets() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VectorizedCellProcessorTest::testLennardJonesInstructionSets()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+#if defined(MARDYN_DPDP)
+	const double Tolerance = 1e-10;
+	const VectorizedCellProcessor::Precision precision = VectorizedCellProcessor::Precision::DPDP;
+#elif defined(MARDYN_SPDP)
+	const double Tolerance = 1e-05;
+	const VectorizedCellProcessor::Precision precision = VectorizedCellProcessor::Precision::SPDP;
+#else
+	const double Tolerance = 1e-05;
+	const VectorizedCellProcessor::Precision precision = VectorizedCellProcessor::Precision::SPSP;
+#endif
+
+	const double ScenarioCutoff = 35.0;
+	const char filename[] = {"VectorizationLennardJones.inp"};
+
+	ParticleContainer* container_1 = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, ScenarioCutoff);
+	ParticlePairs2PotForceAdapter forceAdapter(*_domain);
+	LegacyCellProcessor cellProcessor(ScenarioCutoff, ScenarioCutoff, &forceAdapter);
+	container_1->traverseCells(cellProcessor);
+	for (auto m = container_1->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+		m->calcFM();
+	}
+	const double legacy_u_pot = _domain->getLocalUpot();
+	const double legacy_virial = _domain->getLocalVirial();
+
+	const VectorizedCellProcessor::InstructionSet supported = VectorizedCellProcessor::detectInstructionSet();
+	for (auto instructionSet : {VectorizedCellProcessor::InstructionSet::DEFAULT,
+			VectorizedCellProcessor::InstructionSet::AVX2, VectorizedCellProcessor::InstructionSet::AVX512F}) {
+		if (instructionSet > supported) {
+			break;
+		}
+		tearDown(); setUp();
+
+		ParticleContainer* container_2 = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, ScenarioCutoff);
+		VectorizedCellProcessor vectorized_cell_proc(*_domain, ScenarioCutoff, ScenarioCutoff);
+		vectorized_cell_proc.setPrecision(precision);
+		vectorized_cell_proc.setInstructionSet(instructionSet);
+		container_2->traverseCells(vectorized_cell_proc);
+		for (auto m = container_2->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+			m->calcFM();
+		}
+
+		auto m_1 = container_1->iterator(ParticleIterator::ALL_CELLS);
+		for (auto m_2 = container_2->iterator(ParticleIterator::ALL_CELLS); m_2.isValid(); ++m_2) {
+			for (int i = 0; i < 3; i++) {
+				std::stringstream str;
+				str << VectorizedCellProcessor::instructionSetToString(instructionSet)
+						<< ": Molecule id=" << m_2->getID() << " index i=" << i << std::endl;
+				ASSERT_DOUBLES_EQUAL_MSG(str.str(), m_1->F(i), m_2->F(i), Tolerance);
+				ASSERT_DOUBLES_EQUAL_MSG(str.str(), m_1->M(i), m_2->M(i), Tolerance);
+				ASSERT_DOUBLES_EQUAL_MSG(str.str(), m_1->Vi(i), m_2->Vi(i), Tolerance);
+			}
+			++m_1;
+		}
+		ASSERT_DOUBLES_EQUAL(legacy_u_pot, _domain->getLocalUpot(), Tolerance);
+		ASSERT_DOUBLES_EQUAL(legacy_virial, _domain->getLocalVirial(), Tolerance);
+
+		delete container_2;
+	}
+	delete container_1;
+}
+
 void VectorizedCellProcessorTest::testElectrostaticVectorization(const char* filename, double ScenarioCutoff) {
 	if (_domainDecomposition->getNumProcs() != 1) {
 		test_log->info()
@@ -386,3 +458,134 @@ void VectorizedCellProcessorTest::testMultiComponentMultiPotentials() {
 	const char* filename = "VectorizationMultiComponentMultiPotentials.inp";
 	testElectrostaticVectorization(filename, 35.0);
 }
+
+void VectorizedCellProcessorTest::testIntrinsicsInstructionSets() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VectorizedCellProcessorTest::testIntrinsicsInstructionSets()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+#if defined(MARDYN_DPDP)
+	const double Tolerance = 1e-11;
+#else
+	const double Tolerance = 1e-05;
+#endif
+
+	const double ScenarioCutoff = 35.0;
+	const char filename[] = {"VectorizationMultiComponentMultiPotentials.inp"};
+
+	ParticleContainer* container_1 = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, ScenarioCutoff);
+	ParticlePairs2PotForceAdapter forceAdapter(*_domain);
+	LegacyCellProcessor cellProcessor(ScenarioCutoff, ScenarioCutoff, &forceAdapter);
+	container_1->traverseCells(cellProcessor);
+	for (auto m = container_1->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+		m->calcFM();
+	}
+	const double legacy_u_pot = _domain->getLocalUpot();
+	const double legacy_virial = _domain->getLocalVirial();
+
+	const VectorizedCellProcessor::InstructionSet supported = VectorizedCellProcessor::detectInstructionSet();
+	for (auto instructionSet : {VectorizedCellProcessor::InstructionSet::DEFAULT,
+			VectorizedCellProcessor::InstructionSet::AVX2, VectorizedCellProcessor::InstructionSet::AVX512F}) {
+		if (instructionSet > supported) {
+			break;
+		}
+		tearDown(); setUp();
+
+		ParticleContainer* container_2 = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, ScenarioCutoff);
+		VectorizedCellProcessor vectorized_cell_proc(*_domain, ScenarioCutoff, ScenarioCutoff);
+		vectorized_cell_proc.setInstructionSet(instructionSet);
+		// the kernels of the build may already use a wider instruction set, but never a narrower one
+		ASSERT_TRUE(instructionSet == VectorizedCellProcessor::InstructionSet::DEFAULT
+				or vectorized_cell_proc.getInstructionSet() >= instructionSet);
+		container_2->traverseCells(vectorized_cell_proc);
+		for (auto m = container_2->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+			m->calcFM();
+		}
+
+		auto m_1 = container_1->iterator(ParticleIterator::ALL_CELLS);
+		for (auto m_2 = container_2->iterator(ParticleIterator::ALL_CELLS); m_2.isValid(); ++m_2) {
+			for (int i = 0; i < 3; i++) {
+				std::stringstream str;
+				str << VectorizedCellProcessor::instructionSetToString(instructionSet)
+						<< ": Molecule id=" << m_2->getID() << " index i=" << i << std::endl;
+				ASSERT_DOUBLES_EQUAL_MSG(str.str(), m_1->F(i), m_2->F(i), Tolerance);
+				ASSERT_DOUBLES_EQUAL_MSG(str.str(), m_1->M(i), m_2->M(i), Tolerance);
+				ASSERT_DOUBLES_EQUAL_MSG(str.str(), m_1->Vi(i), m_2->Vi(i), Tolerance);
+			}
+			++m_1;
+		}
+		ASSERT_DOUBLES_EQUAL(legacy_u_pot, _domain->getLocalUpot(), Tolerance);
+		ASSERT_DOUBLES_EQUAL(legacy_virial, _domain->getLocalVirial(), Tolerance);
+
+		delete container_2;
+	}
+	delete container_1;
+}
+
+void VectorizedCellProcessorTest::testVerletClusterLists() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VectorizedCellProcessorTest::testVerletClusterLists()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+#if defined(MARDYN_DPDP)
+	double Tolerance = 1e-12;
+#else
+	double Tolerance = 1e-06;
+#endif
+
+	const double ScenarioCutoff = 20.0;
+	const double skin = 2.0;
+	const char filename[] = {"VectorizationLennardJones.inp"};
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, ScenarioCutoff);
+
+	VectorizedCellProcessor plainCellProc(*_domain, ScenarioCutoff, ScenarioCutoff);
+	VectorizedCellProcessor verletCellProc(*_domain, ScenarioCutoff, ScenarioCutoff);
+	verletCellProc.setVerletListParameters(skin, 1000);
+
+	// the first steps stay within half the skin in total, the last one exceeds it
+	const double stepLength[] = {0.0, 0.15, 0.15, 0.15, 1.5};
+	for (double length : stepLength) {
+		for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+			const double id = m->getID();
+			m->setr(0, m->r(0) + length * std::sin(id));
+			m->setr(1, m->r(1) + length * std::cos(2.0 * id));
+			m->setr(2, m->r(2) + length * std::sin(3.0 * id) * std::cos(id));
+		}
+		container->update();
+
+		// reference without lists
+		container->updateMoleculeCaches();
+		container->traverseCells(plainCellProc);
+		std::vector<std::array<double, 9>> reference;
+		for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+			m->calcFM();
+			reference.push_back({m->F(0), m->F(1), m->F(2), m->M(0), m->M(1), m->M(2), m->Vi(0), m->Vi(1), m->Vi(2)});
+		}
+		const double plain_u_pot = _domain->getLocalUpot();
+		const double plain_virial = _domain->getLocalVirial();
+
+		// same positions with lists
+		container->updateMoleculeCaches();
+		container->traverseCells(verletCellProc);
+		size_t index = 0;
+		for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m, ++index) {
+			m->calcFM();
+			const std::array<double, 9> verlet = {m->F(0), m->F(1), m->F(2), m->M(0), m->M(1), m->M(2), m->Vi(0), m->Vi(1), m->Vi(2)};
+			for (int i = 0; i < 9; i++) {
+				std::stringstream str;
+				str << "Molecule id=" << m->getID() << " quantity i=" << i << " step length " << length << std::endl;
+				ASSERT_DOUBLES_EQUAL_MSG(str.str(), reference[index][i], verlet[i], Tolerance);
+			}
+		}
+		ASSERT_EQUAL(reference.size(), index);
+		ASSERT_DOUBLES_EQUAL(plain_u_pot, _domain->getLocalUpot(), Tolerance);
+		ASSERT_DOUBLES_EQUAL(plain_virial, _domain->getLocalVirial(), Tolerance);
+	}
+
+	delete container;
+}
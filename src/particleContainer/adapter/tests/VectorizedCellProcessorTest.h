@@ -22,6 +22,7 @@ class VectorizedCellProcessorTest : public utils::TestWithSimulationSetup {
 	TEST_METHOD(testForcePotentialCalculationF0);
 
 	TEST_METHOD(testLennardJonesVectorization);
+	TEST_METHOD(testLennardJonesInstructionSets);
 
 	TEST_METHOD(testChargeChargeVectorization);
 	TEST_METHOD(testChargeDipoleVectorization);
@@ -35,6 +36,9 @@ class VectorizedCellProcessorTest : public utils::TestWithSimulationSetup {
 	TEST_METHOD(testWaterVectorization);
 
 	TEST_METHOD(testMultiComponentMultiPotentials);
+	TEST_METHOD(testIntrinsicsInstructionSets);
+
+	TEST_METHOD(testVerletClusterLists);
 
 	TEST_SUITE_END();
 
@@ -73,6 +77,12 @@ public:
 	 */
 	void testLennardJonesVectorization();
 
+	/**
+	 * Same as testLennardJonesVectorization, but with the compiler-vectorized kernels in the
+	 * precision of the build, for every instruction set supported by the CPU.
+	 */
+	void testLennardJonesInstructionSets();
+
 	/**
 	 * Generic test routine for all electrostatic interactions.
 	 * Which test is run is dependent on filename,
@@ -120,5 +130,18 @@ public:
 	 */
 	void testMultiComponentMultiPotentials();
 
+	/**
+	 * Same as testMultiComponentMultiPotentials, but with the intrinsics kernels compiled for
+	 * every instruction set supported by the CPU.
+	 */
+	void testIntrinsicsInstructionSets();
+
+	/**
+	 * Move the molecules of the Lennard-Jones scenario in several small steps and check that
+	 * forces, torques, virials and the potential energy are the same with and without Verlet cluster lists.
+	 * The lists are reused while the displacement stays below half the skin and rebuilt afterwards.
+	 */
+	void testVerletClusterLists();
+
 };
 #endif /* VECTORIZEDCELLPROCESSORTEST_H_ */
@@ -0,0 +1,83 @@
+/*
+ * VerletClusterListTest.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#include "VerletClusterListTest.h"
+#include "particleContainer/adapter/CellDataSoA.h"
+#include "particleContainer/adapter/VerletClusterList.h"
+
+#include <array>
+
+TEST_SUITE_REGISTRATION(VerletClusterListTest);
+
+VerletClusterListTest::VerletClusterListTest() {
+}
+
+VerletClusterListTest::~VerletClusterListTest() {
+}
+
+void VerletClusterListTest::testBuild() {
+	typedef ConcSites::SiteType SiteType;
+	const std::array<vcp_real_calc, 3> origin = {0.0, 0.0, 0.0};
+	const std::array<vcp_real_calc, 3> near = {1.0, 0.0, 0.0};
+	const std::array<vcp_real_calc, 3> far = {0.0, 10.0, 0.0};
+
+	// one molecule in the first cell
+	CellDataSoA soa1(1, 1, 0, 0, 0);
+	soa1._mol_pos.xBegin()[0] = origin[0];
+	soa1._mol_pos.yBegin()[0] = origin[1];
+	soa1._mol_pos.zBegin()[0] = origin[2];
+	soa1.pushBackLJC(0, origin, origin, 0);
+
+	// chunk 0: all near, chunk 1: all far, chunk 2: only the last site near
+	const size_t numLJC = 3 * VCP_VEC_SIZE;
+	CellDataSoA soa2(numLJC + 1, numLJC, 1, 0, 0);
+	for (size_t j = 0; j < numLJC; ++j) {
+		const bool isNear = j < VCP_VEC_SIZE or j == numLJC - 1;
+		soa2.pushBackLJC(j, isNear ? near : far, isNear ? near : far, 0);
+	}
+	soa2.pushBackCharge(0, far, far, 1.0);
+
+	VerletClusterList list(42);
+	ASSERT_EQUAL(42ul, list.getOtherCellIndex());
+
+	// the LJ radius does not reach the far sites, the charge radius does
+	list.build(soa1, soa2, 2.0 * 2.0, 11.0 * 11.0, VCP_VEC_SIZE);
+	ASSERT_EQUAL(VCP_VEC_SIZE, list.getChunkSize());
+	const uint64_t* ljcMask = list.getChunkMask(0, SiteType::LJC);
+	ASSERT_TRUE(VerletClusterList::isChunkSet(ljcMask, 0));
+	ASSERT_TRUE(not VerletClusterList::isChunkSet(ljcMask, 1));
+	ASSERT_TRUE(VerletClusterList::isChunkSet(ljcMask, 2));
+	ASSERT_TRUE(VerletClusterList::isChunkSet(list.getChunkMask(0, SiteType::CHARGE), 0));
+
+	// with a smaller charge radius the charge chunk is dropped
+	list.build(soa1, soa2, 2.0 * 2.0, 5.0 * 5.0, VCP_VEC_SIZE);
+	ASSERT_TRUE(not VerletClusterList::isChunkSet(list.getChunkMask(0, SiteType::CHARGE), 0));
+}
+
+void VerletClusterListTest::testIsValid() {
+	const double halfSkin = 0.5;
+	const unsigned rebuildFrequency = 10;
+	VerletClusterList list;
+	ASSERT_TRUE(not list.isValid(0, 0, 0.0, 0.0, halfSkin, 0, rebuildFrequency));
+
+	CellDataSoA soa(0, 0, 0, 0, 0);
+	list.build(soa, soa, 1.0, 1.0, VCP_VEC_SIZE);
+	list.setBuildState(3, 5, 1.0, 2.0, 100);
+
+	ASSERT_TRUE(list.isValid(3, 5, 1.0, 2.0, halfSkin, 100, rebuildFrequency));
+	ASSERT_TRUE(list.isValid(3, 5, 1.5, 2.5, halfSkin, 109, rebuildFrequency));
+
+	// layout of either cell rebuilt
+	ASSERT_TRUE(not list.isValid(4, 5, 1.0, 2.0, halfSkin, 100, rebuildFrequency));
+	ASSERT_TRUE(not list.isValid(3, 6, 1.0, 2.0, halfSkin, 100, rebuildFrequency));
+
+	// molecules of either cell moved further than half the skin
+	ASSERT_TRUE(not list.isValid(3, 5, 1.6, 2.0, halfSkin, 100, rebuildFrequency));
+	ASSERT_TRUE(not list.isValid(3, 5, 1.0, 2.6, halfSkin, 100, rebuildFrequency));
+
+	// rebuild frequency reached
+	ASSERT_TRUE(not list.isValid(3, 5, 1.0, 2.0, halfSkin, 110, rebuildFrequency));
+}
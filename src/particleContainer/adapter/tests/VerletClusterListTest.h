@@ -0,0 +1,39 @@
+/*
+ * VerletClusterListTest.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef VERLETCLUSTERLISTTEST_H_
+#define VERLETCLUSTERLISTTEST_H_
+
+#include "utils/Testing.h"
+
+class VerletClusterListTest : public utils::Test {
+
+	TEST_SUITE(VerletClusterListTest);
+
+	TEST_METHOD(testBuild);
+	TEST_METHOD(testIsValid);
+
+	TEST_SUITE_END();
+
+public:
+	VerletClusterListTest();
+
+	virtual ~VerletClusterListTest();
+
+	/**
+	 * Build the list for one molecule against three chunks of LJ centers and one chunk of charges:
+	 * only the chunks with at least one site within the radius have to be flagged.
+	 */
+	void testBuild();
+
+	/**
+	 * Check that a list is invalidated by a layout change, a displacement of more than half the skin
+	 * and the rebuild frequency.
+	 */
+	void testIsValid();
+};
+
+#endif /* VERLETCLUSTERLISTTEST_H_ */
@@ -2,6 +2,9 @@
 
 #include "SIMD_TYPES.h"
 
+namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
+
 class MaskingChooser {
 private:
 	MaskCalcVec compute_molecule=MaskCalcVec::zero();
@@ -202,6 +205,27 @@ public:
 	typedef GatherChooser MaskGatherC;
 #endif
 
+/**
+ * \brief Loads like MGC, but discards all stores.
+ * \details Used for test molecules (e.g. Widom insertions): the forces, torques and virials on the
+ * molecules of the second cell are not written, so the energy can be computed without modifying the cell.
+ */
+template<class MGC>
+class ReadOnlyChooser : public MGC {
+public:
+	using MGC::MGC;
+
+	template<typename T, typename Vec>
+	inline static void store(T* const /*addr*/, const size_t& /*offset*/,
+			Vec& /*value*/, const vcp_lookupOrMask_vec& /*lookup*/) {
+	}
+
+	template<typename T, typename Vec, typename Mask>
+	inline static void storeMasked(T* const /*addr*/, const size_t& /*offset*/,
+			Vec& /*value*/, const vcp_lookupOrMask_vec& /*lookup*/, const Mask& /*mask*/) {
+	}
+};
+
 class CountUnmasked_MGC {
 private:
 	countertype32 _numUnmasked;
@@ -217,3 +241,6 @@ public:
 		_numUnmasked += forceMask.countUnmasked();
 	}
 };
+
+} /* namespace VCP_ISA_NAMESPACE */
+} /* namespace vcp */
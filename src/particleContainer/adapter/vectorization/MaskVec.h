@@ -11,11 +11,13 @@
 #include "./SIMD_TYPES.h"
 
 namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
 
 template<typename FloatOrDouble>
 class MaskVec {
 };
 
+} /* namespace VCP_ISA_NAMESPACE */
 } /* namespace vcp */
 
 // SPECIALIZATIONS: suggested to view via vimdiff
@@ -13,6 +13,7 @@
 // keep this file and MaskVecFloat as close as possible, so that they can be examined via diff!
 
 namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
 
 template<>
 class MaskVec<double> {
@@ -179,6 +180,7 @@ public:
 	}
 };
 
+} /* namespace VCP_ISA_NAMESPACE */
 } /* namespace vcp */
 
 #endif /* SRC_PARTICLECONTAINER_ADAPTER_VECTORIZATION_MASKVECDOUBLE_H_ */
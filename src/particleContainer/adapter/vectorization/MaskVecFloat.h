@@ -13,6 +13,7 @@
 // keep this file and MaskVecDouble as close as possible, so that they can be examined via diff!
 
 namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
 
 template<>
 class MaskVec<float> {
@@ -179,6 +180,7 @@ public:
 	}
 };
 
+} /* namespace VCP_ISA_NAMESPACE */
 } /* namespace vcp */
 
 #endif /* SRC_PARTICLECONTAINER_ADAPTER_VECTORIZATION_MASKVECFLOAT_H_ */
@@ -11,6 +11,7 @@
 #include "RealVec.h"
 
 namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
 
 #if VCP_VEC_WIDTH != VCP_VEC_W__64
 // the novec case is handled differently, as it requires only one RealVec<double> to store its results.
@@ -322,6 +323,7 @@ public:
 
 #endif /* VCP_VEC_WIDTH */
 
+} /* namespace VCP_ISA_NAMESPACE */
 } /* namespace vcp */
 
 #endif /* SRC_PARTICLECONTAINER_ADAPTER_VECTORIZATION_REALACCUMVECSPDP_H_ */
@@ -17,11 +17,13 @@
 #include "utils/Logger.h"
 
 namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
 
 template<typename FloatOrDouble>
 class RealVec {
 }; /* class RealVec */
 
+} /* namespace VCP_ISA_NAMESPACE */
 } /* namespace vcp */
 
 // SPECIALIZATIONS: suggested to view via vimdiff
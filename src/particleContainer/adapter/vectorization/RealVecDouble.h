@@ -13,6 +13,7 @@
 // keep this file and RealVecFloat as close as possible, so that they can be examined via diff!
 
 namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
 
 template<>
 class RealVec<double> {
@@ -542,6 +543,7 @@ public:
 
 }; /* class RealCalcVec */
 
+} /* namespace VCP_ISA_NAMESPACE */
 } /* namespace vcp */
 
 #endif /* SRC_PARTICLECONTAINER_ADAPTER_VECTORIZATION_REALVECDOUBLE_H_ */
@@ -13,6 +13,7 @@
 // keep this file and RealVecDouble as close as possible, so that they can be examined via diff!
 
 namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
 
 template<>
 class RealVec<float> {
@@ -554,6 +555,7 @@ public:
 
 }; /* class RealCalcVec */
 
+} /* namespace VCP_ISA_NAMESPACE */
 } /* namespace vcp */
 
 #endif /* SRC_PARTICLECONTAINER_ADAPTER_VECTORIZATION_REALVECFLOAT_H_ */
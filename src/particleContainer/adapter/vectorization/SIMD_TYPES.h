@@ -93,6 +93,26 @@
 	#define VCP_VEC_TYPE VCP_NOVEC
 #endif
 
+// Everything depending on the vector type lives in an inline namespace of vcp named after it, so that translation
+// units compiled for different instruction sets can be linked into one binary (see VectorizedCellProcessorKernel.h).
+#if VCP_VEC_TYPE==VCP_NOVEC
+	#define VCP_ISA_NAMESPACE novec
+#elif VCP_VEC_TYPE==VCP_VEC_SSE3
+	#define VCP_ISA_NAMESPACE sse3
+#elif VCP_VEC_TYPE==VCP_VEC_AVX
+	#define VCP_ISA_NAMESPACE avx
+#elif VCP_VEC_TYPE==VCP_VEC_AVX2
+	#define VCP_ISA_NAMESPACE avx2
+#elif VCP_VEC_TYPE==VCP_VEC_KNL
+	#define VCP_ISA_NAMESPACE knl
+#elif VCP_VEC_TYPE==VCP_VEC_KNL_GATHER
+	#define VCP_ISA_NAMESPACE knl_gather
+#elif VCP_VEC_TYPE==VCP_VEC_AVX512F
+	#define VCP_ISA_NAMESPACE avx512f
+#elif VCP_VEC_TYPE==VCP_VEC_AVX512F_GATHER
+	#define VCP_ISA_NAMESPACE avx512f_gather
+#endif
+
 // Include necessary files if we vectorize.
 #if VCP_VEC_TYPE==VCP_NOVEC
 	// no file to include
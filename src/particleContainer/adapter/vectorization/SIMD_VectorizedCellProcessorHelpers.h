@@ -13,6 +13,10 @@
 
 #include "SIMD_TYPES.h"
 #include "utils/AlignedArray.h"
+#include "particleContainer/adapter/VerletClusterList.h"
+
+namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
 
 /**
  * unpacks eps_24 and sig2 from the eps_sigI array according to the index array id_j (for mic+avx2: use gather)
@@ -378,6 +382,17 @@ public:
 	vcp_inline static size_t NumDistanceCalculations(const size_t numSoA1, const size_t /*numSoA2*/) {
 		return numSoA1 * (numSoA1 - 1) / 2;
 	}
+
+	//! first center of the second cell to be considered for center i (scalar loops, without alignment)
+	vcp_inline static size_t FirstJ(const size_t i) {
+		return i;
+	}
+
+	//! whether two centers of molecules at squared distance m_r2 interact (scalar loops)
+	template<typename T>
+	vcp_inline static bool Condition(const T m_r2, const T rc2) {
+		return m_r2 != T(0) and (not ApplyCutoff or m_r2 < rc2);
+	}
 }; /* end of class SingleCellPolicy_ */
 
 /**
@@ -419,16 +434,28 @@ public:
 	vcp_inline static size_t NumDistanceCalculations(const size_t numSoA1, const size_t numSoA2) {
 		return numSoA1 * numSoA2;
 	}
+
+	vcp_inline static size_t FirstJ(const size_t /*i*/) {
+		return 0;
+	}
+
+	template<typename T>
+	vcp_inline static bool Condition(const T m_r2, const T rc2) {
+		return not ApplyCutoff or m_r2 < rc2;
+	}
 }; /* end of class CellPairPolicy_ */
 
 /**
  * \brief The dist lookup for a molecule and all centers of a type
+ * \param verletChunkMask optional chunk mask of a VerletClusterList. If given, the distances are only computed for
+ * chunks of VCP_VEC_SIZE centers whose bit is set, all other chunks are treated as out of range.
  */
 template<class ForcePolicy, class MaskGatherChooser>
 countertype32
 static vcp_inline calcDistLookup (const size_t & i_center_idx, const size_t & soa2_num_centers,
 		vcp_lookupOrMask_single* const soa2_center_dist_lookup, const vcp_real_calc* const soa2_m_r_x, const vcp_real_calc* const soa2_m_r_y, const vcp_real_calc* const soa2_m_r_z,
-		const RealCalcVec & cutoffRadiusSquareD, size_t end_j, const RealCalcVec m1_r_x, const RealCalcVec m1_r_y, const RealCalcVec m1_r_z) {
+		const RealCalcVec & cutoffRadiusSquareD, size_t end_j, const RealCalcVec m1_r_x, const RealCalcVec m1_r_y, const RealCalcVec m1_r_z,
+		const uint64_t* const verletChunkMask = nullptr) {
 
 	size_t j = ForcePolicy :: InitJ(i_center_idx);
 	MaskCalcVec initJ_mask = ForcePolicy :: InitJ_Mask(i_center_idx);
@@ -436,6 +463,10 @@ static vcp_inline calcDistLookup (const size_t & i_center_idx, const size_t & so
 	MaskGatherChooser mgc(soa2_center_dist_lookup, j);
 
 	for (; j < end_j; j += VCP_VEC_SIZE) {
+		if (verletChunkMask != nullptr and not VerletClusterList::isChunkSet(verletChunkMask, j / VCP_VEC_SIZE)) {
+			mgc.storeCalcDistLookup(j, MaskCalcVec::zero());
+			continue;
+		}
 		const RealCalcVec m2_r_x = RealCalcVec::aligned_load(soa2_m_r_x + j);
 		const RealCalcVec m2_r_y = RealCalcVec::aligned_load(soa2_m_r_y + j);
 		const RealCalcVec m2_r_z = RealCalcVec::aligned_load(soa2_m_r_z + j);
@@ -452,7 +483,9 @@ static vcp_inline calcDistLookup (const size_t & i_center_idx, const size_t & so
 
 	}
 	const MaskCalcVec remainderMask = vcp_simd_getRemainderMask(soa2_num_centers);
-	if (remainderMask.movemask()) {
+	if (remainderMask.movemask() and verletChunkMask != nullptr and not VerletClusterList::isChunkSet(verletChunkMask, j / VCP_VEC_SIZE)) {
+		mgc.storeCalcDistLookup(j, MaskCalcVec::zero());
+	} else if (remainderMask.movemask()) {
 		const RealCalcVec m2_r_x = RealCalcVec::aligned_load_mask(soa2_m_r_x + j, remainderMask);
 		const RealCalcVec m2_r_y = RealCalcVec::aligned_load_mask(soa2_m_r_y + j, remainderMask);
 		const RealCalcVec m2_r_z = RealCalcVec::aligned_load_mask(soa2_m_r_z + j, remainderMask);
@@ -471,5 +504,7 @@ static vcp_inline calcDistLookup (const size_t & i_center_idx, const size_t & so
 
 }
 
+} /* namespace VCP_ISA_NAMESPACE */
+} /* namespace vcp */
 
 #endif /* SIMD_VECTORIZEDCELLPROCESSORHELPERS_H */
@@ -0,0 +1,129 @@
+/*
+ * FullParticleCellTest.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#include "FullParticleCellTest.h"
+#include "particleContainer/FullParticleCell.h"
+#include "molecules/Component.h"
+#include "molecules/Molecule.h"
+
+#include <cmath>
+
+TEST_SUITE_REGISTRATION(FullParticleCellTest);
+
+FullParticleCellTest::FullParticleCellTest() {
+}
+
+FullParticleCellTest::~FullParticleCellTest() {
+}
+
+void FullParticleCellTest::testPersistentSoALayout() {
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	Component component(0);
+	component.addLJcenter(0, 0, 0, 1, 1, 1, 0, false);
+
+	const double boxMin[3] = {0.0, 0.0, 0.0};
+	const double boxMax[3] = {2.0, 2.0, 2.0};
+	FullParticleCell cell;
+	cell.setBoxMin(boxMin);
+	cell.setBoxMax(boxMax);
+
+	//(id, cid, x, y, z, vx, vy, vz, q0, q1, q2, q3, Dx, Dy, Dz)
+	Molecule m1(1, &component, 0.5, 0.5, 0.5, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+	Molecule m2(2, &component, 1.5, 1.5, 1.5, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+	cell.addParticle(m1);
+	cell.addParticle(m2);
+	cell.buildSoACaches();
+
+	CellDataSoA& soa = cell.getCellDataSoA();
+	ASSERT_EQUAL(2ul, soa.getMolNum());
+	ASSERT_EQUAL(2ul, soa._ljc_num);
+
+	// move a molecule inside the cell: layout stays valid, positions have to be refreshed
+	auto it = cell.iterator();
+	it->setr(0, 0.75);
+	double force[3] = {1.0, 1.0, 1.0};
+	it->Fadd(force);
+	cell.buildSoACaches();
+	ASSERT_EQUAL(2ul, soa.getMolNum());
+	ASSERT_DOUBLES_EQUAL(0.75, static_cast<double>(soa._mol_pos.x(0)), 1e-6);
+	ASSERT_DOUBLES_EQUAL(0.75, static_cast<double>(soa._centers_r.getTriplet(ConcSites::SiteType::LJC, 0)[0]), 1e-6);
+	ASSERT_DOUBLES_EQUAL(0.0, cell.iterator()->F(0), 1e-15);
+
+	// adding a molecule invalidates the layout
+	Molecule m3(3, &component, 1.0, 1.0, 1.0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+	cell.addParticle(m3);
+	cell.buildSoACaches();
+	ASSERT_EQUAL(3ul, soa.getMolNum());
+	ASSERT_EQUAL(3ul, soa._ljc_num);
+
+	// so does deleting one
+	cell.deleteMoleculeByIndex(0);
+	cell.buildSoACaches();
+	ASSERT_EQUAL(2ul, soa.getMolNum());
+	ASSERT_EQUAL(2ul, soa._ljc_num);
+	for (int i = 0; i < cell.getMoleculeCount(); ++i) {
+		Molecule* m = nullptr;
+		cell.moleculesAtNew(i, m);
+		ASSERT_DOUBLES_EQUAL(m->r(0), static_cast<double>(soa._mol_pos.x(i)), 1e-6);
+	}
+#endif
+}
+
+void FullParticleCellTest::testSoARefreshRotatedSites() {
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	Component component(0);
+	component.addLJcenter(0.1, 0, 0, 1, 1, 1, 0, false);
+	component.addCharge(0, 0.1, 0, 1, 0.5);
+	component.addDipole(0, 0, 0.1, 0, 0, 1, 2.0);
+	component.addQuadrupole(0.1, 0.1, 0, 1, 0, 0, 3.0);
+
+	const double boxMin[3] = {0.0, 0.0, 0.0};
+	const double boxMax[3] = {2.0, 2.0, 2.0};
+	FullParticleCell cell;
+	cell.setBoxMin(boxMin);
+	cell.setBoxMax(boxMax);
+
+	Molecule m1(1, &component, 0.5, 0.5, 0.5, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+	cell.addParticle(m1);
+	cell.buildSoACaches();
+	const unsigned long layoutVersion = cell.getSoALayoutVersion();
+
+	// move and rotate the molecule by 90 degrees around the z axis
+	Molecule* m = nullptr;
+	cell.moleculesAtNew(0, m);
+	m->setr(0, 0.75);
+	m->setq(Quaternion(M_PI / 2, {0.0, 0.0, 1.0}));
+	cell.buildSoACaches();
+	ASSERT_EQUAL(layoutVersion, cell.getSoALayoutVersion());
+
+	CellDataSoA& soa = cell.getCellDataSoA();
+	const std::array<double, 3> ljc = m->computeLJcenter_d(0);
+	const std::array<double, 3> charge = m->computeCharge_d(0);
+	const std::array<double, 3> dipole = m->computeDipole_d(0);
+	const std::array<double, 3> dipoleE = m->computeDipole_e(0);
+	const std::array<double, 3> quadrupole = m->computeQuadrupole_d(0);
+	const std::array<double, 3> quadrupoleE = m->computeQuadrupole_e(0);
+	for (int d = 0; d < 3; ++d) {
+		ASSERT_DOUBLES_EQUAL(m->r(d), static_cast<double>(soa._centers_m_r.getTriplet(ConcSites::SiteType::LJC, 0)[d]), 1e-6);
+		ASSERT_DOUBLES_EQUAL(m->r(d), static_cast<double>(soa._centers_m_r.getTriplet(ConcSites::SiteType::QUADRUPOLE, 0)[d]), 1e-6);
+		ASSERT_DOUBLES_EQUAL(m->r(d) + ljc[d], static_cast<double>(soa._centers_r.getTriplet(ConcSites::SiteType::LJC, 0)[d]), 1e-6);
+		ASSERT_DOUBLES_EQUAL(m->r(d) + charge[d], static_cast<double>(soa._centers_r.getTriplet(ConcSites::SiteType::CHARGE, 0)[d]), 1e-6);
+		ASSERT_DOUBLES_EQUAL(m->r(d) + dipole[d], static_cast<double>(soa._centers_r.getTriplet(ConcSites::SiteType::DIPOLE, 0)[d]), 1e-6);
+		ASSERT_DOUBLES_EQUAL(m->r(d) + quadrupole[d], static_cast<double>(soa._centers_r.getTriplet(ConcSites::SiteType::QUADRUPOLE, 0)[d]), 1e-6);
+	}
+	ASSERT_DOUBLES_EQUAL(dipoleE[0], static_cast<double>(soa._dipoles_e.x(0)), 1e-6);
+	ASSERT_DOUBLES_EQUAL(dipoleE[1], static_cast<double>(soa._dipoles_e.y(0)), 1e-6);
+	ASSERT_DOUBLES_EQUAL(dipoleE[2], static_cast<double>(soa._dipoles_e.z(0)), 1e-6);
+	ASSERT_DOUBLES_EQUAL(quadrupoleE[0], static_cast<double>(soa._quadrupoles_e.x(0)), 1e-6);
+	ASSERT_DOUBLES_EQUAL(quadrupoleE[1], static_cast<double>(soa._quadrupoles_e.y(0)), 1e-6);
+	ASSERT_DOUBLES_EQUAL(quadrupoleE[2], static_cast<double>(soa._quadrupoles_e.z(0)), 1e-6);
+	// the rotation has to be visible in the SoA, the constant site data has to survive the refresh
+	ASSERT_DOUBLES_EQUAL(0.1, std::abs(static_cast<double>(soa._centers_r.getTriplet(ConcSites::SiteType::CHARGE, 0)[0]) - 0.75), 1e-6);
+	ASSERT_DOUBLES_EQUAL(0.5, static_cast<double>(soa._charges_q[0]), 1e-6);
+	ASSERT_DOUBLES_EQUAL(2.0, static_cast<double>(soa._dipoles_p[0]), 1e-6);
+	ASSERT_DOUBLES_EQUAL(3.0, static_cast<double>(soa._quadrupoles_m[0]), 1e-6);
+#endif
+}
@@ -0,0 +1,36 @@
+/*
+ * FullParticleCellTest.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_PARTICLECONTAINER_TESTS_FULLPARTICLECELLTEST_H_
+#define SRC_PARTICLECONTAINER_TESTS_FULLPARTICLECELLTEST_H_
+
+#include "utils/Testing.h"
+
+class FullParticleCellTest : public utils::Test {
+
+	TEST_SUITE(FullParticleCellTest);
+	TEST_METHOD(testPersistentSoALayout);
+	TEST_METHOD(testSoARefreshRotatedSites);
+	TEST_SUITE_END();
+
+public:
+	FullParticleCellTest();
+	virtual ~FullParticleCellTest();
+
+	/**
+	 * Checks that the SoA is refreshed (and not rebuilt from stale data) when molecules move,
+	 * and that adding or deleting molecules correctly triggers a rebuild of the layout.
+	 */
+	void testPersistentSoALayout();
+
+	/**
+	 * Checks that refreshing an unchanged layout updates the site positions and orientations of
+	 * moved and rotated molecules in place and keeps their constant site data.
+	 */
+	void testSoARefreshRotatedSites();
+};
+
+#endif /* SRC_PARTICLECONTAINER_TESTS_FULLPARTICLECELLTEST_H_ */
@@ -13,6 +13,10 @@ class LinkedCellsTest;
 #include "parallel/DomainDecomposition.h"
 #endif
 #include "particleContainer/adapter/CellProcessor.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
 #include <vector>
 
 #include "particleContainer/adapter/ParticlePairs2PotForceAdapter.h"
@@ -20,6 +24,7 @@ class LinkedCellsTest;
 #include "particleContainer/adapter/VectorizedCellProcessor.h"
 #include "particleContainer/LinkedCellTraversals/HalfShellTraversal.h"
 #include "particleContainer/TraversalTuner.h"
+#include "utils/xmlfileUnits.h"
 
 TEST_SUITE_REGISTRATION(LinkedCellsTest);
 
@@ -378,6 +383,10 @@ void LinkedCellsTest::testFullShellMPIDirect() {
 	doForceComparisonTest("simple-lj-tiny.inp", TraversalTuner < ParticleCell > ::traversalNames::C08, 1, "direct", "fs");
 }
 
+void LinkedCellsTest::testFullShellMPINeighbourCollective() {
+	doForceComparisonTest("simple-lj-tiny.inp", TraversalTuner < ParticleCell > ::traversalNames::C08, 1, "neighbour-collective", "fs");
+}
+
 void LinkedCellsTest::testHalfShellMPIIndirect() {
 //	doForceComparisonTest("simple-lj.inp", TraversalTuner < ParticleCell > ::traversalNames::HS, 1, "indirect", "hs");
 	doForceComparisonTest("simple-lj-tiny.inp", TraversalTuner < ParticleCell > ::traversalNames::HS, 1, "indirect", "hs");
@@ -413,6 +422,10 @@ void LinkedCellsTest::testEighthShellMPIDirectPP() {
 	doForceComparisonTest("simple-lj-tiny.inp", TraversalTuner < ParticleCell > ::traversalNames::C08ES, 2, "direct-pp", "es");
 }
 
+void LinkedCellsTest::testTaskMPIDirectPP() {
+	doForceComparisonTest("simple-lj-tiny.inp", TraversalTuner < ParticleCell > ::traversalNames::TASK, 1, "direct-pp", "fs");
+}
+
 void LinkedCellsTest::testCellBorderAndFlagManager() {
 	long int cellIndex;
 	double cellBoxMin[3], cellBoxMax[3];
@@ -508,6 +521,137 @@ void LinkedCellsTest::testCellBorderAndFlagManager() {
 
 }
 
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+void LinkedCellsTest::testGetEnergies() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "LinkedCellsTest::testGetEnergies()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+#if defined(MARDYN_DPDP)
+	const double relativeTolerance = 1e-10;
+#else
+	const double relativeTolerance = 1e-4;
+#endif
+
+	// contains LJ centers, charges, dipoles and quadrupoles of several components
+	const double cutoff = 20.0;
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell,
+			"VectorizationMultiComponentMultiPotentials.inp", cutoff);
+	container->update();
+	container->updateMoleculeCaches();
+
+	// test insertions: copies of every 10th molecule, shifted and wrapped into the box
+	std::vector<Molecule> testMolecules;
+	unsigned long index = 0;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m, ++index) {
+		if (index % 10 != 0) {
+			continue;
+		}
+		Molecule test = *m;
+		test.setid(1000000 + index);
+		for (int d = 0; d < 3; ++d) {
+			const double boxMin = container->getBoundingBoxMin(d);
+			const double boxLength = container->getBoundingBoxMax(d) - boxMin;
+			double r = test.r(d) + 3.0 + d;
+			if (r >= boxMin + boxLength) {
+				r -= boxLength;
+			}
+			test.setr(d, r);
+		}
+		testMolecules.push_back(test);
+	}
+	ASSERT_TRUE(testMolecules.size() > 0);
+
+	ParticlePairs2PotForceAdapter handler(*_domain);
+	VectorizedCellProcessor cellProcessor(*_domain, cutoff, cutoff);
+	std::vector<double> energies;
+	container->getEnergies(&handler, testMolecules, energies, cellProcessor);
+	ASSERT_EQUAL(testMolecules.size(), energies.size());
+
+	for (size_t i = 0; i < testMolecules.size(); ++i) {
+		const double expected = container->getEnergy(&handler, &testMolecules[i], cellProcessor);
+		std::stringstream str;
+		str << "test molecule " << i << " id=" << testMolecules[i].getID() << std::endl;
+		ASSERT_DOUBLES_EQUAL_MSG(str.str(), expected, energies[i], relativeTolerance * std::max(1.0, std::abs(expected)));
+	}
+
+	delete container;
+}
+#endif
+
+void LinkedCellsTest::testAutotuningSamples() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "LinkedCellsTest::testAutotuningSamples()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	const double cutoff = 3.5;
+	LinkedCells* container = dynamic_cast<LinkedCells*>(initializeFromFile(ParticleContainerFactory::LinkedCell,
+			"simple-lj-tiny.inp", cutoff));
+	TraversalTuner<ParticleCell>* tuner = container->_traversalTuner.get();
+
+	const std::string xmlFilename = getTestDataFilename("autotuning.test.xml", false);
+	{
+		std::ofstream xml(xmlFilename);
+		xml << "<datastructure type=\"LinkedCells\">"
+			<< "<traversalSelector>auto</traversalSelector>"
+			<< "<autotuning><traversals>sliced,c08</traversals><samples>2</samples></autotuning>"
+			<< "</datastructure>";
+	}
+	XMLfileUnits xmlconfig(xmlFilename);
+	xmlconfig.changecurrentnode("/datastructure");
+	tuner->readXML(xmlconfig);
+	ASSERT_TRUE(tuner->isAutotuning());
+	ASSERT_TRUE(tuner->_tuning);
+	ASSERT_EQUAL(TraversalTuner<ParticleCell>::SLICED, tuner->getSelectedTraversal());
+
+	VectorizedCellProcessor cellProcessor(*_domain, cutoff, cutoff);
+	auto forceCalculation = [&]() {
+		container->updateMoleculeCaches();
+		container->traverseCells(cellProcessor);
+		ASSERT_TRUE(tuner->_stepTime > 0.0);
+	};
+
+	// initialization of the simulation: container update and initial force calculation
+	container->update();
+	forceCalculation();
+	container->update();
+	ASSERT_EQUAL(0u, tuner->_samplesTaken);
+	ASSERT_EQUAL(0.0, tuner->_stepTime);
+
+	// resorting the particles is not measured
+	class ResortCellProcessor : public CellProcessor {
+	public:
+		ResortCellProcessor() : CellProcessor(0.0, 0.0) {}
+		void initTraversal() {}
+		void preprocessCell(ParticleCell& ) {}
+		void processCellPair(ParticleCell& cell1, ParticleCell& cell2, bool sumAll = false) {
+			cell1.updateLeavingMoleculesBase(cell2);
+		}
+		void processCell(ParticleCell& ) {}
+		double processSingleMolecule(Molecule*, ParticleCell& ) { return 0.0; }
+		void postprocessCell(ParticleCell& ) {}
+		void endTraversal() {}
+	} resortCellProcessor;
+	tuner->traverseCellPairs(tuner->getSelectedTraversal(), resortCellProcessor);
+	ASSERT_EQUAL(0.0, tuner->_stepTime);
+
+	// time steps: one warm-up and two measured samples per candidate
+	for (unsigned sample = 1; sample <= 3; ++sample) {
+		forceCalculation();
+		container->update();
+		ASSERT_EQUAL(sample % 3, tuner->_samplesTaken);
+	}
+	ASSERT_EQUAL(TraversalTuner<ParticleCell>::C08, tuner->getSelectedTraversal());
+	ASSERT_TRUE(std::isfinite(tuner->_tuningConfigurations[0].time));
+	ASSERT_TRUE(std::isinf(tuner->_tuningConfigurations[1].time));
+
+	delete container;
+}
+
 void LinkedCellsTest::doForceComparisonTest(std::string inputFile,
 		TraversalTuner<ParticleCell>::traversalNames traversal, unsigned cellsInCutoff, std::string neighbourCommScheme,
 		std::string commScheme) {
@@ -26,9 +26,15 @@ class LinkedCellsTest: public ParticleContainerTest {
 
 	TEST_METHOD(testCellBorderAndFlagManager);
 
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	TEST_METHOD(testGetEnergies);
+#endif
+	TEST_METHOD(testAutotuningSamples);
+
 #ifndef ENABLE_REDUCED_MEMORY_MODE
 	TEST_METHOD(testFullShellMPIDirectPP);
 	TEST_METHOD(testFullShellMPIDirect);
+	TEST_METHOD(testFullShellMPINeighbourCollective);
 
 	TEST_METHOD(testHalfShellMPIDirectPP);
 	TEST_METHOD(testHalfShellMPIDirect);
@@ -39,6 +45,8 @@ class LinkedCellsTest: public ParticleContainerTest {
 	TEST_METHOD(testMidpointMPIIndirect);
 
 	TEST_METHOD(testEighthShellMPIDirectPP);
+
+	TEST_METHOD(testTaskMPIDirectPP);
 #else
 #pragma message "half and midpoint tests disabled for RMM"
 #endif
@@ -83,6 +91,7 @@ public:
 
 	void testFullShellMPIDirectPP();
 	void testFullShellMPIDirect();
+	void testFullShellMPINeighbourCollective();
 
 	void testHalfShellMPIDirectPP();
 	void testHalfShellMPIDirect();
@@ -95,8 +104,21 @@ public:
 
 	void testEighthShellMPIDirectPP();
 
+	void testTaskMPIDirectPP();
+
 	void testCellBorderAndFlagManager();
 
+	/**
+	 * Compare the batched, vectorized getEnergies() for test insertions with getEnergy() for each of them.
+	 */
+	void testGetEnergies();
+
+	/**
+	 * Neither the initial container update and force calculation nor the resorting of the particles may form
+	 * samples of the traversal autotuning.
+	 */
+	void testAutotuningSamples();
+
 private:
 
 	void doForceComparisonTest(std::string inputFile, TraversalTuner<ParticleCell>::traversalNames traversal, unsigned cellsInCutoff, std::string neighbourCommScheme, std::string commScheme);
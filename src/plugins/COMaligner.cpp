@@ -6,6 +6,7 @@
  */
 
 #include "COMaligner.h"
+#include "WrapOpenMP.h"
 
 //! @brief will be called to read configuration
 //!
@@ -111,19 +112,10 @@ void COMaligner::beforeForces(ParticleContainer* particleContainer,
 
         // RESET
         for (unsigned d = 0; d < 3; d++) {
-            _balance[d] = 0.0;
             _motion[d] = 0.0;
         }
-        _mass = 0;
-
-        // ITERATE OVER PARTICLES
-        for (auto tm = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); tm.isValid(); ++tm) {
-            double partMass = tm->mass();
-            _mass += partMass;
-            for (int d = _dim_start; d < _dim_end; d += _dim_step) {
-                _balance[d] += tm->r(d) * partMass;
-            }
-        }
+
+        // the local _balance and _mass were summed up in visitMolecule()
 
         // COMMUNICATION
         domainDecomp->collCommInit(4);
@@ -173,6 +165,37 @@ void COMaligner::beforeForces(ParticleContainer* particleContainer,
     // TODO: Check for OpenMP implementation of above for-loop
 }
 
+//! @brief the local center of mass is summed up in every alignment step
+bool COMaligner::beginMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) {
+    if (hook != MoleculeVisitHook::BEFORE_FORCES or not _enabled or (simstep - 1) % _interval != 0) {
+        return false;
+    }
+    _threadBalances.assign(mardyn_get_max_threads(), ThreadBalance{{0.0, 0.0, 0.0}, 0.0});
+    return true;
+}
+
+void COMaligner::visitMolecule(MoleculeVisitHook /*hook*/, Molecule& molecule, int threadNum) {
+    ThreadBalance& threadBalance = _threadBalances[threadNum];
+    double partMass = molecule.mass();
+    threadBalance.mass += partMass;
+    for (int d = _dim_start; d < _dim_end; d += _dim_step) {
+        threadBalance.balance[d] += molecule.r(d) * partMass;
+    }
+}
+
+void COMaligner::endMoleculeVisit(MoleculeVisitHook /*hook*/, unsigned long /*simstep*/) {
+    for (unsigned d = 0; d < 3; d++) {
+        _balance[d] = 0.0;
+    }
+    _mass = 0;
+    for (const auto& threadBalance : _threadBalances) {
+        for (unsigned d = 0; d < 3; d++) {
+            _balance[d] += threadBalance.balance[d];
+        }
+        _mass += threadBalance.mass;
+    }
+}
+
 //! @brief called after Forces are applied
 //! applies the motion calculated earlier
 //!
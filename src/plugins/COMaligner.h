@@ -14,6 +14,8 @@ class COMalignerTest;
 #include "Domain.h"
 #include "parallel/DomainDecompBase.h"
 
+#include <vector>
+
 /** @brief
 * Plugin: can be enabled via config.xml <br>
 *
@@ -60,6 +62,13 @@ private:
     double _boxLength[3];
     double _cutoff;
 
+    //! partial sums of one thread, padded to a cache line to avoid false sharing
+    struct alignas(64) ThreadBalance {
+        double balance[3];
+        double mass;
+    };
+    std::vector<ThreadBalance> _threadBalances;
+
 public:
     COMaligner(){
         // SETUP
@@ -85,6 +94,13 @@ public:
 
     void beforeForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, unsigned long simstep) override;
 
+    //! the center of mass is summed up in the common pass of the simulation before the forces
+    bool beginMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) override;
+
+    void visitMolecule(MoleculeVisitHook hook, Molecule& molecule, int threadNum) override;
+
+    void endMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) override;
+
     void endStep(
             ParticleContainer *particleContainer, DomainDecompBase *domainDecomp,
             Domain *domain, unsigned long simstep) override;
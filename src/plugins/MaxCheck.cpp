@@ -11,7 +11,9 @@
 #include "parallel/DomainDecompBase.h"
 #include "molecules/Molecule.h"
 #include "utils/Logger.h"
+#include "WrapOpenMP.h"
 #include <array>
+#include <unordered_set>
 
 using namespace std;
 using Log::global_log;
@@ -121,7 +123,7 @@ void MaxCheck::beforeEventNewTimestep(
 	if (simstep < _control.start || simstep > _control.stop
 			|| simstep % _control.freq != 0)
 		return;
-	this->checkMaxVals(particleContainer, domainDecomp, simstep);
+	this->deleteMarkedMolecules(particleContainer);
 }
 
 void MaxCheck::afterForces(
@@ -132,114 +134,134 @@ void MaxCheck::afterForces(
 	if (simstep < _control.start || simstep > _control.stop
 			|| simstep % _control.freq != 0)
 		return;
-	this->checkMaxVals(particleContainer, domainDecomp, simstep);
+	this->deleteMarkedMolecules(particleContainer);
 }
 
-void MaxCheck::checkMaxVals(ParticleContainer* particleContainer,
-		DomainDecompBase* domainDecomp, unsigned long simstep) {
+bool MaxCheck::beginMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) {
+	if (hook != MoleculeVisitHook::BEFORE_EVENT_NEW_TIMESTEP and hook != MoleculeVisitHook::AFTER_FORCES)
+		return false;
+	if (simstep < _control.start || simstep > _control.stop
+			|| simstep % _control.freq != 0)
+		return false;
+	_threadDeletions.resize(mardyn_get_max_threads());
+	for (auto& deletions : _threadDeletions) {
+		deletions.clear();
+	}
+	return true;
+}
 
-#if defined(_OPENMP)
-#pragma omp parallel
-#endif
-	{
-		uint32_t cid_ub;
-		std::array<double,3> r;
-		std::array<double,3> F;
-		std::array<double,3> v;
-		std::array<double,3> M;
-		std::array<double,3> L;
-		MaxVals absVals;
-
-		for (auto it = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
-			cid_ub = it->componentid() + 1;
-			for (uint8_t d = 0; d < 3; ++d) {
-				r[d] = it->r(d);
-				F[d] = it->F(d);
-				v[d] = it->v(d);
-				M[d] = it->M(d);
-				L[d] = it->D(d);
-			}
+void MaxCheck::visitMolecule(MoleculeVisitHook /*hook*/, Molecule& molecule, int threadNum) {
+	uint32_t cid_ub;
+	std::array<double,3> r;
+	std::array<double,3> F;
+	std::array<double,3> v;
+	std::array<double,3> M;
+	std::array<double,3> L;
+	MaxVals absVals;
+
+	cid_ub = molecule.componentid() + 1;
+	for (uint8_t d = 0; d < 3; ++d) {
+		r[d] = molecule.r(d);
+		F[d] = molecule.F(d);
+		v[d] = molecule.v(d);
+		M[d] = molecule.M(d);
+		L[d] = molecule.D(d);
+	}
 
-			// check range
-			bool isInside = this->moleculeInsideRange(r);
-			if (_range.inclusive and not isInside) {
-				// If the range is inclusive, we skip if the particle is not in the range.
-				continue;
-			}
-			if (not _range.inclusive and isInside) {
-				// If the range is exclusive, we skip if the particle is in the range.
- 				continue;
-			}
+	// check range
+	bool isInside = this->moleculeInsideRange(r);
+	if (_range.inclusive and not isInside) {
+		// If the range is inclusive, we skip if the particle is not in the range.
+		return;
+	}
+	if (not _range.inclusive and isInside) {
+		// If the range is exclusive, we skip if the particle is in the range.
+		return;
+	}
 
-			// calc abs vals
-			absVals.F2 = this->calcSquaredVectorLength(F);
-			absVals.v2 = this->calcSquaredVectorLength(v);
-			absVals.M2 = this->calcSquaredVectorLength(M);
-			absVals.L2 = this->calcSquaredVectorLength(L);
-
-			MaxVals &mv = _maxVals[cid_ub];
-
-			if (MCM_LIMIT_TO_MAX_VALUE == mv.method) {
-				if (mv.F > 0. && absVals.F2 > mv.F2) {
-					double Fabs = sqrt(absVals.F2);
-					double scale = mv.F / Fabs;
-					it->scale_F(scale);
-				}
-
-				if (mv.v > 0. && absVals.v2 > mv.v2) {
-					double vabs = sqrt(absVals.v2);
-					double scale = mv.v / vabs;
-					it->scale_v(scale);
-				}
-				
-				if (mv.M > 0. && absVals.M2 > mv.M2) {
-					double Mabs = sqrt(absVals.M2);
-					double scale = mv.M / Mabs;
-					it->scale_M(scale);
-				}
-
-				if (mv.L > 0. && absVals.L2 > mv.L2) {
-					double Labs = sqrt(absVals.L2);
-					double scale = mv.L / Labs;
-					it->scale_D(scale);
-				}
-			} else if (MCM_LIMIT_TO_MAX_VALUE_OVERLAPS == mv.method) {
-				if (mv.F > 0. && absVals.F2 > mv.F2) {
-					double Fabs = sqrt(absVals.F2);
-					double scale = mv.F / Fabs;
-					it->scale_F(scale);
-
-					if (mv.v > 0. && absVals.v2 > mv.v2) {
-						double vabs = sqrt(absVals.v2);
-						scale = mv.v / vabs;
-						it->scale_v(scale);
-					}
-				}
-				if (mv.M > 0. && absVals.M2 > mv.M2) {
-					double Mabs = sqrt(absVals.M2);
-					double scale = mv.M / Mabs;
-					it->scale_M(scale);
-
-					if (mv.L > 0. && absVals.L2 > mv.L2) {
-						double Labs = sqrt(absVals.L2);
-						scale = mv.L / Labs;
-						it->scale_D(scale);
-					}
-				}
-			} else if (MCM_DELETE_PARTICLES == mv.method) {
-				if ( (mv.F > 0. && absVals.F2 > mv.F2) || (mv.v > 0. && absVals.v2 > mv.v2) || (mv.M > 0. && absVals.M2 > mv.M2) || (mv.L > 0. && absVals.L2 > mv.L2) )
-				    particleContainer->deleteMolecule(it, false);
-				//				_deletions.push_back(&(*it));
+	// components without target have nothing to check
+	auto mvIter = _maxVals.find(cid_ub);
+	if (mvIter == _maxVals.end()) {
+		return;
+	}
+	const MaxVals &mv = mvIter->second;
+
+	// calc abs vals
+	absVals.F2 = this->calcSquaredVectorLength(F);
+	absVals.v2 = this->calcSquaredVectorLength(v);
+	absVals.M2 = this->calcSquaredVectorLength(M);
+	absVals.L2 = this->calcSquaredVectorLength(L);
+
+	if (MCM_LIMIT_TO_MAX_VALUE == mv.method) {
+		if (mv.F > 0. && absVals.F2 > mv.F2) {
+			double Fabs = sqrt(absVals.F2);
+			double scale = mv.F / Fabs;
+			molecule.scale_F(scale);
+		}
+
+		if (mv.v > 0. && absVals.v2 > mv.v2) {
+			double vabs = sqrt(absVals.v2);
+			double scale = mv.v / vabs;
+			molecule.scale_v(scale);
+		}
+
+		if (mv.M > 0. && absVals.M2 > mv.M2) {
+			double Mabs = sqrt(absVals.M2);
+			double scale = mv.M / Mabs;
+			molecule.scale_M(scale);
+		}
+
+		if (mv.L > 0. && absVals.L2 > mv.L2) {
+			double Labs = sqrt(absVals.L2);
+			double scale = mv.L / Labs;
+			molecule.scale_D(scale);
+		}
+	} else if (MCM_LIMIT_TO_MAX_VALUE_OVERLAPS == mv.method) {
+		if (mv.F > 0. && absVals.F2 > mv.F2) {
+			double Fabs = sqrt(absVals.F2);
+			double scale = mv.F / Fabs;
+			molecule.scale_F(scale);
+
+			if (mv.v > 0. && absVals.v2 > mv.v2) {
+				double vabs = sqrt(absVals.v2);
+				scale = mv.v / vabs;
+				molecule.scale_v(scale);
+			}
+		}
+		if (mv.M > 0. && absVals.M2 > mv.M2) {
+			double Mabs = sqrt(absVals.M2);
+			double scale = mv.M / Mabs;
+			molecule.scale_M(scale);
+
+			if (mv.L > 0. && absVals.L2 > mv.L2) {
+				double Labs = sqrt(absVals.L2);
+				scale = mv.L / Labs;
+				molecule.scale_D(scale);
 			}
 		}
+	} else if (MCM_DELETE_PARTICLES == mv.method) {
+		// the visit must not delete molecules, they are deleted in the hook method right after the visit
+		if ( (mv.F > 0. && absVals.F2 > mv.F2) || (mv.v > 0. && absVals.v2 > mv.v2) || (mv.M > 0. && absVals.M2 > mv.M2) || (mv.L > 0. && absVals.L2 > mv.L2) )
+			_threadDeletions[threadNum].push_back(molecule.getID());
+	}
+}
 
-		//		// perform deletions
-		//		for(auto it:_deletions) {
-		//			particleContainer->deleteMolecule(*it, true);
-		//			_deletions.pop_back();
-		//		}
+void MaxCheck::deleteMarkedMolecules(ParticleContainer* particleContainer) {
+	std::unordered_set<unsigned long> deletions;
+	for (auto& threadDeletions : _threadDeletions) {
+		deletions.insert(threadDeletions.begin(), threadDeletions.end());
+		threadDeletions.clear();
+	}
+	if (deletions.empty())
+		return;
 
-	} // end pragma omp parallel
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+	for (auto it = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+		if (deletions.count(it->getID()) > 0)
+			particleContainer->deleteMolecule(it, false);
+	}
 }
 
 bool MaxCheck::moleculeInsideRange(std::array<double,3>& r)
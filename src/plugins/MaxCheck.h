@@ -121,18 +121,26 @@ public:
 	void finish(ParticleContainer *particleContainer,
 				DomainDecompBase *domainDecomp, Domain *domain) override {}
 
+	/** @brief The values are checked and limited in the common pass of the simulation at the hook points
+	 * beforeEventNewTimestep and afterForces. Molecules failing the check with method 3 are only marked there and
+	 * deleted by the hook method.
+	 */
+	bool beginMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) override;
+	void visitMolecule(MoleculeVisitHook hook, Molecule& molecule, int threadNum) override;
+
 	std::string getPluginName() override {return std::string("MaxCheck");}
 	static PluginBase* createInstance() {return new MaxCheck();}
 
 private:
 	double calcSquaredVectorLength(std::array<double,3>& vec) {return (vec[0]*vec[0] + vec[1]*vec[1] + vec[2]*vec[2]);}
-	void checkMaxVals(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, unsigned long simstep);
+	void deleteMarkedMolecules(ParticleContainer* particleContainer);
 	bool moleculeInsideRange(std::array<double,3>& r);
 
 private:
 	TimestepControl _control;
 	maxvals_map _maxVals;
-	std::vector<Molecule*> _deletions;
+	//! ids of the molecules to delete, marked by each thread in visitMolecule()
+	std::vector<std::vector<unsigned long> > _threadDeletions;
 	struct Range {double xmin, xmax, ymin, ymax, zmin, zmax; bool inclusive;} _range;
 };
 
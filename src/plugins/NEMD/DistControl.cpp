@@ -9,6 +9,7 @@
 #include "molecules/Molecule.h"
 #include "Domain.h"
 #include "Simulation.h"
+#include "WrapOpenMP.h"
 #include "particleContainer/ParticleContainer.h"
 #include "parallel/DomainDecompBase.h"
 #include "utils/Region.h"
@@ -236,10 +237,7 @@ void DistControl::init(ParticleContainer *particleContainer,
 void DistControl::beforeForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
 		unsigned long simstep)
 {
-	for(auto it = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
-		// sample density profile
-		this->SampleProfiles(&(*it));
-	}
+	// the density profile was sampled in visitMolecule()
 
 	// determine interface midpoints and update region positions
 	this->UpdatePositions(simstep);
@@ -249,6 +247,33 @@ void DistControl::beforeForces(ParticleContainer* particleContainer, DomainDecom
 	this->WriteDataProfiles(simstep);
 }
 
+bool DistControl::beginMoleculeVisit(MoleculeVisitHook hook, unsigned long /*simstep*/)
+{
+	if(hook != MoleculeVisitHook::BEFORE_FORCES)
+		return false;
+	_threadNumMolecules.assign(mardyn_get_max_threads() * _nNumValuesScalar, 0);
+	_threadForceSum.assign(mardyn_get_max_threads() * _nNumValuesScalar, 0.);
+	return true;
+}
+
+void DistControl::visitMolecule(MoleculeVisitHook /*hook*/, Molecule& molecule, int threadNum)
+{
+	const uint64_t nOffset = threadNum * _nNumValuesScalar;
+	this->SampleProfiles(&molecule, &_threadNumMolecules[nOffset], &_threadForceSum[nOffset]);
+}
+
+void DistControl::endMoleculeVisit(MoleculeVisitHook /*hook*/, unsigned long /*simstep*/)
+{
+	const int numThreads = mardyn_get_max_threads();
+	for(int t=0; t<numThreads; ++t) {
+		const uint64_t nOffset = t * _nNumValuesScalar;
+		for(auto s=0u; s<_nNumValuesScalar; ++s) {
+			_nNumMolecules.local[s] += _threadNumMolecules[nOffset + s];
+			_dForceSum.local[s] += _threadForceSum[nOffset + s];
+		}
+	}
+}
+
 void DistControl::PrepareSubdivision()
 {
 	Domain* domain = global_simulation->getDomain();
@@ -329,6 +354,11 @@ void DistControl::PrepareDataStructures()
 }
 
 void DistControl::SampleProfiles(Molecule* mol)
+{
+	this->SampleProfiles(mol, _nNumMolecules.local.data(), _dForceSum.local.data());
+}
+
+void DistControl::SampleProfiles(Molecule* mol, uint64_t* nNumMolecules, double* dForceSum)
 {
 	unsigned int nPosIndex;
 	unsigned int nIndexMax = _binParams.count - 1;
@@ -342,13 +372,13 @@ void DistControl::SampleProfiles(Molecule* mol)
 	if(nPosIndex > nIndexMax)  // negative values will be ignored to: cast to unsigned int --> high value
 		return;
 
-	_nNumMolecules.local.at(nPosIndex)++;
-	_dForceSum.local.at(nPosIndex) += mol->F(1);
+	nNumMolecules[nPosIndex]++;
+	dForceSum[nPosIndex] += mol->F(1);
 
 	unsigned short cid = mol->componentid() + 1;  // cid == 0: sum of all components
 	unsigned long nOffset = _nOffsets[cid] + nPosIndex;
-	_nNumMolecules.local.at(nOffset)++;
-	_dForceSum.local.at(nOffset) += mol->F(1);
+	nNumMolecules[nOffset]++;
+	dForceSum[nOffset] += mol->F(1);
 }
 
 void DistControl::CalcProfiles()
@@ -105,6 +105,13 @@ public:
 	void finish(ParticleContainer *particleContainer,
 				DomainDecompBase *domainDecomp, Domain *domain) override {}
 
+	//! the density and force profiles are sampled in the common pass of the simulation before the forces
+	bool beginMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) override;
+	void visitMolecule(MoleculeVisitHook hook, Molecule& molecule, int threadNum) override;
+	void endMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) override;
+	//! only moves the regions of the observers, not the molecules
+	bool modifiesMoleculesAt(MoleculeVisitHook /*hook*/) override {return false;}
+
 	std::string getPluginName() override {return std::string("DistControl");}
 	static PluginBase* createInstance() {return new DistControl();}
 
@@ -146,6 +153,7 @@ private:
 	void EstimateInterfaceMidpoint();  // called by UpdatePositions
 	void EstimateInterfaceMidpointsByForce();
 	void ResetLocalValues();
+	void SampleProfiles(Molecule* mol, uint64_t* nNumMolecules, double* dForceSum);
 
 	// data structures
 	void InitDataStructures();
@@ -167,7 +175,10 @@ private:
 	std::vector<uint64_t> _nOffsets;
 
 	CommVar<std::vector<uint64_t> > _nNumMolecules;
-	CommVar<std::vector<uint64_t> > _dForceSum;
+	CommVar<std::vector<double> > _dForceSum;
+	// thread-private sampling bins (_nNumValuesScalar values per thread), summed up into the local values
+	std::vector<uint64_t> _threadNumMolecules;
+	std::vector<double> _threadForceSum;
 	std::vector<double> _dMidpointPositions;
 	std::vector<double> _dDensityProfile;
 	std::vector<double> _dDensityProfileSmoothed;
@@ -5,6 +5,7 @@
 #include "molecules/Molecule.h"
 #include "utils/Logger.h"
 #include "utils/FileUtils.h"
+#include "WrapOpenMP.h"
 
 #include <fstream>
 #include <cmath>
@@ -133,34 +134,57 @@ void DriftCtrl::readXML(XMLfileUnits& xmlconfig)
 		<< _target.drift.at(0) << "," << _target.drift.at(1) << "," << _target.drift.at(2) << ", cid=" << _target.cid<< endl;
 }
 
-void DriftCtrl::beforeForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, unsigned long simstep)
+bool DriftCtrl::beginMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep)
 {
-	int nRank = domainDecomp->getRank();
+	if(hook != MoleculeVisitHook::BEFORE_FORCES || simstep % _control.freq.sample != 0)
+		return false;
+	const uint64_t numVals = static_cast<uint64_t>(mardyn_get_max_threads()) * _sampling.size() * _range.subdivision.numBins;
+	_threadNumParticles.assign(numVals, 0);
+	_threadMomentum.assign(3 * numVals, 0.);
+	return true;
+}
+
+void DriftCtrl::visitMolecule(MoleculeVisitHook /*hook*/, Molecule& molecule, int threadNum)
+{
+	// check if inside range
+	double yPos = molecule.r(1);
+	if(yPos <= _range.yl || yPos > _range.yr)
+		return;
 	
-	// sample
-	if(simstep % _control.freq.sample == 0)
-	{
-		for(auto it = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
-			// check if inside range
-			double yPos = it->r(1);
-			if(yPos <= _range.yl || yPos > _range.yr)
-				continue;
-			
-			uint32_t cid_zb = it->componentid();
-			uint32_t cid_ub = cid_zb+1;
-			uint32_t yPosID = floor( (yPos-_range.yl) / _range.subdivision.binWidth.actual);
-			double mass = 1.;  //TODO: get mass
-			std::array<double,3> p;  // momentum
-			p.at(0) = it->v(0) * mass;
-			p.at(1) = it->v(1) * mass;
-			p.at(2) = it->v(2) * mass;
+	uint32_t cid_zb = molecule.componentid();
+	uint32_t cid_ub = cid_zb+1;
+	uint32_t yPosID = floor( (yPos-_range.yl) / _range.subdivision.binWidth.actual);
+	double mass = 1.;  //TODO: get mass
 
-			_sampling.at(cid_ub).numParticles.local.at(yPosID)++;
-			_sampling.at(cid_ub).momentum.at(0).local.at(yPosID) += p.at(0);
-			_sampling.at(cid_ub).momentum.at(1).local.at(yPosID) += p.at(1);
-			_sampling.at(cid_ub).momentum.at(2).local.at(yPosID) += p.at(2);
+	const uint64_t binID = (static_cast<uint64_t>(threadNum) * _sampling.size() + cid_ub) * _range.subdivision.numBins + yPosID;
+	_threadNumParticles[binID]++;
+	for(uint32_t d = 0; d < 3; ++d)
+		_threadMomentum[3 * binID + d] += molecule.v(d) * mass;  // momentum
+}
+
+void DriftCtrl::endMoleculeVisit(MoleculeVisitHook /*hook*/, unsigned long /*simstep*/)
+{
+	const int numThreads = mardyn_get_max_threads();
+	for(int t = 0; t < numThreads; ++t)
+	{
+		for(uint32_t cid = 0; cid < _sampling.size(); ++cid)
+		{
+			for(uint32_t yPosID = 0; yPosID < _range.subdivision.numBins; ++yPosID)
+			{
+				const uint64_t binID = (static_cast<uint64_t>(t) * _sampling.size() + cid) * _range.subdivision.numBins + yPosID;
+				_sampling.at(cid).numParticles.local.at(yPosID) += _threadNumParticles[binID];
+				for(uint32_t d = 0; d < 3; ++d)
+					_sampling.at(cid).momentum.at(d).local.at(yPosID) += _threadMomentum[3 * binID + d];
+			}
 		}
 	}
+}
+
+void DriftCtrl::beforeForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, unsigned long simstep)
+{
+	int nRank = domainDecomp->getRank();
+	
+	// the molecules were sampled in visitMolecule()
 	
 	// control
 	if(simstep % _control.freq.control == 0)
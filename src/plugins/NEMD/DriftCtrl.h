@@ -62,6 +62,10 @@ public:
 			  DomainDecompBase *domainDecomp, Domain *domain) override;
 
 	void beforeForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, unsigned long simstep) override;
+	//! the momentum is sampled in the common pass of the simulation before the forces, the correction is done here
+	bool beginMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) override;
+	void visitMolecule(MoleculeVisitHook hook, Molecule& molecule, int threadNum) override;
+	void endMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) override;
 	void afterForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, unsigned long simstep) override {}
 	void endStep(ParticleContainer *particleContainer, DomainDecompBase *domainDecomp, Domain *domain, unsigned long simstep) override {}
 	void finish(ParticleContainer *particleContainer, DomainDecompBase *domainDecomp, Domain *domain) override {}
@@ -90,6 +94,9 @@ private:
 	} _target;
 	
 	std::vector<BinVectors> _sampling;
+	// thread-private sampling bins, layout [thread][component][bin], momentum with 3 values per bin
+	std::vector<uint64_t> _threadNumParticles;
+	std::vector<double> _threadMomentum;
 };
 
 #endif /*DRIFTCTRL_H_*/
@@ -17,6 +17,7 @@
 #include "utils/xmlfileUnits.h"
 #include "utils/Random.h"
 #include "utils/FileUtils.h"
+#include "WrapOpenMP.h"
 #include "io/ReplicaGenerator.h"  // class MoleculeDataReader
 
 #include <map>
@@ -444,7 +445,7 @@ void MettDeamon::init(ParticleContainer* particleContainer, DomainDecompBase* do
 }
 void MettDeamon::beforeEventNewTimestep(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, unsigned long simstep)
 {
-	this->init_positionMap(particleContainer);
+	// the positions of the trapped molecules were stored in visitMolecule()
 }
 void MettDeamon::beforeForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, unsigned long simstep)
 {
@@ -533,31 +534,78 @@ void MettDeamon::prepare_start(DomainDecompBase* domainDecomp, ParticleContainer
 	}
 }
 
-void MettDeamon::init_positionMap(ParticleContainer* particleContainer)
+bool MettDeamon::beginMoleculeVisit(MoleculeVisitHook hook, unsigned long /*simstep*/)
 {
-	for(auto pit = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); pit.isValid(); ++pit)
+	if(MoleculeVisitHook::BEFORE_EVENT_NEW_TIMESTEP == hook) {
+		_threadStorePosition.resize(mardyn_get_max_threads() );
+		for(auto&& positions : _threadStorePosition)
+			positions.clear();
+		return true;
+	}
+	// in case of an empty reservoir, the molecules are not touched after the forces
+	return MoleculeVisitHook::AFTER_FORCES == hook && RRM_EMPTY != _reservoir->getReadMethod();
+}
+
+void MettDeamon::visitMolecule(MoleculeVisitHook hook, Molecule& molecule, int threadNum)
+{
+	if(MoleculeVisitHook::BEFORE_EVENT_NEW_TIMESTEP == hook)
+		this->storePosition(molecule, threadNum);
+	else
+		this->resetTrappedMolecule(molecule);
+}
+
+void MettDeamon::endMoleculeVisit(MoleculeVisitHook hook, unsigned long /*simstep*/)
+{
+	if(MoleculeVisitHook::BEFORE_EVENT_NEW_TIMESTEP != hook)
+		return;
+	for(auto&& positions : _threadStorePosition)
+		for(auto&& idPos : positions)
+			_storePosition[idPos.first] = idPos.second;
+}
+
+void MettDeamon::storePosition(Molecule& molecule, int threadNum)
+{
+	uint32_t cid = molecule.componentid();
+
+	bool bIsTrappedMolecule = this->IsTrappedMolecule(cid);
+	if(bIsTrappedMolecule)
 	{
-		uint64_t mid = pit->getID();
-		uint32_t cid = pit->componentid();
+		//savevelo
+		std::array<double,10> pos;
+		pos.at(0) = molecule.r(0);
+		pos.at(1) = molecule.r(1);
+		pos.at(2) = molecule.r(2);
+		pos.at(3) = molecule.v(0);
+		pos.at(4) = molecule.v(1);
+		pos.at(5) = molecule.v(2);
+		Quaternion q = molecule.q();
+		pos.at(6) = q.qw();
+		pos.at(7) = q.qx();
+		pos.at(8) = q.qy();
+		pos.at(9) = q.qz();
+		_threadStorePosition[threadNum].emplace_back(molecule.getID(), pos);
+	}
+}
 
-		bool bIsTrappedMolecule = this->IsTrappedMolecule(cid);
-		if(bIsTrappedMolecule)
-		{
-			//savevelo
-			std::array<double,10> pos;
-			pos.at(0) = pit->r(0);
-			pos.at(1) = pit->r(1);
-			pos.at(2) = pit->r(2);
-			pos.at(3) = pit->v(0);
-			pos.at(4) = pit->v(1);
-			pos.at(5) = pit->v(2);
-			Quaternion q = pit->q();
-			pos.at(6) = q.qw();
-			pos.at(7) = q.qx();
-			pos.at(8) = q.qy();
-			pos.at(9) = q.qz();
-			_storePosition[pit->getID()] = pos;
-		}
+void MettDeamon::resetTrappedMolecule(Molecule& molecule)
+{
+	uint32_t cid_zb = molecule.componentid();
+	uint32_t cid_ub = cid_zb+1;
+	double dY = molecule.r(1);
+	if(dY > _manipfree.ymin && dY < _manipfree.ymax)
+		return;
+
+	if(cid_ub == _manipfree.cid_ub)
+		return;
+
+	bool bIsTrappedMolecule = this->IsTrappedMolecule(cid_zb);
+
+	if(bIsTrappedMolecule) {
+		molecule.setD(0, 0.);
+		molecule.setD(1, 0.);
+		molecule.setD(2, 0.);
+
+		this->resetVelocity(&molecule);
 	}
 }
 
@@ -767,28 +815,7 @@ void MettDeamon::postForce_action(ParticleContainer* particleContainer, DomainDe
 	unsigned long nNumMoleculesLocal = 0;
 	unsigned long nNumMoleculesGlobal = 0;
 
-	for(auto pit = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); pit.isValid(); ++pit)
-	{
-		uint32_t cid_zb = pit->componentid();
-		uint32_t cid_ub = cid_zb+1;
-		double dY = pit->r(1);
-		if(dY > _manipfree.ymin && dY < _manipfree.ymax)
-			continue;
-
-		if(cid_ub == _manipfree.cid_ub)
-			continue;
-
-		bool bIsTrappedMolecule = this->IsTrappedMolecule(cid_zb);
-
-		if(bIsTrappedMolecule) {
-			pit->setD(0, 0.);
-			pit->setD(1, 0.);
-			pit->setD(2, 0.);
-
-			this->resetVelocity( &(*pit) );
-		}
-
-	}  // loop over molecules
+	// the trapped molecules were reset in visitMolecule()
 
 	nNumMoleculesLocal = particleContainer->getNumberOfParticles();
 
@@ -197,6 +197,16 @@ public:
 	void afterForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, unsigned long simstep) override;
 	void endStep(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain, unsigned long simstep) override {};
 	void finish(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain) override {};
+	/** @brief The positions of the trapped molecules are stored (beforeEventNewTimestep) and the trapped molecules are
+	 * reset after the forces (afterForces) in the common pass of the simulation. Releasing, deleting and inserting
+	 * molecules before the forces stays a serial loop in preForce_action(), because the molecules are deleted and draw
+	 * their release velocities from shared sequences in iteration order.
+	 */
+	bool beginMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) override;
+	void visitMolecule(MoleculeVisitHook hook, Molecule& molecule, int threadNum) override;
+	void endMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) override;
+	bool modifiesMoleculesAt(MoleculeVisitHook hook) override {return MoleculeVisitHook::BEFORE_FORCES == hook;}
+
 	std::string getPluginName() override {return std::string("MettDeamon");}
 	static PluginBase* createInstance() {return new MettDeamon();}
 
@@ -206,7 +216,6 @@ public:
 	double  getTransitionPlanePosY() {return _dTransitionPlanePosY;}
 
 	void prepare_start(DomainDecompBase* domainDecomp, ParticleContainer* particleContainer, double cutoffRadius);
-	void init_positionMap(ParticleContainer* particleContainer);
 	void preForce_action(ParticleContainer* particleContainer, double cutoffRadius);
 	void postForce_action(ParticleContainer* particleContainer, DomainDecompBase* domainDecomposition);
 
@@ -257,6 +266,8 @@ private:
 	void releaseTrappedMolecule(Molecule* mol, bool& bDeleteParticle);
 	void resetPositionAndOrientation(Molecule* mol, const double& dBoxY);
 	void resetVelocity(Molecule* mol);
+	void storePosition(Molecule& molecule, int threadNum);
+	void resetTrappedMolecule(Molecule& molecule);
 
 	void InitTransitionPlane(Domain* domain);
 	void getAvailableParticleIDs(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
@@ -296,6 +307,7 @@ private:
 	int64_t _numDeletedMolsSum;
 	uint64_t _nDeleteNonVolatile;
 	std::map<uint64_t, std::array<double,10> > _storePosition;  //Map for frozen particle position storage <"id, position">
+	std::vector<std::vector<std::pair<uint64_t, std::array<double,10> > > > _threadStorePosition;  // positions stored by each thread, merged into _storePosition
 	std::list<uint64_t> _listDeletedMolecules;
 	// identity change (by component ID)
 	std::vector<uint32_t> _vecChangeCompIDsFreeze;
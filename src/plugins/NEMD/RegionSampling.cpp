@@ -14,6 +14,7 @@
 #include "utils/FileUtils.h"
 #include "utils/xmlfileUnits.h"
 #include "DistControl.h"
+#include "WrapOpenMP.h"
 
 #include <iostream>
 #include <fstream>
@@ -35,28 +36,6 @@ using namespace std;
 // init static ID --> instance counting
 unsigned short SampleRegion::_nStaticID = 0;
 
-void SampleRegion::get_v(double* q, Molecule* mol)
-{
-	for(uint16_t d=0; d<3; ++d)
-		q[d] = mol->v(d);
-}
-
-void SampleRegion::get_F(double* q, Molecule* mol)
-{
-	for(uint16_t d=0; d<3; ++d)
-		q[d] = mol->F(d);
-}
-
-void SampleRegion::get_v2(double& q, Molecule* mol)
-{
-	q = mol->v2();
-}
-
-void SampleRegion::get_F2(double& q, Molecule* mol)
-{
-	q = mol->F2();
-}
-
 SampleRegion::SampleRegion( RegionSampling* parent, double dLowerCorner[3], double dUpperCorner[3] )
 	: CuboidRegionObs(parent, dLowerCorner, dUpperCorner),
 	_bDiscretisationDoneProfiles(false),
@@ -83,12 +62,18 @@ SampleRegion::SampleRegion( RegionSampling* parent, double dLowerCorner[3], doub
 	// Init component specific parameters for VDF sampling
 	this->initComponentSpecificParamsVDF();
 
-	_fptr = get_v;
-	_f2ptr = get_v2;
+	_bSampleForcesVDF = false;
+	_bSampleComponentSumVDF = false;
 	_boolSingleComp = false;
+
+	_numThreadCopies = mardyn_get_max_threads();
 }
 
-SampleRegion::~SampleRegion() {}
+SampleRegion::~SampleRegion()
+{
+	for(auto&& lock : _threadCopyLocks)
+		mardyn_destroy_lock(&lock);
+}
 
 void SampleRegion::initComponentSpecificParamsVDF()
 {
@@ -260,14 +245,12 @@ void SampleRegion::readXML(XMLfileUnits& xmlconfig)
 		{
 			if("VDF" == strSamplingModuleType)
 			{
-				_fptr = get_v;
-				_f2ptr = get_v2;
+				_bSampleForcesVDF = false;
 				_fnamePrefixVDF = "VDF";
 			}
 			else if("FDF" == strSamplingModuleType)
 			{
-				_fptr = get_F;
-				_f2ptr = get_F2;
+				_bSampleForcesVDF = true;
 				_fnamePrefixVDF = "FDF";
 			}
 
@@ -691,6 +674,17 @@ void SampleRegion::initSamplingProfiles(int nDimension)
 	resizeExactly(_d2EkinDriftComp, _nNumValsVector);
 	resizeExactly(_dTemperatureComp, _nNumValsVector);
 
+	// thread-private bins
+	_threadValuesProfiles.resize(mardyn_get_max_threads());
+	for(auto&& tv : _threadValuesProfiles) {
+		resizeExactly(tv.nNumMolecules, _nNumValsScalar);
+		resizeExactly(tv.nRotDOF, _nNumValsScalar);
+		resizeExactly(tv.d2EkinRot, _nNumValsScalar);
+		resizeExactly(tv.dVelocity, _nNumValsVector);
+		resizeExactly(tv.dSquaredVelocity, _nNumValsVector);
+		resizeExactly(tv.dForce, _nNumValsVector);
+	}
+
 	// init sampling data structures
 	this->resetLocalValuesProfiles();
 
@@ -769,6 +763,18 @@ void SampleRegion::initSamplingVDF(int nDimension)
 	_dataPtrs.at(2).at(2) = _VDF_pjy_nvz_local.data();
 	_dataPtrs.at(2).at(3) = _VDF_pjy_pvz_local.data();
 
+	// thread-private bins
+	_threadValuesVDF.resize(mardyn_get_max_threads());
+	for(auto&& tv : _threadValuesVDF) {
+		resizeExactly(tv.VDF_pjy_abs, _numValsVDF);
+		resizeExactly(tv.VDF_njy_abs, _numValsVDF);
+		for(unsigned int d=0; d < 3; ++d)
+			for(unsigned int i=0; i < 4; ++i)
+				if(nullptr != _dataPtrs.at(d).at(i))
+					resizeExactly(tv.VDF_xvd.at(d).at(i), _numValsVDF);
+	}
+	_bSampleComponentSumVDF = _vecComponentSpecificParamsVDF.at(0).bSamplingEnabled;
+
 
 	// init local values
 	this->resetLocalValuesVDF();
@@ -856,6 +862,9 @@ void SampleRegion::initSamplingFieldYR(int nDimension)
 	// [direction all|+|-][component][position]
 	resizeExactly(_nNumMoleculesFieldYRLocal  , _nNumValsFieldYR);
 	resizeExactly(_nNumMoleculesFieldYRGlobal , _nNumValsFieldYR);
+	_nNumMoleculesFieldYRThread.resize(mardyn_get_max_threads());
+	for(auto&& tv : _nNumMoleculesFieldYRThread)
+		resizeExactly(tv, _nNumValsFieldYR);
 
 	// output profiles
 	resizeExactly(_dDensityFieldYR, _nNumValsFieldYR);
@@ -958,7 +967,7 @@ void SampleRegion::doDiscretisationFieldYR(int nDimension)
 	_bDiscretisationDoneFieldYR = true;
 }
 
-void SampleRegion::sampleProfiles(Molecule* molecule, int nDimension)
+void SampleRegion::sampleProfiles(Molecule* molecule, int nDimension, int threadNum)
 {
 	if(not _SamplingEnabledProfiles)
 		return;
@@ -979,10 +988,7 @@ void SampleRegion::sampleProfiles(Molecule* molecule, int nDimension)
 	if(nPosIndex > nIndexMax)  // negative values will be ignored to: cast to unsigned int --> high value
 		return;
 
-	unsigned int cid = molecule->componentid() + 1;  // id starts internally with 0
-	if(_boolSingleComp){
-		cid = 1;
-	}
+	unsigned int cid = _boolSingleComp ? 1 : molecule->componentid() + 1;  // id starts internally with 0
 	unsigned int nRotDOF = molecule->component()->getRotationalDegreesOfFreedom();
 	double d2EkinTrans = molecule->U_trans_2();
 	double d2EkinRot   = molecule->U_rot_2();
@@ -999,6 +1005,9 @@ void SampleRegion::sampleProfiles(Molecule* molecule, int nDimension)
 	v2[1] = v[1]*v[1];
 	v2[2] = v[2]*v[2];
 
+	// thread-private bins, no synchronization needed
+	ThreadValuesProfiles& tv = _threadValuesProfiles[threadNum % _numThreadCopies];
+
 	// Loop over directions: all (+/-) | only (+) | only (-)
 	for(unsigned int dir = 0; dir < 3; ++dir)
 	{
@@ -1016,31 +1025,12 @@ void SampleRegion::sampleProfiles(Molecule* molecule, int nDimension)
 		mardyn_assert(indexCID < _nNumValsScalar);
 
 		// Scalar quantities
-		#if defined(_OPENMP)
-		#pragma omp atomic
-		#endif
-		_nNumMoleculesLocal[ indexAll ] ++;  // all components
-		#if defined(_OPENMP)
-		#pragma omp atomic
-		#endif
-		_nNumMoleculesLocal[ indexCID ] ++;  // specific component
-		#if defined(_OPENMP)
-		#pragma omp atomic
-		#endif
-		_nRotDOFLocal      [ indexAll ] += nRotDOF;
-		#if defined(_OPENMP)
-		#pragma omp atomic
-		#endif
-		_nRotDOFLocal      [ indexCID ] += nRotDOF;
-
-		#if defined(_OPENMP)
-		#pragma omp atomic
-		#endif
-		_d2EkinRotLocal    [ indexAll ] += d2EkinRot;
-		#if defined(_OPENMP)
-		#pragma omp atomic
-		#endif
-		_d2EkinRotLocal    [ indexCID ] += d2EkinRot;
+		tv.nNumMolecules[ indexAll ] ++;  // all components
+		tv.nNumMolecules[ indexCID ] ++;  // specific component
+		tv.nRotDOF      [ indexAll ] += nRotDOF;
+		tv.nRotDOF      [ indexCID ] += nRotDOF;
+		tv.d2EkinRot    [ indexAll ] += d2EkinRot;
+		tv.d2EkinRot    [ indexCID ] += d2EkinRot;
 
 		// Vector quantities
 		// Loop over dimensions  x, y, z (vector components)
@@ -1052,36 +1042,18 @@ void SampleRegion::sampleProfiles(Molecule* molecule, int nDimension)
 			mardyn_assert(vIndexAll < _nNumValsVector);
 			mardyn_assert(vIndexCID < _nNumValsVector);
 
-			#if defined(_OPENMP)
-			#pragma omp atomic
-			#endif
-			_dVelocityLocal       [ vIndexAll ] += v[dim];
-			#if defined(_OPENMP)
-			#pragma omp atomic
-			#endif
-			_dVelocityLocal       [ vIndexCID ] += v[dim];
-			#if defined(_OPENMP)
-			#pragma omp atomic
-			#endif
-			_dSquaredVelocityLocal[ vIndexAll ] += v2[dim];
-			#if defined(_OPENMP)
-			#pragma omp atomic
-			#endif
-			_dSquaredVelocityLocal[ vIndexCID ] += v2[dim];
-			#if defined(_OPENMP)
-			#pragma omp atomic
-			#endif
-			_dForceLocal          [ vIndexAll ] += F[dim];
-			#if defined(_OPENMP)
-			#pragma omp atomic
-			#endif
-			_dForceLocal          [ vIndexCID ] += F[dim];
+			tv.dVelocity       [ vIndexAll ] += v[dim];
+			tv.dVelocity       [ vIndexCID ] += v[dim];
+			tv.dSquaredVelocity[ vIndexAll ] += v2[dim];
+			tv.dSquaredVelocity[ vIndexCID ] += v2[dim];
+			tv.dForce          [ vIndexAll ] += F[dim];
+			tv.dForce          [ vIndexCID ] += F[dim];
 		}
 	}
 }
 
 
-void SampleRegion::sampleVDF(Molecule* molecule, int nDimension)
+void SampleRegion::sampleVDF(Molecule* molecule, int nDimension, int threadNum)
 {
 
 	if(not _SamplingEnabledVDF)
@@ -1092,11 +1064,8 @@ void SampleRegion::sampleVDF(Molecule* molecule, int nDimension)
 	if(not _bDiscretisationDoneVDF)
 		return;
 
-	uint32_t cid = molecule->componentid()+1;  // 0: all components
-	if(_boolSingleComp){
-		cid = 1;
-	}
-	const ComponentSpecificParamsVDF& csp = _vecComponentSpecificParamsVDF.at(cid);
+	uint32_t cid = _boolSingleComp ? 1 : molecule->componentid()+1;  // 0: all components
+	const ComponentSpecificParamsVDF& csp = _vecComponentSpecificParamsVDF[cid];
 	if(not csp.bSamplingEnabled){
 		return;
 	}
@@ -1116,19 +1085,25 @@ void SampleRegion::sampleVDF(Molecule* molecule, int nDimension)
 	if(nBinIndex > nIndexMax)
 		return;
 
+	// sample either velocity or force vector
+	double v[3];
 	double absVal;
-	_f2ptr(absVal, molecule);
-	absVal = sqrt(absVal);
+	if(_bSampleForcesVDF) {
+		for(unsigned int d=0; d < 3; ++d)
+			v[d] = molecule->F(d);
+		absVal = sqrt(molecule->F2() );
+	}
+	else {
+		for(unsigned int d=0; d < 3; ++d)
+			v[d] = molecule->v(d);
+		absVal = sqrt(molecule->v2() );
+	}
 	double dInvVelocityClassWidth = csp.dInvVelocityClassWidth;
 	uint32_t nVelocityClassIndex = (uint32_t)(floor(absVal * dInvVelocityClassWidth) );
 
 	// calculate velocity vector indices for velocity components
-	double v[3];
 	uint32_t naVelocityClassIndex[3];
-
-	_fptr(v, molecule);  // sample either velocity or force vector
 	for(unsigned int d=0; d < 3; ++d) {
-		//v[d] = molecule->v(d);
 		naVelocityClassIndex[d] = (uint32_t)(floor( fabs( v[d] ) * dInvVelocityClassWidth) );
 	}
 
@@ -1139,57 +1114,31 @@ void SampleRegion::sampleVDF(Molecule* molecule, int nDimension)
 			return;
 	}
 
-	// sampling
-	bool bSampleComponentSum = _vecComponentSpecificParamsVDF.at(0).bSamplingEnabled;
+	// sampling into thread-private bins, no synchronization needed
+	ThreadValuesVDF& tv = _threadValuesVDF[threadNum % _numThreadCopies];
+
 	// velocity components
 	for(unsigned int d=0; d < 3; ++d)
 	{
 		uint8_t ptrIndex = 2*(v[1]>0.)+(v[d]>0.);
-		#if defined(_OPENMP)
-		#pragma omp atomic
-		#endif
-		_dataPtrs.at(d).at(ptrIndex)[ nOffset + naVelocityClassIndex[d] ]++;
-		if(bSampleComponentSum) {
-			#if defined(_OPENMP)
-			#pragma omp atomic
-			#endif
-			_dataPtrs.at(d).at(ptrIndex)[ nBinOffset + naVelocityClassIndex[d] ]++;
-		}
+		std::vector<uint64_t>& bins = tv.VDF_xvd[d][ptrIndex];
+		bins[ nOffset + naVelocityClassIndex[d] ]++;
+		if(_bSampleComponentSumVDF)
+			bins[ nBinOffset + naVelocityClassIndex[d] ]++;
 	}
 
 	// absolute velocity
 	if(nVelocityClassIndex > nIndexMaxVelo)  // v_abs > v_max? (respect finite resolution of velocity)
 		return;
 
-	if(v[1] > 0.)  // particle flux in positive y-direction
-	{
-		if(bSampleComponentSum) {
-			#if defined(_OPENMP)
-			#pragma omp atomic
-			#endif
-			_VDF_pjy_abs_local[nBinOffset + nVelocityClassIndex]++;
-		}
-		#if defined(_OPENMP)
-		#pragma omp atomic
-		#endif
-		_VDF_pjy_abs_local[nOffset + nVelocityClassIndex]++;
-	}
-	else  // particle flux in negative y-direction
-	{
-		if(bSampleComponentSum) {
-			#if defined(_OPENMP)
-			#pragma omp atomic
-			#endif
-			_VDF_njy_abs_local[nBinOffset + nVelocityClassIndex]++;
-		}
-		#if defined(_OPENMP)
-		#pragma omp atomic
-		#endif
-		_VDF_njy_abs_local[nOffset + nVelocityClassIndex]++;
-	}
+	// particle flux in positive or negative y-direction
+	std::vector<uint64_t>& absBins = (v[1] > 0.) ? tv.VDF_pjy_abs : tv.VDF_njy_abs;
+	if(_bSampleComponentSumVDF)
+		absBins[nBinOffset + nVelocityClassIndex]++;
+	absBins[nOffset + nVelocityClassIndex]++;
 }
 
-void SampleRegion::sampleFieldYR(Molecule* molecule)
+void SampleRegion::sampleFieldYR(Molecule* molecule, int threadNum)
 {
 	if(not _SamplingEnabledFieldYR)
 		return;
@@ -1229,38 +1178,17 @@ void SampleRegion::sampleFieldYR(Molecule* molecule)
 		mardyn_assert(_nOffsetFieldYR[0][sec][cid][nPosIndexR] + nPosIndexY < _nNumValsFieldYR);
 	}
 
+	// thread-private bins, no synchronization needed
+	std::vector<uint64_t>& nNumMolecules = _nNumMoleculesFieldYRThread[threadNum % _numThreadCopies];
+
 	// Scalar quantities
-	#if defined(_OPENMP)
-	#pragma omp atomic
-	#endif
-	_nNumMoleculesFieldYRLocal[ _nOffsetFieldYR[0][0][0  ][nPosIndexR] + nPosIndexY ] ++;  // all components
-	#if defined(_OPENMP)
-	#pragma omp atomic
-	#endif
-	_nNumMoleculesFieldYRLocal[ _nOffsetFieldYR[0][0][cid][nPosIndexR] + nPosIndexY ] ++;  // specific component
-
-	if(dPosRelativeX >= 0.)
-	{
-		#if defined(_OPENMP)
-		#pragma omp atomic
-		#endif
-		_nNumMoleculesFieldYRLocal[ _nOffsetFieldYR[0][1][0  ][nPosIndexR] + nPosIndexY ] ++;  // all components
-		#if defined(_OPENMP)
-		#pragma omp atomic
-		#endif
-		_nNumMoleculesFieldYRLocal[ _nOffsetFieldYR[0][1][cid][nPosIndexR] + nPosIndexY ] ++;  // specific component
-	}
-	else
-	{
-		#if defined(_OPENMP)
-		#pragma omp atomic
-		#endif
-		_nNumMoleculesFieldYRLocal[ _nOffsetFieldYR[0][2][0  ][nPosIndexR] + nPosIndexY ] ++;  // all components
-		#if defined(_OPENMP)
-		#pragma omp atomic
-		#endif
-		_nNumMoleculesFieldYRLocal[ _nOffsetFieldYR[0][2][cid][nPosIndexR] + nPosIndexY ] ++;  // specific component
-	}
+	nNumMolecules[ _nOffsetFieldYR[0][0][0  ][nPosIndexR] + nPosIndexY ] ++;  // all components
+	nNumMolecules[ _nOffsetFieldYR[0][0][cid][nPosIndexR] + nPosIndexY ] ++;  // specific component
+
+	// upper (x >= 0) or lower section
+	uint8_t sec = (dPosRelativeX >= 0.) ? 1 : 2;
+	nNumMolecules[ _nOffsetFieldYR[0][sec][0  ][nPosIndexR] + nPosIndexY ] ++;  // all components
+	nNumMolecules[ _nOffsetFieldYR[0][sec][cid][nPosIndexR] + nPosIndexY ] ++;  // specific component
 }
 
 void SampleRegion::calcGlobalValuesProfiles(DomainDecompBase* domainDecomp, Domain* domain)
@@ -1524,6 +1452,7 @@ void SampleRegion::writeDataProfiles(DomainDecompBase* domainDecomp, unsigned lo
 		return;
 
 	// calc global values
+	this->reduceThreadValuesProfiles();
 	this->calcGlobalValuesProfiles(domainDecomp, domain);
 
 	// reset local values
@@ -1687,6 +1616,7 @@ void SampleRegion::writeDataVDF(DomainDecompBase* domainDecomp, unsigned long si
 		return;
 
 	// calc global values
+	this->reduceThreadValuesVDF();
 	this->calcGlobalValuesVDF();  // calculate global velocity distribution sums
 
 	// reset local values
@@ -1812,6 +1742,7 @@ void SampleRegion::writeDataFieldYR(DomainDecompBase* domainDecomp, unsigned lon
 		return;
 
 	// calc global values
+	this->reduceThreadValuesFieldYR();
 	this->calcGlobalValuesFieldYR(domainDecomp, domain);
 
 	// reset local values
@@ -1891,6 +1822,14 @@ void SampleRegion::resetLocalValuesVDF()
 	std::fill(_VDF_njy_nvx_local.begin(), _VDF_njy_nvx_local.end(), 0);
 	std::fill(_VDF_njy_nvy_local.begin(), _VDF_njy_nvy_local.end(), 0);
 	std::fill(_VDF_njy_nvz_local.begin(), _VDF_njy_nvz_local.end(), 0);
+
+	for(auto&& tv : _threadValuesVDF) {
+		std::fill(tv.VDF_pjy_abs.begin(), tv.VDF_pjy_abs.end(), 0);
+		std::fill(tv.VDF_njy_abs.begin(), tv.VDF_njy_abs.end(), 0);
+		for(auto&& vd : tv.VDF_xvd)
+			for(auto&& v : vd)
+				std::fill(v.begin(), v.end(), 0);
+	}
 }
 
 
@@ -1908,6 +1847,15 @@ void SampleRegion::resetLocalValuesProfiles()
 	std::fill(_dVelocityLocal.begin(), _dVelocityLocal.end(), 0.);
 	std::fill(_dSquaredVelocityLocal.begin(), _dSquaredVelocityLocal.end(), 0.);
 	std::fill(_dForceLocal.begin(), _dForceLocal.end(), 0.);
+
+	for(auto&& tv : _threadValuesProfiles) {
+		std::fill(tv.nNumMolecules.begin(), tv.nNumMolecules.end(), 0);
+		std::fill(tv.nRotDOF.begin(), tv.nRotDOF.end(), 0);
+		std::fill(tv.d2EkinRot.begin(), tv.d2EkinRot.end(), 0.);
+		std::fill(tv.dVelocity.begin(), tv.dVelocity.end(), 0.);
+		std::fill(tv.dSquaredVelocity.begin(), tv.dSquaredVelocity.end(), 0.);
+		std::fill(tv.dForce.begin(), tv.dForce.end(), 0.);
+	}
 }
 
 void SampleRegion::resetOutputDataProfiles()
@@ -1931,6 +1879,111 @@ void SampleRegion::resetLocalValuesFieldYR()
 
 	// Scalar quantities
 	std::fill(_nNumMoleculesFieldYRLocal.begin(), _nNumMoleculesFieldYRLocal.end(), 0);
+
+	for(auto&& tv : _nNumMoleculesFieldYRThread)
+		std::fill(tv.begin(), tv.end(), 0);
+}
+
+void SampleRegion::reduceThreadValuesProfiles()
+{
+	if(not _SamplingEnabledProfiles)
+		return;
+
+	for(auto&& tv : _threadValuesProfiles) {
+		// Scalar quantities
+		for(unsigned long i = 0; i < _nNumValsScalar; ++i) {
+			_nNumMoleculesLocal[i] += tv.nNumMolecules[i];
+			_nRotDOFLocal[i]       += tv.nRotDOF[i];
+			_d2EkinRotLocal[i]     += tv.d2EkinRot[i];
+		}
+		// Vector quantities
+		for(unsigned long i = 0; i < _nNumValsVector; ++i) {
+			_dVelocityLocal[i]        += tv.dVelocity[i];
+			_dSquaredVelocityLocal[i] += tv.dSquaredVelocity[i];
+			_dForceLocal[i]           += tv.dForce[i];
+		}
+	}
+}
+
+void SampleRegion::reduceThreadValuesVDF()
+{
+	if(not _SamplingEnabledVDF)
+		return;
+
+	for(auto&& tv : _threadValuesVDF) {
+		for(uint32_t vi = 0; vi < _numValsVDF; ++vi) {
+			_VDF_pjy_abs_local[vi] += tv.VDF_pjy_abs[vi];
+			_VDF_njy_abs_local[vi] += tv.VDF_njy_abs[vi];
+		}
+		for(unsigned int d=0; d < 3; ++d) {
+			for(unsigned int i=0; i < 4; ++i) {
+				uint64_t* dataPtr = _dataPtrs.at(d).at(i);
+				if(nullptr == dataPtr)
+					continue;
+				const std::vector<uint64_t>& threadData = tv.VDF_xvd.at(d).at(i);
+				for(uint32_t vi = 0; vi < _numValsVDF; ++vi)
+					dataPtr[vi] += threadData[vi];
+			}
+		}
+	}
+}
+
+void SampleRegion::reduceThreadValuesFieldYR()
+{
+	if(not _SamplingEnabledFieldYR)
+		return;
+
+	for(auto&& tv : _nNumMoleculesFieldYRThread)
+		for(uint64_t i = 0; i < _nNumValsFieldYR; ++i)
+			_nNumMoleculesFieldYRLocal[i] += tv[i];
+}
+
+size_t SampleRegion::getThreadCopyBytes() const
+{
+	size_t numBytes = 0;
+	if(not _threadValuesProfiles.empty()) {
+		const ThreadValuesProfiles& tv = _threadValuesProfiles.front();
+		numBytes += (tv.nNumMolecules.size() + tv.nRotDOF.size()) * sizeof(unsigned long);
+		numBytes += (tv.d2EkinRot.size() + tv.dVelocity.size() + tv.dSquaredVelocity.size() + tv.dForce.size()) * sizeof(double);
+	}
+	if(not _threadValuesVDF.empty()) {
+		const ThreadValuesVDF& tv = _threadValuesVDF.front();
+		numBytes += (tv.VDF_pjy_abs.size() + tv.VDF_njy_abs.size()) * sizeof(uint64_t);
+		for(auto&& vd : tv.VDF_xvd)
+			for(auto&& v : vd)
+				numBytes += v.size() * sizeof(uint64_t);
+	}
+	if(not _nNumMoleculesFieldYRThread.empty())
+		numBytes += _nNumMoleculesFieldYRThread.front().size() * sizeof(uint64_t);
+	return numBytes;
+}
+
+void SampleRegion::limitThreadCopies(double memoryLimitMB)
+{
+	const int numThreads = mardyn_get_max_threads();
+	const double copyMB = this->getThreadCopyBytes() / (1024. * 1024.);
+	_numThreadCopies = numThreads;
+	if(copyMB > 0. && numThreads * copyMB > memoryLimitMB) {
+		_numThreadCopies = std::max(1, static_cast<int>(memoryLimitMB / copyMB) );
+		global_log->warning() << "RegionSampling->region["<<this->GetID()-1<<"]: " << numThreads << " thread-private copies of "
+				<< copyMB << " MB exceed the memory limit, " << _numThreadCopies << " copies are shared by the threads" << endl;
+	}
+	global_log->info() << "RegionSampling->region["<<this->GetID()-1<<"]: " << _numThreadCopies << " thread-private copies use "
+			<< _numThreadCopies * copyMB << " MB" << endl;
+
+	// drop the surplus copies, they are still empty
+	if(_threadValuesProfiles.size() > (size_t)_numThreadCopies)
+		_threadValuesProfiles.resize(_numThreadCopies);
+	if(_threadValuesVDF.size() > (size_t)_numThreadCopies)
+		_threadValuesVDF.resize(_numThreadCopies);
+	if(_nNumMoleculesFieldYRThread.size() > (size_t)_numThreadCopies)
+		_nNumMoleculesFieldYRThread.resize(_numThreadCopies);
+
+	for(auto&& lock : _threadCopyLocks)
+		mardyn_destroy_lock(&lock);
+	_threadCopyLocks.resize(_numThreadCopies < numThreads ? _numThreadCopies : 0);
+	for(auto&& lock : _threadCopyLocks)
+		mardyn_init_lock(&lock);
 }
 
 void SampleRegion::updateSlabParameters()
@@ -1981,6 +2034,7 @@ DistControl* SampleRegion::getDistControl()
 
 RegionSampling::RegionSampling()
 //: ControlInstance()
+	: _threadMemoryLimit(256.)
 {
 }
 
@@ -2005,6 +2059,8 @@ void RegionSampling::readXML(XMLfileUnits& xmlconfig)
 		global_log->warning() << "RegionSampling: No region parameters specified. Program exit ..." << endl;
 		Simulation::exit(-1);
 	}
+	xmlconfig.getNodeValue("threadmemorylimit", _threadMemoryLimit);
+	global_log->info() << "RegionSampling: Memory limit of the thread-private bins per region: " << _threadMemoryLimit << " MB" << endl;
 	string oldpath = xmlconfig.getcurrentnodepath();
 	XMLfile::Query::const_iterator outputRegionIter;
 	for( outputRegionIter = query.begin(); outputRegionIter; outputRegionIter++ )
@@ -2045,20 +2101,25 @@ void RegionSampling::init(ParticleContainer * /*particleContainer */,
 		(*it)->initSamplingProfiles(RS_DIMENSION_Y);
 		(*it)->initSamplingVDF(RS_DIMENSION_Y);
 		(*it)->initSamplingFieldYR(RS_DIMENSION_Y);
+		(*it)->limitThreadCopies(_threadMemoryLimit);
 	}
 }
 
-void RegionSampling::endStep(ParticleContainer *particleContainer,
+bool RegionSampling::beginMoleculeVisit(MoleculeVisitHook hook, unsigned long /*simstep*/)
+{
+	return hook == MoleculeVisitHook::END_STEP;
+}
+
+void RegionSampling::visitMolecule(MoleculeVisitHook /*hook*/, Molecule& molecule, int threadNum)
+{
+	this->doSampling(&molecule, threadNum);
+}
+
+void RegionSampling::endStep(ParticleContainer * /*particleContainer*/,
 		DomainDecompBase *domainDecomp, Domain * /*domain */,
 		unsigned long simstep) {
 
-	#if defined(_OPENMP)
-	#pragma omp parallel
-	#endif
-	for (auto pit = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); pit.isValid(); ++pit )
-		this->doSampling(&(*pit), domainDecomp, simstep);
-
-	// write data
+	// molecules have already been sampled by visitMolecule(), the thread-private bins are reduced when writing
 	this->writeData(domainDecomp, simstep);
 }
 
@@ -2067,16 +2128,21 @@ void RegionSampling::addRegion(SampleRegion* region)
 	_vecSampleRegions.push_back(region);
 }
 
-void RegionSampling::doSampling(Molecule* mol, DomainDecompBase* domainDecomp, unsigned long simstep)
+void RegionSampling::doSampling(Molecule* mol, int threadNum)
 {
 	// sample profiles and vdf
 	std::vector<SampleRegion*>::iterator it;
 
 	for(it=_vecSampleRegions.begin(); it!=_vecSampleRegions.end(); ++it)
 	{
-		(*it)->sampleProfiles(mol, RS_DIMENSION_Y);
-		(*it)->sampleVDF(mol, RS_DIMENSION_Y);
-		(*it)->sampleFieldYR(mol);
+		mardyn_lock_t* lock = (*it)->getThreadCopyLock(threadNum);
+		if(nullptr != lock)
+			mardyn_set_lock(lock);
+		(*it)->sampleProfiles(mol, RS_DIMENSION_Y, threadNum);
+		(*it)->sampleVDF(mol, RS_DIMENSION_Y, threadNum);
+		(*it)->sampleFieldYR(mol, threadNum);
+		if(nullptr != lock)
+			mardyn_unset_lock(lock);
 	}
 }
 
@@ -12,6 +12,7 @@
 #include "utils/Region.h"
 #include "molecules/MoleculeForwardDeclaration.h"
 #include "plugins/PluginBase.h"
+#include "WrapOpenMP.h"
 
 #include <vector>
 #include <array>
@@ -50,6 +51,8 @@ class RegionSampling;
 
 class SampleRegion : public CuboidRegionObs
 {
+	friend class RegionSamplingTest;
+
 public:
 	SampleRegion(RegionSampling* parent, double dLowerCorner[3], double dUpperCorner[3] );
 	virtual ~SampleRegion();
@@ -89,10 +92,19 @@ public:
 	void doDiscretisationVDF(int nDimension);
 	void doDiscretisationFieldYR(int nDimension);
 
-	// molecule container loop methods
-	void sampleProfiles(Molecule* molecule, int nDimension);
-	void sampleVDF(Molecule* molecule, int nDimension);
-	void sampleFieldYR(Molecule* molecule);
+	/** Bound the memory of the thread-private bins of all sampling modules: if one copy per thread exceeds
+	 * memoryLimitMB, fewer copies are kept and shared round-robin by the threads (see getThreadCopyLock()). */
+	void limitThreadCopies(double memoryLimitMB);
+	//! lock of the copy of thread threadNum, nullptr if every thread has its own copy
+	mardyn_lock_t* getThreadCopyLock(int threadNum) {
+		return _threadCopyLocks.empty() ? nullptr : &_threadCopyLocks[threadNum % _numThreadCopies];
+	}
+
+	// molecule container loop methods, thread-safe: each thread samples into its own bins,
+	// shared bins have to be locked by the caller, see getThreadCopyLock()
+	void sampleProfiles(Molecule* molecule, int nDimension, int threadNum);
+	void sampleVDF(Molecule* molecule, int nDimension, int threadNum);
+	void sampleFieldYR(Molecule* molecule, int threadNum);
 
 	// calc global values
 	void calcGlobalValuesProfiles(DomainDecompBase* domainDecomp, Domain* domain);
@@ -113,15 +125,19 @@ private:
 	void resetLocalValuesVDF();
 	void resetLocalValuesFieldYR();
 
+	// sum up the thread-private bins into the local data structures
+	void reduceThreadValuesProfiles();
+	void reduceThreadValuesVDF();
+	void reduceThreadValuesFieldYR();
+
+	//! memory of one copy of the thread-private bins of all sampling modules in bytes
+	size_t getThreadCopyBytes() const;
+
 	void initComponentSpecificParamsVDF();
 	void showComponentSpecificParamsVDF();
 
-	static void get_v(double* q, Molecule* mol);
-	static void get_F(double* q, Molecule* mol);
-	static void get_v2(double& q, Molecule* mol);
-	static void get_F2(double& q, Molecule* mol);
-	void(*_fptr)(double*, Molecule*);
-	void(*_f2ptr)(double&, Molecule*);
+	//! sample force (FDF) instead of velocity (VDF) distribution
+	bool _bSampleForcesVDF;
 
 	// observer mechanism: update region coords dependent on the interface position, determined by plugin DistControl
 	DistControl* getDistControl();
@@ -209,6 +225,17 @@ private:
 	std::vector<double> _d2EkinDriftComp;
 	std::vector<double> _dTemperatureComp;
 
+	//! thread-private sampling bins, same layout as the local data structures
+	struct ThreadValuesProfiles {
+		std::vector<unsigned long> nNumMolecules;
+		std::vector<unsigned long> nRotDOF;
+		std::vector<double> d2EkinRot;
+		std::vector<double> dVelocity;
+		std::vector<double> dSquaredVelocity;
+		std::vector<double> dForce;
+	};
+	std::vector<ThreadValuesProfiles> _threadValuesProfiles;
+
 	// --- VDF ---
 
 	// parameters
@@ -264,6 +291,15 @@ private:
 	std::vector<uint64_t> _VDF_njy_nvz_global;
 
 	std::array<std::array<uint64_t*,4>,3> _dataPtrs;
+
+	//! thread-private sampling bins; VDF_xvd is indexed like _dataPtrs, VDF_xvd[1][1] and VDF_xvd[1][2] stay empty
+	struct ThreadValuesVDF {
+		std::vector<uint64_t> VDF_pjy_abs;
+		std::vector<uint64_t> VDF_njy_abs;
+		std::array<std::array<std::vector<uint64_t>,4>,3> VDF_xvd;
+	};
+	std::vector<ThreadValuesVDF> _threadValuesVDF;
+	bool _bSampleComponentSumVDF;
 	std::string _fnamePrefixVDF;
 
 	// --- fieldYR ---
@@ -302,6 +338,7 @@ private:
 	// [component][section][positionR][positionY]
 	std::vector<uint64_t> _nNumMoleculesFieldYRLocal;
 	std::vector<uint64_t> _nNumMoleculesFieldYRGlobal;
+	std::vector<std::vector<uint64_t>> _nNumMoleculesFieldYRThread;  // [thread][component][section][positionR][positionY]
 
 	// output profiles
 	std::vector<double> _dDensityFieldYR;
@@ -311,11 +348,17 @@ private:
 	uint8_t _nFileTypeFieldYR;
 	
 	bool _boolSingleComp;
+
+	// thread-private bins
+	int _numThreadCopies;  // thread t samples into copy t % _numThreadCopies
+	std::vector<mardyn_lock_t> _threadCopyLocks;  // one lock per copy, only if the copies are shared
 };
 
 class XMLfileUnits;
 class RegionSampling : public ControlInstance, public PluginBase
 {
+	friend class RegionSamplingTest;
+
 public:
 	RegionSampling();
 	virtual ~RegionSampling();
@@ -327,6 +370,7 @@ public:
 	 * The following XML object structure is handled by this method:
 	 * \code{.xml}
 	<plugin name="RegionSampling">
+		<threadmemorylimit>FLOAT</threadmemorylimit>   <!-- memory in MB the thread-private bins of one region may use together, default: 256 -->
 		<region>
 			<coords>   <!-- lc and uc: lower and upper corner of cuboid sampling region -->
 				<lcx>FLOAT</lcx> <lcy refcoordsID="0">FLOAT</lcy> <lcz>FLOAT</lcz>
@@ -404,6 +448,14 @@ public:
 			DomainDecompBase *domainDecomp, Domain *domain,
 			unsigned long simstep) override;
 
+	//! the molecules are sampled in the common pass of the simulation at the end of each step
+	bool beginMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) override;
+
+	void visitMolecule(MoleculeVisitHook hook, Molecule& molecule, int threadNum) override;
+
+	//! only writes output, never changes the molecules
+	bool modifiesMoleculesAt(MoleculeVisitHook /*hook*/) override { return false; }
+
 	void finish(ParticleContainer *particleContainer,
 				DomainDecompBase *domainDecomp, Domain *domain) override {}
 
@@ -416,7 +468,7 @@ protected:
 	SampleRegion* getSampleRegion(unsigned short nRegionID) {return _vecSampleRegions.at(nRegionID-1); }  // vector index starts with 0, region index with 1
 
 	// sample profiles and vdf
-	void doSampling(Molecule* mol, DomainDecompBase* domainDecomp, unsigned long simstep);
+	void doSampling(Molecule* mol, int threadNum);
 	// write out profiles and vdf
 	void writeData(DomainDecompBase* domainDecomp, unsigned long simstep);
 	void prepareRegionSubdivisions();  // need to be called before allocating the data structures
@@ -428,6 +480,9 @@ private:
 	unsigned long _writeFrequencyProfiles;
 	unsigned long _initSamplingVDF;
 	unsigned long _writeFrequencyVDF;
+
+	// each thread samples into private bins, which multiplies their memory by the number of threads; bounded by this limit in MB
+	double _threadMemoryLimit;
 };
 
 #endif /* REGIONSAMPLING_H_ */
@@ -9,6 +9,7 @@
  // Important: Always plot the running average data to make sure convergence has been achieved. Permittivity may take a long time to converge, i.e. a few million steps with ~1000 particles. Reducing number of slabs for the thermostat can drastically improve results/convergence!
  // If a simulation is resumed from a restart file, then the existing running average file is ammended but the computation of the running averages starts anew at the time step of the restart file
 #include "Permittivity.h"
+#include "WrapOpenMP.h"
 void Permittivity::readXML(XMLfileUnits& xmlconfig) {
 	global_log->info() << "Calculation of relative permittivity enabled." << std::endl;
 	xmlconfig.getNodeValue("writefrequency", _writeFrequency);
@@ -76,30 +77,51 @@ void Permittivity::init(ParticleContainer* particleContainer, DomainDecompBase*
 		}
 	}
 }
-void Permittivity::record(ParticleContainer* particleContainer) {
+bool Permittivity::beginMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) {
+	// nothing is recorded in the first call of endStep, see there
+	if (hook != MoleculeVisitHook::END_STEP or not _readStartingStep or simstep <= _initStatistics
+		or simstep % _recordingTimesteps != 0) {
+		return false;
+	}
+	_threadRecords.assign(mardyn_get_max_threads(), ThreadRecord{{0., 0., 0.}, 0});
+	_myAbsByComponent.assign(_numComponents, 0.);
+	for (const auto& [component, myAbs] : _myAbs) {
+		_myAbsByComponent[component] = myAbs;
+	}
+	return true;
+}
+
+void Permittivity::visitMolecule(MoleculeVisitHook /*hook*/, Molecule& molecule, int threadNum) {
 	
 	double Quaternion[4];
 	double orientationVector[3];
 	
-	for(ParticleIterator tempMol = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); tempMol.isValid(); ++tempMol){
-		
-		Quaternion[0] = tempMol->q().qw();
-		Quaternion[1] = tempMol->q().qx();
-		Quaternion[2] = tempMol->q().qy();
-		Quaternion[3] = tempMol->q().qz();
-		
-		// Calculates dipole moment vector from quaternions
-		orientationVector[0] = 2 * (Quaternion[1] * Quaternion[3] + Quaternion[0] * Quaternion[2]);
-		orientationVector[1] = 2 * (Quaternion[2] * Quaternion[3] - Quaternion[0] * Quaternion[1]);
-		orientationVector[2] = 1 - 2 * (Quaternion[1] * Quaternion[1] + Quaternion[2] * Quaternion[2]);
-		
-		_numParticlesLocal++;	
+	Quaternion[0] = molecule.q().qw();
+	Quaternion[1] = molecule.q().qx();
+	Quaternion[2] = molecule.q().qy();
+	Quaternion[3] = molecule.q().qz();
+	
+	// Calculates dipole moment vector from quaternions
+	orientationVector[0] = 2 * (Quaternion[1] * Quaternion[3] + Quaternion[0] * Quaternion[2]);
+	orientationVector[1] = 2 * (Quaternion[2] * Quaternion[3] - Quaternion[0] * Quaternion[1]);
+	orientationVector[2] = 1 - 2 * (Quaternion[1] * Quaternion[1] + Quaternion[2] * Quaternion[2]);
+	
+	ThreadRecord& threadRecord = _threadRecords[threadNum];
+	threadRecord.numParticles++;
 
+	for (unsigned int i = 0; i < 3; i++) {
+		// Calculates M as sum of all molecular dipole moment vectors for current time step
+		threadRecord.M[i] += orientationVector[i] * _myAbsByComponent[molecule.componentid()];
+	}
+}
+
+void Permittivity::endMoleculeVisit(MoleculeVisitHook /*hook*/, unsigned long /*simstep*/) {
+	for (const auto& threadRecord : _threadRecords) {
+		_numParticlesLocal += threadRecord.numParticles;
 		for (unsigned int i = 0; i < 3; i++) {
-			// Calculates M as sum of all molecular dipole moment vectors for current time step
-			_localM[_accumulatedSteps][i] += orientationVector[i] * _myAbs[tempMol->getComponentLookUpID()];	
+			_localM[_accumulatedSteps][i] += threadRecord.M[i];
 		}
-	}		
+	}
 }
 
 void Permittivity::writeRunningAverage(unsigned long indexM, double tempMX, double tempMY, double tempMZ, double tempMSquared) { // writes instantaneous values, temporary averages and running averages of Mx, My, Mz, <M2> and epsilon
@@ -220,7 +242,7 @@ void Permittivity::endStep(ParticleContainer* particleContainer, DomainDecompBas
 	}
 
 	if (simstep > _initStatistics && simstep % _recordingTimesteps == 0) {
-		record(particleContainer);
+		// the molecules were recorded in visitMolecule()
 		_accumulatedSteps++;
 	}
 	
@@ -16,12 +16,18 @@
 #include "particleContainer/ParticleContainer.h"
 #include "plugins/PluginBase.h"
 
+#include <vector>
+
 class Permittivity: public PluginBase {
 public:
 
 	void init(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain) override;
 	void readXML(XMLfileUnits& xmlconfig) override;
-	void record(ParticleContainer* particleContainer);
+	// the dipole moments are recorded in the common pass of the simulation at the end of the recording steps
+	bool beginMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) override;
+	void visitMolecule(MoleculeVisitHook hook, Molecule& molecule, int threadNum) override;
+	void endMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) override;
+	bool modifiesMoleculesAt(MoleculeVisitHook /*hook*/) override { return false; }
 	void endStep(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain,
 				 unsigned long simstep) override;
 	void reset();
@@ -64,6 +70,13 @@ private:
 	double _T; // Target temperature
 	std::ofstream _ravStream;
 	std::string _outputPrefix;
+	// partial sums of one thread during the recording, padded to a cache line to avoid false sharing
+	struct alignas(64) ThreadRecord {
+		double M[3];
+		unsigned long numParticles;
+	};
+	std::vector<ThreadRecord> _threadRecords;
+	std::vector<double> _myAbsByComponent; // Dipole moment of component, 0 for components without dipole
 };
 
 #endif /*SRC_PLUGINS_PERMITTIVITY_H_*/
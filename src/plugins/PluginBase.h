@@ -8,6 +8,7 @@
 #include <functional>
 
 #include "utils/FunctionWrapper.h"
+#include "molecules/MoleculeForwardDeclaration.h"
 
 class ParticleContainer;
 class DomainDecompBase;
@@ -43,9 +44,20 @@ class XMLfileUnits;
  * \code{.cpp}
  *   static PluginBase* createInstance() { return new MyPlugin(); }   // class name is MyPlugin
  * \endcode
+ *
+ * Plugins, which only need to look at each molecule once at one of the hook points, should not iterate over the
+ * particle container themselves, but implement beginMoleculeVisit() and visitMolecule(). The Simulation then visits
+ * the molecules for such a plugin in an OpenMP parallel pass right before its hook method (beforeEventNewTimestep,
+ * beforeForces, afterForces, endStep) is called. Consecutive visiting plugins share one pass, as long as the hook
+ * methods in between do not change the molecules (see modifiesMoleculesAt()).
  */
 class PluginBase {
 public:
+	//! hook points, at which the molecules are visited for the plugins
+	enum class MoleculeVisitHook {
+		BEFORE_EVENT_NEW_TIMESTEP, BEFORE_FORCES, AFTER_FORCES, END_STEP
+	};
+
     //! @brief Subclasses should use their constructur to pass parameters (e.g. filenames)
     PluginBase(){}
 
@@ -183,6 +195,48 @@ public:
 	virtual void accessAllCallbacks(const std::map<std::string, FunctionWrapper>& callbackMap) {
 		// Empty by default.
 	}
+
+	/**
+	 * Called serially for all plugins before the first hook method at the given hook point is called.
+	 * Can be used to prepare the thread-local state used in visitMolecule().
+	 * @return true, if visitMolecule() shall be called for all local molecules right before the hook method of this
+	 *         plugin at this hook point
+	 */
+	virtual bool beginMoleculeVisit(MoleculeVisitHook /* hook */, unsigned long /* simstep */) {
+		return false;
+	}
+
+	/**
+	 * Called for every molecule inside the local domain (no halo molecules), if beginMoleculeVisit() returned true.
+	 * The calls are distributed over the OpenMP threads, thus the plugin may only modify the given molecule and state
+	 * belonging to the calling thread. The molecule must not be deleted.
+	 * @param threadNum number of the calling thread, smaller than mardyn_get_max_threads()
+	 */
+	virtual void visitMolecule(MoleculeVisitHook /* hook */, Molecule& /* molecule */, int /* threadNum */) {}
+
+	/**
+	 * Called serially after the common pass over the molecules, e.g. to combine the thread-local state.
+	 * Only called, if beginMoleculeVisit() returned true.
+	 */
+	virtual void endMoleculeVisit(MoleculeVisitHook /* hook */, unsigned long /* simstep */) {}
+
+	/**
+	 * Tells whether the hook method of this plugin at the given hook point may move, insert or delete molecules or
+	 * change their velocities or forces. Only if not, the molecules are visited for the following plugins in the same
+	 * pass as for this one, before this hook method is called.
+	 */
+	virtual bool modifiesMoleculesAt(MoleculeVisitHook /* hook */) {
+		return true;
+	}
+
+	/**
+	 * Tells whether the molecule visit or the hook method of this plugin at the given hook point reads or changes the
+	 * velocities or angular momenta. Only if so, a velocity scaling which the integrator deferred to the next time step
+	 * is applied before the hook (see Leapfrog::deferVelocityScaling()).
+	 */
+	virtual bool accessesVelocitiesAt(MoleculeVisitHook /* hook */) {
+		return true;
+	}
 };
 
 #endif /* PLUGINBASE_H */
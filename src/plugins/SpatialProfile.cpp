@@ -3,6 +3,9 @@
 //
 
 #include "SpatialProfile.h"
+
+#include <algorithm>
+
 #include "plugins/profiles/ProfileBase.h"
 #include "plugins/profiles/DensityProfile.h"
 #include "plugins/profiles/Velocity3dProfile.h"
@@ -25,12 +28,15 @@ void SpatialProfile::readXML(XMLfileUnits& xmlconfig) {
 	global_log->info() << "[SpatialProfile] Write frequency: " << _writeFrequency << endl;
 	xmlconfig.getNodeValue("outputprefix", _outputPrefix);
 	global_log->info() << "[SpatialProfile] Output prefix: " << _outputPrefix << endl;
+	xmlconfig.getNodeValue("threadmemorylimit", _threadMemoryLimit);
+	global_log->info() << "[SpatialProfile] Memory limit of the thread-local copies: " << _threadMemoryLimit << " MB" << endl;
 	xmlconfig.getNodeValue("mode", _mode);
 	global_log->info() << "[SpatialProfile] Mode " << _mode << endl;
 	xmlconfig.getNodeValue("profiledComponent", _profiledCompString);
 	global_log->info() << "[SpatialProfile] Profiled Component:" << _profiledCompString << endl;
 	
-	if (_profiledCompString != "all") {
+	_allComponents = _profiledCompString == "all";
+	if (not _allComponents) {
 		_profiledComp = std::stoi(_profiledCompString);
 	}
 
@@ -212,12 +218,38 @@ void SpatialProfile::init(ParticleContainer* particleContainer, DomainDecompBase
 	samplInfo.universalCentre[2] = 0.5 * samplInfo.globalLength[2];
 
 	global_log->info() << "[SpatialProfile] profile init" << std::endl;
-	// Init profiles with sampling information and reset maps
-	for (unsigned long uID = 0; uID < _uIDs; uID++) {
-		for (unsigned i = 0; i < _profiles.size(); i++) {
-			_profiles[i]->init(samplInfo);
-			_profiles[i]->reset(uID);
-		}
+	// Init profiles with sampling information and their part of the flat storage
+	_numThreads = mardyn_get_max_threads();
+	const unsigned long threadStride = _uIDs * _comms;
+	const double copyMB = threadStride * sizeof(double) / (1024. * 1024.);
+	_numCopies = _numThreads;
+	if (copyMB > 0. and _numCopies * copyMB > _threadMemoryLimit) {
+		_numCopies = std::max(1, static_cast<int>(_threadMemoryLimit / copyMB));
+		global_log->warning() << "[SpatialProfile] " << _numThreads << " thread-local copies of " << copyMB
+							  << " MB exceed the memory limit, " << _numCopies << " copies are shared by the threads" << endl;
+	}
+	global_log->info() << "[SpatialProfile] " << _numCopies << " thread-local copies use " << _numCopies * copyMB
+					   << " MB" << endl;
+	_localValues.assign(_numCopies * threadStride, 0.0);
+	_globalValues.assign(threadStride, 0.0);
+	for (auto& lock : _copyLocks) {
+		mardyn_destroy_lock(&lock);
+	}
+	_copyLocks.resize(_numCopies < _numThreads ? _numCopies : 0);
+	for (auto& lock : _copyLocks) {
+		mardyn_init_lock(&lock);
+	}
+	unsigned long offset = 0;
+	for (unsigned i = 0; i < _profiles.size(); i++) {
+		_profiles[i]->init(samplInfo);
+		_profiles[i]->setStorage(_localValues.data() + offset, _globalValues.data() + offset, threadStride, _numCopies);
+		offset += _uIDs * _profiles[i]->comms();
+	}
+}
+
+SpatialProfile::~SpatialProfile() {
+	for (auto& lock : _copyLocks) {
+		mardyn_destroy_lock(&lock);
 	}
 }
 
@@ -234,50 +266,8 @@ void SpatialProfile::endStep(ParticleContainer* particleContainer, DomainDecompB
 							 unsigned long simstep) {
 	int mpi_rank = domainDecomp->getRank();
 
-	unsigned xun, yun, zun;
 	if ((simstep >= _initStatistics) && (simstep % _profileRecordingTimesteps == 0)) {
-		long uID;
-
-		// Loop over all particles and bin them with uIDs
-		for (auto thismol = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); thismol.isValid(); ++thismol) {
-			
-			if ((_profiledCompString != "all") && (thismol->componentid() == _profiledComp-1)) {
-				
-				// Get uID
-				if (samplInfo.cylinder) {
-					uID = getCylUID(thismol);
-					if (uID == -1) {
-						// Invalid uID -> Molecule not in cylinder -> continue
-						continue;
-					}
-				} else {
-					uID = getCartesianUID(thismol);
-				}
-				// pass mol + uID to all profiles
-				for (unsigned i = 0; i < _profiles.size(); i++) {
-					_profiles[i]->record(*thismol, (unsigned) uID);
-				}
-			}
-			
-			if (_profiledCompString == "all"){
-							
-				// Get uID
-				if (samplInfo.cylinder) {
-					uID = getCylUID(thismol);
-					if (uID == -1) {
-						// Invalid uID -> Molecule not in cylinder -> continue
-						continue;
-					}
-				} else {
-					uID = getCartesianUID(thismol);
-				}
-				// pass mol + uID to all profiles
-				for (unsigned i = 0; i < _profiles.size(); i++) {
-					_profiles[i]->record(*thismol, (unsigned) uID);
-				}
-			}
-		}
-
+		// the molecules were binned in visitMolecule(), every thread recorded into its own block of _localValues
 		// Record number of Timesteps recorded since last output write
 		_accumulatedDatasets++;
 	}
@@ -286,28 +276,7 @@ void SpatialProfile::endStep(ParticleContainer* particleContainer, DomainDecompB
 		// COLLECTIVE COMMUNICATION
 		global_log->info() << "[SpatialProfile] uIDs: " << _uIDs << " acc. Data: " << _accumulatedDatasets << "\n";
 
-		// Initialize Communication with number of bins * number of total comms needed per bin by all profiles.
-		domainDecomp->collCommInit(_comms * _uIDs);
-
-		// Append Communications
-		for (unsigned long uID = 0; uID < _uIDs; uID++) {
-			for (unsigned i = 0; i < _profiles.size(); i++) {
-				_profiles[i]->collectAppend(domainDecomp, uID);
-			}
-		}
-
-		// Reduction Communication to get global values
-		domainDecomp->collCommAllreduceSum();
-
-		// Write global values in all bins in all profiles
-		for (unsigned long uID = 0; uID < _uIDs; uID++) {
-			for (unsigned i = 0; i < _profiles.size(); i++) {
-				_profiles[i]->collectRetrieve(domainDecomp, uID);
-			}
-		}
-
-		// Finalize Communication
-		domainDecomp->collCommFinalize();
+		reduceValues(domainDecomp);
 
 		// Initialize Output from rank 0 process
 		if (mpi_rank == 0) {
@@ -318,15 +287,70 @@ void SpatialProfile::endStep(ParticleContainer* particleContainer, DomainDecompB
 		}
 
 		// Reset profile arrays for next recording frame.
-		for (unsigned long uID = 0; uID < _uIDs; uID++) {
-			for (unsigned i = 0; i < _profiles.size(); i++) {
-				_profiles[i]->reset(uID);
-			}
-		}
+		std::fill(_localValues.begin(), _localValues.end(), 0.0);
+		std::fill(_globalValues.begin(), _globalValues.end(), 0.0);
 		_accumulatedDatasets = 0;
 	}
 }
 
+void SpatialProfile::reduceValues(DomainDecompBase* domainDecomp) {
+	// Sum up the blocks of all copies into the block of copy 0
+	const unsigned long numValues = _uIDs * _comms;
+	double* const localValues = _localValues.data();
+	#if defined(_OPENMP)
+	#pragma omp parallel for simd
+	#endif
+	for (unsigned long i = 0; i < numValues; i++) {
+		double sum = localValues[i];
+		for (int t = 1; t < _numCopies; t++) {
+			sum += localValues[t * numValues + i];
+		}
+		localValues[i] = sum;
+	}
+
+	// Reduce the values of all bins of all profiles to the root process at once
+#ifdef ENABLE_MPI
+	MPI_CHECK(MPI_Reduce(localValues, _globalValues.data(), numValues, MPI_DOUBLE, MPI_SUM, 0,
+						 domainDecomp->getCommunicator()));
+#else
+	std::copy(localValues, localValues + numValues, _globalValues.begin());
+#endif
+}
+
+bool SpatialProfile::beginMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) {
+	return hook == MoleculeVisitHook::END_STEP and simstep >= _initStatistics
+		and simstep % _profileRecordingTimesteps == 0;
+}
+
+void SpatialProfile::visitMolecule(MoleculeVisitHook /*hook*/, Molecule& molecule, int /*threadNum*/) {
+	if (not _allComponents && (molecule.componentid() != _profiledComp - 1)) {
+		return;
+	}
+
+	// Get uID
+	long uID;
+	if (samplInfo.cylinder) {
+		uID = getCylUID(molecule);
+		if (uID == -1) {
+			// Invalid uID -> Molecule not in cylinder -> continue
+			return;
+		}
+	} else {
+		uID = getCartesianUID(molecule);
+	}
+	// pass mol + uID to all profiles, they record into the block of the calling thread
+	mardyn_lock_t* lock = _copyLocks.empty() ? nullptr : &_copyLocks[mardyn_get_thread_num() % _numCopies];
+	if (lock) {
+		mardyn_set_lock(lock);
+	}
+	for (unsigned i = 0; i < _profiles.size(); i++) {
+		_profiles[i]->record(molecule, (unsigned) uID);
+	}
+	if (lock) {
+		mardyn_unset_lock(lock);
+	}
+}
+
 /**
  * @brief getCartesianUID samples the domain cartesian coordinate bins.
  *
@@ -336,10 +360,10 @@ void SpatialProfile::endStep(ParticleContainer* particleContainer, DomainDecompB
  * @param thismol
  * @return
  */
-unsigned long SpatialProfile::getCartesianUID(ParticleIterator& thismol) {
-	auto xun = (unsigned) floor(thismol->r(0) * samplInfo.universalInvProfileUnit[0]);
-	auto yun = (unsigned) floor(thismol->r(1) * samplInfo.universalInvProfileUnit[1]);
-	auto zun = (unsigned) floor(thismol->r(2) * samplInfo.universalInvProfileUnit[2]);
+unsigned long SpatialProfile::getCartesianUID(const Molecule& thismol) {
+	auto xun = (unsigned) floor(thismol.r(0) * samplInfo.universalInvProfileUnit[0]);
+	auto yun = (unsigned) floor(thismol.r(1) * samplInfo.universalInvProfileUnit[1]);
+	auto zun = (unsigned) floor(thismol.r(2) * samplInfo.universalInvProfileUnit[2]);
 	auto uID = (unsigned long) (xun * samplInfo.universalProfileUnit[1] * samplInfo.universalProfileUnit[2]
 								+ yun * samplInfo.universalProfileUnit[2] + zun);
 	return uID;
@@ -361,7 +385,7 @@ unsigned long SpatialProfile::getCartesianUID(ParticleIterator& thismol) {
  * @param thismol
  * @return
  */
-long SpatialProfile::getCylUID(ParticleIterator& thismol) {
+long SpatialProfile::getCylUID(const Molecule& thismol) {
 
 	int phiUn, rUn, hUn;// (phiUn,rUn,yun): bin number in a special direction, e.g. rUn==5 corresponds to the 5th bin in the radial direction,
 	long unID;    // as usual
@@ -369,9 +393,9 @@ long SpatialProfile::getCylUID(ParticleIterator& thismol) {
 
 	unID = -1; // initialization, causes an error message, if unID is not calculated in this method but used in record profile
 
-	xc = thismol->r(0) - samplInfo.universalCentre[0];
-	yc = thismol->r(1) - samplInfo.universalCentre[1];
-	zc = thismol->r(2) - samplInfo.universalCentre[2];
+	xc = thismol.r(0) - samplInfo.universalCentre[0];
+	yc = thismol.r(1) - samplInfo.universalCentre[1];
+	zc = thismol.r(2) - samplInfo.universalCentre[2];
 
 	// transformation in polar coordinates
 	double R2 = xc * xc + zc * zc;
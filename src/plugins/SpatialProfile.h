@@ -37,6 +37,11 @@ class Virial2DProfile;
 
 /** @brief SpatialProfile is a Plugin that is called like any other plugin derived from PluginBase. It handles all profiles in /plugins/profiles. <br>
  * New profiles must be added via the plugins/ ProfileBase to comply with this Plugin. <br>
+ * The values of all profiles are kept in one flat array. Molecules are binned in parallel with thread-local copies of
+ * the array, which are summed up and reduced to the root process with a single MPI_Reduce when the output is written.
+ * The copies multiply the memory of the profiles by the number of threads. Their number is therefore bounded by
+ * <b>threadmemorylimit</b>, the memory in MB all copies may use together (default 256). If the limit is
+ * exceeded, threads share copies and serialize the recording via a lock per copy. At least one copy is always kept. <br>
  *
  *
  * <b>x y z</b>: Set Sampling Grid for all profiles. Output currently only readable for <b>x = 1</b>. <br>
@@ -60,6 +65,7 @@ class Virial2DProfile;
         <recording>1</recording>
       </timesteps>
       <outputprefix>comparison</outputprefix>
+      <threadmemorylimit>256</threadmemorylimit>
       <profiles>
         <density>1</density>
         <temperature>0</temperature>
@@ -72,8 +78,12 @@ class Virial2DProfile;
  */
 class SpatialProfile : public PluginBase {
 
+	friend class SpatialProfileTest;
+
 public:
 
+	~SpatialProfile() override;
+
 	void init(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain) override;
 
 	void readXML(XMLfileUnits& xmlconfig) override;
@@ -82,12 +92,20 @@ public:
 			ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
 			Domain* domain, unsigned long simstep) override;
 
+	//! the molecules are binned in the common pass of the simulation at the end of the sampling steps
+	bool beginMoleculeVisit(MoleculeVisitHook hook, unsigned long simstep) override;
+
+	void visitMolecule(MoleculeVisitHook hook, Molecule& molecule, int threadNum) override;
+
+	//! only writes output, never changes the molecules
+	bool modifiesMoleculesAt(MoleculeVisitHook /*hook*/) override { return false; }
+
 	void finish(ParticleContainer* particleContainer,
 				DomainDecompBase* domainDecomp, Domain* domain) override {};
 
-	unsigned long getCartesianUID(ParticleIterator& thismol);
+	unsigned long getCartesianUID(const Molecule& thismol);
 
-	long getCylUID(ParticleIterator& thismol);
+	long getCylUID(const Molecule& thismol);
 
 	std::string getPluginName() override { return std::string("SpatialProfile"); }
 
@@ -123,6 +141,7 @@ private:
 	std::string _mode;
 	std::string _profiledCompString;
 	unsigned int _profiledComp;
+	bool _allComponents = true;
 
 
 	unsigned long _uIDs; //!< Total number of unique IDs with the selected Grid. This is the number of total bins in the Sampling grid.
@@ -130,6 +149,15 @@ private:
 	std::vector<ProfileBase*> _profiles; // vector holding all enabled profiles
 	int _comms = 0; // total number of communications per bin needed by all profiles.
 
+	/** Flat storage of the local values of all profiles. Each thread has its own block of _uIDs * _comms values, in
+	 * which the values of the profiles are stored one after another (_uIDs * comms() values per profile). */
+	std::vector<double> _localValues;
+	std::vector<double> _globalValues; //!< reduced values of all profiles (only on root), same layout as one thread block
+	int _numThreads = 1;
+	int _numCopies = 1; //!< number of thread-local copies in _localValues, thread t uses copy t % _numCopies
+	double _threadMemoryLimit = 256.; //!< memory limit for all thread-local copies in MB
+	std::vector<mardyn_lock_t> _copyLocks; //!< one lock per copy, only used if threads share copies
+
 	// Needed for XML check for enabled profiles.
 	bool _ALL = false;
 	bool _DENSITY = false;
@@ -141,6 +169,9 @@ private:
 
 	void addProfile(ProfileBase* profile);
 
+	//! sum up the thread-local copies and reduce them to the global values on the root process
+	void reduceValues(DomainDecompBase* domainDecomp);
+
 	std::optional<std::function<unsigned long(void)>> getNumFixRegion;
 
 };
@@ -15,15 +15,18 @@
 #include "particleContainer/ParticleCell.h"
 #include "particleContainer/adapter/CellDataSoA.h"
 #include "Domain.h"
+#include "integrators/Integrator.h"
 #include "parallel/DomainDecompBase.h"
 #include "molecules/Molecule.h"
 #include "utils/Logger.h"
+#include "utils/String_utils.h"
 #include <cstdlib>
 #include <ctime>
 #include <cmath>
 #include <iostream>
 #include <fstream>
 #include <cstdio>
+#include <random>
 
 void VectorizationTuner::readXML(XMLfileUnits& xmlconfig) {
 	std::string mode = "file";
@@ -67,6 +70,20 @@ void VectorizationTuner::readXML(XMLfileUnits& xmlconfig) {
 	}
 	global_log->info() << "Molecule count increase type: " << incTypeStr << std::endl;
 
+	std::string precisions;
+	if (xmlconfig.getNodeValue("precisions", precisions)) {
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+		for (const auto& precision : string_utils::split(precisions, ',')) {
+			_precisions.push_back(VectorizedCellProcessor::precisionFromString(string_utils::trim(precision)));
+		}
+		global_log->info() << "Precisions: " << precisions << std::endl;
+		xmlconfig.getNodeValue("driftSteps", _driftSteps);
+		global_log->info() << "Time steps of the energy drift measurement: " << _driftSteps << std::endl;
+#else
+		global_log->warning() << "Precisions can not be selected in the reduced memory mode, ignoring them." << std::endl;
+#endif
+	}
+
 }
 
 void VectorizationTuner::finish(ParticleContainer * /*particleContainer*/,
@@ -120,8 +137,31 @@ void VectorizationTuner::tune(std::vector<Component>& ComponentList) {
 
     vtWriter->initWrite(_outputPrefix, _cutoffRadius, _LJCutoffRadius, _cutoffRadiusBig, _LJCutoffRadiusBig);
 
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+    auto vcp = dynamic_cast<VectorizedCellProcessor*>(_cellProcessor);
+    if (vcp == nullptr and not _precisions.empty()) {
+    	global_log->warning() << "VT: precisions can only be compared for the VectorizedCellProcessor, ignoring them." << std::endl;
+    	_precisions.clear();
+    }
+    const auto restorePrecision = vcp != nullptr ? vcp->getPrecision() : VectorizedCellProcessor::Precision::NATIVE;
+    if (not _precisions.empty()) {
+    	compareAccuracy(ComponentList);
+    }
+#endif
+    // one pass with the current settings, if no precisions are given
+    const size_t numPasses = std::max<size_t>(_precisions.size(), 1);
+    for (size_t pass = 0; pass < numPasses; ++pass) {
+    	std::string precisionString;
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+    	if (not _precisions.empty()) {
+    		vcp->setPrecision(_precisions[pass]);
+    		precisionString = " (" + VectorizedCellProcessor::precisionToString(_precisions[pass]) + ")";
+    		global_log->info() << "VT: measuring precision " << VectorizedCellProcessor::precisionToString(_precisions[pass]) << std::endl;
+    	}
+#endif
+
     if(_moleculeCntIncreaseType==linear or _moleculeCntIncreaseType==both){
-    	vtWriter->writeHeader("Linearly");
+    	vtWriter->writeHeader("Linearly" + precisionString);
 
 		for (unsigned int i = _minMoleculeCnt;
 				i <= (_moleculeCntIncreaseType == linear ? _maxMoleculeCnt : std::min(32u, _maxMoleculeCnt)); i++) {
@@ -134,7 +174,7 @@ void VectorizationTuner::tune(std::vector<Component>& ComponentList) {
 		}
     }
     if(_moleculeCntIncreaseType==exponential or _moleculeCntIncreaseType==both){
-    	vtWriter->writeHeader("Exponentially");
+    	vtWriter->writeHeader("Exponentially" + precisionString);
 
     	for(unsigned int i = _minMoleculeCnt; i <= _maxMoleculeCnt; i*=2){
     		iterate(ComponentList, i, gflopsOwnBig, gflopsPairBig, gflopsOwnNormal, gflopsPairNormalFace, gflopsPairNormalEdge, gflopsPairNormalCorner, gflopsOwnZero, gflopsPairZero);
@@ -142,6 +182,12 @@ void VectorizationTuner::tune(std::vector<Component>& ComponentList) {
     							gflopsPairNormalCorner, gflopsOwnZero, gflopsPairZero);
     	}
     }
+    }
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+    if (not _precisions.empty()) {
+    	vcp->setPrecision(restorePrecision);
+    }
+#endif
 
     vtWriter->close();
 
@@ -153,6 +199,194 @@ void VectorizationTuner::tune(std::vector<Component>& ComponentList) {
 
 }
 
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+void VectorizationTuner::compareAccuracy(std::vector<Component>& ComponentList) {
+	auto& vcp = dynamic_cast<VectorizedCellProcessor&>(*_cellProcessor);
+	const auto restorePrecision = vcp.getPrecision();
+	const double restoreCutoff = _cellProcessor->getCutoffRadiusSquare();
+	const double restoreLJCutoff = _cellProcessor->getLJCutoffRadiusSquare();
+	_cellProcessor->setCutoffRadius(_cutoffRadius);
+	_cellProcessor->setLJCutoffRadius(_LJCutoffRadius);
+
+	int cellsPerDim[3] = { 4, 4, 4 };
+	double haloBoxMin[3] = {-1., -1., -1.};
+	double haloBoxMax[3] = {3., 3., 3.};
+	double boxMin[3] = {0., 0., 0.};
+	double boxMax[3] = {2., 2., 2.};
+	double cellLength[3] = {1., 1., 1.};
+	int haloWidthInNumCells[3] = {1, 1, 1};
+	ParticleCell::_cellBorderAndFlagManager.init(cellsPerDim, haloBoxMin, haloBoxMax, boxMin, boxMax, cellLength,
+												 haloWidthInNumCells);
+	ParticleCell firstCell;
+	ParticleCell secondCell;
+	firstCell.setCellIndex(21);
+	secondCell.setCellIndex(22);
+	firstCell.assignCellToBoundaryRegion();
+	secondCell.assignCellToBoundaryRegion();
+
+	double BoxMin[3] = {0., 0., 0.};
+	double BoxMax[3] = {1., 1., 1.};
+	double BoxMin2[3] = { 1., 0., 0. };
+	double BoxMax2[3] = { 2., 1., 1. };
+	firstCell.setBoxMin(BoxMin);
+	secondCell.setBoxMin(BoxMin2);
+	firstCell.setBoxMax(BoxMax);
+	secondCell.setBoxMax(BoxMax2);
+
+	// a mesh avoids the (arbitrarily) close pairs of random positions
+	initMeshOfMolecules(BoxMin, BoxMax, ComponentList[0], firstCell, secondCell);
+
+	// forces of all LJ centers of the first cell and the potential energy for one precision
+	auto calculate = [&](VectorizedCellProcessor::Precision precision, std::vector<double>& forces) {
+		vcp.setPrecision(precision);
+		firstCell.buildSoACaches();
+		secondCell.buildSoACaches();
+		vcp.initTraversal();
+		vcp.processCell(firstCell);
+		vcp.processCellPair(firstCell, secondCell);
+		vcp.endTraversal();
+
+		typedef ConcSites::SiteType SiteType;
+		typedef ConcSites::CoordinateType Coordinate;
+		typedef CellDataSoA::QuantityType QuantityType;
+		CellDataSoA& soa = firstCell.getCellDataSoA();
+		forces.clear();
+		for (auto coord : {Coordinate::X, Coordinate::Y, Coordinate::Z}) {
+			const vcp_real_accum* const f = soa.getBeginAccum(QuantityType::FORCE, SiteType::LJC, coord);
+			forces.insert(forces.end(), f, f + soa._ljc_num);
+		}
+		return _simulation.getDomain()->getLocalUpot();
+	};
+
+	std::vector<double> referenceForces, forces;
+	const double referenceUpot = calculate(VectorizedCellProcessor::Precision::DPDP, referenceForces);
+	double referenceNorm = 0.;
+	for (double f : referenceForces) {
+		referenceNorm += f * f;
+	}
+
+	for (auto precision : _precisions) {
+		const double upot = calculate(precision, forces);
+		double deviation = 0.;
+		for (size_t i = 0; i < forces.size(); ++i) {
+			deviation += (forces[i] - referenceForces[i]) * (forces[i] - referenceForces[i]);
+		}
+		global_log->info() << "VT: accuracy of precision " << VectorizedCellProcessor::precisionToString(precision)
+				<< " compared to DPDP: relative deviation of the potential energy "
+				<< std::abs(upot - referenceUpot) / std::abs(referenceUpot) << ", of the forces "
+				<< std::sqrt(deviation / referenceNorm) << std::endl;
+	}
+
+	clearMolecules(firstCell);
+	clearMolecules(secondCell);
+
+	if (_driftSteps > 0) {
+		double referenceMaxDeviation = 0.;
+		const double referenceDrift = measureEnergyDrift(ComponentList[0], VectorizedCellProcessor::Precision::DPDP,
+				referenceMaxDeviation);
+		global_log->info() << "VT: energy drift of DPDP over " << _driftSteps << " steps: relative change of the total energy "
+				<< referenceDrift << ", maximal relative deviation " << referenceMaxDeviation << std::endl;
+		for (auto precision : _precisions) {
+			double maxDeviation = 0.;
+			const double drift = measureEnergyDrift(ComponentList[0], precision, maxDeviation);
+			global_log->info() << "VT: energy drift of precision " << VectorizedCellProcessor::precisionToString(precision)
+					<< " over " << _driftSteps << " steps: relative change of the total energy " << drift
+					<< ", maximal relative deviation " << maxDeviation << std::endl;
+		}
+	}
+
+	vcp.setPrecision(restorePrecision);
+	_cellProcessor->setCutoffRadiusSquare(restoreCutoff);
+	_cellProcessor->setLJCutoffRadiusSquare(restoreLJCutoff);
+}
+
+double VectorizationTuner::measureEnergyDrift(Component& component, VectorizedCellProcessor::Precision precision,
+		double& maxDeviation) {
+	auto& vcp = dynamic_cast<VectorizedCellProcessor&>(*_cellProcessor);
+	vcp.setPrecision(precision);
+
+	// 3x3x3 molecules per cell at the distance of the LJ minimum, so that the run does not depend on the units
+	const double sigma = component.numLJcenters() > 0 ? component.ljcenter(0).sigma() : 1.;
+	const double spacing = std::pow(2., 1. / 6.) * sigma;
+	const int numPerDim = 3;
+	const double cellLength = numPerDim * spacing;
+
+	ParticleCell firstCell;
+	ParticleCell secondCell;
+	firstCell.setCellIndex(21);
+	secondCell.setCellIndex(22);
+	firstCell.assignCellToBoundaryRegion();
+	secondCell.assignCellToBoundaryRegion();
+	double boxMin1[3] = {0., 0., 0.};
+	double boxMax1[3] = {cellLength, cellLength, cellLength};
+	double boxMin2[3] = {cellLength, 0., 0.};
+	double boxMax2[3] = {2. * cellLength, cellLength, cellLength};
+	firstCell.setBoxMin(boxMin1);
+	firstCell.setBoxMax(boxMax1);
+	secondCell.setBoxMin(boxMin2);
+	secondCell.setBoxMax(boxMax2);
+
+	// deterministic displacements of up to 5% of sigma, so that every precision integrates the same system
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<double> displacement(-0.05 * sigma, 0.05 * sigma);
+	unsigned long id = 0;
+	for (ParticleCell* cell : {&firstCell, &secondCell}) {
+		for (int z = 0; z < numPerDim; ++z) {
+			for (int y = 0; y < numPerDim; ++y) {
+				for (int x = 0; x < numPerDim; ++x) {
+					const double pos[3] = {cell->getBoxMin(0) + (x + 0.5) * spacing + displacement(generator),
+							(y + 0.5) * spacing + displacement(generator), (z + 0.5) * spacing + displacement(generator)};
+					Molecule m(id++, &component, pos[0], pos[1], pos[2], 0., 0., 0., 1., 0., 0., 0., 0., 0., 0.);
+					cell->addParticle(m);
+				}
+			}
+		}
+	}
+
+	// forces, torques and potential energy of the current positions, the molecules keep them for the next step
+	auto calculateForces = [&]() {
+		firstCell.buildSoACaches();
+		secondCell.buildSoACaches();
+		vcp.initTraversal();
+		vcp.processCell(firstCell);
+		vcp.processCell(secondCell);
+		vcp.processCellPair(firstCell, secondCell);
+		vcp.endTraversal();
+		for (ParticleCell* cell : {&firstCell, &secondCell}) {
+			for (auto m = cell->iterator(); m.isValid(); ++m) {
+				m->calcFM();
+			}
+		}
+		return _simulation.getDomain()->getLocalUpot();
+	};
+
+	const double dt = _simulation.getIntegrator()->getTimestepLength();
+	const double initialEnergy = calculateForces();
+	double energy = initialEnergy;
+	maxDeviation = 0.;
+	for (unsigned int step = 0; step < _driftSteps; ++step) {
+		for (ParticleCell* cell : {&firstCell, &secondCell}) {
+			for (auto m = cell->iterator(); m.isValid(); ++m) {
+				m->upd_preF(dt);
+			}
+		}
+		const double upot = calculateForces();
+		double summv2 = 0., sumIw2 = 0.;
+		for (ParticleCell* cell : {&firstCell, &secondCell}) {
+			for (auto m = cell->iterator(); m.isValid(); ++m) {
+				m->upd_postF(0.5 * dt, summv2, sumIw2);
+			}
+		}
+		energy = upot + 0.5 * (summv2 + sumIw2);
+		maxDeviation = std::max(maxDeviation, std::abs(energy - initialEnergy) / std::abs(initialEnergy));
+	}
+
+	clearMolecules(firstCell);
+	clearMolecules(secondCell);
+	return std::abs(energy - initialEnergy) / std::abs(initialEnergy);
+}
+#endif
+
 void VectorizationTuner::iterateOwn(unsigned int numRepetitions,
 		ParticleCell& cell, double& gflopsPair, FlopCounter& flopCounter) {
 	runOwn(flopCounter, cell, 1);
@@ -14,6 +14,7 @@ enum MoleculeCntIncreaseTypeEnum{
 
 #include "particleContainer/adapter/CellProcessor.h"
 #include "particleContainer/adapter/FlopCounter.h"
+#include "particleContainer/adapter/VectorizedCellProcessor.h"
 #include "plugins/PluginBase.h"
 #include "ensemble/EnsembleBase.h"
 #include "parallel/LoadCalc.h"
@@ -26,6 +27,9 @@ class Component;
  *
  * This class is used to get detailed information about the performance of the VectorizedCellProcessor.
  * For different scenarios, the performance is evaluated and output.
+ * If precisions are given, all measurements are repeated for each of them and the accuracy of each precision
+ * compared to DPDP (relative deviation of potential energy and forces) is logged, as well as the drift of the total
+ * energy over a short NVE run of a small lattice of molecules.
  * Later this could be used to actually use this class as a tuner, i.e. to use the best possible vectorization method for the actual computation.
  */
 class VectorizationTuner: public PluginBase {
@@ -56,6 +60,8 @@ public:
 	     <numRepetitionsMax>INTEGER</numRepetitionsMax>
 	     <moleculecntincreasetype>linear OR exponential OR both</moleculecntincreasetype> <!--default: both-->
 	     <mode>stdout OR file</mode> <!--print to stdout or file-->
+	     <precisions>native,SPSP,SPDP,DPDP</precisions> <!--optional: comma separated precisions of the VectorizedCellProcessor to measure, default: current precision only-->
+	     <driftSteps>INTEGER</driftSteps> <!--time steps of the energy drift measurement per precision, 0 disables it, default: 1000-->
 	   </plugin>
 	   \endcode
 	 */
@@ -129,6 +135,29 @@ private:
 	/// FlopCounter for zero cutoff radius
 	std::unique_ptr<FlopCounter> _flopCounterZeroRc;
 
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	/// Precisions of the VectorizedCellProcessor, for which the measurements are done.
+	std::vector<VectorizedCellProcessor::Precision> _precisions;
+
+	/**
+	 * Logs the deviation of the potential energy and the forces of a test configuration
+	 * for every precision in _precisions compared to DPDP.
+	 */
+	void compareAccuracy(std::vector<Component>& ComponentList);
+
+	/// Number of time steps of the energy drift measurement.
+	unsigned int _driftSteps{1000};
+
+	/**
+	 * Integrates a lattice of molecules of the given component (slightly displaced from the LJ minimum, at rest)
+	 * in two cells for _driftSteps time steps without thermostat, using the given precision for the forces.
+	 * @param maxDeviation maximal relative deviation of the total energy from its initial value during the run
+	 * @return relative change of the total energy between the first and the last step
+	 */
+	double measureEnergyDrift(Component& component, VectorizedCellProcessor::Precision precision,
+			double& maxDeviation);
+#endif
+
 	/*
 	 * Writes the given TunerTimes to a file
 	 */
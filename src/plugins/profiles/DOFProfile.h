@@ -16,31 +16,16 @@ class DOFProfile final : public ProfileBase {
 public:
     ~DOFProfile() final = default;
     void record(Molecule &mol, unsigned long uID) final  {
-        _localProfile[uID] += 3.0 + (long double) (mol.component()->getRotationalDegreesOfFreedom());
-    }
-    void collectAppend(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        domainDecomp->collCommAppendInt(_localProfile[uID]);
-    }
-    void collectRetrieve(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        _globalProfile[uID] = domainDecomp->collCommGetInt();
+        localValues(uID)[0] += 3.0 + (double) (mol.component()->getRotationalDegreesOfFreedom());
     }
     void output(string prefix, long unsigned accumulatedDatasets) final;
-    void reset(unsigned long uID) final  {
-        _localProfile[uID] = 0;
-        _globalProfile[uID] = 0;
-    }
     int comms() final {return 1;}
 
     int getGlobalDOF(unsigned long uid) const {
-    	return _globalProfile.at(uid);
+    	return static_cast<int>(globalValues(uid)[0]);
     }
 
 private:
-    // Local 1D Profile
-    std::map<unsigned, int> _localProfile;
-    // Global 1D Profile
-    std::map<unsigned, int> _globalProfile;
-
     void writeDataEntry(unsigned long uID, ofstream &outfile) const final;
 };
 
@@ -33,5 +33,5 @@ void DensityProfile::output(string prefix, long unsigned accumulatedDatasets) {
 }
 
 void DensityProfile::writeDataEntry (unsigned long uID, ofstream& outfile) const {
-	outfile << (double) this->_globalProfile.at(uID) / (_samplInfo.segmentVolume * _accumulatedDatasets) << "\t";
+	outfile << globalValues(uID)[0] / (_samplInfo.segmentVolume * _accumulatedDatasets) << "\t";
 }
@@ -15,31 +15,16 @@ class DensityProfile final : public ProfileBase {
 public:
 	~DensityProfile() final = default;
     void record(Molecule &mol, unsigned long uID) final  {
-        _localProfile[uID] += 1;
-    }
-    void collectAppend(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        domainDecomp->collCommAppendInt(_localProfile[uID]);
-    }
-    void collectRetrieve(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        _globalProfile[uID] = domainDecomp->collCommGetInt();
+        localValues(uID)[0] += 1;
     }
     void output(string prefix, long unsigned accumulatedDatasets) final;
-    void reset(unsigned long uID) final  {
-        _localProfile[uID] = 0;
-        _globalProfile[uID] = 0;
-    }
     int comms() final {return 1;}
 
     int getGlobalNumber (unsigned long uid) const {
-    	return _globalProfile.at(uid);
+    	return static_cast<int>(globalValues(uid)[0]);
     }
 
 private:
-    // Local 1D Profile
-    std::map<unsigned, int> _localProfile;
-    // Global 1D Profile
-    std::map<unsigned, int> _globalProfile;
-
     void writeDataEntry(unsigned long uID, ofstream &outfile) const final;
 };
 
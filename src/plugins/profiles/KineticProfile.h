@@ -18,30 +18,16 @@ public:
         double mv2 = 0.0;
         double Iw2 = 0.0;
         mol.calculate_mv2_Iw2(mv2, Iw2);
-        _localProfile[uID] += mv2 + Iw2;
-    }
-    void collectAppend(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        domainDecomp->collCommAppendDouble(_localProfile[uID]);
-    }
-    void collectRetrieve(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        _globalProfile[uID] = domainDecomp->collCommGetDouble();
+        localValues(uID)[0] += mv2 + Iw2;
     }
     void output(string prefix, long unsigned accumulatedDatasets) final;
-    void reset(unsigned long uID) final  {
-        _localProfile[uID] = 0.0;
-        _globalProfile[uID] = 0.0;
-    }
     int comms() final {return 1;}
 
     double getGlobalKineticEnergy(unsigned long uid) const {
-    	return _globalProfile.at(uid);
+    	return globalValues(uid)[0];
     }
 
 private:
-    // Local 1D Profile
-    std::map<unsigned, double> _localProfile;
-    // Global 1D Profile
-    std::map<unsigned, double> _globalProfile;
 
     void writeDataEntry(unsigned long uID, ofstream &outfile) const final;
 
@@ -40,7 +40,7 @@ void Velocity3dProfile::writeDataEntry (unsigned long uID, ofstream& outfile) co
 		// Check for division by 0
 		int numberDensity = _densityProfile->getGlobalNumber(uID);
 		if (numberDensity != 0) {
-			vd = _global3dProfile.at(uID)[d] / numberDensity;
+			vd = globalValues(uID)[d] / numberDensity;
 		} else {
 			vd = 0;
 		}
@@ -35,7 +35,7 @@ void VelocityAbsProfile::writeDataEntry (unsigned long uID, ofstream& outfile) c
 	long double vd;
 	int numberDensity = _densityProfile->getGlobalNumber(uID);
 	if (numberDensity != 0) {
-		vd = _globalProfile.at(uID) / numberDensity;
+		vd = globalValues(uID)[0] / numberDensity;
 	} else {
 		vd = 0;
 	}
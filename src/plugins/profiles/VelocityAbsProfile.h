@@ -16,7 +16,7 @@ class DensityProfile;
 class VelocityAbsProfile final : public ProfileBase {
 public:
 	VelocityAbsProfile(DensityProfile * dens) :
-			_densityProfile(dens), _localProfile(), _globalProfile() {
+			_densityProfile(dens) {
 	}
     ~VelocityAbsProfile() final = default;
     void record(Molecule& mol, unsigned long uID) final  {
@@ -27,29 +27,15 @@ public:
             absV += v*v;
         }
         absV = sqrt(absV);
-        _localProfile[uID] += absV;
-    }
-    void collectAppend(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        domainDecomp->collCommAppendDouble(_localProfile[uID]);
-    }
-    void collectRetrieve(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        _globalProfile[uID] = domainDecomp->collCommGetDouble();
+        localValues(uID)[0] += absV;
     }
     void output(string prefix, long unsigned accumulatedDatasets) final;
-    void reset(unsigned long uID) final  {
-        _localProfile[uID] = 0.0;
-        _globalProfile[uID] = 0.0;
-    }
     // set correct number of communications needed for this profile
     int comms() final {return 1;}
 
 private:
     DensityProfile * _densityProfile;
 
-    // Local 1D Profile
-    std::map<unsigned, double> _localProfile;
-    // Global 1D Profile
-    std::map<unsigned, double> _globalProfile;
 
     void writeDataEntry(unsigned long uID, ofstream &outfile) const final;
 };
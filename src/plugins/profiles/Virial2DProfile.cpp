@@ -47,9 +47,9 @@ void Virial2DProfile::writeDataEntry(unsigned long uID, ofstream &outfile) const
 	long double virial2Dz = 0.0;
 	
 	long double N = _densityProfile->getGlobalNumber(uID);
-	long double Px = this->_global3dProfile.at(uID)[0];
-	long double Py = this->_global3dProfile.at(uID)[1];
-	long double Pz = this->_global3dProfile.at(uID)[2];
+	long double Px = globalValues(uID)[0];
+	long double Py = globalValues(uID)[1];
+	long double Pz = globalValues(uID)[2];
 
 	virial2Dx = (globalTemperatureFixRegion* N + Px)/(_samplInfo.segmentVolume * _accumulatedDatasets);
 	virial2Dy = (globalTemperatureFixRegion* N + Py)/(_samplInfo.segmentVolume * _accumulatedDatasets);
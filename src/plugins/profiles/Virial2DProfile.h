@@ -17,7 +17,7 @@ class KineticProfile;
 class Virial2DProfile final : public ProfileBase {
 public:
 	Virial2DProfile(DensityProfile* densProf, DOFProfile * dofProf, KineticProfile * kinProf) :
-			_densityProfile(densProf), _dofProfile(dofProf), _kineticProfile(kinProf), _local3dProfile(), _global3dProfile() {
+			_densityProfile(densProf), _dofProfile(dofProf), _kineticProfile(kinProf) {
 			}
 
 	~Virial2DProfile() final = default;
@@ -25,32 +25,13 @@ public:
 	
 	void record(Molecule& mol, unsigned long uID) final {
 		for (unsigned short d = 0; d < 3; d++) {
-			_local3dProfile[uID][d] += mol.Vi(d);
-		}
-	}
-
-	void collectAppend(DomainDecompBase* domainDecomp, unsigned long uID) final {
-		for (unsigned short d = 0; d < 3; d++) {
-			domainDecomp->collCommAppendDouble(_local3dProfile[uID][d]);
-		}
-	}
-
-	void collectRetrieve(DomainDecompBase* domainDecomp, unsigned long uID) final {
-		for (unsigned short d = 0; d < 3; d++) {
-			_global3dProfile[uID][d] = domainDecomp->collCommGetDouble();
+			localValues(uID)[d] += mol.Vi(d);
 		}
 	}
 
 
 	void output(string prefix, long unsigned accumulatedDatasets) final;
 
-	void reset(unsigned long uID) final {
-		for (unsigned d = 0; d < 3; d++) {
-			_local3dProfile[uID][d] = 0.0;
-			_global3dProfile[uID][d] = 0.0;
-		}
-	}
-
 	int comms() final { return 3; }
 
 private:
@@ -58,11 +39,6 @@ private:
 	DOFProfile* _dofProfile;
 	KineticProfile* _kineticProfile;
 
-	// Local 3D Profile
-	std::map<unsigned, std::array<double, 3>> _local3dProfile;
-	// Global 3D Profile
-	std::map<unsigned, std::array<double, 3>> _global3dProfile;
-
 	// Only needed because its abstract, all output handled by output()
 	void writeDataEntry(unsigned long uID, ofstream& outfile) const final;
 
@@ -73,9 +73,9 @@ void VirialProfile::output(string prefix, long unsigned accumulatedDatasets) {
 							y * _samplInfo.universalProfileUnit[2] + b);
 				}
 				// Add pressures
-				Px += _global3dProfile[unID][0];
-				Py += _global3dProfile[unID][1];
-				Pz += _global3dProfile[unID][2];
+				Px += globalValues(unID)[0];
+				Py += globalValues(unID)[1];
+				Pz += globalValues(unID)[2];
 				// Add molecules in layer
 				Ny += _densityProfile->getGlobalNumber(unID);
 			}
@@ -25,6 +25,13 @@ void COMalignerTest::testCOMalign() {
 	std::unique_ptr<COMaligner> plugin {new COMaligner()};
 
     plugin->init(container.get(), _domainDecomposition, _domain);
+    // the center of mass is summed up in the common pass over the molecules, which the simulation does before the forces
+    const auto hook = PluginBase::MoleculeVisitHook::BEFORE_FORCES;
+    ASSERT_TRUE(plugin->beginMoleculeVisit(hook, 1));
+    for (auto it = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+        plugin->visitMolecule(hook, *it, 0);
+    }
+    plugin->endMoleculeVisit(hook, 1);
     plugin->beforeForces(container.get(), _domainDecomposition, 1);
 
     double m = plugin->_mass;
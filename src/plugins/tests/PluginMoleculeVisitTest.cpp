@@ -0,0 +1,131 @@
+/*
+ * PluginMoleculeVisitTest.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#include "plugins/tests/PluginMoleculeVisitTest.h"
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Simulation.h"
+#include "WrapOpenMP.h"
+#include "particleContainer/ParticleContainer.h"
+#include "plugins/PluginBase.h"
+
+TEST_SUITE_REGISTRATION(PluginMoleculeVisitTest);
+
+namespace {
+
+/** Sums up the x coordinates of the molecules in the end step visit and logs the order of the calls. */
+class SamplingPlugin : public PluginBase {
+public:
+	SamplingPlugin(const std::string& name, std::vector<std::string>& log) : _name(name), _log(log) {}
+
+	void init(ParticleContainer*, DomainDecompBase*, Domain*) override {}
+	void readXML(XMLfileUnits&) override {}
+	void finish(ParticleContainer*, DomainDecompBase*, Domain*) override {}
+	std::string getPluginName() override { return _name; }
+
+	void endStep(ParticleContainer*, DomainDecompBase*, Domain*, unsigned long) override {
+		_log.push_back("endStep " + _name);
+	}
+
+	bool beginMoleculeVisit(MoleculeVisitHook hook, unsigned long) override {
+		_threadSums.assign(mardyn_get_max_threads(), 0.0);
+		return hook == MoleculeVisitHook::END_STEP;
+	}
+
+	void visitMolecule(MoleculeVisitHook, Molecule& molecule, int threadNum) override {
+		_threadSums[threadNum] += molecule.r(0);
+	}
+
+	void endMoleculeVisit(MoleculeVisitHook, unsigned long) override {
+		_sum = 0.0;
+		for (double threadSum : _threadSums) {
+			_sum += threadSum;
+		}
+		_log.push_back("visit " + _name);
+	}
+
+	bool modifiesMoleculesAt(MoleculeVisitHook) override { return false; }
+
+	double _sum = 0.0;
+
+private:
+	std::string _name;
+	std::vector<std::string>& _log;
+	std::vector<double> _threadSums;
+};
+
+/** Moves all molecules in its end step, like e.g. COMaligner does before the forces. */
+class MovingPlugin : public PluginBase {
+public:
+	MovingPlugin(std::vector<std::string>& log) : _log(log) {}
+
+	void init(ParticleContainer*, DomainDecompBase*, Domain*) override {}
+	void readXML(XMLfileUnits&) override {}
+	void finish(ParticleContainer*, DomainDecompBase*, Domain*) override {}
+	std::string getPluginName() override { return "Moving"; }
+
+	void endStep(ParticleContainer* particleContainer, DomainDecompBase*, Domain*, unsigned long) override {
+		for (auto it = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+			it->move(0, 0.125);
+		}
+		_log.push_back("endStep Moving");
+	}
+
+private:
+	std::vector<std::string>& _log;
+};
+
+}  // namespace
+
+void PluginMoleculeVisitTest::testVisitAfterModifyingPlugin() {
+	std::unique_ptr<ParticleContainer> container{
+		initializeFromFile(ParticleContainerFactory::LinkedCell, "1clj-regular-2x2x2-offset.inp", 0.5)};
+	const unsigned long numMolecules = container->getNumberOfParticles();
+
+	std::vector<std::string> log;
+	SamplingPlugin before("before", log);
+	MovingPlugin moving(log);
+	SamplingPlugin after("after", log);
+	std::list<PluginBase*> plugins{&before, &moving, &after};
+
+	Simulation::callPluginHook(plugins, container.get(), PluginBase::MoleculeVisitHook::END_STEP, 1,
+			[&](PluginBase* plugin) { plugin->endStep(container.get(), _domainDecomposition, _domain, 1); });
+
+	const std::vector<std::string> expected{"visit before", "endStep before", "endStep Moving", "visit after",
+			"endStep after"};
+	ASSERT_EQUAL(expected.size(), log.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		ASSERT_EQUAL(expected[i], log[i]);
+	}
+	ASSERT_DOUBLES_EQUAL(before._sum + 0.125 * numMolecules, after._sum, 1e-12);
+}
+
+void PluginMoleculeVisitTest::testSharedPass() {
+	std::unique_ptr<ParticleContainer> container{
+		initializeFromFile(ParticleContainerFactory::LinkedCell, "1clj-regular-2x2x2-offset.inp", 0.5)};
+
+	std::vector<std::string> log;
+	SamplingPlugin first("first", log);
+	SamplingPlugin second("second", log);
+	MovingPlugin moving(log);
+	std::list<PluginBase*> plugins{&first, &second, &moving};
+
+	Simulation::callPluginHook(plugins, container.get(), PluginBase::MoleculeVisitHook::END_STEP, 1,
+			[&](PluginBase* plugin) { plugin->endStep(container.get(), _domainDecomposition, _domain, 1); });
+
+	// both visits are finished before the first hook method is called
+	const std::vector<std::string> expected{"visit first", "visit second", "endStep first", "endStep second",
+			"endStep Moving"};
+	ASSERT_EQUAL(expected.size(), log.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		ASSERT_EQUAL(expected[i], log[i]);
+	}
+	ASSERT_DOUBLES_EQUAL(first._sum, second._sum, 1e-12);
+}
@@ -0,0 +1,35 @@
+/*
+ * PluginMoleculeVisitTest.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_PLUGINS_TESTS_PLUGINMOLECULEVISITTEST_H_
+#define SRC_PLUGINS_TESTS_PLUGINMOLECULEVISITTEST_H_
+
+#include "utils/TestWithSimulationSetup.h"
+
+/**
+ * Checks that the common pass over the molecules (Simulation::callPluginHook()) keeps the order of the plugins: a
+ * visiting plugin has to see the molecules as changed by the hook methods of the plugins before it.
+ */
+class PluginMoleculeVisitTest : public utils::TestWithSimulationSetup {
+
+	TEST_SUITE(PluginMoleculeVisitTest);
+	TEST_METHOD(testVisitAfterModifyingPlugin);
+	TEST_METHOD(testSharedPass);
+	TEST_SUITE_END;
+
+public:
+	PluginMoleculeVisitTest() = default;
+
+	virtual ~PluginMoleculeVisitTest() = default;
+
+	/** A sampling plugin after a plugin moving the molecules sees the moved molecules, one before does not. */
+	void testVisitAfterModifyingPlugin();
+
+	/** Consecutive plugins, which do not change the molecules, share one pass. */
+	void testSharedPass();
+};
+
+#endif /* SRC_PLUGINS_TESTS_PLUGINMOLECULEVISITTEST_H_ */
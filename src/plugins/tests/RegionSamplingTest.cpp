@@ -0,0 +1,117 @@
+/*
+ * RegionSamplingTest.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#include "plugins/tests/RegionSamplingTest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "WrapOpenMP.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+#include "plugins/NEMD/RegionSampling.h"
+#include "utils/xmlfileUnits.h"
+
+TEST_SUITE_REGISTRATION(RegionSamplingTest);
+
+void RegionSamplingTest::testThreadPrivateBins() {
+	testSampling(256., mardyn_get_max_threads());
+}
+
+void RegionSamplingTest::testSharedBins() {
+	testSampling(1e-9, 1);
+}
+
+RegionSampling* RegionSamplingTest::createRegionSampling(double threadMemoryLimit, ParticleContainer* container) {
+	const std::string xmlFilename = getTestDataFilename("regionsampling.test.xml", false);
+	{
+		std::ofstream xml(xmlFilename);
+		xml << "<plugin name=\"RegionSampling\">"
+			   "<threadmemorylimit>" << threadMemoryLimit << "</threadmemorylimit>"
+			   "<region>"
+			   "<coords><lcx>0</lcx><lcy>0</lcy><lcz>0</lcz><ucx>box</ucx><ucy>box</ucy><ucz>box</ucz></coords>"
+			   "<sampling type=\"profiles\">"
+			   "<control><start>0</start><frequency>1</frequency><stop>100</stop></control>"
+			   "<subdivision type=\"number\"><number>8</number></subdivision>"
+			   "</sampling>"
+			   "<sampling type=\"fieldYR\">"
+			   "<outputfile type=\"ASCII\"><prefix>" << getTestDataFilename("regionsampling.test", false) << "</prefix></outputfile>"
+			   "<control><start>0</start><frequency>1</frequency><stop>100</stop></control>"
+			   "<subdivision dim=\"y\" type=\"number\"><number>4</number></subdivision>"
+			   "<subdivision dim=\"r\" type=\"number\"><number>4</number></subdivision>"
+			   "</sampling>"
+			   "</region></plugin>" << std::endl;
+	}
+	XMLfileUnits xmlconfig(xmlFilename);
+	xmlconfig.changecurrentnode("/plugin");
+
+	RegionSampling* regionSampling = new RegionSampling();
+	regionSampling->readXML(xmlconfig);
+	regionSampling->init(container, _domainDecomposition, _domain);
+	return regionSampling;
+}
+
+void RegionSamplingTest::testSampling(double threadMemoryLimit, int expectedCopies) {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "RegionSamplingTest::testSampling()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell,
+			"VectorizationMultiComponentMultiPotentials.inp", 20.0);
+
+	// serial reference
+	RegionSampling* reference = createRegionSampling(256., container);
+	for (auto it = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+		reference->visitMolecule(PluginBase::MoleculeVisitHook::END_STEP, *it, 0);
+	}
+
+	RegionSampling* regionSampling = createRegionSampling(threadMemoryLimit, container);
+	SampleRegion* region = regionSampling->getSampleRegion(1);
+	ASSERT_EQUAL(expectedCopies, region->_numThreadCopies);
+	ASSERT_EQUAL(static_cast<size_t>(expectedCopies), region->_threadValuesProfiles.size());
+	ASSERT_EQUAL(static_cast<size_t>(expectedCopies), region->_nNumMoleculesFieldYRThread.size());
+	ASSERT_EQUAL(expectedCopies < mardyn_get_max_threads() ? static_cast<size_t>(expectedCopies) : 0ul,
+			region->_threadCopyLocks.size());
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	for (auto it = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+		regionSampling->visitMolecule(PluginBase::MoleculeVisitHook::END_STEP, *it, mardyn_get_thread_num());
+	}
+
+	SampleRegion* referenceRegion = reference->getSampleRegion(1);
+	referenceRegion->reduceThreadValuesProfiles();
+	referenceRegion->reduceThreadValuesFieldYR();
+	region->reduceThreadValuesProfiles();
+	region->reduceThreadValuesFieldYR();
+
+	unsigned long numSampled = 0;
+	for (size_t i = 0; i < region->_nNumValsScalar; ++i) {
+		ASSERT_EQUAL(referenceRegion->_nNumMoleculesLocal[i], region->_nNumMoleculesLocal[i]);
+		ASSERT_EQUAL(referenceRegion->_nRotDOFLocal[i], region->_nRotDOFLocal[i]);
+		ASSERT_DOUBLES_EQUAL(referenceRegion->_d2EkinRotLocal[i], region->_d2EkinRotLocal[i],
+				1e-10 * std::abs(referenceRegion->_d2EkinRotLocal[i]));
+		numSampled += region->_nNumMoleculesLocal[i];
+	}
+	ASSERT_TRUE(numSampled > 0);
+	for (size_t i = 0; i < region->_nNumValsVector; ++i) {
+		ASSERT_DOUBLES_EQUAL(referenceRegion->_dVelocityLocal[i], region->_dVelocityLocal[i],
+				1e-10 * std::max(1.0, std::abs(referenceRegion->_dVelocityLocal[i])));
+		ASSERT_DOUBLES_EQUAL(referenceRegion->_dForceLocal[i], region->_dForceLocal[i],
+				1e-10 * std::max(1.0, std::abs(referenceRegion->_dForceLocal[i])));
+	}
+	for (size_t i = 0; i < region->_nNumValsFieldYR; ++i) {
+		ASSERT_EQUAL(referenceRegion->_nNumMoleculesFieldYRLocal[i], region->_nNumMoleculesFieldYRLocal[i]);
+	}
+
+	delete reference;
+	delete regionSampling;
+	delete container;
+}
@@ -0,0 +1,47 @@
+/*
+ * RegionSamplingTest.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_PLUGINS_TESTS_REGIONSAMPLINGTEST_H_
+#define SRC_PLUGINS_TESTS_REGIONSAMPLINGTEST_H_
+
+#include "utils/TestWithSimulationSetup.h"
+
+#include <string>
+
+class RegionSampling;
+class ParticleContainer;
+
+/**
+ * Checks the sampling of RegionSampling into thread-private bins: the reduced profiles and y-r-fields have to match
+ * a serial sampling, both with one copy per thread and with copies shared by the threads due to the memory limit.
+ */
+class RegionSamplingTest : public utils::TestWithSimulationSetup {
+
+	TEST_SUITE(RegionSamplingTest);
+	TEST_METHOD(testThreadPrivateBins);
+	TEST_METHOD(testSharedBins);
+	TEST_SUITE_END;
+
+public:
+	RegionSamplingTest() = default;
+
+	virtual ~RegionSamplingTest() = default;
+
+	/** One copy of the bins per thread. */
+	void testThreadPrivateBins();
+
+	/** A memory limit below the size of one copy, so all threads share a single copy. */
+	void testSharedBins();
+
+private:
+	/** Sample a scenario in parallel with the given memory limit and compare with a serial sampling. */
+	void testSampling(double threadMemoryLimit, int expectedCopies);
+
+	/** Create a RegionSampling with one region covering the box, sampling profiles and a y-r-field. */
+	RegionSampling* createRegionSampling(double threadMemoryLimit, ParticleContainer* container);
+};
+
+#endif /* SRC_PLUGINS_TESTS_REGIONSAMPLINGTEST_H_ */
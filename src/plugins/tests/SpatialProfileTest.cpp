@@ -0,0 +1,81 @@
+/*
+ * SpatialProfileTest.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#include "plugins/tests/SpatialProfileTest.h"
+
+#include <fstream>
+
+#include "WrapOpenMP.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+#include "plugins/SpatialProfile.h"
+#include "plugins/profiles/DensityProfile.h"
+#include "utils/xmlfileUnits.h"
+
+TEST_SUITE_REGISTRATION(SpatialProfileTest);
+
+void SpatialProfileTest::testThreadLocalCopies() {
+	testDensityProfile(256., mardyn_get_max_threads());
+}
+
+void SpatialProfileTest::testSharedCopies() {
+	testDensityProfile(1e-9, 1);
+}
+
+void SpatialProfileTest::testDensityProfile(double threadMemoryLimit, int expectedCopies) {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "SpatialProfileTest::testDensityProfile()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	const std::string xmlFilename = getTestDataFilename("spatialprofile.test.xml", false);
+	{
+		std::ofstream xml(xmlFilename);
+		xml << "<plugin name=\"SpatialProfile\">"
+			   "<mode>cartesian</mode><x>1</x><y>4</y><z>4</z>"
+			   "<profiledComponent>all</profiledComponent>"
+			   "<writefrequency>1</writefrequency><timesteps><init>0</init><recording>1</recording></timesteps>"
+			   "<outputprefix>" << getTestDataFilename("spatialprofile.test", false) << "</outputprefix>"
+			   "<threadmemorylimit>" << threadMemoryLimit << "</threadmemorylimit>"
+			   "<profiles><density>1</density></profiles></plugin>" << std::endl;
+	}
+	XMLfileUnits xmlconfig(xmlFilename);
+	xmlconfig.changecurrentnode("/plugin");
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell,
+			"VectorizationMultiComponentMultiPotentials.inp", 20.0);
+
+	SpatialProfile profile;
+	profile.readXML(xmlconfig);
+	profile.init(container, _domainDecomposition, _domain);
+	ASSERT_EQUAL(expectedCopies, profile._numCopies);
+	ASSERT_EQUAL(expectedCopies < mardyn_get_max_threads() ? static_cast<size_t>(expectedCopies) : 0ul,
+			profile._copyLocks.size());
+
+	// serial reference
+	std::vector<int> expected(profile._uIDs, 0);
+	for (auto it = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+		++expected[profile.getCartesianUID(*it)];
+	}
+
+	// two parallel sampling steps, as in the common molecule pass of the simulation
+	for (int step = 0; step < 2; ++step) {
+		#if defined(_OPENMP)
+		#pragma omp parallel
+		#endif
+		for (auto it = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+			profile.visitMolecule(PluginBase::MoleculeVisitHook::END_STEP, *it, mardyn_get_thread_num());
+		}
+	}
+	profile.reduceValues(_domainDecomposition);
+
+	for (unsigned long uID = 0; uID < profile._uIDs; ++uID) {
+		ASSERT_EQUAL(2 * expected[uID], profile._densProfile->getGlobalNumber(uID));
+	}
+
+	delete container;
+}
@@ -0,0 +1,42 @@
+/*
+ * SpatialProfileTest.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_PLUGINS_TESTS_SPATIALPROFILETEST_H_
+#define SRC_PLUGINS_TESTS_SPATIALPROFILETEST_H_
+
+#include "utils/TestWithSimulationSetup.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * Checks the binning of SpatialProfile into thread-local copies: the reduced density profile has to match a serial
+ * count, both with one copy per thread and with copies shared by the threads due to the memory limit.
+ */
+class SpatialProfileTest : public utils::TestWithSimulationSetup {
+
+	TEST_SUITE(SpatialProfileTest);
+	TEST_METHOD(testThreadLocalCopies);
+	TEST_METHOD(testSharedCopies);
+	TEST_SUITE_END;
+
+public:
+	SpatialProfileTest() = default;
+
+	virtual ~SpatialProfileTest() = default;
+
+	/** One copy per thread. */
+	void testThreadLocalCopies();
+
+	/** A memory limit below the size of one copy, so all threads share a single copy. */
+	void testSharedCopies();
+
+private:
+	/** Bin a scenario in parallel with the given memory limit and compare the densities with a serial count. */
+	void testDensityProfile(double threadMemoryLimit, int expectedCopies);
+};
+
+#endif /* SRC_PLUGINS_TESTS_SPATIALPROFILETEST_H_ */
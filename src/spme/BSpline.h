@@ -0,0 +1,59 @@
+/*
+ * BSpline.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_SPME_BSPLINE_H_
+#define SRC_SPME_BSPLINE_H_
+
+namespace spme {
+
+/**
+ * \brief Weights of a point charge at the scaled coordinate u on the mesh points floor(u) - order + 1, ..., floor(u).
+ * \details theta[i] = M_order(u - k) and dtheta[i] = M_order'(u - k) for k = floor(u) - order + 1 + i, where M_n is
+ * the cardinal B-spline of order n (Essmann et al., J. Chem. Phys. 103, 8577 (1995)).
+ * \param w fractional part u - floor(u)
+ * \param order order of the B-spline, at least 3
+ */
+inline void bsplineWeights(double w, int order, double* theta, double* dtheta) {
+	theta[order - 1] = 0.0;
+	theta[1] = w;
+	theta[0] = 1.0 - w;
+	for (int k = 3; k < order; ++k) {
+		const double div = 1.0 / (k - 1);
+		theta[k - 1] = div * w * theta[k - 2];
+		for (int j = 1; j < k - 1; ++j) {
+			theta[k - j - 1] = div * ((w + j) * theta[k - j - 2] + (k - j - w) * theta[k - j - 1]);
+		}
+		theta[0] = div * (1.0 - w) * theta[0];
+	}
+
+	// M_n'(x) = M_{n-1}(x) - M_{n-1}(x - 1)
+	dtheta[0] = -theta[0];
+	for (int j = 1; j < order; ++j) {
+		dtheta[j] = theta[j - 1] - theta[j];
+	}
+
+	const double div = 1.0 / (order - 1);
+	theta[order - 1] = div * w * theta[order - 2];
+	for (int j = 1; j < order - 1; ++j) {
+		theta[order - j - 1] = div * ((w + j) * theta[order - j - 2] + (order - j - w) * theta[order - j - 1]);
+	}
+	theta[0] = div * (1.0 - w) * theta[0];
+}
+
+//! \brief Value of the cardinal B-spline M_order at x.
+inline double bsplineValue(int order, double x) {
+	if (x <= 0.0 or x >= order) {
+		return 0.0;
+	}
+	if (order == 2) {
+		return 1.0 - (x > 1.0 ? x - 1.0 : 1.0 - x);
+	}
+	return (x * bsplineValue(order - 1, x) + (order - x) * bsplineValue(order - 1, x - 1.0)) / (order - 1);
+}
+
+} // namespace spme
+
+#endif /* SRC_SPME_BSPLINE_H_ */
@@ -0,0 +1,726 @@
+/*
+ * SmoothParticleMeshEwald.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#include "SmoothParticleMeshEwald.h"
+#include "spme/BSpline.h"
+#include "Domain.h"
+#include "Simulation.h"
+#include "ensemble/EnsembleBase.h"
+#include "molecules/Molecule.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+#include "particleContainer/adapter/VectorizedCellProcessor.h"
+#include "utils/Logger.h"
+#include "utils/xmlfileUnits.h"
+#include "WrapOpenMP.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using Log::global_log;
+using std::endl;
+
+namespace spme {
+
+namespace {
+
+//! maximal B-spline order
+const int MAX_ORDER = 12;
+
+int wrap(int i, int n) {
+	i %= n;
+	return i < 0 ? i + n : i;
+}
+
+//! frequency of the mesh index i, in [-n/2, n/2]
+int frequency(int i, int n) {
+	return i <= n / 2 ? i : i - n;
+}
+
+std::vector<int> displacements(const std::vector<int>& counts) {
+	std::vector<int> displs(counts.size() + 1, 0);
+	for (size_t r = 0; r < counts.size(); ++r) {
+		displs[r + 1] = displs[r] + counts[r];
+	}
+	return displs;
+}
+
+} // namespace
+
+SmoothParticleMeshEwald::SmoothParticleMeshEwald() :
+		_tolerance(1e-5), _alpha(0.0), _gridSpacing(0.0), _splineOrder(4), _cutoffRadius(0.0),
+		_domain(nullptr), _domainDecomp(nullptr), _rank(0), _numProcs(1),
+#ifdef ENABLE_MPI
+		_comm(MPI_COMM_WORLD),
+#endif
+		_boxLength{{0.0, 0.0, 0.0}}, _meshSize{{0, 0, 0}}, _brickLow{{0, 0, 0}}, _brickNum{{0, 0, 0}} {
+}
+
+SmoothParticleMeshEwald::~SmoothParticleMeshEwald() {
+}
+
+void SmoothParticleMeshEwald::readXML(XMLfileUnits& xmlconfig) {
+	xmlconfig.getNodeValue("tolerance", _tolerance);
+	xmlconfig.getNodeValue("alpha", _alpha);
+	xmlconfig.getNodeValueReduced("gridSpacing", _gridSpacing);
+	xmlconfig.getNodeValue("splineOrder", _splineOrder);
+
+	if (_tolerance <= 0.0 or _tolerance >= 1.0) {
+		global_log->error() << "SmoothParticleMeshEwald: tolerance must be in (0, 1)" << endl;
+		Simulation::exit(1);
+	}
+	if (_alpha < 0.0 or _gridSpacing < 0.0) {
+		global_log->error() << "SmoothParticleMeshEwald: alpha and gridSpacing must not be negative" << endl;
+		Simulation::exit(1);
+	}
+	if (_splineOrder < 3 or _splineOrder > MAX_ORDER) {
+		global_log->error() << "SmoothParticleMeshEwald: splineOrder must be in [3, " << MAX_ORDER << "]" << endl;
+		Simulation::exit(1);
+	}
+	global_log->info() << "SmoothParticleMeshEwald: tolerance: " << _tolerance << endl;
+	global_log->info() << "SmoothParticleMeshEwald: splineOrder: " << _splineOrder << endl;
+}
+
+void SmoothParticleMeshEwald::setParameters(double tolerance, int splineOrder, double gridSpacing, double alpha) {
+	_tolerance = tolerance;
+	_splineOrder = splineOrder;
+	_gridSpacing = gridSpacing;
+	_alpha = alpha;
+}
+
+void SmoothParticleMeshEwald::init(Domain* domain, DomainDecompBase* domainDecomp, double cutoffRadius) {
+	_domain = domain;
+	_domainDecomp = domainDecomp;
+	_cutoffRadius = cutoffRadius;
+	_rank = domainDecomp->getRank();
+	_numProcs = domainDecomp->getNumProcs();
+#ifdef ENABLE_MPI
+	_comm = domainDecomp->getCommunicator();
+#endif
+
+	if (_alpha <= 0.0) {
+		// erfc(alpha * rc) = tolerance
+		double low = 0.0, high = 1.0 / cutoffRadius;
+		while (std::erfc(high * cutoffRadius) > _tolerance) {
+			high *= 2.0;
+		}
+		for (int i = 0; i < 100; ++i) {
+			const double mid = 0.5 * (low + high);
+			(std::erfc(mid * cutoffRadius) > _tolerance ? low : high) = mid;
+		}
+		_alpha = high;
+	}
+	if (_alpha * cutoffRadius > VectorizedCellProcessor::maxEwaldAlphaCutoff) {
+		// beyond, the real space part of the cell processor loses accuracy, while erfc is already below 2e-17
+		_alpha = VectorizedCellProcessor::maxEwaldAlphaCutoff / cutoffRadius;
+		global_log->warning() << "SmoothParticleMeshEwald: alpha limited to " << _alpha << " (alpha * cutoff radius = "
+				<< VectorizedCellProcessor::maxEwaldAlphaCutoff << ")." << endl;
+	}
+	if (_gridSpacing <= 0.0) {
+		_gridSpacing = 0.4 / _alpha;
+	}
+
+	for (auto& component : *(global_simulation->getEnsemble()->getComponents())) {
+		if (component.numDipoles() > 0 or component.numQuadrupoles() > 0) {
+			global_log->warning() << "SmoothParticleMeshEwald: dipoles and quadrupoles are not part of the Ewald sum,"
+					<< " they are still computed within the cutoff radius." << endl;
+			break;
+		}
+	}
+
+	_threadBricks.resize(mardyn_get_max_threads());
+	setupMesh();
+
+	global_log->info() << "SmoothParticleMeshEwald: alpha: " << _alpha << ", erfc(alpha * rc) = "
+			<< std::erfc(_alpha * cutoffRadius) << endl;
+	global_log->info() << "SmoothParticleMeshEwald: mesh: " << _meshSize[0] << " x " << _meshSize[1] << " x "
+			<< _meshSize[2] << " points" << endl;
+}
+
+void SmoothParticleMeshEwald::setupMesh() {
+	std::vector<double> splineAtIntegers(_splineOrder - 1);
+	for (int k = 0; k < _splineOrder - 1; ++k) {
+		splineAtIntegers[k] = bsplineValue(_splineOrder, k + 1.0);
+	}
+
+	for (int d = 0; d < 3; ++d) {
+		_boxLength[d] = _domain->getGlobalLength(d);
+		const int points = static_cast<int>(std::ceil(_boxLength[d] / _gridSpacing));
+		const int K = FFT1D::goodSize(std::max(points, _splineOrder));
+		_meshSize[d] = K;
+		_fft[d].reset(new FFT1D(K));
+
+		std::vector<double>& moduli = _bsplineModuli[d];
+		moduli.assign(K, 0.0);
+		for (int m = 0; m < K; ++m) {
+			Complex sum(0.0, 0.0);
+			for (int k = 0; k < _splineOrder - 1; ++k) {
+				sum += splineAtIntegers[k] * std::polar(1.0, 2.0 * M_PI * m * k / K);
+			}
+			moduli[m] = std::norm(sum);
+		}
+		// odd orders: the modulus vanishes at the Nyquist frequency, interpolate (as in Essmann's reference code)
+		for (int m = 0; m < K; ++m) {
+			if (moduli[m] < 1e-7) {
+				moduli[m] = 0.5 * (moduli[wrap(m - 1, K)] + moduli[wrap(m + 1, K)]);
+			}
+		}
+		for (int m = 0; m < K; ++m) {
+			moduli[m] = 1.0 / moduli[m];
+		}
+	}
+
+	_xSlabStart.resize(_numProcs + 1);
+	_ySlabStart.resize(_numProcs + 1);
+	for (int r = 0; r <= _numProcs; ++r) {
+		_xSlabStart[r] = static_cast<int>(static_cast<long>(r) * _meshSize[0] / _numProcs);
+		_ySlabStart[r] = static_cast<int>(static_cast<long>(r) * _meshSize[1] / _numProcs);
+	}
+	_xSlabOwner.resize(_meshSize[0]);
+	for (int r = 0; r < _numProcs; ++r) {
+		std::fill(_xSlabOwner.begin() + _xSlabStart[r], _xSlabOwner.begin() + _xSlabStart[r + 1], r);
+	}
+}
+
+void SmoothParticleMeshEwald::computeElectrostatics(ParticleContainer* particleContainer) {
+	global_simulation->timers()->start("SMOOTH_PARTICLE_MESH_EWALD_COMPLETE");
+
+	for (int d = 0; d < 3; ++d) {
+		if (_domain->getGlobalLength(d) != _boxLength[d]) {
+			setupMesh();
+			break;
+		}
+	}
+
+	global_simulation->timers()->start("SMOOTH_PARTICLE_MESH_EWALD_SPREAD");
+	collectCharges(particleContainer);
+	spreadCharges();
+	global_simulation->timers()->stop("SMOOTH_PARTICLE_MESH_EWALD_SPREAD");
+
+	global_simulation->timers()->start("SMOOTH_PARTICLE_MESH_EWALD_COMMUNICATION");
+	bricksToSlab();
+	global_simulation->timers()->stop("SMOOTH_PARTICLE_MESH_EWALD_COMMUNICATION");
+
+	global_simulation->timers()->start("SMOOTH_PARTICLE_MESH_EWALD_FFT");
+	forwardFFT();
+	std::array<double, 3> virial = {{0.0, 0.0, 0.0}};
+	double upot = convolve(virial);
+	backwardFFT();
+	global_simulation->timers()->stop("SMOOTH_PARTICLE_MESH_EWALD_FFT");
+
+	global_simulation->timers()->start("SMOOTH_PARTICLE_MESH_EWALD_COMMUNICATION");
+	slabToBricks();
+	global_simulation->timers()->stop("SMOOTH_PARTICLE_MESH_EWALD_COMMUNICATION");
+
+	global_simulation->timers()->start("SMOOTH_PARTICLE_MESH_EWALD_GATHER");
+	upot += gatherForces(virial);
+	global_simulation->timers()->stop("SMOOTH_PARTICLE_MESH_EWALD_GATHER");
+
+	// neutralising background of a non-neutral system, dE/dV = -E/V
+	double totalCharge = 0.0;
+	for (double q : _chargeQ) {
+		totalCharge += q;
+	}
+#ifdef ENABLE_MPI
+	MPI_Allreduce(MPI_IN_PLACE, &totalCharge, 1, MPI_DOUBLE, MPI_SUM, _comm);
+#endif
+	double virialSum = virial[0] + virial[1] + virial[2];
+	if (_rank == 0 and std::fabs(totalCharge) > 1e-10) {
+		const double volume = _boxLength[0] * _boxLength[1] * _boxLength[2];
+		const double background = -M_PI * totalCharge * totalCharge / (2.0 * volume * _alpha * _alpha);
+		upot += background;
+		virialSum += 3.0 * background;
+	}
+
+	_domain->setLocalUpot(_domain->getLocalUpot() + upot);
+	_domain->setLocalVirial(_domain->getLocalVirial() + virialSum);
+
+	global_simulation->timers()->stop("SMOOTH_PARTICLE_MESH_EWALD_COMPLETE");
+}
+
+void SmoothParticleMeshEwald::collectCharges(ParticleContainer* particleContainer) {
+	_molecules.clear();
+	_firstCharge.clear();
+	_chargePos.clear();
+	_chargeQ.clear();
+
+	for (auto m = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		const unsigned numCharges = m->numCharges();
+		if (numCharges == 0) {
+			continue;
+		}
+		_molecules.push_back(&(*m));
+		_firstCharge.push_back(_chargeQ.size());
+		for (unsigned j = 0; j < numCharges; ++j) {
+			const std::array<double, 3> d = m->charge_d(j);
+			for (int k = 0; k < 3; ++k) {
+				_chargePos.push_back(m->r(k) + d[k]);
+			}
+			_chargeQ.push_back(m->component()->charge(j).q());
+		}
+	}
+	_firstCharge.push_back(_chargeQ.size());
+
+	// the brick covers the support of the B-splines of all own charges
+	if (_chargeQ.empty()) {
+		_brickLow = {{0, 0, 0}};
+		_brickNum = {{0, 0, 0}};
+		return;
+	}
+	for (int d = 0; d < 3; ++d) {
+		int low = std::numeric_limits<int>::max(), high = std::numeric_limits<int>::min();
+		for (size_t c = 0; c < _chargeQ.size(); ++c) {
+			const int base = static_cast<int>(std::floor(_meshSize[d] * _chargePos[3 * c + d] / _boxLength[d]));
+			low = std::min(low, base);
+			high = std::max(high, base);
+		}
+		_brickLow[d] = low - _splineOrder + 1;
+		_brickNum[d] = high - _brickLow[d] + 1;
+	}
+}
+
+void SmoothParticleMeshEwald::spreadCharges() {
+	const size_t brickSize = static_cast<size_t>(_brickNum[0]) * _brickNum[1] * _brickNum[2];
+	_brickQ.assign(brickSize, 0.0);
+	const long numCharges = _chargeQ.size();
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		std::vector<double>& brick = _threadBricks[mardyn_get_thread_num()];
+		brick.assign(brickSize, 0.0);
+		double theta[3][MAX_ORDER], dtheta[3][MAX_ORDER];
+		int base[3];
+
+		#if defined(_OPENMP)
+		#pragma omp for schedule(static)
+		#endif
+		for (long c = 0; c < numCharges; ++c) {
+			for (int d = 0; d < 3; ++d) {
+				const double u = _meshSize[d] * _chargePos[3 * c + d] / _boxLength[d];
+				const double uFloor = std::floor(u);
+				bsplineWeights(u - uFloor, _splineOrder, theta[d], dtheta[d]);
+				base[d] = static_cast<int>(uFloor) - _splineOrder + 1 - _brickLow[d];
+			}
+			const double q = _chargeQ[c];
+			for (int i = 0; i < _splineOrder; ++i) {
+				const double qx = q * theta[0][i];
+				for (int j = 0; j < _splineOrder; ++j) {
+					const double qxy = qx * theta[1][j];
+					double* row = &brick[(static_cast<size_t>(base[0] + i) * _brickNum[1] + base[1] + j) * _brickNum[2] + base[2]];
+					for (int k = 0; k < _splineOrder; ++k) {
+						row[k] += qxy * theta[2][k];
+					}
+				}
+			}
+		}
+
+		const int numThreads = mardyn_get_num_threads();
+		#if defined(_OPENMP)
+		#pragma omp for schedule(static)
+		#endif
+		for (long p = 0; p < static_cast<long>(brickSize); ++p) {
+			double sum = 0.0;
+			for (int t = 0; t < numThreads; ++t) {
+				sum += _threadBricks[t][p];
+			}
+			_brickQ[p] = sum;
+		}
+	} // end pragma omp parallel
+}
+
+size_t SmoothParticleMeshEwald::brickPointsInSlab(int rank, int owner) const {
+	const int* brick = &_bricks[6 * rank];
+	size_t planes = 0;
+	for (int i = 0; i < brick[3]; ++i) {
+		if (_xSlabOwner[wrap(brick[0] + i, _meshSize[0])] == owner) {
+			++planes;
+		}
+	}
+	return planes * brick[4] * brick[5];
+}
+
+void SmoothParticleMeshEwald::alltoallv(const std::vector<int>& sendCounts, const std::vector<int>& recvCounts) {
+	const std::vector<int> recvDispls = displacements(recvCounts);
+	_recvBuffer.resize(recvDispls.back());
+#ifdef ENABLE_MPI
+	const std::vector<int> sendDispls = displacements(sendCounts);
+	MPI_Alltoallv(_sendBuffer.data(), sendCounts.data(), sendDispls.data(), MPI_DOUBLE,
+			_recvBuffer.data(), recvCounts.data(), recvDispls.data(), MPI_DOUBLE, _comm);
+#else
+	std::copy(_sendBuffer.begin(), _sendBuffer.begin() + recvDispls.back(), _recvBuffer.begin());
+#endif
+}
+
+void SmoothParticleMeshEwald::bricksToSlab() {
+	const int ownBrick[6] = {_brickLow[0], _brickLow[1], _brickLow[2], _brickNum[0], _brickNum[1], _brickNum[2]};
+	_bricks.resize(6 * _numProcs);
+#ifdef ENABLE_MPI
+	MPI_Allgather(ownBrick, 6, MPI_INT, _bricks.data(), 6, MPI_INT, _comm);
+#else
+	std::copy(ownBrick, ownBrick + 6, _bricks.begin());
+#endif
+
+	std::vector<int> sendCounts(_numProcs), recvCounts(_numProcs);
+	for (int r = 0; r < _numProcs; ++r) {
+		sendCounts[r] = brickPointsInSlab(_rank, r);
+		recvCounts[r] = brickPointsInSlab(r, _rank);
+	}
+
+	// the x-planes of the brick, sorted by the owner of their slab
+	const size_t planeSize = static_cast<size_t>(_brickNum[1]) * _brickNum[2];
+	std::vector<int> offset = displacements(sendCounts);
+	_sendBuffer.resize(offset.back());
+	for (int i = 0; i < _brickNum[0]; ++i) {
+		const int owner = _xSlabOwner[wrap(_brickLow[0] + i, _meshSize[0])];
+		std::copy(_brickQ.begin() + i * planeSize, _brickQ.begin() + (i + 1) * planeSize, _sendBuffer.begin() + offset[owner]);
+		offset[owner] += planeSize;
+	}
+	alltoallv(sendCounts, recvCounts);
+
+	const int K1 = _meshSize[1], K2 = _meshSize[2];
+	const int slabStart = _xSlabStart[_rank];
+	_xSlab.assign(static_cast<size_t>(_xSlabStart[_rank + 1] - slabStart) * K1 * K2, Complex(0.0, 0.0));
+	size_t p = 0;
+	for (int r = 0; r < _numProcs; ++r) {
+		const int* brick = &_bricks[6 * r];
+		for (int i = 0; i < brick[3]; ++i) {
+			const int x = wrap(brick[0] + i, _meshSize[0]);
+			if (_xSlabOwner[x] != _rank) {
+				continue;
+			}
+			for (int j = 0; j < brick[4]; ++j) {
+				Complex* row = &_xSlab[(static_cast<size_t>(x - slabStart) * K1 + wrap(brick[1] + j, K1)) * K2];
+				for (int k = 0; k < brick[5]; ++k) {
+					row[wrap(brick[2] + k, K2)] += _recvBuffer[p++];
+				}
+			}
+		}
+	}
+}
+
+void SmoothParticleMeshEwald::slabToBricks() {
+	std::vector<int> sendCounts(_numProcs), recvCounts(_numProcs);
+	for (int r = 0; r < _numProcs; ++r) {
+		sendCounts[r] = brickPointsInSlab(r, _rank);
+		recvCounts[r] = brickPointsInSlab(_rank, r);
+	}
+
+	const int K1 = _meshSize[1], K2 = _meshSize[2];
+	const int slabStart = _xSlabStart[_rank];
+	_sendBuffer.resize(displacements(sendCounts).back());
+	size_t p = 0;
+	for (int r = 0; r < _numProcs; ++r) {
+		const int* brick = &_bricks[6 * r];
+		for (int i = 0; i < brick[3]; ++i) {
+			const int x = wrap(brick[0] + i, _meshSize[0]);
+			if (_xSlabOwner[x] != _rank) {
+				continue;
+			}
+			for (int j = 0; j < brick[4]; ++j) {
+				const Complex* row = &_xSlab[(static_cast<size_t>(x - slabStart) * K1 + wrap(brick[1] + j, K1)) * K2];
+				for (int k = 0; k < brick[5]; ++k) {
+					_sendBuffer[p++] = row[wrap(brick[2] + k, K2)].real();
+				}
+			}
+		}
+	}
+	alltoallv(sendCounts, recvCounts);
+
+	const size_t planeSize = static_cast<size_t>(_brickNum[1]) * _brickNum[2];
+	std::vector<int> offset = displacements(recvCounts);
+	_brickPhi.resize(_brickQ.size());
+	for (int i = 0; i < _brickNum[0]; ++i) {
+		const int owner = _xSlabOwner[wrap(_brickLow[0] + i, _meshSize[0])];
+		std::copy(_recvBuffer.begin() + offset[owner], _recvBuffer.begin() + offset[owner] + planeSize,
+				_brickPhi.begin() + i * planeSize);
+		offset[owner] += planeSize;
+	}
+}
+
+void SmoothParticleMeshEwald::forwardFFT() {
+	const int K0 = _meshSize[0], K1 = _meshSize[1], K2 = _meshSize[2];
+	const long xPlanes = _xSlabStart[_rank + 1] - _xSlabStart[_rank];
+	const long yPlanes = _ySlabStart[_rank + 1] - _ySlabStart[_rank];
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		#if defined(_OPENMP)
+		#pragma omp for schedule(static)
+		#endif
+		for (long line = 0; line < xPlanes * K1; ++line) {
+			_fft[2]->transform(&_xSlab[line * K2], 1, -1);
+		}
+		#if defined(_OPENMP)
+		#pragma omp for schedule(static)
+		#endif
+		for (long line = 0; line < xPlanes * K2; ++line) {
+			_fft[1]->transform(&_xSlab[(line / K2) * K1 * K2 + line % K2], K2, -1);
+		}
+	} // end pragma omp parallel
+
+	transposeXToY();
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		#if defined(_OPENMP)
+		#pragma omp for schedule(static)
+		#endif
+		for (long line = 0; line < yPlanes * K2; ++line) {
+			_fft[0]->transform(&_ySlab[(line / K2) * K0 * K2 + line % K2], K2, -1);
+		}
+	} // end pragma omp parallel
+}
+
+void SmoothParticleMeshEwald::backwardFFT() {
+	const int K0 = _meshSize[0], K1 = _meshSize[1], K2 = _meshSize[2];
+	const long xPlanes = _xSlabStart[_rank + 1] - _xSlabStart[_rank];
+	const long yPlanes = _ySlabStart[_rank + 1] - _ySlabStart[_rank];
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		#if defined(_OPENMP)
+		#pragma omp for schedule(static)
+		#endif
+		for (long line = 0; line < yPlanes * K2; ++line) {
+			_fft[0]->transform(&_ySlab[(line / K2) * K0 * K2 + line % K2], K2, 1);
+		}
+	} // end pragma omp parallel
+
+	transposeYToX();
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		#if defined(_OPENMP)
+		#pragma omp for schedule(static)
+		#endif
+		for (long line = 0; line < xPlanes * K2; ++line) {
+			_fft[1]->transform(&_xSlab[(line / K2) * K1 * K2 + line % K2], K2, 1);
+		}
+		#if defined(_OPENMP)
+		#pragma omp for schedule(static)
+		#endif
+		for (long line = 0; line < xPlanes * K1; ++line) {
+			_fft[2]->transform(&_xSlab[line * K2], 1, 1);
+		}
+	} // end pragma omp parallel
+}
+
+void SmoothParticleMeshEwald::transposeXToY() {
+	const int K0 = _meshSize[0], K1 = _meshSize[1], K2 = _meshSize[2];
+	const int xPlanes = _xSlabStart[_rank + 1] - _xSlabStart[_rank];
+	const int yPlanes = _ySlabStart[_rank + 1] - _ySlabStart[_rank];
+
+	std::vector<int> sendCounts(_numProcs), recvCounts(_numProcs);
+	for (int r = 0; r < _numProcs; ++r) {
+		sendCounts[r] = 2 * xPlanes * (_ySlabStart[r + 1] - _ySlabStart[r]) * K2;
+		recvCounts[r] = 2 * (_xSlabStart[r + 1] - _xSlabStart[r]) * yPlanes * K2;
+	}
+	_sendBuffer.resize(displacements(sendCounts).back());
+	size_t p = 0;
+	for (int r = 0; r < _numProcs; ++r) {
+		for (int x = 0; x < xPlanes; ++x) {
+			for (int y = _ySlabStart[r]; y < _ySlabStart[r + 1]; ++y) {
+				const Complex* row = &_xSlab[(static_cast<size_t>(x) * K1 + y) * K2];
+				for (int z = 0; z < K2; ++z) {
+					_sendBuffer[p++] = row[z].real();
+					_sendBuffer[p++] = row[z].imag();
+				}
+			}
+		}
+	}
+	alltoallv(sendCounts, recvCounts);
+
+	_ySlab.resize(static_cast<size_t>(yPlanes) * K0 * K2);
+	p = 0;
+	for (int r = 0; r < _numProcs; ++r) {
+		for (int x = _xSlabStart[r]; x < _xSlabStart[r + 1]; ++x) {
+			for (int y = 0; y < yPlanes; ++y) {
+				Complex* row = &_ySlab[(static_cast<size_t>(y) * K0 + x) * K2];
+				for (int z = 0; z < K2; ++z, p += 2) {
+					row[z] = Complex(_recvBuffer[p], _recvBuffer[p + 1]);
+				}
+			}
+		}
+	}
+}
+
+void SmoothParticleMeshEwald::transposeYToX() {
+	const int K0 = _meshSize[0], K1 = _meshSize[1], K2 = _meshSize[2];
+	const int xPlanes = _xSlabStart[_rank + 1] - _xSlabStart[_rank];
+	const int yPlanes = _ySlabStart[_rank + 1] - _ySlabStart[_rank];
+
+	std::vector<int> sendCounts(_numProcs), recvCounts(_numProcs);
+	for (int r = 0; r < _numProcs; ++r) {
+		sendCounts[r] = 2 * (_xSlabStart[r + 1] - _xSlabStart[r]) * yPlanes * K2;
+		recvCounts[r] = 2 * xPlanes * (_ySlabStart[r + 1] - _ySlabStart[r]) * K2;
+	}
+	_sendBuffer.resize(displacements(sendCounts).back());
+	size_t p = 0;
+	for (int r = 0; r < _numProcs; ++r) {
+		for (int x = _xSlabStart[r]; x < _xSlabStart[r + 1]; ++x) {
+			for (int y = 0; y < yPlanes; ++y) {
+				const Complex* row = &_ySlab[(static_cast<size_t>(y) * K0 + x) * K2];
+				for (int z = 0; z < K2; ++z) {
+					_sendBuffer[p++] = row[z].real();
+					_sendBuffer[p++] = row[z].imag();
+				}
+			}
+		}
+	}
+	alltoallv(sendCounts, recvCounts);
+
+	p = 0;
+	for (int r = 0; r < _numProcs; ++r) {
+		for (int x = 0; x < xPlanes; ++x) {
+			for (int y = _ySlabStart[r]; y < _ySlabStart[r + 1]; ++y) {
+				Complex* row = &_xSlab[(static_cast<size_t>(x) * K1 + y) * K2];
+				for (int z = 0; z < K2; ++z, p += 2) {
+					row[z] = Complex(_recvBuffer[p], _recvBuffer[p + 1]);
+				}
+			}
+		}
+	}
+}
+
+double SmoothParticleMeshEwald::convolve(std::array<double, 3>& virial) {
+	const int K0 = _meshSize[0], K1 = _meshSize[1], K2 = _meshSize[2];
+	const int yStart = _ySlabStart[_rank];
+	const long size = static_cast<long>(_ySlabStart[_rank + 1] - yStart) * K0 * K2;
+	const double volume = _boxLength[0] * _boxLength[1] * _boxLength[2];
+	const double prefactor = 1.0 / (M_PI * volume);
+	const double expFactor = M_PI * M_PI / (_alpha * _alpha);
+
+	double upot = 0.0, virialX = 0.0, virialY = 0.0, virialZ = 0.0;
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(static) reduction(+:upot, virialX, virialY, virialZ)
+	#endif
+	for (long p = 0; p < size; ++p) {
+		const int y = yStart + static_cast<int>(p / (static_cast<long>(K0) * K2));
+		const int x = static_cast<int>((p / K2) % K0);
+		const int z = static_cast<int>(p % K2);
+		const double mx = frequency(x, K0) / _boxLength[0];
+		const double my = frequency(y, K1) / _boxLength[1];
+		const double mz = frequency(z, K2) / _boxLength[2];
+		const double m2 = mx * mx + my * my + mz * mz;
+		if (m2 == 0.0) {
+			_ySlab[p] = 0.0;
+			continue;
+		}
+
+		const double influence = prefactor * std::exp(-expFactor * m2) / m2
+				* _bsplineModuli[0][x] * _bsplineModuli[1][y] * _bsplineModuli[2][z];
+		const double energy = 0.5 * influence * std::norm(_ySlab[p]);
+		const double virialFactor = 2.0 * (1.0 + expFactor * m2) / m2;
+		upot += energy;
+		virialX += energy * (1.0 - virialFactor * mx * mx);
+		virialY += energy * (1.0 - virialFactor * my * my);
+		virialZ += energy * (1.0 - virialFactor * mz * mz);
+		_ySlab[p] *= influence;
+	}
+
+	virial[0] += virialX;
+	virial[1] += virialY;
+	virial[2] += virialZ;
+	return upot;
+}
+
+double SmoothParticleMeshEwald::gatherForces(std::array<double, 3>& virial) {
+	const long numMolecules = _molecules.size();
+	const double selfFactor = _alpha / std::sqrt(M_PI);
+	const double alpha2 = _alpha * _alpha;
+
+	double upot = 0.0, virialX = 0.0, virialY = 0.0, virialZ = 0.0;
+	#if defined(_OPENMP)
+	#pragma omp parallel reduction(+:upot, virialX, virialY, virialZ)
+	#endif
+	{
+		double theta[3][MAX_ORDER], dtheta[3][MAX_ORDER];
+		int base[3];
+
+		#if defined(_OPENMP)
+		#pragma omp for schedule(static)
+		#endif
+		for (long mi = 0; mi < numMolecules; ++mi) {
+			Molecule* molecule = _molecules[mi];
+			const size_t first = _firstCharge[mi], last = _firstCharge[mi + 1];
+
+			for (size_t c = first; c < last; ++c) {
+				const double* pos = &_chargePos[3 * c];
+				const double q = _chargeQ[c];
+
+				// reciprocal space: F = -q grad(sum_k theta(k) phi(k))
+				for (int d = 0; d < 3; ++d) {
+					const double u = _meshSize[d] * pos[d] / _boxLength[d];
+					const double uFloor = std::floor(u);
+					bsplineWeights(u - uFloor, _splineOrder, theta[d], dtheta[d]);
+					base[d] = static_cast<int>(uFloor) - _splineOrder + 1 - _brickLow[d];
+				}
+				double f[3] = {0.0, 0.0, 0.0};
+				for (int i = 0; i < _splineOrder; ++i) {
+					for (int j = 0; j < _splineOrder; ++j) {
+						const double* row = &_brickPhi[(static_cast<size_t>(base[0] + i) * _brickNum[1] + base[1] + j) * _brickNum[2] + base[2]];
+						for (int k = 0; k < _splineOrder; ++k) {
+							f[0] += dtheta[0][i] * theta[1][j] * theta[2][k] * row[k];
+							f[1] += theta[0][i] * dtheta[1][j] * theta[2][k] * row[k];
+							f[2] += theta[0][i] * theta[1][j] * dtheta[2][k] * row[k];
+						}
+					}
+				}
+				for (int d = 0; d < 3; ++d) {
+					f[d] *= -q * _meshSize[d] / _boxLength[d];
+				}
+
+				// the virial is accumulated between the molecule centers, as in the cell processors
+				virialX -= (pos[0] - molecule->r(0)) * f[0];
+				virialY -= (pos[1] - molecule->r(1)) * f[1];
+				virialZ -= (pos[2] - molecule->r(2)) * f[2];
+
+				// remove the interactions within the molecule, which the mesh contains, and the self energy
+				upot -= selfFactor * q * q;
+				for (size_t c2 = first; c2 < last; ++c2) {
+					if (c2 == c) {
+						continue;
+					}
+					const double dr[3] = {pos[0] - _chargePos[3 * c2], pos[1] - _chargePos[3 * c2 + 1],
+							pos[2] - _chargePos[3 * c2 + 2]};
+					const double r2 = dr[0] * dr[0] + dr[1] * dr[1] + dr[2] * dr[2];
+					const double qq = q * _chargeQ[c2];
+					if (r2 < 1e-24) {
+						upot -= qq * selfFactor;
+						continue;
+					}
+					const double r = std::sqrt(r2);
+					const double erfTerm = std::erf(_alpha * r) / r;
+					upot -= 0.5 * qq * erfTerm;
+					const double fac = qq * (2.0 * selfFactor * std::exp(-alpha2 * r2) - erfTerm) / r2;
+					for (int d = 0; d < 3; ++d) {
+						f[d] += fac * dr[d];
+					}
+				}
+
+				molecule->Fchargeadd(c - first, f);
+			}
+		}
+	} // end pragma omp parallel
+
+	virial[0] += virialX;
+	virial[1] += virialY;
+	virial[2] += virialZ;
+	return upot;
+}
+
+} // namespace spme
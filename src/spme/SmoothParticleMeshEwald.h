@@ -0,0 +1,160 @@
+/*
+ * SmoothParticleMeshEwald.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_SPME_SMOOTHPARTICLEMESHEWALD_H_
+#define SRC_SPME_SMOOTHPARTICLEMESHEWALD_H_
+
+#include "bhfmm/fft/tools/FFT1D.h"
+
+#include <array>
+#include <complex>
+#include <memory>
+#include <vector>
+
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
+
+class Domain;
+class DomainDecompBase;
+class ParticleContainer;
+class XMLfileUnits;
+
+#include "molecules/MoleculeForwardDeclaration.h"
+
+namespace spme {
+
+/**
+ * \brief Smooth particle mesh Ewald summation (Essmann et al., J. Chem. Phys. 103, 8577 (1995)) for point charges.
+ *
+ * The Coulomb interaction is split by the Ewald parameter alpha:
+ * - The real space part erfc(alpha r) / r is computed up to the cutoff radius by the charge kernel of the
+ *   VectorizedCellProcessor (see VectorizedCellProcessor::setEwaldSplitting()).
+ * - The reciprocal space part is computed here. The charges are spread onto a periodic mesh with
+ *   cardinal B-splines, the mesh is convolved with the influence function by a distributed 3D FFT,
+ *   and the forces are interpolated back with the derivatives of the B-splines.
+ * - The self energy, the interactions of charges within the same molecule (which are excluded from the
+ *   real space part) and, for a non-neutral system, the neutralising background are corrected here as well.
+ *
+ * Every process spreads the charges of its own molecules onto a local brick of the mesh, which covers its
+ * subdomain of the domain decomposition and the B-spline support. The FFT is done on slabs of x-planes,
+ * which are transposed to slabs of y-planes for the transforms along x. The bricks are summed into the slabs
+ * and the potential is sent back to the bricks by MPI_Alltoallv.
+ * Spreading, gathering, the line FFTs and the reciprocal space sum are parallelised with OpenMP.
+ *
+ * Dipoles and quadrupoles are not part of the Ewald sum, they keep their cutoff / reaction field treatment.
+ *
+ * \code{.xml}
+   <electrostatic type="SmoothParticleMeshEwald">
+     <tolerance>DOUBLE</tolerance>      <!-- erfc(alpha * cutoff), determines alpha; default 1e-5 -->
+     <alpha>DOUBLE</alpha>              <!-- Ewald parameter in 1/length, overrides the tolerance; alpha * cutoff <= 6 -->
+     <gridSpacing>DOUBLE</gridSpacing>  <!-- maximal mesh spacing; default 0.4 / alpha -->
+     <splineOrder>INT</splineOrder>     <!-- order of the B-splines, 3 to 12; default 4 -->
+   </electrostatic>
+   \endcode
+ */
+class SmoothParticleMeshEwald {
+public:
+	typedef std::complex<double> Complex;
+
+	SmoothParticleMeshEwald();
+	~SmoothParticleMeshEwald();
+
+	void readXML(XMLfileUnits& xmlconfig);
+
+	//! \brief Set the parameters without an XML file, alpha = 0 determines alpha from the tolerance.
+	void setParameters(double tolerance, int splineOrder, double gridSpacing = 0.0, double alpha = 0.0);
+
+	/**
+	 * \brief Determine alpha and the mesh, and precompute the B-spline moduli.
+	 * \param cutoffRadius cutoff radius of the real space part
+	 */
+	void init(Domain* domain, DomainDecompBase* domainDecomp, double cutoffRadius);
+
+	/**
+	 * \brief Add the reciprocal space forces and the corrections to the charges of the own molecules.
+	 * \details The forces are added to the charge sites, so this has to be called after the traversal and before the
+	 * forces are summed up per molecule (Simulation::updateForces()). Potential and virial are added to the
+	 * local values of the Domain. Has to be called by all processes.
+	 */
+	void computeElectrostatics(ParticleContainer* particleContainer);
+
+	double getAlpha() const {
+		return _alpha;
+	}
+
+	//! \brief Number of mesh points per dimension.
+	std::array<int, 3> getMeshSize() const {
+		return _meshSize;
+	}
+
+private:
+	double _tolerance;
+	double _alpha;
+	double _gridSpacing;
+	int _splineOrder;
+	double _cutoffRadius;
+
+	Domain* _domain;
+	DomainDecompBase* _domainDecomp;
+	int _rank, _numProcs;
+#ifdef ENABLE_MPI
+	MPI_Comm _comm;
+#endif
+
+	//! box length, for which the mesh has been set up
+	std::array<double, 3> _boxLength;
+	std::array<int, 3> _meshSize;
+	//! 1 / |b_d(m)|^2 of the B-spline interpolation (Essmann et al., eq. 4.4) per dimension
+	std::array<std::vector<double>, 3> _bsplineModuli;
+	std::array<std::unique_ptr<FFT1D>, 3> _fft;
+
+	//! first x-plane of the x-slab and first y-plane of the y-slab of every process, plus the mesh size
+	std::vector<int> _xSlabStart, _ySlabStart;
+	//! process, whose x-slab holds the x-plane
+	std::vector<int> _xSlabOwner;
+
+	//! own molecules with charges and the range of their charges in the arrays below
+	std::vector<Molecule*> _molecules;
+	std::vector<size_t> _firstCharge;
+	std::vector<double> _chargePos;
+	std::vector<double> _chargeQ;
+
+	//! local brick: first mesh index (not wrapped) and number of mesh points per dimension
+	std::array<int, 3> _brickLow, _brickNum;
+	//! bricks of all processes, 6 ints per process
+	std::vector<int> _bricks;
+	std::vector<double> _brickQ, _brickPhi;
+	//! per thread copies of the brick for the spreading
+	std::vector<std::vector<double> > _threadBricks;
+
+	//! mesh on the x-slab ([x][y][z]) and on the y-slab ([y][x][z])
+	std::vector<Complex> _xSlab, _ySlab;
+	std::vector<double> _sendBuffer, _recvBuffer;
+
+	void setupMesh();
+	void collectCharges(ParticleContainer* particleContainer);
+	void spreadCharges();
+	void bricksToSlab();
+	void slabToBricks();
+	void forwardFFT();
+	void backwardFFT();
+	void transposeXToY();
+	void transposeYToX();
+	//! multiply the transformed mesh by the influence function, returns the energy and adds to the virial tensor
+	double convolve(std::array<double, 3>& virial);
+	//! interpolate the forces and apply the corrections, returns the energy of the corrections
+	double gatherForces(std::array<double, 3>& virial);
+
+	//! number of points of the brick of process rank, whose x-plane belongs to the slab of process owner
+	size_t brickPointsInSlab(int rank, int owner) const;
+	//! exchange _sendBuffer into _recvBuffer, the counts are numbers of doubles
+	void alltoallv(const std::vector<int>& sendCounts, const std::vector<int>& recvCounts);
+};
+
+} // namespace spme
+
+#endif /* SRC_SPME_SMOOTHPARTICLEMESHEWALD_H_ */
@@ -0,0 +1,238 @@
+/*
+ * SmoothParticleMeshEwaldTest.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#include "SmoothParticleMeshEwaldTest.h"
+#include "Domain.h"
+#include "bhfmm/fft/tools/FFT1D.h"
+#include "molecules/Molecule.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/adapter/VectorizedCellProcessor.h"
+#include "spme/SmoothParticleMeshEwald.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+TEST_SUITE_REGISTRATION(SmoothParticleMeshEwaldTest);
+#else
+#pragma message "Compilation info: SmoothParticleMeshEwaldTest disabled in reduced memory mode"
+#endif
+
+SmoothParticleMeshEwaldTest::SmoothParticleMeshEwaldTest() {
+}
+
+SmoothParticleMeshEwaldTest::~SmoothParticleMeshEwaldTest() {
+}
+
+void SmoothParticleMeshEwaldTest::testFFT() {
+	typedef FFT1D::Complex Complex;
+
+	for (int n : {1, 2, 7, 12, 30, 64, 81, 98}) {
+		std::vector<Complex> data(2 * n), reference(n);
+		for (int j = 0; j < n; ++j) {
+			data[2 * j] = Complex(std::sin(0.3 * j + 0.1), std::cos(1.7 * j * j));
+		}
+
+		for (int sign : {-1, 1}) {
+			for (int k = 0; k < n; ++k) {
+				reference[k] = 0.0;
+				for (int j = 0; j < n; ++j) {
+					const double phi = sign * 2.0 * M_PI * ((static_cast<long>(j) * k) % n) / n;
+					reference[k] += data[2 * j] * Complex(std::cos(phi), std::sin(phi));
+				}
+			}
+
+			std::vector<Complex> transformed(data);
+			FFT1D fft(n);
+			fft.transform(transformed.data(), 2, sign);
+			for (int k = 0; k < n; ++k) {
+				std::stringstream str;
+				str << "n=" << n << " sign=" << sign << " k=" << k << std::endl;
+				ASSERT_DOUBLES_EQUAL_MSG(str.str(), reference[k].real(), transformed[2 * k].real(), 1e-10 * n);
+				ASSERT_DOUBLES_EQUAL_MSG(str.str(), reference[k].imag(), transformed[2 * k].imag(), 1e-10 * n);
+				// the odd entries are not part of the line
+				ASSERT_EQUAL(data[2 * k + 1], transformed[2 * k + 1]);
+			}
+		}
+	}
+}
+
+void SmoothParticleMeshEwaldTest::computeEwald(const std::string& fileName, double tolerance, int splineOrder,
+		double gridSpacing, std::vector<ChargedParticle>& particles, double& upot, double& virial) {
+	const double cutoffRadius = 4.0;
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, fileName.c_str(), cutoffRadius);
+	_domainDecomposition->exchangeMolecules(container, _domain);
+	// as in the simulation, otherwise the halo copies still refer to the force storage of their originals
+	container->updateMoleculeCaches();
+
+	spme::SmoothParticleMeshEwald ewald;
+	ewald.setParameters(tolerance, splineOrder, gridSpacing);
+	ewald.init(_domain, _domainDecomposition, cutoffRadius);
+
+	VectorizedCellProcessor cellProcessor(*_domain, cutoffRadius, cutoffRadius);
+	cellProcessor.setEwaldSplitting(ewald.getAlpha());
+	container->traverseCells(cellProcessor);
+	ewald.computeElectrostatics(container);
+
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		m->calcFM();
+		ChargedParticle particle;
+		particle.id = m->getID();
+		particle.q = m->component()->charge(0).q();
+		for (int d = 0; d < 3; ++d) {
+			particle.r[d] = m->r(d);
+			particle.f[d] = m->F(d);
+		}
+		particles.push_back(particle);
+	}
+	std::sort(particles.begin(), particles.end(),
+			[](const ChargedParticle& a, const ChargedParticle& b) { return a.id < b.id; });
+	upot = _domain->getLocalUpot();
+	virial = _domain->getLocalVirial();
+
+	delete container;
+}
+
+void SmoothParticleMeshEwaldTest::directEwald(const std::vector<ChargedParticle>& particles, double boxLength,
+		std::vector<std::array<double, 3> >& forces, double& upot) {
+	// alpha and the number of images and wave vectors are chosen for convergence to machine precision
+	const double alpha = 6.4 / boxLength;
+	const int numImages = 2, numWaveVectors = 14;
+	const double volume = boxLength * boxLength * boxLength;
+
+	forces.assign(particles.size(), {0.0, 0.0, 0.0});
+	upot = 0.0;
+
+	// real space part
+	for (size_t i = 0; i < particles.size(); ++i) {
+		upot -= alpha / std::sqrt(M_PI) * particles[i].q * particles[i].q;
+		for (size_t j = 0; j < particles.size(); ++j) {
+			for (int nx = -numImages; nx <= numImages; ++nx) {
+				for (int ny = -numImages; ny <= numImages; ++ny) {
+					for (int nz = -numImages; nz <= numImages; ++nz) {
+						if (i == j and nx == 0 and ny == 0 and nz == 0) {
+							continue;
+						}
+						const double dr[3] = {particles[i].r[0] - particles[j].r[0] + nx * boxLength,
+								particles[i].r[1] - particles[j].r[1] + ny * boxLength,
+								particles[i].r[2] - particles[j].r[2] + nz * boxLength};
+						const double r2 = dr[0] * dr[0] + dr[1] * dr[1] + dr[2] * dr[2];
+						const double r = std::sqrt(r2);
+						const double qq = particles[i].q * particles[j].q;
+						const double erfcTerm = std::erfc(alpha * r) / r;
+						upot += 0.5 * qq * erfcTerm;
+						const double fac = qq * (erfcTerm + M_2_SQRTPI * alpha * std::exp(-alpha * alpha * r2)) / r2;
+						for (int d = 0; d < 3; ++d) {
+							forces[i][d] += fac * dr[d];
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// reciprocal space part
+	for (int mx = -numWaveVectors; mx <= numWaveVectors; ++mx) {
+		for (int my = -numWaveVectors; my <= numWaveVectors; ++my) {
+			for (int mz = -numWaveVectors; mz <= numWaveVectors; ++mz) {
+				if (mx == 0 and my == 0 and mz == 0) {
+					continue;
+				}
+				const double k[3] = {2.0 * M_PI * mx / boxLength, 2.0 * M_PI * my / boxLength,
+						2.0 * M_PI * mz / boxLength};
+				const double k2 = k[0] * k[0] + k[1] * k[1] + k[2] * k[2];
+				const double g = 4.0 * M_PI / volume * std::exp(-k2 / (4.0 * alpha * alpha)) / k2;
+				double structureRe = 0.0, structureIm = 0.0;
+				for (const ChargedParticle& p : particles) {
+					const double kr = k[0] * p.r[0] + k[1] * p.r[1] + k[2] * p.r[2];
+					structureRe += p.q * std::cos(kr);
+					structureIm += p.q * std::sin(kr);
+				}
+				upot += 0.5 * g * (structureRe * structureRe + structureIm * structureIm);
+				for (size_t i = 0; i < particles.size(); ++i) {
+					const double kr = k[0] * particles[i].r[0] + k[1] * particles[i].r[1] + k[2] * particles[i].r[2];
+					const double fac = g * particles[i].q * (std::sin(kr) * structureRe - std::cos(kr) * structureIm);
+					for (int d = 0; d < 3; ++d) {
+						forces[i][d] += fac * k[d];
+					}
+				}
+			}
+		}
+	}
+}
+
+void SmoothParticleMeshEwaldTest::testDirectEwald() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "SmoothParticleMeshEwaldTest::testDirectEwald()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	struct Setting {
+		double tolerance;
+		int splineOrder;
+		double gridSpacing;
+		double forceTolerance;
+		double energyTolerance;
+	};
+	for (const Setting& setting : {Setting{1e-6, 6, 0.2, 1e-4, 1e-4}, Setting{1e-9, 8, 0.1, 1e-7, 1e-7}}) {
+		std::vector<ChargedParticle> particles;
+		double upot, virial;
+		computeEwald("SPMEIonic.inp", setting.tolerance, setting.splineOrder, setting.gridSpacing, particles, upot, virial);
+
+		std::vector<std::array<double, 3> > referenceForces;
+		double referenceUpot;
+		directEwald(particles, _domain->getGlobalLength(0), referenceForces, referenceUpot);
+
+		for (size_t i = 0; i < particles.size(); ++i) {
+			for (int d = 0; d < 3; ++d) {
+				std::stringstream str;
+				str << "tolerance " << setting.tolerance << " molecule " << particles[i].id << " force component " << d
+						<< std::endl;
+				ASSERT_DOUBLES_EQUAL_MSG(str.str(), referenceForces[i][d], particles[i].f[d], setting.forceTolerance);
+			}
+		}
+		ASSERT_DOUBLES_EQUAL(referenceUpot, upot, setting.energyTolerance);
+		// the virial of the Coulomb interaction equals its potential energy
+		ASSERT_DOUBLES_EQUAL(referenceUpot, virial, setting.energyTolerance);
+
+		// reset variables, which are not visible here
+		tearDown();
+		setUp();
+	}
+}
+
+void SmoothParticleMeshEwaldTest::testAlphaIndependence() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "SmoothParticleMeshEwaldTest::testAlphaIndependence()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	std::vector<ChargedParticle> particlesSmallAlpha, particlesLargeAlpha;
+	double upotSmallAlpha, upotLargeAlpha, virialSmallAlpha, virialLargeAlpha;
+	computeEwald("FMMCharge.inp", 1e-6, 8, 0.1, particlesSmallAlpha, upotSmallAlpha, virialSmallAlpha);
+
+	// reset variables, which are not visible here
+	tearDown();
+	setUp();
+
+	computeEwald("FMMCharge.inp", 1e-9, 8, 0.1, particlesLargeAlpha, upotLargeAlpha, virialLargeAlpha);
+
+	ASSERT_EQUAL(particlesSmallAlpha.size(), particlesLargeAlpha.size());
+	for (size_t i = 0; i < particlesSmallAlpha.size(); ++i) {
+		for (int d = 0; d < 3; ++d) {
+			std::stringstream str;
+			str << "Molecule " << i << " force component " << d << std::endl;
+#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), particlesSmallAlpha[i].f[d], particlesLargeAlpha[i].f[d], 1e-4);
+#else /* VCP_DPDP */
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), particlesSmallAlpha[i].f[d], particlesLargeAlpha[i].f[d], 1e-5);
+#endif
+		}
+	}
+	ASSERT_DOUBLES_EQUAL(upotSmallAlpha, upotLargeAlpha, 1e-5);
+}
@@ -0,0 +1,55 @@
+/*
+ * SmoothParticleMeshEwaldTest.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_SPME_TESTS_SMOOTHPARTICLEMESHEWALDTEST_H_
+#define SRC_SPME_TESTS_SMOOTHPARTICLEMESHEWALDTEST_H_
+
+#include "utils/TestWithSimulationSetup.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+class SmoothParticleMeshEwaldTest: public utils::TestWithSimulationSetup {
+	TEST_SUITE(SmoothParticleMeshEwaldTest);
+
+	TEST_METHOD(testFFT);
+	TEST_METHOD(testDirectEwald);
+	TEST_METHOD(testAlphaIndependence);
+
+	TEST_SUITE_END();
+
+public:
+	SmoothParticleMeshEwaldTest();
+	virtual ~SmoothParticleMeshEwaldTest();
+
+	//! compare FFT1D with the naive discrete Fourier transform
+	void testFFT();
+
+	//! real space part (VectorizedCellProcessor) plus SPME against a direct Ewald sum of a small ionic system
+	void testDirectEwald();
+
+	//! real space part (VectorizedCellProcessor) plus SPME has to be independent of the Ewald parameter
+	void testAlphaIndependence();
+
+private:
+	struct ChargedParticle {
+		unsigned long id;
+		double q;
+		std::array<double, 3> r;
+		std::array<double, 3> f;
+	};
+
+	//! particles sorted by id with their forces, the potential energy and the virial
+	void computeEwald(const std::string& fileName, double tolerance, int splineOrder, double gridSpacing,
+			std::vector<ChargedParticle>& particles, double& upot, double& virial);
+
+	//! plain Ewald sum of single charge molecules in a cubic box
+	static void directEwald(const std::vector<ChargedParticle>& particles, double boxLength,
+			std::vector<std::array<double, 3> >& forces, double& upot);
+};
+
+#endif /* SRC_SPME_TESTS_SMOOTHPARTICLEMESHEWALDTEST_H_ */
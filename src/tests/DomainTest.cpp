@@ -0,0 +1,81 @@
+/*
+ * DomainTest.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#include "tests/DomainTest.h"
+
+#include <array>
+
+#include "Domain.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+
+TEST_SUITE_REGISTRATION(DomainTest);
+
+void DomainTest::testCalculateGlobalValues() {
+	ParticleContainer* particleContainer = initializeFromFile(ParticleContainerFactory::LinkedCell, "simple-lj-tiny.inp", 5.0);
+	const int rank = _domainDecomposition->getRank();
+	const int numProcs = _domainDecomposition->getNumProcs();
+
+	// reference: sums of the own molecules, reduced separately
+	unsigned long numMolecules = 0;
+	double summv2 = 0.;
+	std::array<double, 3> sumv = {0., 0., 0.};
+	for (auto it = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+		++numMolecules;
+		summv2 += it->mass() * it->v2();
+		for (int d = 0; d < 3; d++) {
+			sumv[d] += it->v(d);
+		}
+	}
+	_domainDecomposition->collCommInit(5);
+	_domainDecomposition->collCommAppendUnsLong(numMolecules);
+	_domainDecomposition->collCommAppendDouble(summv2);
+	for (int d = 0; d < 3; d++) {
+		_domainDecomposition->collCommAppendDouble(sumv[d]);
+	}
+	_domainDecomposition->collCommAllreduceSum();
+	numMolecules = _domainDecomposition->collCommGetUnsLong();
+	summv2 = _domainDecomposition->collCommGetDouble();
+	for (int d = 0; d < 3; d++) {
+		sumv[d] = _domainDecomposition->collCommGetDouble();
+	}
+	_domainDecomposition->collCommFinalize();
+	ASSERT_EQUAL(64ul, numMolecules);
+
+	_domain->setGlobalTemperature(1.0);
+	_domain->enableUndirectedThermostat(0);
+	_domain->setUpotCorr(0.5);
+	_domain->setVirialCorr(0.25);
+	// the first step collects the directed velocity, the second one does not
+	for (bool collectThermostatVelocities : {true, false}) {
+		_domain->setLocalUpot(rank + 1.);
+		_domain->setLocalVirial(2. * (rank + 1.));
+		_domain->calculateVelocitySums(particleContainer);
+		if (collectThermostatVelocities) {
+			_domain->calculateThermostatDirectedVelocity(particleContainer);
+		}
+		_domain->calculateGlobalValues(_domainDecomposition, particleContainer, collectThermostatVelocities, 1.0);
+
+		const double sumRanks = numProcs * (numProcs + 1.) / 2.;
+		ASSERT_DOUBLES_EQUAL(sumRanks + 0.5, _domain->getGlobalUpot(), 1e-12);
+		ASSERT_DOUBLES_EQUAL(2. * sumRanks + 0.25, _domain->getAverageGlobalVirial() * _domain->getglobalNumMolecules(), 1e-12);
+		// the kinetic energy of the first step is not yet relative to the directed velocity
+		ASSERT_DOUBLES_EQUAL(summv2 / (3. * numMolecules), _domain->getGlobalCurrentTemperature(), 1e-12 * summv2);
+		for (int d = 0; d < 3; d++) {
+			ASSERT_DOUBLES_EQUAL(sumv[d] / numMolecules, _domain->getThermostatDirectedVelocity(0, d), 1e-15);
+		}
+		if (not collectThermostatVelocities) {
+			break;
+		}
+		// the second step sees the thermal motion only
+		double directedv2 = 0.;
+		for (int d = 0; d < 3; d++) {
+			directedv2 += sumv[d] * sumv[d] / (numMolecules * numMolecules);
+		}
+		summv2 -= numMolecules * particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY)->mass() * directedv2;
+	}
+	delete particleContainer;
+}
@@ -0,0 +1,33 @@
+/*
+ * DomainTest.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_TESTS_DOMAINTEST_H_
+#define SRC_TESTS_DOMAINTEST_H_
+
+#include "utils/TestWithSimulationSetup.h"
+
+/**
+ * Test the global reductions of Domain::calculateGlobalValues().
+ */
+class DomainTest : public utils::TestWithSimulationSetup {
+
+	TEST_SUITE(DomainTest);
+	TEST_METHOD(testCalculateGlobalValues);
+	TEST_SUITE_END();
+
+public:
+	DomainTest() = default;
+
+	virtual ~DomainTest() = default;
+
+	/**
+	 * Potential energy, virial, number of molecules and temperature are summed up over all processes, also on steps
+	 * which collect the directed velocity of an undirected thermostat, which is the mean velocity then.
+	 */
+	void testCalculateGlobalValues();
+};
+
+#endif /* SRC_TESTS_DOMAINTEST_H_ */
@@ -164,6 +164,11 @@ public:
 		setPaddingToZero(_data);
 	}
 
+	/**
+	 * \brief	Set all entries (including padding) of all site types to zero
+	 */
+	void zero() { _data.AlignedArray<T>::zero(0); }
+
 	/**
 	 * \brief	Get the size of currently occupied memory
 	 * \return	Number of allocated bytes
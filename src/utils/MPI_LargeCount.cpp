@@ -0,0 +1,43 @@
+/*
+ * MPI_LargeCount.cpp
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#include "utils/MPI_LargeCount.h"
+
+#ifdef ENABLE_MPI
+
+#include "utils/Logger.h"
+
+void createLargeContiguousType(uint64_t count, MPI_Datatype oldtype, MPI_Datatype* newtype) {
+	const uint64_t chunkSize = uint64_t(1) << 30;
+	const uint64_t numChunks = count / chunkSize;
+	const int remainder = static_cast<int>(count % chunkSize);
+
+	if (numChunks == 0) {
+		MPI_CHECK(MPI_Type_contiguous(remainder, oldtype, newtype));
+		MPI_CHECK(MPI_Type_commit(newtype));
+		return;
+	}
+
+	MPI_Aint lowerBound, extent;
+	MPI_CHECK(MPI_Type_get_extent(oldtype, &lowerBound, &extent));
+
+	MPI_Datatype chunkType, chunksType, remainderType;
+	MPI_CHECK(MPI_Type_contiguous(static_cast<int>(chunkSize), oldtype, &chunkType));
+	MPI_CHECK(MPI_Type_contiguous(static_cast<int>(numChunks), chunkType, &chunksType));
+	MPI_CHECK(MPI_Type_contiguous(remainder, oldtype, &remainderType));
+
+	int blocklengths[2] = {1, 1};
+	MPI_Aint displacements[2] = {0, static_cast<MPI_Aint>(numChunks * chunkSize) * extent};
+	MPI_Datatype types[2] = {chunksType, remainderType};
+	MPI_CHECK(MPI_Type_create_struct(2, blocklengths, displacements, types, newtype));
+	MPI_CHECK(MPI_Type_commit(newtype));
+
+	MPI_CHECK(MPI_Type_free(&chunkType));
+	MPI_CHECK(MPI_Type_free(&chunksType));
+	MPI_CHECK(MPI_Type_free(&remainderType));
+}
+
+#endif /* ENABLE_MPI */
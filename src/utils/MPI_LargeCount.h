@@ -0,0 +1,26 @@
+/*
+ * MPI_LargeCount.h
+ *
+ *  Created on: 17 Oct 2026
+ */
+
+#ifndef SRC_UTILS_MPI_LARGECOUNT_H_
+#define SRC_UTILS_MPI_LARGECOUNT_H_
+
+#ifdef ENABLE_MPI
+
+#include <cstdint>
+
+#include <mpi.h>
+
+/** @brief Create a committed datatype of count consecutive elements of oldtype.
+ *
+ * MPI calls take the number of elements as int. Reading or writing one element of the created type instead allows
+ * transfers of 2^31 or more elements (e.g. bytes of a checkpoint) in a single, possibly collective, call. The type is
+ * built from contiguous chunks of 2^30 elements and a remainder. It has to be freed with MPI_Type_free by the caller.
+ */
+void createLargeContiguousType(uint64_t count, MPI_Datatype oldtype, MPI_Datatype* newtype);
+
+#endif /* ENABLE_MPI */
+
+#endif /* SRC_UTILS_MPI_LARGECOUNT_H_ */